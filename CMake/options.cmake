@@ -210,6 +210,15 @@ if (OPTION_USE_SVG)
   set (FLTK_USE_SVG 1)
 endif (OPTION_USE_SVG)
 
+#######################################################################
+if (WIN32)
+  option (OPTION_USE_GDIPLUS "use GDI+ to draw antialiased lines and curves" OFF)
+
+  if (OPTION_USE_GDIPLUS)
+    set (USE_GDIPLUS 1)
+  endif (OPTION_USE_GDIPLUS)
+endif (WIN32)
+
 #######################################################################
 set (HAVE_GL LIB_GL OR LIB_MesaGL)
 
@@ -587,6 +596,31 @@ else()
   set (FLTK_XDBE_FOUND FALSE)
 endif (OPTION_USE_XDBE AND HAVE_XDBE_H)
 
+#######################################################################
+if (X11_FOUND)
+  option (OPTION_USE_XSYNC "use the X synchronization extension" ON)
+endif (X11_FOUND)
+
+if (OPTION_USE_XSYNC AND HAVE_XSYNC_H AND X11_Xext_FOUND)
+  set (HAVE_XSYNC 1)
+  set (FLTK_XSYNC_FOUND TRUE)
+else()
+  set (FLTK_XSYNC_FOUND FALSE)
+endif (OPTION_USE_XSYNC AND HAVE_XSYNC_H AND X11_Xext_FOUND)
+
+#######################################################################
+if (X11_FOUND)
+  option (OPTION_USE_XSHM "use the MIT-SHM extension" ON)
+endif (X11_FOUND)
+
+# XShm*() functions live in libXext which is linked already when found
+if (OPTION_USE_XSHM AND HAVE_XSHM_H AND X11_Xext_FOUND)
+  set (HAVE_XSHM 1)
+  set (FLTK_XSHM_FOUND TRUE)
+else()
+  set (FLTK_XSHM_FOUND FALSE)
+endif (OPTION_USE_XSHM AND HAVE_XSHM_H AND X11_Xext_FOUND)
+
 #######################################################################
 set (FL_NO_PRINT_SUPPORT FALSE)
 if (X11_FOUND AND NOT OPTION_PRINT_SUPPORT)
@@ -41,6 +41,9 @@ endif (DEBUG_VARIABLES_CMAKE)
 
 if (WIN32)
   list (APPEND FLTK_LDLIBS -lole32 -luuid -lcomctl32 -lws2_32)
+  if (USE_GDIPLUS)
+    list (APPEND FLTK_LDLIBS -lgdiplus)
+  endif (USE_GDIPLUS)
 elseif (APPLE AND OPTION_APPLE_SDL)
   # FIXME: do nothing?
 elseif (APPLE AND NOT OPTION_APPLE_X11)
@@ -60,6 +63,15 @@ if (HAVE_DLSYM)
   endforeach ()
 endif (HAVE_DLSYM)
 
+# zlib is used by the PostScript driver to Flate-compress image streams
+if (FLTK_BUILTIN_ZLIB_FOUND)
+  list (APPEND FLTK_LDLIBS -lfltk_z)
+else ()
+  if (LIB_zlib)
+    list (APPEND FLTK_LDLIBS -lz)
+  endif (LIB_zlib)
+endif (FLTK_BUILTIN_ZLIB_FOUND)
+
 #######################################################################
 # Set variables for fltk-config (generated from fltk-config.in)
 #######################################################################
@@ -0,0 +1,11 @@
+/*
+  ABI Configuration file for the Fast Light Tool Kit (FLTK).
+
+  ============================================================================
+    DO NOT EDIT - This file is generated by CMake !
+  ============================================================================
+
+  define FL_ABI_VERSION: 1xxyy for 1.x.y (xx,yy with leading zero)
+*/
+
+/* #undef FL_ABI_VERSION */
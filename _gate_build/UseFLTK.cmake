@@ -0,0 +1,15 @@
+#
+# UseFLTK.CMake - FLTK CMake environment configuration file for external projects.
+#
+# This file is deprecated and will be removed in FLTK 1.4.0 or later
+#
+# automatically generated - do not edit
+#
+
+include_directories("/root/repo/_gate_build;/root/repo")
+
+message(AUTHOR_WARNING
+" * Warning: UseFLTK.cmake is deprecated and will be removed in FLTK 1.4.0
+ * or later. Please use 'include_directories(\${FLTK_INCLUDE_DIRS})' or
+ * 'target_include_directories(<target> PUBLIC|PRIVATE \${FLTK_INCLUDE_DIRS})'
+ * instead of 'include(\${FLTK_USE_FILE})'.")
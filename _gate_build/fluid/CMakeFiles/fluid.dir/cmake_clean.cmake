@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "../bin/fluid"
+  "../bin/fluid.pdb"
+  "CMakeFiles/fluid.dir/CodeEditor.cxx.o"
+  "CMakeFiles/fluid.dir/CodeEditor.cxx.o.d"
+  "CMakeFiles/fluid.dir/ExternalCodeEditor_UNIX.cxx.o"
+  "CMakeFiles/fluid.dir/ExternalCodeEditor_UNIX.cxx.o.d"
+  "CMakeFiles/fluid.dir/Fl_Function_Type.cxx.o"
+  "CMakeFiles/fluid.dir/Fl_Function_Type.cxx.o.d"
+  "CMakeFiles/fluid.dir/Fl_Group_Type.cxx.o"
+  "CMakeFiles/fluid.dir/Fl_Group_Type.cxx.o.d"
+  "CMakeFiles/fluid.dir/Fl_Menu_Type.cxx.o"
+  "CMakeFiles/fluid.dir/Fl_Menu_Type.cxx.o.d"
+  "CMakeFiles/fluid.dir/Fl_Type.cxx.o"
+  "CMakeFiles/fluid.dir/Fl_Type.cxx.o.d"
+  "CMakeFiles/fluid.dir/Fl_Widget_Type.cxx.o"
+  "CMakeFiles/fluid.dir/Fl_Widget_Type.cxx.o.d"
+  "CMakeFiles/fluid.dir/Fl_Window_Type.cxx.o"
+  "CMakeFiles/fluid.dir/Fl_Window_Type.cxx.o.d"
+  "CMakeFiles/fluid.dir/Fluid_Image.cxx.o"
+  "CMakeFiles/fluid.dir/Fluid_Image.cxx.o.d"
+  "CMakeFiles/fluid.dir/StyleParse.cxx.o"
+  "CMakeFiles/fluid.dir/StyleParse.cxx.o.d"
+  "CMakeFiles/fluid.dir/about_panel.cxx.o"
+  "CMakeFiles/fluid.dir/about_panel.cxx.o.d"
+  "CMakeFiles/fluid.dir/align_widget.cxx.o"
+  "CMakeFiles/fluid.dir/align_widget.cxx.o.d"
+  "CMakeFiles/fluid.dir/alignment_panel.cxx.o"
+  "CMakeFiles/fluid.dir/alignment_panel.cxx.o.d"
+  "CMakeFiles/fluid.dir/binary.cxx.o"
+  "CMakeFiles/fluid.dir/binary.cxx.o.d"
+  "CMakeFiles/fluid.dir/code.cxx.o"
+  "CMakeFiles/fluid.dir/code.cxx.o.d"
+  "CMakeFiles/fluid.dir/factory.cxx.o"
+  "CMakeFiles/fluid.dir/factory.cxx.o.d"
+  "CMakeFiles/fluid.dir/file.cxx.o"
+  "CMakeFiles/fluid.dir/file.cxx.o.d"
+  "CMakeFiles/fluid.dir/fluid.cxx.o"
+  "CMakeFiles/fluid.dir/fluid.cxx.o.d"
+  "CMakeFiles/fluid.dir/function_panel.cxx.o"
+  "CMakeFiles/fluid.dir/function_panel.cxx.o.d"
+  "CMakeFiles/fluid.dir/template_panel.cxx.o"
+  "CMakeFiles/fluid.dir/template_panel.cxx.o.d"
+  "CMakeFiles/fluid.dir/undo.cxx.o"
+  "CMakeFiles/fluid.dir/undo.cxx.o.d"
+  "CMakeFiles/fluid.dir/widget_panel.cxx.o"
+  "CMakeFiles/fluid.dir/widget_panel.cxx.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fluid.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,197 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/flstring.c" "src/CMakeFiles/fltk.dir/flstring.c.o" "gcc" "src/CMakeFiles/fltk.dir/flstring.c.o.d"
+  "/root/repo/src/numericsort.c" "src/CMakeFiles/fltk.dir/numericsort.c.o" "gcc" "src/CMakeFiles/fltk.dir/numericsort.c.o.d"
+  "/root/repo/src/scandir_posix.c" "src/CMakeFiles/fltk.dir/scandir_posix.c.o" "gcc" "src/CMakeFiles/fltk.dir/scandir_posix.c.o.d"
+  "/root/repo/src/vsnprintf.c" "src/CMakeFiles/fltk.dir/vsnprintf.c.o" "gcc" "src/CMakeFiles/fltk.dir/vsnprintf.c.o.d"
+  "/root/repo/src/xutf8/case.c" "src/CMakeFiles/fltk.dir/xutf8/case.c.o" "gcc" "src/CMakeFiles/fltk.dir/xutf8/case.c.o.d"
+  "/root/repo/src/xutf8/is_right2left.c" "src/CMakeFiles/fltk.dir/xutf8/is_right2left.c.o" "gcc" "src/CMakeFiles/fltk.dir/xutf8/is_right2left.c.o.d"
+  "/root/repo/src/xutf8/is_spacing.c" "src/CMakeFiles/fltk.dir/xutf8/is_spacing.c.o" "gcc" "src/CMakeFiles/fltk.dir/xutf8/is_spacing.c.o.d"
+  "/root/repo/src/xutf8/keysym2Ucs.c" "src/CMakeFiles/fltk.dir/xutf8/keysym2Ucs.c.o" "gcc" "src/CMakeFiles/fltk.dir/xutf8/keysym2Ucs.c.o.d"
+  "/root/repo/src/Fl.cxx" "src/CMakeFiles/fltk.dir/Fl.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl.cxx.o.d"
+  "/root/repo/src/Fl_Adjuster.cxx" "src/CMakeFiles/fltk.dir/Fl_Adjuster.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Adjuster.cxx.o.d"
+  "/root/repo/src/Fl_Bitmap.cxx" "src/CMakeFiles/fltk.dir/Fl_Bitmap.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Bitmap.cxx.o.d"
+  "/root/repo/src/Fl_Box.cxx" "src/CMakeFiles/fltk.dir/Fl_Box.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Box.cxx.o.d"
+  "/root/repo/src/Fl_Browser.cxx" "src/CMakeFiles/fltk.dir/Fl_Browser.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Browser.cxx.o.d"
+  "/root/repo/src/Fl_Browser_.cxx" "src/CMakeFiles/fltk.dir/Fl_Browser_.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Browser_.cxx.o.d"
+  "/root/repo/src/Fl_Browser_load.cxx" "src/CMakeFiles/fltk.dir/Fl_Browser_load.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Browser_load.cxx.o.d"
+  "/root/repo/src/Fl_Button.cxx" "src/CMakeFiles/fltk.dir/Fl_Button.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Button.cxx.o.d"
+  "/root/repo/src/Fl_Chart.cxx" "src/CMakeFiles/fltk.dir/Fl_Chart.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Chart.cxx.o.d"
+  "/root/repo/src/Fl_Check_Browser.cxx" "src/CMakeFiles/fltk.dir/Fl_Check_Browser.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Check_Browser.cxx.o.d"
+  "/root/repo/src/Fl_Check_Button.cxx" "src/CMakeFiles/fltk.dir/Fl_Check_Button.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Check_Button.cxx.o.d"
+  "/root/repo/src/Fl_Choice.cxx" "src/CMakeFiles/fltk.dir/Fl_Choice.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Choice.cxx.o.d"
+  "/root/repo/src/Fl_Clock.cxx" "src/CMakeFiles/fltk.dir/Fl_Clock.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Clock.cxx.o.d"
+  "/root/repo/src/Fl_Color_Chooser.cxx" "src/CMakeFiles/fltk.dir/Fl_Color_Chooser.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Color_Chooser.cxx.o.d"
+  "/root/repo/src/Fl_Copy_Surface.cxx" "src/CMakeFiles/fltk.dir/Fl_Copy_Surface.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Copy_Surface.cxx.o.d"
+  "/root/repo/src/Fl_Counter.cxx" "src/CMakeFiles/fltk.dir/Fl_Counter.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Counter.cxx.o.d"
+  "/root/repo/src/Fl_Device.cxx" "src/CMakeFiles/fltk.dir/Fl_Device.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Device.cxx.o.d"
+  "/root/repo/src/Fl_Dial.cxx" "src/CMakeFiles/fltk.dir/Fl_Dial.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Dial.cxx.o.d"
+  "/root/repo/src/Fl_Double_Window.cxx" "src/CMakeFiles/fltk.dir/Fl_Double_Window.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Double_Window.cxx.o.d"
+  "/root/repo/src/Fl_File_Browser.cxx" "src/CMakeFiles/fltk.dir/Fl_File_Browser.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_File_Browser.cxx.o.d"
+  "/root/repo/src/Fl_File_Chooser.cxx" "src/CMakeFiles/fltk.dir/Fl_File_Chooser.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_File_Chooser.cxx.o.d"
+  "/root/repo/src/Fl_File_Chooser2.cxx" "src/CMakeFiles/fltk.dir/Fl_File_Chooser2.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_File_Chooser2.cxx.o.d"
+  "/root/repo/src/Fl_File_Icon.cxx" "src/CMakeFiles/fltk.dir/Fl_File_Icon.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_File_Icon.cxx.o.d"
+  "/root/repo/src/Fl_File_Input.cxx" "src/CMakeFiles/fltk.dir/Fl_File_Input.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_File_Input.cxx.o.d"
+  "/root/repo/src/Fl_Flb_Loader.cxx" "src/CMakeFiles/fltk.dir/Fl_Flb_Loader.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Flb_Loader.cxx.o.d"
+  "/root/repo/src/Fl_Graphics_Driver.cxx" "src/CMakeFiles/fltk.dir/Fl_Graphics_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Graphics_Driver.cxx.o.d"
+  "/root/repo/src/Fl_Group.cxx" "src/CMakeFiles/fltk.dir/Fl_Group.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Group.cxx.o.d"
+  "/root/repo/src/Fl_Help_Dialog_Dox.cxx" "src/CMakeFiles/fltk.dir/Fl_Help_Dialog_Dox.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Help_Dialog_Dox.cxx.o.d"
+  "/root/repo/src/Fl_Help_View.cxx" "src/CMakeFiles/fltk.dir/Fl_Help_View.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Help_View.cxx.o.d"
+  "/root/repo/src/Fl_Image.cxx" "src/CMakeFiles/fltk.dir/Fl_Image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Image.cxx.o.d"
+  "/root/repo/src/Fl_Image_Surface.cxx" "src/CMakeFiles/fltk.dir/Fl_Image_Surface.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Image_Surface.cxx.o.d"
+  "/root/repo/src/Fl_Input.cxx" "src/CMakeFiles/fltk.dir/Fl_Input.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Input.cxx.o.d"
+  "/root/repo/src/Fl_Input_.cxx" "src/CMakeFiles/fltk.dir/Fl_Input_.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Input_.cxx.o.d"
+  "/root/repo/src/Fl_Input_Choice.cxx" "src/CMakeFiles/fltk.dir/Fl_Input_Choice.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Input_Choice.cxx.o.d"
+  "/root/repo/src/Fl_Light_Button.cxx" "src/CMakeFiles/fltk.dir/Fl_Light_Button.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Light_Button.cxx.o.d"
+  "/root/repo/src/Fl_Menu.cxx" "src/CMakeFiles/fltk.dir/Fl_Menu.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Menu.cxx.o.d"
+  "/root/repo/src/Fl_Menu_.cxx" "src/CMakeFiles/fltk.dir/Fl_Menu_.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Menu_.cxx.o.d"
+  "/root/repo/src/Fl_Menu_Bar.cxx" "src/CMakeFiles/fltk.dir/Fl_Menu_Bar.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Menu_Bar.cxx.o.d"
+  "/root/repo/src/Fl_Menu_Button.cxx" "src/CMakeFiles/fltk.dir/Fl_Menu_Button.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Menu_Button.cxx.o.d"
+  "/root/repo/src/Fl_Menu_Window.cxx" "src/CMakeFiles/fltk.dir/Fl_Menu_Window.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Menu_Window.cxx.o.d"
+  "/root/repo/src/Fl_Menu_add.cxx" "src/CMakeFiles/fltk.dir/Fl_Menu_add.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Menu_add.cxx.o.d"
+  "/root/repo/src/Fl_Menu_global.cxx" "src/CMakeFiles/fltk.dir/Fl_Menu_global.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Menu_global.cxx.o.d"
+  "/root/repo/src/Fl_Multi_Label.cxx" "src/CMakeFiles/fltk.dir/Fl_Multi_Label.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Multi_Label.cxx.o.d"
+  "/root/repo/src/Fl_Native_File_Chooser.cxx" "src/CMakeFiles/fltk.dir/Fl_Native_File_Chooser.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Native_File_Chooser.cxx.o.d"
+  "/root/repo/src/Fl_Native_File_Chooser_FLTK.cxx" "src/CMakeFiles/fltk.dir/Fl_Native_File_Chooser_FLTK.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Native_File_Chooser_FLTK.cxx.o.d"
+  "/root/repo/src/Fl_Native_File_Chooser_GTK.cxx" "src/CMakeFiles/fltk.dir/Fl_Native_File_Chooser_GTK.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Native_File_Chooser_GTK.cxx.o.d"
+  "/root/repo/src/Fl_Overlay_Window.cxx" "src/CMakeFiles/fltk.dir/Fl_Overlay_Window.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Overlay_Window.cxx.o.d"
+  "/root/repo/src/Fl_Pack.cxx" "src/CMakeFiles/fltk.dir/Fl_Pack.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Pack.cxx.o.d"
+  "/root/repo/src/Fl_Paged_Device.cxx" "src/CMakeFiles/fltk.dir/Fl_Paged_Device.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Paged_Device.cxx.o.d"
+  "/root/repo/src/Fl_Pixmap.cxx" "src/CMakeFiles/fltk.dir/Fl_Pixmap.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Pixmap.cxx.o.d"
+  "/root/repo/src/Fl_Positioner.cxx" "src/CMakeFiles/fltk.dir/Fl_Positioner.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Positioner.cxx.o.d"
+  "/root/repo/src/Fl_Preferences.cxx" "src/CMakeFiles/fltk.dir/Fl_Preferences.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Preferences.cxx.o.d"
+  "/root/repo/src/Fl_Printer.cxx" "src/CMakeFiles/fltk.dir/Fl_Printer.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Printer.cxx.o.d"
+  "/root/repo/src/Fl_Progress.cxx" "src/CMakeFiles/fltk.dir/Fl_Progress.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Progress.cxx.o.d"
+  "/root/repo/src/Fl_Recording_Surface.cxx" "src/CMakeFiles/fltk.dir/Fl_Recording_Surface.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Recording_Surface.cxx.o.d"
+  "/root/repo/src/Fl_Repeat_Button.cxx" "src/CMakeFiles/fltk.dir/Fl_Repeat_Button.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Repeat_Button.cxx.o.d"
+  "/root/repo/src/Fl_Return_Button.cxx" "src/CMakeFiles/fltk.dir/Fl_Return_Button.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Return_Button.cxx.o.d"
+  "/root/repo/src/Fl_Roller.cxx" "src/CMakeFiles/fltk.dir/Fl_Roller.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Roller.cxx.o.d"
+  "/root/repo/src/Fl_Round_Button.cxx" "src/CMakeFiles/fltk.dir/Fl_Round_Button.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Round_Button.cxx.o.d"
+  "/root/repo/src/Fl_Screen_Driver.cxx" "src/CMakeFiles/fltk.dir/Fl_Screen_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Screen_Driver.cxx.o.d"
+  "/root/repo/src/Fl_Scroll.cxx" "src/CMakeFiles/fltk.dir/Fl_Scroll.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Scroll.cxx.o.d"
+  "/root/repo/src/Fl_Scrollbar.cxx" "src/CMakeFiles/fltk.dir/Fl_Scrollbar.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Scrollbar.cxx.o.d"
+  "/root/repo/src/Fl_Shared_Image.cxx" "src/CMakeFiles/fltk.dir/Fl_Shared_Image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Shared_Image.cxx.o.d"
+  "/root/repo/src/Fl_Simple_Terminal.cxx" "src/CMakeFiles/fltk.dir/Fl_Simple_Terminal.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Simple_Terminal.cxx.o.d"
+  "/root/repo/src/Fl_Single_Window.cxx" "src/CMakeFiles/fltk.dir/Fl_Single_Window.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Single_Window.cxx.o.d"
+  "/root/repo/src/Fl_Slider.cxx" "src/CMakeFiles/fltk.dir/Fl_Slider.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Slider.cxx.o.d"
+  "/root/repo/src/Fl_Spinner.cxx" "src/CMakeFiles/fltk.dir/Fl_Spinner.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Spinner.cxx.o.d"
+  "/root/repo/src/Fl_Sys_Menu_Bar.cxx" "src/CMakeFiles/fltk.dir/Fl_Sys_Menu_Bar.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Sys_Menu_Bar.cxx.o.d"
+  "/root/repo/src/Fl_System_Driver.cxx" "src/CMakeFiles/fltk.dir/Fl_System_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_System_Driver.cxx.o.d"
+  "/root/repo/src/Fl_Table.cxx" "src/CMakeFiles/fltk.dir/Fl_Table.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Table.cxx.o.d"
+  "/root/repo/src/Fl_Table_Row.cxx" "src/CMakeFiles/fltk.dir/Fl_Table_Row.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Table_Row.cxx.o.d"
+  "/root/repo/src/Fl_Tabs.cxx" "src/CMakeFiles/fltk.dir/Fl_Tabs.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tabs.cxx.o.d"
+  "/root/repo/src/Fl_Text_Buffer.cxx" "src/CMakeFiles/fltk.dir/Fl_Text_Buffer.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Text_Buffer.cxx.o.d"
+  "/root/repo/src/Fl_Text_Display.cxx" "src/CMakeFiles/fltk.dir/Fl_Text_Display.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Text_Display.cxx.o.d"
+  "/root/repo/src/Fl_Text_Editor.cxx" "src/CMakeFiles/fltk.dir/Fl_Text_Editor.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Text_Editor.cxx.o.d"
+  "/root/repo/src/Fl_Tile.cxx" "src/CMakeFiles/fltk.dir/Fl_Tile.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tile.cxx.o.d"
+  "/root/repo/src/Fl_Tiled_Image.cxx" "src/CMakeFiles/fltk.dir/Fl_Tiled_Image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tiled_Image.cxx.o.d"
+  "/root/repo/src/Fl_Tooltip.cxx" "src/CMakeFiles/fltk.dir/Fl_Tooltip.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tooltip.cxx.o.d"
+  "/root/repo/src/Fl_Tree.cxx" "src/CMakeFiles/fltk.dir/Fl_Tree.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tree.cxx.o.d"
+  "/root/repo/src/Fl_Tree_Item.cxx" "src/CMakeFiles/fltk.dir/Fl_Tree_Item.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tree_Item.cxx.o.d"
+  "/root/repo/src/Fl_Tree_Item_Array.cxx" "src/CMakeFiles/fltk.dir/Fl_Tree_Item_Array.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tree_Item_Array.cxx.o.d"
+  "/root/repo/src/Fl_Tree_Prefs.cxx" "src/CMakeFiles/fltk.dir/Fl_Tree_Prefs.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Tree_Prefs.cxx.o.d"
+  "/root/repo/src/Fl_Valuator.cxx" "src/CMakeFiles/fltk.dir/Fl_Valuator.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Valuator.cxx.o.d"
+  "/root/repo/src/Fl_Value_Input.cxx" "src/CMakeFiles/fltk.dir/Fl_Value_Input.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Value_Input.cxx.o.d"
+  "/root/repo/src/Fl_Value_Output.cxx" "src/CMakeFiles/fltk.dir/Fl_Value_Output.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Value_Output.cxx.o.d"
+  "/root/repo/src/Fl_Value_Slider.cxx" "src/CMakeFiles/fltk.dir/Fl_Value_Slider.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Value_Slider.cxx.o.d"
+  "/root/repo/src/Fl_Virtual_Browser.cxx" "src/CMakeFiles/fltk.dir/Fl_Virtual_Browser.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Virtual_Browser.cxx.o.d"
+  "/root/repo/src/Fl_Widget.cxx" "src/CMakeFiles/fltk.dir/Fl_Widget.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Widget.cxx.o.d"
+  "/root/repo/src/Fl_Widget_Surface.cxx" "src/CMakeFiles/fltk.dir/Fl_Widget_Surface.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Widget_Surface.cxx.o.d"
+  "/root/repo/src/Fl_Window.cxx" "src/CMakeFiles/fltk.dir/Fl_Window.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Window.cxx.o.d"
+  "/root/repo/src/Fl_Window_Driver.cxx" "src/CMakeFiles/fltk.dir/Fl_Window_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Window_Driver.cxx.o.d"
+  "/root/repo/src/Fl_Window_fullscreen.cxx" "src/CMakeFiles/fltk.dir/Fl_Window_fullscreen.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Window_fullscreen.cxx.o.d"
+  "/root/repo/src/Fl_Window_hotspot.cxx" "src/CMakeFiles/fltk.dir/Fl_Window_hotspot.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Window_hotspot.cxx.o.d"
+  "/root/repo/src/Fl_Window_iconize.cxx" "src/CMakeFiles/fltk.dir/Fl_Window_iconize.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Window_iconize.cxx.o.d"
+  "/root/repo/src/Fl_Wizard.cxx" "src/CMakeFiles/fltk.dir/Fl_Wizard.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_Wizard.cxx.o.d"
+  "/root/repo/src/Fl_XBM_Image.cxx" "src/CMakeFiles/fltk.dir/Fl_XBM_Image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_XBM_Image.cxx.o.d"
+  "/root/repo/src/Fl_XPM_Image.cxx" "src/CMakeFiles/fltk.dir/Fl_XPM_Image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_XPM_Image.cxx.o.d"
+  "/root/repo/src/Fl_abort.cxx" "src/CMakeFiles/fltk.dir/Fl_abort.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_abort.cxx.o.d"
+  "/root/repo/src/Fl_add_idle.cxx" "src/CMakeFiles/fltk.dir/Fl_add_idle.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_add_idle.cxx.o.d"
+  "/root/repo/src/Fl_arg.cxx" "src/CMakeFiles/fltk.dir/Fl_arg.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_arg.cxx.o.d"
+  "/root/repo/src/Fl_compose.cxx" "src/CMakeFiles/fltk.dir/Fl_compose.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_compose.cxx.o.d"
+  "/root/repo/src/Fl_display.cxx" "src/CMakeFiles/fltk.dir/Fl_display.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_display.cxx.o.d"
+  "/root/repo/src/Fl_get_key.cxx" "src/CMakeFiles/fltk.dir/Fl_get_key.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_get_key.cxx.o.d"
+  "/root/repo/src/Fl_get_system_colors.cxx" "src/CMakeFiles/fltk.dir/Fl_get_system_colors.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_get_system_colors.cxx.o.d"
+  "/root/repo/src/Fl_grab.cxx" "src/CMakeFiles/fltk.dir/Fl_grab.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_grab.cxx.o.d"
+  "/root/repo/src/Fl_lock.cxx" "src/CMakeFiles/fltk.dir/Fl_lock.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_lock.cxx.o.d"
+  "/root/repo/src/Fl_own_colormap.cxx" "src/CMakeFiles/fltk.dir/Fl_own_colormap.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_own_colormap.cxx.o.d"
+  "/root/repo/src/Fl_visual.cxx" "src/CMakeFiles/fltk.dir/Fl_visual.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_visual.cxx.o.d"
+  "/root/repo/src/Fl_x.cxx" "src/CMakeFiles/fltk.dir/Fl_x.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/Fl_x.cxx.o.d"
+  "/root/repo/src/drivers/Posix/Fl_Posix_Printer_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_Printer_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_Printer_Driver.cxx.o.d"
+  "/root/repo/src/drivers/Posix/Fl_Posix_System_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_System_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_System_Driver.cxx.o.d"
+  "/root/repo/src/drivers/PostScript/Fl_PostScript.cxx" "src/CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript.cxx.o.d"
+  "/root/repo/src/drivers/PostScript/Fl_PostScript_image.cxx" "src/CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript_image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript_image.cxx.o.d"
+  "/root/repo/src/drivers/X11/Fl_X11_Screen_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Screen_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Screen_Driver.cxx.o.d"
+  "/root/repo/src/drivers/X11/Fl_X11_System_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/X11/Fl_X11_System_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/X11/Fl_X11_System_Driver.cxx.o.d"
+  "/root/repo/src/drivers/X11/Fl_X11_Window_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Window_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Window_Driver.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Copy_Surface_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Copy_Surface_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Copy_Surface_Driver.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver_arci.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_arci.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_arci.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver_color.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_color.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_color.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver_font_xft.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_font_xft.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_font_xft.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver_image.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_image.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver_line_style.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_line_style.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_line_style.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver_rect.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_rect.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_rect.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Graphics_Driver_vertex.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_vertex.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_vertex.cxx.o.d"
+  "/root/repo/src/drivers/Xlib/Fl_Xlib_Image_Surface_Driver.cxx" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Image_Surface_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Image_Surface_Driver.cxx.o.d"
+  "/root/repo/src/filename_absolute.cxx" "src/CMakeFiles/fltk.dir/filename_absolute.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/filename_absolute.cxx.o.d"
+  "/root/repo/src/filename_expand.cxx" "src/CMakeFiles/fltk.dir/filename_expand.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/filename_expand.cxx.o.d"
+  "/root/repo/src/filename_ext.cxx" "src/CMakeFiles/fltk.dir/filename_ext.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/filename_ext.cxx.o.d"
+  "/root/repo/src/filename_isdir.cxx" "src/CMakeFiles/fltk.dir/filename_isdir.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/filename_isdir.cxx.o.d"
+  "/root/repo/src/filename_list.cxx" "src/CMakeFiles/fltk.dir/filename_list.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/filename_list.cxx.o.d"
+  "/root/repo/src/filename_match.cxx" "src/CMakeFiles/fltk.dir/filename_match.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/filename_match.cxx.o.d"
+  "/root/repo/src/filename_setext.cxx" "src/CMakeFiles/fltk.dir/filename_setext.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/filename_setext.cxx.o.d"
+  "/root/repo/src/fl_arc.cxx" "src/CMakeFiles/fltk.dir/fl_arc.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_arc.cxx.o.d"
+  "/root/repo/src/fl_ask.cxx" "src/CMakeFiles/fltk.dir/fl_ask.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_ask.cxx.o.d"
+  "/root/repo/src/fl_boxtype.cxx" "src/CMakeFiles/fltk.dir/fl_boxtype.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_boxtype.cxx.o.d"
+  "/root/repo/src/fl_cached_box.cxx" "src/CMakeFiles/fltk.dir/fl_cached_box.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_cached_box.cxx.o.d"
+  "/root/repo/src/fl_color.cxx" "src/CMakeFiles/fltk.dir/fl_color.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_color.cxx.o.d"
+  "/root/repo/src/fl_cursor.cxx" "src/CMakeFiles/fltk.dir/fl_cursor.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_cursor.cxx.o.d"
+  "/root/repo/src/fl_curve.cxx" "src/CMakeFiles/fltk.dir/fl_curve.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_curve.cxx.o.d"
+  "/root/repo/src/fl_diamond_box.cxx" "src/CMakeFiles/fltk.dir/fl_diamond_box.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_diamond_box.cxx.o.d"
+  "/root/repo/src/fl_dnd_x.cxx" "src/CMakeFiles/fltk.dir/fl_dnd_x.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_dnd_x.cxx.o.d"
+  "/root/repo/src/fl_draw.cxx" "src/CMakeFiles/fltk.dir/fl_draw.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_draw.cxx.o.d"
+  "/root/repo/src/fl_draw_pixmap.cxx" "src/CMakeFiles/fltk.dir/fl_draw_pixmap.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_draw_pixmap.cxx.o.d"
+  "/root/repo/src/fl_encoding_latin1.cxx" "src/CMakeFiles/fltk.dir/fl_encoding_latin1.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_encoding_latin1.cxx.o.d"
+  "/root/repo/src/fl_encoding_mac_roman.cxx" "src/CMakeFiles/fltk.dir/fl_encoding_mac_roman.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_encoding_mac_roman.cxx.o.d"
+  "/root/repo/src/fl_engraved_label.cxx" "src/CMakeFiles/fltk.dir/fl_engraved_label.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_engraved_label.cxx.o.d"
+  "/root/repo/src/fl_file_dir.cxx" "src/CMakeFiles/fltk.dir/fl_file_dir.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_file_dir.cxx.o.d"
+  "/root/repo/src/fl_font.cxx" "src/CMakeFiles/fltk.dir/fl_font.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_font.cxx.o.d"
+  "/root/repo/src/fl_gleam.cxx" "src/CMakeFiles/fltk.dir/fl_gleam.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_gleam.cxx.o.d"
+  "/root/repo/src/fl_gtk.cxx" "src/CMakeFiles/fltk.dir/fl_gtk.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_gtk.cxx.o.d"
+  "/root/repo/src/fl_labeltype.cxx" "src/CMakeFiles/fltk.dir/fl_labeltype.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_labeltype.cxx.o.d"
+  "/root/repo/src/fl_open_uri.cxx" "src/CMakeFiles/fltk.dir/fl_open_uri.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_open_uri.cxx.o.d"
+  "/root/repo/src/fl_oval_box.cxx" "src/CMakeFiles/fltk.dir/fl_oval_box.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_oval_box.cxx.o.d"
+  "/root/repo/src/fl_overlay.cxx" "src/CMakeFiles/fltk.dir/fl_overlay.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_overlay.cxx.o.d"
+  "/root/repo/src/fl_overlay_visual.cxx" "src/CMakeFiles/fltk.dir/fl_overlay_visual.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_overlay_visual.cxx.o.d"
+  "/root/repo/src/fl_plastic.cxx" "src/CMakeFiles/fltk.dir/fl_plastic.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_plastic.cxx.o.d"
+  "/root/repo/src/fl_read_image.cxx" "src/CMakeFiles/fltk.dir/fl_read_image.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_read_image.cxx.o.d"
+  "/root/repo/src/fl_rect.cxx" "src/CMakeFiles/fltk.dir/fl_rect.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_rect.cxx.o.d"
+  "/root/repo/src/fl_round_box.cxx" "src/CMakeFiles/fltk.dir/fl_round_box.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_round_box.cxx.o.d"
+  "/root/repo/src/fl_rounded_box.cxx" "src/CMakeFiles/fltk.dir/fl_rounded_box.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_rounded_box.cxx.o.d"
+  "/root/repo/src/fl_scroll_area.cxx" "src/CMakeFiles/fltk.dir/fl_scroll_area.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_scroll_area.cxx.o.d"
+  "/root/repo/src/fl_set_font.cxx" "src/CMakeFiles/fltk.dir/fl_set_font.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_set_font.cxx.o.d"
+  "/root/repo/src/fl_shadow_box.cxx" "src/CMakeFiles/fltk.dir/fl_shadow_box.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_shadow_box.cxx.o.d"
+  "/root/repo/src/fl_shortcut.cxx" "src/CMakeFiles/fltk.dir/fl_shortcut.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_shortcut.cxx.o.d"
+  "/root/repo/src/fl_show_colormap.cxx" "src/CMakeFiles/fltk.dir/fl_show_colormap.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_show_colormap.cxx.o.d"
+  "/root/repo/src/fl_string.cxx" "src/CMakeFiles/fltk.dir/fl_string.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_string.cxx.o.d"
+  "/root/repo/src/fl_symbols.cxx" "src/CMakeFiles/fltk.dir/fl_symbols.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_symbols.cxx.o.d"
+  "/root/repo/src/fl_utf8.cxx" "src/CMakeFiles/fltk.dir/fl_utf8.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_utf8.cxx.o.d"
+  "/root/repo/src/fl_vertex.cxx" "src/CMakeFiles/fltk.dir/fl_vertex.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/fl_vertex.cxx.o.d"
+  "/root/repo/src/screen_xywh.cxx" "src/CMakeFiles/fltk.dir/screen_xywh.cxx.o" "gcc" "src/CMakeFiles/fltk.dir/screen_xywh.cxx.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
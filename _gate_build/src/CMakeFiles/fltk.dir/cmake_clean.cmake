@@ -0,0 +1,367 @@
+file(REMOVE_RECURSE
+  "../lib/libfltk.a"
+  "../lib/libfltk.pdb"
+  "CMakeFiles/fltk.dir/Fl.cxx.o"
+  "CMakeFiles/fltk.dir/Fl.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Adjuster.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Adjuster.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Bitmap.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Bitmap.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Box.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Box.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Browser.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Browser.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Browser_.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Browser_.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Browser_load.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Browser_load.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Button.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Button.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Chart.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Chart.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Check_Browser.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Check_Browser.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Check_Button.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Check_Button.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Choice.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Choice.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Clock.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Clock.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Color_Chooser.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Color_Chooser.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Copy_Surface.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Copy_Surface.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Counter.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Counter.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Device.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Device.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Dial.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Dial.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Double_Window.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Double_Window.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_File_Browser.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_File_Browser.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_File_Chooser.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_File_Chooser.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_File_Chooser2.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_File_Chooser2.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_File_Icon.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_File_Icon.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_File_Input.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_File_Input.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Flb_Loader.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Flb_Loader.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Graphics_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Graphics_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Group.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Group.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Help_Dialog_Dox.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Help_Dialog_Dox.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Help_View.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Help_View.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Image.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Image.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Image_Surface.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Image_Surface.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Input.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Input.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Input_.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Input_.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Input_Choice.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Input_Choice.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Light_Button.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Light_Button.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Menu.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Menu.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Menu_.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Menu_.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Menu_Bar.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Menu_Bar.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Menu_Button.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Menu_Button.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Menu_Window.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Menu_Window.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Menu_add.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Menu_add.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Menu_global.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Menu_global.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Multi_Label.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Multi_Label.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Native_File_Chooser.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Native_File_Chooser.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Native_File_Chooser_FLTK.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Native_File_Chooser_FLTK.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Native_File_Chooser_GTK.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Native_File_Chooser_GTK.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Overlay_Window.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Overlay_Window.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Pack.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Pack.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Paged_Device.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Paged_Device.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Pixmap.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Pixmap.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Positioner.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Positioner.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Preferences.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Preferences.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Printer.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Printer.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Progress.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Progress.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Recording_Surface.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Recording_Surface.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Repeat_Button.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Repeat_Button.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Return_Button.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Return_Button.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Roller.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Roller.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Round_Button.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Round_Button.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Screen_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Screen_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Scroll.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Scroll.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Scrollbar.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Scrollbar.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Shared_Image.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Shared_Image.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Simple_Terminal.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Simple_Terminal.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Single_Window.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Single_Window.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Slider.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Slider.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Spinner.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Spinner.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Sys_Menu_Bar.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Sys_Menu_Bar.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_System_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_System_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Table.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Table.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Table_Row.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Table_Row.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tabs.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tabs.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Text_Buffer.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Text_Buffer.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Text_Display.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Text_Display.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Text_Editor.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Text_Editor.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tile.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tile.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tiled_Image.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tiled_Image.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tooltip.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tooltip.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tree.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tree.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tree_Item.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tree_Item.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tree_Item_Array.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tree_Item_Array.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Tree_Prefs.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Tree_Prefs.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Valuator.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Valuator.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Value_Input.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Value_Input.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Value_Output.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Value_Output.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Value_Slider.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Value_Slider.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Virtual_Browser.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Virtual_Browser.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Widget.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Widget.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Widget_Surface.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Widget_Surface.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Window.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Window.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Window_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Window_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Window_fullscreen.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Window_fullscreen.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Window_hotspot.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Window_hotspot.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Window_iconize.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Window_iconize.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_Wizard.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_Wizard.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_XBM_Image.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_XBM_Image.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_XPM_Image.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_XPM_Image.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_abort.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_abort.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_add_idle.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_add_idle.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_arg.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_arg.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_compose.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_compose.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_display.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_display.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_get_key.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_get_key.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_get_system_colors.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_get_system_colors.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_grab.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_grab.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_lock.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_lock.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_own_colormap.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_own_colormap.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_visual.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_visual.cxx.o.d"
+  "CMakeFiles/fltk.dir/Fl_x.cxx.o"
+  "CMakeFiles/fltk.dir/Fl_x.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_Printer_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_Printer_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_System_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Posix/Fl_Posix_System_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript_image.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/PostScript/Fl_PostScript_image.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Screen_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Screen_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/X11/Fl_X11_System_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/X11/Fl_X11_System_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Window_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/X11/Fl_X11_Window_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Copy_Surface_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Copy_Surface_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_arci.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_arci.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_color.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_color.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_font_xft.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_font_xft.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_image.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_image.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_line_style.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_line_style.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_rect.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_rect.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_vertex.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Graphics_Driver_vertex.cxx.o.d"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Image_Surface_Driver.cxx.o"
+  "CMakeFiles/fltk.dir/drivers/Xlib/Fl_Xlib_Image_Surface_Driver.cxx.o.d"
+  "CMakeFiles/fltk.dir/filename_absolute.cxx.o"
+  "CMakeFiles/fltk.dir/filename_absolute.cxx.o.d"
+  "CMakeFiles/fltk.dir/filename_expand.cxx.o"
+  "CMakeFiles/fltk.dir/filename_expand.cxx.o.d"
+  "CMakeFiles/fltk.dir/filename_ext.cxx.o"
+  "CMakeFiles/fltk.dir/filename_ext.cxx.o.d"
+  "CMakeFiles/fltk.dir/filename_isdir.cxx.o"
+  "CMakeFiles/fltk.dir/filename_isdir.cxx.o.d"
+  "CMakeFiles/fltk.dir/filename_list.cxx.o"
+  "CMakeFiles/fltk.dir/filename_list.cxx.o.d"
+  "CMakeFiles/fltk.dir/filename_match.cxx.o"
+  "CMakeFiles/fltk.dir/filename_match.cxx.o.d"
+  "CMakeFiles/fltk.dir/filename_setext.cxx.o"
+  "CMakeFiles/fltk.dir/filename_setext.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_arc.cxx.o"
+  "CMakeFiles/fltk.dir/fl_arc.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_ask.cxx.o"
+  "CMakeFiles/fltk.dir/fl_ask.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_boxtype.cxx.o"
+  "CMakeFiles/fltk.dir/fl_boxtype.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_cached_box.cxx.o"
+  "CMakeFiles/fltk.dir/fl_cached_box.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_color.cxx.o"
+  "CMakeFiles/fltk.dir/fl_color.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_cursor.cxx.o"
+  "CMakeFiles/fltk.dir/fl_cursor.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_curve.cxx.o"
+  "CMakeFiles/fltk.dir/fl_curve.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_diamond_box.cxx.o"
+  "CMakeFiles/fltk.dir/fl_diamond_box.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_dnd_x.cxx.o"
+  "CMakeFiles/fltk.dir/fl_dnd_x.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_draw.cxx.o"
+  "CMakeFiles/fltk.dir/fl_draw.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_draw_pixmap.cxx.o"
+  "CMakeFiles/fltk.dir/fl_draw_pixmap.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_encoding_latin1.cxx.o"
+  "CMakeFiles/fltk.dir/fl_encoding_latin1.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_encoding_mac_roman.cxx.o"
+  "CMakeFiles/fltk.dir/fl_encoding_mac_roman.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_engraved_label.cxx.o"
+  "CMakeFiles/fltk.dir/fl_engraved_label.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_file_dir.cxx.o"
+  "CMakeFiles/fltk.dir/fl_file_dir.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_font.cxx.o"
+  "CMakeFiles/fltk.dir/fl_font.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_gleam.cxx.o"
+  "CMakeFiles/fltk.dir/fl_gleam.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_gtk.cxx.o"
+  "CMakeFiles/fltk.dir/fl_gtk.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_labeltype.cxx.o"
+  "CMakeFiles/fltk.dir/fl_labeltype.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_open_uri.cxx.o"
+  "CMakeFiles/fltk.dir/fl_open_uri.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_oval_box.cxx.o"
+  "CMakeFiles/fltk.dir/fl_oval_box.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_overlay.cxx.o"
+  "CMakeFiles/fltk.dir/fl_overlay.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_overlay_visual.cxx.o"
+  "CMakeFiles/fltk.dir/fl_overlay_visual.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_plastic.cxx.o"
+  "CMakeFiles/fltk.dir/fl_plastic.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_read_image.cxx.o"
+  "CMakeFiles/fltk.dir/fl_read_image.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_rect.cxx.o"
+  "CMakeFiles/fltk.dir/fl_rect.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_round_box.cxx.o"
+  "CMakeFiles/fltk.dir/fl_round_box.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_rounded_box.cxx.o"
+  "CMakeFiles/fltk.dir/fl_rounded_box.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_scroll_area.cxx.o"
+  "CMakeFiles/fltk.dir/fl_scroll_area.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_set_font.cxx.o"
+  "CMakeFiles/fltk.dir/fl_set_font.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_shadow_box.cxx.o"
+  "CMakeFiles/fltk.dir/fl_shadow_box.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_shortcut.cxx.o"
+  "CMakeFiles/fltk.dir/fl_shortcut.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_show_colormap.cxx.o"
+  "CMakeFiles/fltk.dir/fl_show_colormap.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_string.cxx.o"
+  "CMakeFiles/fltk.dir/fl_string.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_symbols.cxx.o"
+  "CMakeFiles/fltk.dir/fl_symbols.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_utf8.cxx.o"
+  "CMakeFiles/fltk.dir/fl_utf8.cxx.o.d"
+  "CMakeFiles/fltk.dir/fl_vertex.cxx.o"
+  "CMakeFiles/fltk.dir/fl_vertex.cxx.o.d"
+  "CMakeFiles/fltk.dir/flstring.c.o"
+  "CMakeFiles/fltk.dir/flstring.c.o.d"
+  "CMakeFiles/fltk.dir/numericsort.c.o"
+  "CMakeFiles/fltk.dir/numericsort.c.o.d"
+  "CMakeFiles/fltk.dir/scandir_posix.c.o"
+  "CMakeFiles/fltk.dir/scandir_posix.c.o.d"
+  "CMakeFiles/fltk.dir/screen_xywh.cxx.o"
+  "CMakeFiles/fltk.dir/screen_xywh.cxx.o.d"
+  "CMakeFiles/fltk.dir/vsnprintf.c.o"
+  "CMakeFiles/fltk.dir/vsnprintf.c.o.d"
+  "CMakeFiles/fltk.dir/xutf8/case.c.o"
+  "CMakeFiles/fltk.dir/xutf8/case.c.o.d"
+  "CMakeFiles/fltk.dir/xutf8/is_right2left.c.o"
+  "CMakeFiles/fltk.dir/xutf8/is_right2left.c.o.d"
+  "CMakeFiles/fltk.dir/xutf8/is_spacing.c.o"
+  "CMakeFiles/fltk.dir/xutf8/is_spacing.c.o.d"
+  "CMakeFiles/fltk.dir/xutf8/keysym2Ucs.c.o"
+  "CMakeFiles/fltk.dir/xutf8/keysym2Ucs.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/fltk.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
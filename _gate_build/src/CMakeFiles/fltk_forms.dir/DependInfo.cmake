@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/forms_bitmap.cxx" "src/CMakeFiles/fltk_forms.dir/forms_bitmap.cxx.o" "gcc" "src/CMakeFiles/fltk_forms.dir/forms_bitmap.cxx.o.d"
+  "/root/repo/src/forms_compatibility.cxx" "src/CMakeFiles/fltk_forms.dir/forms_compatibility.cxx.o" "gcc" "src/CMakeFiles/fltk_forms.dir/forms_compatibility.cxx.o.d"
+  "/root/repo/src/forms_free.cxx" "src/CMakeFiles/fltk_forms.dir/forms_free.cxx.o" "gcc" "src/CMakeFiles/fltk_forms.dir/forms_free.cxx.o.d"
+  "/root/repo/src/forms_fselect.cxx" "src/CMakeFiles/fltk_forms.dir/forms_fselect.cxx.o" "gcc" "src/CMakeFiles/fltk_forms.dir/forms_fselect.cxx.o.d"
+  "/root/repo/src/forms_pixmap.cxx" "src/CMakeFiles/fltk_forms.dir/forms_pixmap.cxx.o" "gcc" "src/CMakeFiles/fltk_forms.dir/forms_pixmap.cxx.o.d"
+  "/root/repo/src/forms_timer.cxx" "src/CMakeFiles/fltk_forms.dir/forms_timer.cxx.o" "gcc" "src/CMakeFiles/fltk_forms.dir/forms_timer.cxx.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/CMakeFiles/fltk.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "../lib/libfltk_forms.a"
+  "../lib/libfltk_forms.pdb"
+  "CMakeFiles/fltk_forms.dir/forms_bitmap.cxx.o"
+  "CMakeFiles/fltk_forms.dir/forms_bitmap.cxx.o.d"
+  "CMakeFiles/fltk_forms.dir/forms_compatibility.cxx.o"
+  "CMakeFiles/fltk_forms.dir/forms_compatibility.cxx.o.d"
+  "CMakeFiles/fltk_forms.dir/forms_free.cxx.o"
+  "CMakeFiles/fltk_forms.dir/forms_free.cxx.o.d"
+  "CMakeFiles/fltk_forms.dir/forms_fselect.cxx.o"
+  "CMakeFiles/fltk_forms.dir/forms_fselect.cxx.o.d"
+  "CMakeFiles/fltk_forms.dir/forms_pixmap.cxx.o"
+  "CMakeFiles/fltk_forms.dir/forms_pixmap.cxx.o.d"
+  "CMakeFiles/fltk_forms.dir/forms_timer.cxx.o"
+  "CMakeFiles/fltk_forms.dir/forms_timer.cxx.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fltk_forms.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,39 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Fl_Gl_Choice.cxx" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Choice.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Choice.cxx.o.d"
+  "/root/repo/src/Fl_Gl_Device_Plugin.cxx" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Device_Plugin.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Device_Plugin.cxx.o.d"
+  "/root/repo/src/Fl_Gl_Overlay.cxx" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Overlay.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Overlay.cxx.o.d"
+  "/root/repo/src/Fl_Gl_Window.cxx" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Window.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/Fl_Gl_Window.cxx.o.d"
+  "/root/repo/src/drivers/OpenGL/Fl_OpenGL_Display_Device.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Display_Device.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Display_Device.cxx.o.d"
+  "/root/repo/src/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_arci.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_arci.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_arci.cxx.o.d"
+  "/root/repo/src/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_color.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_color.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_color.cxx.o.d"
+  "/root/repo/src/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_font.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_font.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_font.cxx.o.d"
+  "/root/repo/src/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_line_style.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_line_style.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_line_style.cxx.o.d"
+  "/root/repo/src/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_rect.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_rect.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_rect.cxx.o.d"
+  "/root/repo/src/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_vertex.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_vertex.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_vertex.cxx.o.d"
+  "/root/repo/src/drivers/X11/Fl_X11_Gl_Window_Driver.cxx" "src/CMakeFiles/fltk_gl.dir/drivers/X11/Fl_X11_Gl_Window_Driver.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/drivers/X11/Fl_X11_Gl_Window_Driver.cxx.o.d"
+  "/root/repo/src/freeglut_geometry.cxx" "src/CMakeFiles/fltk_gl.dir/freeglut_geometry.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/freeglut_geometry.cxx.o.d"
+  "/root/repo/src/freeglut_stroke_mono_roman.cxx" "src/CMakeFiles/fltk_gl.dir/freeglut_stroke_mono_roman.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/freeglut_stroke_mono_roman.cxx.o.d"
+  "/root/repo/src/freeglut_stroke_roman.cxx" "src/CMakeFiles/fltk_gl.dir/freeglut_stroke_roman.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/freeglut_stroke_roman.cxx.o.d"
+  "/root/repo/src/freeglut_teapot.cxx" "src/CMakeFiles/fltk_gl.dir/freeglut_teapot.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/freeglut_teapot.cxx.o.d"
+  "/root/repo/src/gl_draw.cxx" "src/CMakeFiles/fltk_gl.dir/gl_draw.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/gl_draw.cxx.o.d"
+  "/root/repo/src/gl_start.cxx" "src/CMakeFiles/fltk_gl.dir/gl_start.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/gl_start.cxx.o.d"
+  "/root/repo/src/glut_compatibility.cxx" "src/CMakeFiles/fltk_gl.dir/glut_compatibility.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/glut_compatibility.cxx.o.d"
+  "/root/repo/src/glut_font.cxx" "src/CMakeFiles/fltk_gl.dir/glut_font.cxx.o" "gcc" "src/CMakeFiles/fltk_gl.dir/glut_font.cxx.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/CMakeFiles/fltk.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,49 @@
+file(REMOVE_RECURSE
+  "../lib/libfltk_gl.a"
+  "../lib/libfltk_gl.pdb"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Choice.cxx.o"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Choice.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Device_Plugin.cxx.o"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Device_Plugin.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Overlay.cxx.o"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Overlay.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Window.cxx.o"
+  "CMakeFiles/fltk_gl.dir/Fl_Gl_Window.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Display_Device.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Display_Device.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_arci.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_arci.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_color.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_color.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_font.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_font.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_line_style.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_line_style.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_rect.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_rect.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_vertex.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/OpenGL/Fl_OpenGL_Graphics_Driver_vertex.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/drivers/X11/Fl_X11_Gl_Window_Driver.cxx.o"
+  "CMakeFiles/fltk_gl.dir/drivers/X11/Fl_X11_Gl_Window_Driver.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/freeglut_geometry.cxx.o"
+  "CMakeFiles/fltk_gl.dir/freeglut_geometry.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/freeglut_stroke_mono_roman.cxx.o"
+  "CMakeFiles/fltk_gl.dir/freeglut_stroke_mono_roman.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/freeglut_stroke_roman.cxx.o"
+  "CMakeFiles/fltk_gl.dir/freeglut_stroke_roman.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/freeglut_teapot.cxx.o"
+  "CMakeFiles/fltk_gl.dir/freeglut_teapot.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/gl_draw.cxx.o"
+  "CMakeFiles/fltk_gl.dir/gl_draw.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/gl_start.cxx.o"
+  "CMakeFiles/fltk_gl.dir/gl_start.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/glut_compatibility.cxx.o"
+  "CMakeFiles/fltk_gl.dir/glut_compatibility.cxx.o.d"
+  "CMakeFiles/fltk_gl.dir/glut_font.cxx.o"
+  "CMakeFiles/fltk_gl.dir/glut_font.cxx.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fltk_gl.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
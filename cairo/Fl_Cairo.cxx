@@ -76,16 +76,29 @@ cairo_t * Fl::cairo_make_current(Fl_Window* wi) {
         return 0;
     }
 
+#ifndef __APPLE__
+  float scale = Fl::screen_scale(wi->screen_num()); // get the screen scaling factor
+#endif
     // don't re-create a context if it's the same gc/window couple
-    if (fl_gc==Fl::cairo_state_.gc() && fl_xid(wi) == (Window) Fl::cairo_state_.window())
+    if (fl_gc==Fl::cairo_state_.gc() && wi == (Fl_Window*) Fl::cairo_state_.window() &&
+        Fl::cairo_cc() != 0) {
+#if defined(USE_X11)
+        // the target surface tracks the window; only its size may have changed
+        cairo_xlib_surface_set_size(cairo_get_target(Fl::cairo_cc()),
+                                    int(wi->w() * scale), int(wi->h() * scale));
+#endif
+        // give every draw pass the same initial transformation, whatever
+        // the previous pass left in the context
+        cairo_identity_matrix(Fl::cairo_cc());
+#ifndef __APPLE__
+        cairo_scale(Fl::cairo_cc(), scale, scale);
+#endif
         return Fl::cairo_cc();
+    }
 
     cairo_state_.window(wi);
 
   cairo_t * cairo_ctxt;
-#ifndef __APPLE__
-  float scale = Fl::screen_scale(wi->screen_num()); // get the screen scaling factor
-#endif
 #if defined(USE_X11)
   cairo_ctxt = Fl::cairo_make_current(0, wi->w() * scale, wi->h() * scale);
 #else
@@ -169,7 +182,10 @@ cairo_t * Fl::cairo_make_current(void *gc, int W, int H) {
         return cairo_state_.cc();
 
     // we need to (re-)create a fresh cc ...
-    cairo_state_.gc(gc); // keep track for next time
+    // Note: on X11 the surface is built from fl_display/fl_window and the
+    // gc argument is null; keep track of fl_gc so that the reuse test in
+    // cairo_make_current(Fl_Window*) can recognize the gc/window couple.
+    cairo_state_.gc(fl_gc); // keep track for next time
     cairo_surface_t * s = cairo_create_surface(gc, W, H);
     cairo_t * c = cairo_create(s);
     cairo_state_.cc(c); //  and purge any previously owned context
@@ -0,0 +1,166 @@
+//
+// Binary dialog file ('.flb') output for the Fast Light User Interface
+// Designer (FLUID).
+//
+// Copyright 1998-2021 by Bill Spitzak and others.
+//
+// This library is free software. Distribution and use rights are outlined in
+// the file "COPYING" which should have been included with this file.  If this
+// file is missing or damaged, see the license at:
+//
+//     https://www.fltk.org/COPYING.php
+//
+// Please see the following page on how to report bugs and issues:
+//
+//     https://www.fltk.org/bugs.php
+//
+
+// Writes the widget tree in the compact binary form read at run time by
+// Fl_Flb_Loader, which also documents the format (see FL/Fl_Flb_Loader.H).
+// Only the widget tree is written: functions, code blocks and declarations
+// have no meaning at run time, and a widget's callback is written by name
+// so the application can bind it with Fl_Flb_Loader::symbol().
+
+#include <FL/Fl.H>
+#include <FL/Fl_Flb_Loader.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Valuator.H>
+#include <FL/Fl_Spinner.H>
+#include <FL/Fl_Progress.H>
+#include <FL/fl_utf8.h>
+#include "Fl_Type.h"
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+static FILE *fbout;
+
+static void wbyte(unsigned char c) {
+  fputc(c, fbout);
+}
+
+static void wint(unsigned v) { // little endian
+  fputc(v & 255, fbout);
+  fputc((v >> 8) & 255, fbout);
+  fputc((v >> 16) & 255, fbout);
+  fputc((v >> 24) & 255, fbout);
+}
+
+static void wstr(const char *s) {
+  unsigned n = s ? (unsigned)strlen(s) : 0;
+  if (n > 65535) n = 65535;
+  fputc(n & 255, fbout);
+  fputc((n >> 8) & 255, fbout);
+  if (n) fwrite(s, 1, n, fbout);
+}
+
+static void wdouble(double d) { // as text, so the format has no endianness
+  char buf[64];
+  sprintf(buf, "%.17g", d);
+  wstr(buf);
+}
+
+// Returns the callback if it is a plain function name that the loader can
+// bind by symbol; inline callback bodies ("{...}") cannot be stored.
+static const char *bindable_callback(Fl_Type *t) {
+  const char *cb = t->callback();
+  if (!cb || !*cb) return 0;
+  if (!isalpha(*cb & 255) && *cb != '_') return 0;
+  for (const char *s = cb; *s; s++)
+    if (!isalnum(*s & 255) && *s != '_') return 0;
+  return cb;
+}
+
+// Writes one widget (or menu item) record.
+static void write_flb_widget(Fl_Widget_Type *t) {
+  Fl_Widget *o = t->o;
+  wbyte(FL_FLB_TAG_WIDGET);
+  wstr(t->type_name());
+  wstr(t->name());
+  wstr(t->label());
+  wstr(bindable_callback(t));
+  wstr(t->tooltip());
+  if (o) {
+    wint(o->x()); wint(o->y()); wint(o->w()); wint(o->h());
+    // for menu items 'type' holds the FL_MENU_* flags instead
+    wint(t->is_menu_item() ? ((Fl_Menu_Item_Type*)t)->flags() : o->type());
+    wint(o->box());
+    wint(o->color());
+    wint(o->selection_color());
+    wint(o->labelfont());
+    wint(o->labelsize());
+    wint(o->labelcolor());
+    wint(o->align());
+    wint(o->when());
+  } else { // menu items may have no widget
+    for (int i = 0; i < 4; i++) wint(0);
+    wint(t->is_menu_item() ? ((Fl_Menu_Item_Type*)t)->flags() : 0);
+    for (int i = 0; i < 8; i++) wint(0);
+  }
+
+  Fl_Font tf; int ts; Fl_Color tc;
+  int has_text = t->textstuff(0, tf, ts, tc);
+  int has_values = o && (t->is_valuator() || t->is_spinner() ||
+                         (t->is_button() && !t->is_menu_item()) ||
+                         strcmp(t->type_name(), "Fl_Progress") == 0);
+
+  unsigned flags = 0;
+  if (o && !o->visible()) flags |= FL_FLB_FLAG_HIDDEN;
+  if (o && !o->active()) flags |= FL_FLB_FLAG_DEACTIVATED;
+  if (t->resizable()) flags |= FL_FLB_FLAG_RESIZABLE;
+  if (t->hotspot()) flags |= FL_FLB_FLAG_HOTSPOT;
+  if (t->is_parent()) flags |= FL_FLB_FLAG_CHILDREN;
+  if (has_values) flags |= FL_FLB_FLAG_VALUES;
+  if (has_text) flags |= FL_FLB_FLAG_TEXT;
+  wbyte((unsigned char)flags);
+
+  if (has_values) {
+    double v[4] = { 0.0, 0.0, 0.0, 0.0 };
+    if (t->is_valuator()) {
+      Fl_Valuator *vo = (Fl_Valuator*)o;
+      v[0] = vo->minimum(); v[1] = vo->maximum();
+      v[2] = vo->step(); v[3] = vo->value();
+    } else if (t->is_spinner()) {
+      Fl_Spinner *so = (Fl_Spinner*)o;
+      v[0] = so->minimum(); v[1] = so->maximum();
+      v[2] = so->step(); v[3] = so->value();
+    } else if (t->is_button()) {
+      v[3] = ((Fl_Button*)o)->value();
+    } else { // Fl_Progress
+      Fl_Progress *po = (Fl_Progress*)o;
+      v[0] = po->minimum(); v[1] = po->maximum(); v[3] = po->value();
+    }
+    for (int i = 0; i < 4; i++) wdouble(v[i]);
+  }
+  if (has_text) {
+    wint(tf);
+    wint(ts);
+    wint(tc);
+  }
+}
+
+// Writes the widget tree to 'filename'. Returns 0 on failure (like
+// write_file() in file.cxx).
+int write_flb_file(const char *filename) {
+  fbout = fl_fopen(filename, "wb");
+  if (!fbout) return 0;
+  fwrite(FL_FLB_MAGIC, 1, 4, fbout);
+  // open parent widgets, so the tree nesting becomes begin/end records
+  int open_levels[256];
+  int depth = 0;
+  for (Fl_Type *p = Fl_Type::first; p; p = p->next) {
+    while (depth && open_levels[depth-1] >= p->level) {
+      wbyte(FL_FLB_TAG_END);
+      depth--;
+    }
+    if (!p->is_widget()) continue;
+    write_flb_widget((Fl_Widget_Type*)p);
+    if (p->is_parent() && depth < (int)(sizeof(open_levels)/sizeof(int)))
+      open_levels[depth++] = p->level;
+  }
+  while (depth--) wbyte(FL_FLB_TAG_END);
+  wbyte(FL_FLB_TAG_EOF);
+  int ret = fclose(fbout) == 0;
+  fbout = 0;
+  return ret;
+}
@@ -362,6 +362,11 @@ void save_template_cb(Fl_Widget *, void *) {
   png_init_io(pptr, fp);
   png_set_IHDR(pptr, iptr, w, h, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
                PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+  // the screenshot is rewritten on every save: favor encode speed over the
+  // last few percent of compression (SUB filtering alone works well for
+  // rendered UI content, and skips trying all five filters on every row)
+  png_set_compression_level(pptr, 3);
+  png_set_filter(pptr, 0, PNG_FILTER_SUB);
   png_set_sRGB(pptr, iptr, PNG_sRGB_INTENT_PERCEPTUAL);
 
   png_write_info(pptr, iptr);
@@ -692,6 +697,7 @@ int exit_early = 0;
 int update_file = 0;            // fluid -u
 int compile_file = 0;           // fluid -c
 int compile_strings = 0;        // fluic -cs
+int binary_file = 0;            // fluid -b
 int batch_mode = 0;             // if set (-c, -u) don't open display
 int header_file_set = 0;
 int code_file_set = 0;
@@ -741,6 +747,31 @@ void write_cb(Fl_Widget *, void *) {
   }
 }
 
+extern int write_flb_file(const char *); // in binary.cxx
+
+// Writes the binary dialog file read at run time by Fl_Flb_Loader
+void write_flb_cb(Fl_Widget *, void *) {
+  if (!filename) {
+    save_cb(0,0);
+    if (!filename) return;
+  }
+  char bname[FL_PATH_MAX];
+  strlcpy(bname, fl_filename_name(filename), sizeof(bname));
+  fl_filename_setext(bname, sizeof(bname), ".flb");
+  if (!batch_mode) goto_source_dir();
+  int x = write_flb_file(bname);
+  if (!batch_mode) leave_source_dir();
+  if (batch_mode) {
+    if (!x) {fprintf(stderr,"%s : %s\n",bname,strerror(errno)); exit(1);}
+  } else {
+    if (!x) {
+      fl_message("Can't write %s: %s", bname, strerror(errno));
+    } else if (completion_button->value()) {
+      fl_message("Wrote %s", bname);
+    }
+  }
+}
+
 void write_strings_cb(Fl_Widget *, void *) {
   static const char *exts[] = { ".txt", ".po", ".msg" };
   if (!filename) {
@@ -1056,6 +1087,7 @@ Fl_Menu_Item Main_Menu[] = {
   {"Save As &Template...", 0, save_template_cb, 0, FL_MENU_DIVIDER},
   {"&Print...", FL_COMMAND+'p', print_menu_cb},
   {"Write &Code...", FL_COMMAND+FL_SHIFT+'c', write_cb, 0},
+  {"Write &Binary...", FL_COMMAND+FL_SHIFT+'b', write_flb_cb, 0},
   {"&Write Strings...", FL_COMMAND+FL_SHIFT+'w', write_strings_cb, 0, FL_MENU_DIVIDER},
   {relative_history[0], FL_COMMAND+'0', open_history_cb, absolute_history[0]},
   {relative_history[1], FL_COMMAND+'1', open_history_cb, absolute_history[1]},
@@ -1702,6 +1734,7 @@ static int arg(int argc, char** argv, int& i) {
   if (argv[i][1] == 'd' && !argv[i][2]) {G_debug=1; i++; return 1;}
   if (argv[i][1] == 'u' && !argv[i][2]) {update_file++; batch_mode++; i++; return 1;}
   if (argv[i][1] == 'c' && !argv[i][2]) {compile_file++; batch_mode++; i++; return 1;}
+  if (argv[i][1] == 'b' && !argv[i][2]) {binary_file++; batch_mode++; i++; return 1;}
   if (argv[i][1] == 'c' && argv[i][2] == 's' && !argv[i][3]) {compile_file++; compile_strings++; batch_mode++; i++; return 1;}
   if (argv[i][1] == 'o' && !argv[i][2] && i+1 < argc) {
     code_file_name = argv[i+1];
@@ -1758,6 +1791,7 @@ int main(int argc,char **argv) {
       "usage: %s <switches> name.fl\n"
       " -u : update .fl file and exit (may be combined with '-c' or '-cs')\n"
       " -c : write .cxx and .h and exit\n"
+      " -b : write binary dialog (.flb) file for Fl_Flb_Loader and exit\n"
       " -cs : write .cxx and .h and strings and exit\n"
       " -o <name> : .cxx output filename, or extension if <name> starts with '.'\n"
       " -h <name> : .h output filename, or extension if <name> starts with '.'\n"
@@ -1827,6 +1861,12 @@ int main(int argc,char **argv) {
       exit(0);
   }
 
+  if (binary_file) {            // fluid -b
+    write_flb_cb(0,0);
+    if (!compile_file)
+      exit(0);
+  }
+
   if (compile_file) {           // fluid -c[s]
     if (compile_strings)
       write_strings_cb(0,0);
@@ -27,14 +27,12 @@
 #include <FL/Fl_Tooltip.H>
 #include <FL/fl_draw.H>
 
+#include <FL/fl_utf8.h> // fl_fopen()
 #include <ctype.h>
 #include <stdlib.h>
+#include <stdio.h>
 #include "flstring.h"
 
-#if defined(DEBUG) || defined(DEBUG_WATCH)
-#  include <stdio.h>
-#endif // DEBUG || DEBUG_WATCH
-
 //
 // Globals...
 //
@@ -259,6 +257,16 @@ void Fl::remove_timeout(Fl_Timeout_Handler cb, void *argp) {
   Fl::screen_driver()->remove_timeout(cb, argp);
 }
 
+/**
+ Returns the number of pending timeout callbacks.
+
+ This is meant for instrumentation of applications that create many
+ timeouts; platforms that do not track this return 0.
+ */
+int Fl::timer_count() {
+  return Fl::screen_driver()->timer_count();
+}
+
 
 
 ////////////////////////////////////////////////////////////////
@@ -276,6 +284,8 @@ struct Check {
 };
 static Check *first_check, *next_check, *free_check;
 
+extern Fl_Perf_Counters fl_perf_counters; // defined below
+
 /**
   FLTK will call this callback just before it flushes the display and
   waits for events.  This is different than an idle callback because it
@@ -309,8 +319,8 @@ static Check *first_check, *next_check, *free_check;
 */
 void Fl::add_check(Fl_Timeout_Handler cb, void *argp) {
   Check* t = free_check;
-  if (t) free_check = t->next;
-  else t = new Check;
+  if (t) {free_check = t->next; fl_perf_counters.pool_reuses++;}
+  else {t = new Check; fl_perf_counters.pool_allocs++;}
   t->cb = cb;
   t->arg = argp;
   t->next = first_check;
@@ -443,9 +453,276 @@ void (*Fl::idle)(); // see Fl::add_idle.cxx for the add/remove functions
  It is zero if nothing happens.  It is negative if an error
  occurs (this will happen on X11 if a signal happens).
 */
+// Frame scheduler state (see Fl::frame_rate()): when enabled, Fl::flush()
+// repaints at most once per frame period. Damage accumulates between frames
+// and Fl::wait() never sleeps past the next frame deadline, so event
+// handling gets the remainder of each frame budget.
+static double frame_period = 0.0; // seconds per frame, 0 = scheduler off
+static double frame_due = 0.0;    // earliest time the next flush may run
+
+static double frame_clock() {
+  time_t sec; int usec;
+  Fl::system_driver()->gettime(&sec, &usec);
+  return double(sec) + usec / 1000000.;
+}
+
+/**
+  Limits how often Fl::flush() repaints damaged windows.
+
+  With a frame rate of \p fps frames per second, damage accumulates until
+  the current frame period has elapsed and is then repainted in one batch,
+  and the event loop is woken no later than the next frame deadline. This
+  keeps continuously-animating windows from starving input processing:
+  events are handled for the remainder of each frame budget while repaints
+  happen at a steady \p fps.
+
+  Pass 0 (the default) to disable the scheduler and repaint damage on
+  every pass through the event loop.
+*/
+void Fl::frame_rate(double fps) {
+  frame_period = fps > 0 ? 1.0 / fps : 0.0;
+  frame_due = 0.0;
+}
+
+/** Returns the frame rate set with frame_rate(double), or 0 if the frame scheduler is off. */
+double Fl::frame_rate() {
+  return frame_period > 0 ? 1.0 / frame_period : 0.0;
+}
+
+// Frame callbacks are stored like the checks above: a list plus a freelist,
+// with next_frame_cb pointing at the next unprocessed entry so callbacks may
+// add and remove frame callbacks from inside one.
+
+struct Frame_Cb {
+  Fl_Frame_Handler cb;
+  void* data;
+  Frame_Cb* next;
+};
+static Frame_Cb *first_frame_cb, *next_frame_cb, *free_frame_cb;
+
+static void run_frame_callbacks(double frame_time) {
+  if (next_frame_cb == first_frame_cb) {
+    while (next_frame_cb) {
+      Frame_Cb* p = next_frame_cb;
+      next_frame_cb = p->next;
+      (p->cb)(frame_time, p->data);
+    }
+    next_frame_cb = first_frame_cb;
+  }
+}
+
+/**
+  Adds a callback that runs once per presented frame.
+
+  The callback is called from Fl::flush() just before the frame's damaged
+  windows are repainted, so widget state updated in it (typically followed
+  by Fl_Widget::redraw()) is drawn exactly once in that frame. \p frame_time
+  is the time the frame is presented, on the same clock used by the timeout
+  functions; advance animations by the difference between successive values
+  rather than by a nominal timer period.
+
+  With the frame scheduler enabled (Fl::frame_rate(double)) the callbacks
+  run once per frame period, and installing one keeps the event loop waking
+  at each frame deadline even while no damage is pending. With the
+  scheduler disabled they run whenever the event loop repaints, i.e. on
+  every pass through Fl::flush() - enable the scheduler to get a steady
+  clock.
+
+  This is meant to replace Fl::repeat_timeout() chains for animation, which
+  run on a clock unrelated to repainting and so can render twice or not at
+  all within one display frame.
+
+  \see Fl::frame_rate(double), Fl::remove_frame_callback()
+  \since 1.4.0
+*/
+void Fl::add_frame_callback(Fl_Frame_Handler cb, void *data) {
+  Frame_Cb* t = free_frame_cb;
+  if (t) {free_frame_cb = t->next; fl_perf_counters.pool_reuses++;}
+  else {t = new Frame_Cb; fl_perf_counters.pool_allocs++;}
+  t->cb = cb;
+  t->data = data;
+  t->next = first_frame_cb;
+  if (next_frame_cb == first_frame_cb) next_frame_cb = t;
+  first_frame_cb = t;
+}
+
+/**
+  Removes a frame callback. It is harmless to remove a frame callback
+  that no longer exists.
+
+  \since 1.4.0
+*/
+void Fl::remove_frame_callback(Fl_Frame_Handler cb, void *data) {
+  for (Frame_Cb** p = &first_frame_cb; *p;) {
+    Frame_Cb* t = *p;
+    if (t->cb == cb && t->data == data) {
+      if (next_frame_cb == t) next_frame_cb = t->next;
+      *p = t->next;
+      t->next = free_frame_cb;
+      free_frame_cb = t;
+    } else {
+      p = &(t->next);
+    }
+  }
+}
+
+/**
+  Returns 1 if the specified frame callback is currently installed.
+
+  \since 1.4.0
+*/
+int Fl::has_frame_callback(Fl_Frame_Handler cb, void *data) {
+  for (Frame_Cb* t = first_frame_cb; t; t = t->next) {
+    if (t->cb == cb && t->data == data) return 1;
+  }
+  return 0;
+}
+
+// Shared with the platform code that fires timeouts and with Fl_lock.cxx;
+// zero-initialized by static storage duration.
+Fl_Perf_Counters fl_perf_counters;
+
+/**
+  Returns the library's event loop activity counters.
+
+  The counters accumulate from program start, or from the last call to
+  perf_counters_reset(). The reference stays valid for the lifetime of the
+  program and always reflects the current values.
+
+  \see Fl_Perf_Counters
+  \since 1.4.0
+*/
+const Fl_Perf_Counters &Fl::perf_counters() {
+  return fl_perf_counters;
+}
+
+/**
+  Resets all event loop activity counters to zero.
+
+  \see Fl::perf_counters()
+  \since 1.4.0
+*/
+void Fl::perf_counters_reset() {
+  memset(&fl_perf_counters, 0, sizeof(fl_perf_counters));
+}
+
+////////////////////////////////////////////////////////////////
+// Per-widget draw profiling (see Fl::draw_profile(int)): samples land
+// in a fixed open-addressed table, so recording is a hash lookup and
+// two additions - cheap enough to leave running while reproducing a
+// slow frame.
+
+int Fl::draw_profile_ = 0;
+
+#define DRAW_PROFILE_SLOTS 256 // power of two
+
+static Fl_Draw_Profile_Entry draw_profile_table[DRAW_PROFILE_SLOTS];
+
+// Returns the profiling clock; the caller reads it before widget->draw()
+// and passes it to fl_draw_profile_record() afterwards.
+double fl_draw_profile_now() {
+  return frame_clock();
+}
+
+// Accumulates one draw of 'widget' that started at clock value 't0'.
+void fl_draw_profile_record(Fl_Widget *widget, double t0) {
+  double dt = frame_clock() - t0;
+  unsigned h = (unsigned)(((size_t)widget) >> 4);
+  for (int probe = 0; probe < 8; probe++) {
+    Fl_Draw_Profile_Entry &e = draw_profile_table[(h + probe) & (DRAW_PROFILE_SLOTS - 1)];
+    if (e.widget == widget) {
+      e.seconds += dt;
+      e.draws++;
+      e.label = widget->label();
+      return;
+    }
+    if (!e.widget) {
+      e.widget = widget;
+      e.label = widget->label();
+      e.seconds = dt;
+      e.draws = 1;
+      return;
+    }
+  }
+  // this table region is full: drop the sample, the hot widgets of a
+  // slow frame are drawn again and again and will be represented
+}
+
+/**
+  Starts or stops per-widget draw profiling.
+
+  While profiling is on, every widget drawn through the library - the
+  children visited by Fl_Group::draw_children() and the top-level
+  windows repainted by Fl::flush() - has the wall time of its draw()
+  recorded into a sampling table. Query the table with
+  Fl::draw_profile_hot() to see where a slow frame goes instead of
+  bisecting by commenting out widgets.
+
+  When off (the default) the only cost is one test per drawn widget.
+  Toggling does not clear already collected samples, so profiling can
+  be restricted to the interaction of interest; call
+  Fl::draw_profile_reset() to start a fresh measurement.
+
+  \param[in] onoff non-zero collects samples, 0 stops collecting
+
+  \since 1.4.0
+*/
+void Fl::draw_profile(int onoff) {
+  draw_profile_ = onoff;
+}
+
+/**
+  Retrieves the hottest widgets recorded by draw profiling.
+
+  Fills \p entries with up to \p num table rows, sorted by cumulative
+  draw time, hottest first. A group's time includes its children, so
+  containers naturally rank above the culprits inside them; compare a
+  group with its children to locate the expensive subtree.
+
+  \param[out] entries caller-provided array receiving the hot list
+  \param[in]  num     capacity of \p entries
+
+  \returns the number of entries written
+
+  \see Fl::draw_profile(int)
+  \since 1.4.0
+*/
+int Fl::draw_profile_hot(Fl_Draw_Profile_Entry *entries, int num) {
+  if (!entries || num <= 0) return 0;
+  int n = 0;
+  for (int i = 0; i < DRAW_PROFILE_SLOTS; i++) {
+    const Fl_Draw_Profile_Entry &e = draw_profile_table[i];
+    if (!e.widget) continue;
+    int pos = (n < num) ? n : num;
+    while (pos > 0 && entries[pos - 1].seconds < e.seconds) pos--;
+    if (pos >= num) continue; // colder than everything kept so far
+    for (int k = ((n < num) ? n : num - 1); k > pos; k--) entries[k] = entries[k - 1];
+    entries[pos] = e;
+    if (n < num) n++;
+  }
+  return n;
+}
+
+/**
+  Discards all collected draw profiling samples.
+
+  \see Fl::draw_profile(int)
+  \since 1.4.0
+*/
+void Fl::draw_profile_reset() {
+  memset(draw_profile_table, 0, sizeof(draw_profile_table));
+}
+
 double Fl::wait(double time_to_wait) {
   // delete all widgets that were listed during callbacks
   do_widget_deletion();
+  if (frame_period > 0 && (damage() || first_frame_cb)) {
+    // deferred damage or a frame callback is pending: wake up at the frame
+    // deadline at the latest
+    double remaining = frame_due - frame_clock();
+    if (remaining < 0.0) remaining = 0.0;
+    if (remaining < time_to_wait) time_to_wait = remaining;
+  }
   return screen_driver()->wait(time_to_wait);
 }
 
@@ -619,21 +896,53 @@ void Fl::redraw() {
   event queue.
 */
 void Fl::flush() {
+  if (frame_period > 0 && (damage() || first_frame_cb)) {
+    double now = frame_clock();
+    if (now < frame_due) return; // not due yet: let damage accumulate
+    // advance the deadline on a fixed grid, but resynchronize when we
+    // fell more than a whole frame behind
+    frame_due = (now - frame_due > frame_period) ? now + frame_period
+                                                 : frame_due + frame_period;
+  }
+  // frame callbacks run before the repaint below so the damage they flag
+  // is drawn in this same frame
+  if (first_frame_cb) run_frame_callbacks(frame_clock());
   if (damage()) {
     damage_ = 0;
-    for (Fl_X* i = Fl_X::first; i; i = i->next) {
-      Fl_Window* wi = i->w;
-      if (Fl_Window_Driver::driver(wi)->wait_for_expose_value) {damage_ = 1; continue;}
-      if (!wi->visible_r()) continue;
+    fl_perf_counters.flushes++;
+    // only walk the windows that Fl_Widget::damage() put on the dirty list:
+    Fl_Window* wi = Fl_Window_Driver::first_dirty();
+    while (wi) {
+      Fl_Window_Driver* dr = Fl_Window_Driver::driver(wi);
+      if (dr->wait_for_expose_value || !wi->visible_r()) {
+        // leave the window on the list; it is repainted when it can be
+        if (dr->wait_for_expose_value) damage_ = 1;
+        wi = dr->next_dirty();
+        continue;
+      }
       if (wi->damage()) {
-        Fl_Window_Driver::driver(wi)->flush();
+        if (draw_profile_) {
+          double t0 = fl_draw_profile_now();
+          dr->flush();
+          fl_draw_profile_record(wi, t0);
+        } else {
+          dr->flush();
+        }
         wi->clear_damage();
+        fl_perf_counters.window_flushes++;
       }
+      dr->clear_damage_rects();
       // destroy damage regions for windows that don't use them:
-      if (i->region) {
+      Fl_X* i = Fl_X::i(wi);
+      if (i && i->region) {
         fl_graphics_driver->XDestroyRegion(i->region);
         i->region = 0;
       }
+      // read the next pointer only after flushing: drawing code may have
+      // hidden or deleted other windows, which unlinks them from the list
+      Fl_Window* next = dr->next_dirty();
+      Fl_Window_Driver::remove_dirty(wi);
+      wi = next;
     }
   }
   screen_driver()->flush();
@@ -1139,8 +1448,268 @@ int Fl::handle(int e, Fl_Window* window)
 
  \see Fl::event_dispatch(Fl_Event_Dispatch)
  */
+////////////////////////////////////////////////////////////////
+// Event compression (Fl::event_compression()):
+// FL_MOVE/FL_DRAG and FL_MOUSEWHEEL events arriving faster than one per
+// motion_interval are not dispatched immediately; the newest one is kept
+// (wheel deltas are summed) and delivered either when the next event of a
+// different kind arrives, so ordering with clicks and keys is preserved,
+// or by a check callback at the end of the current event loop pass.
+
+static int event_compression_enabled = 1;
+static const double motion_interval = 0.005; // min seconds between dispatches
+static double motion_last_time = 0.0;
+static int pending_event = 0; // FL_MOVE, FL_DRAG or FL_MOUSEWHEEL, 0 = none
+static Fl_Window *pending_window = 0;
+static int pending_x, pending_y, pending_x_root, pending_y_root, pending_state;
+static int pending_dx, pending_dy;
+static char pending_flushing = 0;
+
+static void flush_pending_event(void* = 0) {
+  Fl::remove_check(flush_pending_event);
+  if (!pending_event) return;
+  int e = pending_event;
+  Fl_Window *win = pending_window;
+  pending_event = 0;
+  pending_window = 0;
+  // drop the event if the window was hidden or destroyed since it was
+  // queued: fl_throw_focus() clears fl_xmousewin in that case, just like
+  // the motion consolidation in the system handlers relies on
+  if (win != fl_xmousewin) return;
+  // save the state of the event being dispatched right now, if any: this
+  // may be called while another event's fields are already in place
+  int sx = Fl::e_x, sy = Fl::e_y, sxr = Fl::e_x_root, syr = Fl::e_y_root;
+  int sstate = Fl::e_state, sdx = Fl::e_dx, sdy = Fl::e_dy, snum = Fl::e_number;
+  Fl::e_x = pending_x;
+  Fl::e_y = pending_y;
+  Fl::e_x_root = pending_x_root;
+  Fl::e_y_root = pending_y_root;
+  Fl::e_state = pending_state;
+  if (e == FL_MOUSEWHEEL) {
+    Fl::e_dx = pending_dx;
+    Fl::e_dy = pending_dy;
+  }
+  pending_flushing = 1;
+  Fl::handle(e, win);
+  pending_flushing = 0;
+  Fl::e_x = sx; Fl::e_y = sy; Fl::e_x_root = sxr; Fl::e_y_root = syr;
+  Fl::e_state = sstate; Fl::e_dx = sdx; Fl::e_dy = sdy; Fl::e_number = snum;
+}
+
+/**
+  Enables or disables compression of motion and mouse wheel events.
+
+  When enabled (the default), consecutive FL_MOVE/FL_DRAG and
+  FL_MOUSEWHEEL events that arrive faster than the dispatch rate limit
+  (200 events per second) are coalesced: only the newest pointer position
+  is delivered and wheel deltas are summed, so a high-rate mouse does not
+  swamp widget handle() methods. The final event of a burst is always
+  delivered within the same event loop pass, and any other event flushes
+  a pending motion first, so ordering with clicks and keystrokes is
+  preserved.
+
+  Widgets that need every sample can opt out individually with
+  Fl_Widget::compress_events(0), which disables compression whenever such
+  a widget (or one of its parents) is the target.
+*/
+void Fl::event_compression(int enable) {
+  event_compression_enabled = enable;
+  if (!enable) flush_pending_event();
+}
+
+/** Returns whether motion and mouse wheel event compression is enabled, see event_compression(int). */
+int Fl::event_compression() {
+  return event_compression_enabled;
+}
+
+////////////////////////////////////////////////////////////////
+// Event recording and replay (Fl::event_record(), Fl::event_replay()):
+// every event entering Fl::handle_() can be appended to a trace file -
+// one text line per event with a relative timestamp, window-relative
+// coordinates and the full event state - and such a trace can later be
+// dispatched again into the running application at original or
+// accelerated speed, measuring how long each event took to handle and
+// draw. Windows are identified by their position in the open-window
+// list, so a trace recorded against one build of an application replays
+// against another as long as it opens its windows in the same order.
+
+static FILE *record_file = 0;
+static double record_time0 = 0;
+
+static int window_number(Fl_Window *win) { // position in the open-window list
+  int n = 0;
+  for (Fl_Window *w = Fl::first_window(); w; w = Fl::next_window(w), n++)
+    if (w == win) return n;
+  return -1;
+}
+
+static Fl_Window *numbered_window(int n) {
+  if (n < 0) return 0;
+  for (Fl_Window *w = Fl::first_window(); w; w = Fl::next_window(w), n--)
+    if (!n) return w;
+  return 0;
+}
+
+static void record_event(int e, Fl_Window *window) {
+  fprintf(record_file, "%.6f %d %d %d %d %d %d %d %d %d %d",
+          frame_clock() - record_time0, e, window_number(window),
+          Fl::e_x, Fl::e_y, Fl::e_state, Fl::e_clicks, Fl::e_is_click,
+          Fl::e_keysym, Fl::e_dx, Fl::e_dy);
+  for (int i = 0; i < Fl::e_length; i++)
+    fprintf(record_file, " %02x", (unsigned char)Fl::e_text[i]);
+  fputc('\n', record_file);
+}
+
+/**
+  Starts recording every event dispatched through Fl::handle_() to
+  \p filename, replacing any recording in progress.
+
+  Each event is written as one text line holding a timestamp relative to
+  the start of the recording, the event type, the target window's
+  position in the open-window list, the window-relative pointer
+  coordinates and the remaining event state, so traces are independent
+  of where the windows sit on the screen. Recording continues until
+  event_record_stop() is called.
+
+  \param filename the trace file to write
+  \return 1 on success, 0 if the file could not be created
+  \see Fl::event_replay(const char*, double)
+*/
+int Fl::event_record(const char *filename) {
+  event_record_stop();
+  record_file = fl_fopen(filename, "w");
+  if (!record_file) return 0;
+  record_time0 = frame_clock();
+  return 1;
+}
+
+/** Stops a recording started with event_record(const char*). */
+void Fl::event_record_stop() {
+  if (record_file) {
+    fclose(record_file);
+    record_file = 0;
+  }
+}
+
+/**
+  Replays a trace recorded with event_record(const char*) into the
+  running application and measures how long each event takes.
+
+  Every recorded event is dispatched through Fl::handle() to the window
+  at the same position in the open-window list it was recorded against
+  (falling back to the first window), followed by Fl::flush() so the
+  resulting repaint is part of the measurement. With \p speed 1.0 events
+  are paced by their recorded timestamps; larger values replay
+  proportionally faster and 0 replays as fast as the application can
+  process them. The event loop keeps running between paced events, so
+  timeouts and idle callbacks behave as during the recording.
+
+  The number of replayed events, the wall time they took to dispatch and
+  draw, and the longest single event are accumulated in the
+  Fl::perf_counters() replay fields; reset them before the call to
+  measure one scenario. Typical use is a performance regression test:
+  record an interaction sequence once, then replay it against each build
+  (under a virtual display server if no screen is available) and compare
+  the reported frame times.
+
+  \param filename the trace file to read
+  \param speed replay speed factor, 0 for no pacing
+  \return the number of events replayed, 0 if the file could not be read
+*/
+int Fl::event_replay(const char *filename, double speed) {
+  FILE *f = fl_fopen(filename, "r");
+  if (!f) return 0;
+  static char text[256]; // replayed e_text, must outlive the dispatch
+  char line[1024];
+  int count = 0;
+  double start = frame_clock();
+  while (fgets(line, sizeof(line), f)) {
+    double t;
+    int e, winno, x, y, state, clicks, isclick, keysym, dx, dy, consumed;
+    if (sscanf(line, "%lf %d %d %d %d %d %d %d %d %d %d%n", &t, &e, &winno,
+               &x, &y, &state, &clicks, &isclick, &keysym, &dx, &dy,
+               &consumed) != 11)
+      continue;
+    Fl_Window *win = numbered_window(winno);
+    if (!win) win = first_window();
+    if (!win) break;
+    if (speed > 0) {
+      double due = start + t / speed, now;
+      while ((now = frame_clock()) < due) wait(due - now);
+    }
+    int len = 0;
+    const char *p = line + consumed;
+    unsigned byte;
+    while (len < (int)sizeof(text) - 1 &&
+           sscanf(p, " %2x%n", &byte, &consumed) == 1) {
+      text[len++] = (char)byte;
+      p += consumed;
+    }
+    text[len] = 0;
+    e_x = x; e_y = y;
+    e_x_root = x + win->x(); e_y_root = y + win->y();
+    e_state = state; e_clicks = clicks; e_is_click = isclick;
+    e_keysym = keysym; e_dx = dx; e_dy = dy;
+    e_text = text; e_length = len;
+    double t0 = frame_clock();
+    handle(e, win);
+    flush();
+    double dt = frame_clock() - t0;
+    fl_perf_counters.replay_events++;
+    fl_perf_counters.replay_frame_seconds += dt;
+    if (dt > fl_perf_counters.replay_frame_max)
+      fl_perf_counters.replay_frame_max = dt;
+    count++;
+  }
+  fclose(f);
+  return count;
+}
+
 int Fl::handle_(int e, Fl_Window* window)
 {
+  if ((unsigned)e < sizeof(fl_perf_counters.events)/sizeof(fl_perf_counters.events[0]))
+    fl_perf_counters.events[e]++;
+  if (record_file) record_event(e, window);
+
+  if (event_compression_enabled && !pending_flushing && !fl_local_grab) {
+    if (e == FL_MOVE || e == FL_DRAG || e == FL_MOUSEWHEEL) {
+      Fl_Widget *target = grab() ? grab() :
+        (pushed() && e != FL_MOUSEWHEEL) ? pushed() : belowmouse();
+      int opt_out = 0;
+      for (Fl_Widget *w = target; w; w = w->parent())
+        if (!w->compress_events()) { opt_out = 1; break; }
+      if (!opt_out) {
+        // FL_MOVE and FL_DRAG share the pending slot; an event of the
+        // other kind flushes what is pending to keep relative ordering
+        int same_kind = pending_event &&
+          ((pending_event == FL_MOUSEWHEEL) == (e == FL_MOUSEWHEEL));
+        if (pending_event && !same_kind) flush_pending_event();
+        double now = frame_clock();
+        if (now - motion_last_time < motion_interval) {
+          if (e == FL_MOUSEWHEEL && same_kind) {
+            pending_dx += e_dx;
+            pending_dy += e_dy;
+          } else if (e == FL_MOUSEWHEEL) {
+            pending_dx = e_dx;
+            pending_dy = e_dy;
+          }
+          pending_event = e;
+          pending_window = window;
+          pending_x = e_x;
+          pending_y = e_y;
+          pending_x_root = e_x_root;
+          pending_y_root = e_y_root;
+          pending_state = e_state;
+          if (!has_check(flush_pending_event)) add_check(flush_pending_event);
+          return 1;
+        }
+        motion_last_time = now;
+      }
+    } else if (pending_event) {
+      flush_pending_event(); // deliver the motion before the new event
+    }
+  }
+
   e_number = e;
   if (fl_local_grab) return fl_local_grab(e);
 
@@ -1471,7 +2040,9 @@ void Fl_Widget::damage(uchar fl) {
       fl_graphics_driver->XDestroyRegion(i->region);
       i->region = 0;
     }
+    Fl_Window_Driver::driver((Fl_Window*)this)->collapse_damage_rects();
     damage_ |= fl;
+    Fl_Window_Driver::add_dirty((Fl_Window*)this);
     Fl::damage(FL_DAMAGE_CHILD);
   }
 }
@@ -1506,13 +2077,18 @@ void Fl_Widget::damage(uchar fl, int X, int Y, int W, int H) {
     if (i->region) {
       fl_graphics_driver->add_rectangle_to_region(i->region, X, Y, W, H);
     }
+    Fl_Window_Driver::driver((Fl_Window*)wi)->add_damage_rect(X, Y, W, H);
     wi->damage_ |= fl;
   } else {
     // create a new region:
     if (i->region) fl_graphics_driver->XDestroyRegion(i->region);
     i->region = fl_graphics_driver->XRectangleRegion(X,Y,W,H);
+    Fl_Window_Driver *dr = Fl_Window_Driver::driver((Fl_Window*)wi);
+    dr->clear_damage_rects();
+    dr->add_damage_rect(X, Y, W, H);
     wi->damage_ = fl;
   }
+  Fl_Window_Driver::add_dirty((Fl_Window*)wi);
   Fl::damage(FL_DAMAGE_CHILD);
 }
 
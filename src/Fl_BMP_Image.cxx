@@ -95,12 +95,76 @@ Fl_BMP_Image::Fl_BMP_Image(const char *imagename, const unsigned char *data)
   }
 }
 
+/**
+ \brief Decode a BMP file row by row without loading it into memory.
+
+ Instead of building an Fl_BMP_Image, each decoded row is handed to \p cb
+ as it is produced, so only a single row is ever held in memory. This is
+ intended for processing images far too large to keep uncompressed, e.g.
+ converting or scaling huge screenshots. The usual Fl_Image::max_size()
+ limit does not apply.
+
+ The callback receives the row index \p y, the image width and depth
+ (3 for RGB, 4 for RGBA), a pointer to the row's pixels, and \p cbdata.
+ Rows are delivered in file order, which for most BMP files is bottom-up,
+ so the callback must place rows by \p y rather than assume a sequence.
+ Icon-style files with an appended transparency mask can only resolve
+ alpha after all rows are read; for those the image is buffered
+ internally and the rows are delivered afterwards.
+
+ \param[in] filename a full path and name pointing to a valid BMP file.
+ \param[in] cb       sink receiving each decoded row
+ \param[in] cbdata   user data passed to the callback
+
+ \returns 0 on success, or one of the Fl_Image ERR_ codes on failure.
+
+ \version 1.4.0
+ */
+int Fl_BMP_Image::stream(const char *filename, Row_Callback *cb, void *cbdata)
+{
+  Fl_Image_Reader rdr;
+  if (rdr.open(filename) == -1)
+    return ERR_FILE_ACCESS;
+  Fl_BMP_Image img;
+  img.load_bmp_(rdr, cb, cbdata);
+  return (img.ld() < 0) ? img.ld() : 0;
+}
+
+/**
+ \brief Decode a BMP image from memory row by row.
+
+ Same as Fl_BMP_Image::stream(const char*, Row_Callback*, void*), but
+ reading the BMP data from a block of memory.
+
+ \param[in] imagename  A name given to this image or NULL
+ \param[in] data       Pointer to the start of the BMP image in memory
+ \param[in] cb         sink receiving each decoded row
+ \param[in] cbdata     user data passed to the callback
+
+ \returns 0 on success, or one of the Fl_Image ERR_ codes on failure.
+
+ \version 1.4.0
+ */
+int Fl_BMP_Image::stream(const char *imagename, const unsigned char *data,
+                         Row_Callback *cb, void *cbdata)
+{
+  Fl_Image_Reader rdr;
+  if (rdr.open(imagename, data) == -1)
+    return ERR_FILE_ACCESS;
+  Fl_BMP_Image img;
+  img.load_bmp_(rdr, cb, cbdata);
+  return (img.ld() < 0) ? img.ld() : 0;
+}
+
 /*
  This method reads BMP image data and creates an RGB or RGBA image. The BMP
  format supports only 1 bit for alpha. To avoid code duplication, we use
  an Fl_Image_Reader that reads data from either a file or from memory.
+ If cb is set, the image is decoded for stream() instead: rows are passed
+ to the callback as they are produced and no pixel array is kept, except
+ for masked icons whose alpha is only known after all rows are read.
  */
-void Fl_BMP_Image::load_bmp_(Fl_Image_Reader &rdr)
+void Fl_BMP_Image::load_bmp_(Fl_Image_Reader &rdr, Row_Callback *cb, void *cbdata)
 {
   int     info_size,    // Size of info header
           depth,        // Depth of image (bits)
@@ -228,13 +292,29 @@ void Fl_BMP_Image::load_bmp_(Fl_Image_Reader &rdr)
   d(bDepth);
   if (offbits) rdr.seek(offbits);
 
-  if (((size_t)w()) * h() * d() > max_size() ) {
-    Fl::warning("BMP file \"%s\" is too large!\n", rdr.name());
-    w(0); h(0); d(0); ld(ERR_FORMAT);
-    return;
+  uchar *linebuf = 0;   // whole-row input buffer for the truecolor depths
+  int linesize = 0;
+  if (depth == 16 || depth == 24 || depth == 32) {
+    // these depths are never RLE compressed, so each padded row can be
+    // fetched from the reader in one block instead of byte by byte
+    linesize = (w() * (depth / 8) + 3) & ~3;
+    linebuf = new uchar[linesize];
+  }
+
+  uchar *rowbuf = 0;    // single-row buffer for streaming decode
+  if (cb && !havemask) {
+    // Streaming decode: only one row is ever held, so the full-image
+    // max_size() limit does not apply.
+    rowbuf = new uchar[w() * d()];
+  } else {
+    if (((size_t)w()) * h() * d() > max_size() ) {
+      Fl::warning("BMP file \"%s\" is too large!\n", rdr.name());
+      w(0); h(0); d(0); ld(ERR_FORMAT);
+      return;
+    }
+    array = new uchar[w() * h() * d()];
+    alloc_array = 1;
   }
-  array = new uchar[w() * h() * d()];
-  alloc_array = 1;
 
   // Read the image data...
   color = 0;
@@ -252,7 +332,7 @@ void Fl_BMP_Image::load_bmp_(Fl_Image_Reader &rdr)
   }
 
   for (y = start_y; y != end_y; y += row_order) {
-    ptr = (uchar *)array + y * w() * d();
+    ptr = rowbuf ? rowbuf : (uchar *)array + y * w() * d();
 
     switch (depth)
     {
@@ -409,9 +489,12 @@ void Fl_BMP_Image::load_bmp_(Fl_Image_Reader &rdr)
         }
         break;
 
-      case 16 : // 16-bit 5:5:5 or 5:6:5 RGB
-        for (x = w(); x > 0; x --, ptr += bDepth) {
-          uchar b = rdr.read_byte(), a = rdr.read_byte() ;
+      case 16 : { // 16-bit 5:5:5 or 5:6:5 RGB
+        // read the whole padded row in one block, then convert
+        rdr.read(linebuf, linesize);
+        const uchar *in = linebuf;
+        for (x = w(); x > 0; x --, ptr += bDepth, in += 2) {
+          uchar b = in[0], a = in[1];
           if (use_5_6_5) {
             ptr[2] = (uchar)(( b << 3 ) & 0xf8);
             ptr[1] = (uchar)(((a << 5) & 0xe0) | ((b >> 3) & 0x1c));
@@ -422,35 +505,38 @@ void Fl_BMP_Image::load_bmp_(Fl_Image_Reader &rdr)
             ptr[0] = (uchar)((a<<1) & 0xf8);
           }
         }
-
-        // Read remaining bytes to align to 32 bits...
-        for (temp = w() * 2; temp & 3; temp ++) {
-          rdr.read_byte();
-        }
         break;
+      }
 
-      case 24 : // 24-bit RGB
-        for (x = w(); x > 0; x --, ptr += bDepth) {
-          ptr[2] = rdr.read_byte();
-          ptr[1] = rdr.read_byte();
-          ptr[0] = rdr.read_byte();
-        }
-
-        // Read remaining bytes to align to 32 bits...
-        for (temp = w() * 3; temp & 3; temp ++) {
-          rdr.read_byte();
+      case 24 : { // 24-bit RGB
+        // read the whole padded row in one block and swizzle BGR to RGB
+        rdr.read(linebuf, linesize);
+        const uchar *in = linebuf;
+        for (x = w(); x > 0; x --, ptr += bDepth, in += 3) {
+          ptr[0] = in[2];
+          ptr[1] = in[1];
+          ptr[2] = in[0];
         }
         break;
+      }
 
-      case 32 : // 32-bit RGBA
-        for (x = w(); x > 0; x --, ptr += bDepth) {
-          ptr[2] = rdr.read_byte();
-          ptr[1] = rdr.read_byte();
-          ptr[0] = rdr.read_byte();
-          ptr[3] = rdr.read_byte();
+      case 32 : { // 32-bit RGBA
+        // read the whole row in one block and swizzle BGRA to RGBA
+        rdr.read(linebuf, linesize);
+        const uchar *in = linebuf;
+        for (x = w(); x > 0; x --, ptr += bDepth, in += 4) {
+          ptr[0] = in[2];
+          ptr[1] = in[1];
+          ptr[2] = in[0];
+          ptr[3] = in[3];
         }
         break;
+      }
     }
+
+    // Deliver the finished row to the streaming sink...
+    if (rowbuf)
+      cb(y, w(), d(), rowbuf, cbdata);
   }
 
   if (havemask) {
@@ -472,5 +558,19 @@ void Fl_BMP_Image::load_bmp_(Fl_Image_Reader &rdr)
         rdr.read_byte();
     }
   }
+
+  delete[] linebuf;
+
+  if (rowbuf) {
+    delete[] rowbuf;
+  } else if (cb) {
+    // Streaming decode of a masked icon: the rows were buffered until
+    // the mask resolved their alpha, deliver them now and let go of them.
+    for (y = 0; y < h(); y ++)
+      cb(y, w(), d(), (uchar *)array + y * w() * d(), cbdata);
+    delete[] (uchar *)array;
+    array = 0;
+    alloc_array = 0;
+  }
   // File is closed when returning...
 }
@@ -123,6 +123,8 @@ Fl_Bitmap::~Fl_Bitmap() {
 }
 
 void Fl_Bitmap::uncache() {
+  extern void fl_image_cache_forget(Fl_Image *); // in Fl_Graphics_Driver.cxx
+  fl_image_cache_forget(this);
   if (id_) {
     fl_delete_bitmask((Fl_Bitmask)id_);
     id_ = 0;
@@ -43,16 +43,177 @@
 //       Changes to FL_BLINE *must* be reflected in Fl_File_Chooser.cxx as well.
 //       This hack in Fl_File_Chooser should be solved.
 //
+struct FL_BPARSE;
+
 struct FL_BLINE {       // data is in a linked list of these
   FL_BLINE* prev;
   FL_BLINE* next;
   void* data;
   Fl_Image* icon;
+  FL_BPARSE* parsed;    // cached format/column parse, built by parse_line()
   short length;         // sizeof(txt)-1, may be longer than string
   char flags;           // selected, displayed
   char txt[1];          // start of allocated array
 };
 
+struct FL_BSEG {        // one tab-separated field of a parsed line
+  int txt;              // offset of the field's text copy within the parse block
+  short font_set;       // absolute font from @F or @f/@t, or -1
+  short font_attr;      // FL_BOLD/FL_ITALIC bits OR'd onto the font
+  short size;           // absolute size from @l/@m/@s/@S, or -1
+  short align;          // FL_ALIGN_LEFT, FL_ALIGN_CENTER or FL_ALIGN_RIGHT
+  unsigned color;       // text color from @C/@N, see has_color
+  unsigned bgcolor;     // background fill color from @B, see has_bg
+  char has_color;       // @C or @N was given
+  char has_bg;          // @B was given
+  char has_width;       // field ends at a column split and takes a column_widths() entry
+  char hline;           // @-: draw an engraved divider
+  char underline;       // @u or @_: underline the field
+};
+
+struct FL_BPARSE {      // cached parse of one line, see parse_line()
+  FL_BPARSE* next;      // freelist link while the block awaits reuse
+  int alloc;            // bytes the block was allocated with
+  char format_char;     // format_char() the line was parsed with
+  char column_char;     // column_char() the line was parsed with
+  int ncols;            // number of column_widths() entries when parsed
+  int nseg;             // number of fields
+  FL_BSEG seg[1];       // start of allocated array, followed by the text copies
+};
+
+struct FL_BCHUNK {      // arena block the lines are allocated from
+  FL_BCHUNK* next;
+  int used;             // bytes of buf already handed out
+  int size;             // capacity of buf
+  char buf[1];          // start of allocated array
+};
+
+#define FL_BCHUNK_SIZE 65504 // payload per chunk, roughly a thousand lines
+
+// Returns \p size bytes for a new line or parse block. The lines live in
+// per-browser arena chunks rather than in individual malloc() blocks, so
+// that clear() can drop a huge list with one free() per chunk instead of
+// two per line. Nothing in a chunk is freed separately: a removed line
+// goes on freelist_ for reuse by insert(), a stale parse is simply
+// abandoned, and clear() parks the emptied chunks on spare_ so the next
+// fill reuses them instead of hitting malloc() again.
+char* Fl_Browser::pool_alloc(int size) {
+  size = (size + sizeof(void*) - 1) & ~(int)(sizeof(void*) - 1); // keep pointers aligned
+  FL_BCHUNK* c = chunks_;
+  if (!c || c->used + size > c->size) {
+    if (spare_ && size <= spare_->size) { // recycle a chunk from an earlier fill
+      c = spare_;
+      spare_ = c->next;
+      c->used = 0;
+    } else {
+      int n = size > FL_BCHUNK_SIZE ? size : FL_BCHUNK_SIZE;
+      c = (FL_BCHUNK*)malloc(sizeof(FL_BCHUNK) + n - 1);
+      c->used = 0;
+      c->size = n;
+    }
+    c->next = chunks_;
+    chunks_ = c;
+  }
+  char* p = c->buf + c->used;
+  c->used += size;
+  return p;
+}
+
+// Returns the parsed form of line 'l': its column splits and the @-codes of
+// each field, with the visible text copied out NUL-terminated. The result is
+// cached in the line so repaints don't re-scan the format prefixes; it is
+// rebuilt when the line was re-parsed with a different format character,
+// column character or number of column widths, and freed with the line.
+FL_BPARSE *Fl_Browser::parse_line(FL_BLINE *l) const {
+  char fc = format_char();
+  char cc = column_char();
+  const int *widths = column_widths();
+  int ncols = 0;
+  while (widths[ncols]) ncols++;
+  Fl_Browser* self = (Fl_Browser*)this;
+  FL_BPARSE *p = l->parsed;
+  if (p && p->format_char == fc && p->column_char == cc && p->ncols == ncols)
+    return p;
+  if (p) { // recycle the stale parse; rows that update steadily would
+           // otherwise grow the arena without bound
+    p->next = self->parse_free_;
+    self->parse_free_ = p;
+  }
+  int maxseg = ncols + 1; // one field per column split plus the last one
+  int need = (int)(sizeof(FL_BPARSE) + (maxseg-1)*sizeof(FL_BSEG)
+                   + strlen(l->txt) + maxseg);
+  // reuse a recycled parse block if one of the first few is big enough:
+  p = 0;
+  FL_BPARSE** fp = &self->parse_free_;
+  for (int i = 0; *fp && i < 8; i++) {
+    if ((*fp)->alloc >= need) {p = *fp; *fp = p->next; break;}
+    fp = &(*fp)->next;
+  }
+  if (!p) {
+    p = (FL_BPARSE*)self->pool_alloc(need);
+    p->alloc = need;
+  }
+  p->format_char = fc;
+  p->column_char = cc;
+  p->ncols = ncols;
+  p->nseg = 0;
+  char *out = (char*)(p->seg + maxseg); // text copies go after the field array
+  char *str = l->txt;
+  int col = 0;
+  while (str) {
+    FL_BSEG *g = p->seg + p->nseg++;
+    char *e = 0; // pointer to end of field or null if none
+    if (col < ncols) { // find end of field and temporarily replace with 0
+      e = strchr(str, cc);
+      if (e) {*e = 0; col++;}
+    }
+    g->font_set = -1;
+    g->font_attr = 0;
+    g->size = -1;
+    g->align = FL_ALIGN_LEFT;
+    g->has_color = g->has_bg = 0;
+    g->color = g->bgcolor = 0;
+    g->has_width = e ? 1 : 0;
+    g->hline = g->underline = 0;
+    // check for all the @-lines recognized by XForms:
+    if (fc) {
+      while (*str == fc && *++str && *str != fc) {
+        switch (*str++) {
+        case 'l': case 'L': g->size = 24; break;
+        case 'm': case 'M': g->size = 18; break;
+        case 's': g->size = 11; break;
+        case 'b': g->font_attr |= FL_BOLD; break;
+        case 'i': g->font_attr |= FL_ITALIC; break;
+        case 'f': case 't': g->font_set = FL_COURIER; g->font_attr = 0; break;
+        case 'c': g->align = FL_ALIGN_CENTER; break;
+        case 'r': g->align = FL_ALIGN_RIGHT; break;
+        case 'B': g->bgcolor = (unsigned)strtoul(str, &str, 10); g->has_bg = 1; break;
+        case 'C': g->color = (unsigned)strtoul(str, &str, 10); g->has_color = 1; break;
+        case 'F': g->font_set = (short)strtol(str, &str, 10); g->font_attr = 0; break;
+        case 'N': g->color = (unsigned)FL_INACTIVE_COLOR; g->has_color = 1; break;
+        case 'S': g->size = (short)strtol(str, &str, 10); break;
+        case '-': g->hline = 1; break;
+        case 'u':
+        case '_': g->underline = 1; break;
+        case '.': goto BREAK;
+        }
+      }
+    }
+  BREAK:
+    g->txt = (int)(out - (char*)p);
+    strcpy(out, str);
+    out += strlen(str) + 1;
+    if (e) {
+      *e = cc; // put the separator back
+      str = e+1;
+    } else {
+      str = 0; // last one occupied by text
+    }
+  }
+  l->parsed = p;
+  return p;
+}
+
 /**
   Returns the very first item in the list.
   Example of use:
@@ -226,7 +387,16 @@ FL_BLINE* Fl_Browser::_remove(int line) {
 */
 void Fl_Browser::remove(int line) {
   if (line < 1 || line > lines) return;
-  free(_remove(line));
+  FL_BLINE* l = _remove(line);
+  // the line lives in an arena chunk; park it on the freelist for reuse
+  // by insert() instead of freeing it, and its parse likewise
+  if (l->parsed) {
+    l->parsed->next = parse_free_;
+    parse_free_ = l->parsed;
+    l->parsed = 0;
+  }
+  l->next = freelist_;
+  freelist_ = l;
 }
 
 /**
@@ -284,12 +454,22 @@ void Fl_Browser::insert(int line, FL_BLINE* item) {
 void Fl_Browser::insert(int line, const char* newtext, void* d) {
   if (!newtext) newtext = "";           // STR #3269
   int l = (int) strlen(newtext);
-  FL_BLINE* t = (FL_BLINE*)malloc(sizeof(FL_BLINE)+l);
-  t->length = (short)l;
+  // reuse a removed line if one of the first few has room for the text:
+  FL_BLINE* t = 0;
+  FL_BLINE** p = &freelist_;
+  for (int i = 0; *p && i < 8; i++) {
+    if ((*p)->length >= l) {t = *p; *p = t->next; break;}
+    p = &(*p)->next;
+  }
+  if (!t) {
+    t = (FL_BLINE*)pool_alloc(sizeof(FL_BLINE)+l);
+    t->length = (short)l;
+  }
   t->flags = 0;
   strcpy(t->txt, newtext);
   t->data = d;
   t->icon = 0;
+  t->parsed = 0;
   insert(line, t);
 }
 
@@ -321,20 +501,32 @@ void Fl_Browser::text(int line, const char* newtext) {
   if (!newtext) newtext = "";           // STR #3269
   int l = (int) strlen(newtext);
   if (l > t->length) {
-    FL_BLINE* n = (FL_BLINE*)malloc(sizeof(FL_BLINE)+l);
+    FL_BLINE* n = (FL_BLINE*)pool_alloc(sizeof(FL_BLINE)+l);
     replacing(t, n);
     cache = n;
     n->data = t->data;
     n->icon = t->icon;
+    n->parsed = 0;
     n->length = (short)l;
     n->flags = t->flags;
     n->prev = t->prev;
     if (n->prev) n->prev->next = n; else first = n;
     n->next = t->next;
     if (n->next) n->next->prev = n; else last = n;
-    free(t);
+    if (t->parsed) { // recycle the replaced line's parse as well
+      t->parsed->next = parse_free_;
+      parse_free_ = t->parsed;
+      t->parsed = 0;
+    }
+    t->next = freelist_; // the replaced line can be reused by insert()
+    freelist_ = t;
     t = n;
   }
+  if (t->parsed) { // the cached parse describes the old text; recycle it
+    t->parsed->next = parse_free_;
+    parse_free_ = t->parsed;
+    t->parsed = 0;
+  }
   strcpy(t->txt, newtext);
   redraw_line(t);
 }
@@ -364,10 +556,14 @@ int Fl_Browser::item_height(void *item) const {
 
   int hmax = 2; // use 2 to insure we don't return a zero!
 
+  // batch the metric queries; most items use a single font/size
+  Fl_Measure_Context mc = fl_graphics_driver->begin_measure(textfont(), textsize());
+  Fl_Font mfont = textfont();
+  int msize = textsize();
+
   if (!l->txt[0]) {
     // For blank lines set the height to exactly 1 line!
-    fl_font(textfont(), textsize());
-    int hh = fl_height();
+    int hh = mc.height();
     if (hh > hmax) hmax = hh;
   } else {
     const int* i = column_widths();
@@ -397,7 +593,11 @@ int Fl_Browser::item_height(void *item) const {
       if (ptr && *i++) str = strchr(str, column_char());
       else str = NULL;
       if((!str && *ptr) || (str && ptr < str)) {
-        fl_font(font, tsize); int hh = fl_height();
+        if (font != mfont || tsize != msize) {
+          mc = fl_graphics_driver->begin_measure(font, tsize);
+          mfont = font; msize = tsize;
+        }
+        int hh = mc.height();
         if (hh > hmax) hmax = hh;
       }
       if (!str || !*str) break;
@@ -465,8 +665,8 @@ int Fl_Browser::item_width(void *item) const {
 
   if (ww==0 && l->icon) ww = l->icon->w();
 
-  fl_font(font, tsize);
-  return ww + int(fl_width(str)) + 6;
+  Fl_Measure_Context mc = fl_graphics_driver->begin_measure(font, tsize);
+  return ww + int(mc.width(str)) + 6;
 }
 
 /**
@@ -501,17 +701,16 @@ int Fl_Browser::incr_height() const {
 */
 void Fl_Browser::item_draw(void* item, int X, int Y, int W, int H) const {
   FL_BLINE* l = (FL_BLINE*)item;
-  char* str = l->txt;
+  // all the @-code and column scanning was done up front (or on a previous
+  // repaint) by parse_line(); here we only position and emit the fields
+  FL_BPARSE* p = parse_line(l);
   const int* i = column_widths();
 
   bool firstLoop = true;        // for icon
-  while (W > 6) {       // do each tab-separated field
-    int w1 = W; // width for this field
-    char* e = 0; // pointer to end of field or null if none
-    if (*i) { // find end of field and temporarily replace with 0
-      e = strchr(str, column_char());
-      if (e) {*e = 0; w1 = *i++;}
-    }
+  for (int s = 0; s < p->nseg && W > 6; s++) { // do each tab-separated field
+    FL_BSEG* g = p->seg + s;
+    const char* str = (const char*)p + g->txt;
+    int w1 = g->has_width ? *i++ : W; // width for this field
     // Icon drawing code
     if (firstLoop) {
       firstLoop = false;
@@ -521,71 +720,33 @@ void Fl_Browser::item_draw(void* item, int X, int Y, int W, int H) const {
         X += iconw; W -= iconw; w1 -= iconw;
       }
     }
-    int tsize = textsize();
-    Fl_Font font = textfont();
-    Fl_Color lcol = textcolor();
-    Fl_Align talign = FL_ALIGN_LEFT;
-    // check for all the @-lines recognized by XForms:
-    //#if defined(__GNUC__)
-    //#warning FIXME This maybe needs to be more UTF8 aware now...?
-    //#endif /*__GNUC__*/
-    if ( format_char() ) {      // can be NULL
-      while (*str == format_char() && *++str && *str != format_char()) {
-        switch (*str++) {
-        case 'l': case 'L': tsize = 24; break;
-        case 'm': case 'M': tsize = 18; break;
-        case 's': tsize = 11; break;
-        case 'b': font = (Fl_Font)(font|FL_BOLD); break;
-        case 'i': font = (Fl_Font)(font|FL_ITALIC); break;
-        case 'f': case 't': font = FL_COURIER; break;
-        case 'c': talign = FL_ALIGN_CENTER; break;
-        case 'r': talign = FL_ALIGN_RIGHT; break;
-        case 'B':
-          if (!(l->flags & SELECTED)) {
-            fl_color((Fl_Color)strtoul(str, &str, 10));
-            fl_rectf(X, Y, w1, H);
-          } else while (isdigit(*str & 255)) str++; // skip digits
-          break;
-        case 'C':
-          lcol = (Fl_Color)strtoul(str, &str, 10);
-          break;
-        case 'F':
-          font = (Fl_Font)strtol(str, &str, 10);
-          break;
-        case 'N':
-          lcol = FL_INACTIVE_COLOR;
-          break;
-        case 'S':
-          tsize = strtol(str, &str, 10);
-          break;
-        case '-':
-          fl_color(FL_DARK3);
-          fl_line(X+3, Y+H/2, X+w1-3, Y+H/2);
-          fl_color(FL_LIGHT3);
-          fl_line(X+3, Y+H/2+1, X+w1-3, Y+H/2+1);
-          break;
-        case 'u':
-        case '_':
-          fl_color(lcol);
-          fl_line(X+3, Y+H-1, X+w1-3, Y+H-1);
-          break;
-        case '.':
-          goto BREAK;
-        }
-      }
+    Fl_Font font = g->font_set >= 0 ? (Fl_Font)g->font_set : textfont();
+    font = (Fl_Font)(font | g->font_attr);
+    int tsize = g->size >= 0 ? g->size : textsize();
+    Fl_Color lcol = g->has_color ? (Fl_Color)g->color : textcolor();
+    if (g->has_bg && !(l->flags & SELECTED)) {
+      fl_color((Fl_Color)g->bgcolor);
+      fl_rectf(X, Y, w1, H);
+    }
+    if (g->hline) {
+      fl_color(FL_DARK3);
+      fl_line(X+3, Y+H/2, X+w1-3, Y+H/2);
+      fl_color(FL_LIGHT3);
+      fl_line(X+3, Y+H/2+1, X+w1-3, Y+H/2+1);
+    }
+    if (g->underline) {
+      fl_color(lcol);
+      fl_line(X+3, Y+H-1, X+w1-3, Y+H-1);
     }
-  BREAK:
     fl_font(font, tsize);
     if (l->flags & SELECTED)
       lcol = fl_contrast(lcol, selection_color());
     if (!active_r()) lcol = fl_inactive(lcol);
     fl_color(lcol);
-    fl_draw(str, X+3, Y, w1-6, H, e ? Fl_Align(talign|FL_ALIGN_CLIP) : talign, 0, 0);
-    if (!e) break; // no more fields...
-    *e = column_char(); // put the separator back
+    fl_draw(str, X+3, Y, w1-6, H,
+            g->has_width ? Fl_Align(g->align|FL_ALIGN_CLIP) : Fl_Align(g->align), 0, 0);
     X += w1;
     W -= w1;
-    str = e+1;
   }
 }
 
@@ -605,6 +766,21 @@ Fl_Browser::Fl_Browser(int X, int Y, int W, int H, const char *L)
   format_char_ = '@';
   column_char_ = '\t';
   first = last = cache = 0;
+  chunks_ = spare_ = 0;
+  freelist_ = 0;
+  parse_free_ = 0;
+}
+
+/**
+  The destructor deletes all list items and destroys the browser.
+*/
+Fl_Browser::~Fl_Browser() {
+  clear();
+  for (FL_BCHUNK* c = spare_; c;) {
+    FL_BCHUNK* n = c->next;
+    free(c);
+    c = n;
+  }
 }
 
 /**
@@ -619,8 +795,20 @@ void Fl_Browser::lineposition(int line, Fl_Line_Position pos) {
   int p = 0;
 
   FL_BLINE* l;
-  for (l=first; l && line>1; l = l->next) {
-    line--; p += item_height(l);
+  if (lines - line < line - 1) {
+    // closer to the end: walk backwards from the last line, starting
+    // from the incrementally maintained total height:
+    p = full_height();
+    int n = lines;
+    for (l = last; l; l = l->prev) {
+      p -= item_height(l);
+      if (n == line) break;
+      n--;
+    }
+  } else {
+    for (l=first; l && line>1; l = l->next) {
+      line--; p += item_height(l);
+    }
   }
   if (l && (pos == BOTTOM)) p += item_height (l);
 
@@ -676,14 +864,23 @@ void Fl_Browser::textsize(Fl_Fontsize newSize) {
 
 /**
   Removes all the lines in the browser.
+  The memory the lines were using is kept for reuse by later add() and
+  insert() calls and is only returned to the system when the browser is
+  destroyed.
   \see add(), insert(), remove(), swap(int,int), clear()
 */
 void Fl_Browser::clear() {
-  for (FL_BLINE* l = first; l;) {
-    FL_BLINE* n = l->next;
-    free(l);
-    l = n;
+  // the lines all live in the arena chunks: park those on the spare list
+  // for the next fill instead of freeing every line separately
+  for (FL_BCHUNK* c = chunks_; c;) {
+    FL_BCHUNK* n = c->next;
+    c->next = spare_;
+    spare_ = c;
+    c = n;
   }
+  chunks_ = 0;
+  freelist_ = 0;
+  parse_free_ = 0;
   full_height_ = 0;
   first = 0;
   last = 0;
@@ -881,6 +1078,24 @@ void Fl_Browser::swap(int a, int b) {
   swap(ai,bi);
 }
 
+/**
+  Moves \p line to its sorted position after its text changed.
+
+  The rest of the list must already be in the order a previous sort()
+  with the same \p flags produced; only the one line is repositioned,
+  so updating a few rows of a large sorted browser is much cheaper
+  than calling sort() again.
+  You must call redraw() to make any changes visible.
+  \param[in] line  The changed line. If out of range, nothing is done.
+  \param[in] flags FL_SORT_ASCENDING or FL_SORT_DESCENDING, as passed to sort().
+  \see sort(int), Fl_Browser_::sort_item()
+  \since 1.4.0
+*/
+void Fl_Browser::resort(int line, int flags) {
+  if (line < 1 || line > lines) return;
+  sort_item(find_line(line), flags);
+}
+
 /**
   Set the image icon for \p line to the value \p icon.
   Caller is responsible for keeping the icon allocated.
@@ -17,6 +17,8 @@
 #define DISPLAY_SEARCH_BOTH_WAYS_AT_ONCE
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <FL/Fl.H>
 #include <FL/Fl_Widget.H>
 #include <FL/Fl_Browser_.H>
@@ -44,7 +46,7 @@
 
 /* redraw bits:
    1 = redraw children (the scrollbar)
-   2 = redraw one or two items
+   2 = redraw the changed items
    4 = redraw all items
 */
 
@@ -122,9 +124,30 @@ void Fl_Browser_::resize(int X, int Y, int W, int H) {
   \see redraw_lines(), redraw_line()
 */
 void Fl_Browser_::redraw_line(void* item) {
-  if (!redraw1 || redraw1 == item) {redraw1 = item; damage(FL_DAMAGE_EXPOSE);}
-  else if (!redraw2 || redraw2 == item) {redraw2 = item; damage(FL_DAMAGE_EXPOSE);}
-  else damage(FL_DAMAGE_SCROLL);
+  // if all lines will be redrawn anyway there is nothing to schedule, but a
+  // pending blit-scroll must still be told which rows cannot just be copied:
+  if ((damage() & FL_DAMAGE_SCROLL) && !scroll_blit_) return;
+  for (int i = 0; i < redraw_count_; i++)
+    if (redraw_items_[i] == item) return; // already scheduled
+  if (redraw_count_ >= 128) {
+    // with this many changed lines a full repaint is cheaper than testing
+    // every visible line against the scheduled items:
+    redraw_lines();
+    return;
+  }
+  if (redraw_count_ >= redraw_size_) {
+    redraw_size_ = redraw_size_ ? redraw_size_ * 2 : 16;
+    redraw_items_ = (void**)realloc(redraw_items_, redraw_size_ * sizeof(void*));
+  }
+  redraw_items_[redraw_count_++] = item;
+  damage(FL_DAMAGE_EXPOSE);
+}
+
+// True if item was passed to redraw_line() since the last draw():
+int Fl_Browser_::redraw_marked(void* item) const {
+  for (int i = 0; i < redraw_count_; i++)
+    if (redraw_items_[i] == item) return 1;
+  return 0;
 }
 
 // Figure out top() based on position():
@@ -134,8 +157,22 @@ void Fl_Browser_::update_top() {
     void* l;
     int ly;
     int yy = position_;
-    // start from either head or current position, whichever is closer:
-    if (!top_ || yy <= (real_position_/2)) {
+    // start from the head, the current position or the tail, whichever
+    // is closest to the target position:
+    int dh = yy;  // distance when starting at the head
+    int dc = (top_ && real_position_ > yy) ? real_position_ - yy : yy - real_position_;
+    if (!top_) dc = dh;
+    void* tail = 0;
+    int fh = 0;
+    if (dh > 0 && dc > 0) {
+      // the tail is only reachable if the subclass implements item_last():
+      tail = item_last();
+      if (tail) fh = full_height();
+    }
+    if (tail && (fh - yy) < dh && (fh - yy) < dc) {
+      l = tail;
+      ly = fh - item_quick_height(tail);
+    } else if (!top_ || dh <= dc) {
       l = item_first();
       ly = 0;
     } else {
@@ -195,7 +232,14 @@ void Fl_Browser_::position(int pos) {
   if (pos < 0) pos = 0;
   if (pos == position_) return;
   position_ = pos;
-  if (pos != real_position_) redraw_lines();
+  if (pos != real_position_) {
+    // scrolling does not change the rows themselves, so unless a content
+    // change already scheduled a full row repaint, draw() may satisfy this
+    // by blitting the surviving rows into place, see draw():
+    int blit = scroll_blit_ || !(damage() & FL_DAMAGE_SCROLL);
+    redraw_lines();
+    scroll_blit_ = (char)blit;
+  }
 }
 
 /**
@@ -320,6 +364,48 @@ void Fl_Browser_::display(void* item) {
 #endif
 }
 
+// Draw the rows intersecting the given rectangle, called by fl_scroll()
+// for the areas a blit-scroll uncovered (and directly for sub-areas):
+void Fl_Browser_::draw_clip(int ex, int ey, int ew, int eh) {
+  int X, Y, W, H; bbox(X, Y, W, H);
+  fl_push_clip(ex, ey, ew, eh);
+  void* l = top();
+  int yy = -offset_;
+  for (; l && yy < H; l = item_next(l)) {
+    int hh = item_height(l);
+    if (hh <= 0) continue;
+    if (yy+Y+hh > ey && yy+Y < ey+eh) {
+      if (item_selected(l)) {
+        fl_color(active_r() ? selection_color() : fl_inactive(selection_color()));
+        fl_rectf(X, yy+Y, W, hh);
+      } else {
+        fl_push_clip(X, yy+Y, W, hh);
+        draw_box(box() ? box() : FL_DOWN_BOX, x(), y(), w(), h(), color());
+        fl_pop_clip();
+      }
+      item_draw(l, X-hposition_, yy+Y, W+hposition_, hh);
+      if (l == selection_ && Fl::focus() == this) {
+        draw_box(FL_BORDER_FRAME, X, yy+Y, W, hh, color());
+        draw_focus(FL_NO_BOX, X, yy+Y, W+1, hh+1);
+      }
+      int ww = item_width(l);
+      if (ww > max_width) {max_width = ww; max_width_item = l;}
+    }
+    yy += hh;
+  }
+  // erase the area below the last line:
+  if (yy < H) {
+    fl_push_clip(X, yy+Y, W, H-yy);
+    draw_box(box() ? box() : FL_DOWN_BOX, x(), y(), w(), h(), color());
+    fl_pop_clip();
+  }
+  fl_pop_clip();
+}
+
+void Fl_Browser_::draw_clip_cb(void* v, int X, int Y, int W, int H) {
+  ((Fl_Browser_*)v)->draw_clip(X, Y, W, H);
+}
+
 // redraw, has side effect of updating top and setting scrollbar:
 /**
   Draws the list within the normal widget bounding box.
@@ -388,6 +474,18 @@ J1:
 
   bbox(X, Y, W, H);
 
+  // If the rows are unchanged and merely scrolled, blit the surviving rows
+  // into place and repaint only the newly exposed strip instead of running
+  // item_draw() for every visible row:
+  if (scroll_blit_ && (damage() & FL_DAMAGE_SCROLL) && !(damage() & FL_DAMAGE_ALL) &&
+      !drawsquare && hposition_ == drawn_hposition_) {
+    int scrolled = real_position_ - drawn_position_;
+    if (scrolled > -H && scrolled < H) {
+      if (scrolled) fl_scroll(X, Y, W, H, 0, -scrolled, draw_clip_cb, this);
+      clear_damage((uchar)(damage() & ~FL_DAMAGE_SCROLL));
+    }
+  }
+
   fl_push_clip(X, Y, W, H);
   // for each line, draw it if full redraw or scrolled.  Erase background
   // if not a full redraw or if it is selected:
@@ -396,7 +494,7 @@ J1:
   for (; l && yy < H; l = item_next(l)) {
     int hh = item_height(l);
     if (hh <= 0) continue;
-    if ((damage()&(FL_DAMAGE_SCROLL|FL_DAMAGE_ALL)) || l == redraw1 || l == redraw2) {
+    if ((damage()&(FL_DAMAGE_SCROLL|FL_DAMAGE_ALL)) || redraw_marked(l)) {
       if (item_selected(l)) {
         fl_color(active_r() ? selection_color() : fl_inactive(selection_color()));
         fl_rectf(X, yy+Y, W, hh);
@@ -424,7 +522,7 @@ J1:
   fl_pop_clip();
 
   fl_push_clip(x(),y(),w(),h());                // STR# 2886
-  redraw1 = redraw2 = 0;
+  redraw_count_ = 0;
   if (!dont_repeat) {
     dont_repeat = 1;
     // see if changes to full_height caused by calls to slow_height
@@ -474,6 +572,9 @@ J1:
   }
 
   real_hposition_ = hposition_;
+  drawn_position_ = real_position_;
+  drawn_hposition_ = hposition_;
+  scroll_blit_ = 0;
   fl_pop_clip();
 }
 
@@ -493,6 +594,9 @@ void Fl_Browser_::new_list() {
   offset_ = 0;
   max_width = 0;
   max_width_item = 0;
+  redraw_count_ = 0; // the scheduled items are gone
+  selected_count_ = 0;
+  full_height_cache_ = -1;
   redraw_lines();
 }
 
@@ -519,9 +623,15 @@ void Fl_Browser_::deleting(void* item) {
     real_position_ = 0;
     offset_ = 0;
     top_ = 0;
+    scroll_blit_ = 0; // the row positions are renumbered, blitting is off
   }
   if (item == selection_) selection_ = 0;
   if (item == max_width_item) {max_width_item = 0; max_width = 0;}
+  // forget the scheduled redraw, the pointer may be reused by a new item:
+  for (int i = 0; i < redraw_count_; i++)
+    if (redraw_items_[i] == item) {redraw_items_[i] = redraw_items_[--redraw_count_]; break;}
+  track_selected(item, 0);
+  full_height_cache_ = -1;
 }
 
 /**
@@ -534,7 +644,12 @@ void Fl_Browser_::deleting(void* item) {
   \param[in] b Item to replace 'a'
 */
 void Fl_Browser_::replacing(void* a, void* b) {
-  redraw_line(a);
+  for (int i = 0; i < redraw_count_; i++)
+    if (redraw_items_[i] == a) {redraw_items_[i] = b; break;}
+  for (int i = 0; i < selected_count_; i++)
+    if (selected_items_[i] == a) {selected_items_[i] = b; break;}
+  redraw_line(b);
+  full_height_cache_ = -1;
   if (a == selection_) selection_ = b;
   if (a == top_) top_ = b;
   if (a == max_width_item) {max_width_item = 0; max_width = 0;}
@@ -569,7 +684,9 @@ void Fl_Browser_::swapping(void* a, void* b) {
 */
 void Fl_Browser_::inserting(void* a, void* b) {
   if (displayed(a)) redraw_lines();
+  else scroll_blit_ = 0; // rows outside the view are renumbered, blitting is off
   if (a == top_) top_ = b;
+  full_height_cache_ = -1;
 }
 
 /**
@@ -603,6 +720,22 @@ void* Fl_Browser_::find_item(int ypos) {
                          If 0, doesn't do callback (default).
   \returns 1 if state was changed, 0 if not.
 */
+// Keeps selected_items_ in sync with the selection flags set through
+// select(): the items whose flag we set are listed there, so deselect()
+// and select_only() can visit just those instead of walking every item.
+void Fl_Browser_::track_selected(void *item, int val) {
+  if (val) {
+    if (selected_count_ >= selected_size_) {
+      selected_size_ = selected_size_ ? selected_size_ * 2 : 16;
+      selected_items_ = (void**)realloc(selected_items_, selected_size_ * sizeof(void*));
+    }
+    selected_items_[selected_count_++] = item;
+  } else {
+    for (int i = 0; i < selected_count_; i++)
+      if (selected_items_[i] == item) {selected_items_[i] = selected_items_[--selected_count_]; break;}
+  }
+}
+
 int Fl_Browser_::select(void* item, int val, int docallbacks) {
   if (type() == FL_MULTI_BROWSER) {
     if (selection_ != item) {
@@ -612,17 +745,20 @@ int Fl_Browser_::select(void* item, int val, int docallbacks) {
     }
     if ((!val)==(!item_selected(item))) return 0;
     item_select(item, val);
+    track_selected(item, val);
     redraw_line(item);
   } else {
     if (val && selection_ == item) return 0;
     if (!val && selection_ != item) return 0;
     if (selection_) {
       item_select(selection_, 0);
+      track_selected(selection_, 0);
       redraw_line(selection_);
       selection_ = 0;
     }
     if (val) {
       item_select(item, 1);
+      track_selected(item, 1);
       selection_ = item;
       redraw_line(item);
       display(item);
@@ -647,13 +783,30 @@ int Fl_Browser_::select(void* item, int val, int docallbacks) {
 */
 int Fl_Browser_::deselect(int docallbacks) {
   if (type() == FL_MULTI_BROWSER) {
+    // only the items select() marked selected can have their flag set,
+    // so visit those instead of walking the whole (possibly huge) list
     int change = 0;
-    for (void* p = item_first(); p; p = item_next(p))
-      change |= select(p, 0, docallbacks);
+    Fl_Widget_Tracker wp(this);
+    while (selected_count_) {
+      void* p = selected_items_[--selected_count_];
+      if (!item_selected(p)) continue;
+      item_select(p, 0);
+      redraw_line(p);
+      change = 1;
+      if (docallbacks) {
+        set_changed();
+        do_callback();
+        if (wp.deleted()) return change;
+      }
+    }
+    // the focus item ends up on the last line, as it always did
+    selection_ = item_last();
+    if (selection_) redraw_line(selection_);
     return change;
   } else {
     if (!selection_) return 0;
     item_select(selection_, 0);
+    track_selected(selection_, 0);
     redraw_line(selection_);
     selection_ = 0;
     return 1;
@@ -672,9 +825,19 @@ int Fl_Browser_::select_only(void* item, int docallbacks) {
   int change = 0;
   Fl_Widget_Tracker wp(this);
   if (type() == FL_MULTI_BROWSER) {
-    for (void* p = item_first(); p; p = item_next(p)) {
-      if (p != item) change |= select(p, 0, docallbacks);
+    // clear only the items select() marked selected, see deselect()
+    for (int i = 0; i < selected_count_;) {
+      void* p = selected_items_[i];
+      if (p == item) {i++; continue;}
+      if (!item_selected(p)) { // drop a stale entry
+        selected_items_[i] = selected_items_[--selected_count_];
+        continue;
+      }
+      change |= select(p, 0, docallbacks);
       if (wp.deleted()) return change;
+      // select(p, 0) normally removed p from selected_items_; only
+      // advance if the slot still holds it
+      if (i < selected_count_ && selected_items_[i] == p) i++;
     }
   }
   change |= select(item, 1, docallbacks);
@@ -975,13 +1138,32 @@ Fl_Browser_::Fl_Browser_(int X, int Y, int W, int H, const char* L)
   max_width = 0;
   max_width_item = 0;
   scrollbar_size_ = 0;
-  redraw1 = redraw2 = 0;
+  redraw_items_ = 0;
+  redraw_count_ = redraw_size_ = 0;
+  selected_items_ = 0;
+  selected_count_ = selected_size_ = 0;
+  full_height_cache_ = -1;
+  drawn_position_ = drawn_hposition_ = 0;
+  scroll_blit_ = 0;
   end();
 }
 
+/**
+  The destructor frees all internal data of the browser.
+*/
+Fl_Browser_::~Fl_Browser_() {
+  if (redraw_items_) free(redraw_items_);
+  if (selected_items_) free(selected_items_);
+}
+
 /**
   Sort the items in the browser based on \p flags.
   item_swap(void*, void*) and item_text(void*) must be implemented for this call.
+
+  The sort is stable: items whose text compares equal keep their
+  relative order, so sorting by several keys in succession works as
+  expected.
+
   \param[in] flags FL_SORT_ASCENDING -- sort in ascending order\n
                    FL_SORT_DESCENDING -- sort in descending order\n
                    Values other than the above will cause undefined behavior\n
@@ -989,40 +1171,96 @@ Fl_Browser_::Fl_Browser_(int X, int Y, int W, int H, const char* L)
   \todo Add a flag to ignore case
 */
 void Fl_Browser_::sort(int flags) {
-  //
-  // Simple bubble sort - pure lazyness on my side.
-  //
-  int i, j, n = -1, desc = ((flags&FL_SORT_DESCENDING)==FL_SORT_DESCENDING);
-  void *a =item_first(), *b, *c;
-  if (!a) return;
-  while (a) {
-    a = item_next(a);
-    n++;
-  }
-  for (i=n; i>0; i--) {
-    char swapped = 0;
-    a = item_first();
-    b = item_next(a);
-    for (j=0; j<i; j++) {
-      const char *ta = item_text(a);
-      const char *tb = item_text(b);
-      c = item_next(b);
-      if (desc) {
-        if (strcmp(ta, tb)<0) {
-          item_swap(a, b);
-          swapped = 1;
-        }
-      } else {
-        if (strcmp(ta, tb)>0) {
-          item_swap(a, b);
-          swapped = 1;
-        }
+  int i, desc = ((flags&FL_SORT_DESCENDING)==FL_SORT_DESCENDING);
+  void *p;
+  int n = 0;
+  for (p = item_first(); p; p = item_next(p)) n++;
+  if (n < 2) return;
+
+  // collect the items, then merge sort an index array over them; the
+  // list itself is only touched by the final swap pass
+  void **items = new void*[n];
+  i = 0;
+  for (p = item_first(); p; p = item_next(p)) items[i++] = p;
+
+  int *order = new int[n];
+  int *temp = new int[n];
+  for (i = 0; i < n; i++) order[i] = i;
+  for (int width = 1; width < n; width *= 2) {
+    for (int lo = 0; lo + width < n; lo += 2*width) {
+      int mid = lo + width;
+      int hi = lo + 2*width; if (hi > n) hi = n;
+      int a = lo, b = mid, k = lo;
+      while (a < mid && b < hi) {
+        int c = strcmp(item_text(items[order[a]]), item_text(items[order[b]]));
+        // take from the left run on ties to keep the sort stable
+        if (desc ? (c >= 0) : (c <= 0)) temp[k++] = order[a++];
+        else temp[k++] = order[b++];
       }
-      if (!c) break;
-      b = c; a = item_prev(b);
+      while (a < mid) temp[k++] = order[a++];
+      while (b < hi) temp[k++] = order[b++];
+      memcpy(order+lo, temp+lo, (hi-lo)*sizeof(int));
     }
-    if (!swapped)
-      break;
+  }
+
+  // apply the permutation with at most n-1 swaps: 'at' maps a list
+  // position to the item (by original index) now stored there, 'pos'
+  // is its inverse
+  int *at = temp; // reuse
+  int *pos = new int[n];
+  for (i = 0; i < n; i++) { at[i] = i; pos[i] = i; }
+  for (int k = 0; k < n; k++) {
+    int want = order[k];    // original index that belongs at position k
+    int cur = pos[want];    // position it currently occupies
+    if (cur == k) continue;
+    item_swap(items[at[k]], items[want]);
+    int was = at[k];
+    at[k] = want; at[cur] = was;
+    pos[want] = k; pos[was] = cur;
+  }
+
+  delete[] pos;
+  delete[] temp;
+  delete[] order;
+  delete[] items;
+}
+
+/**
+  Repositions a single \p item whose sort key changed.
+
+  Assuming the rest of the list is already in the order sort() with the
+  same \p flags would produce, the item is bubbled towards the head or
+  the tail until it sits between its neighbors again, so the cost is
+  proportional to how far the item moved rather than to the list size.
+  Use this when individual rows of a large sorted list update, instead
+  of re-sorting everything.
+
+  Items comparing equal are not moved past each other, matching the
+  stable behavior of sort().
+  item_swap(void*, void*) and item_text(void*) must be implemented for
+  this call.
+
+  \param[in] item  the item whose text changed
+  \param[in] flags same sort order flags that were passed to sort()
+
+  \see Fl_Browser_::sort(int)
+  \since 1.4.0
+*/
+void Fl_Browser_::sort_item(void *item, int flags) {
+  if (!item) return;
+  int desc = ((flags&FL_SORT_DESCENDING)==FL_SORT_DESCENDING);
+  void *other;
+  // bubble towards the head while the item sorts before its predecessor
+  while ((other = item_prev(item)) != 0) {
+    int c = strcmp(item_text(other), item_text(item));
+    if (desc ? (c < 0) : (c > 0)) item_swap(other, item);
+    else break;
+  }
+  // and towards the tail while it sorts after its successor
+  while ((other = item_next(item)) != 0) {
+    int c = strcmp(item_text(item), item_text(other));
+    if (desc ? (c < 0) : (c > 0)) item_swap(item, other);
+    else break;
   }
 }
 
@@ -1055,15 +1293,24 @@ int Fl_Browser_::incr_height() const {
 /**
   This method may be provided by the subclass to indicate the full height
   of the item list, in pixels.
-  The default implementation computes the full height from the item heights.
+  The default implementation computes the full height from the item heights,
+  and caches the result; the bookkeeping methods (inserting(), deleting(),
+  replacing(), new_list()) invalidate the cache, so the items are not walked
+  again until the list changes.
+  Subclasses whose item_quick_height() differs from item_height() should
+  override this method, because the cache cannot see later corrections made
+  by item_height().
   Includes the items that are scrolled off screen.
   \returns The height of the entire list, in pixels.
 */
 int Fl_Browser_::full_height() const {
-  int t = 0;
-  for (void* p = item_first(); p; p = item_next(p))
-    t += item_quick_height(p);
-  return t;
+  if (full_height_cache_ < 0) {
+    int t = 0;
+    for (void* p = item_first(); p; p = item_next(p))
+      t += item_quick_height(p);
+    full_height_cache_ = t;
+  }
+  return full_height_cache_;
 }
 
 /**
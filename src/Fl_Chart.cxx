@@ -219,14 +219,46 @@ static void draw_piechart(int x,int y,int w,int h,
     }
 }
 
+// fl_scroll() callback: repaints the strip of the plot a blit uncovered
+void Fl_Chart::draw_clip_(void *v, int X, int Y, int W, int H) {
+  Fl_Chart *c = (Fl_Chart*)v;
+  fl_push_clip(X, Y, W, H);
+  c->draw(); // pending_scroll_ is 0 here, so this is a normal clipped redraw
+  fl_pop_clip();
+}
+
 void Fl_Chart::draw() {
 
-    draw_box();
     Fl_Boxtype b = box();
     int xx = x()+Fl::box_dx(b); // was 9 instead of dx...
     int yy = y()+Fl::box_dy(b);
     int ww = w()-Fl::box_dw(b);
     int hh = h()-Fl::box_dh(b);
+
+    // Incremental strip-chart update: when only new samples were appended
+    // to a full chart with fixed bounds, shift the rendered plot sideways
+    // with a blit and repaint just the newly exposed strip through the
+    // scroll callback. Bar positions are exact multiples of the strip
+    // width; the other chart types center on half strip widths and thus
+    // need an even strip width to land on the same pixels after the shift.
+    if (pending_scroll_ > 0 && damage() == FL_DAMAGE_SCROLL) {
+        int n = pending_scroll_;
+        pending_scroll_ = 0;
+        int cw = (type() == FL_BAR_CHART) ? ww : ww-1;
+        int bw = (maxnumb > 0 && cw > 0 && cw % maxnumb == 0) ? cw/maxnumb : 0;
+        if (type() != FL_BAR_CHART && (bw & 1)) bw = 0;
+        int supported = (type() == FL_BAR_CHART || type() == FL_LINE_CHART ||
+                         type() == FL_FILLED_CHART || type() == FL_SPIKE_CHART);
+        int inside_label = label() && (align() & FL_ALIGN_INSIDE);
+        if (supported && bw > 0 && n*bw < cw && numb == maxnumb &&
+            min < max && !inside_label) {
+            fl_scroll(xx, yy, ww, hh, -n*bw, 0, draw_clip_, this);
+            return;
+        }
+    }
+    pending_scroll_ = 0;
+
+    draw_box();
     fl_push_clip(xx, yy, ww, hh);
 
     ww--; hh--; // adjust for line thickness
@@ -234,8 +266,8 @@ void Fl_Chart::draw() {
     if (min >= max) {
         min = max = 0.0;
         for (int i=0; i<numb; i++) {
-            if (entries[i].val < min) min = entries[i].val;
-            if (entries[i].val > max) max = entries[i].val;
+            if (entries[first_+i].val < min) min = entries[first_+i].val;
+            if (entries[first_+i].val > max) max = entries[first_+i].val;
         }
     }
 
@@ -244,22 +276,22 @@ void Fl_Chart::draw() {
     switch (type()) {
     case FL_BAR_CHART:
         ww++; // makes the bars fill box correctly
-        draw_barchart(xx,yy,ww,hh, numb, entries, min, max,
+        draw_barchart(xx,yy,ww,hh, numb, entries+first_, min, max,
                         autosize(), maxnumb, textcolor());
         break;
     case FL_HORBAR_CHART:
         hh++; // makes the bars fill box correctly
-        draw_horbarchart(xx,yy,ww,hh, numb, entries, min, max,
+        draw_horbarchart(xx,yy,ww,hh, numb, entries+first_, min, max,
                         autosize(), maxnumb, textcolor());
         break;
     case FL_PIE_CHART:
-        draw_piechart(xx,yy,ww,hh,numb,entries,0, textcolor());
+        draw_piechart(xx,yy,ww,hh,numb,entries+first_,0, textcolor());
         break;
     case FL_SPECIALPIE_CHART:
-        draw_piechart(xx,yy,ww,hh,numb,entries,1,textcolor());
+        draw_piechart(xx,yy,ww,hh,numb,entries+first_,1,textcolor());
         break;
     default:
-        draw_linechart(type(),xx,yy,ww,hh, numb, entries, min, max,
+        draw_linechart(type(),xx,yy,ww,hh, numb, entries+first_, min, max,
                         autosize(), maxnumb, textcolor());
         break;
     }
@@ -287,7 +319,10 @@ Fl_Widget(X,Y,W,H,L) {
   numb       = 0;
   maxnumb    = 0;
   sizenumb   = FL_CHART_MAX;
+  first_     = 0;
+  pending_scroll_ = 0;
   autosize_  = 1;
+  incremental_ = 0;
   min = max  = 0;
   textfont_  = FL_HELVETICA;
   textsize_  = 10;
@@ -307,6 +342,7 @@ Fl_Chart::~Fl_Chart() {
  */
 void Fl_Chart::clear() {
   numb = 0;
+  first_ = 0;
   min = max = 0;
   redraw();
 }
@@ -319,25 +355,44 @@ void Fl_Chart::clear() {
   \param[in] col optional data color
  */
 void Fl_Chart::add(double val, const char *str, unsigned col) {
-  /* Allocate more entries if required */
-  if (numb >= sizenumb) {
+  // Drop the oldest entry as needed by advancing the start of the window
+  // instead of memmove'ing the whole array for every sample; the array is
+  // slid back in one move only when its end is reached, which keeps the
+  // append cost O(1) amortized while the entries stay contiguous.
+  if (numb >= maxnumb && maxnumb > 0) {
+    first_++;
+    numb--;
+    if (first_ + numb >= sizenumb) {
+      if (sizenumb < 2 * maxnumb) {
+        sizenumb = 2 * maxnumb;
+        entries = (FL_CHART_ENTRY *)realloc(entries, sizeof(FL_CHART_ENTRY) * (sizenumb + 1));
+      } else {
+        memmove(entries, entries + first_, sizeof(FL_CHART_ENTRY) * numb);
+        first_ = 0;
+      }
+    }
+  } else if (first_ + numb >= sizenumb) {
+    /* Allocate more entries if required */
     sizenumb += FL_CHART_MAX;
     entries = (FL_CHART_ENTRY *)realloc(entries, sizeof(FL_CHART_ENTRY) * (sizenumb + 1));
   }
-  // Shift entries as needed
-  if (numb >= maxnumb && maxnumb > 0) {
-    memmove(entries, entries + 1, sizeof(FL_CHART_ENTRY) * (numb - 1));
-    numb --;
-  }
-  entries[numb].val = float(val);
-  entries[numb].col = col;
+  FL_CHART_ENTRY *e = &entries[first_ + numb];
+  e->val = float(val);
+  e->col = col;
     if (str) {
-        strlcpy(entries[numb].str,str,FL_CHART_LABEL_MAX + 1);
+        strlcpy(e->str,str,FL_CHART_LABEL_MAX + 1);
     } else {
-        entries[numb].str[0] = 0;
+        e->str[0] = 0;
     }
   numb++;
-  redraw();
+  // appending to a full chart with fixed bounds only scrolls the plot:
+  // let draw() blit it if incremental drawing is enabled and applicable
+  if (incremental_ && maxnumb > 0 && numb == maxnumb && min < max) {
+    pending_scroll_++;
+    damage(FL_DAMAGE_SCROLL);
+  } else {
+    redraw();
+  }
 }
 
 /**
@@ -351,6 +406,11 @@ void Fl_Chart::add(double val, const char *str, unsigned col) {
 void Fl_Chart::insert(int ind, double val, const char *str, unsigned col) {
   int i;
   if (ind < 1 || ind > numb+1) return;
+  // slide the window back to the start of the array first (cold path)
+  if (first_) {
+    memmove(entries, entries + first_, sizeof(FL_CHART_ENTRY) * numb);
+    first_ = 0;
+  }
   /* Allocate more entries if required */
   if (numb >= sizenumb) {
     sizenumb += FL_CHART_MAX;
@@ -380,12 +440,12 @@ void Fl_Chart::insert(int ind, double val, const char *str, unsigned col) {
  */
 void Fl_Chart::replace(int ind,double val, const char *str, unsigned col) {
   if (ind < 1 || ind > numb) return;
-  entries[ind-1].val = float(val);
-  entries[ind-1].col = col;
+  entries[first_+ind-1].val = float(val);
+  entries[first_+ind-1].col = col;
   if (str) {
-      strlcpy(entries[ind-1].str,str,FL_CHART_LABEL_MAX+1);
+      strlcpy(entries[first_+ind-1].str,str,FL_CHART_LABEL_MAX+1);
   } else {
-      entries[ind-1].str[0] = 0;
+      entries[first_+ind-1].str[0] = 0;
   }
   redraw();
 }
@@ -414,8 +474,12 @@ void Fl_Chart::maxsize(int m) {
   /* Shift entries if required */
   if (numb > maxnumb) {
       for (i = 0; i<maxnumb; i++)
-          entries[i] = entries[i+numb-maxnumb];
+          entries[i] = entries[first_+i+numb-maxnumb];
       numb = maxnumb;
+      first_ = 0;
       redraw();
+  } else if (first_) {
+      memmove(entries, entries + first_, sizeof(FL_CHART_ENTRY) * numb);
+      first_ = 0;
   }
 }
@@ -32,15 +32,20 @@ Fl_Check_Browser::cb_item *Fl_Check_Browser::find_item(int n) const {
     return 0;
   }
 
-  if (n == cached_item) {
-    p = cache;
-    n = 1;
-  } else if (n == cached_item + 1) {
-    p = cache->next;
-    n = 1;
-  } else if (n == cached_item - 1) {
-    p = cache->prev;
-    n = 1;
+  if (cache) {
+    int d = n - cached_item;            // distance from the cached item
+    int ad = d < 0 ? -d : d;
+    if (ad < n - 1) {                   // cached item closer than 'first'?
+      p = cache;
+      if (d >= 0) {
+        n = d + 1;                      // walk forward below
+      } else {
+        while (d++) {                   // walk backward from the cache
+          p = p->prev;
+        }
+        n = 1;
+      }
+    }
   }
 
   while (--n) {
@@ -80,6 +85,7 @@ Fl_Check_Browser::Fl_Check_Browser(int X, int Y, int W, int H, const char *l)
   when(FL_WHEN_NEVER);
   first = last = 0;
   nitems_ = nchecked_ = 0;
+  cache = 0;
   cached_item = -1;
 }
 
@@ -105,12 +111,7 @@ const char *Fl_Check_Browser::item_text(void *item) const {
 }
 
 void *Fl_Check_Browser::item_at(int index) const { // note: index is 1-based
-  if (index < 1 || index > nitems())
-    return 0L;
-  cb_item *item = (cb_item *)item_first();
-  for (int i = 1; i < index; i++)
-    item = (cb_item *)(item_next(item));
-  return (void *)item;
+  return find_item(index);      // handles range check, uses the item cache
 }
 
 void Fl_Check_Browser::item_swap(int ia, int ib) {
@@ -291,6 +292,7 @@ int Fl_Check_Browser::remove(int item) {
     free(p);
 
     --nitems_;
+    cache = 0;
     cached_item = -1;
   }
 
@@ -314,6 +316,7 @@ void Fl_Check_Browser::clear() {
 
   first = last = 0;
   nitems_ = nchecked_ = 0;
+  cache = 0;
   cached_item = -1;
 }
 
@@ -336,7 +339,7 @@ void Fl_Check_Browser::checked(int i, int b) {
     } else {
       nchecked_--;
     }
-    redraw();
+    redraw_line(p);     // repaint just this row, not the whole list
   }
 }
 
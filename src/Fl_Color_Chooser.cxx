@@ -16,6 +16,7 @@
 
 #include <FL/Fl.H>
 #include <FL/Fl_Color_Chooser.H>
+#include <FL/Fl_Image.H>
 #include <FL/fl_draw.H>
 #include <FL/math.h>
 #include <stdio.h>
@@ -299,6 +300,10 @@ int Flcc_HueBox::handle_key(int key) {
 #endif // !FL_DOXYGEN
 
 #ifndef FL_DOXYGEN
+Flcc_HueBox::~Flcc_HueBox() {
+  delete cache_;
+}
+
 void Flcc_HueBox::draw() {
   if (damage()&FL_DAMAGE_ALL) draw_box();
   int x1 = x()+Fl::box_dx(box());
@@ -306,8 +311,23 @@ void Flcc_HueBox::draw() {
   int w1 = w()-Fl::box_dw(box());
   int h1 = h()-Fl::box_dh(box());
   if (w1>0 && h1>0) {
+#ifdef UPDATE_HUE_BOX
+    const double V = ((Fl_Color_Chooser*)parent())->value();
+#else
+    const double V = 1.0;
+#endif
+    if (!cache_ || cache_->w() != w1 || cache_->h() != h1 || cache_v_ != V) {
+      // regenerate the gradient well; hue or saturation drags reuse it
+      // and only move the crosshair over the cached image
+      uchar *data = new uchar[w1 * h1 * 3];
+      for (int j = 0; j < h1; j++) generate_image(this, 0, j, w1, data + j*w1*3);
+      delete cache_;
+      cache_ = new Fl_RGB_Image(data, w1, h1, 3);
+      cache_->alloc_array = 1;
+      cache_v_ = V;
+    }
     if (damage() == FL_DAMAGE_EXPOSE) fl_push_clip(x1+px,yy1+py,6,6);
-    fl_draw_image(generate_image, this, x1, yy1, w1, h1);
+    cache_->draw(x1, yy1);
     if (damage() == FL_DAMAGE_EXPOSE) fl_pop_clip();
   }
   Fl_Color_Chooser* c = (Fl_Color_Chooser*)parent();
@@ -377,6 +397,10 @@ static void generate_vimage(void* vv, int X, int Y, int W, uchar* buf) {
 }
 
 #ifndef FL_DOXYGEN
+Flcc_ValueBox::~Flcc_ValueBox() {
+  delete cache_;
+}
+
 void Flcc_ValueBox::draw() {
   if (damage()&FL_DAMAGE_ALL) draw_box();
   Fl_Color_Chooser* c = (Fl_Color_Chooser*)parent();
@@ -386,8 +410,19 @@ void Flcc_ValueBox::draw() {
   int w1 = w()-Fl::box_dw(box());
   int h1 = h()-Fl::box_dh(box());
   if (w1>0 && h1>0) {
+    if (!cache_ || cache_->w() != w1 || cache_->h() != h1 ||
+        cache_r_ != tr || cache_g_ != tg || cache_b_ != tb) {
+      // regenerate the gradient ramp; value drags reuse it and only
+      // move the marker over the cached image
+      uchar *data = new uchar[w1 * h1 * 3];
+      for (int j = 0; j < h1; j++) generate_vimage(this, 0, j, w1, data + j*w1*3);
+      delete cache_;
+      cache_ = new Fl_RGB_Image(data, w1, h1, 3);
+      cache_->alloc_array = 1;
+      cache_r_ = tr; cache_g_ = tg; cache_b_ = tb;
+    }
     if (damage() == FL_DAMAGE_EXPOSE) fl_push_clip(x1,yy1+py,w1,6);
-    fl_draw_image(generate_vimage, this, x1, yy1, w1, h1);
+    cache_->draw(x1, yy1);
     if (damage() == FL_DAMAGE_EXPOSE) fl_pop_clip();
   }
   int Y = int((1-c->value()) * (h1-6));
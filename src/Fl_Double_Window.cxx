@@ -80,3 +80,48 @@ void Fl_Double_Window::flush()
 Fl_Double_Window::~Fl_Double_Window() {
   hide();
 }
+
+
+/**
+  Sets how many bytes of destroyed backbuffers are kept for reuse.
+
+  By default (0) every double-buffered window allocates its own
+  offscreen buffer when first flushed and deletes it when the window
+  is hidden or enlarged. With a nonzero cap the buffers are parked in
+  a shared pool instead and handed out again to the next window of
+  the same size, which avoids the round trip to the windowing system
+  when windows are hidden and reshown, and bounds the pixmap memory
+  those buffers can hold. Has no effect on backbuffers provided by
+  the X double buffering extension, which belong to their window.
+
+  \see backbuffer_idle_timeout(double)
+*/
+void Fl_Double_Window::backbuffer_pool_max(size_t bytes) {
+  Fl_Window_Driver::buffer_pool_max(bytes);
+}
+
+/** Returns the backbuffer pool cap set with backbuffer_pool_max(size_t). */
+size_t Fl_Double_Window::backbuffer_pool_max() {
+  return Fl_Window_Driver::buffer_pool_max();
+}
+
+/**
+  Reclaims the backbuffer of windows that have not been redrawn for
+  approximately \p secs seconds, e.g. iconified or fully covered
+  windows. A window whose buffer was reclaimed simply redraws
+  completely the next time it is flushed, so very short timeouts trade
+  redraw work for memory. The default (0) keeps every shown window's
+  backbuffer allocated, as before.
+
+  Combined with backbuffer_pool_max(size_t) this caps the steady-state
+  backbuffer memory of applications with many windows: idle windows
+  release their buffers into the pool and active ones lease them back.
+*/
+void Fl_Double_Window::backbuffer_idle_timeout(double secs) {
+  Fl_Window_Driver::buffer_idle_timeout(secs);
+}
+
+/** Returns the timeout set with backbuffer_idle_timeout(double). */
+double Fl_Double_Window::backbuffer_idle_timeout() {
+  return Fl_Window_Driver::buffer_idle_timeout();
+}
@@ -46,6 +46,9 @@
 
 #define SELECTED 1
 #define NOTDISPLAYED 2
+// Private to Fl_File_Browser: the file icon of this line has not been
+// resolved yet; it will be looked up when the line first becomes visible.
+#define ICON_PENDING 4
 
 // TODO -- Warning: The definition of FL_BLINE here is a hack.
 //    Fl_File_Browser should not do this. PLEASE FIX.
@@ -58,6 +61,7 @@ struct FL_BLINE                 // data is in a linked list of these
   FL_BLINE      *next;          // Next item in list
   void          *data;          // Pointer to data (function)
   Fl_Image      *icon;          // Pointer to optional icon
+  void          *parsed;        // Cached format parse (private to Fl_Browser.cxx)
   short         length;         // sizeof(txt)-1, may be longer than string
   char          flags;          // selected, displayed
   char          txt[1];         // start of allocated array
@@ -251,6 +255,21 @@ Fl_File_Browser::item_draw(void *p,     // I - List item data
   // Draw the list item text...
   line = (FL_BLINE *)p;
 
+  // Look up the file icon the first time the line becomes visible; load()
+  // defers this so that loading a directory does not stat() every file.
+  if (line->flags & ICON_PENDING)
+  {
+    line->flags &= ~ICON_PENDING;
+
+    if (Fl_File_Icon::first() != NULL && directory_ != NULL)
+    {
+      char filename[4096];              // Full path of this file
+
+      fl_snprintf(filename, sizeof(filename), "%s/%s", directory_, line->txt);
+      line->data = Fl_File_Icon::find(filename);
+    }
+  }
+
   if (line->txt[strlen(line->txt) - 1] == '/')
     fl_font(textfont() | FL_BOLD, textsize());
   else
@@ -368,7 +387,7 @@ Fl_File_Browser::Fl_File_Browser(int        X,  // I - Upper-lefthand X coordina
 {
   // Initialize the filter pattern, current directory, and icon size...
   pattern_   = "*";
-  directory_ = "";
+  directory_ = fl_strdup("");
   iconsize_  = (uchar)(3 * textsize() / 2);
   filetype_  = FILES;
   errmsg_    = NULL;
@@ -378,6 +397,8 @@ Fl_File_Browser::Fl_File_Browser(int        X,  // I - Upper-lefthand X coordina
 // DTOR
 Fl_File_Browser::~Fl_File_Browser() {
   errmsg(NULL);       // free()s prev errmsg, if any
+  if (directory_)
+    free((void *)directory_);
 }
 
 
@@ -421,7 +442,11 @@ Fl_File_Browser::load(const char     *directory,// I - Directory to load
 
   clear();
 
-  directory_ = directory;
+  // Keep a private copy of the directory name; icons of visible lines are
+  // resolved after load() returns and need a path that is still valid...
+  if (directory_)
+    free((void *)directory_);
+  directory_ = directory ? fl_strdup(directory) : NULL;
 
   if (!directory) {
     errmsg("NULL directory specified");
@@ -454,16 +479,26 @@ Fl_File_Browser::load(const char     *directory,// I - Directory to load
 
     for (i = 0, num_dirs = 0; i < num_files; i ++) {
       if (strcmp(files[i]->d_name, "./")) {
-        fl_snprintf(filename, sizeof(filename), "%s/%s", directory_, files[i]->d_name);
-
-        icon = Fl_File_Icon::find(filename);
-        if ((icon && icon->type() == Fl_File_Icon::DIRECTORY) ||
-            Fl::system_driver()->filename_isdir_quick(filename)) {
+        // fl_filename_list() appended a '/' to the name of every directory,
+        // so the directory check costs no extra stat() per file here
+        int len = (int) strlen(files[i]->d_name);
+        if (len > 0 && files[i]->d_name[len-1] == '/') {
+          // The file type is already known, so directory icons can be
+          // resolved without touching the file system...
+          fl_snprintf(filename, sizeof(filename), "%s/%s", directory_, files[i]->d_name);
+
+          icon = Fl_File_Icon::find(filename, Fl_File_Icon::DIRECTORY);
           num_dirs ++;
           insert(num_dirs, files[i]->d_name, icon);
         } else if (filetype_ == FILES &&
                    fl_filename_match(files[i]->d_name, pattern_)) {
-          add(files[i]->d_name, icon);
+          // Defer the icon lookup until the line becomes visible; finding
+          // the file type needs a stat() per file, which adds up badly on
+          // large (especially networked) directories...
+          add(files[i]->d_name, 0);
+
+          if (Fl_File_Icon::first() != NULL)
+            ((FL_BLINE *)item_last())->flags |= ICON_PENDING;
         }
       }
 
@@ -1238,6 +1238,145 @@ Fl_File_Chooser::update_favorites()
 }
 
 
+//
+// Small MRU cache of ready-to-show preview images, shared by all file
+// choosers in the process. Re-selecting a file only costs a stat() instead
+// of decoding and scaling the image again, which matters when flipping
+// back and forth between large photos. Entries are keyed by path, file
+// modification time and size, and by the preview box size the image was
+// scaled for.
+//
+// Ownership: the cache holds exactly one reference to each image, and
+// update_preview() puts cached images into the preview box without taking
+// another one. An entry whose image is currently displayed is therefore
+// only unlinked, never released; update_preview() releases the displaced
+// image on the next update when it is no longer in the cache.
+//
+
+#define PREVIEW_CACHE_MAX 20
+
+struct Fl_Preview_Cache {
+  Fl_Preview_Cache      *next;          // Next entry in the list
+  char                  *filename;      // Full path of the previewed file
+  time_t                mtime;          // Modification time of the file
+  long                  fsize;          // Size of the file
+  int                   pbw, pbh;       // Preview box size it was scaled for
+  Fl_Shared_Image       *image;         // Ready-to-show preview image
+};
+
+static Fl_Preview_Cache *preview_cache = (Fl_Preview_Cache *)0;
+static int              preview_cache_size = 0;
+
+
+//
+// 'preview_cache_remove()' - Drop a cache entry, keeping displayed images alive.
+//
+
+static void
+preview_cache_remove(Fl_Preview_Cache **cp,     // I - Pointer to entry link
+                     Fl_Image         *displayed) // I - Image in the preview box
+{
+  Fl_Preview_Cache *c = *cp;            // Entry to remove
+
+  *cp = c->next;
+  if ((Fl_Image *)c->image != displayed)
+    c->image->release();
+  free(c->filename);
+  delete c;
+  preview_cache_size --;
+}
+
+
+//
+// 'preview_cache_find()' - Return a cached preview image or NULL.
+//
+
+static Fl_Shared_Image *                // O - Cached image or NULL
+preview_cache_find(const char *filename,    // I - Full path of the file
+                   time_t     mtime,        // I - Current modification time
+                   long       fsize,        // I - Current file size
+                   int        pbw,          // I - Preview box width
+                   int        pbh,          // I - Preview box height
+                   Fl_Image   *displayed)   // I - Image in the preview box
+{
+  Fl_Preview_Cache      *c,             // Current cache entry
+                        **cp;           // Pointer to current entry link
+
+  for (cp = &preview_cache; (c = *cp) != (Fl_Preview_Cache *)0; cp = &c->next) {
+    if (strcmp(c->filename, filename)) continue;
+
+    if (c->mtime != mtime || c->fsize != fsize ||
+        c->pbw != pbw || c->pbh != pbh) {
+      // The file changed on disk or the box was resized; drop the entry...
+      preview_cache_remove(cp, displayed);
+      return ((Fl_Shared_Image *)0);
+    }
+
+    // Move the entry to the front of the list...
+    *cp = c->next;
+    c->next = preview_cache;
+    preview_cache = c;
+
+    return (c->image);
+  }
+
+  return ((Fl_Shared_Image *)0);
+}
+
+
+//
+// 'preview_cache_add()' - Remember a preview image, taking one reference.
+//
+
+static void
+preview_cache_add(const char      *filename,    // I - Full path of the file
+                  time_t          mtime,        // I - Modification time of the file
+                  long            fsize,        // I - Size of the file
+                  int             pbw,          // I - Preview box width
+                  int             pbh,          // I - Preview box height
+                  Fl_Shared_Image *image,       // I - Ready-to-show preview image
+                  Fl_Image        *displayed)   // I - Image in the preview box
+{
+  Fl_Preview_Cache      *c,             // New cache entry
+                        **cp;           // Pointer to current entry link
+
+  c           = new Fl_Preview_Cache;
+  c->filename = fl_strdup(filename);
+  c->mtime    = mtime;
+  c->fsize    = fsize;
+  c->pbw      = pbw;
+  c->pbh      = pbh;
+  c->image    = image;
+  c->next     = preview_cache;
+
+  preview_cache = c;
+  preview_cache_size ++;
+
+  // Drop the least recently used entry...
+  if (preview_cache_size > PREVIEW_CACHE_MAX) {
+    for (cp = &preview_cache; (*cp)->next != (Fl_Preview_Cache *)0; cp = &(*cp)->next) {/*empty*/}
+    preview_cache_remove(cp, displayed);
+  }
+}
+
+
+//
+// 'preview_cache_has()' - Return whether an image is held by the cache.
+//
+
+static int                              // O - 1 if the image is cached
+preview_cache_has(Fl_Image *image)      // I - Image to look for
+{
+  Fl_Preview_Cache      *c;             // Current cache entry
+
+  for (c = preview_cache; c != (Fl_Preview_Cache *)0; c = c->next)
+    if ((Fl_Image *)c->image == image)
+      return (1);
+
+  return (0);
+}
+
+
 //
 // 'Fl_File_Chooser::update_preview()' - Update the preview box...
 //
@@ -1252,9 +1391,15 @@ Fl_File_Chooser::update_preview()
   int                   pbw, pbh;       // Width and height of preview box
   int                   w, h;           // Width and height of preview image
   int                   set = 0;        // Set this flag as soon as a decent preview is found
+  int                   cached = 0;     // Did the image come from the preview cache?
+  time_t                mtime = 0;      // Modification time of the file
+  long                  fsize = 0;      // Size of the file
 
   if (!previewButton->value()) return;
 
+  pbw = previewBox->w() - 20;
+  pbh = previewBox->h() - 20;
+
   filename = value();
   if (filename == NULL) {
     // no file name at all, so we have an empty preview
@@ -1275,16 +1420,28 @@ Fl_File_Chooser::update_preview()
         newlabel = "<empty file>";
         set = 1;
       } else {
-        // if this file is an image, try to load it
-        window->cursor(FL_CURSOR_WAIT);
-        Fl::check();
+        mtime = s.st_mtime;
+        fsize = (long)s.st_size;
 
-        image = Fl_Shared_Image::get(filename);
+        // use the cached preview image, if there is one...
+        image = preview_cache_find(filename, mtime, fsize, pbw, pbh,
+                                   previewBox->image());
 
         if (image) {
-          window->cursor(FL_CURSOR_DEFAULT);
-          Fl::check();
+          cached = 1;
           set = 1;
+        } else {
+          // if this file is an image, try to load it
+          window->cursor(FL_CURSOR_WAIT);
+          Fl::check();
+
+          image = Fl_Shared_Image::get(filename);
+
+          if (image) {
+            window->cursor(FL_CURSOR_DEFAULT);
+            Fl::check();
+            set = 1;
+          }
         }
       }
     }
@@ -1292,7 +1449,7 @@ Fl_File_Chooser::update_preview()
 
   oldimage = (Fl_Shared_Image *)previewBox->image();
 
-  if (oldimage) oldimage->release();
+  if (oldimage && !preview_cache_has(oldimage)) oldimage->release();
 
   previewBox->image(0);
 
@@ -1379,9 +1536,6 @@ Fl_File_Chooser::update_preview()
     previewBox->labelfont(FL_HELVETICA);
     previewBox->redraw();
   } else if (image) {
-    pbw = previewBox->w() - 20;
-    pbh = previewBox->h() - 20;
-
     if (image->w() > pbw || image->h() > pbh) {
       w   = pbw;
       h   = w * image->h() / image->w();
@@ -1395,10 +1549,16 @@ Fl_File_Chooser::update_preview()
       previewBox->image((Fl_Image *)oldimage);
 
       image->release();
+      image = oldimage;
     } else {
       previewBox->image((Fl_Image *)image);
     }
 
+    // Remember the displayed image for the next visit of this file...
+    if (!cached)
+      preview_cache_add(filename, mtime, fsize, pbw, pbh, image,
+                        previewBox->image());
+
     previewBox->align(FL_ALIGN_CLIP);
     previewBox->label(0);
   } else if (newlabel) {
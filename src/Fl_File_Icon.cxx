@@ -40,6 +40,8 @@
 #include <FL/Fl_Widget.H>
 #include <FL/fl_draw.H>
 #include <FL/filename.H>
+#include <FL/Fl_Image_Surface.H>
+#include <FL/Fl_Graphics_Driver.H>
 
 //
 // Icon cache...
@@ -47,6 +49,21 @@
 
 Fl_File_Icon    *Fl_File_Icon::first_ = (Fl_File_Icon *)0;
 
+// One rasterized copy of an icon: the vector data drawn at a given size,
+// color and activity, kept as an RGBA image so that repainting the icon
+// is a single blit instead of a replay of all its primitives.
+class Fl_File_Icon_Cache {
+public:
+  Fl_File_Icon_Cache *next;     // Next raster of the same icon
+  int           size;           // Side of the square the icon fills
+  float         scale;          // Screen scaling factor of the raster
+  Fl_Color      color;          // Icon color
+  char          active;         // Active or inactive colors?
+  Fl_RGB_Image  *image;         // The rasterized icon
+};
+
+static char building_cache = 0; // makes draw() replay the vector data while rasterizing
+
 
 // Registers the FL_ICON_LABEL drawing function
 Fl_Labeltype fl_define_FL_ICON_LABEL() {
@@ -85,6 +102,9 @@ Fl_File_Icon::Fl_File_Icon(const char *p,       /* I - Filename pattern */
     alloc_data_ = 0;
   }
 
+  // No rasterized copies yet...
+  cache_ = (Fl_File_Icon_Cache *)0;
+
   // And add the icon to the list of icons...
   next_  = first_;
   first_ = this;
@@ -117,6 +137,26 @@ Fl_File_Icon::~Fl_File_Icon() {
   // Free any memory used...
   if (alloc_data_)
     free(data_);
+
+  uncache();
+}
+
+
+/**
+  Deletes all rasterized copies of the icon that draw() may have kept.
+  This is done automatically whenever the icon data changes.
+
+  \version 1.4.0
+*/
+void Fl_File_Icon::uncache() {
+  while (cache_)
+  {
+    Fl_File_Icon_Cache *c = cache_;
+
+    cache_ = c->next;
+    delete c->image;
+    delete c;
+  }
 }
 
 
@@ -130,6 +170,9 @@ Fl_File_Icon::add(short d)      // I - Data to add
   short *dptr;                  // Pointer to new data value
 
 
+  // The icon is changing, drop any rasterized copies...
+  uncache();
+
   // Allocate/reallocate memory as needed
   if ((num_data_ + 1) >= alloc_data_)
   {
@@ -188,8 +231,129 @@ Fl_File_Icon::find(const char *filename,// I - Name of file */
   return (current);
 }
 
+// Returns a rasterized copy of the icon for the given square size, icon
+// color and activity, rendering and caching one if not done yet. Returns
+// NULL when the icon should be drawn from its vector data instead: while
+// a raster is being built, and when the current surface is not the screen
+// (printers and image surfaces keep the scalable output).
+Fl_RGB_Image *                          // O - Cached image or NULL
+Fl_File_Icon::cache_image_(int      size,   // I - Side of bounding square
+                           Fl_Color ic,     // I - Icon color...
+                           int      active) // I - Active or inactive?
+{
+  Fl_File_Icon_Cache    *c;             // Current raster in the list
+  Fl_RGB_Image          *on_white,      // Icon rendered over white...
+                        *on_black;      // ...and over black
+
+
+  if (building_cache || size <= 0)
+    return ((Fl_RGB_Image *)0);
+
+  if (!Fl_Display_Device::display_device()->is_current())
+    return ((Fl_RGB_Image *)0);
+
+  // Return the existing raster, if any...
+  float s = Fl_Graphics_Driver::default_driver().scale();
+
+  for (c = cache_; c; c = c->next)
+    if (c->size == size && c->color == ic && c->active == active &&
+        c->scale == s)
+      return (c->image);
+
+  // Render the icon over a white and over a black background; where the
+  // two renderings agree the pixel is opaque icon color, where they
+  // differ it shows the background and the difference gives the coverage.
+  building_cache = 1;
+
+  Fl_Image_Surface *surf = new Fl_Image_Surface(size, size, 1);
+
+  Fl_Surface_Device::push_current(surf);
+  fl_color(FL_WHITE);
+  fl_rectf(0, 0, size, size);
+  draw(0, 0, size, size, ic, active);
+  on_white = surf->image();
+  fl_color(FL_BLACK);
+  fl_rectf(0, 0, size, size);
+  draw(0, 0, size, size, ic, active);
+  on_black = surf->image();
+  Fl_Surface_Device::pop_current();
+
+  delete surf;
+  building_cache = 0;
+
+  if (!on_white || !on_black)
+  {
+    delete on_white;
+    delete on_black;
+    return ((Fl_RGB_Image *)0);
+  }
+
+  // Combine the two renderings into one RGBA image...
+  int   W = on_white->data_w();
+  int   H = on_white->data_h();
+  int   d = on_white->d();
+  int   ldw = on_white->ld() ? on_white->ld() : W * d;
+  int   ldb = on_black->ld() ? on_black->ld() : W * d;
+  uchar *rgba = new uchar[W * H * 4];
+
+  for (int y = 0; y < H; y ++)
+  {
+    const uchar *wp = on_white->array + y * ldw;
+    const uchar *bp = on_black->array + y * ldb;
+    uchar       *dst = rgba + y * W * 4;
+
+    for (int x = 0; x < W; x ++, wp += d, bp += d, dst += 4)
+    {
+      int a = 255 - ((wp[0] - bp[0]) + (wp[1] - bp[1]) + (wp[2] - bp[2])) / 3;
+
+      if (a <= 0)
+      {
+        dst[0] = dst[1] = dst[2] = dst[3] = 0;
+      }
+      else
+      {
+        if (a > 255) a = 255;
+        // the black-background rendering holds the icon color
+        // multiplied by the coverage, undo that...
+        for (int i = 0; i < 3; i ++)
+        {
+          int v = bp[i] * 255 / a;
+          dst[i] = (uchar)(v > 255 ? 255 : v);
+        }
+        dst[3] = (uchar)a;
+      }
+    }
+  }
+
+  delete on_white;
+  delete on_black;
+
+  Fl_RGB_Image *img = new Fl_RGB_Image(rgba, W, H, 4);
+  img->alloc_array = 1;
+  img->scale(size, size);
+
+  // Keep the raster for the next repaints...
+  c = new Fl_File_Icon_Cache;
+  c->next   = cache_;
+  c->size   = size;
+  c->scale  = s;
+  c->color  = ic;
+  c->active = (char)(active != 0);
+  c->image  = img;
+  cache_    = c;
+
+  return (img);
+}
+
+
 /**
   Draws an icon in the indicated area.
+
+  The first time an icon is drawn on screen at a given size and color it
+  is rasterized and kept; later repaints blit that raster, which is much
+  faster for icon-heavy widgets such as Fl_File_Browser. Drawing to other
+  surfaces (e.g. a printer) always replays the icon's vector data.
+
   \param[in] x, y, w, h position and size
   \param[in] ic icon color
   \param[in] active status, default is active [non-zero]
@@ -214,6 +378,16 @@ Fl_File_Icon::draw(int      x,          // I - Upper-lefthand X
   if (num_data_ == 0)
     return;
 
+  // Blit the rasterized copy of the icon when there is one...
+  int size = w < h ? w : h;
+  Fl_RGB_Image *img = cache_image_(size, ic, active);
+
+  if (img)
+  {
+    img->draw(x + (w - size) / 2, y + (h - size) / 2);
+    return;
+  }
+
   // Setup the transform matrix as needed...
   scale = w < h ? w : h;
 
@@ -34,6 +34,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 #include <FL/fl_utf8.h>
 #include "flstring.h"
 #include <ctype.h>
@@ -56,6 +57,8 @@ static void     load_kde_icons(const char *directory, const char *icondir);
 static void     load_kde_mimelnk(const char *filename, const char *icondir);
 static char     *kde_to_fltk_pattern(const char *kdepattern);
 static char     *get_kde_val(char *str, const char *key);
+static int      load_icon_cache(void);
+static void     save_icon_cache(void);
 
 
 //
@@ -560,6 +563,215 @@ int Fl_File_Icon::load_image(const char *ifile) // I - File to read from
 }
 
 
+//
+// Icon cache file...
+//
+// The system icon scan - especially the KDE mimelnk walk below - opens
+// and parses hundreds of small files.  Since a loaded icon is just a
+// pattern, a type and a vector data array, the result is snapshotted to
+// a per-user cache file which later startups read back after a handful
+// of stat() calls.  The snapshot is native-endian and versioned; it is
+// rebuilt whenever one of the directories that picked the icon set has
+// a new modification time.
+//
+
+#define ICON_CACHE_VERSION 1    // Bump when the record layout changes
+#define ICON_CACHE_PROBES  5    // Number of staleness probe paths
+
+
+//
+// 'icon_cache_name()' - Get the icon cache filename.
+//
+
+static const char *                     // O - Filename or NULL
+icon_cache_name(char *name,             // O - Filename buffer
+                int  namesize) {        // I - Size of filename buffer
+  const char    *home;                  // Home directory
+
+
+  if ((home = fl_getenv("HOME")) == NULL || !*home) return NULL;
+
+  snprintf(name, namesize, "%s/.fltk/filetype-icons.cache", home);
+  return (name);
+}
+
+
+//
+// 'icon_cache_mtimes()' - Get the timestamps that decide staleness.
+//
+
+static void
+icon_cache_mtimes(long *mtimes) {       // O - One timestamp per probe path
+  int           i;                      // Looping var
+  char          mimelnk[FL_PATH_MAX];   // KDE mimelnk directory
+  char          kdeicons[FL_PATH_MAX];  // KDE icon theme directory
+  const char    *paths[ICON_CACHE_PROBES]; // Probe paths
+  struct stat   sb;                     // Stat buffer
+
+
+  // The same paths load_system_icons() checks to pick an icon set...
+  snprintf(mimelnk, sizeof(mimelnk), "%s/share/mimelnk", kdedir);
+  snprintf(kdeicons, sizeof(kdeicons), "%s/share/icons", kdedir);
+
+  paths[0] = mimelnk;
+  paths[1] = kdeicons;
+  paths[2] = "/usr/share/icons/folder.xpm";
+  paths[3] = "/usr/dt/appconfig/icons";
+  paths[4] = "/usr/lib/filetype";
+
+  for (i = 0; i < ICON_CACHE_PROBES; i ++)
+    mtimes[i] = fl_stat(paths[i], &sb) ? 0 : (long)sb.st_mtime;
+}
+
+
+//
+// 'load_icon_cache()' - Re-create the icons from the cache file.
+//
+
+static int                              // O - 1 on success, 0 to do a full scan
+load_icon_cache(void) {
+  int           i;                      // Looping var
+  char          name[FL_PATH_MAX];      // Cache filename
+  FILE          *fp;                    // Cache file
+  int           header[3];              // Version, probe and icon counts
+  long          mtimes[ICON_CACHE_PROBES], // Current timestamps
+                cached[ICON_CACHE_PROBES]; // Timestamps in the cache
+  int           nicons;                 // Number of icons created
+
+
+  if (!icon_cache_name(name, sizeof(name))) return (0);
+  if ((fp = fl_fopen(name, "rb")) == NULL) return (0);
+
+  if (fread(header, sizeof(header), 1, fp) != 1 ||
+      header[0] != ICON_CACHE_VERSION ||
+      header[1] != ICON_CACHE_PROBES ||
+      header[2] <= 0 || header[2] > 100000 ||
+      fread(cached, sizeof(cached), 1, fp) != 1) {
+    fclose(fp);
+    return (0);
+  }
+
+  icon_cache_mtimes(mtimes);
+
+  for (i = 0; i < ICON_CACHE_PROBES; i ++)
+    if (mtimes[i] != cached[i]) {
+      fclose(fp);
+      return (0);
+    }
+
+  // The file was written oldest icon first, so re-creating the icons in
+  // file order rebuilds the original list order...
+  for (nicons = 0; nicons < header[2]; nicons ++) {
+    int         rec[3];                 // Type, pattern length, data words
+    char        *pattern;               // Pattern string
+    short       *data;                  // Icon data
+
+    if (fread(rec, sizeof(rec), 1, fp) != 1 ||
+        rec[1] < 1 || rec[1] > FL_PATH_MAX ||
+        rec[2] < 0 || rec[2] > 1000000) break;
+
+    // Like the patterns built by the scan, this string stays allocated
+    // for the life of the process; the constructor does not copy it...
+    pattern = (char *)malloc(rec[1]);
+
+    if (fread(pattern, rec[1], 1, fp) != 1 || pattern[rec[1] - 1]) {
+      free(pattern);
+      break;
+    }
+
+    if (rec[2]) {
+      data = (short *)malloc(rec[2] * sizeof(short));
+
+      if (fread(data, rec[2] * sizeof(short), 1, fp) != 1) {
+        free(pattern);
+        free(data);
+        break;
+      }
+
+      new Fl_File_Icon(pattern, rec[0], rec[2], data);
+      free(data);                       // the constructor copied it
+    } else {
+      new Fl_File_Icon(pattern, rec[0]);
+    }
+  }
+
+  fclose(fp);
+
+  if (nicons < header[2]) {
+    // Truncated or corrupt; drop what was created and do a full scan...
+    while (nicons -- > 0) delete Fl_File_Icon::first();
+    fl_unlink(name);
+    return (0);
+  }
+
+  return (1);
+}
+
+
+//
+// 'save_icon_cache()' - Snapshot the loaded icons to the cache file.
+//
+
+static void
+save_icon_cache(void) {
+  int           i;                      // Looping var
+  char          name[FL_PATH_MAX];      // Cache filename
+  char          dir[FL_PATH_MAX];       // Cache directory
+  FILE          *fp;                    // Cache file
+  int           header[3];              // Version, probe and icon counts
+  long          mtimes[ICON_CACHE_PROBES]; // Current timestamps
+  int           nicons;                 // Number of icons
+  int           ok;                     // Did all writes succeed?
+  Fl_File_Icon  *icon;                  // Current icon
+  Fl_File_Icon  **icons;                // All icons, newest first
+
+
+  if (!icon_cache_name(name, sizeof(name))) return;
+
+  for (nicons = 0, icon = Fl_File_Icon::first(); icon; icon = icon->next())
+    nicons ++;
+
+  if (!nicons) return;
+
+  snprintf(dir, sizeof(dir), "%s/.fltk", fl_getenv("HOME"));
+  fl_mkdir(dir, 0777);
+
+  if ((fp = fl_fopen(name, "wb")) == NULL) return;
+
+  header[0] = ICON_CACHE_VERSION;
+  header[1] = ICON_CACHE_PROBES;
+  header[2] = nicons;
+
+  icon_cache_mtimes(mtimes);
+
+  icons = (Fl_File_Icon **)malloc(nicons * sizeof(Fl_File_Icon *));
+  for (i = 0, icon = Fl_File_Icon::first(); icon; icon = icon->next())
+    icons[i ++] = icon;
+
+  ok = fwrite(header, sizeof(header), 1, fp) == 1 &&
+       fwrite(mtimes, sizeof(mtimes), 1, fp) == 1;
+
+  // Write oldest first so reloading re-creates the list in this order...
+  for (i = nicons - 1; ok && i >= 0; i --) {
+    int         rec[3];                 // Type, pattern length, data words
+
+    icon   = icons[i];
+    rec[0] = icon->type();
+    rec[1] = (int)strlen(icon->pattern()) + 1;
+    rec[2] = icon->size();
+
+    ok = fwrite(rec, sizeof(rec), 1, fp) == 1 &&
+         fwrite(icon->pattern(), rec[1], 1, fp) == 1 &&
+         (!rec[2] ||
+          fwrite(icon->value(), rec[2] * sizeof(short), 1, fp) == 1);
+  }
+
+  free(icons);
+
+  if (fclose(fp) || !ok) fl_unlink(name);
+}
+
+
 /**
   Loads all system-defined icons. This call is useful when using the
   FileChooser widget and should be used when the application starts:
@@ -659,6 +871,12 @@ Fl_File_Icon::load_system_icons(void) {
       }
     }
 
+    // Try the snapshot of a previous scan first...
+    if (load_icon_cache()) {
+      init = 1;
+      return;
+    }
+
     snprintf(filename, sizeof(filename), "%s/share/mimelnk", kdedir);
 
     if (!fl_access(filename, F_OK)) {
@@ -760,9 +978,11 @@ Fl_File_Icon::load_system_icons(void) {
       new Fl_File_Icon("*", Fl_File_Icon::DIRECTORY, sizeof(dir) / sizeof(dir[0]), dir);
     }
 
-    // Mark things as initialized...
+    // Mark things as initialized and snapshot them for the next start...
     init = 1;
 
+    save_icon_cache();
+
 #ifdef DEBUG
     int count;
     Fl_File_Icon *temp;
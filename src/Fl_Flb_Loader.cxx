@@ -0,0 +1,624 @@
+//
+// Binary dialog file loader for the Fast Light Tool Kit (FLTK).
+//
+// Copyright 1998-2021 by Bill Spitzak and others.
+//
+// This library is free software. Distribution and use rights are outlined in
+// the file "COPYING" which should have been included with this file.  If this
+// file is missing or damaged, see the license at:
+//
+//     https://www.fltk.org/COPYING.php
+//
+// Please see the following page on how to report bugs and issues:
+//
+//     https://www.fltk.org/bugs.php
+//
+
+#include <FL/Fl.H>
+#include <FL/Fl_Flb_Loader.H>
+#include <FL/fl_utf8.h>
+#include <FL/fl_string.h>
+
+#include <FL/Fl_Window.H>
+#include <FL/Fl_Double_Window.H>
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Pack.H>
+#include <FL/Fl_Scroll.H>
+#include <FL/Fl_Tile.H>
+#include <FL/Fl_Tabs.H>
+#include <FL/Fl_Wizard.H>
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Return_Button.H>
+#include <FL/Fl_Light_Button.H>
+#include <FL/Fl_Check_Button.H>
+#include <FL/Fl_Round_Button.H>
+#include <FL/Fl_Repeat_Button.H>
+#include <FL/Fl_Toggle_Button.H>
+#include <FL/Fl_Input.H>
+#include <FL/Fl_Output.H>
+#include <FL/Fl_Int_Input.H>
+#include <FL/Fl_Float_Input.H>
+#include <FL/Fl_Multiline_Input.H>
+#include <FL/Fl_Multiline_Output.H>
+#include <FL/Fl_Text_Display.H>
+#include <FL/Fl_Text_Editor.H>
+#include <FL/Fl_Menu_Bar.H>
+#include <FL/Fl_Menu_Button.H>
+#include <FL/Fl_Choice.H>
+#include <FL/Fl_Input_Choice.H>
+#include <FL/Fl_Browser.H>
+#include <FL/Fl_Hold_Browser.H>
+#include <FL/Fl_Multi_Browser.H>
+#include <FL/Fl_Select_Browser.H>
+#include <FL/Fl_Slider.H>
+#include <FL/Fl_Value_Slider.H>
+#include <FL/Fl_Scrollbar.H>
+#include <FL/Fl_Roller.H>
+#include <FL/Fl_Dial.H>
+#include <FL/Fl_Adjuster.H>
+#include <FL/Fl_Counter.H>
+#include <FL/Fl_Value_Input.H>
+#include <FL/Fl_Value_Output.H>
+#include <FL/Fl_Progress.H>
+#include <FL/Fl_Spinner.H>
+#include <FL/Fl_Clock.H>
+#include <FL/Fl_Tree.H>
+#include <FL/Fl_Help_View.H>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// How a loaded widget's class-specific attributes (values, text fonts,
+// children) are applied. The factory knows the concrete class, so the
+// loader can cast without RTTI.
+enum {
+  FLB_PLAIN,
+  FLB_GROUP,
+  FLB_WINDOW,
+  FLB_BUTTON,
+  FLB_VALUATOR,       // plain Fl_Valuator subclass
+  FLB_VALUE_SLIDER,   // Fl_Valuator subclasses with their own text attributes:
+  FLB_COUNTER,
+  FLB_VALUE_INPUT,
+  FLB_VALUE_OUTPUT,
+  FLB_PROGRESS,
+  FLB_SPINNER,
+  FLB_INPUT,          // Fl_Input_ subclass
+  FLB_TEXT,           // Fl_Text_Display subclass
+  FLB_BROWSER,        // Fl_Browser_ subclass
+  FLB_MENU,           // Fl_Menu_ subclass
+  FLB_INPUT_CHOICE
+};
+
+#define FLB_MAKE(W) \
+  static Fl_Widget *make_##W(int X, int Y, int Wd, int Ht) { return new W(X, Y, Wd, Ht); }
+
+FLB_MAKE(Fl_Window)
+FLB_MAKE(Fl_Double_Window)
+FLB_MAKE(Fl_Group)
+FLB_MAKE(Fl_Pack)
+FLB_MAKE(Fl_Scroll)
+FLB_MAKE(Fl_Tile)
+FLB_MAKE(Fl_Tabs)
+FLB_MAKE(Fl_Wizard)
+FLB_MAKE(Fl_Box)
+FLB_MAKE(Fl_Button)
+FLB_MAKE(Fl_Return_Button)
+FLB_MAKE(Fl_Light_Button)
+FLB_MAKE(Fl_Check_Button)
+FLB_MAKE(Fl_Round_Button)
+FLB_MAKE(Fl_Repeat_Button)
+FLB_MAKE(Fl_Toggle_Button)
+FLB_MAKE(Fl_Input)
+FLB_MAKE(Fl_Output)
+FLB_MAKE(Fl_Int_Input)
+FLB_MAKE(Fl_Float_Input)
+FLB_MAKE(Fl_Multiline_Input)
+FLB_MAKE(Fl_Multiline_Output)
+FLB_MAKE(Fl_Text_Display)
+FLB_MAKE(Fl_Text_Editor)
+FLB_MAKE(Fl_Menu_Bar)
+FLB_MAKE(Fl_Menu_Button)
+FLB_MAKE(Fl_Choice)
+FLB_MAKE(Fl_Input_Choice)
+FLB_MAKE(Fl_Browser)
+FLB_MAKE(Fl_Hold_Browser)
+FLB_MAKE(Fl_Multi_Browser)
+FLB_MAKE(Fl_Select_Browser)
+FLB_MAKE(Fl_Slider)
+FLB_MAKE(Fl_Value_Slider)
+FLB_MAKE(Fl_Scrollbar)
+FLB_MAKE(Fl_Roller)
+FLB_MAKE(Fl_Dial)
+FLB_MAKE(Fl_Adjuster)
+FLB_MAKE(Fl_Counter)
+FLB_MAKE(Fl_Value_Input)
+FLB_MAKE(Fl_Value_Output)
+FLB_MAKE(Fl_Progress)
+FLB_MAKE(Fl_Spinner)
+FLB_MAKE(Fl_Clock)
+FLB_MAKE(Fl_Tree)
+FLB_MAKE(Fl_Help_View)
+
+struct Flb_Class {
+  const char *name;                     // fluid's type_name()
+  Fl_Widget *(*make)(int, int, int, int);
+  int kind;                             // FLB_* above
+};
+
+#define FLB_CLASS(W, kind) { #W, make_##W, kind }
+
+static const Flb_Class flb_classes[] = {
+  FLB_CLASS(Fl_Window,           FLB_WINDOW),
+  FLB_CLASS(Fl_Double_Window,    FLB_WINDOW),
+  FLB_CLASS(Fl_Group,            FLB_GROUP),
+  FLB_CLASS(Fl_Pack,             FLB_GROUP),
+  FLB_CLASS(Fl_Scroll,           FLB_GROUP),
+  FLB_CLASS(Fl_Tile,             FLB_GROUP),
+  FLB_CLASS(Fl_Tabs,             FLB_GROUP),
+  FLB_CLASS(Fl_Wizard,           FLB_GROUP),
+  FLB_CLASS(Fl_Box,              FLB_PLAIN),
+  FLB_CLASS(Fl_Button,           FLB_BUTTON),
+  FLB_CLASS(Fl_Return_Button,    FLB_BUTTON),
+  FLB_CLASS(Fl_Light_Button,     FLB_BUTTON),
+  FLB_CLASS(Fl_Check_Button,     FLB_BUTTON),
+  FLB_CLASS(Fl_Round_Button,     FLB_BUTTON),
+  FLB_CLASS(Fl_Repeat_Button,    FLB_BUTTON),
+  FLB_CLASS(Fl_Toggle_Button,    FLB_BUTTON),
+  FLB_CLASS(Fl_Input,            FLB_INPUT),
+  FLB_CLASS(Fl_Output,           FLB_INPUT),
+  FLB_CLASS(Fl_Int_Input,        FLB_INPUT),
+  FLB_CLASS(Fl_Float_Input,      FLB_INPUT),
+  FLB_CLASS(Fl_Multiline_Input,  FLB_INPUT),
+  FLB_CLASS(Fl_Multiline_Output, FLB_INPUT),
+  FLB_CLASS(Fl_Text_Display,     FLB_TEXT),
+  FLB_CLASS(Fl_Text_Editor,      FLB_TEXT),
+  FLB_CLASS(Fl_Menu_Bar,         FLB_MENU),
+  FLB_CLASS(Fl_Menu_Button,      FLB_MENU),
+  FLB_CLASS(Fl_Choice,           FLB_MENU),
+  FLB_CLASS(Fl_Input_Choice,     FLB_INPUT_CHOICE),
+  FLB_CLASS(Fl_Browser,          FLB_BROWSER),
+  FLB_CLASS(Fl_Hold_Browser,     FLB_BROWSER),
+  FLB_CLASS(Fl_Multi_Browser,    FLB_BROWSER),
+  FLB_CLASS(Fl_Select_Browser,   FLB_BROWSER),
+  FLB_CLASS(Fl_Slider,           FLB_VALUATOR),
+  FLB_CLASS(Fl_Value_Slider,     FLB_VALUE_SLIDER),
+  FLB_CLASS(Fl_Scrollbar,        FLB_VALUATOR),
+  FLB_CLASS(Fl_Roller,           FLB_VALUATOR),
+  FLB_CLASS(Fl_Dial,             FLB_VALUATOR),
+  FLB_CLASS(Fl_Adjuster,         FLB_VALUATOR),
+  FLB_CLASS(Fl_Counter,          FLB_COUNTER),
+  FLB_CLASS(Fl_Value_Input,      FLB_VALUE_INPUT),
+  FLB_CLASS(Fl_Value_Output,     FLB_VALUE_OUTPUT),
+  FLB_CLASS(Fl_Progress,         FLB_PROGRESS),
+  FLB_CLASS(Fl_Spinner,          FLB_SPINNER),
+  FLB_CLASS(Fl_Clock,            FLB_PLAIN),
+  FLB_CLASS(Fl_Tree,             FLB_PLAIN),
+  FLB_CLASS(Fl_Help_View,        FLB_PLAIN)
+};
+
+static const Flb_Class *flb_find_class(const char *name) {
+  for (unsigned i = 0; i < sizeof(flb_classes)/sizeof(flb_classes[0]); i++)
+    if (strcmp(flb_classes[i].name, name) == 0) return &flb_classes[i];
+  return 0;
+}
+
+static int flb_is_menu_item(const char *name) {
+  return strcmp(name, "MenuItem") == 0 || strcmp(name, "Submenu") == 0;
+}
+
+/** The constructor creates a loader with an empty symbol table. */
+Fl_Flb_Loader::Fl_Flb_Loader() {
+  symbols_ = 0;
+  named_ = 0;
+  errmsg_ = 0;
+  rp_ = rend_ = 0;
+  rfail_ = 0;
+}
+
+/** The destructor frees the symbol table and the widget name list.
+  Widgets built by load() are not destroyed; they belong to the caller. */
+Fl_Flb_Loader::~Fl_Flb_Loader() {
+  while (symbols_) {
+    Symbol *s = symbols_;
+    symbols_ = s->next;
+    free(s->name);
+    delete s;
+  }
+  clear_named();
+}
+
+void Fl_Flb_Loader::clear_named() {
+  while (named_) {
+    Named *n = named_;
+    named_ = n->next;
+    free(n->name);
+    delete n;
+  }
+}
+
+/**
+  Registers the callback function to bind to widgets whose fluid design
+  names \p name as their callback.
+
+  Call this for every callback function the dialog uses before calling
+  load(). Widgets naming a callback that was not registered are built
+  with no callback.
+
+  \param[in] name function name as written in the fluid design
+  \param[in] cb the function to call
+  \param[in] user_data value passed to \p cb, default NULL
+*/
+void Fl_Flb_Loader::symbol(const char *name, Fl_Callback *cb, void *user_data) {
+  Symbol *s = new Symbol;
+  s->name = fl_strdup(name);
+  s->cb = cb;
+  s->data = user_data;
+  s->next = symbols_;
+  symbols_ = s;
+}
+
+/**
+  Returns the widget built by the last load() whose fluid design name
+  is \p name, or NULL.
+*/
+Fl_Widget *Fl_Flb_Loader::widget(const char *name) const {
+  for (Named *n = named_; n; n = n->next)
+    if (strcmp(n->name, name) == 0) return n->w;
+  return 0;
+}
+
+unsigned Fl_Flb_Loader::read_byte() {
+  if (rp_ >= rend_) { rfail_ = 1; return 0; }
+  return *rp_++;
+}
+
+unsigned Fl_Flb_Loader::read_int() {
+  if (rp_ + 4 > rend_) { rfail_ = 1; rp_ = rend_; return 0; }
+  unsigned v = rp_[0] | (rp_[1] << 8) | (rp_[2] << 16) | ((unsigned)rp_[3] << 24);
+  rp_ += 4;
+  return v;
+}
+
+// Returns a malloc'd copy of the string, or NULL for an empty one.
+char *Fl_Flb_Loader::read_str() {
+  if (rp_ + 2 > rend_) { rfail_ = 1; rp_ = rend_; return 0; }
+  unsigned n = rp_[0] | (rp_[1] << 8);
+  rp_ += 2;
+  if (rp_ + n > rend_) { rfail_ = 1; rp_ = rend_; return 0; }
+  char *s = 0;
+  if (n) {
+    s = (char*)malloc(n + 1);
+    memcpy(s, rp_, n);
+    s[n] = 0;
+  }
+  rp_ += n;
+  return s;
+}
+
+// Reads one FL_FLB_TAG_WIDGET record (the tag byte is already consumed)
+// and builds the widget, or adds a menu item when 'menu' is set. Returns
+// 0 on malformed data, 1 otherwise; *built receives the new widget, if any.
+int Fl_Flb_Loader::read_widget(Fl_Group *parent, Fl_Menu_ *menu,
+                               const char *menu_path, Fl_Widget **built) {
+  *built = 0;
+  char *klass = read_str();
+  char *name = read_str();
+  char *label = read_str();
+  char *callback = read_str();
+  char *tooltip = read_str();
+  int x = (int)read_int(), y = (int)read_int();
+  int w = (int)read_int(), h = (int)read_int();
+  unsigned type = read_int(), box = read_int();
+  unsigned color = read_int(), selection_color = read_int();
+  unsigned labelfont = read_int(), labelsize = read_int(), labelcolor = read_int();
+  unsigned align = read_int(), when = read_int();
+  unsigned flags = read_byte();
+  double v[4] = { 0.0, 0.0, 0.0, 0.0 };
+  if (flags & FL_FLB_FLAG_VALUES) {
+    for (int i = 0; i < 4; i++) {
+      char *vs = read_str();
+      if (vs) { v[i] = strtod(vs, 0); free(vs); }
+    }
+  }
+  unsigned textfont = 0, textsize = 0, textcolor = 0;
+  if (flags & FL_FLB_FLAG_TEXT) {
+    textfont = read_int();
+    textsize = read_int();
+    textcolor = read_int();
+  }
+
+  // resolve the callback
+  Fl_Callback *cb = 0;
+  void *cb_data = 0;
+  if (callback) {
+    for (Symbol *s = symbols_; s; s = s->next) {
+      if (strcmp(s->name, callback) == 0) { cb = s->cb; cb_data = s->data; break; }
+    }
+  }
+
+  int ok = !rfail_;
+  if (ok && klass && menu && flb_is_menu_item(klass)) {
+    // A menu item of the enclosing Fl_Menu_ widget. Items are added by
+    // their label path, with '/' and '\' in labels escaped.
+    char path[1024];
+    int n = 0;
+    if (menu_path[0]) {
+      n = (int)strlen(menu_path);
+      if (n > (int)sizeof(path)-2) n = (int)sizeof(path)-2;
+      memcpy(path, menu_path, n);
+      path[n++] = '/';
+    }
+    for (const char *s = label; s && *s && n < (int)sizeof(path)-2; s++) {
+      if (*s == '/' || *s == '\\') path[n++] = '\\';
+      path[n++] = *s;
+    }
+    path[n] = 0;
+    if (strcmp(klass, "Submenu") == 0) {
+      if (path[0]) menu->add(path, 0, 0, 0, FL_SUBMENU);
+      if (flags & FL_FLB_FLAG_CHILDREN) {
+        unsigned tag;
+        while (ok && (tag = read_byte()) == FL_FLB_TAG_WIDGET) {
+          Fl_Widget *ignored;
+          ok = read_widget(parent, menu, path, &ignored);
+        }
+        if (ok && tag != FL_FLB_TAG_END) ok = 0;
+      }
+    } else if (path[0]) {
+      int i = menu->add(path, 0, cb, cb_data, (int)type); // 'type' holds FL_MENU_* flags
+      if (flags & FL_FLB_FLAG_DEACTIVATED) {
+        Fl_Menu_Item *mi = (Fl_Menu_Item*)&menu->menu()[i];
+        mi->deactivate();
+      }
+    }
+  } else if (ok && klass) {
+    // A widget record
+    const Flb_Class *ce = flb_find_class(klass);
+    Fl_Widget *o;
+    int kind;
+    if (ce) {
+      o = ce->make(x, y, w, h);
+      kind = ce->kind;
+    } else if (flags & FL_FLB_FLAG_CHILDREN) {
+      // unknown container class ('widget_class', Fl_Table subclasses, ...)
+      o = new Fl_Group(x, y, w, h);
+      kind = FLB_GROUP;
+    } else {
+      o = new Fl_Box(x, y, w, h);
+      kind = FLB_PLAIN;
+    }
+    *built = o;
+    if (kind != FLB_WINDOW && kind != FLB_GROUP && kind != FLB_INPUT_CHOICE)
+      o->type((uchar)type);
+    o->box((Fl_Boxtype)box);
+    o->color((Fl_Color)color);
+    o->selection_color((Fl_Color)selection_color);
+    o->labelfont((Fl_Font)labelfont);
+    o->labelsize((Fl_Fontsize)labelsize);
+    o->labelcolor((Fl_Color)labelcolor);
+    o->align((Fl_Align)align);
+    o->when((uchar)when);
+    if (label) o->copy_label(label);
+    if (tooltip) o->copy_tooltip(tooltip);
+    if (cb) o->callback(cb, cb_data);
+    if (flags & FL_FLB_FLAG_VALUES) {
+      switch (kind) {
+        case FLB_BUTTON:
+          ((Fl_Button*)o)->value((int)v[3]);
+          break;
+        case FLB_VALUATOR:
+        case FLB_VALUE_SLIDER:
+        case FLB_COUNTER:
+        case FLB_VALUE_INPUT:
+        case FLB_VALUE_OUTPUT: {
+          Fl_Valuator *vo = (Fl_Valuator*)o;
+          vo->minimum(v[0]);
+          vo->maximum(v[1]);
+          if (v[2]) vo->step(v[2]);
+          vo->value(v[3]);
+          break; }
+        case FLB_PROGRESS:
+          ((Fl_Progress*)o)->minimum((float)v[0]);
+          ((Fl_Progress*)o)->maximum((float)v[1]);
+          ((Fl_Progress*)o)->value((float)v[3]);
+          break;
+        case FLB_SPINNER: {
+          Fl_Spinner *so = (Fl_Spinner*)o;
+          so->minimum(v[0]);
+          so->maximum(v[1]);
+          if (v[2]) so->step(v[2]);
+          so->value(v[3]);
+          break; }
+      }
+    }
+    if (flags & FL_FLB_FLAG_TEXT) {
+      Fl_Font tf = (Fl_Font)textfont;
+      Fl_Fontsize ts = (Fl_Fontsize)textsize;
+      Fl_Color tc = (Fl_Color)textcolor;
+      switch (kind) {
+        case FLB_INPUT:
+          ((Fl_Input_*)o)->textfont(tf);
+          ((Fl_Input_*)o)->textsize(ts);
+          ((Fl_Input_*)o)->textcolor(tc);
+          break;
+        case FLB_TEXT:
+          ((Fl_Text_Display*)o)->textfont(tf);
+          ((Fl_Text_Display*)o)->textsize(ts);
+          ((Fl_Text_Display*)o)->textcolor(tc);
+          break;
+        case FLB_BROWSER:
+          ((Fl_Browser_*)o)->textfont(tf);
+          ((Fl_Browser_*)o)->textsize(ts);
+          ((Fl_Browser_*)o)->textcolor(tc);
+          break;
+        case FLB_MENU:
+          ((Fl_Menu_*)o)->textfont(tf);
+          ((Fl_Menu_*)o)->textsize(ts);
+          ((Fl_Menu_*)o)->textcolor(tc);
+          break;
+        case FLB_INPUT_CHOICE:
+          ((Fl_Input_Choice*)o)->textfont(tf);
+          ((Fl_Input_Choice*)o)->textsize(ts);
+          ((Fl_Input_Choice*)o)->textcolor(tc);
+          break;
+        case FLB_VALUE_SLIDER:
+          ((Fl_Value_Slider*)o)->textfont(tf);
+          ((Fl_Value_Slider*)o)->textsize(ts);
+          ((Fl_Value_Slider*)o)->textcolor(tc);
+          break;
+        case FLB_COUNTER:
+          ((Fl_Counter*)o)->textfont(tf);
+          ((Fl_Counter*)o)->textsize(ts);
+          ((Fl_Counter*)o)->textcolor(tc);
+          break;
+        case FLB_VALUE_INPUT:
+          ((Fl_Value_Input*)o)->textfont(tf);
+          ((Fl_Value_Input*)o)->textsize(ts);
+          ((Fl_Value_Input*)o)->textcolor(tc);
+          break;
+        case FLB_VALUE_OUTPUT:
+          ((Fl_Value_Output*)o)->textfont(tf);
+          ((Fl_Value_Output*)o)->textsize(ts);
+          ((Fl_Value_Output*)o)->textcolor(tc);
+          break;
+        case FLB_SPINNER:
+          ((Fl_Spinner*)o)->textfont(tf);
+          ((Fl_Spinner*)o)->textsize(ts);
+          ((Fl_Spinner*)o)->textcolor(tc);
+          break;
+      }
+    }
+    if (flags & FL_FLB_FLAG_HIDDEN) o->hide();
+    if (flags & FL_FLB_FLAG_DEACTIVATED) o->deactivate();
+    if (parent && (flags & FL_FLB_FLAG_RESIZABLE)) parent->resizable(o);
+    if (name) {
+      Named *nn = new Named;
+      nn->name = fl_strdup(name);
+      nn->w = o;
+      nn->next = named_;
+      named_ = nn;
+    }
+    if (flags & FL_FLB_FLAG_CHILDREN) {
+      Fl_Group *g = o->as_group();
+      Fl_Menu_ *m = 0;
+      if (kind == FLB_MENU) m = (Fl_Menu_*)o;
+      else if (kind == FLB_INPUT_CHOICE) m = ((Fl_Input_Choice*)o)->menubutton();
+      unsigned tag;
+      while (ok && (tag = read_byte()) == FL_FLB_TAG_WIDGET) {
+        Fl_Widget *child;
+        if (m) {
+          ok = read_widget(g, m, "", &child);
+        } else if (g) {
+          g->begin();
+          ok = read_widget(g, 0, "", &child);
+          g->end();
+        } else {
+          // children of a non-group placeholder have nowhere to go;
+          // build and discard them to keep the stream in sync
+          ok = read_widget(0, 0, "", &child);
+          if (child) delete child;
+        }
+      }
+      if (ok && tag != FL_FLB_TAG_END) ok = 0;
+      if (g) g->end();
+    }
+  }
+  if (klass) free(klass);
+  if (name) free(name);
+  if (label) free(label);
+  if (callback) free(callback);
+  if (tooltip) free(tooltip);
+  return ok && !rfail_;
+}
+
+/**
+  Builds the widget tree stored in the memory block \p data of \p size
+  bytes, e.g. an mmap()ed or resource-embedded '.flb' file.
+
+  Returns the first top level widget of the design, normally a window
+  that the caller shows and later deletes. Additional top level windows,
+  if any, are also built and can be retrieved with widget(). On a
+  malformed file NULL is returned, everything partially built is
+  destroyed, and error() describes the failure.
+
+  The widget name list of a previous load() is replaced; registered
+  symbols are kept, so one loader can load several files.
+*/
+Fl_Widget *Fl_Flb_Loader::load(const unsigned char *data, unsigned long size) {
+  errmsg_ = 0;
+  clear_named();
+  if (!data || size < 5 || memcmp(data, FL_FLB_MAGIC, 4)) {
+    errmsg_ = "not a binary dialog (.flb) file";
+    return 0;
+  }
+  rp_ = data + 4;
+  rend_ = data + size;
+  rfail_ = 0;
+
+  Fl_Group *old_current = Fl_Group::current();
+  Fl_Group::current(0);
+
+  Fl_Widget **roots = 0;
+  int nroots = 0;
+  int ok = 1;
+  unsigned tag;
+  while (ok && (tag = read_byte()) == FL_FLB_TAG_WIDGET) {
+    Fl_Widget *w = 0;
+    ok = read_widget(0, 0, "", &w);
+    if (w) {
+      roots = (Fl_Widget**)realloc(roots, (nroots+1) * sizeof(Fl_Widget*));
+      roots[nroots++] = w;
+    }
+  }
+  if (ok && tag != FL_FLB_TAG_EOF) ok = 0;
+
+  Fl_Group::current(old_current);
+
+  Fl_Widget *ret = 0;
+  if (!ok || rfail_) {
+    errmsg_ = "truncated or malformed binary dialog file";
+    for (int i = 0; i < nroots; i++) delete roots[i];
+    clear_named();
+  } else if (nroots) {
+    ret = roots[0];
+  } else {
+    errmsg_ = "binary dialog file contains no widgets";
+  }
+  if (roots) free(roots);
+  return ret;
+}
+
+/**
+  Builds the widget tree stored in the binary dialog file \p filename,
+  written by \p "fluid -b".
+
+  \see load(const unsigned char *, unsigned long)
+*/
+Fl_Widget *Fl_Flb_Loader::load(const char *filename) {
+  FILE *fp = fl_fopen(filename, "rb");
+  if (!fp) {
+    errmsg_ = "can't open file";
+    return 0;
+  }
+  fseek(fp, 0, SEEK_END);
+  long size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  unsigned char *data = 0;
+  if (size > 0) {
+    data = (unsigned char*)malloc(size);
+    if (fread(data, 1, size, fp) != (size_t)size) {
+      free(data);
+      data = 0;
+    }
+  }
+  fclose(fp);
+  if (!data) {
+    errmsg_ = "can't read file";
+    return 0;
+  }
+  Fl_Widget *w = load(data, (unsigned long)size);
+  free(data);
+  return w;
+}
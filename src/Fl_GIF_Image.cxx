@@ -30,6 +30,7 @@
 
 #include <FL/Fl.H>
 #include <FL/Fl_GIF_Image.H>
+#include <FL/fl_draw.H>
 #include "Fl_Image_Reader.h"
 #include <FL/fl_utf8.h>
 #include "flstring.h"
@@ -92,7 +93,8 @@
  \see Fl_GIF_Image::Fl_GIF_Image(const char *imagename, const unsigned char *data)
  */
 Fl_GIF_Image::Fl_GIF_Image(const char *filename) :
-  Fl_Pixmap((char *const*)0)
+  Fl_Pixmap((char *const*)0),
+  gif_data_(0)
 {
   Fl_Image_Reader rdr;
   if (rdr.open(filename) == -1) {
@@ -127,7 +129,8 @@ Fl_GIF_Image::Fl_GIF_Image(const char *filename) :
  \see Fl_Shared_Image
 */
 Fl_GIF_Image::Fl_GIF_Image(const char *imagename, const unsigned char *data) :
-  Fl_Pixmap((char *const*)0)
+  Fl_Pixmap((char *const*)0),
+  gif_data_(0)
 {
   Fl_Image_Reader rdr;
   if (rdr.open(imagename, data)==-1) {
@@ -137,6 +140,23 @@ Fl_GIF_Image::Fl_GIF_Image(const char *imagename, const unsigned char *data) :
   }
 }
 
+/**
+ The destructor frees the decoded picture.
+
+ The row pointers, the palette and the packed plane of color indices are
+ owned by this object rather than handed over to Fl_Pixmap (alloc_data
+ stays 0), because Fl_Pixmap assumes one allocation per row.
+*/
+Fl_GIF_Image::~Fl_GIF_Image() {
+  if (gif_data_) {
+    fl_forget_pixmap((const char *const*)gif_data_);
+    delete[] gif_data_[0];        // header line
+    delete[] gif_data_[1];        // compressed colormap
+    delete[] gif_data_[2];        // packed plane of color indices
+    delete[] gif_data_;
+  }
+}
+
 /*
  This method reads GIF image data and creates an RGB or RGBA image. The GIF
  format supports only 1 bit for alpha. To avoid code duplication, we use
@@ -441,15 +461,22 @@ void Fl_GIF_Image::load_gif_(Fl_Image_Reader &rdr)
   p = Image+Width*Height;
   while (p-- > Image) *p = remap[*p];
 
-  // split the image data into lines:
+  // Store the picture as one packed plane of color indices with the row
+  // pointers indexing into it, one row per line as fl_draw_pixmap()
+  // expects. A single allocation avoids the per-row allocator and pointer
+  // overhead, which adds up when hundreds of frames are loaded.
+  char *plane = new char[Height * (Width + 1)];
   for (i=0; i<Height; i++) {
-    new_data[i+2] = new char[Width+1];
+    new_data[i+2] = plane + i*(Width+1);
     memcpy(new_data[i + 2], (char*)(Image + i*Width), Width);
     new_data[i + 2][Width] = 0;
   }
 
   data((const char **)new_data, Height + 2);
-  alloc_data = 1;
+  // the storage is freed by ~Fl_GIF_Image(), not by Fl_Pixmap, which
+  // would delete[] every row pointer individually
+  alloc_data = 0;
+  gif_data_ = new_data;
 
   delete[] Image;
 }
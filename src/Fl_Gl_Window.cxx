@@ -159,6 +159,65 @@ void Fl_Gl_Window::swap_buffers() {
   pGlWindowDriver->swap_buffers();
 }
 
+/**
+  Copies a rectangular part of the back buffer to the front buffer,
+  leaving the rest of both buffers unchanged.
+
+  This is useful when only a small part of the scene changed: after
+  re-rendering the damaged rectangle in the back buffer, presenting it
+  with copy_sub_buffer() avoids the cost of a full-window buffer swap,
+  which can be considerable on large (e.g., 4K) drawables.
+  \p x, \p y, \p w and \p h are expressed in FLTK units relative to the
+  top-left corner of the window, as in draw().
+
+  Partial presentation requires platform support (the
+  \c GLX_MESA_copy_sub_buffer extension under X11). When support is
+  missing, this method calls swap_buffers() instead; the back buffer
+  should therefore always hold a complete frame.
+
+  \returns non-zero if the partial copy was done, 0 if the whole buffer
+  was swapped.
+  \version 1.4.0
+*/
+int Fl_Gl_Window::copy_sub_buffer(int x, int y, int w, int h) {
+  int done = pGlWindowDriver->copy_sub_buffer(x, y, w, h);
+  if (!done) swap_buffers();
+  return done;
+}
+
+/**
+  Sets the number of display refreshes between two buffer swaps.
+
+  With an interval of 1, swap_buffers() waits for the next vertical
+  retrace before presenting the back buffer: animations are paced by the
+  display and do not tear. With an interval of 0, swap_buffers() returns
+  immediately, which is useful for benchmarking. Larger values present
+  every n-th refresh.
+
+  The window must be shown before the interval can be set, and the value
+  applies to this window only. The call is silently ignored when the
+  platform offers no way to control the swap interval (under X11 the
+  \c GLX_EXT_swap_control or \c GLX_MESA_swap_control extension is
+  required); use the swap_interval() getter to know whether it took
+  effect. The initial interval is driver-dependent.
+
+  \param frames number of display refreshes between buffer swaps
+  \version 1.4.0
+*/
+void Fl_Gl_Window::swap_interval(int frames) {
+  pGlWindowDriver->swap_interval(frames);
+}
+
+/**
+  Gets the number of display refreshes between two buffer swaps.
+  \returns the current swap interval, or -1 when it cannot be queried.
+  \see void swap_interval(int)
+  \version 1.4.0
+*/
+int Fl_Gl_Window::swap_interval() const {
+  return pGlWindowDriver->swap_interval();
+}
+
 void Fl_Gl_Window::flush() {
   if (!shown()) return;
   uchar save_valid = valid_f_ & 1;
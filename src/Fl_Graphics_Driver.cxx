@@ -29,6 +29,7 @@
 #include <FL/Fl_Image_Surface.H>
 #include <FL/math.h>
 #include <FL/platform.H>
+#include <string.h>
 
 FL_EXPORT Fl_Graphics_Driver *fl_graphics_driver; // the current driver of graphics operations
 
@@ -145,6 +146,14 @@ void Fl_Graphics_Driver::set_color(Fl_Color i, unsigned c)
 }
 
 
+/** see Fl::set_colors(const unsigned *, int, int) */
+void Fl_Graphics_Driver::set_colors(const unsigned *colors, int first, int count)
+{
+  // reimplement in the driver if it can batch the update
+  for (int i = 0; i < count; i++) set_color((Fl_Color)(first + i), colors[i]);
+}
+
+
 /** see Fl::free_color(Fl_Color, int) */
 void Fl_Graphics_Driver::free_color(Fl_Color i, int overlay)
 {
@@ -249,6 +258,8 @@ void Fl_Graphics_Driver::draw_pixmap(Fl_Pixmap *pxm, int XP, int YP, int WP, int
       delete pxm2;
     } else cache(pxm);
   }
+  void fl_image_cache_note_draw(Fl_Image*, size_t); // below
+  fl_image_cache_note_draw(pxm, (size_t)*pw * *ph * 4);
   // draw pxm using its scaled id_ & pixmap_
   draw_fixed(pxm, X, Y, W, H, cx, cy);
 }
@@ -280,11 +291,168 @@ void Fl_Graphics_Driver::draw_bitmap(Fl_Bitmap *bm, int XP, int YP, int WP, int
       delete bm2;
     } else cache(bm);
   }
+  void fl_image_cache_note_draw(Fl_Image*, size_t); // below
+  fl_image_cache_note_draw(bm, (size_t)*pw * *ph / 8 + 1);
   // draw bm using its scaled id_
   draw_fixed(bm, X, Y, W, H, cx, cy);
 }
 
 
+//
+// Cache of pre-scaled copies of Fl_RGB_Image objects.
+//
+// When a window moves between monitors with different scale factors, the
+// size of the cached form of each image it draws changes, and the image
+// was resampled again at every transition - and at every expose when the
+// same image is drawn at two scales at once. The most recently used
+// scaled copies are kept here, keyed by source image and target size, so
+// switching back to an already-seen scale reuses the resampled pixels
+// and only re-uploads them. Entries are dropped when the source image is
+// uncached, which all pixel mutations and the destructor go through.
+//
+
+#define SCALED_VARIANT_CACHE_SIZE 16
+
+typedef struct {
+  const Fl_RGB_Image *src; // source image the variant was scaled from, or NULL
+  Fl_RGB_Image *scaled;    // owned copy of src at the variant size
+  unsigned last_use;       // for LRU replacement
+} ScaledVariantEntry;
+
+static ScaledVariantEntry scaled_variants[SCALED_VARIANT_CACHE_SIZE];
+static unsigned scaled_variant_clock = 0;
+
+static Fl_RGB_Image *get_scaled_variant(const Fl_RGB_Image *img, int w2, int h2) {
+  for (int i = 0; i < SCALED_VARIANT_CACHE_SIZE; i++) {
+    ScaledVariantEntry *e = &scaled_variants[i];
+    if (e->src == img && e->scaled->data_w() == w2 && e->scaled->data_h() == h2) {
+      e->last_use = ++scaled_variant_clock;
+      return e->scaled;
+    }
+  }
+  return 0;
+}
+
+static void put_scaled_variant(const Fl_RGB_Image *img, Fl_RGB_Image *scaled) {
+  ScaledVariantEntry *e = &scaled_variants[0];
+  for (int i = 1; i < SCALED_VARIANT_CACHE_SIZE; i++) {
+    if (scaled_variants[i].last_use < e->last_use) e = &scaled_variants[i];
+  }
+  delete e->scaled;
+  e->src = img;
+  e->scaled = scaled;
+  e->last_use = ++scaled_variant_clock;
+}
+
+// Called by Fl_RGB_Image::uncache() so modified or deleted images cannot
+// leave stale variants behind.
+void fl_forget_scaled_variants(const Fl_RGB_Image *img) {
+  for (int i = 0; i < SCALED_VARIANT_CACHE_SIZE; i++) {
+    ScaledVariantEntry *e = &scaled_variants[i];
+    if (e->src == img) {
+      delete e->scaled;
+      e->scaled = 0;
+      e->src = 0;
+      e->last_use = 0;
+    }
+  }
+}
+
+//
+// Budgeted LRU registry of images holding a live platform cache.
+//
+// Each first draw of an Fl_Pixmap, Fl_Bitmap or Fl_RGB_Image builds a
+// server/GPU-side copy that stays until uncache(). With many icons spread
+// over rarely-visited dialogs that memory only grows, so the registry
+// tracks every cached image in most-recently-drawn order and, when
+// Fl_Image::cache_budget() is set, evicts the least recently drawn ones
+// past the budget by calling their uncache(). An evicted image simply
+// rebuilds its cache on its next draw. Hit/miss/eviction counts land in
+// Fl::perf_counters().
+//
+
+struct Image_Cache_Entry {
+  Fl_Image *img;
+  size_t bytes;                  // estimated size of the platform cache
+  Image_Cache_Entry *prev, *next;
+};
+static Image_Cache_Entry *image_cache_first = 0; // most recently drawn
+static Image_Cache_Entry *image_cache_last = 0;  // least recently drawn
+static Image_Cache_Entry *image_cache_free = 0;  // recycled entries
+static size_t image_cache_bytes = 0;             // sum of entry bytes
+
+extern Fl_Perf_Counters fl_perf_counters; // in Fl.cxx
+
+static Image_Cache_Entry *image_cache_find(Fl_Image *img) {
+  for (Image_Cache_Entry *e = image_cache_first; e; e = e->next) {
+    if (e->img == img) return e;
+  }
+  return 0;
+}
+
+static void image_cache_unlink(Image_Cache_Entry *e) {
+  if (e->prev) e->prev->next = e->next; else image_cache_first = e->next;
+  if (e->next) e->next->prev = e->prev; else image_cache_last = e->prev;
+}
+
+static void image_cache_push_front(Image_Cache_Entry *e) {
+  e->prev = 0;
+  e->next = image_cache_first;
+  if (image_cache_first) image_cache_first->prev = e;
+  image_cache_first = e;
+  if (!image_cache_last) image_cache_last = e;
+}
+
+// Called by the uncache() methods of the cached image classes: an image
+// with no platform cache must not stay in the registry.
+void fl_image_cache_forget(Fl_Image *img) {
+  Image_Cache_Entry *e = image_cache_find(img);
+  if (!e) return;
+  image_cache_unlink(e);
+  image_cache_bytes -= e->bytes;
+  e->next = image_cache_free;
+  image_cache_free = e;
+}
+
+// Evicts least recently drawn images until the budget is respected,
+// never touching 'keep' (the image being drawn right now, if any).
+void fl_image_cache_trim(Fl_Image *keep) {
+  size_t budget = Fl_Image::cache_budget();
+  if (!budget) return;
+  while (image_cache_bytes > budget && image_cache_last && image_cache_last->img != keep) {
+    Fl_Image *victim = image_cache_last->img;
+    fl_perf_counters.image_cache_evictions++;
+    victim->uncache(); // calls fl_image_cache_forget(victim)
+    if (image_cache_last && image_cache_last->img == victim) break; // did not unregister
+  }
+}
+
+// Called by the image draw functions once the platform cache exists:
+// accounts the draw as hit or miss, refreshes the LRU order and the size
+// estimate, and applies the budget.
+void fl_image_cache_note_draw(Fl_Image *img, size_t bytes) {
+  Image_Cache_Entry *e = image_cache_find(img);
+  if (e) {
+    fl_perf_counters.image_cache_hits++;
+    image_cache_bytes += bytes - e->bytes;
+    e->bytes = bytes;
+    if (e != image_cache_first) {
+      image_cache_unlink(e);
+      image_cache_push_front(e);
+    }
+  } else {
+    fl_perf_counters.image_cache_misses++;
+    e = image_cache_free;
+    if (e) image_cache_free = e->next;
+    else e = new Image_Cache_Entry;
+    e->img = img;
+    e->bytes = bytes;
+    image_cache_push_front(e);
+    image_cache_bytes += bytes;
+  }
+  fl_image_cache_trim(img);
+}
+
 /** Draws an Fl_RGB_Image object using this graphics driver.
  Specifies a bounding box for the image, with the origin (upper left-hand corner) of
  the image offset by the cx and cy arguments.
@@ -310,13 +478,19 @@ void Fl_Graphics_Driver::draw_rgb(Fl_RGB_Image *img, int XP, int YP, int WP, int
   } // after this, w2 x h2 is desired cached image size
   cache_w_h(img, pw, ph); // after this, *pw x *ph is current size of cached image
   if (*id(img) && (w2 != *pw || h2 != *ph )) {
-    img->uncache();
+    // only the cached size is stale, the pixels are not: drop the platform
+    // cache directly so the scaled variants of img survive the transition
+    default_driver().uncache(img, *id(img), *mask(img));
   }
   if (!*id(img) && need_scaled_drawing) { // build and draw a scaled id_ for img
-    Fl_RGB_Scaling keep = Fl_Image::RGB_scaling();
-    Fl_Image::RGB_scaling(Fl_Image::scaling_algorithm());
-    Fl_RGB_Image *img2 = (Fl_RGB_Image*)img->copy(w2, h2);
-    Fl_Image::RGB_scaling(keep);
+    Fl_RGB_Image *img2 = get_scaled_variant(img, w2, h2);
+    if (!img2) {
+      Fl_RGB_Scaling keep = Fl_Image::RGB_scaling();
+      Fl_Image::RGB_scaling(Fl_Image::scaling_algorithm());
+      img2 = (Fl_RGB_Image*)img->copy(w2, h2);
+      Fl_Image::RGB_scaling(keep);
+      put_scaled_variant(img, img2); // the cache owns img2 from here on
+    }
     cache(img2);
     draw_fixed(img2, XP, YP, WP, HP, cx, cy);
     *id(img) = *id(img2);
@@ -325,12 +499,27 @@ void Fl_Graphics_Driver::draw_rgb(Fl_RGB_Image *img, int XP, int YP, int WP, int
     *mask(img2) = 0;
     *pw = w2;
     *ph = h2;
-    delete img2;
   }
   else { // draw img using its scaled id_
     if (!*id(img)) cache(img);
     draw_fixed(img, XP, YP, WP, HP, cx, cy);
   }
+  fl_image_cache_note_draw(img, (size_t)w2 * h2 * 4);
+}
+
+/** Draws the same image at several positions, see fl_draw_image_batch().
+  This base implementation checks the clip once per position and draws the
+  visible ones; drivers with a native composite list can override it to
+  issue the whole batch as one backend operation. */
+void Fl_Graphics_Driver::draw_image_batch(Fl_Image *img, const int *xy_pairs, int count) {
+  if (!img || !xy_pairs) return;
+  int w = img->w(), h = img->h();
+  if (w <= 0 || h <= 0) return;
+  for (int i = 0; i < count; i++) {
+    int x = xy_pairs[2*i], y = xy_pairs[2*i+1];
+    if (!not_clipped(x, y, w, h)) continue;
+    img->draw(x, y, w, h, 0, 0);
+  }
 }
 
 /** Accessor to private member function of Fl_Image_Surface */
@@ -460,6 +649,46 @@ void Fl_Graphics_Driver::rect(int x, int y, int w, int h) {}
 /** see fl_rectf() */
 void Fl_Graphics_Driver::rectf(int x, int y, int w, int h) {}
 
+/** see fl_gradient_rectf(int, int, int, int, int, const double*, const Fl_Color*, int)
+
+  The portable implementation interpolates the gradient one line at a time,
+  merging runs of lines with equal color into single filled rectangles.
+  Drivers with a native linear gradient primitive are expected to override
+  this and render the whole rectangle with one backend call.
+*/
+void Fl_Graphics_Driver::gradient_rect(int x, int y, int w, int h, int nstops, const double *pos, const Fl_Color *colors, int horizontal) {
+  if (w <= 0 || h <= 0 || nstops <= 0) return;
+  Fl_Color keep = color();
+  if (nstops == 1) {
+    color(colors[0]);
+    rectf(x, y, w, h);
+    color(keep);
+    return;
+  }
+  int len = horizontal ? w : h;
+  int run_start = 0, seg = 0;
+  Fl_Color run_color = colors[0];
+  for (int i = 1; i < len; i++) {
+    double t = i / double(len - 1);
+    while (seg < nstops - 2 && t > pos[seg + 1]) seg++;
+    double d = pos[seg + 1] - pos[seg];
+    double u = (d > 0.) ? (t - pos[seg]) / d : 1.;
+    if (u < 0.) u = 0.; else if (u > 1.) u = 1.;
+    Fl_Color c = fl_color_average(colors[seg + 1], colors[seg], float(u));
+    if (c != run_color) { // flush the finished run of equally colored lines
+      color(run_color);
+      if (horizontal) rectf(x + run_start, y, i - run_start, h);
+      else rectf(x, y + run_start, w, i - run_start);
+      run_start = i;
+      run_color = c;
+    }
+  }
+  color(run_color);
+  if (horizontal) rectf(x + run_start, y, len - run_start, h);
+  else rectf(x, y + run_start, w, len - run_start);
+  color(keep);
+}
+
 /** see fl_line(int, int, int, int) */
 void Fl_Graphics_Driver::line(int x, int y, int x1, int y1) {}
 
@@ -611,6 +840,19 @@ int Fl_Graphics_Driver::height() { return size(); }
 /** Return the current line descent */
 int Fl_Graphics_Driver::descent() { return 0; }
 
+/** Select font \p face at size \p fsize and return a context caching its metrics.
+ The returned Fl_Measure_Context answers height() and descent() without further
+ driver calls; width() queries go to this driver with the selected font. */
+Fl_Measure_Context Fl_Graphics_Driver::begin_measure(Fl_Font face, Fl_Fontsize fsize) {
+  font(face, fsize);
+  return Fl_Measure_Context(this, height(), descent());
+}
+
+double Fl_Measure_Context::width(const char *str) const {
+  if (str) return driver_->width(str, (int)strlen(str));
+  else return 0.0;
+}
+
 /** Set the current Fl_Font_Descriptor */
 void Fl_Graphics_Driver::font_descriptor(Fl_Font_Descriptor *d) { font_descriptor_ = d;}
 
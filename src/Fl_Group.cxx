@@ -25,6 +25,7 @@
 #include <FL/fl_draw.H>
 
 #include <stdlib.h> // malloc etc.
+#include <string.h> // memset, memcpy
 
 Fl_Group* Fl_Group::current_;
 
@@ -52,6 +53,209 @@ int Fl_Group::find(const Fl_Widget* o) const {
   return i;
 }
 
+/**
+  Returns the first child whose user_data() equals \p v.
+
+  Only immediate children are searched, in z-order. Useful to route
+  updates to widgets tagged with an application id via
+  Fl_Widget::user_data(void*).
+
+  \param[in] v the user data pointer to look for
+  \returns the first matching child, or NULL if none matches
+  \since 1.4.0
+*/
+Fl_Widget *Fl_Group::find_by_user_data(void *v) const {
+  Fl_Widget*const* a = array();
+  for (int i=0; i < children_; i++, a++)
+    if ((*a)->user_data() == v) return *a;
+  return NULL;
+}
+
+/**
+  Returns the first child whose label() matches \p text with strcmp().
+
+  Only immediate children are searched, in z-order. Children with a
+  NULL label never match.
+
+  \param[in] text the label text to look for; must not be NULL
+  \returns the first matching child, or NULL if none matches
+  \since 1.4.0
+*/
+Fl_Widget *Fl_Group::find_by_label(const char *text) const {
+  Fl_Widget*const* a = array();
+  for (int i=0; i < children_; i++, a++)
+    if ((*a)->label() && strcmp((*a)->label(), text) == 0) return *a;
+  return NULL;
+}
+
+// Optional spatial index over the children. When a group holds thousands
+// of widgets (schematic editors, node graphs), draw() and handle() spend
+// most of their time scanning children that are nowhere near the clip box
+// or the mouse. The index is a uniform grid over the bounding box of all
+// children; each cell lists the children (by index) whose bounding box -
+// inflated by the size of an outside label, if any - intersects the cell.
+// It is built lazily on first use and discarded whenever a child is
+// added, removed or resized.
+
+// number of children below which a linear scan is cheaper than the grid:
+#define FL_GROUP_GRID_MIN 64
+
+class Fl_Group::Grid {
+public:
+  int X, Y, W, H;       // bounding box of all children when built
+  int cols, rows;       // cell layout
+  int cellw, cellh;     // size of one cell
+  int n;                // number of children when built
+  int *start;           // cols*rows+1 offsets into index[]
+  int *index;           // child indices, bucketed by cell
+  char *mark;           // per-child scratch flags for box queries
+  Fl_Widget **cand;     // scratch candidate list for point queries
+  Grid() {start = index = 0; mark = 0; cand = 0;}
+  ~Grid() {free(start); free(index); free(mark); free(cand);}
+
+  // clamp a box to the range of cells it covers, returns 0 if fully outside:
+  int range(int bx, int by, int bw, int bh, int &c1, int &r1, int &c2, int &r2) const {
+    if (bw <= 0 || bh <= 0) return 0;
+    if (bx+bw <= X || by+bh <= Y || bx >= X+W || by >= Y+H) return 0;
+    c1 = (bx - X) / cellw; if (c1 < 0) c1 = 0;
+    r1 = (by - Y) / cellh; if (r1 < 0) r1 = 0;
+    c2 = (bx+bw-1 - X) / cellw; if (c2 >= cols) c2 = cols-1;
+    r2 = (by+bh-1 - Y) / cellh; if (r2 >= rows) r2 = rows-1;
+    return 1;
+  }
+
+  // mark all children whose cells intersect the given box:
+  const char *query_box(int bx, int by, int bw, int bh) const {
+    memset(mark, 0, n);
+    int c1, r1, c2, r2;
+    if (range(bx, by, bw, bh, c1, r1, c2, r2)) {
+      for (int r = r1; r <= r2; r++) {
+        for (int c = c1; c <= c2; c++) {
+          int cell = r*cols + c;
+          for (int k = start[cell]; k < start[cell+1]; k++) mark[index[k]] = 1;
+        }
+      }
+    }
+    return mark;
+  }
+
+  // collect the children whose cell contains (px,py), in child order:
+  int query_point(int px, int py, Fl_Widget *const *a, Fl_Widget **out) const {
+    int c1, r1, c2, r2, found = 0;
+    if (range(px, py, 1, 1, c1, r1, c2, r2)) {
+      int cell = r1*cols + c1;
+      for (int k = start[cell]; k < start[cell+1]; k++) out[found++] = a[index[k]];
+    }
+    return found;
+  }
+};
+
+// the box a child occupies in the index, label included:
+static void child_box(const Fl_Widget *o, int &X, int &Y, int &W, int &H) {
+  X = o->x(); Y = o->y(); W = o->w(); H = o->h();
+  if ((o->align() & 15) && !(o->align() & FL_ALIGN_INSIDE)) {
+    // inflate the box so an outside label is found as well:
+    int lw = 0, lh = 0;
+    o->measure_label(lw, lh);
+    X -= lw; Y -= lh; W += 2*lw; H += 2*lh;
+  }
+}
+
+// Returns the spatial index, building it if necessary. Returns NULL if the
+// index is disabled or the group is too small for it to pay off.
+Fl_Group::Grid *Fl_Group::grid() {
+  if (!spatial_index_ || children_ < FL_GROUP_GRID_MIN) return 0;
+  if (grid_) return grid_;
+  Grid *g = new Grid();
+  Fl_Widget*const* a = array();
+  int i, bx, by, bw, bh;
+  int X1 = 0, Y1 = 0, X2 = 0, Y2 = 0;
+  for (i = 0; i < children_; i++) {
+    child_box(a[i], bx, by, bw, bh);
+    if (!i) {X1 = bx; Y1 = by; X2 = bx+bw; Y2 = by+bh;}
+    else {
+      if (bx < X1) X1 = bx;
+      if (by < Y1) Y1 = by;
+      if (bx+bw > X2) X2 = bx+bw;
+      if (by+bh > Y2) Y2 = by+bh;
+    }
+  }
+  g->X = X1; g->Y = Y1;
+  g->W = X2-X1; g->H = Y2-Y1;
+  if (g->W < 1) g->W = 1;
+  if (g->H < 1) g->H = 1;
+  // aim for a handful of children per cell, but keep the table small:
+  int c = 8;
+  while (c*c*4 < children_ && c < 128) c *= 2;
+  g->cols = g->rows = c;
+  g->cellw = (g->W + c-1) / c;
+  g->cellh = (g->H + c-1) / c;
+  g->n = children_;
+  int cells = g->cols * g->rows;
+  g->start = (int*)calloc(cells+1, sizeof(int));
+  // two passes: count the entries of each cell, then fill them in:
+  int c1, r1, c2, r2, r;
+  for (i = 0; i < children_; i++) {
+    child_box(a[i], bx, by, bw, bh);
+    if (g->range(bx, by, bw, bh, c1, r1, c2, r2))
+      for (r = r1; r <= r2; r++)
+        for (c = c1; c <= c2; c++) g->start[r*g->cols + c + 1]++;
+  }
+  for (c = 0; c < cells; c++) g->start[c+1] += g->start[c];
+  g->index = (int*)malloc((g->start[cells] ? g->start[cells] : 1) * sizeof(int));
+  int *cursor = (int*)malloc(cells * sizeof(int));
+  memcpy(cursor, g->start, cells * sizeof(int));
+  for (i = 0; i < children_; i++) {
+    child_box(a[i], bx, by, bw, bh);
+    if (g->range(bx, by, bw, bh, c1, r1, c2, r2))
+      for (r = r1; r <= r2; r++)
+        for (c = c1; c <= c2; c++) g->index[cursor[r*g->cols + c]++] = i;
+  }
+  free(cursor);
+  g->mark = (char*)malloc(children_);
+  g->cand = (Fl_Widget**)malloc(children_ * sizeof(Fl_Widget*));
+  grid_ = g;
+  return grid_;
+}
+
+/**
+  Enables or disables the spatial index over the children.
+
+  By default (0) the group's draw() and handle() scan all children, which
+  is perfectly adequate for normal dialogs. If a group holds a very large
+  number of children - a schematic, a node graph, a form with thousands of
+  cells - set this to 1 and the group keeps a grid index of the children's
+  bounding boxes: drawing then only visits children intersecting the clip
+  box and mouse events only visit children under the cursor.
+
+  The index is rebuilt automatically when children are added, removed or
+  resized through Fl_Widget::resize() (or position() / size()). If you
+  move a child by some other means, call invalidate_spatial_index().
+  Groups with fewer than 64 children ignore the index and scan linearly.
+
+  Keyboard events, FL_MOUSEWHEEL and navigation are not affected; they
+  retain the semantics of scanning every child.
+
+  \param[in] on 1 to enable the index, 0 to disable it.
+*/
+void Fl_Group::spatial_index(int on) {
+  spatial_index_ = (char)(on ? 1 : 0);
+  if (!on) invalidate_spatial_index();
+}
+
+/**
+  Discards the spatial index so it is rebuilt on next use.
+
+  This is done automatically when children are added, removed or resized;
+  call it yourself if you reposition a child behind the group's back.
+
+  \see void Fl_Group::spatial_index(int on)
+*/
+void Fl_Group::invalidate_spatial_index() {
+  delete grid_;
+  grid_ = 0;
+}
+
 // Some (* which? *) compilers / toolchains can't export the static
 // class member: current_, so these methods can't be inlined...
 
@@ -144,9 +348,28 @@ static int navkey() {
 int Fl_Group::handle(int event) {
 
   Fl_Widget*const* a = array();
+  int nc = children();
   int i;
   Fl_Widget* o;
 
+  // with the spatial index enabled, positional events only consider the
+  // children under the cursor (in the same bottom-to-top order):
+  switch (event) {
+  case FL_ENTER:
+  case FL_MOVE:
+  case FL_DND_ENTER:
+  case FL_DND_DRAG:
+  case FL_PUSH:
+  case FL_RELEASE:
+  case FL_DRAG: {
+    Grid *g = grid();
+    if (g) {
+      nc = g->query_point(Fl::event_x(), Fl::event_y(), a, g->cand);
+      a = g->cand;
+    }
+    break; }
+  }
+
   switch (event) {
 
   case FL_FOCUS:
@@ -187,14 +410,26 @@ int Fl_Group::handle(int event) {
 
   case FL_ENTER:
   case FL_MOVE:
-    for (i = children(); i--;) {
+    // Fast path: between two mouse moves the target almost never changes,
+    // so re-test the child that accepted the last FL_MOVE before scanning
+    // all children. The cache is cleared when that child is removed.
+    o = last_entered_child_;
+    if (o && o->visible() && Fl::event_inside(o) &&
+        o->contains(Fl::belowmouse())) {
+      return send(o,FL_MOVE);
+    }
+    for (i = nc; i--;) {
       o = a[i];
       if (o->visible() && Fl::event_inside(o)) {
         if (o->contains(Fl::belowmouse())) {
+          last_entered_child_ = o;
           return send(o,FL_MOVE);
         } else {
           Fl::belowmouse(o);
-          if (send(o,FL_ENTER)) return 1;
+          if (send(o,FL_ENTER)) {
+            last_entered_child_ = o;
+            return 1;
+          }
         }
       }
     }
@@ -203,7 +438,7 @@ int Fl_Group::handle(int event) {
 
   case FL_DND_ENTER:
   case FL_DND_DRAG:
-    for (i = children(); i--;) {
+    for (i = nc; i--;) {
       o = a[i];
       if (o->takesevents() && Fl::event_inside(o)) {
         if (o->contains(Fl::belowmouse())) {
@@ -218,7 +453,7 @@ int Fl_Group::handle(int event) {
     return 0;
 
   case FL_PUSH:
-    for (i = children(); i--;) {
+    for (i = nc; i--;) {
       o = a[i];
       if (o->takesevents() && Fl::event_inside(o)) {
         Fl_Widget_Tracker wp(o);
@@ -236,7 +471,7 @@ int Fl_Group::handle(int event) {
     if (o == this) return 0;
     else if (o) send(o,event);
     else {
-      for (i = children(); i--;) {
+      for (i = nc; i--;) {
         o = a[i];
         if (o->takesevents() && Fl::event_inside(o)) {
           if (send(o,event)) return 1;
@@ -363,9 +598,12 @@ Fl_Group::Fl_Group(int X,int Y,int W,int H,const char *l)
   children_ = 0;
   array_ = 0;
   savedfocus_ = 0;
+  last_entered_child_ = 0;
   resizable_ = this;
   bounds_ = 0; // this is allocated when first resize() is done
   sizes_ = 0; // see bounds_ (FLTK 1.3 compatibility)
+  grid_ = 0; // this is allocated on demand, see spatial_index(int)
+  spatial_index_ = 0;
 
   // Subclasses may want to construct child objects as part of their
   // constructor, so make sure they are add()'d to this object.
@@ -387,6 +625,7 @@ Fl_Group::Fl_Group(int X,int Y,int W,int H,const char *l)
 */
 void Fl_Group::clear() {
   savedfocus_ = 0;
+  last_entered_child_ = 0;
   resizable_ = this;
   init_sizes();
 
@@ -510,6 +749,7 @@ void Fl_Group::remove(int index) {
   if (index < 0 || index >= children_) return;
   Fl_Widget &o = *child(index);
   if (&o == savedfocus_) savedfocus_ = 0;
+  if (&o == last_entered_child_) last_entered_child_ = 0;
   if (o.parent_ == this) {      // this should always be true
     o.parent_ = 0;
   }
@@ -569,6 +809,7 @@ void Fl_Group::init_sizes() {
   bounds_ = 0;
   delete[] sizes_;      // FLTK 1.3 compatibility
   sizes_ = 0;           // FLTK 1.3 compatibility
+  invalidate_spatial_index();
 }
 
 /**
@@ -710,7 +951,9 @@ void Fl_Group::resize(int X, int Y, int W, int H) {
 
   if ((!resizable() || (dw==0 && dh==0 )) && !Fl_Window::is_a_rescale()) {
 
-    if (!as_window()) {
+    // skip the children entirely if they don't move: this prunes the
+    // whole subtree of a group whose geometry is unchanged
+    if (!as_window() && (dx || dy)) {
       Fl_Widget*const* a = array();
       for (int i=children_; i--;) {
         Fl_Widget* o = *a++;
@@ -779,7 +1022,15 @@ void Fl_Group::resize(int X, int Y, int W, int H) {
 
 #endif // old / new (1.4.0++) widget resizing code
 
-      o->resize(L+dx, T+dy, R-L, B-T);
+      // only resize the child if its geometry actually changed (as in
+      // Fl_Widget::damage_resize()): children left untouched by the
+      // resizable() rules - fixed side panels, toolbars, ... - would
+      // otherwise be visited recursively on every resize event.
+      // During a rescale the resize must always be propagated so the
+      // window drivers can update native window data.
+      if (o->x() != L+dx || o->y() != T+dy || o->w() != R-L || o->h() != B-T ||
+          Fl_Window::is_a_rescale())
+        o->resize(L+dx, T+dy, R-L, B-T);
     }
   }
 }
@@ -791,6 +1042,24 @@ void Fl_Group::resize(int X, int Y, int W, int H) {
   border or background. You can call draw_children() from the derived draw() method
   after drawing the box, border, or background.
 */
+// Is child 'n' of array 'a' fully covered by a later, visible sibling
+// that declared itself opaque (see Fl_Widget::opaque(int))? If so there
+// is no point drawing it; the sibling paints over every pixel anyway.
+//
+static int occluded_by_later_sibling(Fl_Widget*const* a, int n, int children) {
+  Fl_Widget *o = a[n];
+  // an outside label extends past the widget's rectangle; don't skip those
+  if (o->label() && o->align() && !(o->align() & FL_ALIGN_INSIDE)) return 0;
+  for (int j=n+1; j<children; j++) {
+    Fl_Widget *s = a[j];
+    if (!s->opaque() || !s->visible()) continue;
+    if (o->x() >= s->x() && o->y() >= s->y() &&
+        o->x() + o->w() <= s->x() + s->w() &&
+        o->y() + o->h() <= s->y() + s->h()) return 1;
+  }
+  return 0;
+}
+
 void Fl_Group::draw_children() {
   Fl_Widget*const* a = array();
 
@@ -801,14 +1070,35 @@ void Fl_Group::draw_children() {
                  h() - Fl::box_dh(box()));
   }
 
+  // with the spatial index enabled, only visit the children whose cells
+  // intersect the current clip box:
+  const char *marked = 0;
+  Grid *g = grid();
+  if (g) {
+    int cx, cy, cw, ch;
+    fl_clip_box(g->X, g->Y, g->W, g->H, cx, cy, cw, ch);
+    marked = g->query_box(cx, cy, cw, ch);
+  }
+
+  // any opaque children? if not, skip the occlusion tests entirely
+  int occlusion = 0;
+  for (int i=1; i<children_; i++)
+    if (a[i]->opaque() && a[i]->visible()) { occlusion = 1; break; }
+
   if (damage() & ~FL_DAMAGE_CHILD) { // redraw the entire thing:
-    for (int i=children_; i--;) {
-      Fl_Widget& o = **a++;
+    for (int i=0; i<children_; i++) {
+      if (marked && !marked[i]) continue;
+      if (occlusion && occluded_by_later_sibling(a, i, children_)) continue;
+      Fl_Widget& o = *a[i];
       draw_child(o);
       draw_outside_label(o);
     }
   } else {      // only redraw the children that need it:
-    for (int i=children_; i--;) update_child(**a++);
+    for (int i=0; i<children_; i++) {
+      if (marked && !marked[i]) continue;
+      if (occlusion && occluded_by_later_sibling(a, i, children_)) continue;
+      update_child(*a[i]);
+    }
   }
 
   if (clip_children()) fl_pop_clip();
@@ -830,10 +1120,20 @@ void Fl_Group::draw() {
 
   \sa Fl_Group::draw_child(Fl_Widget& widget) const
 */
+// draw profiling, see Fl::draw_profile(int); both implemented in Fl.cxx
+extern double fl_draw_profile_now();
+extern void fl_draw_profile_record(Fl_Widget *widget, double t0);
+
 void Fl_Group::update_child(Fl_Widget& widget) const {
   if (widget.damage() && widget.visible() && widget.type() < FL_WINDOW &&
       fl_not_clipped(widget.x(), widget.y(), widget.w(), widget.h())) {
-    widget.draw();
+    if (Fl::draw_profile()) {
+      double t0 = fl_draw_profile_now();
+      widget.draw();
+      fl_draw_profile_record(&widget, t0);
+    } else {
+      widget.draw();
+    }
     widget.clear_damage();
   }
 }
@@ -848,7 +1148,13 @@ void Fl_Group::draw_child(Fl_Widget& widget) const {
   if (widget.visible() && widget.type() < FL_WINDOW &&
       fl_not_clipped(widget.x(), widget.y(), widget.w(), widget.h())) {
     widget.clear_damage(FL_DAMAGE_ALL);
-    widget.draw();
+    if (Fl::draw_profile()) {
+      double t0 = fl_draw_profile_now();
+      widget.draw();
+      fl_draw_profile_record(&widget, t0);
+    } else {
+      widget.draw();
+    }
     widget.clear_damage();
   }
 }
@@ -39,6 +39,8 @@
 //   Fl_Help_View::resize()          - Resize the help widget.
 //   Fl_Help_View::topline()         - Set the top line to the named target.
 //   Fl_Help_View::topline()         - Set the top line by number.
+//   Fl_Help_View::update_scrollbars() - Update the scrollbars for the
+//                                     current document and widget size.
 //   Fl_Help_View::value()           - Set the help text directly.
 //   scrollbar_callback()            - A callback for the scrollbar.
 //
@@ -1177,6 +1179,86 @@ Fl_Help_View::draw()
 } // draw()
 
 
+/** Frees the search index built by build_search_index(). */
+void Fl_Help_View::free_search_index() {
+  if (search_text_) { free(search_text_); search_text_ = NULL; }
+  if (search_pos_)  { free(search_pos_);  search_pos_  = NULL; }
+  search_len_ = 0;
+}
+
+
+/** Builds the filtered text index used by find().
+
+  The document is copied block by block with HTML tags removed, entities
+  decoded to UTF-8, newlines folded to spaces and printable ASCII lowercased,
+  so that find() can run a plain substring scan instead of re-filtering the
+  raw HTML on every call. search_pos_ maps every byte of the filtered text
+  back to its offset in value(). A NUL byte separates adjacent blocks so
+  that a match can never span two blocks, as before. The index is discarded
+  whenever the document is reformatted (see format()) and rebuilt lazily by
+  the next find().
+*/
+void Fl_Help_View::build_search_index() {
+  free_search_index();
+
+  if (!value_) return;
+
+  int cap = (int)strlen(value_) + nblocks_ + 1;
+  char *txt = (char *)malloc(cap);
+  int  *pos = (int *)malloc(cap * sizeof(int));
+  int  n = 0;
+  Fl_Help_Block *b = blocks_;
+
+  for (int i = 0; i < nblocks_; i++, b++) {
+    if (n) { // separate blocks so a match cannot span them
+      pos[n] = (int)(b->start - value_);
+      txt[n++] = '\0';
+    }
+    const char *bp = b->start;
+    while (*bp && bp < b->end) {
+      const char *start = bp;
+      int c;
+      if (*bp == '<') {
+        // skip to end of element...
+        while (*bp && bp < b->end && *bp != '>') bp++;
+        if (*bp) bp++;
+        continue;
+      }
+      if (n + 4 >= cap) { // entities may decode to more bytes than they use
+        cap *= 2;
+        txt = (char *)realloc(txt, cap);
+        pos = (int *)realloc(pos, cap * sizeof(int));
+      }
+      if (*bp == '&') {
+        // decode HTML entity...
+        if ((c = quote_char(bp + 1)) < 0) { c = '&'; bp++; }
+        else {
+          bp = strchr(bp + 1, ';') + 1;
+          if (c >= 0x80) { // store the code point as UTF-8 so it can match
+            char ubuf[6];
+            int ulen = fl_utf8encode((unsigned)c, ubuf);
+            for (int k = 0; k < ulen; k++) {
+              pos[n] = (int)(start - value_);
+              txt[n++] = ubuf[k];
+            }
+            continue;
+          }
+        }
+      } else c = (uchar)*bp++;
+
+      if (c == '\n') c = ' '; // treat newline as a single space
+
+      pos[n] = (int)(start - value_);
+      txt[n++] = (c > 0x20 && c < 0x80) ? (char)tolower(c) : (char)c;
+    }
+  }
+
+  search_text_ = txt;
+  search_pos_  = pos;
+  search_len_  = n;
+}
+
+
 /** Finds the specified string \p s at starting position \p p.
 
   The argument \p p and the return value are offsets in Fl_Help_View::value(),
@@ -1190,9 +1272,9 @@ Fl_Help_View::draw()
   - every newline (LF, '\\n') in value() is treated like a single space
   - all other strings are compared as-is (byte by byte)
 
-  \todo complex HTML entities for Unicode code points \> 0x80 are currently treated
-    like one byte (not character!) and do not (yet) match correctly ("<" matches "&lt;"
-    but "€" doesn't match "&euro;", and "ü" doesn't match "&uuml;")
+  The first search after a document is loaded or reformatted builds a
+  filtered text index (see build_search_index()), so repeated searches in
+  a large document scan plain text instead of the raw HTML.
 
   \param[in]  s   search string in UTF-8 encoding
   \param[in]  p   starting position for search (0,...), Default = 0
@@ -1203,68 +1285,61 @@ int                                             // O - Matching position or -1 i
 Fl_Help_View::find(const char *s,               // I - String to find
                    int        p)                // I - Starting position
 {
-  int           i,                              // Looping var
-                c;                              // Current character
+  int           i;                              // Looping var
   Fl_Help_Block *b;                             // Current block
-  const char    *bp,                            // Block matching pointer
-                *bs,                            // Start of current comparison
-                *sp;                            // Search string pointer
 
   DEBUG_FUNCTION(__LINE__,__FUNCTION__);
 
   // Range check input and value...
-  if (!s || !value_) return -1;
+  if (!s || !*s || !value_) return -1;
 
   if (p < 0 || p >= (int)strlen(value_)) p = 0;
 
-  // Look for the string...
-  for (i = nblocks_, b = blocks_; i > 0; i--, b++) {
-    if (b->end < (value_ + p))
-      continue;
-
-    if (b->start < (value_ + p)) bp = value_ + p;
-    else bp = b->start;
+  if (!search_text_) build_search_index();
+  if (!search_len_) return -1;
 
-    for (sp = s, bs = bp; *sp && *bp && bp < b->end; bp++) {
-      if (*bp == '<') {
-        // skip to end of element...
-        while (*bp && bp < b->end && *bp != '>') bp++;
-        // no match, so reset to start of search...
-        sp = s;
-        bs = bp + 1;
-        continue;
-      } else if (*bp == '&') {
-        // decode HTML entity...
-        if ((c = quote_char(bp + 1)) < 0) c = '&';      // *FIXME* UTF-8, see below
-        else bp = strchr(bp + 1, ';') + 1;
-      } else c = *bp;
-
-      if (c == '\n') c = ' '; // treat newline as a single space
+  // Fold the search string the same way the index is folded...
+  int ns = (int)strlen(s);
+  char *needle = (char *)malloc(ns + 1);
+  for (i = 0; i < ns; i++) {
+    int c = (uchar)s[i];
+    needle[i] = (c > 0x20 && c < 0x80) ? (char)tolower(c) : (char)c;
+  }
+  needle[ns] = '\0';
+
+  // Find the first index byte at or after position p...
+  int lo = 0, hi = search_len_;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (search_pos_[mid] < p) lo = mid + 1;
+    else hi = mid;
+  }
 
-      // *FIXME* *UTF-8* (A.S. 02/14/2016)
-      // At this point c may be an arbitrary Unicode Code Point corresponding
-      // to a quoted character (see above), i.e. it _can_ be a multi byte
-      // UTF-8 sequence and must be compared with the corresponding
-      // multi byte string in (*sp)...
-      // For instance: "&euro;" == 0x20ac -> 0xe2 0x82 0xac (UTF-8: 3 bytes).
-      // Hint: use fl_utf8encode() [see below]
-
-      if (c > 0x20 && c < 0x80 && tolower(*sp) == tolower(c)) sp++;
-      else if (*sp == c) sp++;
-      else { // No match, so reset to start of search...
-        sp = s;
-        bp = bs;
-        bs++;
-      }
+  // Look for the string...
+  for (i = lo; i + ns <= search_len_; i++) {
+    if (search_text_[i] != needle[0]) {
+      const char *q = (const char *)memchr(search_text_ + i, needle[0],
+                                           search_len_ - ns - i + 1);
+      if (!q) break;
+      i = (int)(q - search_text_);
     }
-
-    if (!*sp) { // Found a match!
-      topline(b->y - b->h);
-      return int(bs - value_);
+    if (memcmp(search_text_ + i, needle, ns) == 0) { // Found a match!
+      int off = search_pos_[i];
+      free(needle);
+      // scroll to the block containing the match...
+      int j;
+      for (j = nblocks_, b = blocks_; j > 0; j--, b++) {
+        if (value_ + off < b->end) {
+          topline(b->y - b->h);
+          break;
+        }
+      }
+      return off;
     }
   }
 
   // No match!
+  free(needle);
   return (-1);
 }
 
@@ -1309,6 +1384,10 @@ void Fl_Help_View::format() {
 
   DEBUG_FUNCTION(__LINE__,__FUNCTION__);
 
+  // The blocks are rebuilt below, so the search index of find() is stale;
+  // it is rebuilt lazily on the next search.
+  free_search_index();
+
   // Reset document width...
   int scrollsize = scrollbar_size_ ? scrollbar_size_ : Fl::scrollbar_size();
   hsize_ = w() - scrollsize - Fl::box_dw(b);
@@ -2026,6 +2105,22 @@ void Fl_Help_View::format() {
     qsort(targets_, ntargets_, sizeof(Fl_Help_Target),
           (compare_func_t)compare_targets);
 
+  update_scrollbars();
+}
+
+
+/** Updates the scrollbars for the current document and widget size.
+
+  This shows, hides and positions the scrollbars and clamps the scrolling
+  positions to the formatted document. The block layout computed by
+  format() depends on the width of the widget but not on its position or
+  height, so resize() can call this directly when the width is unchanged
+  instead of reformatting the whole document.
+*/
+void Fl_Help_View::update_scrollbars() {
+  Fl_Boxtype b = box() ? box() : FL_DOWN_BOX;
+                                        // Box to draw...
+
   int dx = Fl::box_dw(b) - Fl::box_dx(b);
   int dy = Fl::box_dh(b) - Fl::box_dy(b);
   int ss = scrollbar_size_ ? scrollbar_size_ : Fl::scrollbar_size();
@@ -2500,6 +2595,8 @@ Fl_Help_View::format_table(int        *table_width,     // O - Total table width
 /** Frees memory used for the document. */
 void
 Fl_Help_View::free_data() {
+  free_search_index();
+
   // Release all images...
   if (value_) {
     const char  *ptr,           // Pointer into block
@@ -3250,6 +3347,10 @@ Fl_Help_View::Fl_Help_View(int        xx,       // I - Left position
   nblocks_      = 0;
   blocks_       = (Fl_Help_Block *)0;
 
+  search_text_  = (char *)0;
+  search_pos_   = (int *)0;
+  search_len_   = 0;
+
   link_         = (Fl_Help_Func *)0;
 
   alinks_       = 0;
@@ -3451,6 +3552,7 @@ Fl_Help_View::resize(int xx,    // I - New left position
 {
   Fl_Boxtype            b = box() ? box() : FL_DOWN_BOX;
                                         // Box to draw...
+  int                   ww0 = w();      // Previous width
 
 
   Fl_Widget::resize(xx, yy, ww, hh);
@@ -3462,7 +3564,11 @@ Fl_Help_View::resize(int xx,    // I - New left position
                      y() + h() - scrollsize - Fl::box_dh(b) + Fl::box_dy(b),
                      w() - scrollsize - Fl::box_dw(b), scrollsize);
 
-  format();
+  // The document layout only depends on the width: when it is unchanged
+  // (the widget was moved or changed height), the blocks can be kept and
+  // only the scrollbars need updating.
+  if (w() != ww0) format();
+  else update_scrollbars();
 }
 
 
@@ -21,6 +21,7 @@
 #include <FL/Fl_Menu_Item.H>
 #include <FL/Fl_Image.H>
 #include "flstring.h"
+#include <math.h>
 
 void fl_restore_clip(); // from fl_rect.cxx
 
@@ -32,6 +33,30 @@ Fl_RGB_Scaling Fl_Image::RGB_scaling_ = FL_RGB_SCALING_NEAREST;
 
 Fl_RGB_Scaling Fl_Image::scaling_algorithm_ = FL_RGB_SCALING_BILINEAR;
 
+size_t Fl_Image::cache_budget_ = 0;
+
+/**
+ Sets the maximum amount of memory, in bytes, that the platform-specific
+ cached forms of all images may occupy together.
+
+ Drawing an image for the first time builds a platform cache for it
+ (an X11 pixmap, a GDI bitmap, ...). By default these caches are kept
+ until the image is destroyed or Fl_Image::uncache() is called. With a
+ non-zero budget, FLTK evicts the least recently drawn cached images
+ when the budget is exceeded; an evicted image transparently rebuilds
+ its cache the next time it is drawn.
+
+ A value of \c 0 (the default) means unlimited. Lowering the budget
+ takes effect immediately. Cache hit, miss and eviction counts are
+ reported by Fl::perf_counters().
+ \version 1.4
+*/
+void Fl_Image::cache_budget(size_t bytes) {
+  extern void fl_image_cache_trim(Fl_Image *); // in Fl_Graphics_Driver.cxx
+  cache_budget_ = bytes;
+  fl_image_cache_trim(NULL);
+}
+
 /**
  The constructor creates an empty image with the specified
  width, height, and depth. The width and height are in pixels.
@@ -298,6 +323,8 @@ int Fl_Image::draw_scaled(int X, int Y, int W, int H) {
 /** True after fl_register_images() was called, false before */
 bool Fl_Image::register_images_done = false;
 
+Fl_RGB_Image *(*Fl_Image::decode_image_mem)(const unsigned char *, int) = NULL;
+
 //
 // RGB image class...
 //
@@ -346,13 +373,131 @@ Fl_RGB_Image::Fl_RGB_Image(const uchar *bits, int W, int H, int D, int LD) :
   alloc_array(0),
   id_(0),
   mask_(0),
-  cache_w_(0), cache_h_(0)
+  cache_w_(0), cache_h_(0),
+  view_array_(0),
+  view_ld_(0),
+  view_order_(FL_RGB_ORDER_RGB)
 {
     data((const char **)&array, 1);
     ld(LD);
 }
 
 
+// Copy a rectangle of pixels from a caller-owned view with the given channel
+// order into FLTK's native r,g,b(,a) packing. Rows are 'ld' bytes apart in
+// the source and W*D bytes apart in the destination.
+static void fl_convert_view(uchar *dst, const uchar *src, int ld,
+                            int W, int H, int D, Fl_RGB_Order order) {
+  int ri, gi, bi, ai;
+  switch (order) {
+    case FL_RGB_ORDER_BGR:  ri = 2; gi = 1; bi = 0; ai = 3; break;
+    case FL_RGB_ORDER_ARGB: ri = 1; gi = 2; bi = 3; ai = 0; break;
+    case FL_RGB_ORDER_ABGR: ri = 3; gi = 2; bi = 1; ai = 0; break;
+    default:                ri = 0; gi = 1; bi = 2; ai = 3; break;
+  }
+  for (int y = 0; y < H; y++) {
+    const uchar *s = src + y * ld;
+    uchar *d = dst + y * W * D;
+    for (int x = 0; x < W; x++, s += D, d += D) {
+      d[0] = s[ri];
+      d[1] = s[gi];
+      d[2] = s[bi];
+      if (D == 4) d[3] = s[ai];
+    }
+  }
+}
+
+
+/**
+  The constructor creates a new image over a caller-owned pixel buffer
+  with arbitrary line stride and channel order.
+
+  This is intended for interop with producers such as video decoders
+  whose frames are not in FLTK's native r,g,b(,a) packing. \p bits points
+  at the first channel of the top-left pixel, \p LD is the distance in
+  bytes between the starts of consecutive lines (0 means \p W * \p D,
+  larger values account for row padding), and \p order describes the
+  channel order of the buffer.
+
+  If \p order is FL_RGB_ORDER_RGB the buffer is used in place, exactly as
+  with Fl_RGB_Image(const uchar*, int, int, int, int). Otherwise the
+  constructor allocates an internal array in native packing and converts
+  the buffer into it; \p order other than FL_RGB_ORDER_RGB requires
+  \p D == 3 (FL_RGB_ORDER_BGR only) or \p D == 4.
+
+  In both cases the object keeps a reference to \p bits: after the caller
+  changes pixels in the buffer, call update(int, int, int, int) with the
+  changed rectangle to make the image reflect them. The caller is
+  responsible that \p bits persists as long as the image is used.
+
+  \param[in] bits   The caller-owned pixel buffer.
+  \param[in] W      The width of the image in pixels.
+  \param[in] H      The height of the image in pixels.
+  \param[in] D      The image depth, or 'number of channels'.
+  \param[in] LD     Line stride in bytes (0 = \p W * \p D).
+  \param[in] order  The channel order of \p bits.
+
+  \see update(int, int, int, int), Fl_RGB_Order
+  \since 1.4.0
+*/
+Fl_RGB_Image::Fl_RGB_Image(const uchar *bits, int W, int H, int D, int LD, Fl_RGB_Order order) :
+  Fl_Image(W,H,D),
+  array(bits),
+  alloc_array(0),
+  id_(0),
+  mask_(0),
+  cache_w_(0), cache_h_(0),
+  view_array_(bits),
+  view_ld_(LD ? LD : W * D),
+  view_order_(order)
+{
+  if (order != FL_RGB_ORDER_RGB && D >= 3 && W > 0 && H > 0) {
+    uchar *a = new uchar[W * H * D];
+    fl_convert_view(a, view_array_, view_ld_, W, H, D, order);
+    array = a;
+    alloc_array = 1;
+    LD = 0;
+  }
+  data((const char **)&array, 1);
+  ld(LD);
+}
+
+
+/**
+  Tells the image that a rectangle of the caller-owned pixel buffer it was
+  constructed over has changed.
+
+  The rectangle is given in image pixels and is clipped to the image. If
+  the buffer's channel order is not FLTK's native packing, only the pixels
+  inside the rectangle are re-converted, so a video stream that updates a
+  few tiles per frame does not pay for swizzling the whole frame. The
+  image is then uncached so the next draw() re-uploads it.
+
+  This method does nothing for images that were not constructed over
+  caller memory.
+
+  \see Fl_RGB_Image(const uchar*, int, int, int, int, Fl_RGB_Order)
+  \since 1.4.0
+*/
+void Fl_RGB_Image::update(int X, int Y, int W, int H) {
+  if (!view_array_) return;
+  if (X < 0) { W += X; X = 0; }
+  if (Y < 0) { H += Y; Y = 0; }
+  if (X + W > data_w()) W = data_w() - X;
+  if (Y + H > data_h()) H = data_h() - Y;
+  if (W <= 0 || H <= 0) return;
+  if (view_order_ != FL_RGB_ORDER_RGB && alloc_array) {
+    int D = d();
+    for (int y = Y; y < Y + H; y++) {
+      fl_convert_view((uchar *)array + (y * data_w() + X) * D,
+                      view_array_ + y * view_ld_ + X * D, view_ld_,
+                      W, 1, D, view_order_);
+    }
+  }
+  uncache();
+}
+
+
 /**
   The constructor creates a new RGBA image from the specified Fl_Pixmap.
 
@@ -369,7 +514,10 @@ Fl_RGB_Image::Fl_RGB_Image(const Fl_Pixmap *pxm, Fl_Color bg):
   alloc_array(0),
   id_(0),
   mask_(0),
-  cache_w_(0), cache_h_(0)
+  cache_w_(0), cache_h_(0),
+  view_array_(0),
+  view_ld_(0),
+  view_order_(FL_RGB_ORDER_RGB)
 {
   if (pxm && pxm->data_w() > 0 && pxm->data_h() > 0) {
     array = new uchar[data_w() * data_h() * d()];
@@ -391,9 +539,56 @@ Fl_RGB_Image::~Fl_RGB_Image() {
 }
 
 void Fl_RGB_Image::uncache() {
+  extern void fl_forget_scaled_variants(const Fl_RGB_Image *); // in Fl_Graphics_Driver.cxx
+  extern void fl_image_cache_forget(Fl_Image *); // in Fl_Graphics_Driver.cxx
+  fl_forget_scaled_variants(this);
+  fl_image_cache_forget(this);
   Fl_Graphics_Driver::default_driver().uncache(this, id_, mask_);
 }
 
+//
+// Separable Lanczos-3 resampling for FL_RGB_SCALING_LANCZOS.
+//
+
+// The windowed-sinc kernel, non-zero for |t| < 3
+static double fl_lanczos3(double t) {
+  if (t < 0) t = -t;
+  if (t >= 3.0) return 0.0;
+  if (t < 1e-9) return 1.0;
+  double pt = M_PI * t;
+  return 3.0 * sin(pt) * sin(pt / 3.0) / (pt * pt);
+}
+
+// Compute the sample window and normalized filter weights for every
+// output position of one axis. The same weights apply to every row
+// (resp. column), so they are computed once per copy() and reused.
+// When downscaling, the kernel is widened by the scale factor so that
+// all covered source pixels contribute (area-averaging behavior).
+// Returns the number of taps; the caller delete[]s 'start' and 'weight'.
+static int fl_lanczos_weights(int src_size, int dst_size,
+                              int *&start, float *&weight) {
+  double scale  = (double)src_size / dst_size;
+  double fscale = (scale > 1.0) ? scale : 1.0;
+  double support = 3.0 * fscale;
+  int ntaps = 2 * (int)ceil(support);
+  start  = new int[dst_size];
+  weight = new float[dst_size * ntaps];
+  for (int i = 0; i < dst_size; i++) {
+    double center = (i + 0.5) * scale - 0.5;
+    int first = (int)floor(center - support) + 1;
+    start[i] = first;
+    float *wi = weight + i * ntaps;
+    double sum = 0.0;
+    for (int j = 0; j < ntaps; j++)
+      sum += (wi[j] = (float)fl_lanczos3((first + j - center) / fscale));
+    if (sum > 0.0) {
+      for (int j = 0; j < ntaps; j++)
+        wi[j] = (float)(wi[j] / sum);
+    }
+  }
+  return ntaps;
+}
+
 Fl_Image *Fl_RGB_Image::copy(int W, int H) {
   Fl_RGB_Image  *new_image;     // New RGB image
   uchar         *new_array;     // New array for image data
@@ -475,6 +670,75 @@ Fl_Image *Fl_RGB_Image::copy(int W, int H) {
         sy ++;
       }
     }
+  } else if (Fl_Image::RGB_scaling() == FL_RGB_SCALING_LANCZOS) {
+
+    // Lanczos scaling (FL_RGB_SCALING_LANCZOS): a separable two-pass
+    // resampling with precomputed per-column and per-row weights
+    int   *xstart, *ystart;     // first source sample per output position
+    float *xweight, *yweight;   // filter weights per output position
+    const int xtaps = fl_lanczos_weights(data_w(), W, xstart, xweight);
+    const int ytaps = fl_lanczos_weights(data_h(), H, ystart, yweight);
+    const int nd = d();
+    int c, t, sy;
+
+    // Horizontal pass: resample every source row to W columns, keeping
+    // the intermediate in floats (premultiplied when there is alpha)
+    float *tmp = new float[(size_t)W * data_h() * nd];
+    for (sy = 0; sy < data_h(); sy++) {
+      old_ptr = array + sy * line_d;
+      float *out = tmp + (size_t)sy * W * nd;
+      for (dx = 0; dx < W; dx++, out += nd) {
+        const float *wx = xweight + dx * xtaps;
+        for (c = 0; c < nd; c++) out[c] = 0.0f;
+        for (t = 0; t < xtaps; t++) {
+          int sx = xstart[dx] + t;
+          if (sx < 0) sx = 0;
+          else if (sx >= data_w()) sx = data_w() - 1;
+          const uchar *px = old_ptr + sx * nd;
+          const float wt = wx[t];
+          if (nd == 4) {
+            const float a = px[3] * (1.0f / 255.0f);
+            out[0] += px[0] * a * wt;
+            out[1] += px[1] * a * wt;
+            out[2] += px[2] * a * wt;
+            out[3] += px[3] * wt;
+          } else {
+            for (c = 0; c < nd; c++) out[c] += px[c] * wt;
+          }
+        }
+      }
+    }
+
+    // Vertical pass: resample the intermediate columns to H rows
+    for (dy = 0; dy < H; dy++) {
+      const float *wy = yweight + dy * ytaps;
+      new_ptr = new_array + (size_t)dy * W * nd;
+      for (dx = 0; dx < W; dx++, new_ptr += nd) {
+        float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (t = 0; t < ytaps; t++) {
+          sy = ystart[dy] + t;
+          if (sy < 0) sy = 0;
+          else if (sy >= data_h()) sy = data_h() - 1;
+          const float *px = tmp + ((size_t)sy * W + dx) * nd;
+          for (c = 0; c < nd; c++) acc[c] += px[c] * wy[t];
+        }
+        if (nd == 4 && acc[3] > 0.0f) {
+          // Undo the premultiplication...
+          const float ia = 255.0f / acc[3];
+          acc[0] *= ia; acc[1] *= ia; acc[2] *= ia;
+        }
+        for (c = 0; c < nd; c++) {
+          // The kernel overshoots near hard edges, clamp to the byte range
+          float v = acc[c];
+          new_ptr[c] = (uchar)(v <= 0.0f ? 0 : (v >= 255.0f ? 255 : (int)(v + 0.5f)));
+        }
+      }
+    }
+
+    delete[] tmp;
+    delete[] xstart; delete[] xweight;
+    delete[] ystart; delete[] yweight;
+
   } else {
     // Bilinear scaling (FL_RGB_SCALING_BILINEAR)
     const float xscale = (data_w() - 1) / (float) W;
@@ -82,6 +82,20 @@ uchar Fl_Image_Reader::read_byte() {
   }
 }
 
+// Read a block of n bytes into buf from memory or a file.
+// Returns the number of bytes read, which may be short at EOF.
+unsigned int Fl_Image_Reader::read(unsigned char *buf, unsigned int n) {
+  if (pIsFile) {
+    return (unsigned int)fread(buf, 1, n, pFile);
+  } else if (pIsData) {
+    memcpy(buf, pData, n);
+    pData += n;
+    return n;
+  } else {
+    return 0;
+  }
+}
+
 // Read a 16-bit unsigned integer, LSB-first
 unsigned short Fl_Image_Reader::read_word() {
   unsigned char b0, b1;  // Bytes from file
@@ -53,6 +53,9 @@ public:
   // Read a single byte from memory or a file
   unsigned char read_byte();
 
+  // Read a block of n bytes, returns the number of bytes read
+  unsigned int read(unsigned char *buf, unsigned int n);
+
   // Read a 16-bit unsigned integer, LSB-first
   unsigned short read_word();
 
@@ -123,6 +123,60 @@ Fl_Shared_Image* Fl_Image_Surface::highres_image()
   return s_img;
 }
 
+/** Renders a widget to an Fl_RGB_Image by tiles of bounded height.
+
+ This is equivalent to drawing \p widget into an Fl_Image_Surface of the
+ widget's size and calling image(), but the offscreen buffer never exceeds
+ \p widget->w() x \p tile_h pixels: the widget is drawn one horizontal band
+ at a time into a single reused surface and the bands are assembled into the
+ returned image. Use it to rasterize pages much taller than the screen - for
+ example when batch-rendering report pages - without creating offscreens of
+ the full page size, which are slow to allocate and may exceed platform
+ limits.
+
+ The widget must be visible(), as with Fl_Widget_Surface::draw().
+ Widgets are drawn tile by tile, so drawing code that paints outside the
+ current clip region may produce seams at tile boundaries.
+
+ \param widget the widget to rasterize
+ \param tile_h maximal pixel height of the offscreen tile; values <= 0 or
+ larger than the widget height mean render in a single tile
+ \return a new Fl_RGB_Image of the widget's size owned by the caller,
+ or NULL if \p widget has no area
+ \version 1.4.0
+ */
+Fl_RGB_Image *Fl_Image_Surface::tiled_image(Fl_Widget *widget, int tile_h) {
+  if (!widget || widget->w() <= 0 || widget->h() <= 0) return NULL;
+  int W = widget->w(), H = widget->h();
+  if (tile_h <= 0 || tile_h > H) tile_h = H;
+  Fl_Image_Surface *surf = new Fl_Image_Surface(W, tile_h);
+  uchar *data = NULL;
+  int d = 0;
+  for (int y = 0; y < H; y += tile_h) {
+    int th = (y + tile_h > H ? H - y : tile_h);
+    surf->draw(widget, 0, -y); // band y .. y+th-1 of the widget
+    Fl_RGB_Image *tile = surf->image();
+    if (!tile) {
+      delete surf;
+      delete[] data;
+      return NULL;
+    }
+    if (!data) { // sized after the first tile because depth is platform-dependent
+      d = tile->d();
+      data = new uchar[W * H * d];
+    }
+    int ld = tile->ld() ? tile->ld() : tile->data_w() * tile->d();
+    for (int j = 0; j < th; j++) {
+      memcpy(data + (y + j) * W * d, tile->array + j * ld, W * d);
+    }
+    delete tile;
+  }
+  delete surf;
+  Fl_RGB_Image *img = new Fl_RGB_Image(data, W, H, d);
+  img->alloc_array = 1;
+  return img;
+}
+
 // Allows to delete the Fl_Image_Surface object while keeping its underlying Fl_Offscreen
 Fl_Offscreen Fl_Image_Surface::get_offscreen_before_delete_() {
   Fl_Offscreen keep = platform_surface->offscreen;
@@ -214,12 +268,17 @@ void fl_delete_offscreen(Fl_Offscreen ctx) {
    \note The \p ctx argument must have been created by fl_create_offscreen().
    */
 void fl_begin_offscreen(Fl_Offscreen ctx) {
+  Fl_Image_Surface *surface = Fl_Image_Surface_Driver::surface_for_offscreen(ctx);
+  if (surface) Fl_Surface_Device::push_current(surface);
+}
+
+Fl_Image_Surface *Fl_Image_Surface_Driver::surface_for_offscreen(Fl_Offscreen ctx) {
   for (int i = 0; i < count_offscreens; i++) {
     if (offscreen_api_surface[i] && offscreen_api_surface[i]->offscreen() == ctx) {
-      Fl_Surface_Device::push_current(offscreen_api_surface[i]);
-      return;
+      return offscreen_api_surface[i];
     }
   }
+  return NULL;
 }
 
 /** Quit sending drawing commands to the current offscreen buffer.
@@ -20,6 +20,7 @@
 #include "Fl_Screen_Driver.H"
 #include <FL/fl_draw.H>
 #include <FL/fl_ask.H>
+#include <FL/Fl_Graphics_Driver.H>
 #include <math.h>
 #include <FL/fl_utf8.h>
 #include "flstring.h"
@@ -144,6 +145,95 @@ double Fl_Input_::expandpos(
 
 ////////////////////////////////////////////////////////////////
 
+// Cached pixel positions of the line last scanned by handle_mouse() or
+// up_down_position(). Mapping a byte offset to a pixel position with
+// expandpos() rescans the line from its start, so the per-character scan
+// loops in those methods were quadratic in the line length, which made
+// clicking and dragging in multi-kilobyte lines visibly slow. The cache
+// is dropped whenever the text changes (all changes go through functions
+// in this file) and is revalidated against everything else the positions
+// depend on.
+
+static const Fl_Input_* linepos_widget = 0; // widget the cache belongs to
+static const char* linepos_start;       // start of the cached line in value()
+static int linepos_len;                 // length of the cached line in bytes
+static Fl_Font linepos_font;            // font the positions were measured with
+static Fl_Fontsize linepos_size;        // size the positions were measured with
+static int linepos_type;                // input_type() of the widget
+static float linepos_scale;             // GUI scaling factor
+static double* linepos = 0;             // linepos[i]: pixel position of byte i
+static int linepos_alloc = 0;           // allocated table entries
+
+/* \internal
+  Returns a table of the pixel positions of all bytes in one line of text.
+
+  The table has one entry per byte of the line from \p p to \p e, as
+  expanded into \p buf by expand(), plus a final entry for the position
+  right after the last character: <tt>table[i]</tt> is the position that
+  expandpos(p, p+i, buf, 0) would return for every \p i on a character
+  boundary. Bytes inside a UTF-8 sequence get the position of the
+  character they belong to, so the table is always monotone.
+
+  The table is computed once per line and reused while neither the text
+  nor the way it is rendered changes, making repeated position queries
+  on the same line cheap.
+*/
+static const double* line_positions(const Fl_Input_* i, const char* p,
+                                    const char* e, const char* buf) {
+  int len = (int) (e-p);
+  float scale = Fl_Graphics_Driver::default_driver().scale();
+  if (i == linepos_widget && p == linepos_start && len == linepos_len &&
+      i->textfont() == linepos_font && i->textsize() == linepos_size &&
+      i->input_type() == linepos_type && scale == linepos_scale)
+    return linepos;
+
+  if (len+1 > linepos_alloc) {
+    linepos_alloc = len+1;
+    linepos = (double*)realloc(linepos, linepos_alloc*sizeof(double));
+  }
+
+  int n = 0;            // offset into buf, as computed by expandpos()
+  int chr = 0;          // column of the current character, for tab stops
+  double x = 0;         // pixel position of the current character
+  int j = 0;
+  linepos[0] = 0;
+  while (j < len) {
+    int c = p[j] & 255;
+    int n0 = n;
+    int cw = 1;         // bytes consumed from the source line
+    if (i->input_type() == FL_SECRET_INPUT) {
+      cw = fl_utf8len((char)c);
+      if (cw >= 1) n += l_secret; else cw = 1;
+    } else if (c < ' ' || c == 127) {
+      if (c == '\t' && i->input_type() == FL_MULTILINE_INPUT) {
+        n += 8-(chr%8);
+        chr += 7-(chr%8);
+      } else n += 2;
+      chr++;
+    } else {
+      cw = fl_utf8len((char)c);
+      if (cw >= 1) chr++; else cw = 1;
+      n += cw;
+    }
+    if (j+cw > len) cw = len-j;
+    double nx = x + fl_width(buf+n0, n-n0);
+    while (--cw > 0) linepos[++j] = x;
+    linepos[++j] = nx;
+    x = nx;
+  }
+
+  linepos_widget = i;
+  linepos_start = p;
+  linepos_len = len;
+  linepos_font = i->textfont();
+  linepos_size = i->textsize();
+  linepos_type = i->input_type();
+  linepos_scale = scale;
+  return linepos;
+}
+
+////////////////////////////////////////////////////////////////
+
 /** \internal
   Marks a range of characters for update.
 
@@ -543,13 +633,14 @@ void Fl_Input_::handle_mouse(int X, int Y, int /*W*/, int /*H*/, int drag) {
     if (e >= value_+size_) break;
     p = e+1;
   }
+  const double *pos = line_positions(this, p, e, buf);
   const char *l, *r, *t; double f0 = Fl::event_x()-X+xscroll_;
   for (l = p, r = e; l<r; ) {
     double f;
     int cw = fl_utf8len((char)l[0]);
     if (cw < 1) cw = 1;
     t = l+cw;
-    f = X-xscroll_+expandpos(p, t, buf, 0);
+    f = X-xscroll_+pos[t-p];
     if (f <= Fl::event_x()) {l = t; f0 = Fl::event_x()-f;}
     else r = t-cw;
   }
@@ -557,7 +648,7 @@ void Fl_Input_::handle_mouse(int X, int Y, int /*W*/, int /*H*/, int drag) {
     double f1;
     int cw = fl_utf8len((char)l[0]);
     if (cw > 0) {
-      f1 = X-xscroll_+expandpos(p, l + cw, buf, 0) - Fl::event_x();
+      f1 = X-xscroll_+pos[l+cw-p] - Fl::event_x();
       if (f1 < f0) l = l+cw;
     }
   }
@@ -682,10 +773,11 @@ int Fl_Input_::up_down_position(int i, int keepmark) {
   char buf[MAXBUF];
   const char* p = value()+i;
   const char* e = expand(p, buf);
+  const double *pos = line_positions(this, p, e, buf);
   const char *l, *r, *t;
   for (l = p, r = e; l<r; ) {
     t = l+(r-l+1)/2;
-    int f = (int)expandpos(p, t, buf, 0);
+    int f = (int)pos[t-p];
     if (f <= up_down_pos) l = t; else r = t-1;
   }
   int j = (int) (l-value());
@@ -855,6 +947,8 @@ int Fl_Input_::replace(int b, int e, const char* text, int ilen) {
   }
   ilen = nlen;
 
+  if (linepos_widget == this) linepos_widget = 0; // text changes below
+
   put_in_buffer(size_+ilen);
 
   if (e>b) {
@@ -943,6 +1037,8 @@ int Fl_Input_::undo() {
   int b = undoat-xlen;
   int b1 = b;
 
+  if (linepos_widget == this) linepos_widget = 0; // text changes below
+
   put_in_buffer(size_+ilen);
 
   if (ilen) {
@@ -1216,6 +1312,7 @@ void Fl_Input_::put_in_buffer(int len) {
 int Fl_Input_::static_value(const char* str, int len) {
   clear_changed();
   if (undowidget == this) undowidget = 0;
+  if (linepos_widget == this) linepos_widget = 0;
   if (str == value_ && len == size_) return 0;
   if (len) { // non-empty new value:
     if (xscroll_ || yscroll_) {
@@ -1317,6 +1414,7 @@ void Fl_Input_::resize(int X, int Y, int W, int H) {
 */
 Fl_Input_::~Fl_Input_() {
   if (undowidget == this) undowidget = 0;
+  if (linepos_widget == this) linepos_widget = 0;
   if (bufsize) free((void*)buffer);
 }
 
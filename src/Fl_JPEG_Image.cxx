@@ -30,6 +30,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <setjmp.h>
 
 
@@ -99,6 +100,9 @@ extern "C" {
 Fl_JPEG_Image::Fl_JPEG_Image(const char *filename)
 : Fl_RGB_Image(0,0,0)
 {
+  decode_state_   = 0;
+  decode_cb_      = 0;
+  decode_cb_data_ = 0;
   load_jpg_(filename, 0L, 0L);
 }
 
@@ -128,9 +132,86 @@ Fl_JPEG_Image::Fl_JPEG_Image(const char *filename)
 Fl_JPEG_Image::Fl_JPEG_Image(const char *name, const unsigned char *data)
 : Fl_RGB_Image(0,0,0)
 {
+  decode_state_   = 0;
+  decode_cb_      = 0;
+  decode_cb_data_ = 0;
   load_jpg_(0L, name, data);
 }
 
+/**
+ \brief The constructor prepares a JPEG image for incremental decoding.
+
+ Only the JPEG header is read here, so construction is cheap: w(), h()
+ and d() are available immediately, while the pixels are decoded later
+ in scanline bands. Rows not yet decoded are black.
+
+ If \p cb is non-NULL, the decode is driven automatically in small
+ slices from an Fl::add_idle() handler, and \p cb is invoked after each
+ slice with the number of scanlines decoded so far; decoding is complete
+ when that count reaches h(). A typical callback redraws the widget
+ showing the image, so it refines progressively without ever blocking
+ the UI. If \p cb is NULL, the caller drives the decode instead by
+ calling decode_more() as rows are needed.
+
+ Use Fl_Image::fail() to check if the image failed to load, both after
+ construction and after the decode completes.
+
+ \param[in] filename a full path and name pointing to a valid jpeg file.
+ \param[in] cb       progress callback, or NULL to decode on demand
+ \param[in] cbdata   user data passed to the callback
+
+ \see decode_more(), decode_done()
+ \version 1.4.0
+ */
+Fl_JPEG_Image::Fl_JPEG_Image(const char *filename, Decode_Callback *cb, void *cbdata)
+: Fl_RGB_Image(0,0,0)
+{
+  decode_state_   = 0;
+  decode_cb_      = cb;
+  decode_cb_data_ = cbdata;
+  open_jpg_incremental_(filename);
+#ifdef HAVE_LIBJPEG
+  if (decode_state_ && decode_cb_)
+    Fl::add_idle(decode_idle_cb_, this);
+#endif // HAVE_LIBJPEG
+}
+
+/**
+ \brief The constructor loads the JPEG image at a reduced size.
+
+ \p maxsize is a size hint in pixels: the decoder picks the largest of
+ the 1/2, 1/4 and 1/8 reduced-size decodes libjpeg offers whose larger
+ dimension is still at least \p maxsize, so a subsequent
+ Fl_Image::copy(W, H) to the final size never upscales. Decoding a
+ thumbnail this way takes a fraction of the time and memory of decoding
+ at full resolution and shrinking afterwards. If \p maxsize is not
+ smaller than the image, the file is decoded at full resolution.
+
+ Use Fl_Image::fail() to check if Fl_JPEG_Image failed to load, as with
+ Fl_JPEG_Image(const char *filename).
+
+ \param[in] filename a full path and name pointing to a valid jpeg file.
+ \param[in] maxsize  decode at no less than this size, in pixels
+
+ \version 1.4.0
+ */
+Fl_JPEG_Image::Fl_JPEG_Image(const char *filename, int maxsize)
+: Fl_RGB_Image(0,0,0)
+{
+  decode_state_   = 0;
+  decode_cb_      = 0;
+  decode_cb_data_ = 0;
+  load_jpg_(filename, 0L, 0L, maxsize);
+}
+
+/**
+ The destructor discards any still pending incremental decode
+ along with all memory and server resources used by the image.
+ */
+Fl_JPEG_Image::~Fl_JPEG_Image() {
+  abort_decode_();
+}
+
 
 // data source manager for reading jpegs from memory
 // init_source (j_decompress_ptr cinfo)
@@ -208,8 +289,11 @@ static void jpeg_mem_src(j_decompress_ptr cinfo, const unsigned char *data)
  To avoid code duplication, we set filename if we want to read form a file or
  data to read from memory instead. Sharename can be set if the image is
  supposed to be added to teh Fl_Shared_Image list.
+ A positive maxsize is a size hint selecting one of libjpeg's reduced-size
+ decodes (see Fl_JPEG_Image(const char*, int)).
  */
-void Fl_JPEG_Image::load_jpg_(const char *filename, const char *sharename, const unsigned char *data)
+void Fl_JPEG_Image::load_jpg_(const char *filename, const char *sharename, const unsigned char *data,
+                              int maxsize)
 {
 #ifdef HAVE_LIBJPEG
   FILE                   *fp = 0L;  // File pointer
@@ -297,6 +381,19 @@ void Fl_JPEG_Image::load_jpg_(const char *filename, const char *sharename, const
   dinfo.out_color_components = 3;
   dinfo.output_components    = 3;
 
+  // Scale on load: when a size hint says full resolution is not needed,
+  // pick the largest reduced-size decode (1/2, 1/4 or 1/8) whose larger
+  // dimension still covers the hint.
+  if (maxsize > 0) {
+    JDIMENSION big = (dinfo.image_width > dinfo.image_height) ?
+                     dinfo.image_width : dinfo.image_height;
+    dinfo.scale_num   = 1;
+    dinfo.scale_denom = 1;
+    while (dinfo.scale_denom < 8 &&
+           big / (dinfo.scale_denom * 2) >= (JDIMENSION)maxsize)
+      dinfo.scale_denom *= 2;
+  }
+
   jpeg_calc_output_dimensions(&dinfo);
 
   w(dinfo.output_width);
@@ -331,3 +428,220 @@ void Fl_JPEG_Image::load_jpg_(const char *filename, const char *sharename, const
   }
 #endif // HAVE_LIBJPEG
 }
+
+
+//
+// Incremental decoding...
+//
+
+// Scanlines decoded per idle slice when a decode callback drives the decode.
+#define DECODE_CHUNK_LINES 64
+
+#ifdef HAVE_LIBJPEG
+// Persistent state of an incremental decode, alive between
+// open_jpg_incremental_() and the last decode_more() call.
+struct Fl_JPEG_Image::Decode_State {
+  jpeg_decompress_struct  dinfo;        // Decompressor info
+  fl_jpeg_error_mgr       jerr;         // Error handler info
+  FILE                   *fp;           // File being decoded
+  int                     max_destroy_err; // cleanup error counters, see load_jpg_()
+  int                     max_finish_err;
+};
+#endif // HAVE_LIBJPEG
+
+
+/*
+ Reads the JPEG header from 'filename' and prepares the decompressor,
+ leaving it in decode_state_ for decode_more() to consume. The pixel
+ array is allocated here (initially black), so the image can be drawn
+ while it decodes.
+ */
+void Fl_JPEG_Image::open_jpg_incremental_(const char *filename) {
+#ifdef HAVE_LIBJPEG
+  // Clear data...
+  alloc_array = 0;
+  array = (uchar *)0;
+
+  FILE *fp = fl_fopen(filename, "rb");
+  if (fp == NULL) {
+    ld(ERR_FILE_ACCESS);
+    return;
+  }
+
+  Decode_State *ds = new Decode_State;
+  ds->fp = fp;
+  ds->max_destroy_err = 10;     // count errors and give up after a while
+  ds->max_finish_err  = 10;     // to avoid recursion and deadlock
+
+  // Setup the decompressor info and read the header...
+  ds->dinfo.err                = jpeg_std_error((jpeg_error_mgr *)&ds->jerr);
+  ds->jerr.pub_.error_exit     = fl_jpeg_error_handler;
+  ds->jerr.pub_.output_message = fl_jpeg_output_handler;
+
+  if (setjmp(ds->jerr.errhand_))
+  {
+    // JPEG error handling...
+    //    Cleanup routines may hit further errors and longjmp back here,
+    //    so the decompressor teardown is counter-limited (see load_jpg_()).
+    //
+    Fl::warning("JPEG file \"%s\" is too large or contains errors!\n", filename);
+    if (ds->max_destroy_err-- > 0)
+      jpeg_destroy_decompress(&ds->dinfo);
+
+    if (ds->fp) {
+      fclose(ds->fp);
+      ds->fp = 0;
+    }
+
+    w(0);
+    h(0);
+    d(0);
+
+    if (array) {
+      delete[] (uchar *)array;
+      array = 0;
+      alloc_array = 0;
+    }
+
+    delete ds;
+
+    ld(ERR_FORMAT);
+    return;
+  }
+
+  jpeg_create_decompress(&ds->dinfo);
+  jpeg_stdio_src(&ds->dinfo, fp);
+  jpeg_read_header(&ds->dinfo, TRUE);
+
+  ds->dinfo.quantize_colors      = (boolean)FALSE;
+  ds->dinfo.out_color_space      = JCS_RGB;
+  ds->dinfo.out_color_components = 3;
+  ds->dinfo.output_components    = 3;
+
+  jpeg_calc_output_dimensions(&ds->dinfo);
+
+  w(ds->dinfo.output_width);
+  h(ds->dinfo.output_height);
+  d(ds->dinfo.output_components);
+
+  if (((size_t)w()) * h() * d() > max_size() ) longjmp(ds->jerr.errhand_, 1);
+  array = new uchar[w() * h() * d()];
+  alloc_array = 1;
+  memset((uchar *)array, 0, (size_t)w() * h() * d());
+
+  jpeg_start_decompress(&ds->dinfo);
+
+  decode_state_ = ds;
+#else
+  (void)filename;
+#endif // HAVE_LIBJPEG
+}
+
+
+/**
+ Decodes up to \p scanlines more rows of an incrementally loading image.
+
+ Does nothing unless the image was constructed with the incremental
+ constructor and rows are still pending. Rows decode from the top down
+ into the image's pixel array, and the drawing cache is discarded so
+ the decoded rows appear on the next redraw. Once the last row has
+ been decoded, the decoder state is released and decode_done() returns
+ non-zero.
+
+ If a decode callback was given, this is called automatically from an
+ idle handler and apps don't need to call it themselves.
+
+ \param[in] scanlines maximum number of rows to decode on this call.
+ \returns the number of rows still to be decoded; 0 when complete (or failed).
+ \see Fl_JPEG_Image(const char*, Decode_Callback*, void*), decode_done()
+ \version 1.4.0
+ */
+int Fl_JPEG_Image::decode_more(int scanlines) {
+#ifdef HAVE_LIBJPEG
+  Decode_State *ds = decode_state_;
+  JSAMPROW row;
+  if (!ds) return 0;
+
+  if (setjmp(ds->jerr.errhand_))
+  {
+    // JPEG error handling... (see open_jpg_incremental_())
+    Fl::warning("JPEG file is too large or contains errors!\n");
+    if (ds->max_destroy_err-- > 0)
+      jpeg_destroy_decompress(&ds->dinfo);
+
+    if (ds->fp) {
+      fclose(ds->fp);
+      ds->fp = 0;
+    }
+
+    w(0);
+    h(0);
+    d(0);
+
+    if (array) {
+      delete[] (uchar *)array;
+      array = 0;
+      alloc_array = 0;
+    }
+
+    delete ds;
+    decode_state_ = 0;
+
+    ld(ERR_FORMAT);
+    return 0;
+  }
+
+  while (scanlines-- > 0 && ds->dinfo.output_scanline < ds->dinfo.output_height) {
+    row = (JSAMPROW)(array +
+                     ds->dinfo.output_scanline * ds->dinfo.output_width *
+                     ds->dinfo.output_components);
+    jpeg_read_scanlines(&ds->dinfo, &row, (JDIMENSION)1);
+  }
+  int remaining = (int)(ds->dinfo.output_height - ds->dinfo.output_scanline);
+
+  uncache();            // redraws must not reuse the stale offscreen cache
+
+  if (remaining == 0) {
+    if (ds->max_finish_err-- > 0)
+      jpeg_finish_decompress(&ds->dinfo);
+    jpeg_destroy_decompress(&ds->dinfo);
+    fclose(ds->fp);
+    ds->fp = 0;
+    delete ds;
+    decode_state_ = 0;
+  }
+  return remaining;
+#else
+  (void)scanlines;
+  return 0;
+#endif // HAVE_LIBJPEG
+}
+
+
+// Discard a pending incremental decode and its decoder state.
+void Fl_JPEG_Image::abort_decode_() {
+#ifdef HAVE_LIBJPEG
+  if (!decode_state_) return;
+  Fl::remove_idle(decode_idle_cb_, this);
+  Decode_State *ds = decode_state_;
+  decode_state_ = 0;
+  if (setjmp(ds->jerr.errhand_) == 0)
+    jpeg_destroy_decompress(&ds->dinfo);
+  if (ds->fp)
+    fclose(ds->fp);
+  delete ds;
+#endif // HAVE_LIBJPEG
+}
+
+
+// Idle handler driving automatic incremental decodes.
+//    Decodes a slice, then reports progress to the decode callback;
+//    removes itself once nothing is left to decode.
+void Fl_JPEG_Image::decode_idle_cb_(void *data) {
+  Fl_JPEG_Image *img = (Fl_JPEG_Image*)data;
+  int remaining = img->decode_more(DECODE_CHUNK_LINES);
+  if (remaining == 0)
+    Fl::remove_idle(decode_idle_cb_, data);
+  if (img->decode_cb_)
+    img->decode_cb_(img, img->h() - remaining, img->decode_cb_data_);
+}
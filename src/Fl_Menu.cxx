@@ -25,7 +25,9 @@
 #include <FL/Fl_Menu_Window.H>
 #include <FL/Fl_Menu_.H>
 #include <FL/fl_draw.H>
+#include <FL/Fl_Graphics_Driver.H>
 #include <stdio.h>
+#include <stdlib.h>
 #include "flstring.h"
 
 /** Size of the menu starting from this menu item.
@@ -124,6 +126,8 @@ public:
   menutitle* title;
   int handle(int);
   int itemheight;       // zero == menubar
+  int *title_xx;        // menubar title x extents, built lazily
+  int ntitles;
   int numitems;
   int selected;
   int drawn_selected;   // last redraw has this selected
@@ -135,6 +139,7 @@ public:
   ~menuwindow();
   void set_selected(int);
   int find_selected(int mx, int my);
+  void layout_titles();
   int titlex(int);
   void autoscroll(int);
   void position(int x, int y);
@@ -143,6 +148,34 @@ public:
 
 extern char fl_draw_shortcut;
 
+/* Measuring a label costs enough that re-measuring every item each time
+ a large menu pops up (or a menubar lays out) is noticeable. Since menu
+ items cannot hold extra data - they are plain structs, often statically
+ initialized - the last measurement of each item is remembered in a
+ small direct-mapped cache on the side. An entry is only used when
+ everything the measurement depends on still matches, including a hash
+ of the label text, so relabeled or restyled items simply re-measure. */
+struct menu_measure_entry {
+  const Fl_Menu_Item *item; // NULL for an empty slot
+  unsigned hash;            // hash of the label text
+  Fl_Font font;
+  Fl_Fontsize size;
+  uchar type;               // labeltype_
+  float scale;              // GUI scaling factor
+  int w, h;                 // measured label size
+};
+// must be a power of two; slots are assigned consecutively for the
+// consecutive items of a menu array, so one menu with up to this many
+// items caches without collisions
+#define MENU_MEASURE_SLOTS 2048
+static menu_measure_entry *menu_measure_cache = 0;
+
+static unsigned menu_measure_hash(const char *text) {
+  unsigned h = 2166136261u; // FNV-1a
+  while (*text) {h ^= (unsigned char)*text++; h *= 16777619u;}
+  return h;
+}
+
 /**
   Measures width of label, including effect of & characters.
   Optionally, can get height if hp is not NULL.
@@ -156,10 +189,32 @@ int Fl_Menu_Item::measure(int* hp, const Fl_Menu_* m) const {
   l.font    = labelsize_ || labelfont_ ? labelfont_ : (m ? m->textfont() : FL_HELVETICA);
   l.size    = labelsize_ ? labelsize_ : m ? m->textsize() : FL_NORMAL_SIZE;
   l.color   = FL_FOREGROUND_COLOR; // this makes no difference?
+  l.layout  = 0;
+  menu_measure_entry *e = 0;
+  unsigned hash = 0;
+  float scale = Fl_Graphics_Driver::default_driver().scale();
+  if (text) {
+    if (!menu_measure_cache)
+      menu_measure_cache = (menu_measure_entry*)calloc(MENU_MEASURE_SLOTS, sizeof(menu_measure_entry));
+    hash = menu_measure_hash(text);
+    e = &menu_measure_cache[((size_t)this / sizeof(Fl_Menu_Item)) & (MENU_MEASURE_SLOTS - 1)];
+    if (e->item == this && e->hash == hash && e->font == l.font &&
+        e->size == l.size && e->type == labeltype_ && e->scale == scale) {
+      if (hp) *hp = e->h;
+      int w = e->w;
+      if (flags & (FL_MENU_TOGGLE|FL_MENU_RADIO)) w += FL_NORMAL_SIZE;
+      return w;
+    }
+  }
   fl_draw_shortcut = 1;
   int w = 0; int h = 0;
   l.measure(w, hp ? *hp : h);
   fl_draw_shortcut = 0;
+  if (e) {
+    e->item = this; e->hash = hash; e->font = l.font; e->size = l.size;
+    e->type = labeltype_; e->scale = scale;
+    e->w = w; e->h = hp ? *hp : h;
+  }
   if (flags & (FL_MENU_TOGGLE|FL_MENU_RADIO)) w += FL_NORMAL_SIZE;
   return w;
 }
@@ -175,6 +230,7 @@ void Fl_Menu_Item::draw(int x, int y, int w, int h, const Fl_Menu_* m,
   l.font    = labelsize_ || labelfont_ ? labelfont_ : (m ? m->textfont() : FL_HELVETICA);
   l.size    = labelsize_ ? labelsize_ : m ? m->textsize() : FL_NORMAL_SIZE;
   l.color   = labelcolor_ ? labelcolor_ : m ? m->textcolor() : int(FL_FOREGROUND_COLOR);
+  l.layout  = 0;
   if (!active()) l.color = fl_inactive((Fl_Color)l.color);
   Fl_Color color = m ? m->color() : FL_GRAY;
   if (selected) {
@@ -304,6 +360,8 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
   menu = m;
   if (m) m = m->first(); // find the first item that needs to be rendered
   drawn_selected = -1;
+  title_xx = 0;
+  ntitles = 0;
   if (button) {
     box(button->box());
     if (box() == FL_NO_BOX || box() == FL_FLAT_BOX) box(FL_UP_BOX);
@@ -346,18 +404,24 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
     if (w1 > W) W = w1;
     // calculate the maximum width of all shortcuts
     if (m->shortcut_) {
+      // measure with the same font drawentry() will use for the shortcut
+      Fl_Font f = m->labelsize_ || m->labelfont_ ? (Fl_Font)m->labelfont_ :
+                      button ? button->textfont() : FL_HELVETICA;
+      Fl_Measure_Context mc = fl_graphics_driver->begin_measure(f,
+                      m->labelsize_ ? m->labelsize_ :
+                      button ? button->textsize() : FL_NORMAL_SIZE);
       // s is a pointer to the UTF-8 string for the entire shortcut
       // k points only to the key part (minus the modifier keys)
       const char *k, *s = fl_shortcut_label(m->shortcut_, &k);
       if (fl_utf_nb_char((const unsigned char*)k, (int) strlen(k))<=4) {
         // a regular shortcut has a right-justified modifier followed by a left-justified key
-        w1 = int(fl_width(s, (int) (k-s)));
+        w1 = int(mc.width(s, (int) (k-s)));
         if (w1 > hotModsw) hotModsw = w1;
-        w1 = int(fl_width(k))+4;
+        w1 = int(mc.width(k))+4;
         if (w1 > hotKeysw) hotKeysw = w1;
       } else {
         // a shortcut with a long modifier is right-justified to the menu
-        w1 = int(fl_width(s))+4;
+        w1 = int(mc.width(s))+4;
         if (w1 > (hotModsw+hotKeysw)) {
           hotModsw = w1-hotKeysw;
         }
@@ -427,6 +491,7 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
 menuwindow::~menuwindow() {
   hide();
   delete title;
+  delete[] title_xx;
 }
 
 void menuwindow::position(int X, int Y) {
@@ -513,8 +578,31 @@ void menuwindow::draw() {
   if (damage() != FL_DAMAGE_CHILD) {    // complete redraw
     fl_draw_box(box(), 0, 0, w(), h(), button ? button->color() : color());
     if (menu) {
+      // A menu taller than the screen keeps its full height and scrolls
+      // by moving the window, so most rows lie outside both the damaged
+      // region and the desktop. Skip them instead of issuing thousands
+      // of draw calls the server would clip anyway.
+      int cx, cy, cw, ch;
+      fl_clip_box(0, 0, w(), h(), cx, cy, cw, ch);
+      int y0 = cy, y1 = cy+ch;
+      if (h() > Fl::h()) {
+        int dy0 = 0, dy1 = 0; // desktop bounds over all screens
+        for (int i = 0; i < Fl::screen_count(); i++) {
+          int sx, sy, sw, sh;
+          Fl::screen_xywh(sx, sy, sw, sh, i);
+          if (!i || sy < dy0) dy0 = sy;
+          if (!i || sy+sh > dy1) dy1 = sy+sh;
+        }
+        if (dy0-y() > y0) y0 = dy0-y();
+        if (dy1-y() < y1) y1 = dy1-y();
+      }
+      int BW = Fl::box_dx(box());
       const Fl_Menu_Item* m; int j;
-      for (m=menu->first(), j=0; m->text; j++, m = m->next()) drawentry(m, j, 0);
+      for (m=menu->first(), j=0; m->text; j++, m = m->next()) {
+        int yy = BW+1+j*itemheight;
+        if (yy > y1) break;
+        if (yy+itemheight >= y0) drawentry(m, j, 0);
+      }
     }
   } else {
     if (damage() & FL_DAMAGE_CHILD && selected!=drawn_selected) { // change selection
@@ -537,14 +625,15 @@ int menuwindow::find_selected(int mx, int my) {
   my -= y();
   if (my < 0 || my >= h()) return -1;
   if (!itemheight) { // menubar
-    int xx = 3; int n = 0;
-    const Fl_Menu_Item* m = menu->first();
-    for (; ; m = m->next(), n++) {
-      if (!m->text) return -1;
-      xx += m->measure(0, button) + 16;
-      if (xx > mx) break;
+    if (!title_xx) layout_titles();
+    if (!ntitles || mx >= title_xx[ntitles]) return -1;
+    // bisect for the first title whose right edge is past the pointer
+    int a = 0, b = ntitles;
+    while (a < b) {
+      int n = (a+b)/2;
+      if (title_xx[n+1] > mx) b = n; else a = n+1;
     }
-    return n;
+    return a;
   }
   if (mx < Fl::box_dx(box()) || mx >= w()) return -1;
   int n = (my-Fl::box_dx(box())-1)/itemheight;
@@ -552,12 +641,26 @@ int menuwindow::find_selected(int mx, int my) {
   return n;
 }
 
+// Measure the x extents of the menubar titles once. The layout stays
+// fixed while the menu system is posted, so hover tracking and title
+// positioning need not re-measure every title on each motion event.
+void menuwindow::layout_titles() {
+  const Fl_Menu_Item* m;
+  ntitles = 0;
+  for (m = menu->first(); m->text; m = m->next()) ntitles++;
+  title_xx = new int[ntitles+1];
+  int xx = 3; int n = 0;
+  for (m = menu->first(); m->text; m = m->next()) {
+    title_xx[n++] = xx;
+    xx += m->measure(0, button) + 16;
+  }
+  title_xx[n] = xx;
+}
+
 // return horizontal position for item n in a menubar:
 int menuwindow::titlex(int n) {
-  const Fl_Menu_Item* m;
-  int xx = 3;
-  for (m=menu->first(); n--; m = m->next()) xx += m->measure(0, button) + 16;
-  return xx;
+  if (!title_xx) layout_titles();
+  return title_xx[n];
 }
 
 // return 1, if the given root coordinates are inside the window
@@ -1081,10 +1184,13 @@ const Fl_Menu_Item* Fl_Menu_Item::popup(
 */
 const Fl_Menu_Item* Fl_Menu_Item::find_shortcut(int* ip, const bool require_alt) const {
   const Fl_Menu_Item* m = this;
+  // the &x label test can only succeed when the Alt requirement is met,
+  // so check it once instead of for every item
+  const bool test_labels = !require_alt || Fl::event_state(FL_ALT);
   if (m) for (int ii = 0; m->text; m = next_visible_or_not(m), ii++) {
     if (m->active()) {
-      if (Fl::test_shortcut(m->shortcut_)
-         || Fl_Widget::test_shortcut(m->text, require_alt)) {
+      if ((m->shortcut_ && Fl::test_shortcut(m->shortcut_))
+         || (test_labels && Fl_Widget::test_shortcut(m->text, require_alt))) {
         if (ip) *ip=ii;
         return m;
       }
@@ -1108,8 +1214,9 @@ const Fl_Menu_Item* Fl_Menu_Item::test_shortcut() const {
   const Fl_Menu_Item* ret = 0;
   if (m) for (; m->text; m = next_visible_or_not(m)) {
     if (m->active()) {
-      // return immediately any match of an item in top level menu:
-      if (Fl::test_shortcut(m->shortcut_)) return m;
+      // return immediately any match of an item in top level menu;
+      // most items carry no shortcut at all, so test that first:
+      if (m->shortcut_ && Fl::test_shortcut(m->shortcut_)) return m;
       // if (Fl_Widget::test_shortcut(m->text)) return m;
       // only return matches from lower menu if nothing found in top menu:
       if (!ret && m->submenu()) {
@@ -362,15 +362,9 @@ int Fl_Menu_::add(const char *label,int shortcut,Fl_Callback *callback,void *use
   \see                add()
 */
 
-int Fl_Menu_::insert(
-  int index,
-  const char *label,
-  int shortcut,
-  Fl_Callback *callback,
-  void *userdata,
-  int flags
-) {
-  // make this widget own the local array:
+// Make this widget own the local array, so that add()/insert() can
+// grow it in place:
+void Fl_Menu_::own_local_array_() {
   if (this != fl_menu_array_owner) {
     if (fl_menu_array_owner) {
       fl_menu_array_owner->menu_end();
@@ -397,6 +391,17 @@ int Fl_Menu_::insert(
     }
     fl_menu_array_owner = this;
   }
+}
+
+int Fl_Menu_::insert(
+  int index,
+  const char *label,
+  int shortcut,
+  Fl_Callback *callback,
+  void *userdata,
+  int flags
+) {
+  own_local_array_();
   int r = menu_->insert(index,label,shortcut,callback,userdata,flags);
   // if it rellocated array we must fix the pointer:
   int value_offset = (int) (value_-menu_);
@@ -407,6 +412,79 @@ int Fl_Menu_::insert(
 
 
 
+/**
+  Appends a new menu item to the top level of the menu in constant time.
+
+  This behaves like add(), except that no search for an already existing
+  item with the same label is done, and no menu pathname splitting takes
+  place: the new item is always placed at the end of the top level of
+  the menu. This makes building very large menus (e.g. thousands of
+  generated entries) take time proportional to the number of items,
+  where repeated add() calls would re-scan the whole menu for each new
+  item.
+
+  The caller is responsible for not appending an item with the label of
+  an existing one; add() would replace such an item, append() creates a
+  duplicate. If \p label contains an unescaped '/' or \p flags contains
+  \c FL_SUBMENU, this method falls back to add(), as submenus require
+  the search.
+
+  \param[in] label    The text label for the menu item; the special
+                      characters described in add() apply.
+  \param[in] shortcut Optional keyboard shortcut; default 0 for none.
+  \param[in] callback Optional callback invoked when the user clicks the
+                      item; default 0 for none.
+  \param[in] userdata Optional user data passed as an argument to the
+                      callback; default 0.
+  \param[in] flags    Optional flags controlling the type of the menu
+                      item, see add(); default 0.
+  \returns            The index into the menu() array, where the entry
+                      was added.
+
+  \since 1.4.0
+
+  \see add()
+*/
+int Fl_Menu_::append(const char *label, int shortcut, Fl_Callback *callback, void *userdata, int flags) {
+  const char *p;
+  const char *item;
+  int flags1 = 0;
+  char buf[1024];
+  char *q;
+
+  // submenu titles and menu pathnames require the searches done by add(),
+  // only plain item labels can take the fast path:
+  if (flags & FL_SUBMENU) return add(label, shortcut, callback, userdata, flags);
+  if (*label == '/') { // leading slash makes us assume it is a filename
+    item = label;
+  } else {
+    for (p = label; *p; p++) {
+      if (*p == '\\' && p[1]) {p++; continue;}
+      if (*p == '/') return add(label, shortcut, callback, userdata, flags);
+    }
+    // leading underscore causes divider line:
+    if (*label == '_') {label++; flags1 = FL_MENU_DIVIDER;}
+    // copy to buf, changing \x to x:
+    q = buf;
+    for (p = label; *p; *q++ = *p++) if (*p == '\\' && p[1]) p++;
+    *q = 0;
+    item = buf;
+  }
+
+  own_local_array_();
+  int value_offset = (int)(value_ - menu_);
+  int n = local_array_size - 1; // insert before the terminating item
+  menu_ = local_array = array_insert(local_array, local_array_size, n, item, flags|flags1);
+  local_array_size++;
+  Fl_Menu_Item *m = local_array + n;
+  m->shortcut_ = shortcut;
+  m->callback_ = callback;
+  m->user_data_ = userdata;
+  if (value_) value_ = menu_ + value_offset;
+  return n;
+}
+
+
 /**
   This is a Forms (and SGI GL library) compatible add function, it
   adds many menu items, with '|' separating the menu items, and tab
@@ -21,15 +21,47 @@
 #include <FL/Fl_Widget.H>
 #include <FL/Fl_Menu_Item.H>
 #include <FL/Fl_Multi_Label.H>
+#include <FL/Fl_Image_Surface.H>
+#include <FL/fl_draw.H>
 
-static void multi_labeltype(
-    const Fl_Label* o, int x, int y, int w, int h, Fl_Align a)
-{
-  Fl_Multi_Label* b = (Fl_Multi_Label*)(o->value);
+// Fills the extent cache for both sub-labels if the current contents
+// were measured for different label fields, font attributes or wrap
+// width 'win'. Measuring means walking both sub-labels - and chained
+// Fl_Multi_Labels recursively - so repeated repaints of unchanged
+// composites shouldn't pay for it.
+static void multi_measure_parts(Fl_Multi_Label *b, const Fl_Label *o, int win) {
+  if (b->cache_valid &&
+      b->cache_la == b->labela && b->cache_lb == b->labelb &&
+      b->cache_ta == b->typea && b->cache_tb == b->typeb &&
+      b->cache_font == o->font && b->cache_size == o->size &&
+      b->cache_win == win) return;
+  Fl_Label local = *o;
+  local.value = b->labela;
+  local.type = b->typea;
+  int W = win; int H = 0;
+  local.measure(W, H);
+  b->cache_wa = W; b->cache_ha = H;
+  local.value = b->labelb;
+  local.type = b->typeb;
+  W = 0; H = 0;
+  local.measure(W, H);
+  b->cache_wb = W; b->cache_hb = H;
+  b->cache_la = b->labela; b->cache_lb = b->labelb;
+  b->cache_ta = b->typea; b->cache_tb = b->typeb;
+  b->cache_font = o->font; b->cache_size = o->size;
+  b->cache_win = win;
+  b->cache_valid = 1;
+}
+
+// Draws both sub-labels directly; shared by the on-screen path and by
+// the offscreen pre-rendering below.
+static void multi_draw(Fl_Multi_Label *b, const Fl_Label *o,
+                       int x, int y, int w, int h, Fl_Align a) {
+  multi_measure_parts(b, o, w);
+  int W = b->cache_wa; int H = b->cache_ha;
   Fl_Label local = *o;
   local.value = b->labela;
   local.type = b->typea;
-  int W = w; int H = h; local.measure(W, H);
   local.draw(x,y,w,h,a);
   if (a & FL_ALIGN_BOTTOM) h -= H;
   else if (a & FL_ALIGN_TOP) {y += H; h -= H;}
@@ -41,17 +73,47 @@ static void multi_labeltype(
   local.draw(x,y,w,h,a);
 }
 
+// Blits the composite from its cached offscreen, rebuilding the
+// offscreen first when the label or its attributes changed. Returns 0
+// when pre-rendering cannot be used for this call.
+static int multi_render(Fl_Multi_Label *b, const Fl_Label *o,
+                        int x, int y, int w, int h, Fl_Align a) {
+  if (w <= 0 || h <= 0) return 0;
+  if (!b->render_surf_ || b->render_w != w || b->render_h != h ||
+      b->render_align != a || b->render_color != o->color ||
+      !b->cache_valid || b->cache_win != w ||
+      b->cache_la != b->labela || b->cache_lb != b->labelb ||
+      b->cache_ta != b->typea || b->cache_tb != b->typeb ||
+      b->cache_font != o->font || b->cache_size != o->size) {
+    delete b->render_surf_;
+    b->render_surf_ = new Fl_Image_Surface(w, h);
+    Fl_Surface_Device::push_current(b->render_surf_);
+    fl_color(b->render_bg_);
+    fl_rectf(0, 0, w, h);
+    multi_draw(b, o, 0, 0, w, h, a);
+    Fl_Surface_Device::pop_current();
+    b->render_w = w; b->render_h = h;
+    b->render_align = a;
+    b->render_color = o->color;
+  }
+  fl_copy_offscreen(x, y, w, h, b->render_surf_->offscreen(), 0, 0);
+  return 1;
+}
+
+static void multi_labeltype(
+    const Fl_Label* o, int x, int y, int w, int h, Fl_Align a)
+{
+  Fl_Multi_Label* b = (Fl_Multi_Label*)(o->value);
+  if (b->render_ && multi_render(b, o, x, y, w, h, a)) return;
+  multi_draw(b, o, x, y, w, h, a);
+}
+
 // measurement is only correct for left-to-right appending...
 static void multi_measure(const Fl_Label* o, int& w, int& h) {
   Fl_Multi_Label* b = (Fl_Multi_Label*)(o->value);
-  Fl_Label local = *o;
-  local.value = b->labela;
-  local.type = b->typea;
-  local.measure(w,h);
-  local.value = b->labelb;
-  local.type = b->typeb;
-  int W = 0; int H = 0; local.measure(W,H);
-  w += W; if (H>h) h = H;
+  multi_measure_parts(b, o, w);
+  w = b->cache_wa + b->cache_wb;
+  h = b->cache_ha > b->cache_hb ? b->cache_ha : b->cache_hb;
 }
 
 // used by FL_MULTI_LABEL to set up the internal table, see FL/Enumerations.H
@@ -60,10 +122,71 @@ Fl_Labeltype fl_define_FL_MULTI_LABEL() {
   return _FL_MULTI_LABEL;
 }
 
+Fl_Multi_Label::Fl_Multi_Label() {
+  labela = labelb = 0;
+  typea = typeb = 0;
+  cache_la = cache_lb = 0;
+  cache_ta = cache_tb = 0;
+  cache_wa = cache_ha = cache_wb = cache_hb = 0;
+  cache_font = 0;
+  cache_size = 0;
+  cache_win = 0;
+  cache_valid = 0;
+  render_ = 0;
+  render_bg_ = FL_BACKGROUND_COLOR;
+  render_surf_ = 0;
+  render_w = render_h = 0;
+  render_align = 0;
+  render_color = 0;
+}
+
+Fl_Multi_Label::~Fl_Multi_Label() {
+  delete render_surf_;
+}
+
+/** Discards the cached extents and any pre-rendered offscreen.
+
+  The caches notice when \p labela, \p labelb or their types are
+  assigned new pointers and when the font attributes of the labelled
+  widget change. Call this method when a label string or image is
+  modified \e in \e place, so the stale measurements are dropped.
+*/
+void Fl_Multi_Label::invalidate() {
+  cache_valid = 0;
+  delete render_surf_;
+  render_surf_ = 0;
+}
+
+/** Pre-renders the composite into a cached offscreen.
+
+  Once enabled, the whole composite is drawn once into an offscreen
+  buffer filled with the background color \p bg, and every further
+  repaint is a single blit. This pays off for static multi-part labels
+  that repaint often, e.g. icon + text + badge compositions on tab
+  bars. The offscreen is rebuilt automatically when the label fields,
+  font, color, alignment or drawing size change; call invalidate()
+  after modifying a label string or image in place.
+
+  Because the offscreen is opaque, \p bg must match the color the
+  label is drawn over; labels drawn on non-uniform backgrounds should
+  not enable pre-rendering.
+
+  \param[in] bg background color the offscreen is filled with
+
+  \since 1.4.0
+*/
+void Fl_Multi_Label::cache_rendering(Fl_Color bg) {
+  render_ = 1;
+  render_bg_ = bg;
+  invalidate();
+}
+
 void Fl_Multi_Label::label(Fl_Widget* o) {
+  invalidate();
   o->label(FL_MULTI_LABEL, (const char*)this); // calls fl_define_FL_MULTI_LABEL()
 }
 
 void Fl_Multi_Label::label(Fl_Menu_Item* o) {
+  invalidate();
   o->label(FL_MULTI_LABEL, (const char*)this); // calls fl_define_FL_MULTI_LABEL()
 }
@@ -91,6 +91,33 @@ Fl_PNG_Image::Fl_PNG_Image (const char *filename): Fl_RGB_Image(0,0,0)
 }
 
 
+/**
+ \brief Constructor that loads a PNG image at a reduced size.
+
+ \p maxsize is a size hint in pixels: while decoding, the loader keeps
+ only every 2nd, 4th, 8th, ... row and column, choosing the largest
+ power-of-two reduction whose larger dimension is still at least
+ \p maxsize, so a subsequent Fl_Image::copy(W, H) to the final size
+ never upscales. This cuts the peak memory of thumbnail generation by
+ the square of the reduction; interlaced images are composed from
+ several passes over every row and are always loaded at full size.
+ If \p maxsize is not smaller than the image, the file is loaded at
+ full resolution.
+
+ Use Fl_Image::fail() to check if Fl_PNG_Image failed to load, as with
+ Fl_PNG_Image(const char *filename).
+
+ \param[in] filename    Name of PNG file to read
+ \param[in] maxsize     load at no less than this size, in pixels
+
+ \version 1.4.0
+ */
+Fl_PNG_Image::Fl_PNG_Image (const char *filename, int maxsize): Fl_RGB_Image(0,0,0)
+{
+  load_png_(filename, NULL, 0, maxsize);
+}
+
+
 /**
  \brief Constructor that reads a PNG image from memory.
 
@@ -101,16 +128,17 @@ Fl_PNG_Image::Fl_PNG_Image (const char *filename): Fl_RGB_Image(0,0,0)
 
  \param name_png  A name given to this image or NULL
  \param buffer    Pointer to the start of the PNG image in memory
- \param maxsize   Size in bytes of the memory buffer containing the PNG image
+ \param datasize  Size in bytes of the memory buffer containing the PNG image
  */
 Fl_PNG_Image::Fl_PNG_Image (
-      const char *name_png, const unsigned char *buffer, int maxsize): Fl_RGB_Image(0,0,0)
+      const char *name_png, const unsigned char *buffer, int datasize): Fl_RGB_Image(0,0,0)
 {
-  load_png_(name_png, buffer, maxsize);
+  load_png_(name_png, buffer, datasize);
 }
 
 
-void Fl_PNG_Image::load_png_(const char *name_png, const unsigned char *buffer_png, int maxsize)
+void Fl_PNG_Image::load_png_(const char *name_png, const unsigned char *buffer_png, int datasize,
+                             int maxsize)
 {
 #if defined(HAVE_LIBPNG) && defined(HAVE_LIBZ)
   int i;                // Looping var
@@ -155,7 +183,7 @@ void Fl_PNG_Image::load_png_(const char *name_png, const unsigned char *buffer_p
 
   if (from_memory) {
     png_mem_data.current = buffer_png;
-    png_mem_data.last = buffer_png + maxsize;
+    png_mem_data.last = buffer_png + datasize;
     png_mem_data.pp = pp;
     // Initialize the function pointer to the PNG read "engine"...
     png_set_read_fn (pp, (png_voidp) &png_mem_data, png_read_data_from_mem);
@@ -197,24 +225,60 @@ void Fl_PNG_Image::load_png_(const char *name_png, const unsigned char *buffer_p
     png_set_tRNS_to_alpha(pp);
 #  endif // HAVE_PNG_GET_VALID && HAVE_PNG_SET_TRNS_TO_ALPHA
 
-  if (((size_t)w()) * h() * d() > max_size() ) longjmp(png_jmpbuf(pp), 1);
-  array = new uchar[w() * h() * d()];
-  alloc_array = 1;
+  // Row-skipping on load: when the caller gave a size hint, keep only
+  // every skip'th row and column, choosing the largest power-of-two
+  // reduction whose larger dimension still covers the hint. Interlaced
+  // images are composed from several passes over every row, so they
+  // always use the full-size path below.
+  int num_passes = png_set_interlace_handling(pp);
+  int skip = 1;
+  if (maxsize > 0 && num_passes == 1) {
+    int big = (w() > h()) ? w() : h();
+    while (big / (skip * 2) >= maxsize)
+      skip *= 2;
+  }
 
-  // Allocate pointers...
-  rows = new png_bytep[h()];
+  if (skip > 1) {
+    int ow = (w() + skip - 1) / skip;
+    int oh = (h() + skip - 1) / skip;
 
-  for (i = 0; i < h(); i ++)
-    rows[i] = (png_bytep)(array + i * w() * d());
+    if (((size_t)ow) * oh * d() > max_size() ) longjmp(png_jmpbuf(pp), 1);
+    array = new uchar[ow * oh * d()];
+    alloc_array = 1;
 
-  // Read the image, handling interlacing as needed...
-  for (i = png_set_interlace_handling(pp); i > 0; i --)
-    png_read_rows(pp, rows, NULL, h());
+    // Decode one full-width row at a time, sampling the kept rows in place
+    png_bytep rowbuf = new png_byte[w() * d()];
 
-  if (channels == 4) Fl::system_driver()->png_extra_rgba_processing((uchar*)array, w(), h());
+    for (i = 0; i < h(); i ++) {
+      png_read_row(pp, rowbuf, NULL);
+      if (i % skip) continue;
+      uchar *out = (uchar *)array + (i / skip) * ow * d();
+      for (int j = 0; j < ow; j ++)
+        memcpy(out + j * d(), rowbuf + j * skip * d(), d());
+    }
+
+    delete[] rowbuf;
+    w(ow);
+    h(oh);
+  } else {
+    if (((size_t)w()) * h() * d() > max_size() ) longjmp(png_jmpbuf(pp), 1);
+    array = new uchar[w() * h() * d()];
+    alloc_array = 1;
+
+    // Allocate pointers...
+    rows = new png_bytep[h()];
 
-  // Free memory and return...
-  delete[] rows;
+    for (i = 0; i < h(); i ++)
+      rows[i] = (png_bytep)(array + i * w() * d());
+
+    // Read the image, handling interlacing as needed...
+    for (i = num_passes; i > 0; i --)
+      png_read_rows(pp, rows, NULL, h());
+
+    delete[] rows;
+  }
+
+  if (channels == 4) Fl::system_driver()->png_extra_rgba_processing((uchar*)array, w(), h());
 
   png_read_end(pp, info);
   png_destroy_read_struct(&pp, &info, NULL);
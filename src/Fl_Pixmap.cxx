@@ -57,6 +57,8 @@ Fl_Pixmap::~Fl_Pixmap() {
 }
 
 void Fl_Pixmap::uncache() {
+  extern void fl_image_cache_forget(Fl_Image *); // in Fl_Graphics_Driver.cxx
+  fl_image_cache_forget(this);
   if (id_) {
     Fl_Graphics_Driver::default_driver().uncache_pixmap(id_);
     id_ = 0;
@@ -228,6 +230,7 @@ Fl_Image *Fl_Pixmap::copy(int W, int H) {
 void Fl_Pixmap::color_average(Fl_Color c, float i) {
   // Delete any existing pixmap/mask objects...
   uncache();
+  fl_forget_pixmap(data());
 
   // Allocate memory as needed...
   copy_data();
@@ -300,6 +303,7 @@ void Fl_Pixmap::color_average(Fl_Color c, float i) {
 
 void Fl_Pixmap::delete_data() {
   if (alloc_data) {
+    fl_forget_pixmap(data());
     for (int i = 0; i < count(); i ++) delete[] (char *)data()[i];
     delete[] (char **)data();
   }
@@ -320,6 +324,7 @@ void Fl_Pixmap::set_data(const char * const * p) {
 void Fl_Pixmap::desaturate() {
   // Delete any existing pixmap/mask objects...
   uncache();
+  fl_forget_pixmap(data());
 
   // Allocate memory as needed...
   copy_data();
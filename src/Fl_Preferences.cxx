@@ -909,7 +909,9 @@ Fl_Preferences::RootNode::RootNode( Fl_Preferences *prefs, Root root, const char
   filename_(0L),
   vendor_(0L),
   application_(0L),
-  root_(root)
+  root_(root),
+  canAppend_(0),
+  nAppends_(0)
 {
   char *filename = Fl::system_driver()->preference_rootnode(prefs, root, vendor, application);
   filename_    = filename ? fl_strdup(filename) : 0L;
@@ -925,7 +927,9 @@ Fl_Preferences::RootNode::RootNode( Fl_Preferences *prefs, const char *path, con
   filename_(0L),
   vendor_(0L),
   application_(0L),
-  root_(Fl_Preferences::USER)
+  root_(Fl_Preferences::USER),
+  canAppend_(0),
+  nAppends_(0)
 {
 
   if (!vendor)
@@ -950,7 +954,9 @@ Fl_Preferences::RootNode::RootNode( Fl_Preferences *prefs )
   filename_(0L),
   vendor_(0L),
   application_(0L),
-  root_(Fl_Preferences::USER)
+  root_(Fl_Preferences::USER),
+  canAppend_(0),
+  nAppends_(0)
 {
 }
 
@@ -1020,6 +1026,7 @@ int Fl_Preferences::RootNode::read() {
   }
   fclose( f );
   prefs_->node->clearDirtyFlags();
+  canAppend_ = 1;       // the file matches all clean entries now
   return 0;
 }
 
@@ -1034,6 +1041,21 @@ int Fl_Preferences::RootNode::write() {
   if ( ((root_&Fl_Preferences::ROOT_MASK)==Fl_Preferences::SYSTEM) && !(fileAccess_ & Fl_Preferences::SYSTEM_WRITE_OK) )
     return -1;
   fl_make_path_for_file(filename_);
+  // If the file already holds the state of all clean entries and nothing
+  // was removed, append just the changed keys instead of rewriting the
+  // whole database: re-reading applies lines in order, so the appended
+  // values win. A full rewrite compacts the file again after a while, and
+  // whenever an entry or group was deleted (the format can not express a
+  // removal in an appended line).
+  if ( canAppend_ && nAppends_ < 50 && !prefs_->node->pruned() ) {
+    FILE *fa = fl_fopen( filename_, "ab" );
+    if ( fa ) {
+      prefs_->node->writeDirty( fa );
+      fclose( fa );
+      nAppends_++;
+      return 0;
+    }
+  }
   FILE *f = fl_fopen( filename_, "wb" );
   if ( !f )
     return -1;
@@ -1042,6 +1064,8 @@ int Fl_Preferences::RootNode::write() {
   fprintf( f, "; application: %s\n", application_ );
   prefs_->node->write( f );
   fclose( f );
+  canAppend_ = 1;
+  nAppends_ = 0;
   if (Fl::system_driver()->preferences_need_protection_check()) {
     // unix: make sure that system prefs are user-readable
     if (strncmp(filename_, "/etc/fltk/", 10) == 0) {
@@ -1122,6 +1146,9 @@ Fl_Preferences::Node::Node( const char *path ) {
   indexed_ = 0;
   index_ = 0;
   nIndex_ = NIndex_ = 0;
+  entryIndexed_ = 0;
+  entryIndex_ = 0;
+  NEntryIndex_ = 0;
 }
 
 void Fl_Preferences::Node::deleteAllChildren() {
@@ -1132,6 +1159,7 @@ void Fl_Preferences::Node::deleteAllChildren() {
   }
   child_ = 0L;
   dirty_ = 1;
+  pruned_ = 1;
   updateIndex();
 }
 
@@ -1152,7 +1180,9 @@ void Fl_Preferences::Node::deleteAllEntries() {
     nEntry_ = 0;
     NEntry_ = 0;
   }
+  deleteEntryIndex();
   dirty_ = 1;
+  pruned_ = 1;
 }
 
 // delete this and all depending nodes
@@ -1160,6 +1190,7 @@ Fl_Preferences::Node::~Node() {
   deleteAllChildren();
   deleteAllEntries();
   deleteIndex();
+  deleteEntryIndex();
   if ( path_ ) {
     free( path_ );
     path_ = 0L;
@@ -1176,16 +1207,50 @@ char Fl_Preferences::Node::dirty() {
   return 0;
 }
 
+// recursively check if any entry or group was removed since the last full write
+char Fl_Preferences::Node::pruned() {
+  if ( pruned_ ) return 1;
+  if ( next_ && next_->pruned() ) return 1;
+  if ( child_ && child_->pruned() ) return 1;
+  return 0;
+}
+
 // recursively clear all dirty flags
 void Fl_Preferences::Node::clearDirtyFlags() {
   Fl_Preferences::Node *nd = this;
   while (nd) {
     nd->dirty_ = 0;
+    nd->pruned_ = 0;
+    for ( int i = 0; i < nd->nEntry_; i++ ) nd->entry_[i].dirty = 0;
     if ( nd->child_ ) nd->child_->clearDirtyFlags();
     nd = nd->next_;
   }
 }
 
+// write a single name/value pair, hacking the value into smaller pieces if needed
+static void writeEntry( FILE *f, Fl_Preferences::Entry &e ) {
+  char *src = e.value;
+  if ( src ) {
+    fprintf( f, "%s:", e.name );
+    size_t cnt, written = 0;
+    for ( cnt = 0; cnt < 60; cnt++ )
+      if ( src[cnt]==0 ) break;
+    written += fwrite( src, cnt, 1, f );
+    fprintf( f, "\n" );
+    src += cnt;
+    for (;*src;) {
+      for ( cnt = 0; cnt < 80; cnt++ )
+        if ( src[cnt]==0 ) break;
+      fputc( '+', f );
+      written += fwrite( src, cnt, 1, f );
+      fputc( '\n', f );
+      src += cnt;
+    }
+  }
+  else
+    fprintf( f, "%s\n", e.name );
+}
+
 // write this node (recursively from the last neighbor back to this)
 // write all entries
 // write all children
@@ -1193,29 +1258,30 @@ int Fl_Preferences::Node::write( FILE *f ) {
   if ( next_ ) next_->write( f );
   fprintf( f, "\n[%s]\n\n", path_ );
   for ( int i = 0; i < nEntry_; i++ ) {
-    char *src = entry_[i].value;
-    if ( src ) {                // hack it into smaller pieces if needed
-      fprintf( f, "%s:", entry_[i].name );
-      size_t cnt, written = 0;
-      for ( cnt = 0; cnt < 60; cnt++ )
-        if ( src[cnt]==0 ) break;
-      written += fwrite( src, cnt, 1, f );
-      fprintf( f, "\n" );
-      src += cnt;
-      for (;*src;) {
-        for ( cnt = 0; cnt < 80; cnt++ )
-          if ( src[cnt]==0 ) break;
-        fputc( '+', f );
-        written += fwrite( src, cnt, 1, f );
-        fputc( '\n', f );
-        src += cnt;
-      }
-    }
-    else
-      fprintf( f, "%s\n", entry_[i].name );
+    writeEntry( f, entry_[i] );
+    entry_[i].dirty = 0;
   }
   if ( child_ ) child_->write( f );
   dirty_ = 0;
+  pruned_ = 0;
+  return 0;
+}
+
+// append only the changed entries of changed nodes to the file
+// (see RootNode::write() for how this updates the database)
+int Fl_Preferences::Node::writeDirty( FILE *f ) {
+  if ( next_ ) next_->writeDirty( f );
+  if ( dirty_ ) {
+    fprintf( f, "\n[%s]\n\n", path_ );
+    for ( int i = 0; i < nEntry_; i++ ) {
+      if ( entry_[i].dirty ) {
+        writeEntry( f, entry_[i] );
+        entry_[i].dirty = 0;
+      }
+    }
+    dirty_ = 0;
+  }
+  if ( child_ ) child_->writeDirty( f );
   return 0;
 }
 
@@ -1250,21 +1316,28 @@ Fl_Preferences::Node *Fl_Preferences::Node::addChild( const char *path ) {
   return nd;
 }
 
+// hash an entry name for the per-node entry index
+static unsigned entryHash( const char *name ) {
+  unsigned h = 0;
+  while ( *name ) h = 33*h + (unsigned char)*name++;
+  return h;
+}
+
 // create and set, or change an entry within this node
 void Fl_Preferences::Node::set( const char *name, const char *value )
 {
-  for ( int i=0; i<nEntry_; i++ ) {
-    if ( strcmp( name, entry_[i].name ) == 0 ) {
-      if ( !value ) return; // annotation
-      if ( strcmp( value, entry_[i].value ) != 0 ) {
-        if ( entry_[i].value )
-          free( entry_[i].value );
-        entry_[i].value = fl_strdup( value );
-        dirty_ = 1;
-      }
-      lastEntrySet = i;
-      return;
+  int i = getEntry( name );
+  if ( i >= 0 ) {
+    if ( !value ) return; // annotation
+    if ( strcmp( value, entry_[i].value ) != 0 ) {
+      if ( entry_[i].value )
+        free( entry_[i].value );
+      entry_[i].value = fl_strdup( value );
+      entry_[i].dirty = 1;
+      dirty_ = 1;
     }
+    lastEntrySet = i;
+    return;
   }
   if ( NEntry_==nEntry_ ) {
     NEntry_ = NEntry_ ? NEntry_*2 : 10;
@@ -1272,8 +1345,18 @@ void Fl_Preferences::Node::set( const char *name, const char *value )
   }
   entry_[ nEntry_ ].name = fl_strdup( name );
   entry_[ nEntry_ ].value = value?fl_strdup(value):0;
+  entry_[ nEntry_ ].dirty = 1;
   lastEntrySet = nEntry_;
   nEntry_++;
+  if ( entryIndexed_ ) {                // keep the hash table in step
+    if ( 2*nEntry_ > NEntryIndex_ ) {
+      entryIndexed_ = 0;                // table full: rebuild on next lookup
+    } else {
+      unsigned p = entryHash( name ) & (NEntryIndex_-1);
+      while ( entryIndex_[p] >= 0 ) p = (p+1) & (NEntryIndex_-1);
+      entryIndex_[p] = nEntry_-1;
+    }
+  }
   dirty_ = 1;
 }
 
@@ -1318,6 +1401,16 @@ const char *Fl_Preferences::Node::get( const char *name ) {
 
 // find the index of an entry, returns -1 if no such entry
 int Fl_Preferences::Node::getEntry( const char *name ) {
+  if ( nEntry_ > 8 ) {  // for larger groups, look it up in the hash table
+    createEntryIndex();
+    unsigned p = entryHash( name ) & (NEntryIndex_-1);
+    while ( entryIndex_[p] >= 0 ) {
+      if ( strcmp( name, entry_[ entryIndex_[p] ].name ) == 0 )
+        return entryIndex_[p];
+      p = (p+1) & (NEntryIndex_-1);
+    }
+    return -1;
+  }
   for ( int i=0; i<nEntry_; i++ ) {
     if ( strcmp( name, entry_[i].name ) == 0 ) {
       return i;
@@ -1332,7 +1425,9 @@ char Fl_Preferences::Node::deleteEntry( const char *name ) {
   if ( ix == -1 ) return 0;
   memmove( entry_+ix, entry_+ix+1, (nEntry_-ix-1) * sizeof(Entry) );
   nEntry_--;
+  entryIndexed_ = 0;    // the indices of all following entries shifted
   dirty_ = 1;
+  pruned_ = 1;
   return 1;
 }
 
@@ -1467,6 +1562,7 @@ char Fl_Preferences::Node::remove() {
       }
     }
     parent()->dirty_ = 1;
+    parent()->pruned_ = 1;
     parent()->updateIndex();
   }
   delete this;
@@ -1500,6 +1596,34 @@ void Fl_Preferences::Node::deleteIndex() {
   indexed_ = 0;
 }
 
+// Build the hash table over the entry names of this node. Without it,
+// every get and set pays a linear scan over the entry names, which makes
+// reading a preferences file with many entries per group quadratic.
+// Open addressing with linear probing; the table holds entry indices.
+void Fl_Preferences::Node::createEntryIndex() {
+  if (entryIndexed_) return;
+  int i, n = 16;
+  while ( n < 2*nEntry_ ) n *= 2;
+  if ( n != NEntryIndex_ ) {
+    entryIndex_ = (int*)realloc( entryIndex_, n*sizeof(int) );
+    NEntryIndex_ = n;
+  }
+  for ( i=0; i<n; i++ ) entryIndex_[i] = -1;
+  for ( i=0; i<nEntry_; i++ ) {
+    unsigned p = entryHash( entry_[i].name ) & (n-1);
+    while ( entryIndex_[p] >= 0 ) p = (p+1) & (n-1);
+    entryIndex_[p] = i;
+  }
+  entryIndexed_ = 1;
+}
+
+void Fl_Preferences::Node::deleteEntryIndex() {
+  if (entryIndex_) free(entryIndex_);
+  NEntryIndex_ = 0;
+  entryIndex_ = 0;
+  entryIndexed_ = 0;
+}
+
 /**
  \brief Create a plugin.
 
@@ -16,6 +16,7 @@
 //
 
 #include <FL/Fl_Printer.H>
+#include <FL/Fl.H>
 #include <config.h>
 
 #if defined(FL_NO_PRINT_SUPPORT)
@@ -23,7 +24,16 @@
 
 Fl_Printer::Fl_Printer(void) {
   printer = NULL;
+  async_page_cb_ = NULL;
+  async_progress_cb_ = NULL;
+  async_data_ = NULL;
+  async_page_ = async_lastpage_ = 0;
 }
+int Fl_Printer::begin_job_async(int pagecount, Fl_Printer_Page_Handler page_cb,
+                                Fl_Printer_Progress_Handler progress_cb,
+                                void *data, char **perr_message) {return 2;}
+void Fl_Printer::cancel_job_async(void) {}
+void Fl_Printer::async_step(void *v) {}
 Fl_Paged_Device* Fl_Printer::newPrinterDriver(void) {
   return NULL;
 }
@@ -141,6 +151,93 @@ const char *Fl_Printer::property_cancel = "Cancel";
 Fl_Printer::Fl_Printer(void) {
   printer = Fl_Printer::newPrinterDriver();
   driver(printer->driver());
+  async_page_cb_ = NULL;
+  async_progress_cb_ = NULL;
+  async_data_ = NULL;
+  async_page_ = async_lastpage_ = 0;
+}
+
+/**
+  Starts a print job that renders its pages between event loop passes
+  instead of freezing the application until the last page.
+
+  This runs the same dialog as begin_job(int, int*, int*, char**) and, on
+  success, schedules \p page_cb to be called once per pass of the event
+  loop for every page of the selected range, between matching
+  begin_page()/end_page() calls and with the printer as the current
+  drawing surface. The application stays responsive while a long report
+  prints, so \p page_cb must render from state that remains valid during
+  the job. After each page \p progress_cb (when given) is called with the
+  page just printed and the last page of the job, e.g. to update a
+  progress dialog; end_job() runs automatically after the last page.
+  A non-zero return from \p page_cb, or a cancel_job_async() call,
+  finishes the job early.
+
+  All rendering happens on the main thread: FLTK's current drawing
+  surface and font machinery are process-wide, so pages cannot be drawn
+  from a separate thread. One Fl_Printer can run one asynchronous job at
+  a time.
+
+  \param pagecount the number of pages the job would print entirely
+  \param page_cb renders one page, return non-zero to stop the job
+  \param progress_cb called after each printed page, may be NULL
+  \param data passed to both callbacks
+  \param perr_message as with begin_job()
+  \return 0 when the job was started, or the begin_job() error code
+*/
+int Fl_Printer::begin_job_async(int pagecount, Fl_Printer_Page_Handler page_cb,
+                                Fl_Printer_Progress_Handler progress_cb,
+                                void *data, char **perr_message)
+{
+  if (async_page_cb_ || !page_cb) return 1;
+  int frompage = 1, topage = pagecount;
+  int err = begin_job(pagecount, &frompage, &topage, perr_message);
+  if (err) return err;
+  if (topage < frompage) topage = frompage;
+  async_page_cb_ = page_cb;
+  async_progress_cb_ = progress_cb;
+  async_data_ = data;
+  async_page_ = frompage;
+  async_lastpage_ = topage;
+  // give the display back to the event loop between pages: begin_job()
+  // made the printer the current surface until end_job()
+  Fl_Surface_Device::pop_current();
+  Fl::add_timeout(0., async_step, this);
+  return 0;
+}
+
+// Prints one page per event loop pass, see begin_job_async().
+void Fl_Printer::async_step(void *v)
+{
+  Fl_Printer *p = (Fl_Printer*)v;
+  Fl_Surface_Device::push_current(p->printer);
+  int page = p->async_page_++;
+  p->begin_page();
+  int stop = p->async_page_cb_(p, page, p->async_data_);
+  p->end_page();
+  if (stop || page >= p->async_lastpage_) {
+    p->end_job(); // pops the printer surface
+    p->async_page_cb_ = NULL;
+  } else {
+    Fl_Surface_Device::pop_current();
+    Fl::add_timeout(0., async_step, v); // next page on the next pass
+  }
+  if (p->async_progress_cb_ && (p->async_page_cb_ || !stop))
+    p->async_progress_cb_(p, page, p->async_lastpage_, p->async_data_);
+}
+
+/**
+  Finishes a job started with begin_job_async() before its last page.
+  Pages already rendered are printed; the progress callback is not
+  called again. Does nothing when no asynchronous job is running.
+*/
+void Fl_Printer::cancel_job_async(void)
+{
+  if (!async_page_cb_) return;
+  Fl::remove_timeout(async_step, this);
+  Fl_Surface_Device::push_current(printer);
+  end_job();
+  async_page_cb_ = NULL;
 }
 
 int Fl_Printer::begin_job(int pagecount, int *frompage, int *topage, char **perr_message)
@@ -214,6 +311,7 @@ bool Fl_Printer::is_current() {
 
 Fl_Printer::~Fl_Printer(void)
 {
+  if (async_page_cb_) cancel_job_async();
   delete printer;
 }
 
@@ -0,0 +1,995 @@
+//
+// Implementation of classes Fl_Recording_Graphics_Driver and Fl_Recording_Surface
+// in the Fast Light Tool Kit (FLTK).
+//
+// Copyright 2020 by Bill Spitzak and others.
+//
+// This library is free software. Distribution and use rights are outlined in
+// the file "COPYING" which should have been included with this file.  If this
+// file is missing or damaged, see the license at:
+//
+//     https://www.fltk.org/COPYING.php
+//
+// Please see the following page on how to report bugs and issues:
+//
+//     https://www.fltk.org/bugs.php
+//
+
+// Records the standard FLTK drawing API into a replayable binary command stream.
+
+#include <FL/Fl_Recording_Surface.H>
+#include <FL/fl_draw.H>
+#include <FL/math.h>
+#include <FL/Fl_Widget_Surface.H>
+#include <FL/Fl_Graphics_Driver.H>
+#include <FL/Fl.H>
+#include <FL/Fl_RGB_Image.H>
+#include <FL/Fl_Pixmap.H>
+#include <FL/Fl_Bitmap.H>
+#include <stdlib.h>
+#include <string.h>
+
+// The opcodes of the recorded stream. Each is one byte, followed by its
+// arguments in the host's byte order: 'i' below is a 4-byte int, 'f' a
+// 4-byte float, 'd' an 8-byte double, 'b' raw bytes.
+enum {
+  REC_POINT = 1,        // i:x i:y
+  REC_RECT,             // i:x i:y i:w i:h
+  REC_RECTF,            // i:x i:y i:w i:h
+  REC_LINE,             // i:x i:y i:x1 i:y1
+  REC_LINE3,            // i:x i:y i:x1 i:y1 i:x2 i:y2
+  REC_XYLINE,           // i:x i:y i:x1
+  REC_XYLINE2,          // i:x i:y i:x1 i:y2
+  REC_XYLINE3,          // i:x i:y i:x1 i:y2 i:x3
+  REC_YXLINE,           // i:x i:y i:y1
+  REC_YXLINE2,          // i:x i:y i:y1 i:x2
+  REC_YXLINE3,          // i:x i:y i:y1 i:x2 i:y3
+  REC_LOOP3,            // 6 ints
+  REC_LOOP4,            // 8 ints
+  REC_POLYGON3,         // 6 ints
+  REC_POLYGON4,         // 8 ints
+  REC_PUSH_CLIP,        // i:x i:y i:w i:h
+  REC_PUSH_NO_CLIP,     //
+  REC_POP_CLIP,         //
+  REC_COLOR,            // i:Fl_Color
+  REC_COLOR_RGB,        // b:r b:g b:b
+  REC_LINE_STYLE,       // i:style i:width i:n b[n]:dashes (n includes the 0 terminator, n==0 means none)
+  REC_FONT,             // i:face i:size
+  REC_DRAW,             // i:n b[n]:text i:x i:y
+  REC_DRAW_ANGLED,      // i:angle i:n b[n]:text i:x i:y
+  REC_RTL_DRAW,         // i:n b[n]:text i:x i:y
+  REC_BEGIN_POINTS,     //
+  REC_BEGIN_LINE,       //
+  REC_BEGIN_LOOP,       //
+  REC_BEGIN_POLYGON,    //
+  REC_BEGIN_COMPLEX_POLYGON, //
+  REC_VERTEX,           // f:x f:y (device space)
+  REC_GAP,              //
+  REC_END_POINTS,       //
+  REC_END_LINE,         //
+  REC_END_LOOP,         //
+  REC_END_POLYGON,      //
+  REC_END_COMPLEX_POLYGON, //
+  REC_CIRCLE,           // i:filled i:x i:y i:w i:h (device-space bounding box)
+  REC_ARC,              // i:x i:y i:w i:h d:a1 d:a2
+  REC_PIE,              // i:x i:y i:w i:h d:a1 d:a2
+  REC_IMAGE,            // i:x i:y i:w i:h i:d b[w*d*h]:packed rows
+  REC_IMAGE_MONO,       // i:x i:y i:w i:h i:d b[w*d*h]:packed rows
+  REC_RGB,              // i:dw i:dh i:d i:w i:h i:XP i:YP i:WP i:HP i:cx i:cy b[dw*d*dh]
+  REC_BITMAP            // i:dw i:dh i:w i:h i:XP i:YP i:WP i:HP i:cx i:cy b[((dw+7)/8)*dh]
+};
+
+class Fl_Recording_Graphics_Driver : public Fl_Graphics_Driver {
+  uchar *buf_;          // the recorded stream
+  size_t used_;         // bytes recorded so far
+  size_t alloc_;        // allocated length of buf_
+  class Clip {
+  public:
+    int x, y, w, h;     // the clip rectangle, w < 0 means no clip
+    Clip *prev;         // previous in pile of clips
+  };
+  Clip *clip_;          // top of pile of clips
+  class Origin {
+  public:
+    int x, y;           // surface translation the recorded coordinates include
+    Origin *prev;       // previous in pile of translations
+  };
+  Origin *origin_;      // top of pile of translations
+  int ox_, oy_;         // current surface translation
+  void need(size_t n);
+  void op(int code);
+  void put32(int v);
+  void putf(float v);
+  void putd(double v);
+  void putblock(const void *data, size_t n);
+  void reci(int code, const int *v, int count);
+public:
+  Fl_Recording_Graphics_Driver();
+  ~Fl_Recording_Graphics_Driver();
+  const uchar *data() {return buf_;}
+  size_t stream_length() {return used_;}
+  void clear_record();
+  void translate_record(int x, int y);
+  void untranslate_record();
+protected:
+  void point(int x, int y);
+  void rect(int x, int y, int w, int h);
+  void rectf(int x, int y, int w, int h);
+  void line(int x, int y, int x1, int y1);
+  void line(int x, int y, int x1, int y1, int x2, int y2);
+  void xyline(int x, int y, int x1);
+  void xyline(int x, int y, int x1, int y2);
+  void xyline(int x, int y, int x1, int y2, int x3);
+  void yxline(int x, int y, int y1);
+  void yxline(int x, int y, int y1, int x2);
+  void yxline(int x, int y, int y1, int x2, int y3);
+  void loop(int x0, int y0, int x1, int y1, int x2, int y2);
+  void loop(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3);
+  void polygon(int x0, int y0, int x1, int y1, int x2, int y2);
+  void polygon(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3);
+  void push_clip(int x, int y, int w, int h);
+  void push_no_clip();
+  void pop_clip();
+  int clip_box(int x, int y, int w, int h, int &X, int &Y, int &W, int &H);
+  int not_clipped(int x, int y, int w, int h);
+  void color(Fl_Color c);
+  void color(uchar r, uchar g, uchar b);
+  Fl_Color color();
+  void line_style(int style, int width, char *dashes=0);
+  void font(Fl_Font face, Fl_Fontsize fsize);
+  Fl_Font font();
+  void draw(const char *str, int n, int x, int y);
+  void draw(const char *str, int n, float x, float y);
+  void draw(int angle, const char *str, int n, int x, int y);
+  void rtl_draw(const char *str, int n, int x, int y);
+  double width(const char *str, int n);
+  double width(unsigned int c);
+  void text_extents(const char *str, int n, int &dx, int &dy, int &w, int &h);
+  int height();
+  int descent();
+  void begin_points();
+  void begin_line();
+  void begin_loop();
+  void begin_polygon();
+  void begin_complex_polygon();
+  void transformed_vertex0(float x, float y);
+  void gap();
+  void end_points();
+  void end_line();
+  void end_loop();
+  void end_polygon();
+  void end_complex_polygon();
+  void circle(double x, double y, double r);
+  void arc(int x, int y, int w, int h, double a1, double a2);
+  void pie(int x, int y, int w, int h, double a1, double a2);
+  void draw_image(const uchar *buf, int x, int y, int w, int h, int d, int l);
+  void draw_image_mono(const uchar *buf, int x, int y, int w, int h, int d, int l);
+  void draw_image(Fl_Draw_Image_Cb cb, void *data, int x, int y, int w, int h, int d);
+  void draw_image_mono(Fl_Draw_Image_Cb cb, void *data, int x, int y, int w, int h, int d);
+  void draw_rgb(Fl_RGB_Image *rgb, int XP, int YP, int WP, int HP, int cx, int cy);
+  void draw_pixmap(Fl_Pixmap *pxm, int XP, int YP, int WP, int HP, int cx, int cy);
+  void draw_bitmap(Fl_Bitmap *bm, int XP, int YP, int WP, int HP, int cx, int cy);
+private:
+  void record_image(int code, const uchar *buf, int x, int y, int w, int h, int d, int l);
+  void record_rgb_data(const uchar *array, int dw, int dh, int d, int ld,
+                       int w, int h, int XP, int YP, int WP, int HP, int cx, int cy);
+  void record_text(int code, const char *str, int n);
+};
+
+Fl_Recording_Graphics_Driver::Fl_Recording_Graphics_Driver() {
+  buf_ = NULL;
+  used_ = alloc_ = 0;
+  clip_ = NULL;
+  origin_ = NULL;
+  ox_ = oy_ = 0;
+}
+
+Fl_Recording_Graphics_Driver::~Fl_Recording_Graphics_Driver() {
+  if (buf_) free(buf_);
+  while (clip_) {
+    Clip *c = clip_;
+    clip_ = clip_->prev;
+    delete c;
+  }
+  while (origin_) {
+    Origin *o = origin_;
+    origin_ = origin_->prev;
+    delete o;
+  }
+}
+
+void Fl_Recording_Graphics_Driver::clear_record() {
+  used_ = 0;
+}
+
+void Fl_Recording_Graphics_Driver::need(size_t n) {
+  if (used_ + n <= alloc_) return;
+  alloc_ = alloc_ ? alloc_ * 2 : 1024;
+  while (used_ + n > alloc_) alloc_ *= 2;
+  buf_ = (uchar*)realloc(buf_, alloc_);
+}
+
+void Fl_Recording_Graphics_Driver::op(int code) {
+  need(1);
+  buf_[used_++] = (uchar)code;
+}
+
+void Fl_Recording_Graphics_Driver::put32(int v) {
+  need(sizeof(v));
+  memcpy(buf_ + used_, &v, sizeof(v));
+  used_ += sizeof(v);
+}
+
+void Fl_Recording_Graphics_Driver::putf(float v) {
+  need(sizeof(v));
+  memcpy(buf_ + used_, &v, sizeof(v));
+  used_ += sizeof(v);
+}
+
+void Fl_Recording_Graphics_Driver::putd(double v) {
+  need(sizeof(v));
+  memcpy(buf_ + used_, &v, sizeof(v));
+  used_ += sizeof(v);
+}
+
+void Fl_Recording_Graphics_Driver::putblock(const void *data, size_t n) {
+  need(n);
+  memcpy(buf_ + used_, data, n);
+  used_ += n;
+}
+
+void Fl_Recording_Graphics_Driver::reci(int code, const int *v, int count) {
+  op(code);
+  for (int i = 0; i < count; i++) put32(v[i]);
+}
+
+void Fl_Recording_Graphics_Driver::translate_record(int x, int y) {
+  Origin *o = new Origin();
+  o->x = ox_;
+  o->y = oy_;
+  o->prev = origin_;
+  origin_ = o;
+  ox_ += x;
+  oy_ += y;
+}
+
+void Fl_Recording_Graphics_Driver::untranslate_record() {
+  Origin *o = origin_;
+  if (!o) return;
+  ox_ = o->x;
+  oy_ = o->y;
+  origin_ = o->prev;
+  delete o;
+}
+
+void Fl_Recording_Graphics_Driver::point(int x, int y) {
+  int v[] = {x+ox_, y+oy_};
+  reci(REC_POINT, v, 2);
+}
+
+void Fl_Recording_Graphics_Driver::rect(int x, int y, int w, int h) {
+  int v[] = {x+ox_, y+oy_, w, h};
+  reci(REC_RECT, v, 4);
+}
+
+void Fl_Recording_Graphics_Driver::rectf(int x, int y, int w, int h) {
+  int v[] = {x+ox_, y+oy_, w, h};
+  reci(REC_RECTF, v, 4);
+}
+
+void Fl_Recording_Graphics_Driver::line(int x, int y, int x1, int y1) {
+  int v[] = {x+ox_, y+oy_, x1+ox_, y1+oy_};
+  reci(REC_LINE, v, 4);
+}
+
+void Fl_Recording_Graphics_Driver::line(int x, int y, int x1, int y1, int x2, int y2) {
+  int v[] = {x+ox_, y+oy_, x1+ox_, y1+oy_, x2+ox_, y2+oy_};
+  reci(REC_LINE3, v, 6);
+}
+
+void Fl_Recording_Graphics_Driver::xyline(int x, int y, int x1) {
+  int v[] = {x+ox_, y+oy_, x1+ox_};
+  reci(REC_XYLINE, v, 3);
+}
+
+void Fl_Recording_Graphics_Driver::xyline(int x, int y, int x1, int y2) {
+  int v[] = {x+ox_, y+oy_, x1+ox_, y2+oy_};
+  reci(REC_XYLINE2, v, 4);
+}
+
+void Fl_Recording_Graphics_Driver::xyline(int x, int y, int x1, int y2, int x3) {
+  int v[] = {x+ox_, y+oy_, x1+ox_, y2+oy_, x3+ox_};
+  reci(REC_XYLINE3, v, 5);
+}
+
+void Fl_Recording_Graphics_Driver::yxline(int x, int y, int y1) {
+  int v[] = {x+ox_, y+oy_, y1+oy_};
+  reci(REC_YXLINE, v, 3);
+}
+
+void Fl_Recording_Graphics_Driver::yxline(int x, int y, int y1, int x2) {
+  int v[] = {x+ox_, y+oy_, y1+oy_, x2+ox_};
+  reci(REC_YXLINE2, v, 4);
+}
+
+void Fl_Recording_Graphics_Driver::yxline(int x, int y, int y1, int x2, int y3) {
+  int v[] = {x+ox_, y+oy_, y1+oy_, x2+ox_, y3+oy_};
+  reci(REC_YXLINE3, v, 5);
+}
+
+void Fl_Recording_Graphics_Driver::loop(int x0, int y0, int x1, int y1, int x2, int y2) {
+  int v[] = {x0+ox_, y0+oy_, x1+ox_, y1+oy_, x2+ox_, y2+oy_};
+  reci(REC_LOOP3, v, 6);
+}
+
+void Fl_Recording_Graphics_Driver::loop(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) {
+  int v[] = {x0+ox_, y0+oy_, x1+ox_, y1+oy_, x2+ox_, y2+oy_, x3+ox_, y3+oy_};
+  reci(REC_LOOP4, v, 8);
+}
+
+void Fl_Recording_Graphics_Driver::polygon(int x0, int y0, int x1, int y1, int x2, int y2) {
+  int v[] = {x0+ox_, y0+oy_, x1+ox_, y1+oy_, x2+ox_, y2+oy_};
+  reci(REC_POLYGON3, v, 6);
+}
+
+void Fl_Recording_Graphics_Driver::polygon(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) {
+  int v[] = {x0+ox_, y0+oy_, x1+ox_, y1+oy_, x2+ox_, y2+oy_, x3+ox_, y3+oy_};
+  reci(REC_POLYGON4, v, 8);
+}
+
+// The clip pile is maintained for real, so drawing code that culls with
+// fl_not_clipped()/fl_clip_box() behaves during recording as it would on
+// any rectangle-clipping surface.
+void Fl_Recording_Graphics_Driver::push_clip(int x, int y, int w, int h) {
+  Clip *c = new Clip();
+  clip_box(x, y, w, h, c->x, c->y, c->w, c->h);
+  c->prev = clip_;
+  clip_ = c;
+  int v[] = {x+ox_, y+oy_, w, h};
+  reci(REC_PUSH_CLIP, v, 4);
+}
+
+void Fl_Recording_Graphics_Driver::push_no_clip() {
+  Clip *c = new Clip();
+  c->x = c->y = 0;
+  c->w = c->h = -1; // mark of no_clip
+  c->prev = clip_;
+  clip_ = c;
+  op(REC_PUSH_NO_CLIP);
+}
+
+void Fl_Recording_Graphics_Driver::pop_clip() {
+  if (clip_) {
+    Clip *c = clip_;
+    clip_ = clip_->prev;
+    delete c;
+  }
+  op(REC_POP_CLIP);
+}
+
+int Fl_Recording_Graphics_Driver::clip_box(int x, int y, int w, int h, int &X, int &Y, int &W, int &H) {
+  if (!clip_ || clip_->w < 0) {
+    X = x; Y = y; W = w; H = h;
+    return 0;
+  }
+  int ret = 0;
+  if (x > (X=clip_->x)) {X=x; ret=1;}
+  if (y > (Y=clip_->y)) {Y=y; ret=1;}
+  if ((x+w) < (clip_->x+clip_->w)) {
+    W=x+w-X;
+    ret=1;
+  } else
+    W = clip_->x + clip_->w - X;
+  if (W<0) {
+    W=0;
+    return 1;
+  }
+  if ((y+h) < (clip_->y+clip_->h)) {
+    H=y+h-Y;
+    ret=1;
+  } else
+    H = clip_->y + clip_->h - Y;
+  if (H<0) {
+    W=0;
+    H=0;
+    return 1;
+  }
+  return ret;
+}
+
+int Fl_Recording_Graphics_Driver::not_clipped(int x, int y, int w, int h) {
+  if (!clip_ || clip_->w < 0) return 1;
+  int X = 0, Y = 0, W = 0, H = 0;
+  clip_box(x, y, w, h, X, Y, W, H);
+  return W ? 1 : 0;
+}
+
+void Fl_Recording_Graphics_Driver::color(Fl_Color c) {
+  Fl_Graphics_Driver::color(c);
+  op(REC_COLOR);
+  put32((int)c);
+}
+
+void Fl_Recording_Graphics_Driver::color(uchar r, uchar g, uchar b) {
+  Fl_Graphics_Driver::color(fl_rgb_color(r, g, b));
+  op(REC_COLOR_RGB);
+  need(3);
+  buf_[used_++] = r;
+  buf_[used_++] = g;
+  buf_[used_++] = b;
+}
+
+Fl_Color Fl_Recording_Graphics_Driver::color() {
+  return Fl_Graphics_Driver::color();
+}
+
+void Fl_Recording_Graphics_Driver::line_style(int style, int width, char *dashes) {
+  op(REC_LINE_STYLE);
+  put32(style);
+  put32(width);
+  if (dashes && *dashes) {
+    int n = (int)strlen(dashes) + 1; // keep the 0 terminator in the stream
+    put32(n);
+    putblock(dashes, n);
+  } else {
+    put32(0);
+  }
+}
+
+void Fl_Recording_Graphics_Driver::font(Fl_Font face, Fl_Fontsize fsize) {
+  Fl_Graphics_Driver::font(face, fsize);
+  // keep the display driver in sync so the metric queries below answer
+  Fl_Display_Device::display_device()->driver()->font(face, fsize);
+  op(REC_FONT);
+  put32(face);
+  put32(fsize);
+}
+
+Fl_Font Fl_Recording_Graphics_Driver::font() {
+  return Fl_Graphics_Driver::font();
+}
+
+void Fl_Recording_Graphics_Driver::record_text(int code, const char *str, int n) {
+  op(code);
+  put32(n);
+  if (n) putblock(str, n);
+}
+
+void Fl_Recording_Graphics_Driver::draw(const char *str, int n, int x, int y) {
+  record_text(REC_DRAW, str, n);
+  put32(x+ox_);
+  put32(y+oy_);
+}
+
+void Fl_Recording_Graphics_Driver::draw(const char *str, int n, float x, float y) {
+  draw(str, n, (int)x, (int)y);
+}
+
+void Fl_Recording_Graphics_Driver::draw(int angle, const char *str, int n, int x, int y) {
+  op(REC_DRAW_ANGLED);
+  put32(angle);
+  put32(n);
+  if (n) putblock(str, n);
+  put32(x+ox_);
+  put32(y+oy_);
+}
+
+void Fl_Recording_Graphics_Driver::rtl_draw(const char *str, int n, int x, int y) {
+  record_text(REC_RTL_DRAW, str, n);
+  put32(x+ox_);
+  put32(y+oy_);
+}
+
+double Fl_Recording_Graphics_Driver::width(const char *str, int n) {
+  return Fl_Display_Device::display_device()->driver()->width(str, n);
+}
+
+double Fl_Recording_Graphics_Driver::width(unsigned int c) {
+  return Fl_Display_Device::display_device()->driver()->width(c);
+}
+
+void Fl_Recording_Graphics_Driver::text_extents(const char *str, int n, int &dx, int &dy, int &w, int &h) {
+  Fl_Display_Device::display_device()->driver()->text_extents(str, n, dx, dy, w, h);
+}
+
+int Fl_Recording_Graphics_Driver::height() {
+  return Fl_Display_Device::display_device()->driver()->height();
+}
+
+int Fl_Recording_Graphics_Driver::descent() {
+  return Fl_Display_Device::display_device()->driver()->descent();
+}
+
+// The vertex pipeline is recorded as issued; the replaying driver performs
+// its own gap/loop-closing processing. Vertices reach transformed_vertex0()
+// already through the recording driver's own current transformation matrix,
+// so they are stored in device space and replayed with
+// fl_transformed_vertex(); matrix operations need not be in the stream.
+void Fl_Recording_Graphics_Driver::begin_points() {
+  Fl_Graphics_Driver::begin_points();
+  op(REC_BEGIN_POINTS);
+}
+
+void Fl_Recording_Graphics_Driver::begin_line() {
+  Fl_Graphics_Driver::begin_line();
+  op(REC_BEGIN_LINE);
+}
+
+void Fl_Recording_Graphics_Driver::begin_loop() {
+  Fl_Graphics_Driver::begin_loop();
+  op(REC_BEGIN_LOOP);
+}
+
+void Fl_Recording_Graphics_Driver::begin_polygon() {
+  Fl_Graphics_Driver::begin_polygon();
+  op(REC_BEGIN_POLYGON);
+}
+
+void Fl_Recording_Graphics_Driver::begin_complex_polygon() {
+  Fl_Graphics_Driver::begin_polygon(); // sets the shape type without touching gap_
+  op(REC_BEGIN_COMPLEX_POLYGON);
+}
+
+void Fl_Recording_Graphics_Driver::transformed_vertex0(float x, float y) {
+  op(REC_VERTEX);
+  putf(x + ox_);
+  putf(y + oy_);
+}
+
+void Fl_Recording_Graphics_Driver::gap() {
+  op(REC_GAP);
+}
+
+void Fl_Recording_Graphics_Driver::end_points() {
+  op(REC_END_POINTS);
+}
+
+void Fl_Recording_Graphics_Driver::end_line() {
+  op(REC_END_LINE);
+}
+
+void Fl_Recording_Graphics_Driver::end_loop() {
+  op(REC_END_LOOP);
+}
+
+void Fl_Recording_Graphics_Driver::end_polygon() {
+  op(REC_END_POLYGON);
+}
+
+void Fl_Recording_Graphics_Driver::end_complex_polygon() {
+  op(REC_END_COMPLEX_POLYGON);
+}
+
+void Fl_Recording_Graphics_Driver::circle(double x, double y, double r) {
+  // reduce to the device-space bounding box like the native drivers do
+  double xt = transform_x(x, y);
+  double yt = transform_y(x, y);
+  double rx = r * (m.c ? sqrt(m.a*m.a+m.c*m.c) : fabs(m.a));
+  double ry = r * (m.b ? sqrt(m.b*m.b+m.d*m.d) : fabs(m.d));
+  int llx = (int)rint(xt-rx);
+  int w = (int)rint(xt+rx)-llx;
+  int lly = (int)rint(yt-ry);
+  int h = (int)rint(yt+ry)-lly;
+  int v[] = {what == POLYGON ? 1 : 0, llx+ox_, lly+oy_, w, h};
+  reci(REC_CIRCLE, v, 5);
+}
+
+void Fl_Recording_Graphics_Driver::arc(int x, int y, int w, int h, double a1, double a2) {
+  int v[] = {x+ox_, y+oy_, w, h};
+  reci(REC_ARC, v, 4);
+  putd(a1);
+  putd(a2);
+}
+
+void Fl_Recording_Graphics_Driver::pie(int x, int y, int w, int h, double a1, double a2) {
+  int v[] = {x+ox_, y+oy_, w, h};
+  reci(REC_PIE, v, 4);
+  putd(a1);
+  putd(a2);
+}
+
+void Fl_Recording_Graphics_Driver::record_image(int code, const uchar *buf, int x, int y, int w, int h, int d, int l) {
+  if (w <= 0 || h <= 0) return;
+  if (!l) l = w * d;
+  int v[] = {x+ox_, y+oy_, w, h, d};
+  reci(code, v, 5);
+  for (int j = 0; j < h; j++)
+    putblock(buf + j*l, (size_t)w * d);
+}
+
+void Fl_Recording_Graphics_Driver::draw_image(const uchar *buf, int x, int y, int w, int h, int d, int l) {
+  record_image(REC_IMAGE, buf, x, y, w, h, d, l);
+}
+
+void Fl_Recording_Graphics_Driver::draw_image_mono(const uchar *buf, int x, int y, int w, int h, int d, int l) {
+  record_image(REC_IMAGE_MONO, buf, x, y, w, h, d, l);
+}
+
+void Fl_Recording_Graphics_Driver::draw_image(Fl_Draw_Image_Cb cb, void *data, int x, int y, int w, int h, int d) {
+  if (w <= 0 || h <= 0) return;
+  int v[] = {x+ox_, y+oy_, w, h, d};
+  reci(REC_IMAGE, v, 5);
+  uchar *row = new uchar[(size_t)w * d];
+  for (int j = 0; j < h; j++) {
+    cb(data, 0, j, w, row);
+    putblock(row, (size_t)w * d);
+  }
+  delete[] row;
+}
+
+void Fl_Recording_Graphics_Driver::draw_image_mono(Fl_Draw_Image_Cb cb, void *data, int x, int y, int w, int h, int d) {
+  if (w <= 0 || h <= 0) return;
+  int v[] = {x+ox_, y+oy_, w, h, d};
+  reci(REC_IMAGE_MONO, v, 5);
+  uchar *row = new uchar[(size_t)w * d];
+  for (int j = 0; j < h; j++) {
+    cb(data, 0, j, w, row);
+    putblock(row, (size_t)w * d);
+  }
+  delete[] row;
+}
+
+void Fl_Recording_Graphics_Driver::record_rgb_data(const uchar *array, int dw, int dh, int d, int ld,
+                                                   int w, int h, int XP, int YP, int WP, int HP, int cx, int cy) {
+  if (!ld) ld = dw * d;
+  int v[] = {dw, dh, d, w, h, XP+ox_, YP+oy_, WP, HP, cx, cy};
+  reci(REC_RGB, v, 11);
+  for (int j = 0; j < dh; j++)
+    putblock(array + j*ld, (size_t)dw * d);
+}
+
+void Fl_Recording_Graphics_Driver::draw_rgb(Fl_RGB_Image *rgb, int XP, int YP, int WP, int HP, int cx, int cy) {
+  record_rgb_data(rgb->array, rgb->data_w(), rgb->data_h(), rgb->d(), rgb->ld(),
+                  rgb->w(), rgb->h(), XP, YP, WP, HP, cx, cy);
+}
+
+void Fl_Recording_Graphics_Driver::draw_pixmap(Fl_Pixmap *pxm, int XP, int YP, int WP, int HP, int cx, int cy) {
+  // expand the colormapped data once; the stream only carries RGB(A) images
+  Fl_RGB_Image rgb(pxm);
+  record_rgb_data(rgb.array, rgb.data_w(), rgb.data_h(), rgb.d(), rgb.ld(),
+                  pxm->w(), pxm->h(), XP, YP, WP, HP, cx, cy);
+}
+
+void Fl_Recording_Graphics_Driver::draw_bitmap(Fl_Bitmap *bm, int XP, int YP, int WP, int HP, int cx, int cy) {
+  int dw = bm->data_w(), dh = bm->data_h();
+  int v[] = {dw, dh, bm->w(), bm->h(), XP+ox_, YP+oy_, WP, HP, cx, cy};
+  reci(REC_BITMAP, v, 10);
+  putblock(bm->array, (size_t)((dw+7)/8) * dh);
+}
+
+// ---- replay --------------------------------------------------------------
+
+// Bounds-checked reader over a recorded stream; a malformed or truncated
+// stream turns further reads into no-ops and is reported by the caller.
+class Fl_Recording_Reader {
+public:
+  const uchar *p;
+  const uchar *end;
+  int ok;
+  Fl_Recording_Reader(const uchar *data, size_t n) : p(data), end(data+n), ok(1) {}
+  int left() {return (int)(end - p);}
+  int get8() {
+    if (p >= end) {ok = 0; return 0;}
+    return *p++;
+  }
+  int get32() {
+    int v;
+    if (left() < (int)sizeof(v)) {ok = 0; return 0;}
+    memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return v;
+  }
+  float getf() {
+    float v;
+    if (left() < (int)sizeof(v)) {ok = 0; return 0;}
+    memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return v;
+  }
+  double getd() {
+    double v;
+    if (left() < (int)sizeof(v)) {ok = 0; return 0;}
+    memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return v;
+  }
+  const uchar *getblock(size_t n) {
+    if ((size_t)left() < n) {ok = 0; return NULL;}
+    const uchar *b = p;
+    p += n;
+    return b;
+  }
+};
+
+/**
+ Replays a recorded command stream into the current drawing surface.
+ \p data and \p length describe a stream obtained from data() and size() of an
+ Fl_Recording_Surface, here or on another machine of the same endianness.
+ The commands are drawn through the current surface's graphics driver, so any
+ surface — screen, Fl_Image_Surface, printer, SVG — can rasterize a recording.
+ \return 0 on success, or 1 if the stream was malformed and replay stopped early.
+*/
+int Fl_Recording_Surface::replay(const unsigned char *data, size_t length) {
+  Fl_Recording_Reader r(data, length);
+  while (r.ok && r.p < r.end) {
+    int code = r.get8();
+    switch (code) {
+      case REC_POINT: {
+        int x = r.get32(), y = r.get32();
+        if (r.ok) fl_point(x, y);
+        break;
+      }
+      case REC_RECT: {
+        int x = r.get32(), y = r.get32(), w = r.get32(), h = r.get32();
+        if (r.ok) fl_rect(x, y, w, h);
+        break;
+      }
+      case REC_RECTF: {
+        int x = r.get32(), y = r.get32(), w = r.get32(), h = r.get32();
+        if (r.ok) fl_rectf(x, y, w, h);
+        break;
+      }
+      case REC_LINE: {
+        int x = r.get32(), y = r.get32(), x1 = r.get32(), y1 = r.get32();
+        if (r.ok) fl_line(x, y, x1, y1);
+        break;
+      }
+      case REC_LINE3: {
+        int x = r.get32(), y = r.get32(), x1 = r.get32(), y1 = r.get32(), x2 = r.get32(), y2 = r.get32();
+        if (r.ok) fl_line(x, y, x1, y1, x2, y2);
+        break;
+      }
+      case REC_XYLINE: {
+        int x = r.get32(), y = r.get32(), x1 = r.get32();
+        if (r.ok) fl_xyline(x, y, x1);
+        break;
+      }
+      case REC_XYLINE2: {
+        int x = r.get32(), y = r.get32(), x1 = r.get32(), y2 = r.get32();
+        if (r.ok) fl_xyline(x, y, x1, y2);
+        break;
+      }
+      case REC_XYLINE3: {
+        int x = r.get32(), y = r.get32(), x1 = r.get32(), y2 = r.get32(), x3 = r.get32();
+        if (r.ok) fl_xyline(x, y, x1, y2, x3);
+        break;
+      }
+      case REC_YXLINE: {
+        int x = r.get32(), y = r.get32(), y1 = r.get32();
+        if (r.ok) fl_yxline(x, y, y1);
+        break;
+      }
+      case REC_YXLINE2: {
+        int x = r.get32(), y = r.get32(), y1 = r.get32(), x2 = r.get32();
+        if (r.ok) fl_yxline(x, y, y1, x2);
+        break;
+      }
+      case REC_YXLINE3: {
+        int x = r.get32(), y = r.get32(), y1 = r.get32(), x2 = r.get32(), y3 = r.get32();
+        if (r.ok) fl_yxline(x, y, y1, x2, y3);
+        break;
+      }
+      case REC_LOOP3: {
+        int v[6];
+        for (int i = 0; i < 6; i++) v[i] = r.get32();
+        if (r.ok) fl_loop(v[0], v[1], v[2], v[3], v[4], v[5]);
+        break;
+      }
+      case REC_LOOP4: {
+        int v[8];
+        for (int i = 0; i < 8; i++) v[i] = r.get32();
+        if (r.ok) fl_loop(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+        break;
+      }
+      case REC_POLYGON3: {
+        int v[6];
+        for (int i = 0; i < 6; i++) v[i] = r.get32();
+        if (r.ok) fl_polygon(v[0], v[1], v[2], v[3], v[4], v[5]);
+        break;
+      }
+      case REC_POLYGON4: {
+        int v[8];
+        for (int i = 0; i < 8; i++) v[i] = r.get32();
+        if (r.ok) fl_polygon(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+        break;
+      }
+      case REC_PUSH_CLIP: {
+        int x = r.get32(), y = r.get32(), w = r.get32(), h = r.get32();
+        if (r.ok) fl_push_clip(x, y, w, h);
+        break;
+      }
+      case REC_PUSH_NO_CLIP:
+        fl_push_no_clip();
+        break;
+      case REC_POP_CLIP:
+        fl_pop_clip();
+        break;
+      case REC_COLOR: {
+        int c = r.get32();
+        if (r.ok) fl_color((Fl_Color)c);
+        break;
+      }
+      case REC_COLOR_RGB: {
+        int cr = r.get8(), cg = r.get8(), cb = r.get8();
+        if (r.ok) fl_color((uchar)cr, (uchar)cg, (uchar)cb);
+        break;
+      }
+      case REC_LINE_STYLE: {
+        int style = r.get32(), width = r.get32(), n = r.get32();
+        const uchar *dashes = n ? r.getblock(n) : NULL;
+        if (r.ok) fl_line_style(style, width, (char*)dashes);
+        break;
+      }
+      case REC_FONT: {
+        int face = r.get32(), size = r.get32();
+        if (r.ok) fl_font((Fl_Font)face, (Fl_Fontsize)size);
+        break;
+      }
+      case REC_DRAW: {
+        int n = r.get32();
+        const uchar *str = n ? r.getblock(n) : NULL;
+        int x = r.get32(), y = r.get32();
+        if (r.ok && n) fl_draw((const char*)str, n, x, y);
+        break;
+      }
+      case REC_DRAW_ANGLED: {
+        int angle = r.get32(), n = r.get32();
+        const uchar *str = n ? r.getblock(n) : NULL;
+        int x = r.get32(), y = r.get32();
+        if (r.ok && n) fl_draw(angle, (const char*)str, n, x, y);
+        break;
+      }
+      case REC_RTL_DRAW: {
+        int n = r.get32();
+        const uchar *str = n ? r.getblock(n) : NULL;
+        int x = r.get32(), y = r.get32();
+        if (r.ok && n) fl_rtl_draw((const char*)str, n, x, y);
+        break;
+      }
+      case REC_BEGIN_POINTS:
+        fl_begin_points();
+        break;
+      case REC_BEGIN_LINE:
+        fl_begin_line();
+        break;
+      case REC_BEGIN_LOOP:
+        fl_begin_loop();
+        break;
+      case REC_BEGIN_POLYGON:
+        fl_begin_polygon();
+        break;
+      case REC_BEGIN_COMPLEX_POLYGON:
+        fl_begin_complex_polygon();
+        break;
+      case REC_VERTEX: {
+        float x = r.getf(), y = r.getf();
+        if (r.ok) fl_transformed_vertex(x, y);
+        break;
+      }
+      case REC_GAP:
+        fl_gap();
+        break;
+      case REC_END_POINTS:
+        fl_end_points();
+        break;
+      case REC_END_LINE:
+        fl_end_line();
+        break;
+      case REC_END_LOOP:
+        fl_end_loop();
+        break;
+      case REC_END_POLYGON:
+        fl_end_polygon();
+        break;
+      case REC_END_COMPLEX_POLYGON:
+        fl_end_complex_polygon();
+        break;
+      case REC_CIRCLE: {
+        int filled = r.get32(), x = r.get32(), y = r.get32(), w = r.get32(), h = r.get32();
+        if (r.ok) {
+          if (filled) fl_pie(x, y, w, h, 0, 360);
+          else fl_arc(x, y, w, h, 0, 360);
+        }
+        break;
+      }
+      case REC_ARC: {
+        int x = r.get32(), y = r.get32(), w = r.get32(), h = r.get32();
+        double a1 = r.getd(), a2 = r.getd();
+        if (r.ok) fl_arc(x, y, w, h, a1, a2);
+        break;
+      }
+      case REC_PIE: {
+        int x = r.get32(), y = r.get32(), w = r.get32(), h = r.get32();
+        double a1 = r.getd(), a2 = r.getd();
+        if (r.ok) fl_pie(x, y, w, h, a1, a2);
+        break;
+      }
+      case REC_IMAGE:
+      case REC_IMAGE_MONO: {
+        int x = r.get32(), y = r.get32(), w = r.get32(), h = r.get32(), d = r.get32();
+        if (!r.ok || w <= 0 || h <= 0 || d <= 0) {r.ok = 0; break;}
+        const uchar *pix = r.getblock((size_t)w * d * h);
+        if (!r.ok) break;
+        if (code == REC_IMAGE) fl_draw_image(pix, x, y, w, h, d, 0);
+        else fl_draw_image_mono(pix, x, y, w, h, d, 0);
+        break;
+      }
+      case REC_RGB: {
+        int v[11];
+        for (int i = 0; i < 11; i++) v[i] = r.get32();
+        int dw = v[0], dh = v[1], d = v[2];
+        if (!r.ok || dw <= 0 || dh <= 0 || d <= 0) {r.ok = 0; break;}
+        const uchar *pix = r.getblock((size_t)dw * d * dh);
+        if (!r.ok) break;
+        Fl_RGB_Image img(pix, dw, dh, d);
+        img.scale(v[3], v[4], 0, 1);
+        img.draw(v[5], v[6], v[7], v[8], v[9], v[10]);
+        break;
+      }
+      case REC_BITMAP: {
+        int v[10];
+        for (int i = 0; i < 10; i++) v[i] = r.get32();
+        int dw = v[0], dh = v[1];
+        if (!r.ok || dw <= 0 || dh <= 0) {r.ok = 0; break;}
+        const uchar *bits = r.getblock((size_t)((dw+7)/8) * dh);
+        if (!r.ok) break;
+        Fl_Bitmap bm(bits, dw, dh);
+        bm.scale(v[2], v[3], 0, 1);
+        bm.draw(v[4], v[5], v[6], v[7], v[8], v[9]);
+        break;
+      }
+      default:
+        r.ok = 0;
+        break;
+    }
+  }
+  return r.ok ? 0 : 1;
+}
+
+// ---- Fl_Recording_Surface ------------------------------------------------
+
+/**
+ Constructor of the recording surface.
+ \param width,height Extent of the recorded graphics area in FLTK drawing
+ units, as reported by printable_rect().
+*/
+Fl_Recording_Surface::Fl_Recording_Surface(int width, int height) :
+  Fl_Widget_Surface(new Fl_Recording_Graphics_Driver()) {
+  width_ = width;
+  height_ = height;
+}
+
+Fl_Recording_Surface::~Fl_Recording_Surface() {
+  delete driver();
+}
+
+/** Returns the recorded command stream, or NULL if nothing was recorded.
+ The pointer remains owned by the surface and is invalidated by further
+ drawing into it, by clear() and by destruction. */
+const unsigned char *Fl_Recording_Surface::data() {
+  return ((Fl_Recording_Graphics_Driver*)driver())->data();
+}
+
+/** Returns the length in bytes of the recorded command stream. */
+size_t Fl_Recording_Surface::size() {
+  return ((Fl_Recording_Graphics_Driver*)driver())->stream_length();
+}
+
+/** Discards all recorded commands; the surface can record again afterwards. */
+void Fl_Recording_Surface::clear() {
+  ((Fl_Recording_Graphics_Driver*)driver())->clear_record();
+}
+
+void Fl_Recording_Surface::translate(int x, int y) {
+  ((Fl_Recording_Graphics_Driver*)driver())->translate_record(x, y);
+}
+
+void Fl_Recording_Surface::untranslate() {
+  ((Fl_Recording_Graphics_Driver*)driver())->untranslate_record();
+}
+
+int Fl_Recording_Surface::printable_rect(int *w, int *h) {
+  *w = width_;
+  *h = height_;
+  return 0;
+}
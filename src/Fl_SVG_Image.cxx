@@ -62,6 +62,7 @@ Fl_SVG_Image::Fl_SVG_Image(Fl_SVG_Image *source) : Fl_RGB_Image(NULL, 0, 0, 4) {
 
 /** The destructor frees all memory and server resources that are used by the SVG image. */
 Fl_SVG_Image::~Fl_SVG_Image() {
+  drop_tiles_();
   if ( --counted_svg_image_->ref_count <= 0) {
     nsvgDelete(counted_svg_image_->svg_image);
     delete counted_svg_image_;
@@ -196,6 +197,146 @@ void Fl_SVG_Image::rasterize_(int W, int H) {
 }
 
 
+// Tile cache used by draw_tiled_() for very large rasterizations.
+// Tiles are shared across all Fl_SVG_Image objects and keyed by
+// (image, full raster size, tile column, tile row).
+#define SVG_TILE_SIZE 256                    // tile edge length in pixels
+#define SVG_TILE_THRESHOLD (8*1024*1024)     // full rasters above this many bytes get tiled
+
+size_t Fl_SVG_Image::tile_cache_limit_ = 32*1024*1024;
+
+struct Fl_SVG_Tile {
+  Fl_SVG_Image *owner;
+  int zoom_w, zoom_h;     // size of the full raster this tile is part of
+  int tx, ty;             // tile column and row within that raster
+  Fl_RGB_Image *img;
+  unsigned last_use;
+  Fl_SVG_Tile *next;
+};
+
+static Fl_SVG_Tile *svg_tiles = NULL;
+static size_t svg_tile_bytes = 0;
+static unsigned svg_tile_clock = 0;
+
+
+// Remove and free all cached tiles belonging to this image.
+void Fl_SVG_Image::drop_tiles_() {
+  Fl_SVG_Tile **p = &svg_tiles;
+  while (*p) {
+    if ((*p)->owner == this) {
+      Fl_SVG_Tile *t = *p;
+      *p = t->next;
+      svg_tile_bytes -= (size_t)t->img->data_w() * t->img->data_h() * 4;
+      delete t->img;
+      delete t;
+    } else {
+      p = &(*p)->next;
+    }
+  }
+}
+
+
+// Draw the image rasterizing only the tiles that intersect the current clip,
+// instead of rasterizing a full W2 x H2 buffer. Only called when one image
+// pixel maps to one FLTK unit, so tiles can be drawn at their pixel position.
+void Fl_SVG_Image::draw_tiled_(int X, int Y, int W, int H, int cx, int cy, int W2, int H2) {
+  static NSVGrasterizer *rasterizer = nsvgCreateRasterizer();
+  NSVGimage *svg = counted_svg_image_->svg_image;
+  double fx, fy;
+  if (proportional) {
+    fx = svg_scaling_(W2, H2);
+    fy = fx;
+    W2 = int(svg->width * fx + 0.5);
+    H2 = int(svg->height * fy + 0.5);
+  } else {
+    fx = (double)W2 / svg->width;
+    fy = (double)H2 / svg->height;
+  }
+  // compute the visible part of the image in image pixel coordinates
+  int bx, by, bw, bh;
+  fl_clip_box(X, Y, W, H, bx, by, bw, bh);
+  if (bw <= 0 || bh <= 0) return;
+  int ox = X - cx, oy = Y - cy; // where image pixel (0,0) lands on screen
+  int ix0 = bx - ox, iy0 = by - oy;
+  int ix1 = ix0 + bw - 1, iy1 = iy0 + bh - 1;
+  if (ix0 < 0) ix0 = 0;
+  if (iy0 < 0) iy0 = 0;
+  if (ix1 >= W2) ix1 = W2 - 1;
+  if (iy1 >= H2) iy1 = H2 - 1;
+  if (ix0 > ix1 || iy0 > iy1) return;
+  unsigned now = ++svg_tile_clock;
+  for (int ty = iy0 / SVG_TILE_SIZE; ty <= iy1 / SVG_TILE_SIZE; ty++) {
+    for (int tx = ix0 / SVG_TILE_SIZE; tx <= ix1 / SVG_TILE_SIZE; tx++) {
+      Fl_SVG_Tile *t;
+      for (t = svg_tiles; t; t = t->next) {
+        if (t->owner == this && t->zoom_w == W2 && t->zoom_h == H2 &&
+            t->tx == tx && t->ty == ty) break;
+      }
+      if (!t) {
+        int px = tx * SVG_TILE_SIZE, py = ty * SVG_TILE_SIZE;
+        int tw = W2 - px; if (tw > SVG_TILE_SIZE) tw = SVG_TILE_SIZE;
+        int th = H2 - py; if (th > SVG_TILE_SIZE) th = SVG_TILE_SIZE;
+        uchar *buf = new uchar[tw * th * 4];
+        memset(buf, 0, tw * th * 4);
+        nsvgRasterizeXY(rasterizer, svg, float(-px), float(-py), float(fx), float(fy),
+                        buf, tw, th, tw * 4);
+        t = new Fl_SVG_Tile;
+        t->owner = this;
+        t->zoom_w = W2; t->zoom_h = H2;
+        t->tx = tx; t->ty = ty;
+        t->img = new Fl_RGB_Image(buf, tw, th, 4);
+        t->img->alloc_array = 1;
+        if (to_desaturate_) t->img->desaturate();
+        if (average_weight_ < 1) t->img->color_average(average_color_, average_weight_);
+        t->next = svg_tiles;
+        svg_tiles = t;
+        svg_tile_bytes += (size_t)tw * th * 4;
+      }
+      t->last_use = now;
+      t->img->draw(ox + t->tx * SVG_TILE_SIZE, oy + t->ty * SVG_TILE_SIZE);
+    }
+  }
+  // shrink the cache back to its byte budget, dropping the least-recently-drawn
+  // tiles first; tiles stamped during this draw are never dropped
+  while (svg_tile_bytes > tile_cache_limit_) {
+    Fl_SVG_Tile **p, **victim = NULL;
+    for (p = &svg_tiles; *p; p = &(*p)->next) {
+      if ((*p)->last_use != now && (!victim || (*p)->last_use < (*victim)->last_use))
+        victim = p;
+    }
+    if (!victim) break;
+    Fl_SVG_Tile *t = *victim;
+    *victim = t->next;
+    svg_tile_bytes -= (size_t)t->img->data_w() * t->img->data_h() * 4;
+    delete t->img;
+    delete t;
+  }
+}
+
+
+/** Sets the byte budget of the tile cache used when drawing very large SVG images.
+ When the rasterization of an Fl_SVG_Image at its drawing resolution would exceed
+ 8 megabytes, the image is not rasterized as a whole; instead, only the tiles of
+ 256x256 pixels that intersect the current clip region are rasterized and drawn.
+ Tiles are kept in a cache shared by all Fl_SVG_Image objects, so panning or
+ redrawing reuses them; when the cache exceeds \p bytes, the least-recently-drawn
+ tiles are discarded first. The default budget is 32 megabytes.
+ \version 1.4.0
+ */
+void Fl_SVG_Image::tile_cache_limit(size_t bytes) {
+  tile_cache_limit_ = bytes;
+}
+
+
+/** Returns the byte budget of the SVG tile cache.
+ \see tile_cache_limit(size_t)
+ \version 1.4.0
+ */
+size_t Fl_SVG_Image::tile_cache_limit() {
+  return tile_cache_limit_;
+}
+
+
 Fl_Image *Fl_SVG_Image::copy(int W, int H) {
   Fl_SVG_Image *svg2 = new Fl_SVG_Image(this);
   svg2->to_desaturate_ = to_desaturate_;
@@ -258,6 +399,12 @@ void Fl_SVG_Image::draw(int X, int Y, int W, int H, int cx, int cy) {
   int f = fl_graphics_driver->has_feature(Fl_Graphics_Driver::PRINTER) ? 2 : 1;
   int w2 = f*w(), h2 = f*h();
   fl_graphics_driver->cache_size(this, w2, h2);
+  if (ld() >= 0 && w2 == w1 && h2 == h1 && (size_t)w2 * h2 * 4 > SVG_TILE_THRESHOLD) {
+    // Very large image drawn at 1:1 pixel scale: rasterize lazily, by tiles,
+    // only where the clip requires it, instead of the whole image.
+    draw_tiled_(X, Y, W, H, cx, cy, w2, h2);
+    return;
+  }
   resize(w2, h2);
   scale(w1, h1, 0, 1);
   Fl_RGB_Image::draw(X, Y, W, H, cx, cy);
@@ -266,6 +413,7 @@ void Fl_SVG_Image::draw(int X, int Y, int W, int H, int cx, int cy) {
 
 void Fl_SVG_Image::desaturate() {
   to_desaturate_ = true;
+  drop_tiles_();
   Fl_RGB_Image::desaturate();
 }
 
@@ -273,6 +421,7 @@ void Fl_SVG_Image::desaturate() {
 void Fl_SVG_Image::color_average(Fl_Color c, float i) {
   average_color_ = c;
   average_weight_ = i;
+  drop_tiles_();
   Fl_RGB_Image::color_average(c, i);
 }
 
@@ -235,14 +235,39 @@ void Fl_Scroll::bbox(int& X, int& Y, int& W, int& H) {
   }
 }
 
+// Return whether all values land on exact device pixels at the given
+// scale factor. When they do, copying the pixels of the scroll area gives
+// the same result as redrawing the content at its shifted position, even
+// for fractional scale factors.
+static int on_pixel_boundaries(float s, const int *v, int n) {
+  for (int i = 0; i < n; i++) {
+    float p = v[i] * s;
+    float r = (float)(int)(p >= 0 ? p + 0.5f : p - 0.5f); // nearest integer
+    if (p - r > 0.001f || r - p > 0.001f) return 0;
+  }
+  return 1;
+}
+
 void Fl_Scroll::draw() {
   fix_scrollbar_order();
   int X,Y,W,H; bbox(X,Y,W,H);
 
   uchar d = damage();
 
+  // Scrolling by copying pixels is exact for integer scale factors; for
+  // fractional ones it is still exact if the area and the scroll offsets
+  // all map to whole device pixels, so don't fall back to a full redraw
+  // in that case (scrolling by an odd amount at a scale of 1.5 is what
+  // breaks the condition, not the scale factor as such).
   float scale = Fl_Surface_Device::surface()->driver()->scale();
-  if ((d & FL_DAMAGE_ALL) || scale != int(scale)) { // full redraw
+  int can_blit = (scale == int(scale));
+  if (!can_blit) {
+    int v[6];
+    v[0] = X; v[1] = Y; v[2] = W; v[3] = H;
+    v[4] = oldx - xposition_; v[5] = oldy - yposition_;
+    can_blit = on_pixel_boundaries(scale, v, 6);
+  }
+  if ((d & FL_DAMAGE_ALL) || !can_blit) { // full redraw
     draw_box(box(),x(),y(),w(),h(),color());
     draw_clip(this, X, Y, W, H);
   } else {
@@ -14,11 +14,17 @@
 //     https://www.fltk.org/bugs.php
 //
 
+#include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <FL/fl_utf8.h>
 #include "flstring.h"
 
+#ifdef HAVE_PTHREAD
+#  include <pthread.h>
+#  include <unistd.h>
+#endif // HAVE_PTHREAD
+
 #include <FL/Fl.H>
 #include <FL/Fl_Shared_Image.H>
 #include <FL/Fl_XBM_Image.H>
@@ -38,6 +44,33 @@ Fl_Shared_Handler *Fl_Shared_Image::handlers_ = 0;// Additional format handlers
 int     Fl_Shared_Image::num_handlers_ = 0;     // Number of format handlers
 int     Fl_Shared_Image::alloc_handlers_ = 0;   // Allocated format handlers
 
+size_t  Fl_Shared_Image::cache_limit_ = 0;      // Cache byte budget, 0 = unbounded
+size_t  Fl_Shared_Image::mem_used_ = 0;         // Pixel bytes held by all shared images
+unsigned Fl_Shared_Image::lru_clock_ = 0;       // Monotonic counter for LRU ordering
+
+
+//
+// Background loading (see Fl_Shared_Image::get_async())...
+//
+
+// One queued load. The job holds a reference on 'target' so the record
+// survives until the load lands, even if the application released it.
+struct Fl_Shared_Image_Job {
+  Fl_Shared_Image       *target;        // Placeholder waiting for its pixels
+  Fl_Shared_Image_Callback *cb;         // Completion callback, can be NULL
+  void                  *cbdata;        // User data for the callback
+  Fl_Image              *result;        // Decoded image, set by the worker
+  Fl_Shared_Image_Job   *next;          // Next queued job
+};
+
+#ifdef HAVE_PTHREAD
+static Fl_Shared_Image_Job *async_queue_head = 0;
+static Fl_Shared_Image_Job *async_queue_tail = 0;
+static pthread_mutex_t async_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  async_cond  = PTHREAD_COND_INITIALIZER;
+static int async_workers_running = 0;   // only touched by the main thread
+#endif // HAVE_PTHREAD
+
 
 //
 // Typedef the C API sort function type the only way I know how...
@@ -121,6 +154,10 @@ Fl_Shared_Image::Fl_Shared_Image() : Fl_Image(0,0,0) {
   original_    = 0;
   image_       = 0;
   alloc_image_ = 0;
+  mem_size_    = 0;
+  lru_last_    = 0;
+  pinned_      = 0;
+  evicted_     = 0;
 }
 
 
@@ -141,6 +178,10 @@ Fl_Shared_Image::Fl_Shared_Image(const char *n,         // I - Filename
   image_       = img;
   alloc_image_ = !img;
   original_    = 1;
+  mem_size_    = 0;
+  lru_last_    = 0;
+  pinned_      = 0;
+  evicted_     = 0;
 
   if (!img) reload();
   else update();
@@ -195,6 +236,62 @@ Fl_Shared_Image::update() {
     d(image_->d());
     data(image_->data(), image_->count());
   }
+  // Keep the cache byte accounting in step with the pixel data
+  mem_used_ -= mem_size_;
+  mem_size_ = image_ ?
+    (size_t)image_->data_w() * image_->data_h() * image_->d() : 0;
+  mem_used_ += mem_size_;
+}
+
+
+// Record a use of this image for the LRU eviction order.
+void
+Fl_Shared_Image::touch() {
+  lru_last_ = ++lru_clock_;
+}
+
+
+/*
+ Drop the pixel data of this image while keeping its record (and the
+ pointers the application holds to it) valid. The data is loaded again
+ from name_ the next time the image is drawn.
+*/
+void
+Fl_Shared_Image::evict() {
+  if (!image_) return;
+  if (alloc_image_) delete image_;
+  image_ = 0;
+  alloc_image_ = 0;
+  // update() pointed data() at the pixel arrays just deleted; clear it so
+  // callers see an empty image instead of freed memory until reload()
+  data(0, 0);
+  mem_used_ -= mem_size_;
+  mem_size_ = 0;
+  evicted_ = 1;
+}
+
+
+/*
+ Evict least-recently-used images until the cache fits into the byte
+ budget. Only original images loaded from a file can be evicted: they
+ can be reloaded on demand, while copies and pinned images cannot.
+*/
+void
+Fl_Shared_Image::enforce_cache_limit() {
+  if (!cache_limit_) return;
+  while (mem_used_ > cache_limit_) {
+    Fl_Shared_Image *victim = 0;
+    for (int i = 0; i < num_images_; i ++) {
+      Fl_Shared_Image *img = images_[i];
+      if (!img->image_ || img->pinned_ || !img->original_ ||
+          !img->alloc_image_ || !img->name_)
+        continue;
+      if (!victim || img->lru_last_ < victim->lru_last_)
+        victim = img;
+    }
+    if (!victim) break;      // nothing left that may be evicted
+    victim->evict();
+  }
 }
 
 /**
@@ -207,6 +304,7 @@ Fl_Shared_Image::update() {
 Fl_Shared_Image::~Fl_Shared_Image() {
   if (name_) delete[] (char *)name_;
   if (alloc_image_) delete image_;
+  mem_used_ -= mem_size_;
 }
 
 
@@ -245,42 +343,57 @@ void Fl_Shared_Image::release() {
 }
 
 
-/** Reloads the shared image from disk. */
-void Fl_Shared_Image::reload() {
-  // Load image from disk...
+/*
+ Load an image from a file, trying XBM, XPM and the registered handlers.
+ This is used by reload() and by the background loader; for asynchronous
+ loads it runs on the worker thread, so it must not touch the shared
+ image list.
+*/
+Fl_Image *Fl_Shared_Image::load_from_file_(const char *name) {
   int           i;              // Looping var
   FILE          *fp;            // File pointer
   uchar         header[64];     // Buffer for auto-detecting files
   Fl_Image      *img;           // New image
 
-  if (!name_) return;
-
-  if ((fp = fl_fopen(name_, "rb")) != NULL) {
+  if ((fp = fl_fopen(name, "rb")) != NULL) {
     if (fread(header, 1, sizeof(header), fp)==0) { /* ignore */ }
     fclose(fp);
   } else {
-    return;
+    return 0;
   }
 
   // Load the image as appropriate...
   if (memcmp(header, "#define", 7) == 0) // XBM file
-    img = new Fl_XBM_Image(name_);
+    img = new Fl_XBM_Image(name);
   else if (memcmp(header, "/* XPM */", 9) == 0) // XPM file
-    img = new Fl_XPM_Image(name_);
+    img = new Fl_XPM_Image(name);
   else {
     // Not a standard format; try an image handler...
     for (i = 0, img = 0; i < num_handlers_; i ++) {
-      img = (handlers_[i])(name_, header, sizeof(header));
+      img = (handlers_[i])(name, header, sizeof(header));
 
       if (img) break;
     }
   }
 
+  return img;
+}
+
+
+/** Reloads the shared image from disk. */
+void Fl_Shared_Image::reload() {
+  Fl_Image      *img;           // New image
+
+  if (!name_) return;
+
+  img = load_from_file_(name_);
+
   if (img) {
     if (alloc_image_) delete image_;
 
     alloc_image_ = 1;
     image_ = img;
+    evicted_ = 0;
     int W = w();
     int H = h();
     update();
@@ -352,6 +465,12 @@ Fl_Shared_Image::desaturate() {
 // 'Fl_Shared_Image::draw()' - Draw a shared image...
 //
 void Fl_Shared_Image::draw(int X, int Y, int W, int H, int cx, int cy) {
+  // Bring back the pixel data of an image the cache evicted...
+  if (!image_ && evicted_) {
+    reload();
+    enforce_cache_limit();
+  }
+  touch();
   if (!image_) {
     Fl_Image::draw(X, Y, W, H, cx, cy);
     return;
@@ -410,6 +529,7 @@ Fl_Shared_Image* Fl_Shared_Image::find(const char *name, int W, int H) {
 
     if (match) {
       (*match)->refcount_ ++;
+      (*match)->touch();
       return *match;
     }
   }
@@ -474,6 +594,9 @@ Fl_Shared_Image* Fl_Shared_Image::get(const char *name, int W, int H) {
     temp->add();
   }
 
+  temp->touch();
+  enforce_cache_limit();
+
   return temp;
 }
 
@@ -489,11 +612,248 @@ Fl_Shared_Image *Fl_Shared_Image::get(Fl_RGB_Image *rgb, int own_it)
 {
   Fl_Shared_Image *shared = new Fl_Shared_Image(Fl_Preferences::newUUID(), rgb);
   shared->alloc_image_ = own_it;
+  // The image has no file to be reloaded from, exempt it from cache eviction
+  shared->pinned_ = 1;
   shared->add();
   return shared;
 }
 
 
+#ifdef HAVE_PTHREAD
+/*
+ The background loader thread: takes the next queued job, does the file
+ I/O and decode, and hands the finished job back to the main thread.
+*/
+void *Fl_Shared_Image::async_worker_(void *) {
+  for (;;) {
+    pthread_mutex_lock(&async_mutex);
+    while (!async_queue_head)
+      pthread_cond_wait(&async_cond, &async_mutex);
+    Fl_Shared_Image_Job *job = async_queue_head;
+    async_queue_head = job->next;
+    if (!async_queue_head) async_queue_tail = 0;
+    pthread_mutex_unlock(&async_mutex);
+
+    job->result = load_from_file_(job->target->name());
+
+    // Deliver the job to the main thread; retry if the message
+    // queue is momentarily full.
+    while (Fl::awake(async_done_, job) != 0)
+      usleep(1000);
+  }
+  return 0;
+}
+#endif // HAVE_PTHREAD
+
+
+/*
+ Runs on the main thread (via Fl::awake()) when a background load is
+ done: attaches the decoded image to the waiting record and enters it
+ into the cache, or discards everything if the application released the
+ image while the load was in flight.
+*/
+void Fl_Shared_Image::async_done_(void *data) {
+  Fl_Shared_Image_Job *job = (Fl_Shared_Image_Job *)data;
+  Fl_Shared_Image *img = job->target;
+
+  if (img->refcount_ <= 1) {
+    // Cancelled: only the loader's reference is left
+    if (job->result) delete job->result;
+    img->release();
+  } else {
+    if (job->result) {
+      if (img->alloc_image_) delete img->image_;
+      img->image_ = job->result;
+      img->alloc_image_ = 1;
+      img->update();
+      img->add();
+      img->touch();
+      enforce_cache_limit();
+    }
+    img->release();             // the loader's reference; the caller still holds one
+    if (job->cb) (job->cb)(img, job->cbdata);
+  }
+
+  delete job;
+}
+
+
+/** Finds or loads an image in the background.
+
+  Like Fl_Shared_Image::get(const char *, int, int), but the file I/O
+  and decoding run on a worker thread, so the caller - typically a
+  redraw of a browser or grid - never blocks on the disk. The returned
+  image is an empty placeholder (w() and h() are 0, drawing it shows
+  nothing) until the load completes; \p cb is then invoked on the main
+  thread, from which it can redraw the widgets showing the image. If
+  loading fails, \p cb receives the still-empty record.
+
+  If the image is already cached, \p cb is invoked immediately and the
+  cached image is returned.
+
+  As with get(), the returned image must be released with release()
+  when no longer needed. Releasing it while the load is still in flight
+  safely cancels the request: the callback is not invoked and the
+  decoded data is discarded.
+
+  On platforms without thread support the image is loaded synchronously
+  and \p cb is invoked before this method returns.
+
+  \note The format handlers registered with add_handler() run on the
+  worker thread for asynchronous loads. The handlers installed by
+  fl_register_images() are safe; custom handlers must not touch FLTK
+  widgets or other shared state without locking.
+
+  \param name   name of the image file
+  \param cb     completion callback, or NULL
+  \param cbdata user data passed to the callback
+
+  \returns the cached image or a placeholder that fills in later,
+           or NULL if no loader could be started.
+
+  \since FLTK 1.4.0
+*/
+Fl_Shared_Image *Fl_Shared_Image::get_async(const char *name,
+                                            Fl_Shared_Image_Callback *cb,
+                                            void *cbdata) {
+  Fl_Shared_Image *temp;        // Image
+
+  // Already cached: deliver right away...
+  if ((temp = find(name)) != NULL) {
+    if (cb) (*cb)(temp, cbdata);
+    return temp;
+  }
+
+#ifdef HAVE_PTHREAD
+  // Make sure FLTK's thread support and the worker pool exist. One
+  // worker per processor lets a burst of queued loads saturate the
+  // machine instead of trickling through a single thread.
+  if (!async_workers_running) {
+    Fl::lock();                 // enables Fl::awake() message delivery
+    Fl::unlock();
+    int want = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu > 1) want = (int)ncpu;
+#endif
+    for (int i = 0; i < want; i++) {
+      pthread_t worker;
+      if (pthread_create(&worker, 0, async_worker_, 0) == 0) {
+        pthread_detach(worker);
+        async_workers_running++;
+      }
+    }
+  }
+
+  if (async_workers_running) {
+    // Create the placeholder; it joins the cache once its pixels land
+    temp = new Fl_Shared_Image();
+    temp->name_ = new char[strlen(name) + 1];
+    strcpy((char *)temp->name_, name);
+    temp->original_ = 1;
+    temp->refcount_ = 2;        // one for the caller, one for the loader
+
+    Fl_Shared_Image_Job *job = new Fl_Shared_Image_Job;
+    job->target = temp;
+    job->cb     = cb;
+    job->cbdata = cbdata;
+    job->result = 0;
+    job->next   = 0;
+
+    pthread_mutex_lock(&async_mutex);
+    if (async_queue_tail) async_queue_tail->next = job;
+    else async_queue_head = job;
+    async_queue_tail = job;
+    pthread_cond_signal(&async_cond);
+    pthread_mutex_unlock(&async_mutex);
+
+    return temp;
+  }
+#endif // HAVE_PTHREAD
+
+  // No worker available: load synchronously as get() would
+  temp = get(name);
+  if (temp && cb) (*cb)(temp, cbdata);
+  return temp;
+}
+
+
+void Fl_Image_Future::done_cb_(Fl_Shared_Image *, void *data) {
+  ((Fl_Image_Future *)data)->done_ = 1;
+}
+
+
+/** Queues the image file \p name on the decode worker pool.
+
+  The constructor returns immediately; the decode runs in the
+  background. If the image is already in the shared image cache, or no
+  worker could be started and the file was loaded synchronously, the
+  future is ready() right away.
+
+  \param name name of the image file
+*/
+Fl_Image_Future::Fl_Image_Future(const char *name) {
+  done_ = 0;
+  image_ = Fl_Shared_Image::get_async(name, done_cb_, this);
+  if (!image_) done_ = 1;       // no loader - get() will return NULL
+}
+
+
+/** Releases the underlying image.
+
+  If the load is still in flight it is cancelled: the decoded data is
+  discarded when the worker finishes and nothing is entered into the
+  cache. A result obtained from get() stays valid only while the
+  application holds its own reference on it.
+*/
+Fl_Image_Future::~Fl_Image_Future() {
+  if (image_) image_->release();
+}
+
+
+/** Waits for the decode to finish and returns the image.
+
+  Runs the FLTK event loop (Fl::wait()) until the image has arrived,
+  so other events keep being serviced; ready() tells whether get()
+  would return immediately. Call it on the main thread only.
+
+  \returns the loaded image - empty if the file could not be decoded -
+           or NULL if no loader could be started.
+*/
+Fl_Shared_Image *Fl_Image_Future::get() {
+  while (!done_) Fl::wait();
+  return image_;
+}
+
+
+/** Limits the memory used by the shared image cache.
+
+  \p bytes is a budget for the pixel data held by all shared images,
+  0 (the default) leaves the cache unbounded. Whenever the budget is
+  exceeded, the least recently used images are evicted until the cache
+  fits: their pixel data is dropped while their record - and every
+  Fl_Shared_Image pointer the application holds - stays valid, and the
+  data is transparently reloaded from the image file the next time such
+  an image is drawn. This keeps the memory of long-running applications
+  bounded while recently displayed images remain hot in the cache.
+
+  Only original images loaded from a file are evicted, since resized
+  copies and images built from memory cannot be restored on demand.
+  Individual images can be exempted with Fl_Shared_Image::pinned(char).
+
+  \param bytes cache budget for pixel data, in bytes, or 0 for unbounded
+
+  \see Fl_Shared_Image::cache_usage()
+  \see Fl_Shared_Image::pinned(char)
+
+  \since FLTK 1.4.0
+*/
+void Fl_Shared_Image::cache_limit(size_t bytes) {
+  cache_limit_ = bytes;
+  enforce_cache_limit();
+}
+
+
 /** Adds a shared image handler, which is basically a test function
     for adding new formats.
 */
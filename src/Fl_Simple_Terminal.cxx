@@ -64,6 +64,22 @@ static int strcnt(const char *s, char c) {
   return count;
 }
 
+// One parsed feed() chunk in flight from a producer thread to the main thread
+struct Feed_Chunk {
+  Fl_Simple_Terminal *tty;  // destination widget
+  char *text;               // parsed text (ansi codes removed)
+  char *style;              // one style byte per text byte (NULL when ansi() is off)
+  int nlines;               // # of newlines in text
+  bool cleared;             // "\033[2J" seen: clear the screen before appending
+};
+
+// All live Fl_Simple_Terminal widgets. Only ever touched on the main thread,
+// so feed_chunk_cb() can tell without locking when a queued feed() chunk
+// outlived its widget.
+static Fl_Simple_Terminal **feed_terminals = 0;
+static int nfeed_terminals = 0;
+static int afeed_terminals = 0;
+
 // Vertical scrollbar callback intercept
 void Fl_Simple_Terminal::vscroll_cb2(Fl_Widget *w, void*) {
   scrolling = 1;
@@ -106,6 +122,16 @@ Fl_Simple_Terminal::Fl_Simple_Terminal(int X,int Y,int W,int H,const char *l) :
   stable_size_ = builtin_stable_size;
   normal_style_index_  = builtin_normal_index;
   current_style_index_ = builtin_normal_index;
+  // feed() producer state
+  feed_style_index_ = builtin_normal_index;
+  feed_carry_len_ = 0;
+  // Register for feed_chunk_cb()
+  if ( nfeed_terminals >= afeed_terminals ) {
+    afeed_terminals = afeed_terminals ? afeed_terminals*2 : 8;
+    feed_terminals = (Fl_Simple_Terminal**)realloc(feed_terminals,
+                                                   afeed_terminals*sizeof(Fl_Simple_Terminal*));
+  }
+  feed_terminals[nfeed_terminals++] = this;
   // Intercept vertical scrolling
   orig_vscroll_cb = mVScrollBar->callback();
   orig_vscroll_data = mVScrollBar->user_data();
@@ -117,6 +143,13 @@ Fl_Simple_Terminal::Fl_Simple_Terminal(int X,int Y,int W,int H,const char *l) :
  for the terminal, including text buffer, style buffer, etc.
 */
 Fl_Simple_Terminal::~Fl_Simple_Terminal() {
+  // Unregister, so a feed() chunk still queued for us is dropped safely
+  for ( int i=0; i<nfeed_terminals; i++ ) {
+    if ( feed_terminals[i] == this ) {
+      feed_terminals[i] = feed_terminals[--nfeed_terminals];
+      break;
+    }
+  }
   buffer(0);    // disassociate buffer /before/ we delete it
   if ( buf  ) { delete buf;  buf  = 0; }
   if ( sbuf ) { delete sbuf; sbuf = 0; }
@@ -484,17 +517,129 @@ void Fl_Simple_Terminal::enforce_stay_at_bottom() {
  Enforce 'history_lines' limit on the history buffer by trimming off
  lines from the top of the buffer.
 
+ Trimming the top of the text buffer moves all of the text being kept,
+ so when the limit is exceeded, an extra 10% of the history is trimmed
+ along with the excess. The next appends then stay below the limit
+ without any trimming at all, which keeps the cost of appending a line
+ amortized constant even when the terminal is at its history limit;
+ trimming exactly to the limit made bursts of appends quadratic.
+ history_lines() is a maximum, and is never exceeded.
+
  This is a protected member called automatically by the public API functions.
  Only internal methods or subclasses adjusting the internal buffer directly
  should need to call this.
 */
 void Fl_Simple_Terminal::enforce_history_lines() {
   if ( history_lines() > -1 && lines > history_lines() ) {
-    int trimlines = lines - history_lines();
+    int trimlines = lines - history_lines() + (history_lines() / 10);
+    if ( trimlines > lines ) trimlines = lines;
     remove_lines(0, trimlines);                         // remove lines from top
   }
 }
 
+/**
+ Parses ANSI sequences in 's' into newly allocated text and style memory.
+
+ This is the terminal's ANSI state machine, factored out of append() so that
+ feed() can run it on a producer thread. It touches no widget state: the
+ running style is carried in \p style_index (in/out), and a "\033[2J" clear
+ screen sequence is only recorded in \p cleared -- the caller clears the
+ buffers. On return \p ntm_ret and \p nsm_ret hold the filtered text and its
+ style bytes (one per text byte), both NUL terminated and to be free()d by
+ the caller, and \p nlines is the number of newlines in the returned text.
+*/
+void Fl_Simple_Terminal::parse_ansi(const char *s, int len, int &style_index,
+                                    char *&ntm_ret, char *&nsm_ret,
+                                    int &nlines, bool &cleared) {
+  int nstyles = stable_size_ / STE_SIZE;
+  // New text buffer (after ansi codes parsed+removed)
+  char *ntm = (char*)malloc(len+1);       // new text memory
+  char *ntp = ntm;
+  char *nsm = (char*)malloc(len+1);       // new style memory
+  char *nsp = nsm;
+  // ANSI values
+  char astyle = 'A'+style_index;          // the running style index
+  const char *esc = 0;
+  const char *sp = s;
+  const char *end = s + len;
+  nlines = 0;
+  cleared = false;
+  // Walk the string looking for codes, modify new text/style text as needed
+  while ( sp < end && *sp ) {
+    if ( *sp == 033 ) {        // "\033.."
+      esc = sp++;
+      switch (*sp) {
+        case 0:                // "\033<NUL>"? stop
+          continue;
+        case '[': {            // "\033[.."
+          ++sp;
+          int vals[4], tv=0, seqdone=0;
+          while ( sp < end && *sp && !seqdone && isdigit(*sp) ) { // "\033[#;#.."
+            char *newsp;
+            long a = strtol(sp, &newsp, 10);
+            sp = newsp;
+            vals[tv++] = (a<0) ? 0 : a;       // prevent negative values
+            if ( tv >= 4 )      // too many #'s specified? abort sequence
+              { seqdone = 1; sp = esc+1; continue; }
+            switch(*sp) {
+              case ';':         // numeric separator
+                ++sp;
+                continue;
+              case 'J':         // erase in display
+                switch (vals[0]) {
+                  case 0:       // \033[0J -- clear to eol
+                    // unsupported
+                    break;
+                  case 1:       // \033[1J -- clear to sol
+                    // unsupported
+                    break;
+                  case 2:       // \033[2J -- clear entire screen
+                    cleared = true; // caller clears the text buffer
+                    ntp = ntm;  // clear text contents accumulated so far
+                    nsp = nsm;  // clear style contents ""
+                    nlines = 0;
+                    break;
+                }
+                ++sp;
+                seqdone = 1;
+                continue;
+              case 'm':         // set color
+                if ( tv > 0 ) { // at least one value parsed?
+                  style_index = (vals[0] == 0)            // "reset"?
+                                  ? normal_style_index_   // use normal color for "reset"
+                                  : (vals[0] % nstyles);  // use user's value, wrapped to ensure not larger than table
+                  astyle = 'A' + style_index;             // convert index -> style buffer char
+                }
+                ++sp;
+                seqdone = 1;
+                continue;
+              case '\0':        // EOS in middle of sequence?
+                *ntp = 0;       // end of text
+                *nsp = 0;       // end of style
+                seqdone = 1;
+                continue;
+              default:          // un-supported cmd?
+                seqdone = 1;
+                sp = esc+1;     // continue parsing just past esc
+                break;
+            }   // switch
+          }     // while
+        }       // case '['
+      }         // switch
+    }           // \033
+    else {
+      // Non-ANSI character?
+      if ( *sp == '\n' ) ++nlines; // keep track of #lines
+      *ntp++ = *sp++;              // pass char thru
+      *nsp++ = astyle;             // use current style
+    }
+  } // while
+  *ntp = 0;
+  *nsp = 0;
+  ntm_ret = ntm;
+  nsm_ret = nsm;
+}
+
 /**
  Appends new string 's' to terminal.
 
@@ -511,88 +656,15 @@ void Fl_Simple_Terminal::enforce_history_lines() {
 void Fl_Simple_Terminal::append(const char *s, int len) {
   // Remove ansi codes and adjust style buffer accordingly.
   if ( ansi() ) {
-    int nstyles = stable_size_ / STE_SIZE;
     if ( len < 0 ) len = (int)strlen(s);
-    // New text buffer (after ansi codes parsed+removed)
-    char *ntm = (char*)malloc(len+1);       // new text memory
-    char *ntp = ntm;
-    char *nsm = (char*)malloc(len+1);       // new style memory
-    char *nsp = nsm;
-    // ANSI values
-    char astyle = 'A'+current_style_index_; // the running style index
-    const char *esc = 0;
-    const char *sp = s;
-    // Walk user's string looking for codes, modify new text/style text as needed
-    while ( *sp ) {
-      if ( *sp == 033 ) {        // "\033.."
-        esc = sp++;
-        switch (*sp) {
-          case 0:                // "\033<NUL>"? stop
-            continue;
-          case '[': {            // "\033[.."
-            ++sp;
-            int vals[4], tv=0, seqdone=0;
-            while ( *sp && !seqdone && isdigit(*sp) ) { // "\033[#;#.."
-              char *newsp;
-              long a = strtol(sp, &newsp, 10);
-              sp = newsp;
-              vals[tv++] = (a<0) ? 0 : a;       // prevent negative values
-              if ( tv >= 4 )      // too many #'s specified? abort sequence
-                { seqdone = 1; sp = esc+1; continue; }
-              switch(*sp) {
-                case ';':         // numeric separator
-                  ++sp;
-                  continue;
-                case 'J':         // erase in display
-                  switch (vals[0]) {
-                    case 0:       // \033[0J -- clear to eol
-                      // unsupported
-                      break;
-                    case 1:       // \033[1J -- clear to sol
-                      // unsupported
-                      break;
-                    case 2:       // \033[2J -- clear entire screen
-                      clear();    // clear text buffer
-                      ntp = ntm;  // clear text contents accumulated so far
-                      nsp = nsm;  // clear style contents ""
-                      break;
-                  }
-                  ++sp;
-                  seqdone = 1;
-                  continue;
-                case 'm':         // set color
-                  if ( tv > 0 ) { // at least one value parsed?
-                    current_style_index_ = (vals[0] == 0)            // "reset"?
-                                             ? normal_style_index_   // use normal color for "reset"
-                                             : (vals[0] % nstyles);  // use user's value, wrapped to ensure not larger than table
-                    astyle = 'A' + current_style_index_;             // convert index -> style buffer char
-                  }
-                  ++sp;
-                  seqdone = 1;
-                  continue;
-                case '\0':        // EOS in middle of sequence?
-                  *ntp = 0;       // end of text
-                  *nsp = 0;       // end of style
-                  seqdone = 1;
-                  continue;
-                default:          // un-supported cmd?
-                  seqdone = 1;
-                  sp = esc+1;     // continue parsing just past esc
-                  break;
-              }   // switch
-            }     // while
-          }       // case '['
-        }         // switch
-      }           // \033
-      else {
-        // Non-ANSI character?
-        if ( *sp == '\n' ) ++lines; // keep track of #lines
-        *ntp++ = *sp++;             // pass char thru
-        *nsp++ = astyle;            // use current style
-      }
-    } // while
-    *ntp = 0;
-    *nsp = 0;
+    char *ntm, *nsm;                        // new text/style memory
+    int nlines = 0;
+    bool cleared = false;
+    int style_index = current_style_index_;
+    parse_ansi(s, len, style_index, ntm, nsm, nlines, cleared);
+    current_style_index_ = style_index;
+    if ( cleared ) clear();     // "\033[2J" seen: clear text buffer
+    lines += nlines;
     //::printf("  RESULT: ntm='%s'\n", ntm);
     //::printf("  RESULT: nsm='%s'\n", nsm);
     buf->append(ntm);           // new text memory
@@ -608,6 +680,122 @@ void Fl_Simple_Terminal::append(const char *s, int len) {
   enforce_stay_at_bottom();
 }
 
+// Delivers one feed() chunk on the main thread (Fl::awake() handler)
+void Fl_Simple_Terminal::feed_chunk_cb(void *v) {
+  Feed_Chunk *c = (Feed_Chunk*)v;
+  Fl_Simple_Terminal *tty = c->tty;
+  int i;
+  for ( i=0; i<nfeed_terminals; i++ )   // widget still alive?
+    if ( feed_terminals[i] == tty ) break;
+  if ( i < nfeed_terminals ) {
+    if ( c->cleared ) tty->clear();     // "\033[2J" seen by the producer
+    tty->buf->append(c->text);
+    if ( c->style ) tty->sbuf->append(c->style);
+    tty->lines += c->nlines;
+    tty->enforce_history_lines();
+    tty->enforce_stay_at_bottom();
+  }
+  free(c->text);
+  if ( c->style ) free(c->style);
+  free(c);
+}
+
+/**
+ Feeds raw terminal output to the widget, safe to call from any thread.
+
+ Unlike append(), the ANSI state machine runs on the calling thread; the
+ parsed text and its style bytes are handed to the main thread through the
+ Fl::awake(Fl_Awake_Handler, void*) queue and appended to the display the
+ next time the event loop runs. A process producing megabytes of output per
+ second can therefore be ingested by a worker thread without the GUI thread
+ doing any per-byte work, and without the caller taking Fl::lock().
+
+ An ANSI escape sequence split across two feed() calls is held back until
+ the bytes completing it arrive, so output can be fed in arbitrary read(2)
+ sized pieces.
+
+ Rules:
+  - only one thread may feed a given widget at a time
+  - don't change ansi(), style_table() or normal_style_index(int) while
+    another thread is feeding
+  - feed() keeps its own running ANSI style state, independent of the
+    current_style_index() used by append() and printf()
+
+ The widget may be destroyed while chunks are still queued; such chunks are
+ discarded safely.
+
+ \param s string to append.
+
+ \param len optional length of string can be specified if known
+            to save the internals from having to call strlen()
+
+ \see append(), printf(), ansi(bool)
+*/
+void Fl_Simple_Terminal::feed(const char *s, int len) {
+  if ( len < 0 ) len = (int)strlen(s);
+  // Prepend bytes carried over from the previous call
+  const char *data = s;
+  char *heap = 0;
+  if ( feed_carry_len_ ) {
+    heap = (char*)malloc(feed_carry_len_ + len + 1);
+    memcpy(heap, feed_carry_, feed_carry_len_);
+    memcpy(heap+feed_carry_len_, s, len);
+    len += feed_carry_len_;
+    heap[len] = 0;
+    data = heap;
+    feed_carry_len_ = 0;
+  }
+  // Withhold an incomplete trailing escape sequence so it can complete
+  // with the next chunk. Look for the last ESC near the end of the data;
+  // the window also bounds how much a call can carry over.
+  int keep = 0;
+  if ( ansi() ) {
+    for ( int i=len-1; i >= 0 && (len-i) <= (int)sizeof(feed_carry_); i-- ) {
+      if ( data[i] != 033 ) continue;
+      int j = i+1;
+      if ( j < len && data[j] == '[' )
+        for ( ++j; j < len && (isdigit(data[j]) || data[j] == ';'); j++ ) { }
+      if ( j >= len ) keep = len - i;   // no terminating byte yet
+      break;
+    }
+  }
+  int n = len - keep;
+  // Parse on this (the calling) thread
+  char *ntm = 0, *nsm = 0;
+  int nlines = 0;
+  bool cleared = false;
+  if ( ansi() ) {
+    parse_ansi(data, n, feed_style_index_, ntm, nsm, nlines, cleared);
+  } else {
+    ntm = (char*)malloc(n+1);
+    memcpy(ntm, data, n);
+    ntm[n] = 0;
+    nlines = ::strcnt(ntm, '\n');
+  }
+  if ( keep ) {
+    memcpy(feed_carry_, data+n, keep);
+    feed_carry_len_ = keep;
+  }
+  if ( heap ) free(heap);
+  if ( !ntm[0] && !cleared ) {  // nothing to deliver?
+    free(ntm);
+    if ( nsm ) free(nsm);
+    return;
+  }
+  // Queue the parsed chunk for the main thread
+  Feed_Chunk *c = (Feed_Chunk*)malloc(sizeof(Feed_Chunk));
+  c->tty = this;
+  c->text = ntm;
+  c->style = nsm;
+  c->nlines = nlines;
+  c->cleared = cleared;
+  if ( Fl::awake(feed_chunk_cb, c) ) {  // queueing failed? drop the chunk
+    free(c->text);
+    if ( c->style ) free(c->style);
+    free(c);
+  }
+}
+
 /**
  Replaces the terminal with new text content in string 's'.
 
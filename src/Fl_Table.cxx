@@ -25,6 +25,10 @@
 #include <stdio.h>              // fprintf
 #include <stdlib.h>             // realloc/free
 
+// Max cells in the dirty cell list before a partial redraw falls back
+// on the bounding row/col range. See Fl_Table::redraw_cell().
+#define MAX_REDRAW_CELLS 256
+
 
 // An STL-ish vector without templates (private to Fl_Table)
 
@@ -84,42 +88,67 @@ void Fl_Table::col_position(int col) {
   _col_position = col;  // HACK: override what table_scrolled() came up with
 }
 
+// INTERNAL: Rebuild the row offset prefix sums from the row heights.
+//     _rowoffsets[R] is the scroll position (in pixels) of row R;
+//     _rowoffsets[rows()] is the virtual height of the entire table.
+//
+void Fl_Table::recalc_row_offsets() {
+  _rowoffsets.size(_rows + 1);
+  int pos = 0;
+  for ( int t=0; t<_rows; t++ ) {
+    _rowoffsets[t] = pos;
+    pos += row_height(t);
+  }
+  _rowoffsets[_rows] = pos;
+  _rowoffsets_dirty = 0;
+}
+
+// INTERNAL: Rebuild the column offset prefix sums from the column widths.
+//     _coloffsets[C] is the scroll position (in pixels) of column C;
+//     _coloffsets[cols()] is the virtual width of the entire table.
+//
+void Fl_Table::recalc_col_offsets() {
+  _coloffsets.size(_cols + 1);
+  int pos = 0;
+  for ( int t=0; t<_cols; t++ ) {
+    _coloffsets[t] = pos;
+    pos += col_width(t);
+  }
+  _coloffsets[_cols] = pos;
+  _coloffsets_dirty = 0;
+}
+
+// INTERNAL: Binary search the offset array 'offsets' (with entries [0..n])
+//     for the largest index whose offset is <= 'pos'.
+//
+int Fl_Table::offset_search(IntVector &offsets, int n, int pos) {
+  int lo = 0, hi = n;
+  while ( lo < hi ) {
+    int mid = (lo + hi + 1) / 2;
+    if ( offsets[mid] <= pos ) lo = mid;
+    else                       hi = mid - 1;
+  }
+  return(lo);
+}
+
 /**
   Returns the scroll position (in pixels) of the specified 'row'.
 */
 long Fl_Table::row_scroll_position(int row) {
-  int startrow = 0;
-  long scroll = 0;
-  // OPTIMIZATION:
-  //     Attempt to use precomputed row scroll position
-  //
-  if ( toprow_scrollpos != -1 && row >= toprow ) {
-    scroll = toprow_scrollpos;
-    startrow = toprow;
-  }
-  for ( int t=startrow; t<row; t++ ) {
-    scroll += row_height(t);
-  }
-  return(scroll);
+  if ( _rowoffsets_dirty ) recalc_row_offsets();
+  if ( row < 0 ) row = 0;
+  else if ( row > _rows ) row = _rows;
+  return(_rowoffsets[row]);
 }
 
 /**
   Returns the scroll position (in pixels) of the specified column 'col'.
 */
 long Fl_Table::col_scroll_position(int col) {
-  int startcol = 0;
-  long scroll = 0;
-  // OPTIMIZATION:
-  //     Attempt to use precomputed row scroll position
-  //
-  if ( leftcol_scrollpos != -1 && col >= leftcol ) {
-    scroll = leftcol_scrollpos;
-    startcol = leftcol;
-  }
-  for ( int t=startcol; t<col; t++ ) {
-    scroll += col_width(t);
-  }
-  return(scroll);
+  if ( _coloffsets_dirty ) recalc_col_offsets();
+  if ( col < 0 ) col = 0;
+  else if ( col > _cols ) col = _cols;
+  return(_coloffsets[col]);
 }
 
 /**
@@ -152,6 +181,9 @@ Fl_Table::Fl_Table(int X, int Y, int W, int H, const char *l) : Fl_Group(X,Y,W,H
   rightcol          = 0;
   toprow_scrollpos  = -1;
   leftcol_scrollpos = -1;
+  _rowoffsets_dirty = 1;
+  _coloffsets_dirty = 1;
+  _redraw_cells_exact = 1;
   _last_cursor      = FL_CURSOR_DEFAULT;
   _resizing_col     = -1;
   _resizing_row     = -1;
@@ -219,6 +251,7 @@ void Fl_Table::row_height(int row, int height) {
       _rowheights[now_size++] = height;
   }
   _rowheights[row] = height;
+  _rowoffsets_dirty = 1;
   table_resized();
   if ( row <= botrow ) {        // OPTIMIZATION: only redraw if onscreen or above screen
     redraw();
@@ -249,6 +282,7 @@ void Fl_Table::col_width(int col, int width)
     }
   }
   _colwidths[col] = width;
+  _coloffsets_dirty = 1;
   table_resized();
   if ( col <= rightcol ) {      // OPTIMIZATION: only redraw if onscreen or to the left
     redraw();
@@ -560,40 +594,40 @@ void Fl_Table::recalc_dimensions() {
   TODO: Assumes ti[xywh] has already been recalculated.
 */
 void Fl_Table::table_scrolled() {
-  // Find top row
-  int y, row, voff = vscrollbar->value();
-  for ( row=y=0; row < _rows; row++ ) {
-    y += row_height(row);
-    if ( y > voff ) { y -= row_height(row); break; }
-  }
-  _row_position = toprow = ( row >= _rows ) ? (row - 1) : row;
-  toprow_scrollpos = y;         // OPTIMIZATION: save for later use
-  // Find bottom row
+  if ( _rowoffsets_dirty ) recalc_row_offsets();
+  if ( _coloffsets_dirty ) recalc_col_offsets();
+  int old_toprow = toprow,   old_botrow = botrow,
+      old_leftcol = leftcol, old_rightcol = rightcol;
+  // Find top row: the row containing the scroll offset
+  int voff = vscrollbar->value();
+  int row = offset_search(_rowoffsets, _rows, voff);
+  _row_position = toprow = ( row >= _rows ) ? (_rows - 1) : row;
+  toprow_scrollpos = ( toprow >= 0 ) ? _rowoffsets[toprow] : 0;  // OPTIMIZATION: save for later use
+  // Find bottom row: first visible row whose bottom edge reaches the window's
   voff = vscrollbar->value() + tih;
-  for ( ; row < _rows; row++ ) {
-    y += row_height(row);
-    if ( y >= voff ) { break; }
-  }
-  botrow = ( row >= _rows ) ? (row - 1) : row;
-  // Left column
-  int x, col, hoff = hscrollbar->value();
-  for ( col=x=0; col < _cols; col++ ) {
-    x += col_width(col);
-    if ( x > hoff ) { x -= col_width(col); break; }
-  }
-  _col_position = leftcol = ( col >= _cols ) ? (col - 1) : col;
-  leftcol_scrollpos = x;        // OPTIMIZATION: save for later use
-  // Right column
-  //    Work with data left over from leftcol calculation
-  //
+  row = offset_search(_rowoffsets, _rows, voff - 1);
+  botrow = ( row >= _rows ) ? (_rows - 1) : row;
+  // Left column: the column containing the scroll offset
+  int hoff = hscrollbar->value();
+  int col = offset_search(_coloffsets, _cols, hoff);
+  _col_position = leftcol = ( col >= _cols ) ? (_cols - 1) : col;
+  leftcol_scrollpos = ( leftcol >= 0 ) ? _coloffsets[leftcol] : 0; // OPTIMIZATION: save for later use
+  // Right column: first visible column whose right edge reaches the window's
   hoff = hscrollbar->value() + tiw;
-  for ( ; col < _cols; col++ ) {
-    x += col_width(col);
-    if ( x >= hoff ) { break; }
-  }
-  rightcol = ( col >= _cols ) ? (col - 1) : col;
+  col = offset_search(_coloffsets, _cols, hoff - 1);
+  rightcol = ( col >= _cols ) ? (_cols - 1) : col;
   // First tell children to scroll
   draw_cell(CONTEXT_RC_RESIZE, 0,0,0,0,0,0);
+  // VISIBLE RANGE CALLBACK
+  //    Tell the app which cells are about to be drawn, so it can e.g.
+  //    prefetch the rows from slow storage. See also visible_cells().
+  //
+  if ( toprow  != old_toprow  || botrow   != old_botrow ||
+       leftcol != old_leftcol || rightcol != old_rightcol ) {
+    if ( Fl_Widget::callback() && when() & FL_WHEN_CHANGED ) {
+      do_callback(CONTEXT_VISIBLE_RANGE, toprow, leftcol);
+    }
+  }
 }
 
 /**
@@ -664,6 +698,7 @@ void Fl_Table::rows(int val) {
       _rowheights[now_size++] = default_h;      // fill new
     }
   }
+  _rowoffsets_dirty = 1;
   table_resized();
 
   // OPTIMIZATION: redraw only if change is visible.
@@ -687,6 +722,7 @@ void Fl_Table::cols(int val) {
       _colwidths[now_size++] = default_w;       // fill new
     }
   }
+  _coloffsets_dirty = 1;
   table_resized();
   redraw();
 }
@@ -731,6 +767,37 @@ void Fl_Table::damage_zone(int r1, int c1, int r2, int c2, int r3, int c3) {
   redraw_range(R1, R2, C1, C2);
 }
 
+/**
+  Marks the single cell at row \p R, column \p C to be redrawn,
+  and schedules a partial redraw by calling damage(FL_DAMAGE_CHILD).
+
+  Unlike redraw_range(), cells marked this way accumulate into a dirty
+  cell list, and the next draw() repaints just those cells. An app
+  updating scattered cells (e.g. a table mirroring live data) can mark
+  each changed cell and have only those repainted, where redraw_range()
+  would repaint the whole bounding range of rows and columns.
+
+  If too many cells accumulate before the next draw, or ranges were
+  damaged as well, draw() falls back on the bounding range.
+*/
+void Fl_Table::redraw_cell(int R, int C) {
+  if ( R < toprow || R > botrow || C < leftcol || C > rightcol ) return; // offscreen? nothing to do
+  if ( _redraw_cells_exact ) {
+    // Already in the dirty cell list? (list is small; linear scan is fine)
+    for ( int t=0; t<(int)_redraw_cells.size(); t+=2 ) {
+      if ( _redraw_cells[t] == R && _redraw_cells[t+1] == C ) return;
+    }
+    if ( _redraw_cells.size() >= (MAX_REDRAW_CELLS*2) ) {
+      _redraw_cells_exact = 0;          // too many: bounding range is cheaper
+    } else {
+      _redraw_cells.push_back(R);
+      _redraw_cells.push_back(C);
+    }
+  }
+  extend_redraw_range(R, R, C, C);      // keep bounding range current as fallback
+  damage(FL_DAMAGE_CHILD);
+}
+
 /**
   Moves the selection cursor a relative number of rows/columns specifed by R/C.
   R/C can be positive or negative, depending on the direction to move.
@@ -1291,9 +1358,16 @@ void Fl_Table::draw() {
     // Only redraw a few cells?
     if ( ! ( damage() & FL_DAMAGE_ALL ) && _redraw_leftcol != -1 ) {
       fl_push_clip(tix, tiy, tiw, tih);
-      for ( int c = _redraw_leftcol; c <= _redraw_rightcol; c++ ) {
-        for ( int r = _redraw_toprow; r <= _redraw_botrow; r++ ) {
-          _redraw_cell(CONTEXT_CELL, r, c);
+      if ( _redraw_cells_exact && _redraw_cells.size() > 0 ) {
+        // Dirty cell list covers all damage? Repaint just those cells
+        for ( int t=0; t<(int)_redraw_cells.size(); t+=2 ) {
+          _redraw_cell(CONTEXT_CELL, _redraw_cells[t], _redraw_cells[t+1]);
+        }
+      } else {
+        for ( int c = _redraw_leftcol; c <= _redraw_rightcol; c++ ) {
+          for ( int r = _redraw_toprow; r <= _redraw_botrow; r++ ) {
+            _redraw_cell(CONTEXT_CELL, r, c);
+          }
         }
       }
       fl_pop_clip();
@@ -1386,6 +1460,8 @@ void Fl_Table::draw() {
               tix, tiy, tiw, tih);              // routines cleanup
 
     _redraw_leftcol = _redraw_rightcol = _redraw_toprow = _redraw_botrow = -1;
+    _redraw_cells.size(0);
+    _redraw_cells_exact = 1;
   }
   fl_pop_clip();
 }
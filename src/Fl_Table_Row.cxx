@@ -37,30 +37,121 @@
 #define PRINTEVENT
 #endif
 
-// An STL-ish vector without templates (private to Fl_Table_Row)
+// A sorted set of disjoint [start,end] row intervals (private to Fl_Table_Row)
 
-void Fl_Table_Row::CharVector::copy(char *newarr, int newsize) {
-  size(newsize);
-  memcpy(arr, newarr, newsize * sizeof(char));
+Fl_Table_Row::RowIntervals::~RowIntervals() {   // DTOR
+  if (ivals) free(ivals);
+  ivals = 0;
 }
 
-Fl_Table_Row::CharVector::~CharVector() {       // DTOR
-  if (arr) free(arr);
-  arr = 0;
+// Binary search: index of the first interval whose end >= row (may be _size)
+int Fl_Table_Row::RowIntervals::find(int row) const {
+  int lo = 0, hi = _size;
+  while ( lo < hi ) {
+    int mid = (lo + hi) / 2;
+    if ( ivals[2*mid+1] < row ) lo = mid + 1;
+    else hi = mid;
+  }
+  return(lo);
+}
+
+int Fl_Table_Row::RowIntervals::contains(int row) const {
+  int x = find(row);
+  return(( x < _size && ivals[2*x] <= row ) ? 1 : 0);
+}
+
+void Fl_Table_Row::RowIntervals::insert_at(int x, int start, int end) {
+  if ( _size >= _capacity ) {
+    _capacity = _capacity ? _capacity * 2 : 8;
+    ivals = (int*)realloc(ivals, (unsigned)_capacity * 2 * sizeof(int));
+  }
+  memmove(ivals + 2*(x+1), ivals + 2*x, (_size - x) * 2 * sizeof(int));
+  ivals[2*x] = start;
+  ivals[2*x+1] = end;
+  _size++;
+}
+
+void Fl_Table_Row::RowIntervals::remove_at(int x) {
+  memmove(ivals + 2*x, ivals + 2*(x+1), (_size - x - 1) * 2 * sizeof(int));
+  _size--;
 }
 
-void Fl_Table_Row::CharVector::size(int count) {
-  if (count != _size) {
-    arr = (char*)realloc(arr, (unsigned)count * sizeof(char));
-    _size = count;
+int Fl_Table_Row::RowIntervals::add(int row) {
+  int x = find(row);
+  if ( x < _size && ivals[2*x] <= row ) return(0);      // already in the set
+  int touches_prev = ( x > 0 && ivals[2*(x-1)+1] == row - 1 );
+  int touches_next = ( x < _size && ivals[2*x] == row + 1 );
+  if ( touches_prev && touches_next ) {                 // bridges two intervals
+    ivals[2*(x-1)+1] = ivals[2*x+1];
+    remove_at(x);
+  } else if ( touches_prev ) {
+    ivals[2*(x-1)+1] = row;
+  } else if ( touches_next ) {
+    ivals[2*x] = row;
+  } else {
+    insert_at(x, row, row);
   }
+  return(1);
 }
 
+int Fl_Table_Row::RowIntervals::remove(int row) {
+  int x = find(row);
+  if ( x >= _size || ivals[2*x] > row ) return(0);      // not in the set
+  int start = ivals[2*x], end = ivals[2*x+1];
+  if ( start == end )    { remove_at(x); }
+  else if ( row == start ) { ivals[2*x] = row + 1; }
+  else if ( row == end )   { ivals[2*x+1] = row - 1; }
+  else {                                                // split the interval
+    ivals[2*x+1] = row - 1;
+    insert_at(x+1, row + 1, end);
+  }
+  return(1);
+}
+
+void Fl_Table_Row::RowIntervals::set_all(int nrows) {
+  clear();
+  if ( nrows > 0 ) insert_at(0, 0, nrows - 1);
+}
+
+void Fl_Table_Row::RowIntervals::invert(int nrows) {
+  // The gaps between the current intervals become the new intervals
+  int old_size = _size;
+  int *old = ivals;
+  ivals = 0;
+  _size = 0;
+  _capacity = 0;
+  int next_row = 0;             // first row not yet accounted for
+  for ( int i=0; i<old_size; i++ ) {
+    int start = old[2*i], end = old[2*i+1];
+    if ( start >= nrows ) break;
+    if ( start > next_row ) insert_at(_size, next_row, start - 1);
+    next_row = end + 1;
+  }
+  if ( next_row < nrows ) insert_at(_size, next_row, nrows - 1);
+  if ( old ) free(old);
+}
+
+void Fl_Table_Row::RowIntervals::clamp(int nrows) {
+  while ( _size && ivals[2*(_size-1)] >= nrows ) _size--;
+  if ( _size && ivals[2*(_size-1)+1] >= nrows ) ivals[2*(_size-1)+1] = nrows - 1;
+}
+
+int Fl_Table_Row::RowIntervals::count() const {
+  int n = 0;
+  for ( int i=0; i<_size; i++ ) n += ivals[2*i+1] - ivals[2*i] + 1;
+  return(n);
+}
+
+
+Fl_Table_Row::~Fl_Table_Row() {
+  release_all_row_blocks();
+  if ( _block_ring ) free(_block_ring);
+}
 
 // Is row selected?
 int Fl_Table_Row::row_selected(int row) {
   if ( row < 0 || row >= rows() ) return(-1);
-  return(_rowselect[row]);
+  return(_rowselect.contains(row));
 }
 
 // Change row selection type
@@ -68,20 +159,16 @@ void Fl_Table_Row::type(TableRowSelectMode val) {
   _selectmode = val;
   switch ( _selectmode ) {
     case SELECT_NONE: {
-      for ( int row=0; row<rows(); row++ ) {
-        _rowselect[row] = 0;
-      }
+      _rowselect.clear();
       redraw();
       break;
     }
     case SELECT_SINGLE: {
-      int count = 0;
-      for ( int row=0; row<rows(); row++ ) {
-        if ( _rowselect[row] ) {
-          if ( ++count > 1 ) {  // only one allowed
-            _rowselect[row] = 0;
-          }
-        }
+      if ( _rowselect.count() > 1 ) {   // only one allowed: keep the first
+        int start, end;
+        _rowselect.interval(0, start, end);
+        _rowselect.clear();
+        _rowselect.add(start);
       }
       redraw();
       break;
@@ -111,30 +198,29 @@ int Fl_Table_Row::select_row(int row, int flag) {
       return(-1);
 
     case SELECT_SINGLE: {
-      int oldval;
-      for ( int t=0; t<rows(); t++ ) {
-        if ( t == row ) {
-          oldval = _rowselect[row];
-          if ( flag == 2 ) { _rowselect[row] ^= 1; }
-          else             { _rowselect[row] = flag; }
-          if ( oldval != _rowselect[row] ) {
-            redraw_range(row, row, leftcol, rightcol);
-            ret = 1;
-          }
-        }
-        else if ( _rowselect[t] ) {
-          _rowselect[t] = 0;
-          redraw_range(t, t, leftcol, rightcol);
-        }
+      int oldval = _rowselect.contains(row);
+      int newval = ( flag == 2 ) ? !oldval : flag;
+      // Deselect everything else, redrawing whatever was selected
+      for ( int i=0; i<_rowselect.intervals(); i++ ) {
+        int start, end;
+        _rowselect.interval(i, start, end);
+        redraw_range(start, end, leftcol, rightcol);
+      }
+      _rowselect.clear();
+      if ( newval ) { _rowselect.add(row); }
+      if ( oldval != newval ) {
+        redraw_range(row, row, leftcol, rightcol);
+        ret = 1;
       }
       break;
     }
 
     case SELECT_MULTI: {
-      int oldval = _rowselect[row];
-      if ( flag == 2 ) { _rowselect[row] ^= 1; }
-      else             { _rowselect[row] = flag; }
-      if ( _rowselect[row] != oldval ) {                // select state changed?
+      int changed;
+      if ( flag == 2 )    { changed = _rowselect.contains(row) ? _rowselect.remove(row) : _rowselect.add(row); }
+      else if ( flag )    { changed = _rowselect.add(row); }
+      else                { changed = _rowselect.remove(row); }
+      if ( changed ) {                                  // select state changed?
         if ( row >= toprow && row <= botrow ) {         // row visible?
           // Extend partial redraw range
           redraw_range(row, row, leftcol, rightcol);
@@ -159,15 +245,14 @@ void Fl_Table_Row::select_all_rows(int flag) {
     case SELECT_MULTI: {
       char changed = 0;
       if ( flag == 2 ) {
-        for ( int row=0; row<(int)_rowselect.size(); row++ ) {
-          _rowselect[row] ^= 1;
-        }
+        _rowselect.invert(rows());
         changed = 1;
+      } else if ( flag ) {
+        changed = ( _rowselect.count() != rows() ) ? 1 : 0;
+        _rowselect.set_all(rows());
       } else {
-        for ( int row=0; row<(int)_rowselect.size(); row++ ) {
-          changed |= (_rowselect[row] != flag)?1:0;
-          _rowselect[row] = flag;
-        }
+        changed = _rowselect.count() ? 1 : 0;
+        _rowselect.clear();
       }
       if ( changed ) {
         redraw();
@@ -179,8 +264,104 @@ void Fl_Table_Row::select_all_rows(int flag) {
 // Set number of rows
 void Fl_Table_Row::rows(int val) {
   Fl_Table::rows(val);
-  while ( val > (int)_rowselect.size() ) { _rowselect.push_back(0); }   // enlarge
-  while ( val < (int)_rowselect.size() ) { _rowselect.pop_back(); }     // shrink
+  _rowselect.clamp(val);                // drop selection beyond the new end
+  // Drop materialized row blocks that start past the new end
+  for ( int i=_block_ring_n-1; i>=0; i-- ) {
+    if ( _block_ring[i] * _block_rows >= val ) {
+      release_row_block(_block_ring[i]);
+      for ( int j=i; j<_block_ring_n-1; j++ ) { _block_ring[j] = _block_ring[j+1]; }
+      _block_ring_n--;
+    }
+  }
+}
+
+// Virtualized row model (see Fl_Table_Row::row_blocks() in the header)
+
+void Fl_Table_Row::row_blocks(int rows_per_block, int ring_blocks,
+                              Fl_Table_Row_Block_F *fetch,
+                              Fl_Table_Row_Block_F *release, void *data) {
+  release_all_row_blocks();             // with the *old* callbacks
+  if ( _block_ring ) { free(_block_ring); _block_ring = 0; }
+  _block_rows       = ( fetch && rows_per_block > 0 ) ? rows_per_block : 0;
+  _block_fetch_cb   = fetch;
+  _block_release_cb = release;
+  _block_cb_data    = data;
+  _block_ring_size  = ( ring_blocks > 0 ) ? ring_blocks : 16;
+  if ( _block_rows ) {
+    _block_ring = (int*)malloc((unsigned)_block_ring_size * sizeof(int));
+  }
+}
+
+// Tell the app block 'block' was evicted, so it can free the data.
+//     num_rows is clamped to the current row count, so it can be smaller
+//     than it was at fetch time if the table shrank meanwhile.
+//
+void Fl_Table_Row::release_row_block(int block) {
+  if ( !_block_release_cb ) return;
+  int first = block * _block_rows;
+  int num = rows() - first;
+  if ( num > _block_rows ) num = _block_rows;
+  if ( num < 0 ) num = 0;
+  _block_release_cb(this, first, num, _block_cb_data);
+}
+
+// Release every materialized block (shrink, reconfiguration, DTOR)
+void Fl_Table_Row::release_all_row_blocks() {
+  for ( int i=0; i<_block_ring_n; i++ ) { release_row_block(_block_ring[i]); }
+  _block_ring_n = 0;
+}
+
+// Make sure 'block' is materialized and mark it most recently used.
+//     Evicts the least recently used block when the ring is full.
+//
+void Fl_Table_Row::touch_row_block(int block) {
+  int i;
+  for ( i=0; i<_block_ring_n; i++ ) {
+    if ( _block_ring[i] == block ) break;
+  }
+  if ( i < _block_ring_n ) {            // already materialized: move to MRU end
+    for ( ; i<_block_ring_n-1; i++ ) { _block_ring[i] = _block_ring[i+1]; }
+    _block_ring[_block_ring_n-1] = block;
+    return;
+  }
+  if ( _block_ring_n >= _block_ring_size ) {    // ring full: evict the LRU block
+    release_row_block(_block_ring[0]);
+    for ( i=0; i<_block_ring_n-1; i++ ) { _block_ring[i] = _block_ring[i+1]; }
+    _block_ring_n--;
+  }
+  _block_ring[_block_ring_n++] = block;
+  int first = block * _block_rows;
+  int num = rows() - first;
+  if ( num > _block_rows ) num = _block_rows;
+  _block_fetch_cb(this, first, num, _block_cb_data);
+}
+
+// Is the block of rows containing 'row' materialized?
+int Fl_Table_Row::row_block_fetched(int row) {
+  if ( !_block_rows ) return(1);        // virtualization off: all data resident
+  if ( row < 0 || row >= rows() ) return(0);
+  int block = row / _block_rows;
+  for ( int i=0; i<_block_ring_n; i++ ) {
+    if ( _block_ring[i] == block ) return(1);
+  }
+  return(0);
+}
+
+// Draw the table.
+//     Materializes the blocks covering the visible rows first, plus one
+//     block of fetch-ahead on each side so scrolling hits warm data.
+//
+void Fl_Table_Row::draw() {
+  if ( _block_rows && rows() > 0 ) {
+    int first = toprow - _block_rows;
+    int last  = botrow + _block_rows;
+    if ( first < 0 ) first = 0;
+    if ( last >= rows() ) last = rows() - 1;
+    for ( int b=first/_block_rows; b<=last/_block_rows; b++ ) {
+      touch_row_block(b);
+    }
+  }
+  Fl_Table::draw();
 }
 
 // Handle events
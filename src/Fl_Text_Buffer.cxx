@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <FL/fl_utf8.h>
 #include <FL/fl_string.h>
 #include "flstring.h"
@@ -67,31 +68,27 @@ static int min(int i1, int i2)
 #endif
 
 
-static char *undobuffer;
-static int undobufferlength;
-static Fl_Text_Buffer *undowidget;
-static int undoat;              // points after insertion
-static int undocut;             // number of characters deleted there
-static int undoinsert;          // number of characters inserted
-static int undoyankcut;         // length of valid contents of buffer, even if undocut=0
-
 /*
- Resize the undo buffer to match at least the requested size.
+ One coalesced edit in the undo journals. Every modification of the buffer
+ boils down to removing the text in [at-ninserted-nremoved .. at-ninserted)
+ and inserting ninserted bytes in its place; 'removed' holds a copy of the
+ removed text (NULL if nothing was removed). Records are kept in singly
+ linked lists, most recent first, one list for undo and one for redo.
+ Inserted text is not copied - it still lives in the buffer - so a record
+ costs only the bytes it removed plus a small constant.
  */
-static void undobuffersize(int n)
-{
-  if (n > undobufferlength) {
-    if (undobuffer) {
-      do {
-        undobufferlength *= 2;
-      } while (undobufferlength < n);
-      undobuffer = (char *) realloc(undobuffer, undobufferlength);
-    } else {
-      undobufferlength = n + 9;
-      undobuffer = (char *) malloc(undobufferlength);
-    }
-  }
-}
+struct Fl_Text_Buffer::Undo_Record {
+  Undo_Record *next;
+  int at;               // buffer position just after the edit
+  int ninserted;        // number of bytes the edit inserted before 'at'
+  int nremoved;         // number of bytes in 'removed'
+  char *removed;        // copy of the text the edit removed, or NULL
+};
+
+// Maximum bytes of removed text retained per buffer; older records are
+// dropped beyond this. The most recent record is always kept, however
+// large, so a single big deletion stays undoable.
+#define UNDO_JOURNAL_MAX_BYTES (8*1024*1024)
 
 static void def_transcoding_warning_action(Fl_Text_Buffer *text)
 {
@@ -121,8 +118,17 @@ Fl_Text_Buffer::Fl_Text_Buffer(int requestedSize, int preferredGapSize)
   mNPredeleteProcs = 0;
   mPredeleteProcs = NULL;
   mPredeleteCbArgs = NULL;
+  mBatchDepth = 0;
+  mBatchPos = -1;
+  mBatchEnd = 0;
   mCursorPosHint = 0;
   mCanUndo = 1;
+  mUndoList = NULL;
+  mRedoList = NULL;
+  mUndoBytes = 0;
+  mReplayingUndo = 0;
+  mLineChunks = NULL;
+  mNLineChunks = 0;
   input_file_was_transcoded = 0;
   transcoding_warning_action = def_transcoding_warning_action;
 }
@@ -134,6 +140,9 @@ Fl_Text_Buffer::Fl_Text_Buffer(int requestedSize, int preferredGapSize)
 Fl_Text_Buffer::~Fl_Text_Buffer()
 {
   free(mBuf);
+  free(mLineChunks);
+  free_undo_records_(mUndoList);
+  free_undo_records_(mRedoList);
   if (mNModifyProcs != 0) {
     delete[]mModifyProcs;
     delete[]mCbArgs;
@@ -183,6 +192,7 @@ void Fl_Text_Buffer::text(const char *t)
   mGapStart = insertedLength;
   mGapEnd = mGapStart + mPreferredGapSize;
   memcpy(mBuf, t, insertedLength);
+  free_line_index();
 
   /* Zero all of the existing selections */
   update_selections(0, deletedLength, 0);
@@ -438,49 +448,127 @@ void Fl_Text_Buffer::copy(Fl_Text_Buffer * fromBuf, int fromStart,
   }
   mGapStart += copiedLength;
   mLength += copiedLength;
+  if (mLineChunks)
+    line_index_insert(toPos, copiedLength, count_lines_(toPos, toPos + copiedLength));
   update_selections(toPos, 0, copiedLength);
 }
 
 
 /*
- Take the previous changes and undo them. Return the previous
- cursor position in cursorPos. Returns 1 if the undo was applied.
- CursorPos will be at a character boundary.
+ Free a list of undo records and the removed text they carry.
+ */
+void Fl_Text_Buffer::free_undo_records_(Undo_Record *list)
+{
+  while (list) {
+    Undo_Record *next = list->next;
+    free(list->removed);
+    free(list);
+    list = next;
+  }
+}
+
+
+/*
+ Drop the oldest undo records until the retained removed text fits the
+ byte budget again. The most recent record is always kept so that even
+ an oversized deletion remains undoable once.
+ */
+void Fl_Text_Buffer::trim_undo_journal_()
+{
+  if (mUndoBytes <= UNDO_JOURNAL_MAX_BYTES)
+    return;
+  int total = 0;
+  Undo_Record **rp = &mUndoList;
+  while (*rp && (rp == &mUndoList || total + (*rp)->nremoved <= UNDO_JOURNAL_MAX_BYTES)) {
+    total += (*rp)->nremoved;
+    rp = &(*rp)->next;
+  }
+  if (*rp) {
+    free_undo_records_(*rp);
+    *rp = NULL;
+  }
+  mUndoBytes = total;
+}
+
+
+/*
+ Apply the inverse of one edit record to the buffer and return a new
+ record that, replayed in turn, restores the edit - undo and redo are
+ the same operation with the journals swapped. The returned record is
+ built before the buffer is modified so it can capture the text the
+ replay is about to remove. CursorPos will be at a character boundary.
+ */
+Fl_Text_Buffer::Undo_Record *Fl_Text_Buffer::replay_(Undo_Record *rec, int *cursorPos)
+{
+  int b = rec->at - rec->ninserted;
+
+  Undo_Record *inv = (Undo_Record *) malloc(sizeof(Undo_Record));
+  inv->next = NULL;
+  inv->at = b + rec->nremoved;
+  inv->ninserted = rec->nremoved;
+  inv->nremoved = rec->ninserted;
+  inv->removed = rec->ninserted ? text_range(b, rec->at) : NULL;
+
+  mReplayingUndo = 1;
+  if (rec->ninserted && rec->nremoved)
+    replace(b, rec->at, rec->removed);
+  else if (rec->ninserted)
+    remove(b, rec->at);
+  else
+    insert(rec->at, rec->removed);
+  mReplayingUndo = 0;
+
+  if (cursorPos)
+    *cursorPos = mCursorPosHint;
+  return inv;
+}
+
+
+/*
+ Take the most recent change and undo it. Return the new cursor position
+ in cursorPos. Returns 1 if an undo record was applied. Can be called
+ repeatedly to walk further back through the journal; the inverse of each
+ undone edit is pushed onto the redo journal.
  */
 int Fl_Text_Buffer::undo(int *cursorPos)
 {
-  if (undowidget != this || (!undocut && !undoinsert && !mCanUndo))
+  if (!mCanUndo || !mUndoList)
     return 0;
 
-  int ilen = undocut;
-  int xlen = undoinsert;
-  int b = undoat - xlen;
-
-  if (xlen && undoyankcut && !ilen) {
-    ilen = undoyankcut;
-  }
-
-  if (xlen && ilen) {
-    undobuffersize(ilen + 1);
-    undobuffer[ilen] = 0;
-    char *tmp = fl_strdup(undobuffer);
-    replace(b, undoat, tmp);
-    if (cursorPos)
-      *cursorPos = mCursorPosHint;
-    free(tmp);
-  } else if (xlen) {
-    remove(b, undoat);
-    if (cursorPos)
-      *cursorPos = mCursorPosHint;
-  } else if (ilen) {
-    undobuffersize(ilen + 1);
-    undobuffer[ilen] = 0;
-    insert(undoat, undobuffer);
-    if (cursorPos)
-      *cursorPos = mCursorPosHint;
-    undoyankcut = 0;
-  }
+  Undo_Record *rec = mUndoList;
+  mUndoList = rec->next;
+  mUndoBytes -= rec->nremoved;
+
+  Undo_Record *inv = replay_(rec, cursorPos);
+  inv->next = mRedoList;
+  mRedoList = inv;
+
+  free(rec->removed);
+  free(rec);
+  return 1;
+}
+
+
+/*
+ Take the most recently undone change and reapply it. Return the new
+ cursor position in cursorPos. Returns 1 if a redo record was applied.
+ */
+int Fl_Text_Buffer::redo(int *cursorPos)
+{
+  if (!mCanUndo || !mRedoList)
+    return 0;
+
+  Undo_Record *rec = mRedoList;
+  mRedoList = rec->next;
 
+  Undo_Record *inv = replay_(rec, cursorPos);
+  inv->next = mUndoList;
+  mUndoList = inv;
+  mUndoBytes += inv->nremoved;
+  trim_undo_journal_();
+
+  free(rec->removed);
+  free(rec);
   return 1;
 }
 
@@ -491,9 +579,13 @@ int Fl_Text_Buffer::undo(int *cursorPos)
 void Fl_Text_Buffer::canUndo(char flag)
 {
   mCanUndo = flag;
-  // disabling undo also clears the last undo operation!
-  if (!mCanUndo && undowidget==this)
-    undowidget = 0;
+  // disabling undo also discards the journals!
+  if (!mCanUndo) {
+    free_undo_records_(mUndoList);
+    free_undo_records_(mRedoList);
+    mUndoList = mRedoList = NULL;
+    mUndoBytes = 0;
+  }
 }
 
 
@@ -949,14 +1041,147 @@ int Fl_Text_Buffer::skip_displayed_characters(int lineStartPos, int nChars)
 
 
 /*
- Count the number of newline characters between start and end.
- startPos and endPos must be at a character boundary.
- This function is optimized for speed by not using UTF-8 calls.
+ The chunked newline index. For small buffers, count_lines(), skip_lines()
+ and rewind_lines() simply scan character by character. On very large
+ buffers (log files of hundreds of MB) those scans dominate, because the
+ display widget does line math on every edit and scroll. Once a buffer
+ grows past the threshold below, the first line query chops the text into
+ consecutive spans of roughly LINE_INDEX_CHUNK bytes and remembers the
+ newline count of each, so line math only scans the one or two chunks at
+ the ends of the queried range and sums the counts in between. insert_()
+ and remove_() keep the spans current; a chunk that grows too large is
+ chopped up again, and removals collapse the affected chunks into one and
+ recount it.
  */
-int Fl_Text_Buffer::count_lines(int startPos, int endPos) const {
-  IS_UTF8_ALIGNED2(this, (startPos))
-  IS_UTF8_ALIGNED2(this, (endPos))
 
+#define LINE_INDEX_CHUNK 65536
+
+/*
+ Build the index if the buffer is large enough to profit from it.
+ Returns non-zero if the index is present.
+ */
+int Fl_Text_Buffer::line_index() const
+{
+  if (mLineChunks)
+    return 1;
+  if (mLength < 4 * LINE_INDEX_CHUNK)
+    return 0;
+  int n = (mLength + LINE_INDEX_CHUNK - 1) / LINE_INDEX_CHUNK;
+  mLineChunks = (Line_Chunk *) malloc(n * sizeof(Line_Chunk));
+  int base = 0;
+  for (int i = 0; i < n; i++) {
+    int bytes = min(mLength - base, LINE_INDEX_CHUNK);
+    mLineChunks[i].bytes = bytes;
+    mLineChunks[i].lines = count_lines_(base, base + bytes);
+    base += bytes;
+  }
+  mNLineChunks = n;
+  return 1;
+}
+
+
+/*
+ Discard the index; it is rebuilt on the next line query.
+ */
+void Fl_Text_Buffer::free_line_index()
+{
+  if (mLineChunks) {
+    free(mLineChunks);
+    mLineChunks = NULL;
+    mNLineChunks = 0;
+  }
+}
+
+
+/*
+ Chop an oversized chunk back into LINE_INDEX_CHUNK sized pieces.
+ base is the byte offset of the chunk in the buffer.
+ */
+void Fl_Text_Buffer::split_line_chunk(int i, int base)
+{
+  int bytes = mLineChunks[i].bytes;
+  int k = (bytes + LINE_INDEX_CHUNK - 1) / LINE_INDEX_CHUNK;
+  if (k < 2)
+    return;
+  mLineChunks = (Line_Chunk *) realloc(mLineChunks,
+                                       (mNLineChunks + k - 1) * sizeof(Line_Chunk));
+  memmove(mLineChunks + i + k, mLineChunks + i + 1,
+          (mNLineChunks - i - 1) * sizeof(Line_Chunk));
+  int off = 0;
+  for (int j = 0; j < k; j++) {
+    int piece = (j == k - 1) ? bytes - off : LINE_INDEX_CHUNK;
+    mLineChunks[i + j].bytes = piece;
+    mLineChunks[i + j].lines = count_lines_(base + off, base + off + piece);
+    off += piece;
+  }
+  mNLineChunks += k - 1;
+}
+
+
+/*
+ Account for len bytes containing nl newlines inserted at pos.
+ Called after the buffer has been modified.
+ */
+void Fl_Text_Buffer::line_index_insert(int pos, int len, int nl)
+{
+  if (!mLineChunks)
+    return;
+  int base = 0, i = 0;
+  while (i < mNLineChunks - 1 && pos >= base + mLineChunks[i].bytes) {
+    base += mLineChunks[i].bytes;
+    i++;
+  }
+  mLineChunks[i].bytes += len;
+  mLineChunks[i].lines += nl;
+  if (mLineChunks[i].bytes > 2 * LINE_INDEX_CHUNK)
+    split_line_chunk(i, base);
+}
+
+
+/*
+ Account for the range start..end having been removed from the buffer.
+ Called after the buffer has been modified; start and end are the
+ boundaries before the removal. The affected chunks are collapsed into
+ one and recounted, which touches at most two chunks worth of text plus
+ the chunk table.
+ */
+void Fl_Text_Buffer::line_index_remove(int start, int end)
+{
+  if (!mLineChunks)
+    return;
+  int base = 0, i = 0;
+  while (i < mNLineChunks - 1 && start >= base + mLineChunks[i].bytes) {
+    base += mLineChunks[i].bytes;
+    i++;
+  }
+  int j = i, spanEnd = base;
+  while (j < mNLineChunks && spanEnd < end) {
+    spanEnd += mLineChunks[j].bytes;
+    j++;
+  }
+  int bytes = (spanEnd - base) - (end - start);
+  if (j < mNLineChunks)
+    memmove(mLineChunks + i + 1, mLineChunks + j,
+            (mNLineChunks - j) * sizeof(Line_Chunk));
+  mNLineChunks -= (j - i - 1);
+  mLineChunks[i].bytes = bytes;
+  mLineChunks[i].lines = count_lines_(base, base + bytes);
+  if (bytes == 0 && mNLineChunks > 1) {
+    memmove(mLineChunks + i, mLineChunks + i + 1,
+            (mNLineChunks - i - 1) * sizeof(Line_Chunk));
+    mNLineChunks--;
+  } else if (bytes > 2 * LINE_INDEX_CHUNK) {
+    split_line_chunk(i, base);
+  }
+}
+
+
+/*
+ Count the number of newline characters between start and end by scanning.
+ This function is optimized for speed by not using UTF-8 calls.
+ */
+int Fl_Text_Buffer::count_lines_(int startPos, int endPos) const
+{
   int gapLen = mGapEnd - mGapStart;
   int lineCount = 0;
 
@@ -979,17 +1204,39 @@ int Fl_Text_Buffer::count_lines(int startPos, int endPos) const {
 
 
 /*
- Skip to the first character, n lines ahead.
- StartPos must be at a character boundary.
- This function is optimized for speed by not using UTF-8 calls.
+ Count the number of newline characters between start and end.
+ startPos and endPos must be at a character boundary.
+ On large buffers most of the range is summed from the newline index
+ and only the chunks at the ends of the range are scanned.
  */
-int Fl_Text_Buffer::skip_lines(int startPos, int nLines)
-{
+int Fl_Text_Buffer::count_lines(int startPos, int endPos) const {
   IS_UTF8_ALIGNED2(this, (startPos))
+  IS_UTF8_ALIGNED2(this, (endPos))
+
+  if (line_index()) {
+    int base = 0, lineCount = 0;
+    for (int i = 0; i < mNLineChunks && base < endPos; i++) {
+      int ce = base + mLineChunks[i].bytes;
+      if (ce > startPos) {
+        if (base >= startPos && ce <= endPos)
+          lineCount += mLineChunks[i].lines;
+        else
+          lineCount += count_lines_(max(base, startPos), min(ce, endPos));
+      }
+      base = ce;
+    }
+    return lineCount;
+  }
+  return count_lines_(startPos, endPos);
+}
 
-  if (nLines == 0)
-    return startPos;
 
+/*
+ Skip to the first character, n lines ahead, by scanning.
+ This function is optimized for speed by not using UTF-8 calls.
+ */
+int Fl_Text_Buffer::skip_lines_(int startPos, int nLines) const
+{
   int gapLen = mGapEnd - mGapStart;
   int pos = startPos;
   int lineCount = 0;
@@ -1017,14 +1264,45 @@ int Fl_Text_Buffer::skip_lines(int startPos, int nLines)
 
 
 /*
- Skip to the first character, n lines back.
+ Skip to the first character, n lines ahead.
  StartPos must be at a character boundary.
- This function is optimized for speed by not using UTF-8 calls.
+ On large buffers whole chunks are skipped using the newline index and
+ only the chunk containing the result is scanned.
  */
-int Fl_Text_Buffer::rewind_lines(int startPos, int nLines)
+int Fl_Text_Buffer::skip_lines(int startPos, int nLines)
 {
   IS_UTF8_ALIGNED2(this, (startPos))
 
+  if (nLines == 0)
+    return startPos;
+
+  if (line_index()) {
+    int base = 0, i = 0;
+    while (i < mNLineChunks && base + mLineChunks[i].bytes <= startPos) {
+      base += mLineChunks[i].bytes;
+      i++;
+    }
+    for (; i < mNLineChunks; i++) {
+      int ce = base + mLineChunks[i].bytes;
+      int from = max(base, startPos);
+      int n = (from == base) ? mLineChunks[i].lines : count_lines_(from, ce);
+      if (n >= nLines)
+        return skip_lines_(from, nLines);
+      nLines -= n;
+      base = ce;
+    }
+    return mLength;
+  }
+  return skip_lines_(startPos, nLines);
+}
+
+
+/*
+ Skip to the first character, n lines back, by scanning.
+ This function is optimized for speed by not using UTF-8 calls.
+ */
+int Fl_Text_Buffer::rewind_lines_(int startPos, int nLines) const
+{
   int pos = startPos - 1;
   if (pos <= 0)
     return 0;
@@ -1053,6 +1331,26 @@ int Fl_Text_Buffer::rewind_lines(int startPos, int nLines)
 }
 
 
+/*
+ Skip to the first character, n lines back.
+ StartPos must be at a character boundary.
+ On large buffers this is done with two indexed queries: the line number
+ of startPos, then the start of the line n lines above it.
+ */
+int Fl_Text_Buffer::rewind_lines(int startPos, int nLines)
+{
+  IS_UTF8_ALIGNED2(this, (startPos))
+
+  if (line_index()) {
+    int line = count_lines(0, startPos) - nLines;
+    if (line <= 0)
+      return 0;
+    return skip_lines(0, line);
+  }
+  return rewind_lines_(startPos, nLines);
+}
+
+
 /*
  Find a matching string in the buffer.
  */
@@ -1162,6 +1460,77 @@ int Fl_Text_Buffer::search_backward(int startPos, const char *searchString,
 
 
 
+/*
+ Record an insertion in the undo journal. Consecutive insertions at the
+ same spot (typing) extend the record on top of the journal; an insertion
+ where text was just removed turns that record into a replace. Any fresh
+ edit invalidates the redo journal.
+ */
+void Fl_Text_Buffer::record_insert_(int pos, int nInserted)
+{
+  Undo_Record *rec = mUndoList;
+  if (rec && rec->at == pos && rec->ninserted) {
+    rec->ninserted += nInserted;
+    rec->at = pos + nInserted;
+  } else if (rec && rec->at == pos && rec->nremoved) {
+    rec->ninserted = nInserted;
+    rec->at = pos + nInserted;
+  } else {
+    rec = (Undo_Record *) malloc(sizeof(Undo_Record));
+    rec->at = pos + nInserted;
+    rec->ninserted = nInserted;
+    rec->nremoved = 0;
+    rec->removed = NULL;
+    rec->next = mUndoList;
+    mUndoList = rec;
+  }
+  if (mRedoList) {
+    free_undo_records_(mRedoList);
+    mRedoList = NULL;
+  }
+}
+
+
+/*
+ Record a removal in the undo journal, keeping a copy of the removed
+ text. Must be called before the buffer is modified. A removal that ends
+ where the previous removal started (backspacing) is merged into the
+ record on top of the journal. Any fresh edit invalidates the redo
+ journal, and the journal is trimmed back to its byte budget.
+ */
+void Fl_Text_Buffer::record_remove_(int start, int end)
+{
+  char *cut = text_range(start, end);
+  int cutlen = end - start;
+
+  Undo_Record *rec = mUndoList;
+  if (rec && rec->at == end && rec->nremoved && !rec->ninserted) {
+    char *merged = (char *) malloc(cutlen + rec->nremoved + 1);
+    memcpy(merged, cut, cutlen);
+    memcpy(merged + cutlen, rec->removed, rec->nremoved + 1);
+    free(rec->removed);
+    free(cut);
+    rec->removed = merged;
+    rec->nremoved += cutlen;
+    rec->at = start;
+  } else {
+    rec = (Undo_Record *) malloc(sizeof(Undo_Record));
+    rec->at = start;
+    rec->ninserted = 0;
+    rec->nremoved = cutlen;
+    rec->removed = cut;
+    rec->next = mUndoList;
+    mUndoList = rec;
+  }
+  mUndoBytes += cutlen;
+  if (mRedoList) {
+    free_undo_records_(mRedoList);
+    mRedoList = NULL;
+  }
+  trim_undo_journal_();
+}
+
+
 /*
  Insert a string into the buffer.
  Pos must be at a character boundary. Text must be a correct UTF-8 string.
@@ -1187,19 +1556,17 @@ int Fl_Text_Buffer::insert_(int pos, const char *text)
   memcpy(&mBuf[pos], text, insertedLength);
   mGapStart += insertedLength;
   mLength += insertedLength;
+  if (mLineChunks) {
+    int nl = 0;
+    for (int i = 0; i < insertedLength; i++)
+      if (text[i] == '\n')
+        nl++;
+    line_index_insert(pos, insertedLength, nl);
+  }
   update_selections(pos, 0, insertedLength);
 
-  if (mCanUndo) {
-    if (undowidget == this && undoat == pos && undoinsert) {
-      undoinsert += insertedLength;
-    } else {
-      undoinsert = insertedLength;
-      undoyankcut = (undoat == pos) ? undocut : 0;
-    }
-    undoat = pos + insertedLength;
-    undocut = 0;
-    undowidget = this;
-  }
+  if (mCanUndo && !mReplayingUndo)
+    record_insert_(pos, insertedLength);
 
   return insertedLength;
 }
@@ -1211,39 +1578,15 @@ int Fl_Text_Buffer::insert_(int pos, const char *text)
  */
 void Fl_Text_Buffer::remove_(int start, int end)
 {
-  /* if the gap is not contiguous to the area to remove, move it there */
-
-  if (mCanUndo) {
-    if (undowidget == this && undoat == end && undocut) {
-      undobuffersize(undocut + end - start + 1);
-      memmove(undobuffer + end - start, undobuffer, undocut);
-      undocut += end - start;
-    } else {
-      undocut = end - start;
-      undobuffersize(undocut);
-    }
-    undoat = start;
-    undoinsert = 0;
-    undoyankcut = 0;
-    undowidget = this;
-  }
+  /* capture the removed text for undo before the buffer changes */
+  if (mCanUndo && !mReplayingUndo)
+    record_remove_(start, end);
 
-  if (start > mGapStart) {
-    if (mCanUndo)
-      memcpy(undobuffer, mBuf + (mGapEnd - mGapStart) + start,
-             end - start);
+  /* if the gap is not contiguous to the area to remove, move it there */
+  if (start > mGapStart)
     move_gap(start);
-  } else if (end < mGapStart) {
-    if (mCanUndo)
-      memcpy(undobuffer, mBuf + start, end - start);
+  else if (end < mGapStart)
     move_gap(end);
-  } else {
-    int prelen = mGapStart - start;
-    if (mCanUndo) {
-      memcpy(undobuffer, mBuf + start, prelen);
-      memcpy(undobuffer + prelen, mBuf + mGapEnd, end - start - prelen);
-    }
-  }
 
   /* expand the gap to encompass the deleted characters */
   mGapEnd += end - mGapStart;
@@ -1251,6 +1594,7 @@ void Fl_Text_Buffer::remove_(int start, int end)
 
   /* update the length */
   mLength -= end - start;
+  line_index_remove(start, end);
 
   /* fix up any selections which might be affected by the change */
   update_selections(start, end - start, 0);
@@ -1353,7 +1697,6 @@ void Fl_Text_Buffer::remove_selection_(Fl_Text_Selection * sel)
   if (!sel->position(&start, &end))
     return;
   remove(start, end);
-  //undoyankcut = undocut;
 }
 
 
@@ -1389,17 +1732,90 @@ void Fl_Text_Buffer::call_modify_callbacks(int pos, int nDeleted,
                                            int nInserted, int nRestyled,
                                            const char *deletedText) const {
   IS_UTF8_ALIGNED2(this, pos)
+  if (mBatchDepth > 0) {
+    /* While a batch of edits is open, pure insertions are not delivered but
+     merged into one pending callback. Only runs of newly inserted bytes may
+     be merged, or listeners would count untouched text as inserted, so any
+     insertion outside the pending range flushes what is pending first and
+     starts a new run. Everything else (deletions, restyling, selection
+     updates) flushes and is delivered right away. */
+    if (nDeleted == 0 && nRestyled == 0 && nInserted > 0) {
+      if (mBatchPos >= 0 && (pos < mBatchPos || pos > mBatchEnd))
+        call_deferred_callbacks();
+      if (mBatchPos < 0) {
+        mBatchPos = pos;
+        mBatchEnd = pos + nInserted;
+      } else {
+        mBatchEnd += nInserted;
+      }
+      return;
+    }
+    call_deferred_callbacks();
+  }
   for (int i = 0; i < mNModifyProcs; i++)
     (*mModifyProcs[i]) (pos, nInserted, nDeleted, nRestyled,
                         deletedText, mCbArgs[i]);
 }
 
 
+/*
+ Deliver the modify callback deferred while a batch of edits is open.
+ Must run before any mutation that would shift the pending range, see
+ call_predelete_callbacks().
+ */
+void Fl_Text_Buffer::call_deferred_callbacks() const {
+  if (mBatchPos < 0)
+    return;
+  int pos = mBatchPos;
+  int nInserted = mBatchEnd - mBatchPos;
+  mBatchPos = -1;
+  for (int i = 0; i < mNModifyProcs; i++)
+    (*mModifyProcs[i]) (pos, nInserted, 0, 0, NULL, mCbArgs[i]);
+}
+
+
+/**
+ Starts a batch of edits.
+
+ While a batch is open, the modify callbacks for consecutive insertions are
+ not called one by one but merged and deferred; attached displays therefore
+ recalculate their layout once per batch instead of once per insertion.
+ This makes a large difference when many small pieces of text are inserted
+ in a row, e.g. when tailing a log file into the buffer line by line.
+
+ Deletions and replacements inside a batch are delivered immediately (after
+ flushing whatever insertions are pending), so listeners always observe a
+ consistent view of the buffer. Batches may be nested; only the outermost
+ end_edits() delivers the pending callback.
+
+ \see end_edits(), batched_edits()
+ */
+void Fl_Text_Buffer::begin_edits() {
+  mBatchDepth++;
+}
+
+
+/**
+ Ends a batch of edits started with begin_edits() and delivers the deferred
+ modify callback, if any.
+ \see begin_edits()
+ */
+void Fl_Text_Buffer::end_edits() {
+  if (mBatchDepth > 0 && --mBatchDepth == 0)
+    call_deferred_callbacks();
+}
+
+
 /*
  Call all callbacks.
  Unicode safe.
  */
 void Fl_Text_Buffer::call_predelete_callbacks(int pos, int nDeleted) const {
+  /* an actual deletion will shift buffer positions, so a deferred insertion
+   callback must reach the listeners while its range is still valid; the
+   nDeleted == 0 notifications sent before insertions don't shift anything */
+  if (mBatchDepth > 0 && nDeleted > 0)
+    call_deferred_callbacks();
   for (int i = 0; i < mNPredeleteProcs; i++)
     (*mPredeleteProcs[i]) (pos, nDeleted, mPredeleteCbArgs[i]);
 }
@@ -1749,6 +2165,35 @@ static int utf8_input_filter(char *buffer,              // result buffer we fill
   return (int) (q - buffer);
 }
 
+/*
+ Returns true if the len bytes at text are strict UTF-8 without embedded NUL
+ bytes, i.e. the transcoding filter above would pass them through unchanged.
+ */
+static int is_strict_utf8(const char *text, int len)
+{
+  const char *p = text, *e = text + len;
+  char multibyte[5];
+  int l, lp;
+  unsigned u;
+  while (p < e) {
+    unsigned char c = *(unsigned char *) p;
+    if (c && c < 0x80) {        // neither NUL nor multibyte
+      p++;
+      continue;
+    }
+    if (c == 0)
+      return 0;
+    l = fl_utf8len1(*p);
+    if (p + l > e)
+      return 0;
+    u = fl_utf8decode(p, p + l, &lp);
+    if (lp != l || fl_utf8encode(u, multibyte) != l || memcmp(p, multibyte, l))
+      return 0;
+    p += l;
+  }
+  return 1;
+}
+
 const char *Fl_Text_Buffer::file_encoding_warning_message =
 "Displayed text contains the UTF-8 transcoding\n"
 "of the input file which was not UTF-8 encoded.\n"
@@ -1765,11 +2210,47 @@ const char *Fl_Text_Buffer::file_encoding_warning_message =
   FILE *fp;
   if (!(fp = fl_fopen(file, "r")))
     return 1;
+  input_file_was_transcoded = false;
+
+#ifndef EXAMPLE_ENCODING
+  /* Read the whole file with a single call and insert it in one piece if it
+   turns out to be strict UTF-8 already, which is by far the most common
+   case. This skips the byte-by-byte transcoding filter and needs a single
+   gap move and a single modify callback instead of one per chunk of buflen
+   bytes, which makes a difference of seconds on very large log files.
+   Files that are not seekable, not plain UTF-8, or too large for a single
+   insertion take the filter path below as before. */
+  long size = 0;
+  if (fseek(fp, 0, SEEK_END) == 0) {
+    size = ftell(fp);
+    rewind(fp);
+  }
+  if (size > 0 && size < INT_MAX) {
+    char *raw = (char *) malloc(size + 1);
+    if (raw) {
+      int r = (int) fread(raw, 1, size, fp);
+      if (r > 0 && !ferror(fp) && is_strict_utf8(raw, r)) {
+        raw[r] = 0;
+        insert(pos, raw);
+        free(raw);
+        fclose(fp);
+        return 0;
+      }
+      free(raw);
+      if (ferror(fp)) {
+        fclose(fp);
+        return 2;
+      }
+      rewind(fp);
+    }
+  }
+#endif
+
   char *buffer = new char[buflen + 1];
   char *endline, line[100];
   int l;
-  input_file_was_transcoded = false;
   endline = line;
+  begin_edits();        // one coalesced modify callback for all chunks
   while (true) {
 #ifdef EXAMPLE_ENCODING
     // example of 16-bit encoding: UTF-16
@@ -1787,6 +2268,7 @@ const char *Fl_Text_Buffer::file_encoding_warning_message =
     insert(pos, buffer);
     pos += l;
   }
+  end_edits();
   int e = ferror(fp) ? 2 : 0;
   fclose(fp);
   delete[]buffer;
@@ -133,11 +133,15 @@ Fl_Text_Display::Fl_Text_Display(int X, int Y, int W, int H, const char* l)
   mUnfinishedStyle = 0;
   mUnfinishedHighlightCB = 0;
   mHighlightCBArg = 0;
+  mRestyleChunk = 0;
+  mRestylePos = 0;
+  mRestyleActive = 0;
   mMaxsize = 0;
   mSuppressResync = 0;
   mNLinesDeleted = 0;
   mModifyingTabDistance = 0;    // XXX: UNUSED
   mColumnScale = 0;
+  mCharWidthStyle = -1;
   mCursor_color = FL_FOREGROUND_COLOR;
 
   mHScrollBar = new Fl_Scrollbar(0,0,1,1);
@@ -198,6 +202,10 @@ Fl_Text_Display::~Fl_Text_Display() {
     Fl::remove_timeout(scroll_timer_cb, this);
     scroll_direction = 0;
   }
+  if (mRestyleActive) {
+    Fl::remove_idle(restyle_idle_cb, this);
+    mRestyleActive = 0;
+  }
   if (mBuffer) {
     mBuffer->remove_modify_callback(buffer_modified_cb, this);
     mBuffer->remove_predelete_callback(buffer_predelete_cb, this);
@@ -421,9 +429,140 @@ void Fl_Text_Display::highlight_data(Fl_Text_Buffer *styleBuffer,
   mUnfinishedHighlightCB = unfinishedHighlightCB;
   mHighlightCBArg = cbArg;
   mColumnScale = 0;
+  mCharWidthStyle = -1;
 
   mStyleBuffer->canUndo(0);
   damage(FL_DAMAGE_EXPOSE);
+
+  /* new highlighting data invalidates whatever the background restyler
+   has examined so far; let it start over */
+  mRestylePos = 0;
+  schedule_restyle(0);
+}
+
+
+
+/**
+ \brief Recompute "unfinished" styles in the background.
+
+ Normally the highlight callback installed with highlight_data() is only
+ triggered while drawing, when a character with the "unfinished" style is
+ about to be displayed. Everything outside the visible text therefore stays
+ unparsed until it is scrolled into view, or the application parses the
+ whole buffer up front, which can block the user interface for a long time
+ on very large buffers.
+
+ Calling this method with a non-zero \p nbytes lets the display resolve
+ unfinished styles itself whenever the application is idle: each pass scans
+ up to \p nbytes style bytes, calls the highlight callback for any
+ "unfinished" entry it finds, and repaints the lines whose styles arrived.
+ The scan restarts at the position of every buffer modification, so freshly
+ pasted text is restyled soon after the paste without blocking input. The
+ visible range is still parsed on demand while drawing, i.e. before the
+ background passes get to it.
+
+ The callback must mark the style bytes it replaces by selecting them with
+ the style buffer's primary selection, the same protocol that is used to
+ extend redraw ranges during normal buffer modifications. A callback that
+ leaves a position unfinished is simply skipped, so the empty callback used
+ by applications that parse eagerly keeps working.
+
+ A \p nbytes value of 0 (default) turns background restyling off.
+
+ \param nbytes number of style bytes to examine per idle pass, e.g. 16384;
+   0 disables background restyling
+ \see Fl_Text_Display::highlight_data()
+ */
+void Fl_Text_Display::restyle_in_background(int nbytes) {
+  if (nbytes < 0) nbytes = 0;
+  mRestyleChunk = nbytes;
+  if (!nbytes) {
+    if (mRestyleActive) {
+      Fl::remove_idle(restyle_idle_cb, this);
+      mRestyleActive = 0;
+    }
+    return;
+  }
+  mRestylePos = 0;
+  schedule_restyle(0);
+}
+
+
+
+/**
+ Make sure the background restyler will (re)visit everything from \p pos to
+ the end of the buffer, and install the idle callback driving it if needed.
+ Does nothing unless background restyling is enabled and highlighting data
+ is attached.
+ \param pos restart the scan at this index at the latest
+ */
+void Fl_Text_Display::schedule_restyle(int pos) {
+  if (!mRestyleChunk || !mStyleBuffer || !mUnfinishedHighlightCB) return;
+  if (pos < mRestylePos) mRestylePos = pos;
+  if (!mRestyleActive) {
+    Fl::add_idle(restyle_idle_cb, this);
+    mRestyleActive = 1;
+  }
+}
+
+
+
+/**
+ Idle callback driving the background restyling passes.
+ \param cbArg "this" pointer for static callback function
+ */
+void Fl_Text_Display::restyle_idle_cb(void *cbArg) {
+  ((Fl_Text_Display *)cbArg)->restyle_pass();
+}
+
+
+
+/**
+ Run one background restyling pass.
+
+ Scans the next mRestyleChunk style bytes for the "unfinished" style,
+ triggers the highlight callback on them and requests a redraw of the
+ ranges the callback resolved. Uninstalls the idle callback once the scan
+ has reached the end of the style buffer.
+ */
+void Fl_Text_Display::restyle_pass() {
+  Fl_Text_Buffer *styleBuf = mStyleBuffer;
+  if (!styleBuf || !mUnfinishedHighlightCB || !buffer()) {
+    Fl::remove_idle(restyle_idle_cb, this);
+    mRestyleActive = 0;
+    return;
+  }
+
+  int len = styleBuf->length();
+  int end = mRestylePos + mRestyleChunk;
+  if (end > len) end = len;
+
+  Fl_Text_Selection *sel = styleBuf->primary_selection();
+  while (mRestylePos < end) {
+    if (styleBuf->byte_at(mRestylePos) == mUnfinishedStyle) {
+      int pos = buffer()->utf8_align(mRestylePos);
+      sel->selected(0);
+      (mUnfinishedHighlightCB)(pos, mHighlightCBArg);
+      /* Modifications to the style buffer are marked by selecting them with
+       the buffer's primary selection (see extend_range_for_styles());
+       repaint the lines whose styles just arrived */
+      if (sel->selected()) {
+        int s = buffer()->utf8_align(sel->start());
+        int e = buffer()->utf8_align(sel->end());
+        sel->selected(0);
+        redisplay_range(s, mBuffer->line_end(e) + 1);
+        end = min(end, styleBuf->length());
+      }
+      /* if the callback left the position unfinished it is skipped, so a
+       passive callback can not keep this idle callback spinning */
+    }
+    mRestylePos++;
+  }
+
+  if (mRestylePos >= styleBuf->length()) {
+    Fl::remove_idle(restyle_idle_cb, this);
+    mRestyleActive = 0;
+  }
 }
 
 
@@ -464,6 +603,7 @@ void Fl_Text_Display::resize(int X, int Y, int W, int H) {
 
   Fl_Widget::resize(X,Y,W,H);
   mColumnScale = 0; // force recomputation of the width of a column when display is rescaled
+  mCharWidthStyle = -1; // character widths must be measured again as well
   recalc_display();
 }
 
@@ -1683,6 +1823,10 @@ void Fl_Text_Display::buffer_modified_cb( int pos, int nInserted, int nDeleted,
   if ( nInserted != 0 || nDeleted != 0 )
     textD->mCursorPreferredXPos = -1;
 
+  /* let the background restyler revisit everything from the change on */
+  if ( nInserted != 0 || nDeleted != 0 )
+    textD->schedule_restyle( pos );
+
   /* Count the number of lines inserted and deleted, and in the case
    of continuous wrap mode, how much has changed */
   if (textD->mContinuousWrap) {
@@ -3566,6 +3710,14 @@ void Fl_Text_Display::wrapped_line_counter(Fl_Text_Buffer *buf, int startPos,
  insertion/deletion, though static display and wrapping and resizing
  should now be solid because they are now used for online help display.
 
+ Advance widths of ASCII characters depend only on the style byte, so they
+ are remembered in mCharWidth[] and served from there on the next request.
+ Wrapping and line counting re-measure large amounts of text; without the
+ cache a font engine round trip per character dominates those calculations.
+ The cache holds the widths for one style at a time, which is a good fit
+ because styled text comes in runs of equal style. It is emptied whenever
+ the font, the size, the style table or the screen scale may have changed.
+
  \param s text string
  \param xPix x pixel position needed for calculating tab widths
  \param pos offset within string
@@ -3581,7 +3733,16 @@ double Fl_Text_Display::measure_proportional_character(const char *s, int xPix,
 
   int charLen = fl_utf8len1(*s), style = 0;
   if (mStyleBuffer) {
-    style = mStyleBuffer->byte_at(pos);
+    style = (unsigned char)mStyleBuffer->byte_at(pos);
+  }
+  if (charLen == 1 && !(*s & 0x80)) {
+    if (style != mCharWidthStyle) {
+      for (int i = 0; i < 128; i++) mCharWidth[i] = -1.;
+      mCharWidthStyle = style;
+    }
+    double w = mCharWidth[(int)*s];
+    if (w < 0.) w = mCharWidth[(int)*s] = string_width(s, 1, style);
+    return w;
   }
   return string_width(s, charLen, style);
 }
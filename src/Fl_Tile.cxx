@@ -85,6 +85,7 @@
 #include <FL/Fl_Tile.H>
 #include <FL/Fl_Window.H>
 #include <FL/Fl_Rect.H>
+#include <FL/fl_draw.H>
 
 /**
   Drags the intersection at (\p oldx,\p oldy) to (\p newx,\p newy).
@@ -248,8 +249,12 @@ int Fl_Tile::handle(int event) {
     break;
 
   case FL_DRAG:
-    // This is necessary if CONSOLIDATE_MOTION in Fl_x.cxx is turned off:
-    // if (damage()) return 1; // don't fall behind
+    // Don't move the border again before the previous move was drawn, so
+    // each pane draws at most once per flush when motion events arrive
+    // faster than we can relayout (e.g. with CONSOLIDATE_MOTION in
+    // Fl_x.cxx turned off, or nested inside an Fl_Scroll). The skipped
+    // position is picked up by the next FL_DRAG or the FL_RELEASE below.
+    if (damage() && drag_mode_ != DRAG_OUTLINE) return 1; // don't fall behind
   case FL_RELEASE: {
     if (!sdrag) return 0; // should not happen
     Fl_Widget* r = resizable(); if (!r) r = this;
@@ -267,6 +272,21 @@ int Fl_Tile::handle(int event) {
       else if (newy > r->y()+r->h()) newy = r->y()+r->h();
     } else
       newy = sy;
+    if (drag_mode_ == DRAG_OUTLINE && window()) {
+      // only an outline follows the drag; the children are laid out and
+      // drawn once on release (see drag_mode(uchar))
+      window()->make_current();
+      if (event == FL_DRAG) {
+        if ((sdrag & (DRAGH|DRAGV)) == (DRAGH|DRAGV))
+          fl_overlay_rect(sx, sy, newx-sx, newy-sy);
+        else if (sdrag & DRAGH)
+          fl_overlay_rect(newx-1, y(), 3, h());
+        else
+          fl_overlay_rect(x(), newy-1, w(), 3);
+        return 1;
+      }
+      fl_overlay_clear();
+    }
     position(sx,sy,newx,newy);
     if (event == FL_DRAG) set_changed();
     do_callback();
@@ -294,4 +314,5 @@ int Fl_Tile::handle(int event) {
 Fl_Tile::Fl_Tile(int X,int Y,int W,int H,const char*L)
 : Fl_Group(X,Y,W,H,L)
 {
+  drag_mode_ = DRAG_IMMEDIATE;
 }
@@ -54,6 +54,7 @@ public:
   }
   void draw();
   void layout();
+  static void tip_measure();
   /** Shows the tooltip windows only if a tooltip text is available. */
   void show() {
     if (!tip) return;
@@ -75,16 +76,39 @@ Fl_Widget* Fl_Tooltip::widget_ = 0;
 static Fl_TooltipBox *window = 0;
 static int currentTooltipY, currentTooltipH;
 
+// Cached text measurement of 'tip', computed during the hover delay in
+// enter_area() so that showing the tooltip does no measurement on the
+// critical path. The extra fields record the settings the cached values
+// were measured with, so a font or wrap width change invalidates them.
+static const char *measured_tip = 0;
+static Fl_Font measured_font;
+static Fl_Fontsize measured_size;
+static int measured_wrap;
+static int measured_ww, measured_hh;
+
+void Fl_TooltipBox::tip_measure() {
+  if (measured_tip == tip && measured_font == Fl_Tooltip::font() &&
+      measured_size == Fl_Tooltip::size() && measured_wrap == Fl_Tooltip::wrap_width())
+    return;
+  fl_font(Fl_Tooltip::font(), Fl_Tooltip::size());
+  measured_ww = Fl_Tooltip::wrap_width();
+  measured_hh = 0;
+  fl_measure(tip, measured_ww, measured_hh, Fl_Tooltip::draw_symbols_);
+  measured_tip = tip;
+  measured_font = Fl_Tooltip::font();
+  measured_size = Fl_Tooltip::size();
+  measured_wrap = Fl_Tooltip::wrap_width();
+}
+
 Fl_Window *Fl_Tooltip::current_window(void)
 {
   return (Fl_Window*)window;
 }
 
 void Fl_TooltipBox::layout() {
-  fl_font(Fl_Tooltip::font(), Fl_Tooltip::size());
-  int ww = Fl_Tooltip::wrap_width();
-  int hh = 0;
-  fl_measure(tip, ww, hh, Fl_Tooltip::draw_symbols_);
+  tip_measure(); // no-op when pre-measured during the hover delay
+  int ww = measured_ww;
+  int hh = measured_hh;
   ww += (Fl_Tooltip::margin_width() * 2);
   hh += (Fl_Tooltip::margin_height() * 2);
 
@@ -294,6 +318,11 @@ void Fl_Tooltip::enter_area(Fl_Widget* wid, int x,int y,int w,int h, const char*
   Fl::remove_timeout(recent_timeout);
   // remember it:
   widget_ = wid; currentTooltipY = y; currentTooltipH = h; tip = t;
+  // pre-compute the layout now, during the hover delay: create the box
+  // widget and measure the wrapped text so that tooltip_timeout() only
+  // positions and maps the window when the delay expires
+  if (!window) window = new Fl_TooltipBox;
+  Fl_TooltipBox::tip_measure();
   // popup the tooltip immediately if it was recently up:
   if (recent_tooltip) {
     if (window) {
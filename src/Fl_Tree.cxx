@@ -85,6 +85,9 @@ Fl_Tree::Fl_Tree(int X, int Y, int W, int H, const char *L) : Fl_Group(X,Y,W,H,L
   _scrollbar_size  = 0;                         // 0: uses Fl::scrollbar_size()
 
   _lastselect       = 0;
+  _populatecb       = 0;
+  _populatedata     = 0;
+  _maxresident      = 0;
 
   box(FL_DOWN_BOX);
   color(FL_BACKGROUND2_COLOR, FL_SELECTION_COLOR);
@@ -1461,6 +1464,7 @@ int Fl_Tree::get_selected_items(Fl_Tree_Item_Array &ret_items) {
 ///
 int Fl_Tree::open(Fl_Tree_Item *item, int docallback) {
   if ( item->is_open() ) return(0);
+  populate(item);       // supply lazy children before they're shown
   item->open();         // handles recalc_tree()
   redraw();
   if ( docallback ) {
@@ -1550,6 +1554,7 @@ int Fl_Tree::close(Fl_Tree_Item *item, int docallback) {
   if ( docallback ) {
     do_callback_for_item(item, FL_TREE_REASON_CLOSED);
   }
+  if ( _populatecb ) evict_closed();    // enforce the resident item cap
   return(1);
 }
 
@@ -1582,6 +1587,145 @@ int Fl_Tree::close(const char *path, int docallback) {
   return(close(item, docallback));              // handles recalc_tree()
 }
 
+// INTERNAL: Count the items in the subtree rooted at 'item', including 'item'.
+static int count_subtree_items(const Fl_Tree_Item *item) {
+  int count = 1;
+  for ( int t=0; t<item->children(); t++ )
+    count += count_subtree_items(item->child(t));
+  return(count);
+}
+
+// INTERNAL: Is 'item' inside the subtree rooted at 'sub' (including 'sub' itself)?
+static int item_in_subtree(const Fl_Tree_Item *item, const Fl_Tree_Item *sub) {
+  while ( item ) {
+    if ( item == sub ) return(1);
+    item = item->parent();
+  }
+  return(0);
+}
+
+/// Set the callback that supplies an item's children on demand,
+/// enabling 'lazy population' of the tree.
+///
+/// Mark items whose children should be supplied on demand with
+/// Fl_Tree_Item::lazy(). Such items are drawn with a collapse icon even
+/// while childless; the first time one is opened with open(), the
+/// callback is invoked with the item and \p 'data', and should add the
+/// item's children with e.g. Fl_Tree::add(item, name). Children may
+/// themselves be marked lazy(), so only the expanded part of an
+/// arbitrarily large hierarchy is ever resident in memory.
+///
+/// Used together with max_resident_items(), closed subtrees the callback
+/// supplied are freed again when the tree grows too large, and are
+/// repopulated by the callback if reopened. Example:
+///
+/// \code
+///     void populate_cb(Fl_Tree_Item *item, void *data) {
+///       MyCatalog *catalog = (MyCatalog*)data;
+///       // Add 'item's children, marking subdirectories lazy
+///       for ( MyEntry *e = catalog->entries(item); e; e = e->next() ) {
+///         Fl_Tree_Item *child = item->tree()->add(item, e->name());
+///         if ( e->has_entries() ) child->lazy(1);
+///       }
+///     }
+///     ..
+///     tree->populate_callback(populate_cb, (void*)catalog);
+///     tree->max_resident_items(10000);
+///     tree->root()->lazy(1);
+/// \endcode
+///
+/// \param[in] cb   The callback to supply children, or 0 to disable.
+/// \param[in] data Optional user data passed to the callback.
+/// \see Fl_Tree_Item::lazy(), max_resident_items()
+/// \version 1.4.0
+///
+void Fl_Tree::populate_callback(Fl_Tree_Populate_Callback *cb, void *data) {
+  _populatecb   = cb;
+  _populatedata = data;
+}
+
+/// Returns the current populate callback, or 0 if none.
+/// \see populate_callback(Fl_Tree_Populate_Callback*,void*)
+/// \version 1.4.0
+///
+Fl_Tree_Populate_Callback *Fl_Tree::populate_callback() const {
+  return(_populatecb);
+}
+
+/// Returns the user data passed to the populate callback.
+/// \see populate_callback(Fl_Tree_Populate_Callback*,void*)
+/// \version 1.4.0
+///
+void *Fl_Tree::populate_user_data() const {
+  return(_populatedata);
+}
+
+/// Returns the resident item limit for lazily populated trees.
+/// \version 1.4.0
+///
+int Fl_Tree::max_resident_items() const {
+  return(_maxresident);
+}
+
+/// Set the maximum number of items kept resident in a lazily
+/// populated tree, or 0 for no limit (default).
+///
+/// Whenever an item is closed and the tree holds more than \p 'val'
+/// items, closed subtrees that were supplied by the populate callback
+/// are freed, deepest first, until the tree is back under the limit or
+/// nothing more can be freed. Freed items are repopulated by the
+/// callback if reopened. Has no effect without a populate callback.
+///
+/// \param[in] val Maximum number of resident items, or 0 for no limit.
+/// \see populate_callback()
+/// \version 1.4.0
+///
+void Fl_Tree::max_resident_items(int val) {
+  _maxresident = val;
+}
+
+// INTERNAL: Let the populate callback supply 'item's children
+//           if they're still pending.
+void Fl_Tree::populate(Fl_Tree_Item *item) {
+  if ( !_populatecb || !item->is_lazy() ) return;
+  item->lazy(0);                // clear first: callback may re-mark or open items
+  item->populated(1);           // children now evictable under the resident cap
+  _populatecb(item, _populatedata);
+}
+
+// INTERNAL: Evict closed, callback-populated subtrees until the tree
+//           is back under max_resident_items().
+void Fl_Tree::evict_closed() {
+  if ( _maxresident <= 0 || !_root ) return;
+  int resident = count_subtree_items(_root);
+  if ( resident <= _maxresident ) return;
+  evict_scan(_root, resident);
+}
+
+// INTERNAL: Recursive helper for evict_closed().
+//    Walks depth first so the deepest closed subtrees are freed first,
+//    and stops as soon as 'resident' is back under the limit.
+//
+void Fl_Tree::evict_scan(Fl_Tree_Item *item, int &resident) {
+  for ( int t=0; t<item->children(); t++ ) {
+    if ( resident <= _maxresident ) return;
+    evict_scan(item->child(t), resident);
+  }
+  if ( resident <= _maxresident ) return;
+  if ( item->is_open() ) return;                // children visible? keep them
+  if ( !item->is_populated() ) return;          // only evict what the callback supplied
+  if ( !item->has_children() ) return;
+  resident -= count_subtree_items(item) - 1;
+  // Evicted subtree may hold items the tree still points at
+  if ( _lastselect && item_in_subtree(_lastselect, item) && _lastselect != item )
+    _lastselect = 0;
+  if ( _callback_item && item_in_subtree(_callback_item, item) && _callback_item != item )
+    _callback_item = 0;
+  item->clear_children();       // item dtors reset _item_focus as needed
+  item->populated(0);
+  item->lazy(1);                // repopulate on next open()
+}
+
 /// See if \p 'item' is open.
 ///
 /// Items that are 'open' are themselves not necessarily visible;
@@ -34,6 +34,98 @@ static int event_inside(const int xywh[4]) {
   return(Fl::event_inside(xywh[0],xywh[1],xywh[2],xywh[3]));
 }
 
+// Index the child labels when there are at least this many children.
+//    Below this, a linear scan is as fast as a binary search,
+//    and not building an index keeps small items small.
+//
+#define FL_TREE_LABEL_INDEX_MIN 64
+
+/// One entry per labelled child in the parent's label index.
+/// See find_child_indexed().
+struct Fl_Tree_Item::Label_Index {
+  const char *label;            // the child's label
+  int index;                    // the child's position in _children
+};
+
+// qsort() comparator for the label index:
+//    ascending by label, equal labels keep child order.
+//
+int Fl_Tree_Item::label_index_compare(const void *a, const void *b) {
+  const Label_Index *A = (const Label_Index*)a;
+  const Label_Index *B = (const Label_Index*)b;
+  int ret = strcmp(A->label, B->label);
+  if ( ret ) return(ret);
+  return(A->index - B->index);
+}
+
+// Throw away the child label index.
+//    Called whenever the child array or a child's label changes;
+//    find_child_indexed() rebuilds the index on demand.
+//
+void Fl_Tree_Item::invalidate_label_index() {
+  if ( _lindex ) {
+    delete[] _lindex;
+    _lindex = 0;
+    _nlindex = 0;
+    _lchildren = 0;
+  }
+}
+
+// Return the index of the first immediate child with the label 'name'
+// using the child label index, building the index first if needed.
+//
+//    The index keeps the children sorted by label with equal labels in
+//    child order, so duplicate labels resolve to the lowest child index,
+//    exactly like the linear scan in find_child().
+//
+//    Children appended (not inserted) after the index was built don't
+//    invalidate it; they form an unindexed tail that is scanned linearly
+//    and folded into the index once the tail grows too large. This keeps
+//    repeated path-based add()s from rebuilding the index per call.
+//
+//    Returns index of found item, or -1 if not found.
+//
+int Fl_Tree_Item::find_child_indexed(const char *name) const {
+  int t;
+  // Index's unindexed tail grew larger than the index itself? rebuild
+  if ( _lindex &&
+       (children() - _lchildren) >
+         (_nlindex > FL_TREE_LABEL_INDEX_MIN ? _nlindex : FL_TREE_LABEL_INDEX_MIN) ) {
+    delete[] _lindex;
+    _lindex = 0;
+    _nlindex = 0;
+    _lchildren = 0;
+  }
+  if ( !_lindex ) {
+    _lindex = new Label_Index[children()];
+    _nlindex = 0;
+    for ( t=0; t<children(); t++ ) {
+      if ( child(t)->label() ) {
+        _lindex[_nlindex].label = child(t)->label();
+        _lindex[_nlindex].index = t;
+        _nlindex++;
+      }
+    }
+    qsort(_lindex, _nlindex, sizeof(Label_Index), label_index_compare);
+    _lchildren = children();
+  }
+  int lo = 0, hi = _nlindex;
+  while ( lo < hi ) {                   // find leftmost entry >= name
+    int mid = (lo + hi) / 2;
+    if ( strcmp(_lindex[mid].label, name) < 0 ) lo = mid + 1;
+    else                                        hi = mid;
+  }
+  if ( lo < _nlindex && strcmp(_lindex[lo].label, name) == 0 )
+    return(_lindex[lo].index);
+  // Not in the index? scan the tail of children appended since it was built.
+  //    All indexed children sit below _lchildren, so index hits (above)
+  //    still resolve duplicates to the lowest child index.
+  for ( t=_lchildren; t<children(); t++ )
+    if ( child(t)->label() && strcmp(child(t)->label(), name) == 0 )
+      return(t);
+  return(-1);
+}
+
 /// Constructor.
 /// Makes a new instance of Fl_Tree_Item using defaults from \p 'prefs'.
 /// \deprecated in 1.3.3 ABI -- you must use Fl_Tree_Item(Fl_Tree*) for proper horizontal scrollbar behavior.
@@ -66,11 +158,15 @@ void Fl_Tree_Item::_Init(const Fl_Tree_Prefs &prefs, Fl_Tree *tree) {
   _label_xywh[1]    = 0;
   _label_xywh[2]    = 0;
   _label_xywh[3]    = 0;
+  _label_width      = -1;
   _usericon         = 0;
   _userdeicon       = 0;
   _userdata         = 0;
   _parent           = 0;
   _children.manage_item_destroy(1);     // let array's dtor manage destroying Fl_Tree_Items
+  _lindex           = 0;
+  _nlindex          = 0;
+  _lchildren        = 0;
   _prev_sibling     = 0;
   _next_sibling     = 0;
 }
@@ -99,6 +195,7 @@ Fl_Tree_Item::~Fl_Tree_Item() {
   // focus item? set to null
   if ( _tree && this == _tree->_item_focus )
     { _tree->_item_focus = 0; }
+  invalidate_label_index();
   //_children.clear();          // array's destructor handles itself
 }
 
@@ -124,8 +221,12 @@ Fl_Tree_Item::Fl_Tree_Item(const Fl_Tree_Item *o) {
   _label_xywh[1]    = o->_label_xywh[1];
   _label_xywh[2]    = o->_label_xywh[2];
   _label_xywh[3]    = o->_label_xywh[3];
+  _label_width      = o->_label_width;  // same label+font, cached width still valid
   _usericon         = o->usericon();
   _userdata         = o->user_data();
+  _lindex           = 0;                // do not copy the label index
+  _nlindex          = 0;
+  _lchildren        = 0;
   _parent           = o->_parent;
   _prev_sibling     = 0;                // do not copy ptrs! use update_prev_next()
   _next_sibling     = 0;                // do not copy ptrs! use update_prev_next()
@@ -157,6 +258,8 @@ void Fl_Tree_Item::show_self(const char *indent) const {
 void Fl_Tree_Item::label(const char *name) {
   if ( _label ) { free((void*)_label); _label = 0; }
   _label = name ? fl_strdup(name) : 0;
+  _label_width = -1;            // invalidate cached label width
+  if ( _parent ) _parent->invalidate_label_index();     // index refers to old label
   recalc_tree();                // may change label geometry
 }
 
@@ -173,6 +276,7 @@ const Fl_Tree_Item *Fl_Tree_Item::child(int index) const {
 /// Clear all the children for this item.
 void Fl_Tree_Item::clear_children() {
   _children.clear();
+  invalidate_label_index();
   recalc_tree();                // may change tree geometry
 }
 
@@ -184,6 +288,8 @@ void Fl_Tree_Item::clear_children() {
 ///
 int Fl_Tree_Item::find_child(const char *name) {
   if ( name ) {
+    if ( children() >= FL_TREE_LABEL_INDEX_MIN )
+      return(find_child_indexed(name));
     for ( int t=0; t<children(); t++ )
       if ( child(t)->label() )
         if ( strcmp(child(t)->label(), name) == 0 )
@@ -199,11 +305,16 @@ int Fl_Tree_Item::find_child(const char *name) {
 /// \version 1.3.3
 ///
 const Fl_Tree_Item* Fl_Tree_Item::find_child_item(const char *name) const {
-  if ( name )
+  if ( name ) {
+    if ( children() >= FL_TREE_LABEL_INDEX_MIN ) {
+      int t = find_child_indexed(name);
+      return(t == -1 ? 0 : child(t));
+    }
     for ( int t=0; t<children(); t++ )
       if ( child(t)->label() )
         if ( strcmp(child(t)->label(), name) == 0 )
           return(child(t));
+  }
   return(0);
 }
 
@@ -222,18 +333,12 @@ Fl_Tree_Item* Fl_Tree_Item::find_child_item(const char *name) {
 /// \version 1.3.0 release
 ///
 const Fl_Tree_Item *Fl_Tree_Item::find_child_item(char **arr) const {
-  for ( int t=0; t<children(); t++ ) {
-    if ( child(t)->label() ) {
-      if ( strcmp(child(t)->label(), *arr) == 0 ) {     // match?
-        if ( *(arr+1) ) {                               // more in arr? descend
-          return(_children[t]->find_child_item(arr+1));
-        } else {                                        // end of arr? done
-          return(_children[t]);
-        }
-      }
-    }
+  const Fl_Tree_Item *item = find_child_item(*arr);     // match?
+  if ( !item ) return(0);
+  if ( *(arr+1) ) {                                     // more in arr? descend
+    return(item->find_child_item(arr+1));
   }
-  return(0);
+  return(item);                                         // end of arr? done
 }
 
 /// Non-const version of Fl_Tree_Item::find_child_item(char **arr) const.
@@ -309,10 +414,13 @@ Fl_Tree_Item *Fl_Tree_Item::add(const Fl_Tree_Prefs &prefs,
   item->_parent = this;
   switch ( prefs.sortorder() ) {
     case FL_TREE_SORT_NONE: {
+      // Appending doesn't move indexed children, so the label index
+      // stays valid; find_child_indexed() handles the unindexed tail.
       _children.add(item);
       return(item);
     }
     case FL_TREE_SORT_ASCENDING: {
+      invalidate_label_index();
       for ( int t=0; t<_children.total(); t++ ) {
         Fl_Tree_Item *c = _children[t];
         if ( c->label() && strcmp(c->label(), new_label) > 0 ) {
@@ -324,6 +432,7 @@ Fl_Tree_Item *Fl_Tree_Item::add(const Fl_Tree_Prefs &prefs,
       return(item);
     }
     case FL_TREE_SORT_DESCENDING: {
+      invalidate_label_index();
       for ( int t=0; t<_children.total(); t++ ) {
         Fl_Tree_Item *c = _children[t];
         if ( c->label() && strcmp(c->label(), new_label) < 0 ) {
@@ -403,6 +512,7 @@ Fl_Tree_Item *Fl_Tree_Item::insert(const Fl_Tree_Prefs &prefs, const char *new_l
   item->label(new_label);
   item->_parent = this;
   _children.insert(pos, item);
+  invalidate_label_index();
   recalc_tree();                // may change tree geometry
   return(item);
 }
@@ -438,6 +548,7 @@ Fl_Tree_Item *Fl_Tree_Item::insert_above(const Fl_Tree_Prefs &prefs, const char
 Fl_Tree_Item* Fl_Tree_Item::deparent(int pos) {
   Fl_Tree_Item *orphan = _children[pos];
   if ( _children.deparent(pos) < 0 ) return NULL;
+  invalidate_label_index();
   return orphan;
 }
 
@@ -452,6 +563,7 @@ int Fl_Tree_Item::reparent(Fl_Tree_Item *newchild, int pos) {
   int ret;
   if ( (ret = _children.reparent(newchild, this, pos)) < 0 ) return ret;
   newchild->parent(this);               // take custody
+  invalidate_label_index();
   return 0;
 }
 
@@ -464,6 +576,7 @@ int Fl_Tree_Item::reparent(Fl_Tree_Item *newchild, int pos) {
 /// \see move_above(), move_below(), move_into(), move(Fl_Tree_Item*,int,int)
 ///
 int Fl_Tree_Item::move(int to, int from) {
+  invalidate_label_index();
   return _children.move(to, from);
 }
 
@@ -626,6 +739,7 @@ Fl_Tree_Item *Fl_Tree_Item::replace_child(Fl_Tree_Item *olditem,
   newitem->_parent = this;
   // replace in array (handles stitching neighboring items)
   _children.replace(pos, newitem);
+  invalidate_label_index();
   recalc_tree();                        // newitem may have changed tree geometry
   return newitem;
 }
@@ -638,6 +752,7 @@ int Fl_Tree_Item::remove_child(Fl_Tree_Item *item) {
     if ( child(t) == item ) {
       item->clear_children();
       _children.remove(t);
+      invalidate_label_index();
       recalc_tree();            // may change tree geometry
       return(0);
     }
@@ -657,6 +772,7 @@ int Fl_Tree_Item::remove_child(const char *name) {
     if ( child(t)->label() ) {
       if ( strcmp(child(t)->label(), name) == 0 ) {
         _children.remove(t);
+        invalidate_label_index();
         recalc_tree();          // may change tree geometry
         return(0);
       }
@@ -673,6 +789,7 @@ int Fl_Tree_Item::remove_child(const char *name) {
 ///
 void Fl_Tree_Item::swap_children(int ax, int bx) {
   _children.swap(ax, bx);
+  invalidate_label_index();
 }
 
 /// Swap two of our immediate children, given item pointers.
@@ -835,6 +952,25 @@ static void draw_item_focus(Fl_Boxtype B, Fl_Color fg, Fl_Color bg, int X, int Y
 #endif*/
 }
 
+/// Return the width of the item's label() in pixels, measuring it if needed.
+/// The measured width is cached per item; changing the label(), labelfont()
+/// or labelsize() invalidates the cache, so scrolling a large tree doesn't
+/// re-measure every visible label on each redraw.
+/// Sets the label's font as a side effect, so callers can use fl_descent()
+/// and fl_draw() without calling fl_font() again.
+/// \returns label width in pixels, 0 if label() is NULL.
+///
+int Fl_Tree_Item::calc_label_width() const {
+  fl_font(_labelfont, _labelsize);
+  if ( _label_width < 0 ) {
+    int lw=0, lh=0;
+    if ( _label )
+      fl_measure(_label, lw, lh);       // get box around text (including white space)
+    _label_width = lw;
+  }
+  return(_label_width);
+}
+
 /// Return the item's 'visible' height. Takes into account the item's:
 ///    - visibility (if !is_visible(), returns 0)
 ///    - labelfont() height: if label() != NULL
@@ -856,7 +992,7 @@ int Fl_Tree_Item::calc_item_height(const Fl_Tree_Prefs &prefs) const {
        H < widget()->h()) {
     H = widget()->h();
   }
-  if ( has_children() && prefs.openicon() && H<prefs.openicon()->h() )
+  if ( (has_children() || is_lazy()) && prefs.openicon() && H<prefs.openicon()->h() )
     H = prefs.openicon()->h();
   if ( usericon() && H<usericon()->h() )
     H = usericon()->h();
@@ -974,15 +1110,13 @@ int Fl_Tree_Item::draw_item_content(int render) {
   if ( _label &&
        ( !widget() ||
          (prefs.item_draw_mode() & FL_TREE_ITEM_DRAW_LABEL_AND_WIDGET) ) ) {
+    int lw = calc_label_width();        // cached label width; also sets the label's font
+    int lx = label_x()+(_label ? prefs.labelmarginleft() : 0);
+    int ly = label_y()+(label_h()/2)+(_labelsize/2)-fl_descent()/2;
     if ( render ) {
       fl_color(fg);
-      fl_font(_labelfont, _labelsize);
+      fl_draw(_label, lx, ly);
     }
-    int lx = label_x()+(_label ? prefs.labelmarginleft() : 0);
-    int ly = label_y()+(label_h()/2)+(_labelsize/2)-fl_descent()/2;
-    int lw=0, lh=0;
-    fl_measure(_label, lw, lh);         // get box around text (including white space)
-    if ( render ) fl_draw(_label, lx, ly);
     xmax = lx + lw;                     // update max width of drawn item
   }
   return xmax;
@@ -1073,10 +1207,7 @@ void Fl_Tree_Item::draw(int X, int &Y, int W, Fl_Tree_Item *itemfocus,
              ? widget()->h() : H;
     if ( _label &&
          (prefs.item_draw_mode() & FL_TREE_ITEM_DRAW_LABEL_AND_WIDGET) ) {
-      fl_font(_labelfont, _labelsize);  // fldescent() needs this
-      int lw=0, lh=0;
-      fl_measure(_label,lw,lh);         // get box around text (including white space)
-      wx += (lw + prefs.widgetmarginleft());
+      wx += (calc_label_width() + prefs.widgetmarginleft());
     }
     if ( widget()->x() != wx || widget()->y() != wy ||
          widget()->w() != ww || widget()->h() != wh ) {
@@ -1112,7 +1243,8 @@ void Fl_Tree_Item::draw(int X, int &Y, int W, Fl_Tree_Item *itemfocus,
           }
         }
         // Draw collapse icon
-        if ( render && has_children() && prefs.showcollapse() ) {
+        //    Lazy items get one even while childless, so they can be opened.
+        if ( render && (has_children() || is_lazy()) && prefs.showcollapse() ) {
           // Draw icon image
           if ( is_open() ) {
             if ( active ) prefs.closeicon()->draw(icon_x,icon_y);
@@ -1186,7 +1318,7 @@ void Fl_Tree_Item::draw(int X, int &Y, int W, Fl_Tree_Item *itemfocus,
 /// Was the event on the 'collapse' button of this item?
 ///
 int Fl_Tree_Item::event_on_collapse_icon(const Fl_Tree_Prefs &prefs) const {
-  if ( is_visible() && is_active() && has_children() && prefs.showcollapse() ) {
+  if ( is_visible() && is_active() && (has_children() || is_lazy()) && prefs.showcollapse() ) {
     return(event_inside(_collapse_xywh) ? 1 : 0);
   } else {
     return(0);
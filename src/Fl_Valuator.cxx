@@ -37,6 +37,11 @@ Fl_Valuator::Fl_Valuator(int X, int Y, int W, int H, const char* L)
   max = 1;
   A = 0.0;
   B = 1;
+  coalesce_ = 0;
+}
+
+Fl_Valuator::~Fl_Valuator() {
+  if (coalesce_) Fl::remove_check(coalesced_cb_, this);
 }
 
 const double epsilon = 4.66e-10;
@@ -101,9 +106,43 @@ void Fl_Valuator::handle_drag(double v) {
     value_ = v;
     value_damage();
     set_changed();
-    if (when() & FL_WHEN_CHANGED) do_callback();
+    if (when() & FL_WHEN_CHANGED) {
+      if (coalesce_) {
+        // defer to just before the next flush; repeated drag events
+        // within one frame collapse into a single callback
+        if (!Fl::has_check(coalesced_cb_, this)) Fl::add_check(coalesced_cb_, this);
+      } else {
+        do_callback();
+      }
+    }
   }
 }
+
+// Runs once per flush cycle while a coalesced drag is under way,
+// delivering the value the valuator holds at that moment.
+void Fl_Valuator::coalesced_cb_(void *v) {
+  Fl_Valuator *self = (Fl_Valuator *)v;
+  Fl::remove_check(coalesced_cb_, v);
+  self->do_callback();
+}
+
+/**
+  Sets whether FL_WHEN_CHANGED callbacks are coalesced to the frame rate.
+
+  By default every pixel of thumb or knob movement fires the callback,
+  so a fast drag can invoke an expensive callback - repositioning an
+  Fl_Browser or Fl_Text_Display, say - many times per rendered frame.
+  With coalescing enabled (\p n non-zero) the valuator instead delivers
+  at most one FL_WHEN_CHANGED callback per flush cycle, just before the
+  display is updated, with the value current at that moment. The final
+  value of a drag is always delivered; FL_WHEN_RELEASE callbacks are
+  never deferred and supersede a pending coalesced one.
+*/
+void Fl_Valuator::coalesce_callbacks(uchar n) {
+  if (coalesce_ && !n) Fl::remove_check(coalesced_cb_, this);
+  coalesce_ = n;
+}
+
 /** Called after an FL_WHEN_RELEASE event is received and before the callback. */
 void Fl_Valuator::handle_release() {
   if (when()&FL_WHEN_RELEASE) {
@@ -113,6 +152,9 @@ void Fl_Valuator::handle_release() {
     clear_changed();
     // now do the callback only if slider in new position or always is on:
     if (value_ != previous_value_ || when() & FL_WHEN_NOT_CHANGED) {
+      // the release callback reports the final value, a pending
+      // coalesced callback would only repeat it
+      if (coalesce_) Fl::remove_check(coalesced_cb_, this);
       do_callback();
     }
   }
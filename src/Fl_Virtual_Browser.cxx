@@ -0,0 +1,302 @@
+//
+// Virtual (pull-model) browser widget for the Fast Light Tool Kit (FLTK).
+//
+// Copyright 1998-2026 by Bill Spitzak and others.
+//
+// This library is free software. Distribution and use rights are outlined in
+// the file "COPYING" which should have been included with this file.  If this
+// file is missing or damaged, see the license at:
+//
+//     https://www.fltk.org/COPYING.php
+//
+// Please see the following page on how to report bugs and issues:
+//
+//     https://www.fltk.org/bugs.php
+//
+
+#include <FL/Fl.H>
+#include <FL/Fl_Virtual_Browser.H>
+#include <FL/fl_draw.H>
+#include <FL/fl_utf8.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The browser stores no per-row data; an "item" is simply the 1 based row
+// number cast to a pointer, and NULL means no row. The text of a row is
+// fetched from the application callback (or from the load() buffer) each
+// time it is needed, so only the rows scrolled into view are ever touched.
+
+/**
+  The constructor makes an empty browser with no rows.
+  \param[in] X,Y,W,H position and size.
+  \param[in] L The label string, may be NULL.
+*/
+Fl_Virtual_Browser::Fl_Virtual_Browser(int X, int Y, int W, int H, const char *L)
+  : Fl_Browser_(X, Y, W, H, L)
+{
+  type(FL_NORMAL_BROWSER);
+  lines_ = 0;
+  row_cb_ = 0;
+  row_data_ = 0;
+  file_buffer_ = 0;
+  file_lines_ = 0;
+  load_fp_ = 0;
+  load_len_ = load_read_ = 0;
+  load_line_ = 0;
+  load_alloc_ = 0;
+}
+
+/**
+  The destructor frees the file data read by load(), if any.
+  The application data behind the row text callback is not touched.
+*/
+Fl_Virtual_Browser::~Fl_Virtual_Browser() {
+  if (load_fp_) {
+    Fl::remove_idle(index_chunk_cb, this);
+    fclose((FILE*)load_fp_);
+  }
+  if (file_lines_) free(file_lines_);
+  if (file_buffer_) free(file_buffer_);
+}
+
+void *Fl_Virtual_Browser::item_first() const {
+  return item_at(1);
+}
+
+void *Fl_Virtual_Browser::item_next(void *item) const {
+  return item_at((int)(fl_intptr_t)item + 1);
+}
+
+void *Fl_Virtual_Browser::item_prev(void *item) const {
+  return item_at((int)(fl_intptr_t)item - 1);
+}
+
+void *Fl_Virtual_Browser::item_last() const {
+  return item_at(lines_);
+}
+
+void *Fl_Virtual_Browser::item_at(int line) const {
+  if (line < 1 || line > lines_) return 0;
+  return (void*)(fl_intptr_t)line;
+}
+
+int Fl_Virtual_Browser::item_height(void *) const {
+  return incr_height();
+}
+
+int Fl_Virtual_Browser::item_width(void *item) const {
+  const char *str = item_text(item);
+  if (!str) return 6;
+  fl_font(textfont(), textsize());
+  return int(fl_width(str)) + 6;
+}
+
+const char *Fl_Virtual_Browser::item_text(void *item) const {
+  int line = (int)(fl_intptr_t)item;
+  if (line < 1 || line > lines_) return 0;
+  if (row_cb_) return row_cb_((Fl_Virtual_Browser*)this, line, row_data_);
+  if (file_lines_) return file_lines_[line-1];
+  return 0;
+}
+
+void Fl_Virtual_Browser::item_draw(void *item, int X, int Y, int W, int H) const {
+  const char *str = item_text(item);
+  if (!str || !*str) return;
+  fl_font(textfont(), textsize());
+  Fl_Color lcol = textcolor();
+  if (item_selected(item)) lcol = fl_contrast(lcol, selection_color());
+  if (!active_r()) lcol = fl_inactive(lcol);
+  fl_color(lcol);
+  fl_draw(str, X+3, Y, W-6, H, (Fl_Align)(FL_ALIGN_LEFT|FL_ALIGN_CLIP), 0, 0);
+}
+
+/**
+  The height of every row (and therefore the average row height)
+  in pixels. All rows use textfont() and textsize().
+  \returns The row height in pixels.
+*/
+int Fl_Virtual_Browser::incr_height() const {
+  fl_font(textfont(), textsize());
+  int hh = fl_height();
+  return hh > 2 ? hh : 2;
+}
+
+/**
+  The height of the entire list in pixels. Because every row has the
+  same height this costs nothing regardless of the list length.
+  \returns size() times the row height, in pixels.
+*/
+int Fl_Virtual_Browser::full_height() const {
+  return lines_ * incr_height();
+}
+
+/**
+  Sets how many rows are in the browser.
+  Growing the list keeps the scroll position and the selection, so a live
+  log can append rows by just increasing the count. Shrinking the list
+  scrolls back to the top and drops the selection if it is beyond the end.
+  \param[in] n The new number of rows.
+*/
+void Fl_Virtual_Browser::size(int n) {
+  if (n < 0) n = 0;
+  if (n == lines_) return;
+  if (n < lines_) {
+    if (value() > n) deselect();
+    lines_ = n;
+    new_list();
+  } else {
+    lines_ = n;
+    redraw_lines();
+  }
+}
+
+/**
+  Sets the callback that supplies the text of each row.
+  The callback takes precedence over rows read with load(). Passing a
+  NULL \p cb reverts to the load() data, if any.
+  The number of rows is still set with size(int); the callback is only
+  called for rows scrolled into view.
+  \param[in] cb The function returning the text of one row.
+  \param[in] data Arbitrary pointer passed through to \p cb.
+*/
+void Fl_Virtual_Browser::row_text_callback(Fl_Virtual_Browser_Row_Cb *cb, void *data) {
+  row_cb_ = cb;
+  row_data_ = data;
+  redraw_lines();
+}
+
+/**
+  Returns the text of row \p line, as supplied by the row text callback
+  or by load().
+  \param[in] line The row whose text is returned. (1 based)
+  \returns The row's text, or NULL if \p line is out of range or blank.
+*/
+const char *Fl_Virtual_Browser::text(int line) const {
+  return item_text(item_at(line));
+}
+
+/**
+  Removes all rows from the browser and frees the file data read
+  by load(), if any. The row text callback stays installed.
+*/
+void Fl_Virtual_Browser::clear() {
+  if (load_fp_) {
+    Fl::remove_idle(index_chunk_cb, this);
+    fclose((FILE*)load_fp_);
+    load_fp_ = 0;
+  }
+  if (file_lines_) {free(file_lines_); file_lines_ = 0;}
+  if (file_buffer_) {free(file_buffer_); file_buffer_ = 0;}
+  load_len_ = load_read_ = 0;
+  load_line_ = 0;
+  load_alloc_ = 0;
+  size(0);
+}
+
+/**
+  Clears the browser and reads the file, making each line of the file a
+  row of the browser. If the filename is NULL or a zero-length string
+  then this just clears the browser. Unlike Fl_Browser::load() the file
+  is kept in a single buffer that the rows point into, and only the
+  first slice of it is read before this returns: the widget can paint
+  at once no matter how large the file is, while the rest is read and
+  indexed from an idle handler with the scrollbar growing as rows
+  arrive. This returns zero if there was any error in opening the file,
+  in which case errno is set to the system error.
+  \param[in] filename The filename to load
+  \returns 1 if OK, 0 on error (errno has reason)
+*/
+int Fl_Virtual_Browser::load(const char *filename) {
+  clear();
+  if (!filename || !(filename[0])) return 1;
+  FILE *fl = fl_fopen(filename, "rb");
+  if (!fl) return 0;
+  if (fseek(fl, 0, SEEK_END)) {fclose(fl); return 0;}
+  long len = ftell(fl);
+  if (len < 0) {fclose(fl); return 0;}
+  rewind(fl);
+  char *buf = (char*)malloc(len+1);
+  if (!buf) {fclose(fl); return 0;}
+  buf[0] = 0;
+  file_buffer_ = buf;
+  load_fp_ = fl;
+  load_len_ = len;
+  load_read_ = 0;
+  load_line_ = buf;
+  load_alloc_ = 0;
+  // index the first slice now so there is something to paint, then let
+  // the idle handler pull in the rest:
+  index_chunk();
+  if (load_fp_) Fl::add_idle(index_chunk_cb, this);
+  return 1;
+}
+
+// Read the next slice of the file and extend the row index over the
+// lines it completes. The first slice is kept small so that opening a
+// huge file paints immediately; the following ones are larger and run
+// from the idle handler until the whole file is in.
+void Fl_Virtual_Browser::index_chunk() {
+  FILE *fl = (FILE*)load_fp_;
+  long chunk = load_read_ ? 8*1024*1024 : 1024*1024;
+  if (chunk > load_len_ - load_read_) chunk = load_len_ - load_read_;
+  long got = chunk > 0 ? (long)fread(file_buffer_ + load_read_, 1, chunk, fl) : 0;
+  load_read_ += got;
+  // a short read means EOF or a read error; stop with what we have
+  int done = got < chunk || load_read_ >= load_len_;
+  char *end = file_buffer_ + load_read_;
+  *end = 0;                     // keep the buffer NUL terminated
+  int n = lines_;
+  char *scan = end - got;       // newlines before this were all consumed
+  for (;;) {
+    char *nl = (char*)memchr(scan, '\n', end - scan);
+    if (!nl) {
+      // after the last slice, the remainder is a row without a newline:
+      if (!done || end <= load_line_) break;
+      nl = end;
+      scan = 0;                 // and that ends the scan
+    }
+    if (n >= load_alloc_) {
+      int na = load_alloc_ ? 2*load_alloc_ : 1024;
+      char **nlines = (char**)realloc(file_lines_, na * sizeof(char*));
+      if (!nlines) {done = 1; break;} // out of memory: stop with what we have
+      file_lines_ = nlines;
+      load_alloc_ = na;
+    }
+    if (nl > load_line_ && nl[-1] == '\r') nl[-1] = 0; // DOS line ending
+    *nl = 0;
+    file_lines_[n++] = load_line_;
+    load_line_ = nl+1;
+    if (!scan) break;
+    scan = nl+1;
+  }
+  if (done) {
+    fclose(fl);
+    load_fp_ = 0;
+  }
+  if (n != lines_) size(n);
+}
+
+void Fl_Virtual_Browser::index_chunk_cb(void *data) {
+  Fl_Virtual_Browser *b = (Fl_Virtual_Browser*)data;
+  b->index_chunk();
+  if (!b->load_fp_) Fl::remove_idle(index_chunk_cb, data);
+}
+
+/**
+  Returns the currently selected row, or 0 if none is selected.
+  \returns The selected row. (1 based)
+*/
+int Fl_Virtual_Browser::value() const {
+  return (int)(fl_intptr_t)selection();
+}
+
+/**
+  Selects row \p line and deselects any other row.
+  If \p line is out of range the selection is cleared.
+  \param[in] line The row to select. (1 based)
+*/
+void Fl_Virtual_Browser::value(int line) {
+  if (line < 1 || line > lines_) deselect();
+  else select(item_at(line));
+}
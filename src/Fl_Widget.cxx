@@ -118,6 +118,7 @@ Fl_Widget::Fl_Widget(int X, int Y, int W, int H, const char* L) {
   label_.size    = FL_NORMAL_SIZE;
   label_.color   = FL_FOREGROUND_COLOR;
   label_.align_  = FL_ALIGN_CENTER;
+  label_.layout  = 0;
   tooltip_       = 0;
   callback_      = default_callback;
   user_data_     = 0;
@@ -139,6 +140,7 @@ Fl_Widget::Fl_Widget(int X, int Y, int W, int H, const char* L) {
 
 void Fl_Widget::resize(int X, int Y, int W, int H) {
   x_ = X; y_ = Y; w_ = W; h_ = H;
+  if (parent_) parent_->invalidate_spatial_index();
 }
 
 // this is useful for parent widgets to call to resize children:
@@ -167,6 +169,7 @@ extern void fl_throw_focus(Fl_Widget*); // in Fl_x.cxx
 */
 Fl_Widget::~Fl_Widget() {
   Fl::clear_widget_pointer(this);
+  if (label_.layout) label_.cache_layout(0);
   if (flags() & COPIED_LABEL) free((void *)(label_.value));
   if (flags() & COPIED_TOOLTIP) free((void *)(tooltip_));
   // remove from parent group
@@ -292,6 +295,18 @@ void Fl_Widget::copy_label(const char *a) {
   if ((flags() & COPIED_LABEL) && (label_.value == a))
     return;
   if (a) {
+    if (flags() & COPIED_LABEL) {
+      // unchanged text? nothing to copy or redraw
+      if (!strcmp(label_.value, a))
+        return;
+      // new text fits in the existing copy? reuse it, so frequently
+      // updated labels don't free/reallocate on every change
+      if (strlen(a) <= strlen(label_.value)) {
+        memmove((void *)label_.value, a, strlen(a) + 1); // 'a' may overlap the old label
+        redraw_label();
+        return;
+      }
+    }
     label(fl_strdup(a));
     set_flag(COPIED_LABEL);
   } else {
@@ -35,6 +35,35 @@
 
 char *Fl_Window::default_xclass_ = 0L;
 
+double Fl_Window::resize_throttle_ = 0.0;
+
+/** Limits how often interactive resizing relayouts the widget tree.
+
+  While the user drags a resize corner the system can deliver geometry
+  changes much faster than an expensive layout - a large Fl_Table or a
+  deep Fl_Group hierarchy - can recompute. With a throttle of \p t
+  seconds the full child relayout runs at most once per \p t while a
+  resize storm is under way; intermediate geometries are skipped and a
+  final pass with the exact last geometry always follows, so windows
+  never end up laid out for a stale size.
+
+  The default of 0 relayouts on every geometry change, as before.
+
+  \param[in] t minimum time between relayouts in seconds, 0 to disable
+
+  \since FLTK 1.4.0
+*/
+void Fl_Window::resize_throttle(double t) {
+  resize_throttle_ = t > 0.0 ? t : 0.0;
+}
+
+/** Returns the minimum time between relayouts while resizing.
+  \see Fl_Window::resize_throttle(double)
+*/
+double Fl_Window::resize_throttle() {
+  return resize_throttle_;
+}
+
 char Fl_Window::show_iconic_ = 0;
 
 Fl_Window *Fl_Window::current_;
@@ -473,9 +502,31 @@ void Fl_Window::flush()
 {
   if (!shown()) return;
   make_current();
-  fl_clip_region(i->region);
-  i->region = 0;
-  draw();
+  int n = pWindowDriver->damage_rect_count();
+  if (i->region && n > 1 && (damage() & ~FL_DAMAGE_CHILD)) {
+    // Draw each damaged rectangle separately, so that two small updates in
+    // opposite corners of a large window cost two small repaints instead of
+    // one repaint of their common bounding box. This is only safe when
+    // everything inside the clip is redrawn unconditionally: with
+    // child-only damage, update_child() clears a child's damage on the
+    // first rectangle that touches it, so a child straddling two
+    // rectangles would never be repainted in the second one. That case
+    // takes the branch below and draws once, clipped to the exact union
+    // region, which still confines disjoint updates to their own
+    // rectangles.
+    fl_graphics_driver->XDestroyRegion(i->region);
+    i->region = 0;
+    for (int j = 0; j < n; j++) {
+      int X, Y, W, H;
+      pWindowDriver->damage_rect(j, X, Y, W, H);
+      fl_clip_region(fl_graphics_driver->XRectangleRegion(X, Y, W, H));
+      draw();
+    }
+  } else {
+    fl_clip_region(i->region);
+    i->region = 0;
+    draw();
+  }
 }
 
 
@@ -22,6 +22,7 @@
  */
 
 #include "Fl_Window_Driver.H"
+#include "Fl_Screen_Driver.H"
 #include <FL/Fl_Overlay_Window.H>
 #include <FL/fl_draw.H>
 #include <FL/Fl.H>
@@ -42,11 +43,44 @@ pWindow(win)
   shape_data_ = NULL;
   wait_for_expose_value = 0;
   other_xid = 0;
+  damage_rect_count_ = 0;
+  dirty_next_ = NULL;
+  on_dirty_list_ = 0;
+  db_w_ = db_h_ = 0;
+  db_scale_ = 1;
+  db_idle_sweeps_ = 0;
 }
 
 
 Fl_Window_Driver::~Fl_Window_Driver()
 {
+  remove_dirty(pWindow);
+}
+
+Fl_Window *Fl_Window_Driver::dirty_first_ = NULL;
+int Fl_Window_Driver::dirty_count_ = 0;
+
+void Fl_Window_Driver::add_dirty(Fl_Window *win) {
+  Fl_Window_Driver *dr = driver(win);
+  if (dr->on_dirty_list_) return;
+  dr->on_dirty_list_ = 1;
+  dr->dirty_next_ = dirty_first_;
+  dirty_first_ = win;
+  dirty_count_++;
+}
+
+void Fl_Window_Driver::remove_dirty(Fl_Window *win) {
+  Fl_Window_Driver *dr = driver(win);
+  if (!dr->on_dirty_list_) return;
+  for (Fl_Window **p = &dirty_first_; *p; p = &driver(*p)->dirty_next_) {
+    if (*p == win) {
+      *p = dr->dirty_next_;
+      break;
+    }
+  }
+  dr->on_dirty_list_ = 0;
+  dr->dirty_next_ = NULL;
+  dirty_count_--;
 }
 
 int Fl_Window_Driver::minw() {return pWindow->minw;}
@@ -132,11 +166,116 @@ void Fl_Window_Driver::draw_end()
 
 
 
+// --- shared double-buffer pool
+//
+// Every double-buffered window normally owns a full-size offscreen for
+// its whole lifetime, so a workspace with many windows holds many
+// windows' worth of backbuffer pixmaps even for windows that are never
+// repainted. The pool below bounds that: destroy_double_buffer() parks
+// buffers here instead of deleting them (up to buffer_pool_max_ bytes),
+// lease_double_buffer() reuses a parked buffer of the same size, and an
+// optional timer reclaims the buffers of windows that have not been
+// flushed for a while. A window whose buffer was reclaimed simply
+// redraws completely on its next flush, like after hide()/show().
+
+struct Fl_Buffer_Pool_Entry {
+  Fl_Offscreen off;
+  int w, h;                     // size in FLTK units
+  float scale;                  // screen scale the buffer was created under
+  size_t bytes;
+  Fl_Buffer_Pool_Entry *next;
+};
+static Fl_Buffer_Pool_Entry *buffer_pool = NULL; // most recently parked first
+static size_t buffer_pool_bytes = 0;
+
+size_t Fl_Window_Driver::buffer_pool_max_ = 0;
+double Fl_Window_Driver::buffer_idle_timeout_ = 0;
+
+// delete parked buffers (from the cold end) until the pool fits the cap
+static void trim_buffer_pool(size_t cap) {
+  while (buffer_pool_bytes > cap) {
+    Fl_Buffer_Pool_Entry **p = &buffer_pool;
+    while ((*p)->next) p = &(*p)->next;
+    Fl_Buffer_Pool_Entry *e = *p;
+    *p = NULL;
+    fl_delete_offscreen(e->off);
+    buffer_pool_bytes -= e->bytes;
+    delete e;
+  }
+}
+
+/**
+ Returns a backbuffer for a \p W x \p H window, reusing a pooled one of
+ the same size and screen scale when available.
+ */
+Fl_Offscreen Fl_Window_Driver::lease_double_buffer(int W, int H) {
+  float s = Fl::screen_driver()->scale(screen_num());
+  db_w_ = W; db_h_ = H; db_scale_ = s;
+  for (Fl_Buffer_Pool_Entry **p = &buffer_pool; *p; p = &(*p)->next) {
+    Fl_Buffer_Pool_Entry *e = *p;
+    if (e->w == W && e->h == H && e->scale == s) {
+      *p = e->next;
+      buffer_pool_bytes -= e->bytes;
+      Fl_Offscreen off = e->off;
+      delete e;
+      return off;
+    }
+  }
+  return fl_create_offscreen(W, H);
+}
+
 void Fl_Window_Driver::destroy_double_buffer() {
-  fl_delete_offscreen(other_xid);
+  if (other_xid && buffer_pool_max_) {
+    Fl_Buffer_Pool_Entry *e = new Fl_Buffer_Pool_Entry;
+    e->off = other_xid;
+    e->w = db_w_; e->h = db_h_; e->scale = db_scale_;
+    e->bytes = (size_t)(db_w_ * db_scale_) * (size_t)(db_h_ * db_scale_) * 4;
+    e->next = buffer_pool;
+    buffer_pool = e;
+    buffer_pool_bytes += e->bytes;
+    trim_buffer_pool(buffer_pool_max_);
+  } else {
+    fl_delete_offscreen(other_xid);
+  }
   other_xid = 0;
 }
 
+/**
+ Sets the byte cap of the backbuffer pool; 0 (the default) disables
+ pooling so destroyed backbuffers are deleted right away.
+ */
+void Fl_Window_Driver::buffer_pool_max(size_t bytes) {
+  buffer_pool_max_ = bytes;
+  trim_buffer_pool(bytes);
+}
+
+// Timer callback: reclaim the backbuffer of every window that was not
+// flushed during two consecutive sweeps, i.e. was idle for at least
+// buffer_idle_timeout_ seconds. flush() resets the per-window count.
+void Fl_Window_Driver::buffer_idle_sweep(void *) {
+  for (Fl_X *i = Fl_X::first; i; i = i->next) {
+    Fl_Window_Driver *dr = driver(i->w);
+    if (!dr->other_xid || dr->on_dirty_list_) continue; // about to be flushed
+    if (++dr->db_idle_sweeps_ >= 2) {
+      dr->destroy_double_buffer(); // virtual: pools or deletes as appropriate
+      dr->db_idle_sweeps_ = 0;
+    }
+  }
+  Fl::repeat_timeout(buffer_idle_timeout_, buffer_idle_sweep);
+}
+
+/**
+ Sets after how many seconds of not being flushed a window's backbuffer
+ is reclaimed; 0 (the default) keeps backbuffers for as long as the
+ window is shown. Reclaimed windows redraw completely on their next
+ flush, so very short timeouts trade redraw work for memory.
+ */
+void Fl_Window_Driver::buffer_idle_timeout(double secs) {
+  if (buffer_idle_timeout_ > 0) Fl::remove_timeout(buffer_idle_sweep);
+  buffer_idle_timeout_ = secs;
+  if (secs > 0) Fl::add_timeout(secs, buffer_idle_sweep);
+}
+
 void Fl_Window_Driver::shape_pixmap_(Fl_Image* pixmap) {
   Fl_RGB_Image* rgba = new Fl_RGB_Image((Fl_Pixmap*)pixmap);
   shape_alpha_(rgba, 3);
@@ -150,6 +289,7 @@ void Fl_Window_Driver::capture_titlebar_and_borders(Fl_RGB_Image*& top, Fl_RGB_I
 
 // This function is available for use by platform-specific, Fl_Window_Driver-derived classes
 int Fl_Window_Driver::hide_common() {
+  remove_dirty(pWindow);
   pWindow->clear_visible();
 
   if (!shown()) return 1;
@@ -205,14 +345,45 @@ int Fl_Window_Driver::can_do_overlay() {
 void Fl_Window_Driver::redraw_overlay() {
   ((Fl_Overlay_Window*)pWindow)->overlay_ = pWindow;
   pWindow->clear_damage((uchar)(pWindow->damage()|FL_DAMAGE_OVERLAY));
+  add_dirty(pWindow);
   Fl::damage(FL_DAMAGE_CHILD);
 }
 
 void Fl_Window_Driver::flush()
 {
+  db_idle_sweeps_ = 0; // the window is in use, see buffer_idle_sweep()
   pWindow->flush();
 }
 
+/**
+ Record one more damaged rectangle of the window.
+ The rectangle is merged with any recorded rectangle it touches; otherwise
+ it is appended to the list. When the list overflows, the rectangles are
+ marked unusable and flush() falls back to the merged Fl_X::region.
+ */
+void Fl_Window_Driver::add_damage_rect(int X, int Y, int W, int H) {
+  if (damage_rect_count_ > max_damage_rects) return; // already overflowed
+  for (int j = 0; j < damage_rect_count_; j++) {
+    int *r = damage_rect_[j];
+    if (X <= r[0] + r[2] && X + W >= r[0] && Y <= r[1] + r[3] && Y + H >= r[1]) {
+      // the rectangles touch: grow the recorded one to their bounding box
+      int x2 = (r[0] + r[2] > X + W) ? r[0] + r[2] : X + W;
+      int y2 = (r[1] + r[3] > Y + H) ? r[1] + r[3] : Y + H;
+      if (X < r[0]) r[0] = X;
+      if (Y < r[1]) r[1] = Y;
+      r[2] = x2 - r[0];
+      r[3] = y2 - r[1];
+      return;
+    }
+  }
+  if (damage_rect_count_ == max_damage_rects) {
+    collapse_damage_rects();
+    return;
+  }
+  int *r = damage_rect_[damage_rect_count_++];
+  r[0] = X; r[1] = Y; r[2] = W; r[3] = H;
+}
+
 int Fl_Window_Driver::set_cursor(Fl_Cursor) {
   return 0;
 }
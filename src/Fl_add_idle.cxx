@@ -18,6 +18,7 @@
 // Replaces the older set_idle() call (which is used to implement this)
 
 #include <FL/Fl.H>
+#include "Fl_System_Driver.H"
 
 struct idle_cb {
   void (*cb)(void*);
@@ -25,19 +26,99 @@ struct idle_cb {
   idle_cb *next;
 };
 
-// the callbacks are stored linked in a ring.  last points at the one
-// just called, first at the next to call.  last->next == first.
+// There are two priority tiers. The callbacks of each tier are stored
+// linked in a ring. last points at the one just called, first at the
+// next to call. last->next == first.
+// Tier 0 (Fl::add_idle()) runs round-robin on every idle pass as before;
+// tier 1 (Fl::add_idle_low()) is rate-limited to one callback per
+// Fl::idle_low_interval() so background work does not add jitter to the
+// default tier.
 
-static idle_cb* first;
-static idle_cb* last;
+struct idle_ring {
+  idle_cb* first;
+  idle_cb* last;
+};
+static idle_ring rings[2];
 static idle_cb* freelist;
 
-static void call_idle() {
-  idle_cb* p = first;
-  last = p; first = p->next;
+static double low_interval = 0.05; // seconds between low-priority callbacks
+static double low_due = 0.0;       // next time a low-priority callback may run
+
+static double idle_clock() {
+  time_t sec; int usec;
+  Fl::system_driver()->gettime(&sec, &usec);
+  return double(sec) + usec / 1000000.;
+}
+
+// rotate the ring one step and call the callback that comes up
+static void call_ring(idle_ring& r) {
+  idle_cb* p = r.first;
+  r.last = p; r.first = p->next;
   p->cb(p->data); // this may call add_idle() or remove_idle()!
 }
 
+static void call_idle() {
+  if (rings[0].first) call_ring(rings[0]);
+  if (rings[1].first) {
+    double now = idle_clock();
+    if (now >= low_due) {
+      low_due = now + low_interval;
+      call_ring(rings[1]);
+    }
+  }
+}
+
+static void add_idle_(int ring, Fl_Idle_Handler cb, void* data) {
+  extern Fl_Perf_Counters fl_perf_counters; // in Fl.cxx
+  idle_cb* p = freelist;
+  if (p) {freelist = p->next; fl_perf_counters.pool_reuses++;}
+  else {p = new idle_cb; fl_perf_counters.pool_allocs++;}
+  p->cb = cb;
+  p->data = data;
+  idle_ring& r = rings[ring];
+  if (r.first) {
+    r.last->next = p;
+    r.last = p;
+    p->next = r.first;
+  } else {
+    r.first = r.last = p;
+    p->next = p;
+    Fl::set_idle(call_idle);
+  }
+}
+
+static int has_idle_(int ring, Fl_Idle_Handler cb, void* data) {
+  idle_ring& r = rings[ring];
+  idle_cb* p = r.first;
+  if (!p) return 0;
+  for (;; p = p->next) {
+    if (p->cb == cb && p->data == data) return 1;
+    if (p==r.last) return 0;
+  }
+}
+
+static int remove_idle_(int ring, Fl_Idle_Handler cb, void* data) {
+  idle_ring& r = rings[ring];
+  idle_cb* p = r.first;
+  if (!p) return 0;
+  idle_cb* l = r.last;
+  for (;; p = p->next) {
+    if (p->cb == cb && p->data == data) break;
+    if (p==r.last) return 0; // not found
+    l = p;
+  }
+  if (l == p) { // only one
+    r.first = r.last = 0;
+    if (!rings[0].first && !rings[1].first) Fl::set_idle(0);
+  } else {
+    r.last = l;
+    r.first = l->next = p->next;
+  }
+  p->next = freelist;
+  freelist = p;
+  return 1;
+}
+
 /**
   Adds a callback function that is called every time by Fl::wait() and also
   makes it act as though the timeout is zero (this makes Fl::wait() return
@@ -56,53 +137,48 @@ static void call_idle() {
   FLTK will not recursively call the idle callback.
 */
 void Fl::add_idle(Fl_Idle_Handler cb, void* data) {
-  idle_cb* p = freelist;
-  if (p) freelist = p->next;
-  else p = new idle_cb;
-  p->cb = cb;
-  p->data = data;
-  if (first) {
-    last->next = p;
-    last = p;
-    p->next = first;
-  } else {
-    first = last = p;
-    p->next = p;
-    set_idle(call_idle);
-  }
+  add_idle_(0, cb, data);
+}
+
+/**
+  Adds a low-priority idle callback.
+
+  Low-priority callbacks are kept in their own round-robin ring and are
+  rate-limited: at most one of them is called per Fl::idle_low_interval()
+  seconds, after the default tier has had its turn. Use this tier for
+  background work (thumbnailing, prefetching, ...) that should not add
+  jitter to callbacks installed with Fl::add_idle().
+
+  Fl::has_idle() and Fl::remove_idle() work on both tiers.
+*/
+void Fl::add_idle_low(Fl_Idle_Handler cb, void* data) {
+  add_idle_(1, cb, data);
+}
+
+/**
+  Sets the minimum interval, in seconds, between two invocations of
+  low-priority idle callbacks added with Fl::add_idle_low().
+  The default is 0.05 seconds.
+*/
+void Fl::idle_low_interval(double seconds) {
+  low_interval = seconds > 0 ? seconds : 0;
+}
+
+/** Returns the interval set with idle_low_interval(double). */
+double Fl::idle_low_interval() {
+  return low_interval;
 }
 
 /**
   Returns true if the specified idle callback is currently installed.
 */
 int Fl::has_idle(Fl_Idle_Handler cb, void* data) {
-  idle_cb* p = first;
-  if (!p) return 0;
-  for (;; p = p->next) {
-    if (p->cb == cb && p->data == data) return 1;
-    if (p==last) return 0;
-  }
+  return has_idle_(0, cb, data) || has_idle_(1, cb, data);
 }
 
 /**
   Removes the specified idle callback, if it is installed.
 */
 void Fl::remove_idle(Fl_Idle_Handler cb, void* data) {
-  idle_cb* p = first;
-  if (!p) return;
-  idle_cb* l = last;
-  for (;; p = p->next) {
-    if (p->cb == cb && p->data == data) break;
-    if (p==last) return; // not found
-    l = p;
-  }
-  if (l == p) { // only one
-    first = last = 0;
-    set_idle(0);
-  } else {
-    last = l;
-    first = l->next = p->next;
-  }
-  p->next = freelist;
-  freelist = p;
+  if (!remove_idle_(0, cb, data)) remove_idle_(1, cb, data);
 }
@@ -64,6 +64,97 @@ int Fl::awake_ring_head_;
 int Fl::awake_ring_tail_;
 #endif
 
+// Compilers providing the __atomic builtins get a lock-free queue for the
+// awake handlers, so worker threads posting GUI updates never contend on a
+// mutex with each other or with the main thread draining the queue. Other
+// compilers keep the original mutex-guarded ring buffer.
+#if defined(__GNUC__) || defined(__clang__)
+#  define FL_AWAKE_LOCK_FREE 1
+#endif
+
+extern Fl_Perf_Counters fl_perf_counters; // defined in Fl.cxx
+
+#if FL_AWAKE_LOCK_FREE
+
+// A multi-producer single-consumer linked queue (D. Vyukov's design).
+// Producers atomically swap themselves into awake_head and then link the
+// previous head to the new node; the main thread consumes from awake_tail.
+// Nodes are allocated per message, so the queue grows as needed instead of
+// rejecting messages when a fixed ring fills up.
+struct Fl_Awake_Node {
+  Fl_Awake_Handler func;
+  void *data;
+  Fl_Awake_Node *next;
+};
+
+static Fl_Awake_Node *awake_head = 0; // where producers enqueue
+static Fl_Awake_Node *awake_tail = 0; // owned by the consuming (main) thread
+
+static int awake_depth = 0; // queued but not yet consumed messages
+
+// Track the number of queued messages and its high-water mark. Producers
+// race on the peak with plain stores, so under heavy threading it is an
+// approximation; the counters are diagnostics, not program logic.
+static void awake_count_post()
+{
+  __atomic_add_fetch(&fl_perf_counters.awake_posts, 1, __ATOMIC_RELAXED);
+  unsigned long d = (unsigned long)__atomic_add_fetch(&awake_depth, 1, __ATOMIC_RELAXED);
+  if (d > fl_perf_counters.awake_queue_peak)
+    fl_perf_counters.awake_queue_peak = d;
+}
+
+static void awake_queue_init()
+{
+  Fl::system_driver()->lock_ring();
+  if (!awake_head) {
+    // start with a stub node so producers never touch an empty queue
+    Fl_Awake_Node *stub = (Fl_Awake_Node*)malloc(sizeof(Fl_Awake_Node));
+    stub->next = 0;
+    awake_tail = stub;
+    __atomic_store_n(&awake_head, stub, __ATOMIC_RELEASE);
+  }
+  Fl::system_driver()->unlock_ring();
+}
+
+/** Adds an awake handler for use in awake(). */
+int Fl::add_awake_handler_(Fl_Awake_Handler func, void *data)
+{
+  if (!__atomic_load_n(&awake_head, __ATOMIC_ACQUIRE)) awake_queue_init();
+  Fl_Awake_Node *n = (Fl_Awake_Node*)malloc(sizeof(Fl_Awake_Node));
+  if (!n) return -1;
+  n->func = func;
+  n->data = data;
+  n->next = 0;
+  Fl_Awake_Node *prev = __atomic_exchange_n(&awake_head, n, __ATOMIC_ACQ_REL);
+  __atomic_store_n(&prev->next, n, __ATOMIC_RELEASE);
+  awake_count_post();
+  return 0;
+}
+
+/** Gets the last stored awake handler for use in awake(). */
+int Fl::get_awake_handler_(Fl_Awake_Handler &func, void *&data)
+{
+  Fl_Awake_Node *tail = awake_tail;
+  if (!tail) return -1; // no awake() call was made yet
+  Fl_Awake_Node *next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+  if (!next) {
+    if (tail == __atomic_load_n(&awake_head, __ATOMIC_ACQUIRE)) return -1; // empty
+    // a producer swapped awake_head but has not linked its node yet;
+    // it is between two instructions, so spin the few cycles this takes
+    do {
+      next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    } while (!next);
+  }
+  func = next->func;
+  data = next->data;
+  awake_tail = next; // the consumed node becomes the new stub
+  free(tail);
+  __atomic_sub_fetch(&awake_depth, 1, __ATOMIC_RELAXED);
+  return 0;
+}
+
+#else /* !FL_AWAKE_LOCK_FREE */
+
 static const int AWAKE_RING_SIZE = 1024;
 
 /** Adds an awake handler for use in awake(). */
@@ -93,6 +184,11 @@ int Fl::add_awake_handler_(Fl_Awake_Handler func, void *data)
     awake_ring_[awake_ring_head_] = func;
     awake_data_[awake_ring_head_] = data;
     awake_ring_head_ = next_head;
+    fl_perf_counters.awake_posts++;
+    unsigned long d = (unsigned long)((awake_ring_head_ - awake_ring_tail_
+                       + awake_ring_size_) % awake_ring_size_);
+    if (d > fl_perf_counters.awake_queue_peak)
+      fl_perf_counters.awake_queue_peak = d;
   }
   Fl::system_driver()->unlock_ring();
   return ret;
@@ -117,13 +213,16 @@ int Fl::get_awake_handler_(Fl_Awake_Handler &func, void *&data)
   return ret;
 }
 
+#endif /* FL_AWAKE_LOCK_FREE */
+
 /**
  Let the main thread know an update is pending and have it call a specific function.
  Registers a function that will be
  called by the main thread during the next message handling cycle.
  Returns 0 if the callback function was registered,
- and -1 if registration failed. Over a thousand awake callbacks can be
- registered simultaneously.
+ and -1 if registration failed. The message queue grows dynamically on most
+ platforms; where a fixed ring buffer is used instead, over a thousand awake
+ callbacks can be registered simultaneously.
 
  \see Fl::awake(void* message=0)
 */
@@ -133,6 +232,77 @@ int Fl::awake(Fl_Awake_Handler func, void *data) {
   return ret;
 }
 
+// Fl::awake_once() bookkeeping: the pending handler/data pairs, guarded by
+// the ring lock. The list only ever holds pairs that have been posted but
+// not yet run, so it stays short no matter how fast producers post.
+struct Fl_Awake_Once {
+  Fl_Awake_Handler func;
+  void *data;
+  Fl_Awake_Once *next;
+};
+static Fl_Awake_Once *awake_once_pending = 0;
+
+static void awake_once_dispatch(void *v)
+{
+  Fl_Awake_Once *e = (Fl_Awake_Once*)v;
+  Fl_Awake_Handler func = e->func;
+  void *data = e->data;
+  // unlink before calling the handler, so that the handler (or another
+  // thread running concurrently) can re-arm the pair for the next cycle
+  Fl::system_driver()->lock_ring();
+  for (Fl_Awake_Once **p = &awake_once_pending; *p; p = &(*p)->next) {
+    if (*p == e) { *p = e->next; break; }
+  }
+  Fl::system_driver()->unlock_ring();
+  free(e);
+  func(data);
+}
+
+/**
+ Like Fl::awake(Fl_Awake_Handler, void*), but coalesces repeated calls.
+
+ If the same handler/data pair is already queued and has not been called
+ yet, this does nothing and returns 0, so a worker thread posting updates
+ at a high rate wakes the main thread at most once per pair and per event
+ loop iteration instead of flooding the message queue. Once the handler
+ has been called, the next awake_once() with the same pair queues it again.
+
+ Returns 0 if the callback is queued (or was already queued), and -1 if
+ queueing failed.
+
+ \see Fl::awake(Fl_Awake_Handler, void*)
+*/
+int Fl::awake_once(Fl_Awake_Handler func, void *data)
+{
+  Fl::system_driver()->lock_ring();
+  for (Fl_Awake_Once *e = awake_once_pending; e; e = e->next) {
+    if (e->func == func && e->data == data) {
+      Fl::system_driver()->unlock_ring();
+      return 0; // already queued, the pending call will pick up this update
+    }
+  }
+  Fl_Awake_Once *e = (Fl_Awake_Once*)malloc(sizeof(Fl_Awake_Once));
+  if (!e) {
+    Fl::system_driver()->unlock_ring();
+    return -1;
+  }
+  e->func = func;
+  e->data = data;
+  e->next = awake_once_pending;
+  awake_once_pending = e;
+  Fl::system_driver()->unlock_ring();
+  int ret = Fl::awake(awake_once_dispatch, e);
+  if (ret) { // could not queue: take the pair out again
+    Fl::system_driver()->lock_ring();
+    for (Fl_Awake_Once **p = &awake_once_pending; *p; p = &(*p)->next) {
+      if (*p == e) { *p = e->next; break; }
+    }
+    Fl::system_driver()->unlock_ring();
+    free(e);
+  }
+  return ret;
+}
+
 /** \fn int Fl::lock()
     The lock() method blocks the current thread until it
     can safely access FLTK widgets and data. Child threads should
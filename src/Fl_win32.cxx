@@ -559,6 +559,13 @@ void Fl_WinAPI_Screen_Driver::open_display_platform() {
   }
   OleInitialize(0L);
 
+  // Let GDI queue more drawing calls per kernel transition (the default
+  // batch limit is 20). Batching only affects calls that return a boolean
+  // success value; anything whose result is needed flushes the queue first,
+  // so drawing semantics are unchanged while per-primitive call overhead
+  // drops noticeably on widget trees built from many small fills and lines.
+  GdiSetBatchLimit(1000);
+
   get_imm_module();
 }
 
@@ -1242,6 +1249,9 @@ static LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPar
         Fl_Region R, R2;
         Fl_X *i = Fl_X::i(window);
         Fl_Window_Driver::driver(window)->wait_for_expose_value = 0;
+        // the system update region is merged below without going through
+        // Fl_Widget::damage(), so the recorded damage rectangles are stale
+        Fl_Window_Driver::driver(window)->collapse_damage_rects();
         char redraw_whole_window = false;
         if (!i->region && window->damage()) {
           // Redraw the whole window...
@@ -1299,6 +1309,8 @@ static LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPar
         Fl_Window_Driver::driver(window)->flush();
         fl_restore_pen();
         window->clear_damage();
+        Fl_Window_Driver::driver(window)->clear_damage_rects();
+        Fl_Window_Driver::remove_dirty(window);
         return 0;
       } // case WM_PAINT
 
@@ -64,6 +64,60 @@ static int xfixes_event_base = 0;
 static bool have_xfixes = false;
 #  endif
 
+#  if HAVE_XSYNC
+#  include <X11/extensions/sync.h>
+static int have_xsync = -1; // extension presence, checked at first window creation
+
+// One record per top-level window taking part in the _NET_WM_SYNC_REQUEST
+// protocol: the window manager tags each resize with a counter value and
+// waits for the client to store it in the sync counter before presenting
+// the next frame, so the compositor only shows completed redraws.
+struct Fl_XSync_Rec {
+  Window window;
+  XSyncCounter counter;
+  XSyncValue value;     // frame value last received from the window manager
+  char armed;           // a sync request waits for its ConfigureNotify
+  char pending;         // the resize was handled, acknowledge at next flush
+  Fl_XSync_Rec *next;
+};
+static Fl_XSync_Rec *xsync_first = 0;
+
+static Fl_XSync_Rec *find_sync_rec(Window window) {
+  for (Fl_XSync_Rec *r = xsync_first; r; r = r->next)
+    if (r->window == window) return r;
+  return 0;
+}
+#  endif // HAVE_XSYNC
+
+// fl_x11_ack_sync_frames() - called from Fl_X11_Screen_Driver::flush()
+// after all damaged windows were redrawn: report the finished frames
+// to the window manager.
+void fl_x11_ack_sync_frames() {
+#  if HAVE_XSYNC
+  for (Fl_XSync_Rec *r = xsync_first; r; r = r->next) {
+    if (r->pending) {
+      XSyncSetCounter(fl_display, r->counter, r->value);
+      r->pending = 0;
+    }
+  }
+#  endif
+}
+
+// fl_x11_forget_sync_counter() - called when an X window is destroyed
+void fl_x11_forget_sync_counter(Window window) {
+#  if HAVE_XSYNC
+  for (Fl_XSync_Rec **p = &xsync_first; *p; p = &(*p)->next) {
+    if ((*p)->window == window) {
+      Fl_XSync_Rec *r = *p;
+      *p = r->next;
+      XSyncDestroyCounter(fl_display, r->counter);
+      delete r;
+      return;
+    }
+  }
+#  endif
+}
+
 #  include <X11/cursorfont.h>
 
 #  if HAVE_XCURSOR
@@ -114,6 +168,52 @@ struct FD {
 
 static FD *fd = 0;
 
+#  if USE_POLL
+#    define FL_FD_NUM(i) pollfds[i].fd
+#    define FL_FD_EVENTS(i) pollfds[i].events
+#  else
+#    define FL_FD_NUM(i) fd[i].fd
+#    define FL_FD_EVENTS(i) fd[i].events
+#  endif
+
+#  ifdef __linux__
+// An epoll instance mirrors the fd array, so waiting for events scales with
+// the number of ready descriptors instead of the number of watched ones.
+// It is created lazily by the first add_fd() call; if creation fails or the
+// FLTK_NO_EPOLL environment variable is set, the poll/select path is used.
+#    include <sys/epoll.h>
+static int epoll_fd = -2; // -2 = not tried yet, -1 = unavailable/disabled
+
+static int epoll_usable() {
+  if (epoll_fd == -2)
+    epoll_fd = getenv("FLTK_NO_EPOLL") ? -1 : epoll_create1(EPOLL_CLOEXEC);
+  return epoll_fd >= 0;
+}
+
+// (Re)register descriptor n with the union of the events of all fd array
+// entries watching it; the same descriptor may have one entry per event.
+static void epoll_update(int n) {
+  if (!epoll_usable()) return;
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.data.fd = n;
+  int found = 0;
+  for (int i = 0; i < nfds; i++) {
+    if (FL_FD_NUM(i) == n) {
+      found = 1;
+      if (FL_FD_EVENTS(i) & POLLIN) ev.events |= EPOLLIN;
+      if (FL_FD_EVENTS(i) & POLLOUT) ev.events |= EPOLLOUT;
+      if (FL_FD_EVENTS(i) & POLLERR) ev.events |= EPOLLERR;
+    }
+  }
+  if (!found) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, n, &ev);
+  } else if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, n, &ev) < 0) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, n, &ev);
+  }
+}
+#  endif /* __linux__ */
+
 void Fl_X11_System_Driver::add_fd(int n, int events, void (*cb)(int, void*), void *v) {
   remove_fd(n,events);
   int i = nfds++;
@@ -150,6 +250,9 @@ void Fl_X11_System_Driver::add_fd(int n, int events, void (*cb)(int, void*), voi
   if (events & POLLERR) FD_SET(n, &fdsets[2]);
   if (n > maxfd) maxfd = n;
 #  endif
+#  ifdef __linux__
+  epoll_update(n);
+#  endif
 }
 
 void Fl_X11_System_Driver::add_fd(int n, void (*cb)(int, void*), void* v) {
@@ -191,6 +294,9 @@ void Fl_X11_System_Driver::remove_fd(int n, int events) {
   if (events & POLLOUT) FD_CLR(n, &fdsets[1]);
   if (events & POLLERR) FD_CLR(n, &fdsets[2]);
 #  endif
+#  ifdef __linux__
+  epoll_update(n);
+#  endif
 }
 
 void Fl_X11_System_Driver::remove_fd(int n) {
@@ -201,9 +307,37 @@ extern int fl_send_system_handlers(void *e);
 
 #if CONSOLIDATE_MOTION
 static Fl_Window* send_motion;
-extern Fl_Window* fl_xmousewin;
 #endif
+extern Fl_Window* fl_xmousewin;
+// Wheel events arrive as one ButtonPress per tick and a fast touchpad
+// can queue many ticks per loop pass; sum them up and deliver a single
+// FL_MOUSEWHEEL once the queue drains, like the motion consolidation.
+static Fl_Window* send_wheel;
+static int wheel_dx, wheel_dy;
 static bool in_a_window; // true if in any of our windows, even destroyed ones
+
+// Root pointer position recorded from the event being dispatched, so that
+// Fl::get_mouse() called during event handling doesn't need an XQueryPointer
+// round trip to the server (which takes tens of ms on remote displays).
+// The cache is dropped whenever the event loop waits again.
+static int cached_mouse_x, cached_mouse_y;
+static char cached_mouse_valid = 0;
+
+// deliver the accumulated wheel ticks as one FL_MOUSEWHEEL event
+static void send_queued_wheel() {
+  if (!send_wheel) return;
+  Fl_Window *win = send_wheel;
+  send_wheel = 0;
+  Fl::e_dx = wheel_dx;
+  Fl::e_dy = wheel_dy;
+  wheel_dx = wheel_dy = 0;
+  // fl_throw_focus() clears fl_xmousewin when a window is hidden or
+  // destroyed; drop the ticks then instead of dispatching into it, like
+  // the motion consolidation does
+  if (win != fl_xmousewin) return;
+  Fl::handle(FL_MOUSEWHEEL, win);
+}
+
 static void do_queued_events() {
   in_a_window = true;
   while (XEventsQueued(fl_display,QueuedAfterReading)) {
@@ -213,6 +347,7 @@ static void do_queued_events() {
       continue;
     fl_handle(xevent);
   }
+  send_queued_wheel();
   // we send FL_LEAVE only if the mouse did not enter some other window:
   if (!in_a_window) Fl::handle(FL_LEAVE, 0);
 #if CONSOLIDATE_MOTION
@@ -233,6 +368,9 @@ void (*fl_unlock_function)() = nothing;
 // timeout, and >0 if any callbacks were done.
 int Fl_X11_Screen_Driver::poll_or_select_with_delay(double time_to_wait) {
 
+  // the pointer may move while we wait: query it again next time
+  cached_mouse_valid = 0;
+
   // OpenGL and other broken libraries call XEventsQueued
   // unnecessarily and thus cause the file descriptor to not be ready,
   // so we must check for already-read events:
@@ -246,6 +384,29 @@ int Fl_X11_Screen_Driver::poll_or_select_with_delay(double time_to_wait) {
 #  endif
   int n;
 
+#  ifdef __linux__
+  if (epoll_usable()) {
+    struct epoll_event ev[64];
+    int timeout_ms = time_to_wait < 2147483.648 ? int(time_to_wait*1000 + .5) : -1;
+    fl_unlock_function();
+    n = ::epoll_wait(epoll_fd, ev, 64, timeout_ms);
+    fl_lock_function();
+    if (n > 0) {
+      for (int k = 0; k < n; k++) {
+        int f = ev[k].data.fd;
+        short revents = 0;
+        if (ev[k].events & (EPOLLIN|EPOLLHUP)) revents |= POLLIN;
+        if (ev[k].events & EPOLLOUT) revents |= POLLOUT;
+        if (ev[k].events & EPOLLERR) revents |= POLLERR;
+        // the same descriptor may have one fd array entry per event
+        for (int i = 0; i < nfds; i++)
+          if (FL_FD_NUM(i) == f && (FL_FD_EVENTS(i) & revents)) fd[i].cb(f, fd[i].arg);
+      }
+    }
+    return n;
+  }
+#  endif
+
   fl_unlock_function();
 
   if (time_to_wait < 2147483.648) {
@@ -288,6 +449,12 @@ int Fl_X11_Screen_Driver::poll_or_select_with_delay(double time_to_wait) {
 int Fl_X11_Screen_Driver::poll_or_select() {
   if (XQLength(fl_display)) return 1;
   if (!nfds) return 0; // nothing to select or poll
+#  ifdef __linux__
+  if (epoll_usable()) {
+    struct epoll_event ev;
+    return ::epoll_wait(epoll_fd, &ev, 1, 0);
+  }
+#  endif
 #  if USE_POLL
   return ::poll(pollfds, nfds, 0);
 #  else
@@ -365,6 +532,12 @@ static Atom fl_NET_WM_FULLSCREEN_MONITORS;
 Atom fl_NET_WORKAREA;
 static Atom fl_NET_WM_ICON;
 static Atom fl_NET_ACTIVE_WINDOW;
+static Atom fl_NET_WM_STATE_MODAL;
+static Atom fl_NET_WM_STATE_SKIP_TASKBAR;
+static Atom fl_NET_WM_WINDOW_TYPE;
+static Atom fl_NET_WM_WINDOW_TYPE_MENU;
+static Atom fl_NET_WM_SYNC_REQUEST;
+static Atom fl_NET_WM_SYNC_REQUEST_COUNTER;
 
 /*
   Debug: translate Atom (number) to name: enable (1) if used below
@@ -718,46 +891,107 @@ void Fl_X11_Screen_Driver::open_display_platform() {
 void open_display_i(Display* d) {
   fl_display = d;
 
-  WM_DELETE_WINDOW      = XInternAtom(d, "WM_DELETE_WINDOW",    0);
-  WM_PROTOCOLS          = XInternAtom(d, "WM_PROTOCOLS",        0);
-  fl_MOTIF_WM_HINTS     = XInternAtom(d, "_MOTIF_WM_HINTS",     0);
-  TARGETS               = XInternAtom(d, "TARGETS",             0);
-  CLIPBOARD             = XInternAtom(d, "CLIPBOARD",           0);
-  TIMESTAMP             = XInternAtom(d, "TIMESTAMP",           0);
-  PRIMARY_TIMESTAMP     = XInternAtom(d, "PRIMARY_TIMESTAMP",   0);
-  CLIPBOARD_TIMESTAMP   = XInternAtom(d, "CLIPBOARD_TIMESTAMP", 0);
-  fl_XdndAware          = XInternAtom(d, "XdndAware",           0);
-  fl_XdndSelection      = XInternAtom(d, "XdndSelection",       0);
-  fl_XdndEnter          = XInternAtom(d, "XdndEnter",           0);
-  fl_XdndTypeList       = XInternAtom(d, "XdndTypeList",        0);
-  fl_XdndPosition       = XInternAtom(d, "XdndPosition",        0);
-  fl_XdndLeave          = XInternAtom(d, "XdndLeave",           0);
-  fl_XdndDrop           = XInternAtom(d, "XdndDrop",            0);
-  fl_XdndStatus         = XInternAtom(d, "XdndStatus",          0);
-  fl_XdndActionCopy     = XInternAtom(d, "XdndActionCopy",      0);
-  fl_XdndFinished       = XInternAtom(d, "XdndFinished",        0);
-  fl_XdndEnter          = XInternAtom(d, "XdndEnter",           0);
-  fl_XdndURIList        = XInternAtom(d, "text/uri-list",       0);
-  fl_Xatextplainutf     = XInternAtom(d, "text/plain;charset=UTF-8",0);
-  fl_Xatextplainutf2    = XInternAtom(d, "text/plain;charset=utf-8",0); // Firefox/Thunderbird needs this - See STR#2930
-  fl_Xatextplain        = XInternAtom(d, "text/plain",          0);
-  fl_XaText             = XInternAtom(d, "TEXT",                0);
-  fl_XaCompoundText     = XInternAtom(d, "COMPOUND_TEXT",       0);
-  fl_XaUtf8String       = XInternAtom(d, "UTF8_STRING",         0);
-  fl_XaTextUriList      = XInternAtom(d, "text/uri-list",       0);
-  fl_XaImageBmp         = XInternAtom(d, "image/bmp",           0);
-  fl_XaImagePNG         = XInternAtom(d, "image/png",           0);
-  fl_INCR               = XInternAtom(d, "INCR",                0);
-  fl_NET_WM_PID         = XInternAtom(d, "_NET_WM_PID",         0);
-  fl_NET_WM_NAME        = XInternAtom(d, "_NET_WM_NAME",        0);
-  fl_NET_WM_ICON_NAME   = XInternAtom(d, "_NET_WM_ICON_NAME",   0);
-  fl_NET_SUPPORTING_WM_CHECK = XInternAtom(d, "_NET_SUPPORTING_WM_CHECK", 0);
-  fl_NET_WM_STATE       = XInternAtom(d, "_NET_WM_STATE",       0);
-  fl_NET_WM_STATE_FULLSCREEN = XInternAtom(d, "_NET_WM_STATE_FULLSCREEN", 0);
-  fl_NET_WM_FULLSCREEN_MONITORS = XInternAtom(d, "_NET_WM_FULLSCREEN_MONITORS", 0);
-  fl_NET_WORKAREA       = XInternAtom(d, "_NET_WORKAREA",       0);
-  fl_NET_WM_ICON        = XInternAtom(d, "_NET_WM_ICON",        0);
-  fl_NET_ACTIVE_WINDOW  = XInternAtom(d, "_NET_ACTIVE_WINDOW",  0);
+  // Intern all atoms with one round trip to the server; calling
+  // XInternAtom() for each of them is a round trip per atom, which adds
+  // up noticeably on remote displays. The name list below must stay in
+  // the same order as the assignments that follow.
+  static const char *atom_names[] = {
+    "WM_DELETE_WINDOW",
+    "WM_PROTOCOLS",
+    "_MOTIF_WM_HINTS",
+    "TARGETS",
+    "CLIPBOARD",
+    "TIMESTAMP",
+    "PRIMARY_TIMESTAMP",
+    "CLIPBOARD_TIMESTAMP",
+    "XdndAware",
+    "XdndSelection",
+    "XdndEnter",
+    "XdndTypeList",
+    "XdndPosition",
+    "XdndLeave",
+    "XdndDrop",
+    "XdndStatus",
+    "XdndActionCopy",
+    "XdndFinished",
+    "text/uri-list",
+    "text/plain;charset=UTF-8",
+    "text/plain;charset=utf-8",         // Firefox/Thunderbird needs this - See STR#2930
+    "text/plain",
+    "TEXT",
+    "COMPOUND_TEXT",
+    "UTF8_STRING",
+    "image/bmp",
+    "image/png",
+    "INCR",
+    "_NET_WM_PID",
+    "_NET_WM_NAME",
+    "_NET_WM_ICON_NAME",
+    "_NET_SUPPORTING_WM_CHECK",
+    "_NET_WM_STATE",
+    "_NET_WM_STATE_FULLSCREEN",
+    "_NET_WM_FULLSCREEN_MONITORS",
+    "_NET_WORKAREA",
+    "_NET_WM_ICON",
+    "_NET_ACTIVE_WINDOW",
+    "_NET_WM_STATE_MODAL",
+    "_NET_WM_STATE_SKIP_TASKBAR",
+    "_NET_WM_WINDOW_TYPE",
+    "_NET_WM_WINDOW_TYPE_MENU",
+    "_NET_WM_SYNC_REQUEST",
+    "_NET_WM_SYNC_REQUEST_COUNTER"
+  };
+  const int n_atoms = (int)(sizeof(atom_names) / sizeof(atom_names[0]));
+  Atom atoms[sizeof(atom_names) / sizeof(atom_names[0])];
+  int na = 0;
+
+  XInternAtoms(d, (char **)atom_names, n_atoms, 0, atoms);
+
+  WM_DELETE_WINDOW      = atoms[na++];
+  WM_PROTOCOLS          = atoms[na++];
+  fl_MOTIF_WM_HINTS     = atoms[na++];
+  TARGETS               = atoms[na++];
+  CLIPBOARD             = atoms[na++];
+  TIMESTAMP             = atoms[na++];
+  PRIMARY_TIMESTAMP     = atoms[na++];
+  CLIPBOARD_TIMESTAMP   = atoms[na++];
+  fl_XdndAware          = atoms[na++];
+  fl_XdndSelection      = atoms[na++];
+  fl_XdndEnter          = atoms[na++];
+  fl_XdndTypeList       = atoms[na++];
+  fl_XdndPosition       = atoms[na++];
+  fl_XdndLeave          = atoms[na++];
+  fl_XdndDrop           = atoms[na++];
+  fl_XdndStatus         = atoms[na++];
+  fl_XdndActionCopy     = atoms[na++];
+  fl_XdndFinished       = atoms[na++];
+  fl_XdndURIList        = atoms[na++];
+  fl_Xatextplainutf     = atoms[na++];
+  fl_Xatextplainutf2    = atoms[na++];
+  fl_Xatextplain        = atoms[na++];
+  fl_XaText             = atoms[na++];
+  fl_XaCompoundText     = atoms[na++];
+  fl_XaUtf8String       = atoms[na++];
+  fl_XaTextUriList      = fl_XdndURIList;
+  fl_XaImageBmp         = atoms[na++];
+  fl_XaImagePNG         = atoms[na++];
+  fl_INCR               = atoms[na++];
+  fl_NET_WM_PID         = atoms[na++];
+  fl_NET_WM_NAME        = atoms[na++];
+  fl_NET_WM_ICON_NAME   = atoms[na++];
+  fl_NET_SUPPORTING_WM_CHECK = atoms[na++];
+  fl_NET_WM_STATE       = atoms[na++];
+  fl_NET_WM_STATE_FULLSCREEN = atoms[na++];
+  fl_NET_WM_FULLSCREEN_MONITORS = atoms[na++];
+  fl_NET_WORKAREA       = atoms[na++];
+  fl_NET_WM_ICON        = atoms[na++];
+  fl_NET_ACTIVE_WINDOW  = atoms[na++];
+  fl_NET_WM_STATE_MODAL = atoms[na++];
+  fl_NET_WM_STATE_SKIP_TASKBAR = atoms[na++];
+  fl_NET_WM_WINDOW_TYPE = atoms[na++];
+  fl_NET_WM_WINDOW_TYPE_MENU = atoms[na++];
+  fl_NET_WM_SYNC_REQUEST = atoms[na++];
+  fl_NET_WM_SYNC_REQUEST_COUNTER = atoms[na++];
 
   if (sizeof(Atom) < 4)
     atom_bits = sizeof(Atom) * 8;
@@ -814,9 +1048,15 @@ void Fl_X11_Screen_Driver::close_display() {
 
 int Fl_X11_Screen_Driver::get_mouse_unscaled(int &mx, int &my) {
   open_display();
-  Window root = RootWindow(fl_display, fl_screen);
-  Window c; int cx,cy; unsigned int mask;
-  XQueryPointer(fl_display, root, &root, &c, &mx, &my, &cx, &cy, &mask);
+  if (cached_mouse_valid) {
+    // reuse the position carried by the event being dispatched
+    mx = cached_mouse_x;
+    my = cached_mouse_y;
+  } else {
+    Window root = RootWindow(fl_display, fl_screen);
+    Window c; int cx,cy; unsigned int mask;
+    XQueryPointer(fl_display, root, &root, &c, &mx, &my, &cx, &cy, &mask);
+  }
 #if USE_XFT
   int screen = screen_num_unscaled(mx, my);
   return screen >= 0 ? screen : 0;
@@ -1222,6 +1462,10 @@ static void set_event_xy(Fl_Window *win) {
   Fl::e_y       = fl_xevent->xbutton.y/s;
   Fl::e_state   = fl_xevent->xbutton.state << 16;
   fl_event_time = fl_xevent->xbutton.time;
+  // remember the raw root position for Fl::get_mouse()
+  cached_mouse_x = fl_xevent->xbutton.x_root;
+  cached_mouse_y = fl_xevent->xbutton.y_root;
+  cached_mouse_valid = 1;
 #  ifdef __sgi
   // get the meta key off PC keyboards:
   if (fl_key_vector[18]&0x18) Fl::e_state |= FL_META;
@@ -1249,6 +1493,89 @@ static Fl_Window* resize_bug_fix;
 
 ////////////////////////////////////////////////////////////////
 
+// Applies the server-side geometry of a top-level window to the FLTK
+// window, relayouting its children if the size changed. Called for
+// ConfigureNotify events and for the final pass of a throttled resize.
+void fl_handle_configure(Fl_Window *window) {
+  // figure out where OS really put window
+  XWindowAttributes actual;
+  XGetWindowAttributes(fl_display, fl_xid(window), &actual);
+  Window cr; int X, Y, W = actual.width, H = actual.height;
+  XTranslateCoordinates(fl_display, fl_xid(window), actual.root,
+                        0, 0, &X, &Y, &cr);
+#if USE_XFT // detect when window centre changes screen
+  Fl_X11_Screen_Driver *d = (Fl_X11_Screen_Driver*)Fl::screen_driver();
+  Fl_X11_Window_Driver *wd = Fl_X11_Window_Driver::driver(window);
+  int olds = wd->screen_num();
+  int num = d->screen_num_unscaled(X+ actual.width/2, Y +actual.height/2);
+  if (num == -1) num = olds;
+  float s = d->scale(num);
+  if (num != olds) {
+    if (s != d->scale(olds) &&
+        !Fl_X11_Window_Driver::data_for_resize_window_between_screens_.busy &&
+        window->user_data() != &Fl_X11_Screen_Driver::transient_scale_display) {
+      Fl_X11_Window_Driver::data_for_resize_window_between_screens_.busy = true;
+      Fl_X11_Window_Driver::data_for_resize_window_between_screens_.screen = num;
+      // resize_after_screen_change() works also if called here, but calling it
+      // a second later gives a more pleasant user experience when moving windows between distinct screens
+      Fl::add_timeout(1, Fl_X11_Window_Driver::resize_after_screen_change, window);
+    }
+    wd->screen_num(num);
+  }
+#endif // USE_XFT
+
+  // tell Fl_Window about it and set flag to prevent echoing:
+  resize_bug_fix = window;
+#if USE_XFT
+  if (!Fl_X11_Window_Driver::data_for_resize_window_between_screens_.busy &&
+    ( ceil(W/s) != window->w() || ceil(H/s) != window->h() ) ) {
+      window->resize(rint(X/s), rint(Y/s), ceil(W/s), ceil(H/s));
+  } else {
+    window->position(rint(X/s), rint(Y/s));
+  }
+#else
+  window->resize(X, Y, W, H);
+#endif
+
+#if HAVE_XSYNC
+  Fl_XSync_Rec *r = find_sync_rec(fl_xid(window));
+  if (r && r->armed) {
+    r->armed = 0;
+    if (window->damage()) {
+      r->pending = 1;           // acknowledged after the redraw, at flush time
+    } else {
+      // nothing to redraw (e.g. a pure move): release the frame now
+      XSyncSetCounter(fl_display, r->counter, r->value);
+    }
+  }
+#endif // HAVE_XSYNC
+}
+
+// Resize throttling (see Fl_Window::resize_throttle()): configures
+// arriving less than the throttle interval after the last relayout are
+// parked here and applied - with the then-current geometry - when the
+// interval expires.
+static Window throttled_configure_xid = 0;
+static double last_configure_time = 0.0;
+
+static double configure_clock() {
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return (double)t.tv_sec + (double)t.tv_usec / 1000000.0;
+}
+
+static void throttled_configure(void *) {
+  Window xid = throttled_configure_xid;
+  throttled_configure_xid = 0;
+  Fl_Window *window = fl_find(xid);
+  if (window && !window->parent()) {
+    last_configure_time = configure_clock();
+    fl_handle_configure(window);
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
 static char unknown[] = "<unknown>";
 const int unknown_len = 10;
 
@@ -1272,6 +1599,104 @@ static int wasXExceptionRaised() {
 
 }
 
+////////////////////////////////////////////////////////////////
+// Incremental (INCR protocol, ICCCM 2.7.2) selection sends:
+//    A selection payload too large for one ChangeProperty request is
+//    streamed to the requestor through the normal event loop: we post
+//    the INCR size announcement instead of the data, then append one
+//    chunk each time the requestor deletes the property, and finish
+//    with a zero-length chunk.
+
+struct Fl_Incr_Send {
+  Fl_Incr_Send *next;
+  Window requestor;             // who asked for the selection
+  Atom property;                // property the data is streamed into
+  Atom target;                  // data type being sent
+  int clipboard;                // 0 = PRIMARY, 1 = CLIPBOARD
+  long offset;                  // bytes already sent
+};
+static Fl_Incr_Send *fl_incr_sends = 0;
+
+// Chunk size for incremental sends; matches the 64K slices used when
+// receiving (see getIncrData() and the Xdnd code).
+#define INCR_SEND_CHUNK 65536
+
+// Largest payload passed to the requestor in a single property change.
+// Anything bigger - and anything a non-BigRequests server couldn't take
+// in one request anyway - is streamed with the INCR protocol instead.
+static long incr_send_limit() {
+  long bytes = (XMaxRequestSize(fl_display) - 100) * 4;
+  if (bytes > 4 * INCR_SEND_CHUNK) bytes = 4 * INCR_SEND_CHUNK;
+  return bytes;
+}
+
+// Post the payload for one SelectionRequest, starting an incremental
+// transfer if it is too large for a single property change.
+static void fl_send_selection(const XSelectionEvent &e, int clipboard) {
+  long len = fl_selection_length[clipboard];
+  if (len > incr_send_limit()) {
+    Fl_Incr_Send *s = new Fl_Incr_Send;
+    s->requestor = e.requestor;
+    s->property  = e.property;
+    s->target    = e.target;
+    s->clipboard = clipboard;
+    s->offset    = 0;
+    s->next      = fl_incr_sends;
+    fl_incr_sends = s;
+    // we need PropertyNotify from the requestor to drive the transfer and
+    // StructureNotify so its DestroyNotify reaches incr_send_abort() if it
+    // dies mid-transfer; our own windows already select both
+    if (!fl_find(e.requestor))
+      XSelectInput(fl_display, e.requestor, PropertyChangeMask|StructureNotifyMask);
+    long bound = len;
+    XChangeProperty(fl_display, e.requestor, e.property, fl_INCR, 32, 0,
+                    (unsigned char*)&bound, 1);
+  } else {
+    XChangeProperty(fl_display, e.requestor, e.property, e.target, 8, 0,
+                    (unsigned char *)fl_selection_buffer[clipboard], (int)len);
+  }
+}
+
+// The requestor deleted the transfer property: send the next chunk.
+// Returns non-zero if the event belonged to an incremental send.
+static int handle_incr_send(const XPropertyEvent &pe) {
+  Fl_Incr_Send **sp = &fl_incr_sends;
+  while (*sp && ((*sp)->requestor != pe.window || (*sp)->property != pe.atom))
+    sp = &(*sp)->next;
+  Fl_Incr_Send *s = *sp;
+  if (!s) return 0;
+  long len = fl_selection_length[s->clipboard] - s->offset;
+  if (len > INCR_SEND_CHUNK) len = INCR_SEND_CHUNK;
+  if (len < 0) len = 0;         // selection was replaced underneath us: end the transfer
+  XChangeProperty(fl_display, s->requestor, s->property, s->target, 8, 0,
+                  (unsigned char*)fl_selection_buffer[s->clipboard] + s->offset, (int)len);
+  if (len == 0) {               // zero-length chunk terminates the transfer
+    *sp = s->next;
+    // stop listening unless another transfer to the same window is active
+    Fl_Incr_Send *o = fl_incr_sends;
+    while (o && o->requestor != s->requestor) o = o->next;
+    if (!o && !fl_find(s->requestor)) XSelectInput(fl_display, s->requestor, 0);
+    delete s;
+  } else {
+    s->offset += len;
+  }
+  return 1;
+}
+
+// Drop any transfers whose requestor window was destroyed.
+static void incr_send_abort(Window requestor) {
+  Fl_Incr_Send **sp = &fl_incr_sends;
+  while (*sp) {
+    if ((*sp)->requestor == requestor) {
+      Fl_Incr_Send *s = *sp;
+      *sp = s->next;
+      delete s;
+    } else {
+      sp = &(*sp)->next;
+    }
+  }
+}
+
 static bool getNextEvent(XEvent *event_return)
 {
   time_t t = time(NULL);
@@ -1469,9 +1894,19 @@ int fl_handle(const XEvent& thisevent)
   }
 #endif // USE_XRANDR
 
+  if (fl_incr_sends) { // incremental selection transfers in progress?
+    if (xevent.type == PropertyNotify &&
+        xevent.xproperty.state == PropertyDelete &&
+        handle_incr_send(xevent.xproperty)) return 1;
+    if (xevent.type == DestroyNotify)
+      incr_send_abort(xevent.xdestroywindow.window);
+  }
+
   if (xevent.type == PropertyNotify && xevent.xproperty.atom == fl_NET_WORKAREA) {
+    extern int fl_screen_configuration_serial; // in screen_xywh.cxx
     Fl_X11_Screen_Driver *d = (Fl_X11_Screen_Driver*)Fl::screen_driver();
     d->init_workarea();
+    fl_screen_configuration_serial++;
 #if USE_XFT
     after_display_rescale(&(d->current_xft_dpi));
 #endif // USE_XFT
@@ -1491,6 +1926,7 @@ int fl_handle(const XEvent& thisevent)
     static unsigned char* sn_buffer = 0;
     if (sn_buffer) {XFree(sn_buffer); sn_buffer = 0;}
     long bytesread = 0;
+    long chunksize = 65536; // in 32-bit units, i.e. 256 kB to begin with
     if (fl_xevent->xselection.property) for (;;) {
       // The Xdnd code pastes 64K chunks together, possibly to avoid
       // bugs in X servers, or maybe to avoid an extra round-trip to
@@ -1500,7 +1936,7 @@ int fl_handle(const XEvent& thisevent)
       if (XGetWindowProperty(fl_display,
                              fl_xevent->xselection.requestor,
                              fl_xevent->xselection.property,
-                             bytesread/4, 65536, 1, AnyPropertyType,
+                             bytesread/4, chunksize, 1, AnyPropertyType,
                              &actual, &format, &count, &remaining,
                              &portion)) break; // quit on error
 
@@ -1566,6 +2002,9 @@ int fl_handle(const XEvent& thisevent)
       // Cannot trust data to be null terminated
       sn_buffer[bytesread] = '\0';
       if (!remaining) break;
+      // the first reply told us how much is left: fetch it with a single
+      // request instead of one round trip per 256 kB
+      chunksize = (long)((remaining + 3) / 4);
     }
     if (sn_buffer && Fl::e_clipboard_type == Fl::clipboard_plain_text) {
       sn_buffer[bytesread] = 0;
@@ -1574,26 +2013,37 @@ int fl_handle(const XEvent& thisevent)
     if (!fl_selection_requestor) return 0;
     if (Fl::e_clipboard_type == Fl::clipboard_image) {
       if (bytesread == 0) return 0;
-      static char tmp_fname[21];
-      static Fl_Shared_Image *shared = 0;
-      strcpy(tmp_fname, "/tmp/clipboardXXXXXX");
-      int fd = mkstemp(tmp_fname);
-      if (fd == -1) return 0;
-      uchar *p = sn_buffer; ssize_t towrite = bytesread, written;
-      while (towrite) {
-        written = write(fd, p, towrite);
-        p += written; towrite -= written;
-        }
-      close(fd);
-      free(sn_buffer); sn_buffer = 0;
-      shared = Fl_Shared_Image::get(tmp_fname);
-      fl_unlink(tmp_fname);
-      if (!shared) return 0;
-      uchar *rgb = new uchar[shared->w() * shared->h() * shared->d()];
-      memcpy(rgb, shared->data()[0], shared->w() * shared->h() * shared->d());
-      Fl_RGB_Image *image = new Fl_RGB_Image(rgb, shared->w(), shared->h(), shared->d());
-      shared->release();
-      image->alloc_array = 1;
+      Fl_RGB_Image *image = NULL;
+      if (Fl_Image::decode_image_mem) { // set by fl_register_images()
+        // decode straight from the transferred bytes into the final image,
+        // without a temporary file and without copying the decoded pixels
+        image = Fl_Image::decode_image_mem(sn_buffer, (int)bytesread);
+        if (image && image->fail()) { delete image; image = NULL; }
+      }
+      if (image) {
+        free(sn_buffer); sn_buffer = 0;
+      } else { // fall back to decoding through a temporary file
+        static char tmp_fname[21];
+        static Fl_Shared_Image *shared = 0;
+        strcpy(tmp_fname, "/tmp/clipboardXXXXXX");
+        int fd = mkstemp(tmp_fname);
+        if (fd == -1) return 0;
+        uchar *p = sn_buffer; ssize_t towrite = bytesread, written;
+        while (towrite) {
+          written = write(fd, p, towrite);
+          p += written; towrite -= written;
+          }
+        close(fd);
+        free(sn_buffer); sn_buffer = 0;
+        shared = Fl_Shared_Image::get(tmp_fname);
+        fl_unlink(tmp_fname);
+        if (!shared) return 0;
+        uchar *rgb = new uchar[shared->w() * shared->h() * shared->d()];
+        memcpy(rgb, shared->data()[0], shared->w() * shared->h() * shared->d());
+        image = new Fl_RGB_Image(rgb, shared->w(), shared->h(), shared->d());
+        shared->release();
+        image->alloc_array = 1;
+      }
       Fl::e_clipboard_data = (void*)image;
     }
     else if (Fl::e_clipboard_type == Fl::clipboard_plain_text) {
@@ -1654,10 +2104,7 @@ int fl_handle(const XEvent& thisevent)
             // behave that insist on asking for XA_TEXT instead of UTF8_STRING
             // Does not change XA_STRING as that breaks xclipboard.
             if (e.target != XA_STRING) e.target = fl_XaUtf8String;
-            XChangeProperty(fl_display, e.requestor, e.property,
-                            e.target, 8, 0,
-                            (unsigned char *)fl_selection_buffer[clipboard],
-                            fl_selection_length[clipboard]);
+            fl_send_selection(e, clipboard);
           }
         } else { // no data available
           e.property = 0;
@@ -1670,10 +2117,7 @@ int fl_handle(const XEvent& thisevent)
                         XA_ATOM, atom_bits, 0, (unsigned char*)a, 1);
       } else {
         if (e.target == fl_XaImageBmp && fl_selection_length[clipboard]) {
-            XChangeProperty(fl_display, e.requestor, e.property,
-                            e.target, 8, 0,
-                            (unsigned char *)fl_selection_buffer[clipboard],
-                            fl_selection_length[clipboard]);
+            fl_send_selection(e, clipboard);
         } else {
           e.property = 0;
         }
@@ -1705,6 +2149,7 @@ int fl_handle(const XEvent& thisevent)
   if (window) switch (xevent.type) {
 
     case DestroyNotify: { // an X11 window was closed externally from the program
+      fl_x11_forget_sync_counter(xid); // its frame sync counter outlives the window
       Fl::handle(FL_CLOSE, window);
       Fl_X* X = Fl_X::i(window);
       if (X) { // indicates the FLTK window was not closed
@@ -1722,6 +2167,16 @@ int fl_handle(const XEvent& thisevent)
     const long* data = fl_xevent->xclient.data.l;
     if ((Atom)(data[0]) == WM_DELETE_WINDOW) {
       event = FL_CLOSE;
+#if HAVE_XSYNC
+    } else if (message == WM_PROTOCOLS && (Atom)(data[0]) == fl_NET_WM_SYNC_REQUEST) {
+      // the window manager tagged the coming ConfigureNotify; remember the
+      // frame value so the redraw it provokes can be acknowledged
+      Fl_XSync_Rec *r = find_sync_rec(fl_xevent->xclient.window);
+      if (r) {
+        XSyncIntsToValue(&r->value, (unsigned int)data[2], (int)data[3]);
+        r->armed = 1;
+      }
+#endif
     } else if (message == fl_XdndEnter) {
       fl_xmousewin = window;
       in_a_window = true;
@@ -1860,6 +2315,19 @@ int fl_handle(const XEvent& thisevent)
                      xevent.xexpose.width, xevent.xexpose.height);
 #endif
      }
+    if (xevent.type == GraphicsExpose && !xevent.xgraphicsexpose.count)
+      Fl_X11_Window_Driver::driver(window)->scroll_expose_wait_ = 0;
+    return 1;
+
+  case NoExpose:
+    // the source of a scroll copy was fully available after all
+    Fl_X11_Window_Driver::driver(window)->scroll_expose_wait_ = 0;
+    return 1;
+
+  case VisibilityNotify:
+    // tracked so that Fl_X11_Window_Driver::scroll() knows whether a copy
+    // within the window can uncover an obscured area
+    Fl_X11_Window_Driver::driver(window)->visibility_ = (char)xevent.xvisibility.state;
     return 1;
 
   case FocusIn:
@@ -2086,26 +2554,27 @@ int fl_handle(const XEvent& thisevent)
     set_event_xy(window);
     Fl::e_dx = Fl::e_dy = 0;
     if (xevent.xbutton.button == Button4) {
-      Fl::e_dy = -1; // Up
-      event = FL_MOUSEWHEEL;
+      wheel_dy--; // Up
     } else if (xevent.xbutton.button == Button5) {
-      Fl::e_dy = +1; // Down
-      event = FL_MOUSEWHEEL;
+      wheel_dy++; // Down
     } else if (xevent.xbutton.button == 6) {
-        Fl::e_dx = -1; // Left
-        event = FL_MOUSEWHEEL;
+      wheel_dx--; // Left
     } else if (xevent.xbutton.button == 7) {
-        Fl::e_dx = +1; // Right
-        event = FL_MOUSEWHEEL;
+      wheel_dx++; // Right
     } else {
+      // a click must see any scrolling that preceded it in this batch
+      send_queued_wheel();
       Fl::e_state |= (FL_BUTTON1 << (xevent.xbutton.button-1));
       event = FL_PUSH;
       checkdouble();
+      fl_xmousewin = window;
+      in_a_window = true;
+      break;
     }
-
-    fl_xmousewin = window;
+    // wheel tick: remember it and keep draining the queue
+    send_wheel = fl_xmousewin = window;
     in_a_window = true;
-    break;
+    return 0;
 
   case PropertyNotify:
     if (xevent.xproperty.atom == fl_NET_WM_STATE) {
@@ -2181,6 +2650,9 @@ int fl_handle(const XEvent& thisevent)
     Fl::e_state = xevent.xcrossing.state << 16;
     fl_xmousewin = 0;
     in_a_window = false; // make do_queued_events produce FL_LEAVE event
+    // the pointer is moving outside our windows: no more motion events
+    // will update the cached position, so stop using it
+    cached_mouse_valid = 0;
     return 0;
 
   // We cannot rely on the x,y position in the configure notify event.
@@ -2196,45 +2668,30 @@ int fl_handle(const XEvent& thisevent)
   case ConfigureNotify: {
     if (window->parent()) break; // ignore child windows
 
-    // figure out where OS really put window
-    XWindowAttributes actual;
-    XGetWindowAttributes(fl_display, fl_xid(window), &actual);
-    Window cr; int X, Y, W = actual.width, H = actual.height;
-    XTranslateCoordinates(fl_display, fl_xid(window), actual.root,
-                          0, 0, &X, &Y, &cr);
-#if USE_XFT // detect when window centre changes screen
-    Fl_X11_Screen_Driver *d = (Fl_X11_Screen_Driver*)Fl::screen_driver();
-    Fl_X11_Window_Driver *wd = Fl_X11_Window_Driver::driver(window);
-    int olds = wd->screen_num();
-    int num = d->screen_num_unscaled(X+ actual.width/2, Y +actual.height/2);
-    if (num == -1) num = olds;
-    float s = d->scale(num);
-    if (num != olds) {
-      if (s != d->scale(olds) &&
-          !Fl_X11_Window_Driver::data_for_resize_window_between_screens_.busy &&
-          window->user_data() != &Fl_X11_Screen_Driver::transient_scale_display) {
-        Fl_X11_Window_Driver::data_for_resize_window_between_screens_.busy = true;
-        Fl_X11_Window_Driver::data_for_resize_window_between_screens_.screen = num;
-        // resize_after_screen_change() works also if called here, but calling it
-        // a second later gives a more pleasant user experience when moving windows between distinct screens
-        Fl::add_timeout(1, Fl_X11_Window_Driver::resize_after_screen_change, window);
+    // A resize drag can queue ConfigureNotify faster than we relayout.
+    // Only the last geometry matters - fl_handle_configure() asks the
+    // server for the actual position anyway - so consume the backlog
+    // and lay out once.
+    XEvent scratch;
+    while (XCheckTypedWindowEvent(fl_display, xid, ConfigureNotify, &scratch)) {}
+
+    if (Fl_Window::resize_throttle() > 0.0) {
+      double now = configure_clock();
+      if (now - last_configure_time < Fl_Window::resize_throttle()) {
+        // too soon after the last relayout: park this window and apply
+        // its then-current geometry when the interval expires
+        if (throttled_configure_xid && throttled_configure_xid != xid)
+          throttled_configure(0); // a second window is resizing, flush the first
+        throttled_configure_xid = xid;
+        if (!Fl::has_timeout(throttled_configure))
+          Fl::add_timeout(last_configure_time + Fl_Window::resize_throttle() - now,
+                          throttled_configure);
+        break;
       }
-      wd->screen_num(num);
+      last_configure_time = now;
     }
-#endif // USE_XFT
 
-    // tell Fl_Window about it and set flag to prevent echoing:
-    resize_bug_fix = window;
-#if USE_XFT
-    if (!Fl_X11_Window_Driver::data_for_resize_window_between_screens_.busy &&
-      ( ceil(W/s) != window->w() || ceil(H/s) != window->h() ) ) {
-        window->resize(rint(X/s), rint(Y/s), ceil(W/s), ceil(H/s));
-    } else {
-      window->position(rint(X/s), rint(Y/s));
-    }
-#else
-    window->resize(X, Y, W, H);
-#endif
+    fl_handle_configure(window);
     break; // allow add_handler to do something too
     }
 
@@ -2488,10 +2945,10 @@ Fl_X* Fl_X::set_xid(Fl_Window* win, Window winxid) {
 int fl_background_pixel = -1; // hack to speed up bg box drawing
 int fl_disable_transient_for; // secret method of removing TRANSIENT_FOR
 
-static const int childEventMask = ExposureMask;
+static const int childEventMask = ExposureMask|VisibilityChangeMask;
 
 static const int XEventMask =
-ExposureMask|StructureNotifyMask
+ExposureMask|VisibilityChangeMask|StructureNotifyMask
 |KeyPressMask|KeyReleaseMask|KeymapStateMask|FocusChangeMask
 |ButtonPressMask|ButtonReleaseMask
 |EnterWindowMask|LeaveWindowMask
@@ -2650,8 +3107,32 @@ void Fl_X::make_xid(Fl_Window* win, XVisualInfo *visual, Colormap colormap)
 
     win->label(win->label(), win->iconlabel());
 
+    Atom protocols[2] = { WM_DELETE_WINDOW, fl_NET_WM_SYNC_REQUEST };
+    int n_protocols = 1;
+#if HAVE_XSYNC
+    if (have_xsync < 0) {
+      int event_base, error_base, major, minor;
+      have_xsync = XSyncQueryExtension(fl_display, &event_base, &error_base) &&
+                   XSyncInitialize(fl_display, &major, &minor);
+    }
+    if (have_xsync) {
+      // take part in _NET_WM_SYNC_REQUEST so the window manager paces
+      // interactive resizes to our completed frames
+      Fl_XSync_Rec *r = new Fl_XSync_Rec;
+      r->window = xp->xid;
+      XSyncIntToValue(&r->value, 0);
+      r->counter = XSyncCreateCounter(fl_display, r->value);
+      r->armed = r->pending = 0;
+      r->next = xsync_first;
+      xsync_first = r;
+      long counter = (long)r->counter;
+      XChangeProperty(fl_display, xp->xid, fl_NET_WM_SYNC_REQUEST_COUNTER,
+                      XA_CARDINAL, 32, 0, (unsigned char *)&counter, 1);
+      n_protocols = 2;
+    }
+#endif // HAVE_XSYNC
     XChangeProperty(fl_display, xp->xid, WM_PROTOCOLS,
-                    XA_ATOM, 32, 0, (uchar*)&WM_DELETE_WINDOW, 1);
+                    XA_ATOM, 32, 0, (uchar*)protocols, n_protocols);
 
     // send size limits and border:
     Fl_X11_Window_Driver::driver(win)->sendxjunk();
@@ -2679,19 +3160,15 @@ void Fl_X::make_xid(Fl_Window* win, XVisualInfo *visual, Colormap colormap)
       XSetTransientForHint(fl_display, xp->xid, fl_xid(wp));
       if (!wp->visible()) showit = 0; // guess that wm will not show it
       if (win->modal()) {
-        Atom net_wm_state = XInternAtom (fl_display, "_NET_WM_STATE", 0);
-        Atom net_wm_state_skip_taskbar = XInternAtom (fl_display, "_NET_WM_STATE_MODAL", 0);
-        XChangeProperty (fl_display, xp->xid, net_wm_state, XA_ATOM, 32,
-            PropModeAppend, (unsigned char*) &net_wm_state_skip_taskbar, 1);
+        XChangeProperty (fl_display, xp->xid, fl_NET_WM_STATE, XA_ATOM, 32,
+            PropModeAppend, (unsigned char*) &fl_NET_WM_STATE_MODAL, 1);
       }
     }
 
     // Make sure that borderless windows do not show in the task bar
     if (!win->border()) {
-      Atom net_wm_state = XInternAtom (fl_display, "_NET_WM_STATE", 0);
-      Atom net_wm_state_skip_taskbar = XInternAtom (fl_display, "_NET_WM_STATE_SKIP_TASKBAR", 0);
-      XChangeProperty (fl_display, xp->xid, net_wm_state, XA_ATOM, 32,
-          PropModeAppend, (unsigned char*) &net_wm_state_skip_taskbar, 1);
+      XChangeProperty (fl_display, xp->xid, fl_NET_WM_STATE, XA_ATOM, 32,
+          PropModeAppend, (unsigned char*) &fl_NET_WM_STATE_SKIP_TASKBAR, 1);
     }
 
     // If asked for, create fullscreen
@@ -2733,9 +3210,7 @@ void Fl_X::make_xid(Fl_Window* win, XVisualInfo *visual, Colormap colormap)
 
   // set the window type for menu and tooltip windows to avoid animations (compiz)
   if (win->menu_window() || win->tooltip_window()) {
-    Atom net_wm_type = XInternAtom(fl_display, "_NET_WM_WINDOW_TYPE", False);
-    Atom net_wm_type_kind = XInternAtom(fl_display, "_NET_WM_WINDOW_TYPE_MENU", False);
-    XChangeProperty(fl_display, xp->xid, net_wm_type, XA_ATOM, 32, PropModeReplace, (unsigned char*)&net_wm_type_kind, 1);
+    XChangeProperty(fl_display, xp->xid, fl_NET_WM_WINDOW_TYPE, XA_ATOM, 32, PropModeReplace, (unsigned char*)&fl_NET_WM_WINDOW_TYPE_MENU, 1);
   }
 
 #if HAVE_XFIXES
@@ -3010,6 +3485,12 @@ static void cache_pixmap_cursor(Fl_Cursor c, Cursor& cursor, Fl_Window *pWindow,
 
 int Fl_X11_Window_Driver::set_cursor(Fl_Cursor c) {
 
+  /* Setting the cursor the X window already has is a no-op; widgets that
+     update the cursor on every mouse move otherwise flood the connection
+     with XDefineCursor requests. */
+  if ((int)c == cursor_)
+    return 1;
+
   /* The cursors are cached, because creating one takes 0.5ms including
      opening, reading, and closing theme files. They are kept until program
      exit by design, which valgrind will note as reachable. */
@@ -3073,6 +3554,7 @@ int Fl_X11_Window_Driver::set_cursor(Fl_Cursor c) {
 #undef cache_cursor
 
   XDefineCursor(fl_display, fl_xid(pWindow), xc);
+  cursor_ = (int)c;
 
   return 1;
 }
@@ -3140,6 +3622,7 @@ int Fl_X11_Window_Driver::set_cursor(const Fl_RGB_Image *image, int hotx, int ho
 
   xc = XcursorImageLoadCursor(fl_display, cursor);
   XDefineCursor(fl_display, fl_xid(pWindow), xc);
+  cursor_ = -1; // not one of the Fl_Cursor shapes
   XFreeCursor(fl_display, xc);
 
   XcursorImageDestroy(cursor);
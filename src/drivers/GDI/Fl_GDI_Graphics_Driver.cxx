@@ -24,11 +24,17 @@
 
 /*
  * By linking this module, the following static method will instantiate the
- * Windows GDI Graphics driver as the main display driver.
+ * Windows GDI Graphics driver as the main display driver. When the library
+ * is built with USE_GDIPLUS, the GDI+ subclass is instantiated instead and
+ * lines, curves and polygon edges are drawn antialiased.
  */
 Fl_Graphics_Driver *Fl_Graphics_Driver::newMainGraphicsDriver()
 {
+#if USE_GDIPLUS
+  return new Fl_GDIplus_Graphics_Driver();
+#else
   return new Fl_GDI_Graphics_Driver();
+#endif
 }
 
 // Code used to switch output to an off-screen window.  See macros in
@@ -25,6 +25,7 @@
 #include <FL/Fl.H>
 #include <FL/platform.H>
 #include <FL/fl_draw.H>
+#include <string.h>
 
 // FIXME: all the global functions in this file should probably be protected
 // members of the driver class. Starting with 1.4 we will allow multiple drivers
@@ -43,15 +44,120 @@ HPALETTE fl_palette;
 static HGDIOBJ tmppen=0;
 static HPEN savepen=0;
 
+// Which pen the driver last selected into which device context. Repeated
+// color() calls with an unchanged color are frequent during widget drawing;
+// remembering the selection avoids a SelectObject round per call.
+static HDC selected_pen_gc = 0;
+static HPEN selected_pen = 0;
+
+// Forget the remembered pen selection. Must be called by any code that
+// selects or deletes pens behind the back of Fl_GDI_Graphics_Driver::color().
+void fl_forget_pen_selection(void) {
+  selected_pen_gc = 0;
+  selected_pen = 0;
+}
+
+// --- hash-consed pen cache
+//
+// Color and line style changes used to create a GDI pen and delete the
+// previous one, which churns thousands of GDI objects per frame when
+// drawing interleaves colors or styles. All pens now come from one list
+// keyed by (color, style word, width, dash pattern), kept in
+// most-recently-used order: a state change that repeats an earlier
+// combination reuses the live handle, and only genuinely new
+// combinations call ExtCreatePen(). The list is trimmed from the cold
+// end so the driver holds far fewer handles than the per-process GDI
+// object quota. The fl_xmap entries only point into this cache and no
+// longer own their pens.
+
+struct Fl_Pen_Cache_Entry {
+  HPEN pen;
+  COLORREF rgb;
+  int style;                  // the ExtCreatePen() style word
+  int width;
+  int ndashes;
+  DWORD dashes[16];
+  Fl_Pen_Cache_Entry *next;   // most recently used first
+};
+static Fl_Pen_Cache_Entry *pen_cache = 0;
+static int pen_cache_count = 0;
+#define FL_PEN_CACHE_MAX 64   // far below the default 10000 GDI handle quota
+
+static Fl_XMap fl_rgb_xmap;   // the xmap of the current non-indexed color
+
+// Deselect, unreference and delete a pen that leaves the cache.
+static void drop_pen(HPEN pen) {
+  HDC gc = (HDC)fl_graphics_driver->gc();
+  if (gc) {
+    HGDIOBJ oldpen = SelectObject(gc, GetStockObject(BLACK_PEN));
+    if (oldpen != (HGDIOBJ)pen) SelectObject(gc, oldpen);
+  }
+  for (int i = 0; i < 256; i++)
+    if (fl_xmap[i].pen == pen) { fl_xmap[i].pen = 0; fl_xmap[i].brush = -1; }
+  if (fl_rgb_xmap.pen == pen) { fl_rgb_xmap.pen = 0; fl_rgb_xmap.brush = -1; }
+  fl_forget_pen_selection();
+  DeleteObject(pen);
+}
+
+// Returns the pen for the given state, creating it only if no live pen
+// matches. The returned handle stays owned by the cache.
+HPEN fl_cached_pen(COLORREF rgb, int style, int width, int ndashes, const DWORD *dashes) {
+  for (Fl_Pen_Cache_Entry **p = &pen_cache; *p; p = &(*p)->next) {
+    Fl_Pen_Cache_Entry *e = *p;
+    if (e->rgb == rgb && e->style == style && e->width == width &&
+        e->ndashes == ndashes &&
+        (!ndashes || memcmp(e->dashes, dashes, ndashes * sizeof(DWORD)) == 0)) {
+      *p = e->next;           // move the hit to the hot end
+      e->next = pen_cache;
+      pen_cache = e;
+      return e->pen;
+    }
+  }
+  LOGBRUSH penbrush = {BS_SOLID, rgb, 0};
+  HPEN pen = ExtCreatePen(style, width, &penbrush, ndashes, ndashes ? dashes : 0);
+  if (!pen) return 0;
+  Fl_Pen_Cache_Entry *e = new Fl_Pen_Cache_Entry;
+  e->pen = pen;
+  e->rgb = rgb;
+  e->style = style;
+  e->width = width;
+  e->ndashes = ndashes;
+  if (ndashes) memcpy(e->dashes, dashes, ndashes * sizeof(DWORD));
+  e->next = pen_cache;
+  pen_cache = e;
+  if (++pen_cache_count > FL_PEN_CACHE_MAX) { // evict the coldest pen
+    Fl_Pen_Cache_Entry **t = &pen_cache;
+    while ((*t)->next) t = &(*t)->next;
+    Fl_Pen_Cache_Entry *victim = *t;
+    *t = 0;
+    drop_pen(victim->pen);
+    delete victim;
+    pen_cache_count--;
+  }
+  return pen;
+}
+
 void fl_cleanup_pens(void) {
   for (int i=0; i<256; i++) {
-    if (fl_xmap[i].pen) DeleteObject(fl_xmap[i].pen);
+    fl_xmap[i].pen = 0;
+    fl_xmap[i].brush = -1;
+  }
+  fl_rgb_xmap.pen = 0;
+  fl_rgb_xmap.brush = -1;
+  while (pen_cache) {
+    Fl_Pen_Cache_Entry *e = pen_cache;
+    pen_cache = e->next;
+    DeleteObject(e->pen);
+    delete e;
   }
+  pen_cache_count = 0;
+  fl_forget_pen_selection();
 }
 
 void fl_save_pen(void) {
     if(!tmppen) tmppen = CreatePen(PS_SOLID, 1, 0);
   savepen = (HPEN)SelectObject((HDC)fl_graphics_driver->gc(), tmppen);
+  fl_forget_pen_selection();
 }
 
 void fl_restore_pen(void) {
@@ -59,31 +165,21 @@ void fl_restore_pen(void) {
     DeleteObject(tmppen);
     tmppen = 0;
     savepen = 0;
+  fl_forget_pen_selection();
 }
 
 static void clear_xmap(Fl_XMap& xmap) {
   if (xmap.pen) {
-    HDC gc = (HDC)fl_graphics_driver->gc();
-    HGDIOBJ tmppen = GetStockObject(BLACK_PEN);
-    HGDIOBJ oldpen = SelectObject(gc, tmppen);       // Push out the current pen of the gc
-    if(oldpen != xmap.pen) SelectObject(gc, oldpen); // Put it back if it is not the one we are about to delete
-    DeleteObject((HGDIOBJ)(xmap.pen));
+    // the pen itself stays in the cache for reuse
     xmap.pen = 0;
     xmap.brush = -1;
+    fl_forget_pen_selection();
   }
 }
 
 static void set_xmap(Fl_XMap& xmap, COLORREF c, int lw) {
   xmap.rgb = c;
-  if (xmap.pen) {
-      HDC gc = (HDC)fl_graphics_driver->gc();
-      HGDIOBJ oldpen = SelectObject(gc,GetStockObject(BLACK_PEN)); // replace current pen with safe one
-      if (oldpen != xmap.pen)SelectObject(gc,oldpen);              // if old one not xmap.pen, need to put it back
-      DeleteObject(xmap.pen);                                         // delete pen
-  }
-//  xmap.pen = CreatePen(PS_SOLID, 1, xmap.rgb);                        // get a pen into xmap.pen
-  LOGBRUSH penbrush = {BS_SOLID, xmap.rgb, 0};
-  xmap.pen = ExtCreatePen(PS_GEOMETRIC | PS_ENDCAP_FLAT | PS_JOIN_ROUND, lw, &penbrush, 0, 0);
+  xmap.pen = fl_cached_pen(c, PS_GEOMETRIC | PS_ENDCAP_FLAT | PS_JOIN_ROUND, lw, 0, 0);
   xmap.pwidth = lw;
   xmap.brush = -1;
 }
@@ -109,12 +205,16 @@ void Fl_GDI_Graphics_Driver::color(Fl_Color i) {
 #endif
     }
     fl_current_xmap = &xmap;
-    SelectObject(gc_, (HGDIOBJ)(xmap.pen));
+    if (gc_ != selected_pen_gc || xmap.pen != selected_pen) {
+      SelectObject(gc_, (HGDIOBJ)(xmap.pen));
+      selected_pen_gc = gc_;
+      selected_pen = xmap.pen;
+    }
   }
 }
 
 void Fl_GDI_Graphics_Driver::color(uchar r, uchar g, uchar b) {
-  static Fl_XMap xmap;
+  Fl_XMap &xmap = fl_rgb_xmap;
   COLORREF c = RGB(r,g,b);
   Fl_Graphics_Driver::color( fl_rgb_color(r, g, b) );
   int tw = line_width_ ? line_width_ : int(scale()); if (!tw) tw = 1;
@@ -123,7 +223,11 @@ void Fl_GDI_Graphics_Driver::color(uchar r, uchar g, uchar b) {
     set_xmap(xmap, c, tw);
   }
   fl_current_xmap = &xmap;
-  SelectObject(gc_, (HGDIOBJ)(xmap.pen));
+  if (gc_ != selected_pen_gc || xmap.pen != selected_pen) {
+    SelectObject(gc_, (HGDIOBJ)(xmap.pen));
+    selected_pen_gc = gc_;
+    selected_pen = xmap.pen;
+  }
 }
 
 HBRUSH fl_brush() {
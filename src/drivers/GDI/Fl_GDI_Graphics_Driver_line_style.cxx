@@ -23,9 +23,13 @@
 #include <FL/Fl.H>
 #include <FL/platform.H>
 #include <FL/fl_draw.H>
+#include <string.h>
 
 #include "Fl_GDI_Graphics_Driver.H"
 
+extern void fl_forget_pen_selection(void);
+extern HPEN fl_cached_pen(COLORREF rgb, int style, int width,
+                          int ndashes, const DWORD *dashes); // in ..._color.cxx
 
 void Fl_GDI_Graphics_Driver::line_style_unscaled(int style, int width, char* dashes) {
 
@@ -47,14 +51,14 @@ void Fl_GDI_Graphics_Driver::line_style_unscaled(int style, int width, char* das
   }
   if ((style || n) && !width) width = int(scale()); // fix cards that do nothing for 0?
   if (!fl_current_xmap) color(FL_BLACK);
-  LOGBRUSH penbrush = {BS_SOLID,fl_RGB(),0}; // can this be fl_brush()?
-  HPEN newpen = ExtCreatePen(s1, width, &penbrush, n, n ? a : 0);
+  // the frequent defensive fl_line_style(0) resets repeat an earlier
+  // state, so they reselect a live pen instead of building a new one
+  HPEN newpen = fl_cached_pen(fl_RGB(), s1, width, n, a);
   if (!newpen) {
     Fl::error("fl_line_style(): Could not create GDI pen object.");
     return;
   }
-  HPEN oldpen = (HPEN)SelectObject(gc_, newpen);
-  DeleteObject(oldpen);
-  DeleteObject(fl_current_xmap->pen);
-  fl_current_xmap->pen = newpen;
+  SelectObject(gc_, newpen);
+  fl_current_xmap->pen = newpen; // cache-owned, nothing to delete
+  fl_forget_pen_selection();
 }
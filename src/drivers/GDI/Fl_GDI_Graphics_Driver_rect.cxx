@@ -28,6 +28,7 @@
 
 #include "Fl_GDI_Graphics_Driver.H"
 
+extern void fl_forget_pen_selection(void);
 
 // --- line and polygon drawing with integer coordinates
 
@@ -84,11 +85,13 @@ void Fl_GDI_Graphics_Driver::line_unscaled(int x, int y, int x1, int y1, int x2,
 void* Fl_GDI_Graphics_Driver::change_pen_width(int width) { // set the width of the pen, return previous pen
   LOGBRUSH penbrush = {BS_SOLID, fl_RGB(), 0};
   HPEN newpen = ExtCreatePen(PS_GEOMETRIC | PS_ENDCAP_FLAT | PS_JOIN_ROUND, width, &penbrush, 0, 0);
+  fl_forget_pen_selection();
   return SelectObject(gc_, newpen);
 }
 
 void Fl_GDI_Graphics_Driver::reset_pen_width(void *data) {
   DeleteObject(SelectObject(gc_, (HPEN)data));
+  fl_forget_pen_selection();
 }
 
 void Fl_GDI_Graphics_Driver::xyline_unscaled(int x, int y, int x1) {
@@ -0,0 +1,172 @@
+//
+// Antialiased drawing routines based on GDI+ for the Fast Light Tool Kit (FLTK).
+//
+// Copyright 1998-2020 by Bill Spitzak and others.
+//
+// This library is free software. Distribution and use rights are outlined in
+// the file "COPYING" which should have been included with this file.  If this
+// file is missing or damaged, see the license at:
+//
+//     https://www.fltk.org/COPYING.php
+//
+// Please see the following page on how to report bugs and issues:
+//
+//     https://www.fltk.org/bugs.php
+//
+
+#include <config.h>
+
+#if USE_GDIPLUS
+
+#include "Fl_GDI_Graphics_Driver.H"
+#include <FL/Fl.H>
+#include <FL/platform.H>
+#include <FL/fl_draw.H>
+
+/* By default, FLTK on Windows draws with plain GDI, which is fast but does
+ not antialias lines, curves or polygon edges. When the library is built
+ with USE_GDIPLUS, the display driver instantiated by
+ Fl_Graphics_Driver::newMainGraphicsDriver() is this subclass instead. It
+ keeps all GDI code for rectangles, images, text and clipping — those are
+ either pixel-exact by nature or handled elsewhere — and routes the
+ diagonal and curved primitives through GDI+ with antialiasing on.
+
+ A Gdiplus::Graphics object is constructed per primitive from the current
+ device context. This is the usage pattern Microsoft documents for mixed
+ GDI/GDI+ rendering; constructing one is cheap (no kernel transition) and
+ avoids keeping state that would go stale when the gc changes.
+ */
+
+extern unsigned fl_cmap[256]; // defined in fl_color.cxx
+
+ULONG_PTR Fl_GDIplus_Graphics_Driver::gdiplus_token_ = 0;
+int Fl_GDIplus_Graphics_Driver::instance_count_ = 0;
+
+Fl_GDIplus_Graphics_Driver::Fl_GDIplus_Graphics_Driver() {
+  if (instance_count_ == 0) {
+    Gdiplus::GdiplusStartupInput input;
+    Gdiplus::GdiplusStartup(&gdiplus_token_, &input, NULL);
+  }
+  instance_count_++;
+  pen_ = new Gdiplus::Pen(Gdiplus::Color(0, 0, 0), 1.f);
+  pen_->SetStartCap(Gdiplus::LineCapFlat);
+  pen_->SetEndCap(Gdiplus::LineCapFlat);
+  pen_->SetLineJoin(Gdiplus::LineJoinRound);
+  brush_ = new Gdiplus::SolidBrush(Gdiplus::Color(0, 0, 0));
+}
+
+Fl_GDIplus_Graphics_Driver::~Fl_GDIplus_Graphics_Driver() {
+  delete pen_;
+  delete brush_;
+  instance_count_--;
+  if (instance_count_ == 0) {
+    Gdiplus::GdiplusShutdown(gdiplus_token_);
+    gdiplus_token_ = 0;
+  }
+}
+
+void Fl_GDIplus_Graphics_Driver::color(Fl_Color i) {
+  Fl_GDI_Graphics_Driver::color(i);
+  // mirror the color into the GDI+ pen and brush
+  uchar r, g, b;
+  Fl::get_color(color(), r, g, b);
+  pen_->SetColor(Gdiplus::Color(r, g, b));
+  brush_->SetColor(Gdiplus::Color(r, g, b));
+}
+
+void Fl_GDIplus_Graphics_Driver::color(uchar r, uchar g, uchar b) {
+  Fl_GDI_Graphics_Driver::color(r, g, b);
+  pen_->SetColor(Gdiplus::Color(r, g, b));
+  brush_->SetColor(Gdiplus::Color(r, g, b));
+}
+
+void Fl_GDIplus_Graphics_Driver::line_unscaled(int x, int y, int x1, int y1) {
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  graphics_.DrawLine(pen_, x, y, x1, y1);
+}
+
+void Fl_GDIplus_Graphics_Driver::line_unscaled(int x, int y, int x1, int y1, int x2, int y2) {
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  Gdiplus::Point gdi_p[3] = {Gdiplus::Point(x, y), Gdiplus::Point(x1, y1), Gdiplus::Point(x2, y2)};
+  graphics_.DrawLines(pen_, gdi_p, 3);
+}
+
+void Fl_GDIplus_Graphics_Driver::loop_unscaled(int x0, int y0, int x1, int y1, int x2, int y2) {
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  Gdiplus::Point gdi_p[3] = {Gdiplus::Point(x0, y0), Gdiplus::Point(x1, y1), Gdiplus::Point(x2, y2)};
+  graphics_.DrawPolygon(pen_, gdi_p, 3);
+}
+
+void Fl_GDIplus_Graphics_Driver::loop_unscaled(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) {
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  Gdiplus::Point gdi_p[4] = {Gdiplus::Point(x0, y0), Gdiplus::Point(x1, y1), Gdiplus::Point(x2, y2), Gdiplus::Point(x3, y3)};
+  graphics_.DrawPolygon(pen_, gdi_p, 4);
+}
+
+void Fl_GDIplus_Graphics_Driver::polygon_unscaled(int x0, int y0, int x1, int y1, int x2, int y2) {
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  Gdiplus::Point gdi_p[3] = {Gdiplus::Point(x0, y0), Gdiplus::Point(x1, y1), Gdiplus::Point(x2, y2)};
+  graphics_.FillPolygon(brush_, gdi_p, 3);
+}
+
+void Fl_GDIplus_Graphics_Driver::polygon_unscaled(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) {
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  Gdiplus::Point gdi_p[4] = {Gdiplus::Point(x0, y0), Gdiplus::Point(x1, y1), Gdiplus::Point(x2, y2), Gdiplus::Point(x3, y3)};
+  graphics_.FillPolygon(brush_, gdi_p, 4);
+}
+
+// FLTK angles run counterclockwise from 3 o'clock, GDI+ angles clockwise,
+// so the arc from a1 to a2 becomes the arc from -a2 sweeping a2-a1.
+
+void Fl_GDIplus_Graphics_Driver::arc_unscaled(int x, int y, int w, int h, double a1, double a2) {
+  if (w <= 0 || h <= 0) return;
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  graphics_.DrawArc(pen_, x, y, w-1, h-1, float(-a2), float(a2-a1));
+}
+
+void Fl_GDIplus_Graphics_Driver::pie_unscaled(int x, int y, int w, int h, double a1, double a2) {
+  if (w <= 0 || h <= 0) return;
+  Gdiplus::Graphics graphics_(gc_);
+  graphics_.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+  if (a2 - a1 >= 360) { // the full ellipse, the arguments to FillPie() would wrap
+    graphics_.FillEllipse(brush_, x, y, w-1, h-1);
+  } else {
+    graphics_.FillPie(brush_, x, y, w-1, h-1, float(-a2), float(a2-a1));
+  }
+}
+
+void Fl_GDIplus_Graphics_Driver::line_style_unscaled(int style, int width, char* dashes) {
+  Fl_GDI_Graphics_Driver::line_style_unscaled(style, width, dashes);
+  // keep the GDI+ pen in sync with the GDI one
+  pen_->SetWidth(Gdiplus::REAL(width ? width : 1));
+  static const Gdiplus::LineCap Cap[4] = {Gdiplus::LineCapFlat, Gdiplus::LineCapFlat,
+                                          Gdiplus::LineCapRound, Gdiplus::LineCapSquare};
+  static const Gdiplus::LineJoin Join[4] = {Gdiplus::LineJoinRound, Gdiplus::LineJoinMiter,
+                                            Gdiplus::LineJoinRound, Gdiplus::LineJoinBevel};
+  pen_->SetStartCap(Cap[(style>>8)&3]);
+  pen_->SetEndCap(Cap[(style>>8)&3]);
+  pen_->SetLineJoin(Join[(style>>12)&3]);
+  if (dashes && dashes[0]) {
+    Gdiplus::REAL a[16];
+    int n = 0;
+    while (n < 16 && *dashes) a[n++] = Gdiplus::REAL(*dashes++);
+    pen_->SetDashPattern(a, n);
+  } else {
+    switch (style & 0xff) {
+      case FL_DASH:       pen_->SetDashStyle(Gdiplus::DashStyleDash); break;
+      case FL_DOT:        pen_->SetDashStyle(Gdiplus::DashStyleDot); break;
+      case FL_DASHDOT:    pen_->SetDashStyle(Gdiplus::DashStyleDashDot); break;
+      case FL_DASHDOTDOT: pen_->SetDashStyle(Gdiplus::DashStyleDashDotDot); break;
+      default:            pen_->SetDashStyle(Gdiplus::DashStyleSolid); break;
+    }
+  }
+}
+
+#endif // USE_GDIPLUS
@@ -161,24 +161,70 @@ void Fl_OpenGL_Graphics_Driver::polygon(int x0, int y0, int x1, int y1, int x2,
   glEnd();
 }
 
+// FLTK clips with plain rectangles almost exclusively, and the running
+// intersection of rectangles is itself a rectangle, so the clipping region
+// of this driver is a single rectangle which maps directly to the GL
+// scissor test. Widgets outside the clip rectangle are skipped entirely
+// by not_clipped(), those crossing it are cut by the scissor.
+struct Fl_OpenGL_region {
+  int x, y, w, h;
+};
+
+Fl_Region Fl_OpenGL_Graphics_Driver::XRectangleRegion(int x, int y, int w, int h) {
+  Fl_OpenGL_region *r = new Fl_OpenGL_region;
+  r->x = x; r->y = y; r->w = w; r->h = h;
+  return (Fl_Region)r;
+}
+
+void Fl_OpenGL_Graphics_Driver::XDestroyRegion(Fl_Region r) {
+  delete (Fl_OpenGL_region*)r;
+}
+
 void Fl_OpenGL_Graphics_Driver::push_clip(int x, int y, int w, int h) {
-  // TODO: implement OpenGL clipping
-  if (rstackptr < region_stack_max) rstack[++rstackptr] = 0L;
+  Fl_Region r;
+  if (w > 0 && h > 0) {
+    int X, Y, W, H;
+    clip_box(x, y, w, h, X, Y, W, H); // intersect with the current clip rectangle
+    r = XRectangleRegion(X, Y, W, H);
+  } else { // make an empty clip region
+    r = XRectangleRegion(0, 0, 0, 0);
+  }
+  if (rstackptr < region_stack_max) rstack[++rstackptr] = r;
   else Fl::warning("Fl_OpenGL_Graphics_Driver::push_clip: clip stack overflow!\n");
+  restore_clip();
 }
 
 int Fl_OpenGL_Graphics_Driver::clip_box(int x, int y, int w, int h, int &X, int &Y, int &W, int &H) {
-  // TODO: implement OpenGL clipping
   X = x; Y = y; W = w; H = h;
-  return 0;
+  Fl_OpenGL_region *r = (Fl_OpenGL_region*)rstack[rstackptr];
+  if (!r) return 0;
+  if (X < r->x) { W -= r->x - X; X = r->x; }
+  if (Y < r->y) { H -= r->y - Y; Y = r->y; }
+  if (X + W > r->x + r->w) W = r->x + r->w - X;
+  if (Y + H > r->y + r->h) H = r->y + r->h - Y;
+  if (W < 0) W = 0;
+  if (H < 0) H = 0;
+  return (W != w || H != h);
 }
 
 int Fl_OpenGL_Graphics_Driver::not_clipped(int x, int y, int w, int h) {
-  // TODO: implement OpenGL clipping
-  return 1;
+  if (x + w <= 0 || y + h <= 0) return 0;
+  Fl_OpenGL_region *r = (Fl_OpenGL_region*)rstack[rstackptr];
+  if (!r) return 1;
+  return (x < r->x + r->w && x + w > r->x && y < r->y + r->h && y + h > r->y);
 }
 
 void Fl_OpenGL_Graphics_Driver::restore_clip() {
-  // TODO: implement OpenGL clipping
   fl_clip_state_number++;
+  Fl_OpenGL_region *r = (Fl_OpenGL_region*)rstack[rstackptr];
+  Fl_Gl_Window *glw = Fl_Window::current() ? Fl_Window::current()->as_gl_window() : NULL;
+  if (r && glw) {
+    float s = glw->pixels_per_unit();
+    // glScissor() expects the box in pixels from the window's bottom-left corner
+    glScissor(int(r->x * s), glw->pixel_h() - int((r->y + r->h) * s),
+              int(r->w * s + 0.5f), int(r->h * s + 0.5f));
+    glEnable(GL_SCISSOR_TEST); // Fl_Gl_Window::draw() restores the previous state
+  } else {
+    glDisable(GL_SCISSOR_TEST);
+  }
 }
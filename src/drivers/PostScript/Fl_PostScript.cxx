@@ -125,8 +125,12 @@ static const double dashes_cap[5][7]={
 Fl_PostScript_Graphics_Driver::Fl_PostScript_Graphics_Driver(void)
 {
   close_cmd_ = 0;
-  //lang_level_ = 3;
+#if defined(HAVE_LIBZ)
+  // level 3 allows Flate-compressed image streams which keep spool files small
+  lang_level_ = 3;
+#else
   lang_level_ = 2;
+#endif
 #if ! USE_PANGO
   mask = 0;
 #endif
@@ -696,8 +700,13 @@ int Fl_PostScript_Graphics_Driver::start_postscript (int pagecount,
   if (lang_level_ == 2) {
     fputs(prolog_2_pixmap, output);
     }
-  if (lang_level_ > 2)
+  if (lang_level_ > 2) {
     fputs(prolog_3, output);
+#if defined(HAVE_LIBZ)
+    // rebind A85RLE: at level 3 image streams are Flate-compressed, not run-length encoded
+    fputs("/A85RLE { /ASCII85Decode filter /FlateDecode filter } bind def\n", output);
+#endif
+  }
   if (lang_level_ >= 3) {
     fputs("/CS { clipsave } bind def\n", output);
     fputs("/CR { cliprestore } bind def\n", output);
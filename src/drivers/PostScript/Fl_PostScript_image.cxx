@@ -26,6 +26,9 @@
 #include <FL/Fl.H>
 #include <FL/Fl_Pixmap.H>
 #include <FL/Fl_Bitmap.H>
+#if defined(HAVE_LIBZ)
+#include <zlib.h>
+#endif
 
 #if USE_PANGO
 #include <cairo/cairo.h>
@@ -149,6 +152,75 @@ void Fl_PostScript_Graphics_Driver::close85(void *data)  // stops ASCII85-encodi
 // End of implementation of the /ASCII85Encode PostScript filter
 //
 
+#if defined(HAVE_LIBZ)
+
+//
+// Implementation of the /FlateEncode + /ASCII85Encode PostScript filter
+// using the zlib deflate algorithm. /FlateDecode requires language level 3;
+// it compresses image data much better than run-length encoding.
+//
+
+struct struct_flate85 {
+  struct85 *data85; // aux data for ASCII85 encoding
+  z_stream strm;    // zlib deflate stream
+  uchar in[4096];   // holds input bytes not yet compressed
+  int count;        // current input buffer length
+  uchar out[4096];  // holds compressed output bytes
+};
+
+void *Fl_PostScript_Graphics_Driver::prepare_flate85() // prepare to produce Flate+ASCII85-encoded output
+{
+  struct_flate85 *flate = new struct_flate85;
+  flate->count = 0;
+  flate->data85 = (struct85*)prepare85();
+  memset(&flate->strm, 0, sizeof(flate->strm));
+  deflateInit(&flate->strm, Z_DEFAULT_COMPRESSION);
+  return flate;
+}
+
+
+void Fl_PostScript_Graphics_Driver::write_flate85(uchar b, void *data) // sends one input byte to Flate+ASCII85 encoding
+{
+  struct_flate85 *flate = (struct_flate85 *)data;
+  flate->in[flate->count++] = b;
+  if (flate->count < (int)sizeof(flate->in)) return;
+  flate->strm.next_in = flate->in;
+  flate->strm.avail_in = flate->count;
+  while (flate->strm.avail_in > 0) { // compress the input buffer
+    flate->strm.next_out = flate->out;
+    flate->strm.avail_out = sizeof(flate->out);
+    deflate(&flate->strm, Z_NO_FLUSH);
+    int l = int(sizeof(flate->out) - flate->strm.avail_out);
+    if (l) write85(flate->data85, flate->out, l);
+  }
+  flate->count = 0;
+}
+
+
+void Fl_PostScript_Graphics_Driver::close_flate85(void *data) // stop doing Flate+ASCII85 encoding
+{
+  struct_flate85 *flate = (struct_flate85 *)data;
+  int err;
+  flate->strm.next_in = flate->in;
+  flate->strm.avail_in = flate->count;
+  do { // compress pending input bytes and flush the deflate stream
+    flate->strm.next_out = flate->out;
+    flate->strm.avail_out = sizeof(flate->out);
+    err = deflate(&flate->strm, Z_FINISH);
+    int l = int(sizeof(flate->out) - flate->strm.avail_out);
+    if (l) write85(flate->data85, flate->out, l);
+  } while (err == Z_OK);
+  deflateEnd(&flate->strm);
+  close85(flate->data85); // close ASCII85 encoding process
+  delete flate;
+}
+
+//
+// End of implementation of the /FlateEncode + /ASCII85Encode PostScript filter
+//
+
+#endif // HAVE_LIBZ
+
 //
 // Implementation of the /RunLengthEncode + /ASCII85Encode PostScript filter
 // as described in "PostScript LANGUAGE REFERENCE third edition" p. 142
@@ -161,8 +233,16 @@ struct struct_rle85 {
   int run_length; // current length of run
 };
 
+// The prepare_rle85/write_rle85/close_rle85 triplet produces the data decoded
+// by the A85RLE procedure of the prolog. At language level 3, A85RLE is bound
+// to /FlateDecode instead of /RunLengthDecode (see start_postscript()), and
+// these functions delegate to the Flate+ASCII85 encoder above.
+
 void *Fl_PostScript_Graphics_Driver::prepare_rle85() // prepare to produce RLE+ASCII85-encoded output
 {
+#if defined(HAVE_LIBZ)
+  if (lang_level_ > 2) return prepare_flate85();
+#endif
   struct_rle85 *rle = new struct_rle85;
   rle->count = 0;
   rle->run_length = 0;
@@ -173,6 +253,9 @@ void *Fl_PostScript_Graphics_Driver::prepare_rle85() // prepare to produce RLE+A
 
 void Fl_PostScript_Graphics_Driver::write_rle85(uchar b, void *data) // sends one input byte to RLE+ASCII85 encoding
 {
+#if defined(HAVE_LIBZ)
+  if (lang_level_ > 2) { write_flate85(b, data); return; }
+#endif
   struct_rle85 *rle = (struct_rle85 *)data;
   uchar c;
   if (rle->run_length > 0) { // if within a run
@@ -210,6 +293,9 @@ void Fl_PostScript_Graphics_Driver::write_rle85(uchar b, void *data) // sends on
 
 void Fl_PostScript_Graphics_Driver::close_rle85(void *data) // stop doing RLE+ASCII85 encoding
 {
+#if defined(HAVE_LIBZ)
+  if (lang_level_ > 2) { close_flate85(data); return; }
+#endif
   struct_rle85 *rle = (struct_rle85 *)data;
   uchar c;
   if (rle->run_length > 0) { // if within a run, output it
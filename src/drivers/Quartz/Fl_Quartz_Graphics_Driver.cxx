@@ -85,18 +85,70 @@ void Fl_Quartz_Graphics_Driver::global_gc()
   fl_gc = (CGContextRef)gc();
 }
 
+/* Offscreens are how applications cache static widget content: the toolbar
+ or sidebar is drawn once into an offscreen and blitted on each redraw.
+ Wrapping the offscreen's bitmap into a fresh CGImage for every blit is
+ needless work for content that does not change, so the CGImage is retained
+ here per offscreen. It stays valid cheaply because CGBitmapContextCreateImage()
+ is copy-on-write; the cache is dropped whenever a drawing session to the
+ offscreen ends (Fl_Quartz_Image_Surface_Driver::end_current()) and when the
+ offscreen is destroyed.
+ */
+struct Fl_Quartz_offscreen_image {
+  CGContextRef ctx;
+  CGImageRef img;
+  Fl_Quartz_offscreen_image *next;
+};
+static Fl_Quartz_offscreen_image *offscreen_images = NULL;
+
+// Returns a retained CGImage with the current content of offscreen osrc,
+// or NULL before Mac OS 10.4. The returned reference is owned by the cache.
+CGImageRef Fl_Quartz_Graphics_Driver::offscreen_image(Fl_Offscreen osrc) {
+  CGContextRef src = (CGContextRef)osrc;
+  Fl_Quartz_offscreen_image *c;
+  for (c = offscreen_images; c; c = c->next) {
+    if (c->ctx == src) return c->img;
+  }
+#if MAC_OS_X_VERSION_MAX_ALLOWED >= MAC_OS_X_VERSION_10_4
+  if (fl_mac_os_version >= 100400) {
+    c = new Fl_Quartz_offscreen_image;
+    c->ctx = src;
+    c->img = CGBitmapContextCreateImage(src); // requires 10.4
+    c->next = offscreen_images;
+    offscreen_images = c;
+    return c->img;
+  }
+#endif
+  return NULL;
+}
+
+// Forget the cached image of offscreen osrc because its content changed
+// or it is about to be destroyed.
+void Fl_Quartz_Graphics_Driver::offscreen_changed(Fl_Offscreen osrc) {
+  CGContextRef src = (CGContextRef)osrc;
+  Fl_Quartz_offscreen_image **p = &offscreen_images;
+  while (*p) {
+    if ((*p)->ctx == src) {
+      Fl_Quartz_offscreen_image *c = *p;
+      *p = c->next;
+      CGImageRelease(c->img);
+      delete c;
+      return;
+    }
+    p = &((*p)->next);
+  }
+}
+
 void Fl_Quartz_Graphics_Driver::copy_offscreen(int x, int y, int w, int h, Fl_Offscreen osrc, int srcx, int srcy) {
   // draw portion srcx,srcy,w,h of osrc to position x,y (top-left) of the graphics driver's surface
   CGContextRef src = (CGContextRef)osrc;
   void *data = CGBitmapContextGetData(src);
   int sw = CGBitmapContextGetWidth(src);
   int sh = CGBitmapContextGetHeight(src);
-  CGImageRef img;
-#if MAC_OS_X_VERSION_MAX_ALLOWED >= MAC_OS_X_VERSION_10_4
-  if (fl_mac_os_version >= 100400) img = CGBitmapContextCreateImage(src);  // requires 10.4
-  else
-#endif
-  {
+  bool cached = true;
+  CGImageRef img = offscreen_image(osrc); // NULL before Mac OS 10.4
+  if (!img) {
+    cached = false;
     CGImageAlphaInfo alpha = CGBitmapContextGetAlphaInfo(src);
     CGColorSpaceRef lut = CGColorSpaceCreateDeviceRGB();
     // when output goes to a Quartz printercontext, release of the bitmap must be
@@ -109,18 +161,15 @@ void Fl_Quartz_Graphics_Driver::copy_offscreen(int x, int y, int w, int h, Fl_Of
     CGColorSpaceRelease(lut);
   }
   float s = scale();
-  Fl_Surface_Device *current = Fl_Surface_Device::surface();
   // test whether osrc was created by fl_create_offscreen()
-  fl_begin_offscreen(osrc); // does nothing if osrc was not created by fl_create_offscreen()
-  if (current != Fl_Surface_Device::surface()) { // osrc was created by fl_create_offscreen()
-    Fl_Image_Surface *imgs = (Fl_Image_Surface*)Fl_Surface_Device::surface();
+  Fl_Image_Surface *imgs = Fl_Image_Surface_Driver::surface_for_offscreen(osrc);
+  if (imgs) { // osrc was created by fl_create_offscreen()
     int pw, ph;
     imgs->printable_rect(&pw, &ph);
     s = sw / float(pw);
-    fl_end_offscreen();
   }
   draw_CGImage(img, x, y, w, h, srcx, srcy, sw/s, sh/s);
-  CGImageRelease(img);
+  if (!cached) CGImageRelease(img);
 }
 
 // so a CGRect matches exactly what is denoted x,y,w,h for clipping purposes
@@ -79,6 +79,7 @@ Fl_Quartz_Image_Surface_Driver::Fl_Quartz_Image_Surface_Driver(int w, int h, int
 }
 
 Fl_Quartz_Image_Surface_Driver::~Fl_Quartz_Image_Surface_Driver() {
+  Fl_Quartz_Graphics_Driver::offscreen_changed(offscreen);
   if (offscreen && !external_offscreen) {
     void *data = CGBitmapContextGetData(offscreen);
     free(data);
@@ -131,6 +132,7 @@ Fl_RGB_Image* Fl_Quartz_Image_Surface_Driver::image()
 
 void Fl_Quartz_Image_Surface_Driver::end_current()
 {
+  Fl_Quartz_Graphics_Driver::offscreen_changed(offscreen); // content may have changed
   fl_window = pre_window;
   Fl_Surface_Device::end_current();
 }
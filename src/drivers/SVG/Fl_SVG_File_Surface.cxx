@@ -61,7 +61,20 @@ class Fl_SVG_Graphics_Driver : public Fl_Graphics_Driver {
   };
   Clip * clip_; // top of pile of clips
   int clip_count_; // to generate distinct SVG clip Ids
-  char *last_rgb_name_; // NULL or SVG Id of last defined RGB image
+  class Style { // an interned set of style declarations, written once as a CSS rule
+  public:
+    char name[12]; // class name of this style in the SVG file
+    char *decl; // the style declarations, e.g. "fill:rgb(0,0,0)"
+    Style *next; // next in list of interned styles
+  };
+  Style *styles_; // list of styles already written as CSS rules
+  int style_count_; // to generate distinct class names
+  class Image_Def { // records an image written as an SVG <image> def
+  public:
+    char name[45]; // SVG Id of the image def
+    Image_Def *next; // next in list of image defs
+  };
+  Image_Def *image_defs_; // list of image defs present in the document
   const char *family_;
   const char *bold_;
   const char *style_;
@@ -70,6 +83,11 @@ public:
   ~Fl_SVG_Graphics_Driver();
   FILE* file() {return out_;}
 protected:
+  const char *style_class(const char *decl);
+  const char *stroke_style_class();
+  const char *fill_style_class();
+  int image_defined(const char *name);
+  void record_image_def(const char *name);
   void rect(int x, int y, int w, int h);
   void rectf(int x, int y, int w, int h);
   void compute_dasharray(float s, char *dashes=0);
@@ -137,7 +155,9 @@ Fl_SVG_Graphics_Driver::Fl_SVG_Graphics_Driver(FILE *f) {
   dasharray_ = fl_strdup("none");
   p_size = 0;
   p = NULL;
-  last_rgb_name_ = NULL;
+  styles_ = NULL;
+  style_count_ = 0;
+  image_defs_ = NULL;
 }
 
 Fl_SVG_Graphics_Driver::~Fl_SVG_Graphics_Driver()
@@ -149,18 +169,75 @@ Fl_SVG_Graphics_Driver::~Fl_SVG_Graphics_Driver()
     clip_= clip_->prev;
     delete c;
   }
-  if (last_rgb_name_) free(last_rgb_name_);
+  while (styles_) {
+    Style *s = styles_;
+    styles_ = styles_->next;
+    free(s->decl);
+    delete s;
+  }
+  while (image_defs_) {
+    Image_Def *d = image_defs_;
+    image_defs_ = image_defs_->next;
+    delete d;
+  }
+}
+
+// Returns the class name of an interned style, writing its CSS rule to the
+// SVG file the first time each distinct set of declarations is seen.
+// Repeated styles thus cost a short class attribute instead of being
+// spelled out on every element, which matters for long capture sequences.
+const char *Fl_SVG_Graphics_Driver::style_class(const char *decl) {
+  for (Style *s = styles_; s; s = s->next) {
+    if (strcmp(s->decl, decl) == 0) return s->name;
+  }
+  Style *s = new Style();
+  sprintf(s->name, "flst%d", style_count_++);
+  s->decl = fl_strdup(decl);
+  s->next = styles_;
+  styles_ = s;
+  fprintf(out_, "<style>.%s{%s}</style>\n", s->name, s->decl);
+  return s->name;
+}
+
+// interned style of a stroked, unfilled element under the current graphics state
+const char *Fl_SVG_Graphics_Driver::stroke_style_class() {
+  char decl[256];
+  snprintf(decl, sizeof(decl),
+           "fill:none;stroke:rgb(%u,%u,%u);stroke-width:%d;stroke-linecap:%s;stroke-linejoin:%s;stroke-dasharray:%s",
+           red_, green_, blue_, width_, linecap_, linejoin_, dasharray_);
+  return style_class(decl);
+}
+
+// interned style of a filled element under the current graphics state
+const char *Fl_SVG_Graphics_Driver::fill_style_class() {
+  char decl[64];
+  snprintf(decl, sizeof(decl), "fill:rgb(%u,%u,%u)", red_, green_, blue_);
+  return style_class(decl);
+}
+
+int Fl_SVG_Graphics_Driver::image_defined(const char *name) {
+  for (Image_Def *d = image_defs_; d; d = d->next) {
+    if (strcmp(d->name, name) == 0) return 1;
+  }
+  return 0;
+}
+
+void Fl_SVG_Graphics_Driver::record_image_def(const char *name) {
+  Image_Def *d = new Image_Def();
+  strncpy(d->name, name, sizeof(d->name) - 1);
+  d->name[sizeof(d->name) - 1] = 0;
+  d->next = image_defs_;
+  image_defs_ = d;
 }
 
 void Fl_SVG_Graphics_Driver::rect(int x, int y, int w, int h) {
-  fprintf(out_, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" "
-          "fill=\"none\" stroke=\"rgb(%u,%u,%u)\" stroke-width=\"%d\" stroke-dasharray=\"%s\""
-          " stroke-linecap=\"%s\" stroke-linejoin=\"%s\"/>\n", x, y, w-1, h-1, red_, green_, blue_, width_, dasharray_, linecap_, linejoin_);
+  fprintf(out_, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" class=\"%s\"/>\n",
+          x, y, w-1, h-1, stroke_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::rectf(int x, int y, int w, int h) {
-  fprintf(out_, "<rect x=\"%.3f\" y=\"%.3f\" width=\"%d\" height=\"%d\" "
-          "fill=\"rgb(%u,%u,%u)\" />\n", x-.5, y-.5, w, h, red_, green_, blue_);
+  fprintf(out_, "<rect x=\"%.3f\" y=\"%.3f\" width=\"%d\" height=\"%d\" class=\"%s\"/>\n",
+          x-.5, y-.5, w, h, fill_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::point(int x, int y) {
@@ -168,17 +245,13 @@ void Fl_SVG_Graphics_Driver::point(int x, int y) {
 }
 
 void Fl_SVG_Graphics_Driver::line(int x1, int y1, int x2, int y2) {
-  fprintf(out_,
-          "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\" "
-          "style=\"stroke:rgb(%u,%u,%u);stroke-width:%d;stroke-linecap:%s;stroke-linejoin:%s;stroke-dasharray:%s\" />\n",
-          x1,y1,x2,y2, red_, green_, blue_, width_, linecap_, linejoin_, dasharray_);
+  fprintf(out_, "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\" class=\"%s\"/>\n",
+          x1, y1, x2, y2, stroke_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::line(int x1, int y1, int x2, int y2, int x3, int y3) {
-  fprintf(out_,
-          "<path d=\"M %d %d L %d %d L %d %d \" "
-          "style=\"stroke:rgb(%u,%u,%u);fill:none;stroke-width:%d;stroke-linecap:%s;stroke-linejoin:%s;stroke-dasharray:%s\" />\n",
-  x1, y1, x2, y2, x3, y3, red_, green_, blue_, width_, linecap_, linejoin_, dasharray_);
+  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d \" class=\"%s\"/>\n",
+          x1, y1, x2, y2, x3, y3, stroke_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::font_(int ft, int s) {
@@ -317,6 +390,7 @@ int Fl_SVG_Graphics_Driver::descent() {
 
 Fl_SVG_File_Surface::Fl_SVG_File_Surface(int w, int h, FILE *f, int (*closef)(FILE*)) : Fl_Widget_Surface(new Fl_SVG_Graphics_Driver(f)) {
   closef_ = closef;
+  frame_count_ = 0;
   Fl_Window *win = Fl::first_window();
   float s = (win ? Fl::screen_scale(win->screen_num()) : 1);
   int sw = int(w * s), sh = int(h * s);
@@ -359,6 +433,16 @@ void Fl_SVG_File_Surface::untranslate() {
   fputs("</g>\n", driver->file());
 }
 
+void Fl_SVG_File_Surface::begin_frame() {
+  Fl_SVG_Graphics_Driver *driver = (Fl_SVG_Graphics_Driver*)this->driver();
+  fprintf(driver->file(), "<g id=\"FLframe%d\">\n", frame_count_++);
+}
+
+void Fl_SVG_File_Surface::end_frame() {
+  Fl_SVG_Graphics_Driver *driver = (Fl_SVG_Graphics_Driver*)this->driver();
+  fputs("</g>\n", driver->file());
+}
+
 void Fl_SVG_File_Surface::origin(int x, int y) {
   Fl_SVG_Graphics_Driver *driver = (Fl_SVG_Graphics_Driver*)this->driver();
   fprintf(driver->file(), "</g><g transform=\"translate(%d,%d) \">\n", x, y);
@@ -466,10 +550,7 @@ void Fl_SVG_Graphics_Driver::define_rgb_png(Fl_RGB_Image *rgb, const char *name,
     png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
     return;
   }
-  if (name) {
-    if (last_rgb_name_) free(last_rgb_name_);
-    last_rgb_name_ = fl_strdup(name);
-  }
+  if (name) record_image_def(name);
   float f = rgb->data_w() > rgb->data_h() ? float(rgb->w()) / rgb->data_w(): float(rgb->h()) / rgb->data_h();
   if (name) fprintf(out_, "<defs><image id=\"%s\" ", name);
   else fprintf(out_, "<image x=\"%d\" y=\"%d\" ", x, y);
@@ -555,10 +636,7 @@ static void term_destination(jpeg_compress_struct *cinfo) {
 }
 
 void Fl_SVG_Graphics_Driver::define_rgb_jpeg(Fl_RGB_Image *rgb, const char *name, int x, int y) {
-  if (name) {
-    if (last_rgb_name_) free(last_rgb_name_);
-    last_rgb_name_ = fl_strdup(name);
-  }
+  if (name) record_image_def(name);
   float f = rgb->data_w() > rgb->data_h() ? float(rgb->w()) / rgb->data_w(): float(rgb->h()) / rgb->data_h();
   if (name) fprintf(out_, "<defs><image id=\"%s\" ", name);
   else fprintf(out_, "<image x=\"%d\" y=\"%d\" ", x, y);
@@ -605,7 +683,7 @@ void Fl_SVG_Graphics_Driver::draw_rgb(Fl_RGB_Image *rgb, int XP, int YP, int WP,
   bool need_clip = (cx || cy || WP != rgb->w() || HP != rgb->h());
   void *p = (void*)*Fl_Graphics_Driver::id(rgb);
   if (p) sprintf(name, "FLrgb%p", p); else name[0] = 0;
-  if (!p || !last_rgb_name_ || strcmp(name, last_rgb_name_) != 0) {
+  if (!p || !image_defined(name)) {
     if (*name==0 && need_clip) push_clip(XP, YP, WP, HP);
 #if defined(HAVE_LIBJPEG)
     if (rgb->d() == 3 || rgb->d() == 1) define_rgb_jpeg(rgb, *name ? name : NULL, XP-cx, YP-cy);
@@ -616,7 +694,7 @@ void Fl_SVG_Graphics_Driver::draw_rgb(Fl_RGB_Image *rgb, int XP, int YP, int WP,
   }
   if (*name) {
     if (need_clip) push_clip(XP, YP, WP, HP);
-    fprintf(out_, "<use href=\"#%s\" x=\"%d\" y=\"%d\"/>\n", last_rgb_name_, XP-cx, YP-cy);
+    fprintf(out_, "<use href=\"#%s\" x=\"%d\" y=\"%d\"/>\n", name, XP-cx, YP-cy);
     if (need_clip) pop_clip();
   }
 #endif // HAVE_LIBPNG
@@ -628,7 +706,7 @@ void Fl_SVG_Graphics_Driver::draw_pixmap(Fl_Pixmap *pxm, int XP, int YP, int WP,
   bool need_clip = (cx || cy || WP != pxm->w() || HP != pxm->h());
   void *p = (void*)*Fl_Graphics_Driver::id(pxm);
   if (p) sprintf(name, "FLpx%p", p); else name[0] = 0;
-  if (!p || !last_rgb_name_ || strcmp(name, last_rgb_name_) != 0) {
+  if (!p || !image_defined(name)) {
     Fl_RGB_Image *rgb = new Fl_RGB_Image(pxm);
     if (*name==0 && need_clip) push_clip(XP, YP, WP, HP);
     define_rgb_png(rgb, *name ? name : NULL, XP-cx, YP-cy);
@@ -637,7 +715,7 @@ void Fl_SVG_Graphics_Driver::draw_pixmap(Fl_Pixmap *pxm, int XP, int YP, int WP,
   }
   if (*name) {
     if (need_clip) push_clip(XP, YP, WP, HP);
-    fprintf(out_, "<use href=\"#%s\" x=\"%d\" y=\"%d\"/>\n", last_rgb_name_, XP-cx, YP-cy);
+    fprintf(out_, "<use href=\"#%s\" x=\"%d\" y=\"%d\"/>\n", name, XP-cx, YP-cy);
     if (need_clip) pop_clip();
   }
 #endif // HAVE_LIBPNG
@@ -649,7 +727,7 @@ void Fl_SVG_Graphics_Driver::draw_bitmap(Fl_Bitmap *bm, int XP, int YP, int WP,
   bool need_clip = (cx || cy || WP != bm->w() || HP != bm->h());
   void *p = (void*)*Fl_Graphics_Driver::id(bm);
   if (p) sprintf(name, "FLbm%p%X", p, fl_color()); else name[0] = 0;
-  if (!p || !last_rgb_name_ || strcmp(name, last_rgb_name_) != 0) {
+  if (!p || !image_defined(name)) {
     uchar R, G, B;
     Fl::get_color(fl_color(), R, G, B);
     uchar *data = new uchar[bm->data_w() * bm->data_h() * 4];
@@ -679,7 +757,7 @@ void Fl_SVG_Graphics_Driver::draw_bitmap(Fl_Bitmap *bm, int XP, int YP, int WP,
   }
   if (*name) {
     if (need_clip) push_clip(XP, YP, WP, HP);
-    fprintf(out_, "<use href=\"#%s\" x=\"%d\" y=\"%d\"/>\n", last_rgb_name_, XP-cx, YP-cy);
+    fprintf(out_, "<use href=\"#%s\" x=\"%d\" y=\"%d\"/>\n", name, XP-cx, YP-cy);
     if (need_clip) pop_clip();
   }
 #endif // HAVE_LIBPNG
@@ -831,25 +909,23 @@ int Fl_SVG_Graphics_Driver::not_clipped(int x, int y, int w, int h) {
 }
 
 void Fl_SVG_Graphics_Driver::polygon(int x0, int y0, int x1, int y1, int x2, int y2) {
-  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d z\" fill=\"rgb(%u,%u,%u)\" />\n",
-          x0, y0, x1, y1, x2, y2, red_, green_, blue_);
+  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d z\" class=\"%s\"/>\n",
+          x0, y0, x1, y1, x2, y2, fill_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::polygon(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) {
-  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d L %d %d z\" fill=\"rgb(%u,%u,%u)\" />\n",
-          x0, y0, x1, y1, x2, y2, x3, y3, red_, green_, blue_);
+  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d L %d %d z\" class=\"%s\"/>\n",
+          x0, y0, x1, y1, x2, y2, x3, y3, fill_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::loop(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) {
-  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d L %d %d z\" fill=\"none\" stroke=\"rgb(%u,%u,%u)\" "
-          "stroke-width=\"%d\" stroke-linejoin=\"%s\" stroke-linecap=\"%s\" stroke-dasharray=\"%s\"/>\n",
-          x0, y0, x1, y1, x2, y2, x3, y3, red_, green_, blue_, width_, linejoin_, linecap_, dasharray_);
+  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d L %d %d z\" class=\"%s\"/>\n",
+          x0, y0, x1, y1, x2, y2, x3, y3, stroke_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::loop(int x0, int y0, int x1, int y1, int x2, int y2) {
-  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d z\" fill=\"none\" stroke=\"rgb(%u,%u,%u)\" "
-          "stroke-width=\"%d\" stroke-linejoin=\"%s\" stroke-linecap=\"%s\" stroke-dasharray=\"%s\"/>\n",
-          x0, y0, x1, y1, x2, y2, red_, green_, blue_, width_, linejoin_, linecap_, dasharray_);
+  fprintf(out_, "<path d=\"M %d %d L %d %d L %d %d z\" class=\"%s\"/>\n",
+          x0, y0, x1, y1, x2, y2, stroke_style_class());
 }
 
 void Fl_SVG_Graphics_Driver::end_points() {
@@ -865,11 +941,11 @@ void Fl_SVG_Graphics_Driver::end_line() {
     return;
   }
   if (n<=1) return;
+  const char *cls = stroke_style_class(); // intern before the element is open
   fprintf(out_, "<path d=\"M %f %f", p[0].x, p[0].y);
   for (int i=1; i<n; i++)
     fprintf(out_, " L %f %f", p[i].x, p[i].y);
-  fprintf(out_, "\" fill=\"none\" stroke=\"rgb(%u,%u,%u)\" stroke-width=\"%d\" stroke-dasharray=\"%s\" stroke-linecap=\"%s\" stroke-linejoin=\"%s\" />\n",
-          red_, green_, blue_, width_, dasharray_, linecap_, linejoin_);
+  fprintf(out_, "\" class=\"%s\"/>\n", cls);
 }
 
 void Fl_SVG_Graphics_Driver::end_polygon() {
@@ -879,10 +955,11 @@ void Fl_SVG_Graphics_Driver::end_polygon() {
     return;
   }
   if (n<=1) return;
+  const char *cls = fill_style_class(); // intern before the element is open
   fprintf(out_, "<path d=\"M %f %f", p[0].x, p[0].y);
   for (int i=1; i<n; i++)
     fprintf(out_, " L %f %f", p[i].x, p[i].y);
-  fprintf(out_, " z\" fill=\"rgb(%u,%u,%u)\" />\n", red_, green_, blue_);
+  fprintf(out_, " z\" class=\"%s\"/>\n", cls);
 }
 
 void Fl_SVG_Graphics_Driver::circle(double x, double y, double r) {
@@ -909,10 +986,11 @@ void Fl_SVG_Graphics_Driver::end_complex_polygon() {
     return;
   }
   if (n<=1) return;
+  const char *cls = fill_style_class(); // intern before the element is open
   fprintf(out_, "<path d=\"M %f %f", p[0].x, p[0].y);
   for (int i=1; i<n; i++)
     fprintf(out_, " L %f %f", p[i].x, p[i].y);
-  fprintf(out_, " z\" fill=\"rgb(%u,%u,%u)\" />\n", red_, green_, blue_);
+  fprintf(out_, " z\" class=\"%s\"/>\n", cls);
 }
 
 void Fl_SVG_Graphics_Driver::arc(double x, double y, double r, double start, double end) {
@@ -977,6 +1055,7 @@ void Fl_SVG_Graphics_Driver::arc_pie(char AorP, int x, int y, int w, int h, doub
 Fl_SVG_File_Surface::Fl_SVG_File_Surface(int w, int h, FILE *f, int (*closef)(FILE*)) : Fl_Widget_Surface(NULL) {
   closef_ = NULL;
   width_ = height_ = 0;
+  frame_count_ = 0;
 }
 Fl_SVG_File_Surface::~Fl_SVG_File_Surface() {}
 int Fl_SVG_File_Surface::close() {return 0;}
@@ -984,6 +1063,8 @@ FILE *Fl_SVG_File_Surface::file() {return NULL;}
 void Fl_SVG_File_Surface::origin(int x, int y) {}
 void Fl_SVG_File_Surface::translate(int x, int y) {}
 void Fl_SVG_File_Surface::untranslate() {}
+void Fl_SVG_File_Surface::begin_frame() {}
+void Fl_SVG_File_Surface::end_frame() {}
 int Fl_SVG_File_Surface::printable_rect(int *w, int *h) {return 0;}
 
 #endif // FLTK_USE_SVG
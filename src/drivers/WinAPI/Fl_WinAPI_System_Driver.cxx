@@ -102,9 +102,10 @@ extern "C" {
 */
 static wchar_t *utf8_to_wchar(const char *utf8, wchar_t *&wbuf, int lg = -1) {
   unsigned len = (lg >= 0) ? (unsigned)lg : (unsigned)strlen(utf8);
-  unsigned wn = fl_utf8toUtf16(utf8, len, NULL, 0) + 1; // Query length
-  wbuf = (wchar_t *)realloc(wbuf, sizeof(wchar_t) * wn);
-  wn = fl_utf8toUtf16(utf8, len, (unsigned short *)wbuf, wn); // Convert string
+  // Every UTF-8 byte converts to at most one UTF-16 cell, so sizing the
+  // buffer from the byte count avoids a separate length-query pass.
+  wbuf = (wchar_t *)realloc(wbuf, sizeof(wchar_t) * (len + 1));
+  unsigned wn = fl_utf8toUtf16(utf8, len, (unsigned short *)wbuf, len + 1);
   wbuf[wn] = 0;
   return wbuf;
 }
@@ -138,9 +139,12 @@ static wchar_t *utf8_to_wchar(const char *utf8, wchar_t *&wbuf, int lg = -1) {
 */
 static char *wchar_to_utf8(const wchar_t *wstr, char *&utf8) {
   unsigned len = (unsigned)wcslen(wstr);
-  unsigned wn = fl_utf8fromwc(NULL, 0, wstr, len) + 1; // query length
-  utf8 = (char *)realloc(utf8, wn);
-  wn = fl_utf8fromwc(utf8, wn, wstr, len); // convert string
+  // Every UTF-16 cell converts to at most three UTF-8 bytes (a surrogate
+  // pair of two cells makes four bytes), so sizing the buffer from the
+  // cell count avoids a separate length-query pass.
+  unsigned dstlen = 3 * len + 1;
+  utf8 = (char *)realloc(utf8, dstlen);
+  unsigned wn = fl_utf8fromwc(utf8, dstlen, wstr, len);
   utf8[wn] = 0;
   return utf8;
 }
@@ -305,7 +305,7 @@ void Fl_WinAPI_Window_Driver::flush_double()
   if (!i) return; // window not yet created
 
   if (!other_xid) {
-    other_xid = fl_create_offscreen(w(), h());
+    other_xid = lease_double_buffer(w(), h());
     pWindow->clear_damage(FL_DAMAGE_ALL);
   }
   if (pWindow->damage() & ~FL_DAMAGE_EXPOSE) {
@@ -351,7 +351,7 @@ void Fl_WinAPI_Window_Driver::flush_overlay()
   pWindow->clear_damage((uchar)(pWindow->damage()&~FL_DAMAGE_OVERLAY));
 
   if (!other_xid) {
-    other_xid = fl_create_offscreen(w(), h());
+    other_xid = lease_double_buffer(w(), h());
     pWindow->clear_damage(FL_DAMAGE_ALL);
   }
   if (pWindow->damage() & ~FL_DAMAGE_EXPOSE) {
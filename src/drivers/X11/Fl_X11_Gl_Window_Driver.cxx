@@ -35,6 +35,9 @@ class Fl_X11_Gl_Window_Driver : public Fl_Gl_Window_Driver {
   virtual void before_show(int& need_after);
   virtual int mode_(int m, const int *a);
   virtual void swap_buffers();
+  virtual int copy_sub_buffer(int x, int y, int w, int h);
+  virtual void swap_interval(int interval);
+  virtual int swap_interval() const;
   virtual void resize(int is_a_resize, int w, int h);
   virtual char swap_type();
   virtual Fl_Gl_Choice *find(int m, const int *alistp);
@@ -523,6 +526,83 @@ void Fl_X11_Gl_Window_Driver::swap_buffers() {
   glXSwapBuffers(fl_display, fl_xid(pWindow));
 }
 
+// Presents a rectangle of the back buffer through GLX_MESA_copy_sub_buffer,
+// which is much cheaper than a full glXSwapBuffers() on large drawables.
+typedef void (*glXCopySubBufferMESA_type)(Display*, GLXDrawable, int, int, int, int);
+
+int Fl_X11_Gl_Window_Driver::copy_sub_buffer(int x, int y, int w, int h) {
+  static glXCopySubBufferMESA_type glXCopySubBufferMESA_f = NULL;
+  static bool checked = false;
+  if (!checked) {
+    checked = true;
+#if defined(HAVE_GLXGETPROCADDRESSARB)
+    const char *glxExts = glXQueryExtensionsString(fl_display, fl_screen);
+    if (glxExts && strstr(glxExts, "GLX_MESA_copy_sub_buffer"))
+      glXCopySubBufferMESA_f = (glXCopySubBufferMESA_type)
+        glXGetProcAddressARB((const GLubyte *)"glXCopySubBufferMESA");
+#endif
+  }
+  if (!glXCopySubBufferMESA_f) return 0;
+  float s = pixels_per_unit();
+  int pw = int(w * s + 0.5), ph = int(h * s + 0.5);
+  // glXCopySubBufferMESA expects GL coordinates: origin at the bottom-left
+  glXCopySubBufferMESA_f(fl_display, fl_xid(pWindow),
+                         int(x * s), pWindow->pixel_h() - int(y * s) - ph, pw, ph);
+  return 1;
+}
+
+// Controls the number of display refreshes between buffer swaps through
+// GLX_EXT_swap_control, falling back to GLX_MESA_swap_control.
+#ifndef GLX_SWAP_INTERVAL_EXT
+#  define GLX_SWAP_INTERVAL_EXT 0x20F1
+#endif
+typedef void (*glXSwapIntervalEXT_type)(Display*, GLXDrawable, int);
+typedef int (*glXSwapIntervalMESA_type)(unsigned int);
+typedef int (*glXGetSwapIntervalMESA_type)(void);
+static glXSwapIntervalEXT_type glXSwapIntervalEXT_f = NULL;
+static glXSwapIntervalMESA_type glXSwapIntervalMESA_f = NULL;
+static glXGetSwapIntervalMESA_type glXGetSwapIntervalMESA_f = NULL;
+
+static void find_swap_interval_procs() {
+  static bool checked = false;
+  if (checked) return;
+  checked = true;
+#if defined(HAVE_GLXGETPROCADDRESSARB)
+  const char *glxExts = glXQueryExtensionsString(fl_display, fl_screen);
+  if (glxExts && strstr(glxExts, "GLX_EXT_swap_control")) {
+    glXSwapIntervalEXT_f = (glXSwapIntervalEXT_type)
+      glXGetProcAddressARB((const GLubyte *)"glXSwapIntervalEXT");
+  }
+  if (glxExts && strstr(glxExts, "GLX_MESA_swap_control")) {
+    glXSwapIntervalMESA_f = (glXSwapIntervalMESA_type)
+      glXGetProcAddressARB((const GLubyte *)"glXSwapIntervalMESA");
+    glXGetSwapIntervalMESA_f = (glXGetSwapIntervalMESA_type)
+      glXGetProcAddressARB((const GLubyte *)"glXGetSwapIntervalMESA");
+  }
+#endif
+}
+
+void Fl_X11_Gl_Window_Driver::swap_interval(int interval) {
+  if (!fl_xid(pWindow)) return;
+  find_swap_interval_procs();
+  if (glXSwapIntervalEXT_f)
+    glXSwapIntervalEXT_f(fl_display, fl_xid(pWindow), interval);
+  else if (glXSwapIntervalMESA_f)
+    glXSwapIntervalMESA_f((unsigned int)interval);
+}
+
+int Fl_X11_Gl_Window_Driver::swap_interval() const {
+  if (!fl_xid(pWindow)) return -1;
+  find_swap_interval_procs();
+  if (glXSwapIntervalEXT_f) {
+    unsigned int interval = 0;
+    glXQueryDrawable(fl_display, fl_xid(pWindow), GLX_SWAP_INTERVAL_EXT, &interval);
+    return (int)interval;
+  }
+  if (glXGetSwapIntervalMESA_f) return glXGetSwapIntervalMESA_f();
+  return -1;
+}
+
 void Fl_X11_Gl_Window_Driver::resize(int is_a_resize, int W, int H) {
   if (is_a_resize && !pWindow->resizable() && overlay() && overlay() != pWindow) {
     ((Fl_Gl_Window*)overlay())->resize(0,0,W,H);
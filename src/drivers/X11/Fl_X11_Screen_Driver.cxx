@@ -39,6 +39,12 @@
 #include <X11/extensions/Xdbe.h>
 #endif
 
+#if HAVE_XSHM
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+#  include <X11/extensions/XShm.h>
+#endif
+
 #  include <X11/Xutil.h>
 #  ifdef __sgi
 #    include <X11/extensions/readdisplay.h>
@@ -65,18 +71,27 @@ extern const char *fl_bg2;
 
 
 ////////////////////////////////////////////////////////////////////////
-// Timeouts are stored in a sorted list (*first_timeout), so only the
-// first one needs to be checked to see if any should be called.
-// Allocated, but unused (free) Timeout structs are stored in another
-// linked list (*free_timeout).
+// Timeouts are stored in a binary min-heap (timer_heap) ordered by their
+// absolute expiry time, so insertion and expiry stay O(log n) even with
+// thousands of active timers, and only the heap root needs to be checked
+// to see if any should be called. A monotonically increasing sequence
+// number breaks ties so timeouts with equal expiry times still fire in
+// the order they were added.
 
 struct Timeout {
-  double time;
+  double time;       // absolute expiry time on the timer_clock below
+  unsigned long seq; // insertion order, breaks ties between equal times
   void (*cb)(void*);
   void* arg;
-  Timeout* next;
 };
-static Timeout* first_timeout, *free_timeout;
+static Timeout* timer_heap = 0;
+static int timer_heap_size = 0, timer_heap_alloc = 0;
+static unsigned long timer_seq = 0;
+
+// Time elapsed on an arbitrary clock that all expiry times refer to.
+// Storing absolute times means elapse_timeouts() only advances this one
+// value instead of rewriting every pending timeout.
+static double timer_clock;
 
 // I avoid the overhead of getting the current time when we have no
 // timeouts by setting this flag instead of getting the time.
@@ -95,7 +110,56 @@ static void elapse_timeouts() {
   if (reset_clock) {
     reset_clock = 0;
   } else if (elapsed > 0) {
-    for (Timeout* t = first_timeout; t; t = t->next) t->time -= elapsed;
+    timer_clock += elapsed;
+  }
+}
+
+static int timer_earlier(const Timeout& a, const Timeout& b) {
+  return a.time < b.time || (a.time == b.time && a.seq < b.seq);
+}
+
+static void timer_heap_up(int i) {
+  Timeout t = timer_heap[i];
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (!timer_earlier(t, timer_heap[parent])) break;
+    timer_heap[i] = timer_heap[parent];
+    i = parent;
+  }
+  timer_heap[i] = t;
+}
+
+static void timer_heap_down(int i) {
+  Timeout t = timer_heap[i];
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= timer_heap_size) break;
+    if (child + 1 < timer_heap_size &&
+        timer_earlier(timer_heap[child + 1], timer_heap[child])) child++;
+    if (!timer_earlier(timer_heap[child], t)) break;
+    timer_heap[i] = timer_heap[child];
+    i = child;
+  }
+  timer_heap[i] = t;
+}
+
+static void timer_heap_push(const Timeout& t) {
+  if (timer_heap_size == timer_heap_alloc) {
+    timer_heap_alloc = timer_heap_alloc ? 2 * timer_heap_alloc : 32;
+    Timeout* nh = new Timeout[timer_heap_alloc];
+    for (int j = 0; j < timer_heap_size; j++) nh[j] = timer_heap[j];
+    delete[] timer_heap;
+    timer_heap = nh;
+  }
+  timer_heap[timer_heap_size++] = t;
+  timer_heap_up(timer_heap_size - 1);
+}
+
+static void timer_heap_remove(int i) {
+  timer_heap[i] = timer_heap[--timer_heap_size];
+  if (i < timer_heap_size) {
+    timer_heap_up(i);
+    timer_heap_down(i);
   }
 }
 
@@ -106,6 +170,8 @@ static void elapse_timeouts() {
 // time interval:
 static double missed_timeout_by;
 
+extern Fl_Perf_Counters fl_perf_counters; // defined in Fl.cxx
+
 /**
  Creates a driver that manages all screen and display related calls.
 
@@ -425,10 +491,18 @@ void Fl_X11_Screen_Driver::beep(int type)
 }
 
 
+extern void fl_x11_submit_dbe_swaps(); // Fl_X11_Window_Driver.cxx
+extern void fl_x11_ack_sync_frames();  // Fl_x.cxx
+
 void Fl_X11_Screen_Driver::flush()
 {
-  if (fl_display)
+  if (fl_display) {
+    extern void fl_xlib_flush_rect_batch(); // in Fl_Xlib_Graphics_Driver_rect.cxx
+    fl_xlib_flush_rect_batch(); // submit any pending batched fills first
+    fl_x11_submit_dbe_swaps(); // present all double-buffered windows flushed this cycle
+    fl_x11_ack_sync_frames();  // report finished frames to the window manager
     XFlush(fl_display);
+  }
 }
 
 
@@ -436,19 +510,17 @@ double Fl_X11_Screen_Driver::wait(double time_to_wait)
 {
   static char in_idle;
 
-  if (first_timeout) {
+  if (timer_heap_size) {
     elapse_timeouts();
-    Timeout *t;
-    while ((t = first_timeout)) {
-      if (t->time > 0) break;
-      // The first timeout in the array has expired.
-      missed_timeout_by = t->time;
-      // We must remove timeout from array before doing the callback:
-      void (*cb)(void*) = t->cb;
-      void *argp = t->arg;
-      first_timeout = t->next;
-      t->next = free_timeout;
-      free_timeout = t;
+    while (timer_heap_size && timer_heap[0].time - timer_clock <= 0) {
+      // The earliest timeout in the heap has expired.
+      missed_timeout_by = timer_heap[0].time - timer_clock;
+      // We must remove the timeout from the heap before doing the callback:
+      void (*cb)(void*) = timer_heap[0].cb;
+      void *argp = timer_heap[0].arg;
+      timer_heap_remove(0);
+      fl_perf_counters.timeouts++;
+      fl_perf_counters.timeout_lateness -= missed_timeout_by; // missed_timeout_by <= 0
       // Now it is safe for the callback to do add_timeout:
       cb(argp);
     }
@@ -465,8 +537,8 @@ double Fl_X11_Screen_Driver::wait(double time_to_wait)
     // the idle function may turn off idle, we can then wait:
     if (Fl::idle) time_to_wait = 0.0;
   }
-  if (first_timeout && first_timeout->time < time_to_wait)
-    time_to_wait = first_timeout->time;
+  if (timer_heap_size && timer_heap[0].time - timer_clock < time_to_wait)
+    time_to_wait = timer_heap[0].time - timer_clock;
   if (time_to_wait <= 0.0) {
     // do flush second so that the results of events are visible:
     int ret = this->poll_or_select_with_delay(0.0);
@@ -477,9 +549,10 @@ double Fl_X11_Screen_Driver::wait(double time_to_wait)
     Fl::flush();
     if (Fl::idle && !in_idle) // 'idle' may have been set within flush()
       time_to_wait = 0.0;
-    else if (first_timeout && first_timeout->time < time_to_wait) {
+    else if (timer_heap_size && timer_heap[0].time - timer_clock < time_to_wait) {
       // another timeout may have been queued within flush(), see STR #3188
-      time_to_wait = first_timeout->time >= 0.0 ? first_timeout->time : 0.0;
+      double remaining = timer_heap[0].time - timer_clock;
+      time_to_wait = remaining >= 0.0 ? remaining : 0.0;
     }
     return this->poll_or_select_with_delay(time_to_wait);
   }
@@ -488,9 +561,9 @@ double Fl_X11_Screen_Driver::wait(double time_to_wait)
 
 int Fl_X11_Screen_Driver::ready()
 {
-  if (first_timeout) {
+  if (timer_heap_size) {
     elapse_timeouts();
-    if (first_timeout->time <= 0) return 1;
+    if (timer_heap[0].time - timer_clock <= 0) return 1;
   } else {
     reset_clock = 1;
   }
@@ -638,28 +711,20 @@ void Fl_X11_Screen_Driver::add_timeout(double time, Fl_Timeout_Handler cb, void
 
 void Fl_X11_Screen_Driver::repeat_timeout(double time, Fl_Timeout_Handler cb, void *argp) {
   time += missed_timeout_by; if (time < -.05) time = 0;
-  Timeout* t = free_timeout;
-  if (t) {
-      free_timeout = t->next;
-  } else {
-      t = new Timeout;
-  }
-  t->time = time;
-  t->cb = cb;
-  t->arg = argp;
-  // insert-sort the new timeout:
-  Timeout** p = &first_timeout;
-  while (*p && (*p)->time <= time) p = &((*p)->next);
-  t->next = *p;
-  *p = t;
+  Timeout t;
+  t.time = timer_clock + time;
+  t.seq = timer_seq++;
+  t.cb = cb;
+  t.arg = argp;
+  timer_heap_push(t);
 }
 
 /**
   Returns true if the timeout exists and has not been called yet.
 */
 int Fl_X11_Screen_Driver::has_timeout(Fl_Timeout_Handler cb, void *argp) {
-  for (Timeout* t = first_timeout; t; t = t->next)
-    if (t->cb == cb && t->arg == argp) return 1;
+  for (int i = 0; i < timer_heap_size; i++)
+    if (timer_heap[i].cb == cb && timer_heap[i].arg == argp) return 1;
   return 0;
 }
 
@@ -671,16 +736,23 @@ int Fl_X11_Screen_Driver::has_timeout(Fl_Timeout_Handler cb, void *argp) {
         This may change in the future.
 */
 void Fl_X11_Screen_Driver::remove_timeout(Fl_Timeout_Handler cb, void *argp) {
-  for (Timeout** p = &first_timeout; *p;) {
-    Timeout* t = *p;
-    if (t->cb == cb && (t->arg == argp || !argp)) {
-      *p = t->next;
-      t->next = free_timeout;
-      free_timeout = t;
-    } else {
-      p = &(t->next);
-    }
+  // Compact the array over the matching entries, then rebuild the heap.
+  // Removing entries one by one with timer_heap_remove() would be wrong
+  // here: it can sift the replacement element up past slots this scan has
+  // already examined, letting a matching timeout survive.
+  int n = 0;
+  for (int i = 0; i < timer_heap_size; i++) {
+    if (timer_heap[i].cb == cb && (timer_heap[i].arg == argp || !argp)) continue;
+    if (n != i) timer_heap[n] = timer_heap[i];
+    n++;
   }
+  if (n == timer_heap_size) return;
+  timer_heap_size = n;
+  for (int i = n/2 - 1; i >= 0; i--) timer_heap_down(i);
+}
+
+int Fl_X11_Screen_Driver::timer_count() {
+  return timer_heap_size;
 }
 
 int Fl_X11_Screen_Driver::compose(int& del) {
@@ -745,8 +817,111 @@ extern "C" {
   }
 }
 
+#if HAVE_XSHM
+// Screen capture through the MIT-SHM extension: the server writes the pixels
+// directly into a shared memory segment instead of pushing them through the
+// connection. The segment is kept and reused across calls, so repeated
+// captures (e.g. screen recording) allocate nothing per frame.
+
+static XShmSegmentInfo fl_xshm_info;
+static XImage *fl_xshm_image = 0;       // its data points into fl_xshm_info.shmaddr
+static size_t fl_xshm_size = 0;         // current size of the shared segment
+static int fl_xshm_state = 0;           // 0 = untested, 1 = usable, -1 = unusable
+static int fl_xshm_error;
+
+extern "C" {
+  static int xshmerrhandler(Display *display, XErrorEvent *error) {
+    fl_xshm_error = 1;
+    return 0;
+  }
+}
+
+// Captures a drawable rectangle into the shared segment.
+// Returns NULL when MIT-SHM can't be used (e.g. remote display, segment
+// creation failure); the caller then falls back to XGetImage().
+static XImage *fl_xshm_get_image(Drawable xid, int X, int Y, int w, int h) {
+  if (fl_xshm_state < 0) return NULL;
+  if (fl_xshm_state == 0) {
+    int major, minor;
+    Bool pixmaps;
+    if (!XShmQueryVersion(fl_display, &major, &minor, &pixmaps)) {
+      fl_xshm_state = -1;
+      return NULL;
+    }
+    fl_xshm_state = 1;
+  }
+  if (fl_xshm_image && (fl_xshm_image->width != w || fl_xshm_image->height != h)) {
+    fl_xshm_image->data = NULL; // the data belongs to the shared segment
+    XDestroyImage(fl_xshm_image);
+    fl_xshm_image = NULL;
+  }
+  if (!fl_xshm_image) {
+    fl_xshm_image = XShmCreateImage(fl_display, fl_visual->visual, fl_visual->depth,
+                                    ZPixmap, NULL, &fl_xshm_info, w, h);
+    if (!fl_xshm_image) {
+      fl_xshm_state = -1;
+      return NULL;
+    }
+    size_t needed = (size_t)fl_xshm_image->bytes_per_line * fl_xshm_image->height;
+    if (needed > fl_xshm_size) {
+      // create the shared segment, or replace it with a larger one
+      if (fl_xshm_size) {
+        XShmDetach(fl_display, &fl_xshm_info);
+        shmdt(fl_xshm_info.shmaddr);
+        fl_xshm_size = 0;
+      }
+      fl_xshm_info.shmid = shmget(IPC_PRIVATE, needed, IPC_CREAT | 0600);
+      if (fl_xshm_info.shmid < 0) {
+        fl_xshm_image->data = NULL;
+        XDestroyImage(fl_xshm_image);
+        fl_xshm_image = NULL;
+        fl_xshm_state = -1;
+        return NULL;
+      }
+      fl_xshm_info.shmaddr = (char *)shmat(fl_xshm_info.shmid, 0, 0);
+      fl_xshm_info.readOnly = False;
+      if (fl_xshm_info.shmaddr == (char *)-1) {
+        shmctl(fl_xshm_info.shmid, IPC_RMID, 0);
+        fl_xshm_image->data = NULL;
+        XDestroyImage(fl_xshm_image);
+        fl_xshm_image = NULL;
+        fl_xshm_state = -1;
+        return NULL;
+      }
+      fl_xshm_error = 0;
+      XErrorHandler old_handler = XSetErrorHandler(xshmerrhandler);
+      XShmAttach(fl_display, &fl_xshm_info);
+      XSync(fl_display, False);
+      XSetErrorHandler(old_handler);
+      // mark the segment for removal once the last user detaches; this way
+      // it can't outlive the process even on abnormal termination
+      shmctl(fl_xshm_info.shmid, IPC_RMID, 0);
+      if (fl_xshm_error) { // attach failed: the display is likely remote
+        shmdt(fl_xshm_info.shmaddr);
+        fl_xshm_image->data = NULL;
+        XDestroyImage(fl_xshm_image);
+        fl_xshm_image = NULL;
+        fl_xshm_state = -1;
+        return NULL;
+      }
+      fl_xshm_size = needed;
+    }
+    fl_xshm_image->data = fl_xshm_info.shmaddr;
+  }
+  fl_xshm_error = 0;
+  XErrorHandler old_handler = XSetErrorHandler(xshmerrhandler);
+  Bool ok = XShmGetImage(fl_display, xid, fl_xshm_image, X, Y, AllPlanes);
+  XSync(fl_display, False); // collect errors from the capture, if any
+  XSetErrorHandler(old_handler);
+  if (!ok || fl_xshm_error) return NULL;
+  return fl_xshm_image;
+}
+#endif // HAVE_XSHM
+
 Fl_RGB_Image *Fl_X11_Screen_Driver::read_win_rectangle(int X, int Y, int w, int h, Fl_Window *win, bool may_capture_subwins, bool *did_capture_subwins)
 {
+  extern void fl_xlib_flush_rect_batch(); // in Fl_Xlib_Graphics_Driver_rect.cxx
+  fl_xlib_flush_rect_batch();   // drawing must reach the server before the read
   XImage        *image;         // Captured image
   int           i, maxindex;    // Looping vars
   int           x, y;           // Current X & Y in image
@@ -812,9 +987,16 @@ Fl_RGB_Image *Fl_X11_Screen_Driver::read_win_rectangle(int X, int Y, int w, int
       // the image is fully contained, we can use the traditional method
       // however, if the window is obscured etc. the function will still fail. Make sure we
       // catch the error and continue, otherwise an exception will be thrown.
-      XErrorHandler old_handler = XSetErrorHandler(xgetimageerrhandler);
-      image = XGetImage(fl_display, xid, Xs, Ys, ws, hs, AllPlanes, ZPixmap);
-      XSetErrorHandler(old_handler);
+#if HAVE_XSHM
+      // try the MIT-SHM extension first: no image transfer through the
+      // connection and no allocation per capture
+      image = fl_xshm_get_image(xid, Xs, Ys, ws, hs);
+#endif
+      if (!image) {
+        XErrorHandler old_handler = XSetErrorHandler(xgetimageerrhandler);
+        image = XGetImage(fl_display, xid, Xs, Ys, ws, hs, AllPlanes, ZPixmap);
+        XSetErrorHandler(old_handler);
+      }
     } else {
       // image is crossing borders, determine visible region
       int nw, nh, noffx, noffy;
@@ -1043,130 +1225,169 @@ Fl_RGB_Image *Fl_X11_Screen_Driver::read_win_rectangle(int X, int Y, int w, int
       blue_shift ++;
     }
 
-    // Read the pixels and output an RGB image...
-    for (y = 0; y < image->height; y ++) {
-      pixel = (unsigned char *)(image->data + y * image->bytes_per_line);
-      line  = p + y * w * d;
-
-      switch (image->bits_per_pixel) {
-        case 8 :
-          for (x = image->width, line_ptr = line;
-               x > 0;
-               x --, line_ptr += d, pixel ++) {
-            i = *pixel;
-
-            line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
-            line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
-            line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
-          }
-          break;
-
-        case 12 :
-          for (x = image->width, line_ptr = line, index_shift = 0;
-               x > 0;
-               x --, line_ptr += d) {
-            if (index_shift == 0) {
-              i = ((pixel[0] << 4) | (pixel[1] >> 4)) & 4095;
-            } else {
-              i = ((pixel[1] << 8) | pixel[2]) & 4095;
-            }
-
-            line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
-            line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
-            line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+    // Most TrueColor displays store each channel in a byte of its own: copy
+    // the bytes straight across instead of shifting, masking and dividing
+    // every channel of every pixel.
+    int rb = -1, gb = 0, bb = 0;  // byte index of each channel within a pixel
+    int bpp = image->bits_per_pixel / 8;
+    if ((image->bits_per_pixel == 24 || image->bits_per_pixel == 32) &&
+        red_mask == 255 && green_mask == 255 && blue_mask == 255 &&
+        (red_shift % 8) == 0 && (green_shift % 8) == 0 && (blue_shift % 8) == 0) {
+      if (image->byte_order == LSBFirst) {
+        rb = red_shift / 8;
+        gb = green_shift / 8;
+        bb = blue_shift / 8;
+      } else {
+        rb = bpp - 1 - red_shift / 8;
+        gb = bpp - 1 - green_shift / 8;
+        bb = bpp - 1 - blue_shift / 8;
+      }
+    }
 
-            if (index_shift == 0) {
-              index_shift = 4;
-            } else {
-              index_shift = 0;
-              pixel += 3;
-            }
-          }
-          break;
+    if (rb >= 0) {
+      for (y = 0; y < image->height; y ++) {
+        pixel = (unsigned char *)(image->data + y * image->bytes_per_line);
+        line  = p + y * w * d;
+
+        for (x = image->width, line_ptr = line;
+             x > 0;
+             x --, line_ptr += d, pixel += bpp) {
+          line_ptr[0] = pixel[rb];
+          line_ptr[1] = pixel[gb];
+          line_ptr[2] = pixel[bb];
+        }
+      }
+    } else {
+      // Read the pixels and output an RGB image...
+      for (y = 0; y < image->height; y ++) {
+        pixel = (unsigned char *)(image->data + y * image->bytes_per_line);
+        line  = p + y * w * d;
 
-        case 16 :
-          if (image->byte_order == LSBFirst) {
-            // Little-endian...
+        switch (image->bits_per_pixel) {
+          case 8 :
             for (x = image->width, line_ptr = line;
                  x > 0;
-                 x --, line_ptr += d, pixel += 2) {
-              i = (pixel[1] << 8) | pixel[0];
+                 x --, line_ptr += d, pixel ++) {
+              i = *pixel;
 
               line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
               line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
               line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
             }
-          } else {
-            // Big-endian...
-            for (x = image->width, line_ptr = line;
-                 x > 0;
-                 x --, line_ptr += d, pixel += 2) {
-              i = (pixel[0] << 8) | pixel[1];
+            break;
 
-              line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
-              line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
-              line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
-            }
-          }
-          break;
-
-        case 24 :
-          if (image->byte_order == LSBFirst) {
-            // Little-endian...
-            for (x = image->width, line_ptr = line;
+          case 12 :
+            for (x = image->width, line_ptr = line, index_shift = 0;
                  x > 0;
-                 x --, line_ptr += d, pixel += 3) {
-              i = (((pixel[2] << 8) | pixel[1]) << 8) | pixel[0];
+                 x --, line_ptr += d) {
+              if (index_shift == 0) {
+                i = ((pixel[0] << 4) | (pixel[1] >> 4)) & 4095;
+              } else {
+                i = ((pixel[1] << 8) | pixel[2]) & 4095;
+              }
 
               line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
               line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
               line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
-            }
-          } else {
-            // Big-endian...
-            for (x = image->width, line_ptr = line;
-                 x > 0;
-                 x --, line_ptr += d, pixel += 3) {
-              i = (((pixel[0] << 8) | pixel[1]) << 8) | pixel[2];
 
-              line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
-              line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
-              line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+              if (index_shift == 0) {
+                index_shift = 4;
+              } else {
+                index_shift = 0;
+                pixel += 3;
+              }
             }
-          }
-          break;
-
-        case 32 :
-          if (image->byte_order == LSBFirst) {
-            // Little-endian...
-            for (x = image->width, line_ptr = line;
-                 x > 0;
-                 x --, line_ptr += d, pixel += 4) {
-              i = (((((pixel[3] << 8) | pixel[2]) << 8) | pixel[1]) << 8) | pixel[0];
-
-              line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
-              line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
-              line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+            break;
+
+          case 16 :
+            if (image->byte_order == LSBFirst) {
+              // Little-endian...
+              for (x = image->width, line_ptr = line;
+                   x > 0;
+                   x --, line_ptr += d, pixel += 2) {
+                i = (pixel[1] << 8) | pixel[0];
+
+                line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
+                line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
+                line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+              }
+            } else {
+              // Big-endian...
+              for (x = image->width, line_ptr = line;
+                   x > 0;
+                   x --, line_ptr += d, pixel += 2) {
+                i = (pixel[0] << 8) | pixel[1];
+
+                line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
+                line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
+                line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+              }
             }
-          } else {
-            // Big-endian...
-            for (x = image->width, line_ptr = line;
-                 x > 0;
-                 x --, line_ptr += d, pixel += 4) {
-              i = (((((pixel[0] << 8) | pixel[1]) << 8) | pixel[2]) << 8) | pixel[3];
-
-              line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
-              line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
-              line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+            break;
+
+          case 24 :
+            if (image->byte_order == LSBFirst) {
+              // Little-endian...
+              for (x = image->width, line_ptr = line;
+                   x > 0;
+                   x --, line_ptr += d, pixel += 3) {
+                i = (((pixel[2] << 8) | pixel[1]) << 8) | pixel[0];
+
+                line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
+                line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
+                line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+              }
+            } else {
+              // Big-endian...
+              for (x = image->width, line_ptr = line;
+                   x > 0;
+                   x --, line_ptr += d, pixel += 3) {
+                i = (((pixel[0] << 8) | pixel[1]) << 8) | pixel[2];
+
+                line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
+                line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
+                line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+              }
             }
-          }
-          break;
+            break;
+
+          case 32 :
+            if (image->byte_order == LSBFirst) {
+              // Little-endian...
+              for (x = image->width, line_ptr = line;
+                   x > 0;
+                   x --, line_ptr += d, pixel += 4) {
+                i = (((((pixel[3] << 8) | pixel[2]) << 8) | pixel[1]) << 8) | pixel[0];
+
+                line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
+                line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
+                line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+              }
+            } else {
+              // Big-endian...
+              for (x = image->width, line_ptr = line;
+                   x > 0;
+                   x --, line_ptr += d, pixel += 4) {
+                i = (((((pixel[0] << 8) | pixel[1]) << 8) | pixel[2]) << 8) | pixel[3];
+
+                line_ptr[0] = 255 * ((i >> red_shift) & red_mask) / red_mask;
+                line_ptr[1] = 255 * ((i >> green_shift) & green_mask) / green_mask;
+                line_ptr[2] = 255 * ((i >> blue_shift) & blue_mask) / blue_mask;
+              }
+            }
+            break;
+        }
       }
     }
   }
 
   // Destroy the X image we've read and return the RGB(A) image...
+  // (the shared MIT-SHM image is kept for the next capture)
+#if HAVE_XSHM
+  if (image != fl_xshm_image) XDestroyImage(image);
+#else
   XDestroyImage(image);
+#endif
 
   Fl_RGB_Image *rgb = new Fl_RGB_Image(p, w, h, d);
   rgb->alloc_array = 1;
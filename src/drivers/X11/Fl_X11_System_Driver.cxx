@@ -538,9 +538,23 @@ int Fl_X11_System_Driver::filename_list(const char *d,
     // Check if dir (checks done on "old" name as we need to interact with
     // the underlying OS)
     if (de->d_name[len-1]!='/' && len<=FL_PATH_MAX) {
-      // Use memcpy for speed since we already know the length of the string...
-      memcpy(name, de->d_name, len+1);
-      if (fl_filename_isdir(fullname)) {
+      int isdir;
+#ifdef DT_DIR
+      // readdir() already reports the entry type on most filesystems, so
+      // only unknown types and symlinks need the stat() round trip below
+      // (important for large directories on network filesystems)
+      if (de->d_type == DT_DIR) {
+        isdir = 1;
+      } else if (de->d_type != DT_UNKNOWN && de->d_type != DT_LNK) {
+        isdir = 0;
+      } else
+#endif
+      {
+        // Use memcpy for speed since we already know the length of the string...
+        memcpy(name, de->d_name, len+1);
+        isdir = fl_filename_isdir(fullname);
+      }
+      if (isdir) {
         char *dst = newde->d_name + newlen;
         *dst++ = '/';
         *dst = 0;
@@ -29,6 +29,7 @@
 #include <FL/Fl.H>
 #include <FL/platform.H>
 #include <string.h>
+#include <stdlib.h> // realloc()
 #if HAVE_DLFCN_H
 #include <dlfcn.h>
 #endif
@@ -42,6 +43,8 @@ extern Colormap fl_overlay_colormap;
 extern unsigned long fl_transparent_pixel;
 #endif
 
+extern void fl_x11_forget_sync_counter(Window window); // Fl_x.cxx
+
 Window fl_window;
 
 #if USE_XDBE
@@ -71,6 +74,40 @@ static int can_xdbe()
   return use_xdbe;
 }
 
+// Deferred XDBE swaps: flush_double_dbe() queues its swap here, and
+// fl_x11_submit_dbe_swaps() - called from Fl_X11_Screen_Driver::flush()
+// at the end of each flush cycle - presents all the windows flushed in
+// that cycle with a single XdbeSwapBuffers request.
+static XdbeSwapInfo *dbe_swap_queue = 0;
+static int dbe_swap_count = 0;
+static int dbe_swap_alloc = 0;
+
+static void queue_dbe_swap(Window win) {
+  for (int j = 0; j < dbe_swap_count; j++)
+    if (dbe_swap_queue[j].swap_window == win) return;   // already queued
+  if (dbe_swap_count == dbe_swap_alloc) {
+    dbe_swap_alloc = dbe_swap_alloc ? 2 * dbe_swap_alloc : 8;
+    dbe_swap_queue = (XdbeSwapInfo*)realloc(dbe_swap_queue,
+                                            dbe_swap_alloc * sizeof(XdbeSwapInfo));
+  }
+  dbe_swap_queue[dbe_swap_count].swap_window = win;
+  dbe_swap_queue[dbe_swap_count].swap_action = XdbeCopied;
+  dbe_swap_count++;
+}
+
+// Forget a queued swap, e.g. because the window is being destroyed.
+static void unqueue_dbe_swap(Window win) {
+  for (int j = 0; j < dbe_swap_count; j++)
+    if (dbe_swap_queue[j].swap_window == win)
+      dbe_swap_queue[j] = dbe_swap_queue[--dbe_swap_count];
+}
+
+void fl_x11_submit_dbe_swaps() {
+  if (!dbe_swap_count) return;
+  XdbeSwapBuffers(fl_display, dbe_swap_queue, dbe_swap_count);
+  dbe_swap_count = 0;
+}
+
 
 void Fl_X11_Window_Driver::flush_double_dbe(int erase_overlay)
 {
@@ -87,32 +124,39 @@ void Fl_X11_Window_Driver::flush_double_dbe(int erase_overlay)
     pWindow->clear_damage(FL_DAMAGE_ALL);
     backbuffer_bad = 0;
   }
-  // Redraw as needed...
-  if (pWindow->damage()) {
+  // Redraw as needed. Pure expose damage (another window dragged across
+  // us) needs no drawing at all: the back buffer still holds the last
+  // frame, and the XdbeCopied swap below repaints the window from it.
+  if (pWindow->damage() & ~FL_DAMAGE_EXPOSE) {
     fl_clip_region(i->region); i->region = 0;
     fl_window = other_xid;
     draw();
     fl_window = i->xid;
   }
-  // Copy contents of back buffer to window...
-  XdbeSwapInfo s;
-  s.swap_window = fl_xid(pWindow);
-  s.swap_action = XdbeCopied;
-  XdbeSwapBuffers(fl_display, &s, 1);
+  // Queue the copy of the back buffer to the window; all windows
+  // flushed in this cycle are presented with one XdbeSwapBuffers call.
+  queue_dbe_swap(fl_xid(pWindow));
 }
 
+#else // !USE_XDBE
+
+void fl_x11_submit_dbe_swaps() {}
+
 #endif // USE_XDBE
 
 
 void Fl_X11_Window_Driver::destroy_double_buffer() {
 #if USE_XDBE
   if (can_xdbe()) {
+    // XDBE back buffers belong to the server-side window and can't be
+    // parked in the shared pool
+    unqueue_dbe_swap(fl_xid(pWindow)); // don't swap a deallocated buffer
     XdbeDeallocateBackBufferName(fl_display, other_xid);
+    other_xid = 0;
+    return;
   }
-  else
 #endif // USE_XDBE
-    fl_delete_offscreen(other_xid);
-  other_xid = 0;
+  Fl_Window_Driver::destroy_double_buffer(); // parks the buffer in the pool
 }
 
 Fl_Window_Driver *Fl_Window_Driver::newWindowDriver(Fl_Window *w)
@@ -126,6 +170,9 @@ Fl_X11_Window_Driver::Fl_X11_Window_Driver(Fl_Window *win)
 {
   icon_ = new icon_data;
   memset(icon_, 0, sizeof(icon_data));
+  visibility_ = -1;
+  scroll_expose_wait_ = 0;
+  cursor_ = -1;
 #if USE_XFT
   screen_num_ = -1;
 #endif
@@ -221,7 +268,7 @@ void Fl_X11_Window_Driver::flush_double(int erase_overlay)
   pWindow->make_current(); // make sure fl_gc is non-zero
   Fl_X *i = Fl_X::i(pWindow);
   if (!other_xid) {
-      other_xid = fl_create_offscreen(w(), h());
+      other_xid = lease_double_buffer(w(), h());
     pWindow->clear_damage(FL_DAMAGE_ALL);
   }
     if (pWindow->damage() & ~FL_DAMAGE_EXPOSE) {
@@ -232,8 +279,18 @@ void Fl_X11_Window_Driver::flush_double(int erase_overlay)
     }
   if (erase_overlay) fl_clip_region(0);
   int X = 0, Y = 0, W = 0, H = 0;
-  fl_clip_box(0, 0, w(), h(), X, Y, W, H);
-  if (other_xid) fl_copy_offscreen(X, Y, W, H, other_xid, X, Y);
+  int n = erase_overlay ? -1 : damage_rect_count();
+  if (other_xid && n > 1) {
+    // copy only the rectangles that were redrawn instead of their bounding box
+    for (int j = 0; j < n; j++) {
+      damage_rect(j, X, Y, W, H);
+      fl_clip_box(X, Y, W, H, X, Y, W, H);
+      if (W > 0 && H > 0) fl_copy_offscreen(X, Y, W, H, other_xid, X, Y);
+    }
+  } else {
+    fl_clip_box(0, 0, w(), h(), X, Y, W, H);
+    if (other_xid) fl_copy_offscreen(X, Y, W, H, other_xid, X, Y);
+  }
 }
 
 
@@ -247,7 +304,14 @@ void Fl_X11_Window_Driver::flush_overlay()
 #endif
   flush_double(erase_overlay);
   Fl_Overlay_Window *oWindow = pWindow->as_overlay_window();
-  if (overlay() == oWindow) oWindow->draw_overlay();
+  if (overlay() == oWindow) {
+#if USE_XDBE
+    // the overlay is drawn straight onto the window, so the queued
+    // back-to-front copy must be presented first
+    fl_x11_submit_dbe_swaps();
+#endif
+    oWindow->draw_overlay();
+  }
 }
 
 
@@ -477,7 +541,14 @@ void Fl_X11_Window_Driver::hide() {
   screen_num_ = -1;
 # endif
   // this test makes sure ip->xid has not been destroyed already
+#if USE_XDBE
+  if (ip->xid) unqueue_dbe_swap(ip->xid); // forget any swap queued for this window
+#endif
+  if (ip->xid) fl_x11_forget_sync_counter(ip->xid); // drop its frame sync counter
+  extern void fl_xlib_flush_rect_batch(); // in Fl_Xlib_Graphics_Driver_rect.cxx
+  fl_xlib_flush_rect_batch(); // a pending fill must not outlive its drawable
   if (ip->xid) XDestroyWindow(fl_display, ip->xid);
+  cursor_ = -1; // a new X window starts out with the default cursor
   delete ip;
 }
 
@@ -627,6 +698,7 @@ void Fl_X11_Window_Driver::redraw_overlay() {
   if (shown()) {
     if (overlay() == pWindow) {
       pWindow->clear_damage(pWindow->damage()|FL_DAMAGE_OVERLAY);
+      add_dirty(pWindow); // Fl::flush() only visits windows on the dirty list
       Fl::damage(FL_DAMAGE_CHILD);
     } else if (!overlay()->shown())
       overlay()->show();
@@ -666,16 +738,30 @@ int Fl_X11_Window_Driver::scroll(int src_x, int src_y, int src_w, int src_h, int
                                  void (*draw_area)(void*, int,int,int,int), void* data)
 {
   float s = Fl::screen_driver()->scale(screen_num());
-  XCopyArea(fl_display, fl_window, fl_window, (GC)fl_graphics_driver->gc(),
+  GC gc = (GC)fl_graphics_driver->gc();
+  fl_xlib_flush_rect_batch(); // batched fills must reach the drawable before the copy
+  if (fl_window != fl_xid(pWindow)) {
+    // drawing into the back buffer of a double-buffered window: a pixmap
+    // source is always fully available, so no exposure report is needed
+    XSetGraphicsExposures(fl_display, gc, False);
+    XCopyArea(fl_display, fl_window, fl_window, gc,
+              int(src_x*s), int(src_y*s), int(src_w*s), int(src_h*s), int(dest_x*s), int(dest_y*s));
+    XSetGraphicsExposures(fl_display, gc, True);
+    return 0;
+  }
+  if (scroll_expose_wait_) {
+    // the uncovered area of a previous copy hasn't been reported yet; a
+    // second copy would make its coordinates stale, so redraw instead
+    return 1;
+  }
+  XCopyArea(fl_display, fl_window, fl_window, gc,
             int(src_x*s), int(src_y*s), int(src_w*s), int(src_h*s), int(dest_x*s), int(dest_y*s));
-  // we have to sync the display and get the GraphicsExpose events! (sigh)
-  for (;;) {
-    XEvent e; XWindowEvent(fl_display, fl_window, ExposureMask, &e);
-    if (e.type == NoExpose) break;
-    // otherwise assume it is a GraphicsExpose event:
-    draw_area(data, e.xexpose.x, e.xexpose.y,
-              e.xexpose.width, e.xexpose.height);
-    if (!e.xgraphicsexpose.count) break;
+  if (visibility_ != VisibilityUnobscured) {
+    // part of the copy source may be obscured and must be repainted where
+    // it was copied to. Instead of stalling on a server round trip to
+    // collect the GraphicsExpose events here, let the event loop turn them
+    // into FL_DAMAGE_EXPOSE damage repainted at the next flush.
+    scroll_expose_wait_ = 1;
   }
   return 0;
 }
@@ -56,6 +56,7 @@ Fl_Xlib_Graphics_Driver::Fl_Xlib_Graphics_Driver(void) {
   offset_x_ = 0; offset_y_ = 0;
   depth_ = 0;
   clip_max_ = 32760; // clipping limit (2**15 - 8)
+  for (int i = 0; i < FL_REGION_STACK_SIZE; i++) crstack[i].valid = 0;
 }
 
 Fl_Xlib_Graphics_Driver::~Fl_Xlib_Graphics_Driver() {
@@ -64,6 +65,9 @@ Fl_Xlib_Graphics_Driver::~Fl_Xlib_Graphics_Driver() {
 
 
 void Fl_Xlib_Graphics_Driver::gc(void *value) {
+  extern void fl_xlib_forget_line_style(); // in Fl_Xlib_Graphics_Driver_line_style.cxx
+  fl_xlib_forget_line_style(); // a (possibly recreated) GC carries its own line style
+  fl_xlib_flush_rect_batch();
   gc_ = (GC)value;
   fl_gc = gc_;
 }
@@ -80,6 +84,7 @@ void Fl_Xlib_Graphics_Driver::scale(float f) {
 }
 
 void Fl_Xlib_Graphics_Driver::copy_offscreen(int x, int y, int w, int h, Fl_Offscreen pixmap, int srcx, int srcy) {
+  fl_xlib_flush_rect_batch();
   XCopyArea(fl_display, pixmap, fl_window, gc_, srcx*scale(), srcy*scale(), w*scale(), h*scale(), (x+offset_x_)*scale(), (y+offset_y_)*scale());
 
 }
@@ -28,6 +28,7 @@ void Fl_Xlib_Graphics_Driver::arc_unscaled(int x, int y, int w, int h, double a1
   if (w <= 0 || h <= 0) return;
   x += floor(offset_x_);
   y += floor(offset_y_);
+  fl_xlib_flush_rect_batch();
   XDrawArc(fl_display, fl_window, gc_, x, y, w, h, int(a1*64),int((a2-a1)*64));
 }
 
@@ -36,6 +37,7 @@ void Fl_Xlib_Graphics_Driver::pie_unscaled(int x, int y, int w, int h, double a1
   x += floor(offset_x_);
   y += floor(offset_y_);
   int extra = scale() >= 3 ? 1 : 0;
+  fl_xlib_flush_rect_batch();
   XDrawArc(fl_display, fl_window, gc_, x+1+extra, y+1+extra, w-2-2*extra, h-2-2*extra, int(a1*64), int((a2-a1)*64));
   XFillArc(fl_display, fl_window, gc_, x+1, y+1, w-2, h-2, int(a1*64), int((a2-a1)*64));
 }
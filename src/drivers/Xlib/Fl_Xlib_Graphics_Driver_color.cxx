@@ -111,6 +111,7 @@ void Fl_Xlib_Graphics_Driver::color(Fl_Color i) {
   } else {
     Fl_Graphics_Driver::color(i);
     if(!gc_) return; // don't get a default gc if current window is not yet created/valid
+    fl_xlib_flush_rect_batch(); // pending fills use the GC's current foreground
     XSetForeground(fl_display, gc_, fl_xpixel(i));
   }
 }
@@ -118,6 +119,7 @@ void Fl_Xlib_Graphics_Driver::color(Fl_Color i) {
 void Fl_Xlib_Graphics_Driver::color(uchar r,uchar g,uchar b) {
   Fl_Graphics_Driver::color( fl_rgb_color(r, g, b) );
   if(!gc_) return; // don't get a default gc if current window is not yet created/valid
+  fl_xlib_flush_rect_batch(); // pending fills use the GC's current foreground
   XSetForeground(fl_display, gc_, fl_xpixel(r,g,b));
 }
 
@@ -336,6 +338,46 @@ void Fl_Xlib_Graphics_Driver::set_color(Fl_Color i, unsigned c) {
   }
 }
 
+/**
+  Set \p count color mapping table entries in one pass, starting with
+  entry \p first.
+
+  All changed entries with a server-allocated colormap color are freed
+  with a single XFreeColors() request instead of one round trip per
+  entry, so swapping a whole palette at runtime stays cheap. The new
+  colors are not allocated until fl_color(i) is used.
+*/
+void Fl_Xlib_Graphics_Driver::set_colors(const unsigned *colors, int first, int count) {
+#  if HAVE_OVERLAY
+  const int planes = 2;
+#  else
+  const int planes = 1;
+#  endif
+  for (int overlay = 0; overlay < planes; overlay++) {
+#  if USE_COLORMAP
+    ulong pixels[256];
+    int npixels = 0;
+#    if HAVE_OVERLAY
+    Colormap colormap = overlay ? fl_overlay_colormap : fl_colormap;
+#    else
+    Colormap colormap = fl_colormap;
+#    endif
+#  endif
+    for (int i = 0; i < count; i++) {
+      Fl_XColor &xmap = fl_xmap[overlay][first+i];
+      if (fl_cmap[first+i] == colors[i] || !xmap.mapped) continue;
+#  if USE_COLORMAP
+      if (xmap.mapped == 1) pixels[npixels++] = xmap.pixel;
+#  endif
+      xmap.mapped = 0;
+    }
+#  if USE_COLORMAP
+    if (npixels) XFreeColors(fl_display, colormap, pixels, npixels, 0);
+#  endif
+  }
+  for (int i = 0; i < count; i++) fl_cmap[first+i] = colors[i];
+}
+
 /**
  \}
  */
@@ -644,6 +644,7 @@ void Fl_Xlib_Graphics_Driver::text_extents_unscaled(const char *c, int n, int &d
 }
 
 void Fl_Xlib_Graphics_Driver::draw_unscaled(const char* c, int n, int x, int y) {
+  fl_xlib_flush_rect_batch();
 
   // transform coordinates and clip if outside 16-bit space (STR 2798)
 
@@ -679,6 +680,7 @@ void Fl_Xlib_Graphics_Driver::draw_unscaled(int angle, const char *str, int n, i
 }
 
 void Fl_Xlib_Graphics_Driver::rtl_draw_unscaled(const char* c, int n, int x, int y) {
+  fl_xlib_flush_rect_batch();
 
   // transform coordinates and clip if outside 16-bit space (STR 2798)
 
@@ -22,11 +22,13 @@
 #include <FL/fl_draw.H>
 #include <FL/fl_string.h>  // fl_strdup()
 #include <FL/platform.H>
+#include <FL/Fl_Preferences.H>
 #include "Fl_Font.H"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <sys/stat.h>
 
 #include <X11/Xft/Xft.h>
 #include <X11/Xft/XftCompat.h>
@@ -148,6 +150,75 @@ static void correct_extents (float s, int &dx, int &dy, int &w, int &h) {
   }
 }
 
+// Scanning every installed font in Fl::set_fonts() can stall for several
+// seconds on hosts with many fonts. The computed list only changes when
+// fonts are installed or removed, so it is kept in the user's FLTK
+// preferences together with a signature of the fontconfig font and cache
+// directories (library version, directory count, modification times).
+// While the signature still matches, set_fonts() loads the stored list
+// and skips the enumeration entirely.
+
+static void font_cache_stat_dirs(FcStrList *dirs, unsigned &count,
+                                 unsigned long &sum, unsigned long &newest) {
+  if (!dirs) return;
+  FcChar8 *dir;
+  while ((dir = FcStrListNext(dirs)) != NULL) {
+    struct stat s;
+    count++;
+    if (stat((const char *)dir, &s) == 0) {
+      sum += (unsigned long)s.st_mtime;
+      if ((unsigned long)s.st_mtime > newest) newest = (unsigned long)s.st_mtime;
+    }
+  }
+  FcStrListDone(dirs);
+}
+
+static void font_cache_signature(char *buf, int buflen) {
+  unsigned count = 0;
+  unsigned long sum = 0, newest = 0;
+  font_cache_stat_dirs(FcConfigGetFontDirs(NULL), count, sum, newest);
+  font_cache_stat_dirs(FcConfigGetCacheDirs(NULL), count, sum, newest);
+  snprintf(buf, buflen, "%d %u %lu %lu", FcGetVersion(), count, sum, newest);
+}
+
+// Fills the font table from the stored list and returns the number of fonts
+// loaded, or 0 if there is no stored list or its signature does not match.
+static int font_cache_load(const char *signature) {
+  Fl_Preferences cache(Fl_Preferences::CORE_USER, "fltk.org", "fonts");
+  char *stored = 0;
+  int count = 0;
+  cache.get("signature", stored, "");
+  if (strcmp(stored, signature) == 0) cache.get("count", count, 0);
+  free(stored);
+  for (int j = 0; j < count; j++) {
+    char key[16], *name = 0;
+    snprintf(key, sizeof(key), "f%d", j);
+    cache.get(key, name, "");
+    if (!*name) { // the stored list is damaged, rescan
+      free(name);
+      return 0;
+    }
+    Fl::set_font((Fl_Font)(j + FL_FREE_FONT), name); // the font table keeps the string
+  }
+  return count;
+}
+
+// Records the current content of the font table under the given signature.
+static void font_cache_save(const char *signature, int count) {
+  Fl_Preferences cache(Fl_Preferences::CORE_USER, "fltk.org", "fonts");
+  cache.clear();
+  cache.set("signature", signature);
+  cache.set("count", count);
+  for (int j = 0; j < count; j++) {
+    const char *name = Fl::get_font((Fl_Font)(j + FL_FREE_FONT));
+    if (name) {
+      char key[16];
+      snprintf(key, sizeof(key), "f%d", j);
+      cache.set(key, name);
+    }
+  }
+}
+
 #if ! USE_PANGO
 
 ///////////////////////////////////////////////////////////
@@ -354,6 +425,15 @@ Fl_Font Fl_Xlib_Graphics_Driver::set_fonts(const char* pattern_name)
     return FL_FREE_FONT;
   }
 
+  // Load the stored font list if it is still current, and skip the scan
+  char signature[128];
+  font_cache_signature(signature, sizeof(signature));
+  int cached_count = font_cache_load(signature);
+  if (cached_count) {
+    fl_free_font += cached_count;
+    return (Fl_Font)fl_free_font;
+  }
+
   // Create a search pattern that will match every font name - I think this
   // does the Right Thing, but am not certain...
   //
@@ -460,6 +540,9 @@ Fl_Font Fl_Xlib_Graphics_Driver::set_fonts(const char* pattern_name)
     }
     // Now we are done with the list, release it fully
     free(full_list);
+
+    // Keep the list for later runs, it is costly to compute
+    font_cache_save(signature, fl_free_font - FL_FREE_FONT);
   }
   return (Fl_Font)fl_free_font;
 } // ::set_fonts
@@ -701,6 +784,9 @@ puts("Font Opened"); fflush(stdout);
 Fl_Xlib_Font_Descriptor::Fl_Xlib_Font_Descriptor(const char* name, Fl_Fontsize fsize, int fangle) : Fl_Font_Descriptor(name, fsize) {
 //  encoding = fl_encoding_;
   angle = fangle;
+  width = NULL;
+  runs = NULL;
+  runs_stamp = 0;
   font = fontopen(name, fsize, false, angle);
 }
 
@@ -751,9 +837,18 @@ int Fl_Xlib_Graphics_Driver::descent_unscaled() {
 
 double Fl_Xlib_Graphics_Driver::width_unscaled(const char* str, int n) {
   if (!font_descriptor()) return -1.0;
-  XGlyphInfo i;
-  utf8extents((Fl_Xlib_Font_Descriptor*)font_descriptor(), str, n, &i);
-  return i.xOff;
+  // Xft does not apply kerning, so the advance of a string is the sum of the
+  // advances of its characters: serve string measurement from the
+  // glyph-advance cache instead of another round trip through Xft.
+  double w = 0;
+  const char *e = str + n;
+  while (str < e) {
+    int l;
+    unsigned int c = fl_utf8decode(str, e, &l);
+    w += width_unscaled(c);
+    str += l;
+  }
+  return w;
 }
 
 static double fl_xft_width(Fl_Font_Descriptor *desc, FcChar32 *str, int n) {
@@ -763,9 +858,30 @@ static double fl_xft_width(Fl_Font_Descriptor *desc, FcChar32 *str, int n) {
   return i.xOff;
 }
 
+// cache the advance widths of single Unicode characters (see also the
+// USE_PANGO variant of this function)
 double Fl_Xlib_Graphics_Driver::width_unscaled(unsigned int c) {
   if (!font_descriptor()) return -1.0;
-  return fl_xft_width(font_descriptor(), (FcChar32 *)(&c), 1);
+  Fl_Xlib_Font_Descriptor *desc = (Fl_Xlib_Font_Descriptor*)font_descriptor();
+  unsigned r = 0;
+  if (c <= 0xFFFF) {
+    r = (c & 0xFC00) >> 10;
+    if (!desc->width) {
+      desc->width = (int**)new int*[64];
+      memset(desc->width, 0, 64*sizeof(int*));
+    }
+    if (!desc->width[r]) {
+      desc->width[r] = (int*)new int[0x0400];
+      for (int i = 0; i < 0x0400; i++) desc->width[r][i] = -1;
+    } else {
+      if ( desc->width[r][c&0x03FF] >= 0 ) { // already cached
+        return double(desc->width[r][c & 0x03FF]);
+      }
+    }
+  }
+  double w = fl_xft_width(desc, (FcChar32 *)(&c), 1);
+  if (c <= 0xFFFF) desc->width[r][c & 0x03FF] = (int)w;
+  return w;
 }
 
 void Fl_Xlib_Graphics_Driver::text_extents_unscaled(const char *c, int n, int &dx, int &dy, int &w, int &h) {
@@ -784,6 +900,83 @@ void Fl_Xlib_Graphics_Driver::text_extents_unscaled(const char *c, int n, int &d
   correct_extents(scale(), dx, dy, w, h);
 }
 
+#ifndef __CYGWIN__
+
+// tuning of the per-descriptor cache of prepared glyph runs:
+#define GLYPH_RUN_MAX_BYTES 64  // longest string worth caching
+#define GLYPH_RUN_SLOTS     32  // cached runs per font descriptor
+
+struct Fl_Xlib_Font_Descriptor::Glyph_Run {
+  int len;              // byte length of the source string
+  int stamp;            // last use, for least-recently-used replacement
+  int nglyphs;
+  XftGlyphSpec *specs;  // glyph indices and offsets from the run origin
+  char key[GLYPH_RUN_MAX_BYTES];
+};
+
+/* Return the prepared glyph run for the n-byte string str, building and
+ caching it on first use. The glyphs and their integer offsets are exactly
+ what XftDrawString32() would compute for the same string, so strings that
+ are drawn over and over (column headers, repeated cell values) skip the
+ UTF-8 decode and the per-character glyph lookups of the generic path.
+ Returns NULL if the run turns out to be too wide to position in the
+ 16-bit coordinates Xft uses; the caller then takes the generic path.
+ */
+static Fl_Xlib_Font_Descriptor::Glyph_Run *prepare_glyph_run(Fl_Xlib_Font_Descriptor *desc,
+                                                             const char *str, int n)
+{
+  typedef Fl_Xlib_Font_Descriptor::Glyph_Run Glyph_Run;
+  if (!desc->runs) {
+    desc->runs = new Glyph_Run*[GLYPH_RUN_SLOTS];
+    memset(desc->runs, 0, GLYPH_RUN_SLOTS * sizeof(Glyph_Run*));
+  }
+  int slot = 0, oldest = desc->runs_stamp;
+  for (int i = 0; i < GLYPH_RUN_SLOTS; i++) {
+    Glyph_Run *r = desc->runs[i];
+    if (!r) { slot = i; break; }
+    if (r->len == n && !memcmp(r->key, str, n)) {
+      r->stamp = ++desc->runs_stamp;
+      return r;
+    }
+    if (r->stamp < oldest) { oldest = r->stamp; slot = i; }
+  }
+  // build the run in the free or least recently used slot:
+  int wn = n;
+  const wchar_t *buffer = utf8reformat(str, wn);
+  Glyph_Run *r = desc->runs[slot];
+  if (!r) {
+    r = new Glyph_Run;
+    desc->runs[slot] = r;
+  } else {
+    delete[] r->specs;
+  }
+  r->len = n;
+  memcpy(r->key, str, n);
+  r->nglyphs = wn;
+  r->specs = new XftGlyphSpec[wn];
+  int xx = 0, yy = 0;
+  for (int i = 0; i < wn; i++) {
+    FT_UInt g = XftCharIndex(fl_display, desc->font, (FcChar32)buffer[i]);
+    r->specs[i].glyph = g;
+    r->specs[i].x = (short)xx;
+    r->specs[i].y = (short)yy;
+    XGlyphInfo gi;
+    XftGlyphExtents(fl_display, desc->font, &g, 1, &gi);
+    xx += gi.xOff;
+    yy += gi.yOff;
+    if (xx > 0x7000 || xx < -0x7000) { // won't fit in XftGlyphSpec coordinates
+      delete[] r->specs;
+      delete r;
+      desc->runs[slot] = NULL;
+      return NULL;
+    }
+  }
+  r->stamp = ++desc->runs_stamp;
+  return r;
+}
+
+#endif // !__CYGWIN__
+
 void Fl_Xlib_Graphics_Driver::draw_unscaled(const char *str, int n, int x, int y) {
 
   // transform coordinates and clip if outside 16-bit space (STR 2798)
@@ -794,6 +987,8 @@ void Fl_Xlib_Graphics_Driver::draw_unscaled(const char *str, int n, int x, int y
   int y1 = y + floor(offset_y_) ;
   if (y1 < clip_min() || y1 > clip_max()) return;
 
+  fl_xlib_flush_rect_batch();
+
 #if USE_OVERLAY
   XftDraw*& draw_ = fl_overlay ? draw_overlay : ::draw_;
   if (fl_overlay) {
@@ -824,11 +1019,26 @@ void Fl_Xlib_Graphics_Driver::draw_unscaled(const char *str, int n, int x, int y
     color.color.blue  = ((int)b)*0x101;
     color.color.alpha = 0xffff;
 
-    const wchar_t *buffer = utf8reformat(str, n);
 #ifdef __CYGWIN__
+    const wchar_t *buffer = utf8reformat(str, n);
     XftDrawString16(draw_, &color, ((Fl_Xlib_Font_Descriptor*)font_descriptor())->font, x1, y1, (XftChar16 *)buffer, n);
 #else
-    XftDrawString32(draw_, &color, ((Fl_Xlib_Font_Descriptor*)font_descriptor())->font, x1, y1, (XftChar32 *)buffer, n);
+    Fl_Xlib_Font_Descriptor *desc = (Fl_Xlib_Font_Descriptor*)font_descriptor();
+    Fl_Xlib_Font_Descriptor::Glyph_Run *run =
+      (n > 0 && n <= GLYPH_RUN_MAX_BYTES) ? prepare_glyph_run(desc, str, n) : NULL;
+    if (run) {
+      // translate the cached run to the draw origin and submit it whole:
+      XftGlyphSpec specs[GLYPH_RUN_MAX_BYTES];
+      for (int i = 0; i < run->nglyphs; i++) {
+        specs[i].glyph = run->specs[i].glyph;
+        specs[i].x = (short)(x1 + run->specs[i].x);
+        specs[i].y = (short)(y1 + run->specs[i].y);
+      }
+      XftDrawGlyphSpec(draw_, &color, desc->font, specs, run->nglyphs);
+    } else {
+      const wchar_t *buffer = utf8reformat(str, n);
+      XftDrawString32(draw_, &color, desc->font, x1, y1, (XftChar32 *)buffer, n);
+    }
 #endif
   }
 }
@@ -840,6 +1050,7 @@ void Fl_Xlib_Graphics_Driver::draw_unscaled(int angle, const char *str, int n, i
 }
 
 void Fl_Xlib_Graphics_Driver::drawUCS4(const void *str, int n, int x, int y) {
+  fl_xlib_flush_rect_batch();
 #if USE_OVERLAY
   XftDraw*& draw_ = fl_overlay ? draw_overlay : ::draw_;
   if (fl_overlay) {
@@ -881,6 +1092,8 @@ void Fl_Xlib_Graphics_Driver::rtl_draw_unscaled(const char* c, int n, int x, int
   if (x < clip_min() || x > clip_max()) return;
   if (y < clip_min() || y > clip_max()) return;
 
+  fl_xlib_flush_rect_batch();
+
 #if defined(__GNUC__)
 // FIXME: warning Need to improve this XFT right to left draw function
 #endif /*__GNUC__*/
@@ -1012,9 +1225,20 @@ float Fl_Xlib_Graphics_Driver::scale_bitmap_for_PostScript() {
 Fl_Xlib_Font_Descriptor::~Fl_Xlib_Font_Descriptor() {
   if (this == fl_graphics_driver->font_descriptor()) fl_graphics_driver->font_descriptor(NULL);
   //  XftFontClose(fl_display, font);
-#if USE_PANGO
+#if USE_XFT
   if (width) for (int i = 0; i < 64; i++) delete[] width[i];
   delete[] width;
+#  if !USE_PANGO && !defined(__CYGWIN__)
+  if (runs) {
+    for (int i = 0; i < GLYPH_RUN_SLOTS; i++) {
+      if (runs[i]) {
+        delete[] runs[i]->specs;
+        delete runs[i];
+      }
+    }
+    delete[] runs;
+  }
+#  endif
 #endif
 }
 
@@ -1040,7 +1264,9 @@ static void fl_xft_font(Fl_Xlib_Graphics_Driver *driver, Fl_Font fnum, Fl_Fontsi
   driver->Fl_Graphics_Driver::font(fnum, size);
   Fl_Fontdesc *font = fl_fonts + fnum;
   // search the fontsizes we have generated already
-  for (f = (Fl_Xlib_Font_Descriptor*)font->first; f; f = (Fl_Xlib_Font_Descriptor*)f->next) {
+  Fl_Xlib_Font_Descriptor *prev = NULL;
+  for (f = (Fl_Xlib_Font_Descriptor*)font->first; f;
+       prev = f, f = (Fl_Xlib_Font_Descriptor*)f->next) {
     if (f->size == size && f->angle == angle)// && !strcasecmp(f->encoding, fl_encoding_))
       break;
   }
@@ -1048,6 +1274,12 @@ static void fl_xft_font(Fl_Xlib_Graphics_Driver *driver, Fl_Font fnum, Fl_Fontsi
     f = new Fl_Xlib_Font_Descriptor(font->name, size, angle);
     f->next = font->first;
     font->first = f;
+  } else if (prev) {
+    // move the hit to the front: redraw cycles spanning screens of
+    // different scales alternate between a few sizes of the same face
+    prev->next = f->next;
+    f->next = font->first;
+    font->first = f;
   }
   driver->font_descriptor(f);
 #if XFT_MAJOR < 2 && ! USE_PANGO
@@ -1299,6 +1531,7 @@ static void fl_pango_layout_get_pixel_extents(PangoLayout *layout, int &dx, int
 }
 
 void Fl_Xlib_Graphics_Driver::do_draw(int from_right, const char *str, int n, int x, int y) {
+  fl_xlib_flush_rect_batch();
   if (!fl_display || n == 0) return;
   Region region = clip_region();
   if (region && XEmptyRegion(region)) return;
@@ -1448,6 +1681,11 @@ Fl_Font Fl_Xlib_Graphics_Driver::set_fonts(const char* pattern_name)
   PangoFontFamily **families;
   Fl_Xlib_Graphics_Driver::context();
   Fl_Xlib_Graphics_Driver::init_built_in_fonts();
+  // Load the stored font list if it is still current, and skip the scan
+  char signature[128];
+  font_cache_signature(signature, sizeof(signature));
+  count = font_cache_load(signature);
+  if (count) return FL_FREE_FONT + count;
   pango_font_map_list_families(Fl_Xlib_Graphics_Driver::pfmap_, &families, &n_families);
   for (int fam = 0; fam < n_families; fam++) {
     PangoFontFace **faces;
@@ -1468,6 +1706,8 @@ Fl_Font Fl_Xlib_Graphics_Driver::set_fonts(const char* pattern_name)
   /*g_*/free(families);
   // Sort the list into alphabetic order
   qsort(fl_fonts + FL_FREE_FONT, count, sizeof(Fl_Fontdesc), (sort_f_type)font_sort);
+  // Keep the list for later runs, it is costly to compute
+  font_cache_save(signature, count);
   return FL_FREE_FONT + count;
 }
 
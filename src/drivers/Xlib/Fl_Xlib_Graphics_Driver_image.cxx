@@ -57,6 +57,11 @@
 #if HAVE_XRENDER
 #include <X11/extensions/Xrender.h>
 #endif
+#if HAVE_XSHM
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+#  include <X11/extensions/XShm.h>
+#endif
 
 static XImage xi;       // template used to pass info to X
 static int bytes_per_pixel;
@@ -319,6 +324,15 @@ static void xrgb_converter(const uchar *from, uchar *to, int w, int delta) {
 }
 
 static void argb_premul_converter(const uchar *from, uchar *to, int w, int delta) {
+  if (delta == 4) { // contiguous RGBA: the constant stride lets the compiler
+                    // unroll and vectorize the premultiplication
+    const int delta = 4;
+    INNARDS32((unsigned(from[3]) << 24) +
+               (((from[0] * from[3]) / 255) << 16) +
+               (((from[1] * from[3]) / 255) << 8) +
+               ((from[2] * from[3]) / 255));
+    return;
+  }
   INNARDS32((unsigned(from[3]) << 24) +
              (((from[0] * from[3]) / 255) << 16) +
              (((from[1] * from[3]) / 255) << 8) +
@@ -465,6 +479,74 @@ static void figure_out_visual() {
 
 #  define MAXBUFFER 0x40000 // 256k
 
+#if HAVE_XSHM
+#  define MAXSHMBUFFER 0x4000000 // 64 MB
+
+// One shared memory segment reused for all image draws: the converted
+// pixels are written here and XShmPutImage() hands the server the segment
+// instead of pushing the pixel data through the connection.
+static XShmSegmentInfo img_shm_info;
+static size_t img_shm_size = 0;
+static int img_shm_state = 0;   // 0 = untested, 1 = usable, -1 = unusable
+static int img_shm_error;
+
+extern "C" {
+  static int imgshmerrhandler(Display *display, XErrorEvent *error) {
+    img_shm_error = 1;
+    return 0;
+  }
+}
+
+// Returns a buffer of at least the given size shared with the server, or
+// NULL when MIT-SHM can't be used; the one cached segment grows on demand.
+static char *img_shm_buffer(size_t needed) {
+  if (needed > MAXSHMBUFFER) return NULL;
+  if (img_shm_state < 0) return NULL;
+  if (img_shm_state == 0) {
+    int major, minor;
+    Bool pixmaps;
+    if (!XShmQueryVersion(fl_display, &major, &minor, &pixmaps)) {
+      img_shm_state = -1;
+      return NULL;
+    }
+    img_shm_state = 1;
+  }
+  if (needed <= img_shm_size) return img_shm_info.shmaddr;
+  if (img_shm_size) {
+    XShmDetach(fl_display, &img_shm_info);
+    shmdt(img_shm_info.shmaddr);
+    img_shm_size = 0;
+  }
+  img_shm_info.shmid = shmget(IPC_PRIVATE, needed, IPC_CREAT | 0600);
+  if (img_shm_info.shmid < 0) {
+    img_shm_state = -1;
+    return NULL;
+  }
+  img_shm_info.shmaddr = (char *)shmat(img_shm_info.shmid, 0, 0);
+  img_shm_info.readOnly = True;
+  if (img_shm_info.shmaddr == (char *)-1) {
+    shmctl(img_shm_info.shmid, IPC_RMID, 0);
+    img_shm_state = -1;
+    return NULL;
+  }
+  img_shm_error = 0;
+  XErrorHandler old_handler = XSetErrorHandler(imgshmerrhandler);
+  XShmAttach(fl_display, &img_shm_info);
+  XSync(fl_display, False);
+  XSetErrorHandler(old_handler);
+  // mark the segment for removal once the last user detaches, so it can't
+  // outlive the process even on abnormal termination
+  shmctl(img_shm_info.shmid, IPC_RMID, 0);
+  if (img_shm_error) { // attach failed: the display is likely remote
+    shmdt(img_shm_info.shmaddr);
+    img_shm_state = -1;
+    return NULL;
+  }
+  img_shm_size = needed;
+  return img_shm_info.shmaddr;
+}
+#endif // HAVE_XSHM
+
 static void innards(const uchar *buf, int X, int Y, int W, int H,
                     int delta, int linedelta, int mono,
                     Fl_Draw_Image_Cb cb, void* userdata,
@@ -475,6 +557,7 @@ static void innards(const uchar *buf, int X, int Y, int W, int H,
   int dx = 0, dy = 0, w = 0, h = 0;
   fl_clip_box(X, Y, W, H, dx, dy, w, h);
   if (w<=0 || h<=0) return;
+  fl_xlib_flush_rect_batch();
   dx -= X;
   dy -= Y;
   if (!bytes_per_pixel) figure_out_visual();
@@ -526,40 +609,68 @@ static void innards(const uchar *buf, int X, int Y, int W, int H,
     int blocking = h;
     static STORETYPE *buffer;   // our storage, always word aligned
     static long buffer_size;
-    {int size = linesize*h;
-    if (size > MAXBUFFER) {
-      size = MAXBUFFER;
-      blocking = MAXBUFFER/linesize;
+    STORETYPE *dest = NULL;
+#if HAVE_XSHM
+    // try to convert into a segment shared with the server: the whole image
+    // is then blitted with one XShmPutImage and no pixel traffic through
+    // the X connection
+    int use_shm = 0;
+    dest = (STORETYPE *)img_shm_buffer((size_t)linesize * h * sizeof(STORETYPE));
+    if (dest) use_shm = 1;
+#endif
+    if (!dest) {
+      {int size = linesize*h;
+      if (size > MAXBUFFER) {
+        size = MAXBUFFER;
+        blocking = MAXBUFFER/linesize;
+      }
+      if (size > buffer_size) {
+        delete[] buffer;
+        buffer_size = size;
+        buffer = new STORETYPE[size];
+      }}
+      dest = buffer;
     }
-    if (size > buffer_size) {
-      delete[] buffer;
-      buffer_size = size;
-      buffer = new STORETYPE[size];
-    }}
-    xi.data = (char *)buffer;
+    xi.data = (char *)dest;
     xi.bytes_per_line = linesize*sizeof(STORETYPE);
     if (buf) {
       buf += delta*dx+linedelta*dy;
       for (int j=0; j<h; ) {
-        STORETYPE *to = buffer;
+        STORETYPE *to = dest;
         int k;
         for (k = 0; j<h && k<blocking; k++, j++) {
           conv(buf, (uchar*)to, w, delta);
           buf += linedelta;
           to += linesize;
         }
+#if HAVE_XSHM
+        if (use_shm) {
+          xi.obdata = (char *)&img_shm_info; // XShmPutImage() finds the segment here
+          XShmPutImage(fl_display, fl_window, gc, &xi, 0, 0, X+dx, Y+dy+j-k, w, k, False);
+          XSync(fl_display, False); // the segment is reused by the next draw
+          xi.obdata = NULL;
+        } else
+#endif
         XPutImage(fl_display,fl_window,gc, &xi, 0, 0, X+dx, Y+dy+j-k, w, k);
       }
     } else {
       STORETYPE* linebuf = new STORETYPE[(W*delta+(sizeof(STORETYPE)-1))/sizeof(STORETYPE)];
       for (int j=0; j<h; ) {
-        STORETYPE *to = buffer;
+        STORETYPE *to = dest;
         int k;
         for (k = 0; j<h && k<blocking; k++, j++) {
           cb(userdata, dx, dy+j, w, (uchar*)linebuf);
           conv((uchar*)linebuf, (uchar*)to, w, delta);
           to += linesize;
         }
+#if HAVE_XSHM
+        if (use_shm) {
+          xi.obdata = (char *)&img_shm_info;
+          XShmPutImage(fl_display, fl_window, gc, &xi, 0, 0, X+dx, Y+dy+j-k, w, k, False);
+          XSync(fl_display, False);
+          xi.obdata = NULL;
+        } else
+#endif
         XPutImage(fl_display,fl_window,gc, &xi, 0, 0, X+dx, Y+dy+j-k, w, k);
       }
 
@@ -627,6 +738,7 @@ void Fl_Xlib_Graphics_Driver::draw_fixed(Fl_Bitmap *bm, int X, int Y, int W, int
   Y = floor(Y)+floor(offset_y_);
   cache_size(bm, W, H);
   cx *= scale(); cy *= scale();
+  fl_xlib_flush_rect_batch();
   XSetStipple(fl_display, gc_, *Fl_Graphics_Driver::id(bm));
   int ox = X-cx; if (ox < 0) ox += bm->w()*scale();
   int oy = Y-cy; if (oy < 0) oy += bm->h()*scale();
@@ -637,9 +749,77 @@ void Fl_Xlib_Graphics_Driver::draw_fixed(Fl_Bitmap *bm, int X, int Y, int W, int
 }
 
 
+////////////////////////////////////////////////////////////////
+// Idle-time premultiplication cache for un-accelerated alpha compositing.
+//
+// Without XRender, every draw of an image with alpha goes through
+// alpha_blend() below, which multiplies each source channel by its alpha
+// on every draw. After an image has been drawn once this way, it is
+// queued for conversion to a premultiplied copy on the low-priority idle
+// tier; subsequent draws of the same image then blend with a single
+// multiply per channel. The copy is dropped from uncache(), which the
+// image calls when its data changes or it is deleted.
+
+struct premul_cache {
+  Fl_RGB_Image *img;
+  uchar *data;          // premultiplied copy, NULL while still queued
+  premul_cache *next;
+};
+static premul_cache *premul_first = NULL;
+
+static premul_cache *premul_find(Fl_RGB_Image *img) {
+  for (premul_cache *p = premul_first; p; p = p->next)
+    if (p->img == img) return p;
+  return NULL;
+}
+
+// converts one queued image per call, then removes itself
+static void premul_idle_cb(void *) {
+  for (premul_cache *p = premul_first; p; p = p->next) {
+    if (p->data) continue;
+    Fl_RGB_Image *img = p->img;
+    int d = img->d();
+    int ld = img->ld();
+    if (!ld) ld = img->data_w() * d;
+    uchar *out = new uchar[(size_t)img->data_w() * d * img->data_h()];
+    uchar *to = out;
+    for (int y = 0; y < img->data_h(); y++) {
+      const uchar *from = (const uchar*)img->array + y * ld;
+      if (d == 2) {
+        for (int x = img->data_w(); x > 0; x--, from += 2) {
+          *to++ = (from[0] * from[1] + 127) / 255;
+          *to++ = from[1];
+        }
+      } else {
+        for (int x = img->data_w(); x > 0; x--, from += 4) {
+          *to++ = (from[0] * from[3] + 127) / 255;
+          *to++ = (from[1] * from[3] + 127) / 255;
+          *to++ = (from[2] * from[3] + 127) / 255;
+          *to++ = from[3];
+        }
+      }
+    }
+    p->data = out;
+    return;
+  }
+  Fl::remove_idle(premul_idle_cb, NULL); // queue drained
+}
+
+static void premul_forget(Fl_RGB_Image *img) {
+  premul_cache **pp = &premul_first;
+  while (*pp && (*pp)->img != img) pp = &(*pp)->next;
+  if (*pp) {
+    premul_cache *p = *pp;
+    *pp = p->next;
+    if (p->data) delete[] p->data;
+    delete p;
+  }
+}
+
 // Composite an image with alpha on systems that don't have accelerated
 // alpha compositing...
 static void alpha_blend(Fl_RGB_Image *img, int X, int Y, int W, int H, int cx, int cy) {
+  fl_xlib_flush_rect_batch(); // about to read the drawable back
   if (cx < 0) { W += cx; X -= cx; cx = 0; }
   if (cy < 0) { H += cy; Y -= cy; cy = 0; }
   if (W + cx > img->data_w()) W = img->data_w() - cx;
@@ -659,24 +839,114 @@ static void alpha_blend(Fl_RGB_Image *img, int X, int Y, int W, int H, int cx, i
   if (ld == 0) ld = img->data_w() * img->d();
   uchar *srcptr = (uchar*)img->array + cy * ld + cx * img->d();
 
+  // queue the image for idle-time premultiplication on its first draw, and
+  // composite from the premultiplied copy once the conversion has run
+  premul_cache *pc = premul_find(img);
+  if (!pc) {
+    pc = new premul_cache;
+    pc->img = img;
+    pc->data = NULL;
+    pc->next = premul_first;
+    premul_first = pc;
+    if (!Fl::has_idle(premul_idle_cb, NULL)) Fl::add_idle_low(premul_idle_cb, NULL);
+  }
   uchar *dst = fl_read_image(NULL, X, Y, W, H, 0);
   if (!dst) {
     fl_draw_image(srcptr, X, Y, W, H, img->d(), ld);
     return;
   }
+  if (pc->data) {
+    ld = img->data_w() * img->d(); // the copy is stored without row padding
+    srcptr = pc->data + cy * ld + cx * img->d();
+  }
   int srcskip = ld - img->d() * W;
   uchar *dstptr = dst;
 
   uchar srcr, srcg, srcb, srca;
   uchar dstr, dstg, dstb, dsta;
 
-  if (img->d() == 2) {
+  // Most real-world overlays are dominated by fully transparent and fully
+  // opaque pixels: handle those without any blending arithmetic and leave
+  // the multiply-and-shift only for the truly translucent remainder.
+
+  if (pc->data && img->d() == 2) {
+    // Composite premultiplied grayscale + alpha over RGB...
+    for (int y = H; y > 0; y--, srcptr+=srcskip)
+      for (int x = W; x > 0; x--) {
+        srcg = *srcptr++;           // already multiplied by alpha
+        srca = *srcptr++;
+
+        if (srca == 0) {            // fully transparent: keep the background
+          dstptr += 3;
+          continue;
+        }
+        if (srca == 255) {          // fully opaque: copy the source
+          *dstptr++ = srcg;
+          *dstptr++ = srcg;
+          *dstptr++ = srcg;
+          continue;
+        }
+
+        dstr = dstptr[0];
+        dstg = dstptr[1];
+        dstb = dstptr[2];
+        dsta = 255 - srca;
+
+        *dstptr++ = srcg + ((dstr * dsta) >> 8);
+        *dstptr++ = srcg + ((dstg * dsta) >> 8);
+        *dstptr++ = srcg + ((dstb * dsta) >> 8);
+      }
+  } else if (pc->data) {
+    // Composite premultiplied RGBA over RGB...
+    for (int y = H; y > 0; y--, srcptr+=srcskip)
+      for (int x = W; x > 0; x--) {
+        srca = srcptr[3];
+
+        if (srca == 0) {            // fully transparent: keep the background
+          srcptr += 4;
+          dstptr += 3;
+          continue;
+        }
+        if (srca == 255) {          // fully opaque: copy the source
+          *dstptr++ = *srcptr++;
+          *dstptr++ = *srcptr++;
+          *dstptr++ = *srcptr++;
+          srcptr++;
+          continue;
+        }
+
+        srcr = *srcptr++;           // already multiplied by alpha
+        srcg = *srcptr++;
+        srcb = *srcptr++;
+        srcptr++;
+
+        dstr = dstptr[0];
+        dstg = dstptr[1];
+        dstb = dstptr[2];
+        dsta = 255 - srca;
+
+        *dstptr++ = srcr + ((dstr * dsta) >> 8);
+        *dstptr++ = srcg + ((dstg * dsta) >> 8);
+        *dstptr++ = srcb + ((dstb * dsta) >> 8);
+      }
+  } else if (img->d() == 2) {
     // Composite grayscale + alpha over RGB...
     for (int y = H; y > 0; y--, srcptr+=srcskip)
       for (int x = W; x > 0; x--) {
         srcg = *srcptr++;
         srca = *srcptr++;
 
+        if (srca == 0) {            // fully transparent: keep the background
+          dstptr += 3;
+          continue;
+        }
+        if (srca == 255) {          // fully opaque: copy the source
+          *dstptr++ = srcg;
+          *dstptr++ = srcg;
+          *dstptr++ = srcg;
+          continue;
+        }
+
         dstr = dstptr[0];
         dstg = dstptr[1];
         dstb = dstptr[2];
@@ -690,10 +960,25 @@ static void alpha_blend(Fl_RGB_Image *img, int X, int Y, int W, int H, int cx, i
     // Composite RGBA over RGB...
     for (int y = H; y > 0; y--, srcptr+=srcskip)
       for (int x = W; x > 0; x--) {
+        srca = srcptr[3];
+
+        if (srca == 0) {            // fully transparent: keep the background
+          srcptr += 4;
+          dstptr += 3;
+          continue;
+        }
+        if (srca == 255) {          // fully opaque: copy the source
+          *dstptr++ = *srcptr++;
+          *dstptr++ = *srcptr++;
+          *dstptr++ = *srcptr++;
+          srcptr++;
+          continue;
+        }
+
         srcr = *srcptr++;
         srcg = *srcptr++;
         srcb = *srcptr++;
-        srca = *srcptr++;
+        srcptr++;
 
         dstr = dstptr[0];
         dstg = dstptr[1];
@@ -741,6 +1026,7 @@ void Fl_Xlib_Graphics_Driver::draw_fixed(Fl_RGB_Image *img, int X, int Y, int W,
   Y = floor(Y)+floor(offset_y_);
   cache_size(img, W, H);
   cx *= scale(); cy *= scale();
+  fl_xlib_flush_rect_batch();
   if (img->d() == 1 || img->d() == 3) {
     XCopyArea(fl_display, *Fl_Graphics_Driver::id(img), fl_window, gc_, cx, cy, W, H, X, Y);
     return;
@@ -772,6 +1058,8 @@ void Fl_Xlib_Graphics_Driver::draw_rgb(Fl_RGB_Image *rgb, int XP, int YP, int WP
   if (!*Fl_Graphics_Driver::id(rgb)) {
     cache(rgb);
   }
+  extern void fl_image_cache_note_draw(Fl_Image *, size_t); // in Fl_Graphics_Driver.cxx
+  fl_image_cache_note_draw(rgb, (size_t)rgb->data_w() * rgb->data_h() * 4);
   push_clip(XP, YP, WP, HP);
   int Wfull = rgb->w(), Hfull = rgb->h(), offset = 0;
   cache_size(rgb, Wfull, Hfull);
@@ -784,21 +1072,84 @@ void Fl_Xlib_Graphics_Driver::draw_rgb(Fl_RGB_Image *rgb, int XP, int YP, int WP
   scale_and_render_pixmap( *Fl_Graphics_Driver::id(rgb), rgb->d(),
                           rgb->data_w() / double(Wfull), rgb->data_h() / double(Hfull),
                           floor(XP-cx) + floor(offset_x_) - offset, floor(YP-cy) + floor(offset_y_) - offset,
-                          Wfull, Hfull);
+                          Wfull, Hfull,
+                          Fl_Graphics_Driver::mask(rgb)); // keep the source Picture across draws
   pop_clip();
 }
 
+// Draws count copies of one unscaled image through a single source/destination
+// Picture pair and one clip setup, instead of a full draw pipeline pass per
+// copy. Scaled images and other image types fall back to the generic loop.
+void Fl_Xlib_Graphics_Driver::draw_image_batch(Fl_Image *img, const int *xy_pairs, int count) {
+  Fl_RGB_Image *rgb = img ? img->as_rgb_image() : NULL;
+  if (!rgb || count <= 0 || !fl_can_do_alpha_blending() || scale() != 1 ||
+      rgb->w() != rgb->data_w() || rgb->h() != rgb->data_h()) {
+    Fl_Graphics_Driver::draw_image_batch(img, xy_pairs, count);
+    return;
+  }
+  if (!*Fl_Graphics_Driver::id(rgb)) cache(rgb);
+  if (!*Fl_Graphics_Driver::id(rgb)) {
+    Fl_Graphics_Driver::draw_image_batch(img, xy_pairs, count);
+    return;
+  }
+  extern void fl_image_cache_note_draw(Fl_Image *, size_t); // in Fl_Graphics_Driver.cxx
+  fl_image_cache_note_draw(rgb, (size_t)rgb->data_w() * rgb->data_h() * 4);
+  int W = rgb->w(), H = rgb->h();
+  fl_xlib_flush_rect_batch();
+  bool has_alpha = (rgb->d() == 2 || rgb->d() == 4);
+  XRenderPictureAttributes srcattr;
+  memset(&srcattr, 0, sizeof(XRenderPictureAttributes));
+  static XRenderPictFormat *fmt24 = XRenderFindStandardFormat(fl_display, PictStandardRGB24);
+  static XRenderPictFormat *fmt32 = XRenderFindStandardFormat(fl_display, PictStandardARGB32);
+  static XRenderPictFormat *dstfmt = XRenderFindVisualFormat(fl_display, fl_visual->visual);
+  fl_uintptr_t *cached_src = Fl_Graphics_Driver::mask(rgb); // as in scale_and_render_pixmap()
+  Picture src = (Picture)*cached_src;
+  if (!src) {
+    src = XRenderCreatePicture(fl_display, *Fl_Graphics_Driver::id(rgb),
+                               has_alpha ? fmt32 : fmt24, 0, &srcattr);
+    *cached_src = (fl_uintptr_t)src;
+  }
+  Picture dst = XRenderCreatePicture(fl_display, fl_window, dstfmt, 0, &srcattr);
+  if (!src || !dst) {
+    fprintf(stderr, "Failed to create Render pictures (%lu %lu)\n", src, dst);
+    return;
+  }
+  if (clip_region())
+    XRenderSetPictureClipRegion(fl_display, dst, clip_region());
+  for (int i = 0; i < count; i++) {
+    int X = floor(xy_pairs[2*i]) + floor(offset_x_);
+    int Y = floor(xy_pairs[2*i+1]) + floor(offset_y_);
+    if (!not_clipped(X, Y, W, H)) continue;
+    XRenderComposite(fl_display, (has_alpha ? PictOpOver : PictOpSrc), src, None, dst,
+                     0, 0, 0, 0, X, Y, W, H);
+  }
+  XRenderFreePicture(fl_display, dst);
+}
+
 /* Draws with Xrender an Fl_Offscreen with optional scaling and accounting for transparency if necessary.
  XP,YP,WP,HP are in drawing units
+ If cached_src is non-NULL, the source Picture is kept there across calls, so
+ repeated draws of the same cached image reuse one server-side Picture instead
+ of creating and destroying one per draw. The cached Picture is freed together
+ with the image's offscreen in uncache().
  */
-int Fl_Xlib_Graphics_Driver::scale_and_render_pixmap(Fl_Offscreen pixmap, int depth, double scale_x, double scale_y, int XP, int YP, int WP, int HP) {
+int Fl_Xlib_Graphics_Driver::scale_and_render_pixmap(Fl_Offscreen pixmap, int depth, double scale_x, double scale_y, int XP, int YP, int WP, int HP, fl_uintptr_t *cached_src) {
+  fl_xlib_flush_rect_batch();
   bool has_alpha = (depth == 2 || depth == 4);
   XRenderPictureAttributes srcattr;
   memset(&srcattr, 0, sizeof(XRenderPictureAttributes));
   static XRenderPictFormat *fmt24 = XRenderFindStandardFormat(fl_display, PictStandardRGB24);
   static XRenderPictFormat *fmt32 = XRenderFindStandardFormat(fl_display, PictStandardARGB32);
   static XRenderPictFormat *dstfmt = XRenderFindVisualFormat(fl_display, fl_visual->visual);
-  Picture src = XRenderCreatePicture(fl_display, pixmap, has_alpha ?fmt32:fmt24, 0, &srcattr);
+  // A transform or filter set below would stick to a persistent Picture, so
+  // only unscaled draws — the common case for icons and toolbars — reuse it;
+  // scaled draws keep using a temporary Picture.
+  bool persistent = cached_src && scale_x == 1 && scale_y == 1;
+  Picture src = persistent ? (Picture)*cached_src : 0;
+  if (!src) {
+    src = XRenderCreatePicture(fl_display, pixmap, has_alpha ?fmt32:fmt24, 0, &srcattr);
+    if (persistent) *cached_src = (fl_uintptr_t)src;
+  }
   Picture dst = XRenderCreatePicture(fl_display, fl_window, dstfmt, 0, &srcattr);
   if (!src || !dst) {
     fprintf(stderr, "Failed to create Render pictures (%lu %lu)\n", src, dst);
@@ -828,15 +1179,22 @@ int Fl_Xlib_Graphics_Driver::scale_and_render_pixmap(Fl_Offscreen pixmap, int de
   }
   XRenderComposite(fl_display, (has_alpha ? PictOpOver : PictOpSrc), src, None, dst, 0, 0, 0, 0,
                    XP, YP, WP, HP);
-  XRenderFreePicture(fl_display, src);
+  if (!persistent) XRenderFreePicture(fl_display, src);
   XRenderFreePicture(fl_display, dst);
   return 1;
 }
 
 #endif // HAVE_XRENDER
 
-void Fl_Xlib_Graphics_Driver::uncache(Fl_RGB_Image*, fl_uintptr_t &id_, fl_uintptr_t &mask_)
+void Fl_Xlib_Graphics_Driver::uncache(Fl_RGB_Image *img, fl_uintptr_t &id_, fl_uintptr_t &mask_)
 {
+  premul_forget(img);
+#if HAVE_XRENDER
+  if (mask_) { // the persistent XRender Picture attached to the offscreen
+    XRenderFreePicture(fl_display, (Picture)mask_);
+    mask_ = 0;
+  }
+#endif
   if (id_) {
     XFreePixmap(fl_display, (Fl_Offscreen)id_);
     id_ = 0;
@@ -856,6 +1214,7 @@ void Fl_Xlib_Graphics_Driver::draw_fixed(Fl_Pixmap *pxm, int X, int Y, int W, in
   Y = floor(Y)+floor(offset_y_);
   cache_size(pxm, W, H);
   cx *= scale(); cy *= scale();
+  fl_xlib_flush_rect_batch();
   Fl_Region r2 = scale_clip(scale());
   if (*Fl_Graphics_Driver::mask(pxm)) {
     // make X use the bitmap as a mask:
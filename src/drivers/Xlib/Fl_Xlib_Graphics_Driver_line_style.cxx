@@ -26,8 +26,33 @@
 
 #include "Fl_Xlib_Graphics_Driver.H"
 
+// Shadow of the line style last applied to the GC, so the defensive
+// fl_line_style() resets widgets issue constantly are no-ops when the
+// style is already in effect. The shadow is dropped whenever the GC is
+// (re)assigned or its line width is changed behind our back.
+static GC style_gc = None;
+static int style_style;
+static int style_width;
+static char style_dashes[16];
+
+void fl_xlib_forget_line_style() {
+  style_gc = None;
+}
+
 void Fl_Xlib_Graphics_Driver::line_style_unscaled(int style, int width, char* dashes) {
 
+  const char *key_dashes = dashes ? dashes : "";
+  if (gc_ == style_gc && style == style_style && width == style_width &&
+      strcmp(key_dashes, style_dashes) == 0)
+    return;
+  if (gc_ && strlen(key_dashes) < sizeof(style_dashes)) {
+    style_gc = gc_;
+    style_style = style;
+    style_width = width;
+    strcpy(style_dashes, key_dashes);
+  } else
+    style_gc = None; // dash pattern too long to shadow
+
   int ndashes = dashes ? strlen(dashes) : 0;
   // emulate the Windows dash patterns on X
   char buf[7];
@@ -63,6 +88,7 @@ if (*dashes == 0) ndashes = 0;//against error with very small scaling
 }
 
 void *Fl_Xlib_Graphics_Driver::change_pen_width(int lwidth) {
+  style_gc = None; // the GC's line width no longer matches the shadow
   XGCValues *gc_values = (XGCValues*)malloc(sizeof(XGCValues));
   gc_values->line_width = lwidth;
   XChangeGC(fl_display, gc_, GCLineWidth, gc_values);
@@ -72,6 +98,7 @@ void *Fl_Xlib_Graphics_Driver::change_pen_width(int lwidth) {
 }
 
 void Fl_Xlib_Graphics_Driver::reset_pen_width(void *data) {
+  style_gc = None;
   XGCValues *gc_values = (XGCValues*)data;
   line_width_ = gc_values->line_width;
   XChangeGC(fl_display, gc_, GCLineWidth, gc_values);
@@ -26,6 +26,9 @@
 #include <FL/platform.H>
 
 #include "Fl_Xlib_Graphics_Driver.H"
+#if HAVE_XRENDER
+#include <X11/extensions/Xrender.h>
+#endif
 
 // Arbitrary line clipping: clip line end points to 16-bit coordinate range.
 
@@ -189,21 +192,49 @@ int Fl_Xlib_Graphics_Driver::clip_rect(int &x, int &y, int &w, int &h) {
 // Missing X call: (is this the fastest way to init a 1-rectangle region?)
 // Windows equivalent exists, implemented inline in win32.H
 
+// Clip regions are created and destroyed once or more per widget per
+// redraw, so destroyed regions go to a small pool and are refilled on the
+// next XRectangleRegion() instead of cycling through Xlib's allocator -
+// reuse also keeps each region's internal rectangle buffer. The pooled
+// stale content is simply overwritten, since the region operations treat
+// their destination as a pure output.
+
+#define REGION_POOL_SIZE 16
+static Fl_Region region_pool[REGION_POOL_SIZE];
+static int region_pool_n = 0;
+
+extern Fl_Perf_Counters fl_perf_counters; // in Fl.cxx
+
+static Fl_Region region_from_pool() {
+  if (region_pool_n) {
+    fl_perf_counters.pool_reuses++;
+    return region_pool[--region_pool_n];
+  }
+  fl_perf_counters.pool_allocs++;
+  return 0;
+}
+
 // Note: if the entire region is outside the 16-bit X coordinate space an empty
 // clipping region is returned which means that *nothing* will be visible.
 
 Fl_Region Fl_Xlib_Graphics_Driver::XRectangleRegion(int x, int y, int w, int h) {
+  static Fl_Region empty = XCreateRegion(); // stays empty for the writes below
   XRectangle R;
-  Fl_Region r = XCreateRegion(); // create an empty region
-  if (clip_rect(x, y, w, h))     // outside valid coordinate space
-    return r;                    // empty region
+  Fl_Region r = region_from_pool();
+  if (clip_rect(x, y, w, h)) {   // outside valid coordinate space
+    if (!r) return XCreateRegion();
+    XIntersectRegion(empty, empty, r); // write an empty result over the stale content
+    return r;
+  }
+  if (!r) r = XCreateRegion();
   R.x = x; R.y = y; R.width = w; R.height = h;
-  XUnionRectWithRegion(&R, r, r);
+  XUnionRectWithRegion(&R, empty, r);
   return r;
 }
 
 void Fl_Xlib_Graphics_Driver::XDestroyRegion(Fl_Region r) {
-  ::XDestroyRegion(r);
+  if (region_pool_n < REGION_POOL_SIZE) region_pool[region_pool_n++] = r;
+  else ::XDestroyRegion(r);
 }
 
 // --- line and polygon drawing
@@ -215,19 +246,107 @@ void Fl_Xlib_Graphics_Driver::focus_rect(int x, int y, int w, int h)
   x = this->floor(x) + floor(offset_x_);
   y = this->floor(y) + floor(offset_y_);
   if (!clip_rect(x, y, w, h)) {
+    fl_xlib_flush_rect_batch();
     line_style(FL_DOT);
     XDrawRectangle(fl_display, fl_window, gc_, x, y, w, h);
     line_style(FL_SOLID);
   }
 }
 
+// --- batched rectangle fills
+//
+// rectf_unscaled() defers its fills here, so a run of fills issued with no
+// other drawing in between - typical when box drawing paints many flat
+// boxes per flush - reaches the server as one XFillRectangles request
+// instead of one request per rectangle. Every other drawing or GC-changing
+// operation of this driver calls fl_xlib_flush_rect_batch() before its own
+// X request, which keeps the deferral invisible to callers. The GC and
+// drawable are remembered at append time so a pending run is still
+// submitted correctly when it is flushed after a context switch.
+
+#define RECT_BATCH_SIZE 64
+static XRectangle rect_batch[RECT_BATCH_SIZE];
+static int rect_batch_n = 0;
+static GC rect_batch_gc;
+static Window rect_batch_win;
+
+void fl_xlib_flush_rect_batch() {
+  if (!rect_batch_n) return;
+  int n = rect_batch_n;
+  rect_batch_n = 0;
+  if (n == 1)
+    XFillRectangle(fl_display, rect_batch_win, rect_batch_gc,
+                   rect_batch[0].x, rect_batch[0].y, rect_batch[0].width, rect_batch[0].height);
+  else
+    XFillRectangles(fl_display, rect_batch_win, rect_batch_gc, rect_batch, n);
+}
+
 void Fl_Xlib_Graphics_Driver::rectf_unscaled(int x, int y, int w, int h) {
   x += floor(offset_x_);
   y += floor(offset_y_);
-  if (!clip_rect(x, y, w, h))
-    XFillRectangle(fl_display, fl_window, gc_, x, y, w, h);
+  if (clip_rect(x, y, w, h)) return;
+  if (rect_batch_n &&
+      (rect_batch_gc != gc_ || rect_batch_win != fl_window || rect_batch_n >= RECT_BATCH_SIZE))
+    fl_xlib_flush_rect_batch();
+  rect_batch[rect_batch_n].x = x;
+  rect_batch[rect_batch_n].y = y;
+  rect_batch[rect_batch_n].width = w;
+  rect_batch[rect_batch_n].height = h;
+  rect_batch_n++;
+  rect_batch_gc = gc_;
+  rect_batch_win = fl_window;
 }
 
+#if HAVE_XRENDER
+// Renders the gradient server-side: the whole shaded area of a themed box
+// becomes one RenderComposite request instead of one line per row/column.
+void Fl_Xlib_Graphics_Driver::gradient_rect(int x, int y, int w, int h, int nstops, const double *pos, const Fl_Color *colors, int horizontal) {
+  if (w <= 0 || h <= 0) return;
+  if (nstops < 2 || nstops > 32 || !fl_can_do_alpha_blending()) {
+    Fl_Graphics_Driver::gradient_rect(x, y, w, h, nstops, pos, colors, horizontal);
+    return;
+  }
+  // compute device coordinates as Fl_Scalable_Graphics_Driver::rectf() does
+  int X = this->floor(x) + this->floor(offset_x_);
+  int Y = this->floor(y) + this->floor(offset_y_);
+  int W = this->floor(x + w) - this->floor(x);
+  int H = this->floor(y + h) - this->floor(y);
+  if (clip_rect(X, Y, W, H)) return;
+  fl_xlib_flush_rect_batch();
+  XLinearGradient grad;
+  grad.p1.x = grad.p1.y = grad.p2.x = grad.p2.y = XDoubleToFixed(0);
+  if (horizontal) grad.p2.x = XDoubleToFixed(W);
+  else grad.p2.y = XDoubleToFixed(H);
+  XFixed stops[32];
+  XRenderColor stop_colors[32];
+  double prev = 0.;
+  for (int i = 0; i < nstops; i++) {
+    double p = pos[i];
+    if (p < prev) p = prev; else if (p > 1.) p = 1.;
+    prev = p;
+    stops[i] = XDoubleToFixed(p);
+    uchar r, g, b;
+    Fl::get_color(colors[i], r, g, b);
+    stop_colors[i].red   = r * 0x101;
+    stop_colors[i].green = g * 0x101;
+    stop_colors[i].blue  = b * 0x101;
+    stop_colors[i].alpha = 0xffff;
+  }
+  Picture src = XRenderCreateLinearGradient(fl_display, &grad, stops, stop_colors, nstops);
+  XRenderPictureAttributes attr; // unused: no attribute mask is passed
+  static XRenderPictFormat *dstfmt = XRenderFindVisualFormat(fl_display, fl_visual->visual);
+  Picture dst = XRenderCreatePicture(fl_display, fl_window, dstfmt, 0, &attr);
+  Fl_Region reg = scale_clip(scale());
+  const Fl_Region clipr = clip_region();
+  if (clipr)
+    XRenderSetPictureClipRegion(fl_display, dst, clipr);
+  unscale_clip(reg);
+  XRenderComposite(fl_display, PictOpSrc, src, None, dst, 0, 0, 0, 0, X, Y, W, H);
+  XRenderFreePicture(fl_display, src);
+  XRenderFreePicture(fl_display, dst);
+}
+#endif // HAVE_XRENDER
+
 void Fl_Xlib_Graphics_Driver::line_unscaled(int x, int y, int x1, int y1) {
    draw_clipped_line(x + this->floor(offset_x_) , y + this->floor(offset_y_) ,
                     x1 + this->floor(offset_x_) , y1 + this->floor(offset_y_) );
@@ -256,6 +375,7 @@ void Fl_Xlib_Graphics_Driver::loop_unscaled(int x, int y, int x1, int y1, int x2
   p[2].x = x2 + floor(offset_x_) ; p[2].y = y2 + floor(offset_y_) ;
   p[3].x = p[0].x;  p[3].y = p[0].y;
   // *FIXME* This needs X coordinate clipping!
+  fl_xlib_flush_rect_batch();
   XDrawLines(fl_display, fl_window, gc_, p, 4, 0);
 }
 
@@ -267,6 +387,7 @@ void Fl_Xlib_Graphics_Driver::loop_unscaled(int x, int y, int x1, int y1, int x2
   p[3].x = x3 + floor(offset_x_) ; p[3].y = y3 + floor(offset_y_) ;
   p[4].x = p[0].x;  p[4].y = p[0].y;
   // *FIXME* This needs X coordinate clipping!
+  fl_xlib_flush_rect_batch();
   XDrawLines(fl_display, fl_window, gc_, p, 5, 0);
 }
 
@@ -277,6 +398,7 @@ void Fl_Xlib_Graphics_Driver::polygon_unscaled(int x, int y, int x1, int y1, int
   p[2].x = x2 + floor(offset_x_) ; p[2].y = y2 + floor(offset_y_) ;
   p[3].x = p[0].x;  p[3].y = p[0].y;
   // *FIXME* This needs X coordinate clipping!
+  fl_xlib_flush_rect_batch();
   XFillPolygon(fl_display, fl_window, gc_, p, 3, Convex, 0);
   XDrawLines(fl_display, fl_window, gc_, p, 4, 0);
 }
@@ -289,6 +411,7 @@ void Fl_Xlib_Graphics_Driver::polygon_unscaled(int x, int y, int x1, int y1, int
   p[3].x = x3 + floor(offset_x_) ; p[3].y = y3 + floor(offset_y_) ;
   p[4].x = p[0].x;  p[4].y = p[0].y;
   // *FIXME* This needs X coordinate clipping!
+  fl_xlib_flush_rect_batch();
   XFillPolygon(fl_display, fl_window, gc_, p, 4, Convex, 0);
   XDrawLines(fl_display, fl_window, gc_, p, 5, 0);
 }
@@ -299,18 +422,39 @@ void Fl_Xlib_Graphics_Driver::polygon_unscaled(int x, int y, int x1, int y1, int
 // This draws nothing if the line is entirely outside the X coordinate space.
 
 void Fl_Xlib_Graphics_Driver::draw_clipped_line(int x1, int y1, int x2, int y2) {
-  if (!clip_line(x1, y1, x2, y2))
+  if (!clip_line(x1, y1, x2, y2)) {
+    fl_xlib_flush_rect_batch();
     XDrawLine(fl_display, fl_window, gc_, x1, y1, x2, y2);
+  }
 }
 
 // --- clipping
 
 void Fl_Xlib_Graphics_Driver::push_clip(int x, int y, int w, int h) {
   Fl_Region r;
+  int is_rect = 0;
   if (w > 0 && h > 0) {
-    r = XRectangleRegion(x, y, w, h); // does X coordinate clipping
     Fl_Region current = rstack[rstackptr];
-    if (current) {
+    if (!current || crstack[rstackptr].valid) {
+      // the current clip is absent or a plain rectangle: the new clip is
+      // again a rectangle, computed without any region operation
+      if (current) { // intersect with the current clip rectangle
+        rect_clip &c = crstack[rstackptr];
+        if (x < c.x) { w -= c.x - x; x = c.x; }
+        if (y < c.y) { h -= c.y - y; y = c.y; }
+        if (x + w > c.x + c.w) w = c.x + c.w - x;
+        if (y + h > c.y + c.h) h = c.y + c.h - y;
+      }
+      if (w > 0 && h > 0) {
+        r = XRectangleRegion(x, y, w, h); // does X coordinate clipping
+        if (clip_rect(x, y, w, h)) w = h = 0; // keep the record in sync
+      } else { // the intersection is empty
+        r = XCreateRegion();
+        w = h = 0;
+      }
+      is_rect = 1;
+    } else {
+      r = XRectangleRegion(x, y, w, h); // does X coordinate clipping
       Fl_Region temp = XCreateRegion();
       XIntersectRegion(current, r, temp);
       XDestroyRegion(r);
@@ -318,8 +462,16 @@ void Fl_Xlib_Graphics_Driver::push_clip(int x, int y, int w, int h) {
     }
   } else { // make empty clip region:
     r = XCreateRegion();
+    is_rect = 1;
+    w = h = 0;
+  }
+  if (rstackptr < region_stack_max) {
+    ++rstackptr;
+    rstack[rstackptr] = r;
+    crstack[rstackptr].valid = (char)is_rect;
+    crstack[rstackptr].x = x; crstack[rstackptr].y = y;
+    crstack[rstackptr].w = w; crstack[rstackptr].h = h;
   }
-  if (rstackptr < region_stack_max) rstack[++rstackptr] = r;
   else Fl::warning("Fl_Xlib_Graphics_Driver::push_clip: clip stack overflow!\n");
   restore_clip();
 }
@@ -328,6 +480,21 @@ int Fl_Xlib_Graphics_Driver::clip_box(int x, int y, int w, int h, int& X, int& Y
   X = x; Y = y; W = w; H = h;
   Fl_Region r = rstack[rstackptr];
   if (!r) return 0;
+  if (crstack[rstackptr].valid) {
+    // the current clip is a plain rectangle: intersect client-side
+    rect_clip &c = crstack[rstackptr];
+    if (x < c.x) { w -= c.x - x; x = c.x; }
+    if (y < c.y) { h -= c.y - y; y = c.y; }
+    if (x + w > c.x + c.w) w = c.x + c.w - x;
+    if (y + h > c.y + c.h) h = c.y + c.h - y;
+    if (w <= 0 || h <= 0) { // completely outside
+      W = H = 0;
+      return 2;
+    }
+    if (x == X && y == Y && w == W && h == H) return 0; // completely inside
+    X = x; Y = y; W = w; H = h;
+    return 1; // partial
+  }
   switch (XRectInRegion(r, x, y, w, h)) {
     case 0: // completely outside
       W = H = 0;
@@ -354,18 +521,61 @@ int Fl_Xlib_Graphics_Driver::not_clipped(int x, int y, int w, int h) {
   if (!r) return 1;
   // get rid of coordinates outside the 16-bit range the X calls take.
   if (clip_rect(x,y,w,h)) return 0;     // clipped
+  if (crstack[rstackptr].valid) {
+    // the current clip is a plain rectangle: answer client-side,
+    // with the same return values as XRectInRegion()
+    rect_clip &c = crstack[rstackptr];
+    if (c.w <= 0 || c.h <= 0) return 0; // empty clip
+    if (x >= c.x + c.w || y >= c.y + c.h || x + w <= c.x || y + h <= c.y)
+      return 0; // completely outside
+    if (x >= c.x && y >= c.y && x + w <= c.x + c.w && y + h <= c.y + c.h)
+      return 1; // completely inside
+    return 2;   // partial
+  }
   return XRectInRegion(r, x, y, w, h);
 }
 
 void Fl_Xlib_Graphics_Driver::restore_clip() {
   fl_clip_state_number++;
   if (gc_) {
+    fl_xlib_flush_rect_batch(); // pending fills use the GC's current clip
     Region r = rstack[rstackptr];
     if (r) {
-      Region r2 = scale_clip(scale());
-      XSetRegion(fl_display, gc_, rstack[rstackptr]);
-      unscale_clip(r2);
+      if (crstack[rstackptr].valid) {
+        // a single rectangle: hand it to X directly and avoid scaling
+        // a full copy of the region in scale_clip()
+        rect_clip &c = crstack[rstackptr];
+        XRectangle rect = {0, 0, 0, 0};
+        int n = 0;
+        if (c.w > 0 && c.h > 0) {
+          float f = scale();
+          int X = this->floor(c.x + offset_x_, f);
+          int Y = this->floor(c.y + offset_y_, f);
+          int W = this->floor(c.x + c.w + offset_x_, f) - X;
+          int H = this->floor(c.y + c.h + offset_y_, f) - Y;
+          if (!clip_rect(X, Y, W, H)) {
+            rect.x = (short)X; rect.y = (short)Y;
+            rect.width = (unsigned short)W; rect.height = (unsigned short)H;
+            n = 1;
+          }
+        }
+        XSetClipRectangles(fl_display, gc_, 0, 0, &rect, n, Unsorted);
+      } else {
+        Region r2 = scale_clip(scale());
+        XSetRegion(fl_display, gc_, rstack[rstackptr]);
+        unscale_clip(r2);
+      }
     }
     else XSetClipMask(fl_display, gc_, 0);
   }
 }
+
+Fl_Region Fl_Xlib_Graphics_Driver::clip_region() {
+  return Fl_Graphics_Driver::clip_region();
+}
+
+void Fl_Xlib_Graphics_Driver::clip_region(Fl_Region r) {
+  // an arbitrary region replaces the top of the stack
+  crstack[rstackptr].valid = 0;
+  Fl_Graphics_Driver::clip_region(r);
+}
@@ -26,9 +26,11 @@
 #include <FL/fl_draw.H>
 #include <FL/platform.H>
 #include <FL/math.h>
+#include <stdlib.h>
 
 
 void Fl_Xlib_Graphics_Driver::end_points() {
+  if (n>1) fl_xlib_flush_rect_batch();
   if (n>1) XDrawPoints(fl_display, fl_window, gc_, (XPoint*)p, n, 0);
 }
 
@@ -37,7 +39,10 @@ void Fl_Xlib_Graphics_Driver::end_line() {
     end_points();
     return;
   }
-  if (n>1) XDrawLines(fl_display, fl_window, gc_, (XPoint*)p, n, 0);
+  if (n>1) {
+    fl_xlib_flush_rect_batch();
+    XDrawLines(fl_display, fl_window, gc_, (XPoint*)p, n, 0);
+  }
 }
 
 void Fl_Xlib_Graphics_Driver::end_loop() {
@@ -54,7 +59,10 @@ void Fl_Xlib_Graphics_Driver::end_polygon() {
     end_line();
     return;
   }
-  if (n>2) XFillPolygon(fl_display, fl_window, gc_, (XPoint*)p, n, Convex, 0);
+  if (n>2) {
+    fl_xlib_flush_rect_batch();
+    XFillPolygon(fl_display, fl_window, gc_, (XPoint*)p, n, Convex, 0);
+  }
 }
 
 void Fl_Xlib_Graphics_Driver::gap() {
@@ -67,13 +75,68 @@ void Fl_Xlib_Graphics_Driver::gap() {
   }
 }
 
+// Transform a whole vertex array at once, skipping the per-vertex virtual
+// calls of the begin/vertex/end pipeline, and drop repeated device pixels
+// like transformed_vertex0() does. Returns the number of points written to q.
+
+int Fl_Xlib_Graphics_Driver::transform_points(const double *xy, int npts, XPoint *q) {
+  float s = scale();
+  int k = 0;
+  for (int i = 0; i < npts; i++) {
+    double x = xy[2*i], y = xy[2*i+1];
+    short X = short((x*m.a + y*m.c + m.x) * s);
+    short Y = short((x*m.b + y*m.d + m.y) * s);
+    if (!k || X != q[k-1].x || Y != q[k-1].y) {
+      q[k].x = X;
+      q[k].y = Y;
+      k++;
+    }
+  }
+  return k;
+}
+
+void Fl_Xlib_Graphics_Driver::polyline(const double *xy, int npts) {
+  if (npts < 2) {
+    Fl_Graphics_Driver::polyline(xy, npts);
+    return;
+  }
+  XPoint *q = (XPoint*)malloc(npts * sizeof(XPoint));
+  int k = transform_points(xy, npts, q);
+  // split very long polylines so each XDrawLines() call stays well below
+  // the X server's maximum request size; repeat the joining vertex
+  const int chunk = 8192;
+  fl_xlib_flush_rect_batch();
+  for (int start = 0; start < k-1; start += chunk-1) {
+    int count = k - start;
+    if (count > chunk) count = chunk;
+    XDrawLines(fl_display, fl_window, gc_, q+start, count, 0);
+  }
+  free(q);
+}
+
+void Fl_Xlib_Graphics_Driver::polygon(const double *xy, int npts) {
+  if (npts < 3) {
+    Fl_Graphics_Driver::polygon(xy, npts);
+    return;
+  }
+  XPoint *q = (XPoint*)malloc(npts * sizeof(XPoint));
+  int k = transform_points(xy, npts, q);
+  while (k > 2 && q[k-1].x == q[0].x && q[k-1].y == q[0].y) k--; // fixloop()
+  if (k > 2) fl_xlib_flush_rect_batch();
+  if (k > 2) XFillPolygon(fl_display, fl_window, gc_, q, k, Convex, 0);
+  free(q);
+}
+
 void Fl_Xlib_Graphics_Driver::end_complex_polygon() {
   gap();
   if (n < 3) {
     end_line();
     return;
   }
-  if (n>2) XFillPolygon(fl_display, fl_window, gc_, (XPoint*)p, n, 0, 0);
+  if (n>2) {
+    fl_xlib_flush_rect_batch();
+    XFillPolygon(fl_display, fl_window, gc_, (XPoint*)p, n, 0, 0);
+  }
 }
 
 // shortcut the closed circles so they use XDrawArc:
@@ -85,6 +148,7 @@ void Fl_Xlib_Graphics_Driver::ellipse_unscaled(double xt, double yt, double rx,
   int lly = (int)rint(yt-ry);
   int h = (int)rint(yt+ry)-lly;
 
+  fl_xlib_flush_rect_batch();
   (what == POLYGON ? XFillArc : XDrawArc)
     (fl_display, fl_window, gc_, llx, lly, w, h, 0, 360*64);
 }
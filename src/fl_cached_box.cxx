@@ -0,0 +1,218 @@
+//
+// Cached box drawing code for the Fast Light Tool Kit (FLTK).
+//
+// Copyright 1998-2022 by Bill Spitzak and others.
+//
+// This library is free software. Distribution and use rights are outlined in
+// the file "COPYING" which should have been included with this file.  If this
+// file is missing or damaged, see the license at:
+//
+//     https://www.fltk.org/COPYING.php
+//
+// Please see the following page on how to report bugs and issues:
+//
+//     https://www.fltk.org/bugs.php
+//
+
+// Rasterizes expensive box drawing functions once per size and color and
+// satisfies later draws of the same box with a single image blit. This is
+// used by box types that need many primitives per draw (e.g. the round
+// gtk+ and plastic boxes) and by the "@" symbols, and is kept in its own
+// file so the image surface code is only linked in when actually used.
+
+#include <FL/Fl.H>
+#include <FL/fl_draw.H>
+#include <FL/Fl_Image_Surface.H>
+#include <FL/Fl_Graphics_Driver.H>
+
+extern unsigned fl_color_generation;    // in fl_color.cxx
+
+// One rasterized box: a box drawing function rendered at a given size,
+// color and activity, kept as an RGBA image so a repaint is one blit.
+struct Fl_Box_Raster {
+  Fl_Box_Raster *next;          // next raster, most recently used first
+  Fl_Box_Draw_F *f;             // the box drawing function
+  const void    *sym;           // symbol identity for symbol rasters, 0 for boxes
+  unsigned      variant;        // extra key bits (symbol rotation and flips)
+  int           w, h;           // box size the raster was drawn at
+  Fl_Color      color;          // box color
+  char          active;         // Fl::draw_box_active() during the draw
+  float         scale;          // GUI scaling factor of the raster
+  Fl_RGB_Image  *image;         // the rasterized box
+};
+
+#define MAX_RASTERS     64      // keep at most this many rasterized boxes
+#define MAX_RASTER_SIZE 256     // don't rasterize boxes larger than this
+
+static Fl_Box_Raster *rasters = 0;
+static int nrasters = 0;
+static unsigned rasters_generation = 0;
+static char building_raster = 0; // draw directly while rasterizing
+
+static void free_rasters() {
+  while (rasters) {
+    Fl_Box_Raster *r = rasters;
+    rasters = r->next;
+    delete r->image;
+    delete r;
+  }
+  nrasters = 0;
+}
+
+// Renders the box over a white and over a black background; where the
+// two renderings agree the pixel is opaque box color, where they differ
+// it shows the background and the difference gives the coverage. This
+// recovers an alpha channel so the raster blits correctly over any
+// background (same technique as Fl_File_Icon::cache_image_()).
+static Fl_RGB_Image *rasterize(Fl_Box_Draw_F *f, int w, int h, Fl_Color c) {
+  building_raster = 1;
+
+  Fl_Image_Surface *surf = new Fl_Image_Surface(w, h, 1);
+
+  Fl_Surface_Device::push_current(surf);
+  fl_color(FL_WHITE);
+  fl_rectf(0, 0, w, h);
+  f(0, 0, w, h, c);
+  Fl_RGB_Image *on_white = surf->image();
+  fl_color(FL_BLACK);
+  fl_rectf(0, 0, w, h);
+  f(0, 0, w, h, c);
+  Fl_RGB_Image *on_black = surf->image();
+  Fl_Surface_Device::pop_current();
+
+  delete surf;
+  building_raster = 0;
+
+  if (!on_white || !on_black) {
+    delete on_white;
+    delete on_black;
+    return 0;
+  }
+
+  int W = on_white->data_w();
+  int H = on_white->data_h();
+  int d = on_white->d();
+  int ldw = on_white->ld() ? on_white->ld() : W * d;
+  int ldb = on_black->ld() ? on_black->ld() : W * d;
+  uchar *rgba = new uchar[W * H * 4];
+
+  for (int y = 0; y < H; y++) {
+    const uchar *wp = on_white->array + y * ldw;
+    const uchar *bp = on_black->array + y * ldb;
+    uchar *dst = rgba + y * W * 4;
+    for (int x = 0; x < W; x++, wp += d, bp += d, dst += 4) {
+      int a = 255 - ((wp[0] - bp[0]) + (wp[1] - bp[1]) + (wp[2] - bp[2])) / 3;
+      if (a <= 0) {
+        dst[0] = dst[1] = dst[2] = dst[3] = 0;
+      } else {
+        if (a > 255) a = 255;
+        // the black-background rendering holds the box color
+        // multiplied by the coverage, undo that...
+        for (int i = 0; i < 3; i++) {
+          int v = bp[i] * 255 / a;
+          dst[i] = (uchar)(v > 255 ? 255 : v);
+        }
+        dst[3] = (uchar)a;
+      }
+    }
+  }
+
+  delete on_white;
+  delete on_black;
+
+  Fl_RGB_Image *img = new Fl_RGB_Image(rgba, W, H, 4);
+  img->alloc_array = 1;
+  img->scale(w, h);
+  return img;
+}
+
+// The shared cache lookup: finds or builds the raster for the given key
+// and blits it, or falls back to drawing directly through \p f.
+static void draw_cached(Fl_Box_Draw_F *f, const void *sym, unsigned variant,
+                        int x, int y, int w, int h, Fl_Color c) {
+  if (!building_raster && w > 0 && h > 0 &&
+      w <= MAX_RASTER_SIZE && h <= MAX_RASTER_SIZE &&
+      Fl_Display_Device::display_device()->is_current()) {
+
+    if (rasters_generation != fl_color_generation) {
+      free_rasters();   // a color map entry changed: all rasters are stale
+      rasters_generation = fl_color_generation;
+    }
+
+    char active = (char)(Fl::draw_box_active() != 0);
+    float s = Fl_Graphics_Driver::default_driver().scale();
+
+    Fl_Box_Raster *r, **prev;
+    for (prev = &rasters; (r = *prev) != 0; prev = &r->next) {
+      if (r->f == f && r->sym == sym && r->variant == variant &&
+          r->w == w && r->h == h && r->color == c &&
+          r->active == active && r->scale == s) break;
+    }
+    if (r) {
+      if (r != rasters) {       // move to the front of the list
+        *prev = r->next;
+        r->next = rasters;
+        rasters = r;
+      }
+      r->image->draw(x, y);
+      return;
+    }
+
+    Fl_RGB_Image *img = rasterize(f, w, h, c);
+    if (img) {
+      r = new Fl_Box_Raster;
+      r->next    = rasters;
+      r->f       = f;
+      r->sym     = sym;
+      r->variant = variant;
+      r->w       = w;
+      r->h       = h;
+      r->color   = c;
+      r->active  = active;
+      r->scale   = s;
+      r->image   = img;
+      rasters    = r;
+      if (++nrasters > MAX_RASTERS) {   // drop the least recently used
+        for (prev = &rasters; (*prev)->next; prev = &(*prev)->next) {/*empty*/}
+        r = *prev;
+        *prev = 0;
+        delete r->image;
+        delete r;
+        nrasters--;
+      }
+      img->draw(x, y);
+      return;
+    }
+  }
+
+  f(x, y, w, h, c);
+}
+
+/*
+  Draws the box drawn by \p f at the given position, size and color,
+  through a cache of rasterized boxes.
+
+  The first time a (function, size, color, activity, scale) combination
+  is drawn on screen the box is rendered into an offscreen and kept as
+  an RGBA image; later draws blit that image. The cache is bounded (the
+  least recently drawn rasters are dropped first) and is flushed when an
+  entry of the color map changes, e.g. from Fl::set_color() or a scheme
+  change. Oversized boxes and drawing to non-screen surfaces (printers,
+  image surfaces) bypass the cache and draw directly.
+*/
+void fl_draw_box_cached(Fl_Box_Draw_F *f, int x, int y, int w, int h, Fl_Color c) {
+  draw_cached(f, 0, 0, x, y, w, h, c);
+}
+
+/*
+  Same as fl_draw_box_cached(), for "@" symbols (see fl_symbols.cxx).
+
+  Symbols share one drawing callback \p f that replays whatever symbol
+  fl_draw_symbol() last decoded, so the decoded symbol's identity and
+  its rotation/flip bits are passed separately as \p sym and \p variant
+  and take part in the cache key.
+*/
+void fl_draw_symbol_cached(Fl_Box_Draw_F *f, const void *sym, unsigned variant,
+                           int x, int y, int w, int h, Fl_Color c) {
+  draw_cached(f, sym, variant, x, y, w, h, c);
+}
@@ -33,6 +33,11 @@ unsigned fl_cmap[256] = {
 #include "fl_cmap.h" // this is a file produced by "cmap.cxx":
 };
 
+// Incremented whenever an entry of the color map changes, so that code
+// caching rendered output that depends on color map entries can detect
+// stale caches (see fl_cached_box.cxx).
+unsigned fl_color_generation = 0;
+
 // -----------------------------------------------------------------------------
 // all driver code is now in drivers/XXX/Fl_XXX_Graphics_Driver_xyz.cxx
 // -----------------------------------------------------------------------------
@@ -67,12 +72,23 @@ void Fl::set_color(Fl_Color i, uchar red, uchar green, uchar blue) {
 
 void Fl::set_color(Fl_Color i, unsigned c)
 {
+  fl_color_generation++;
   Fl_Graphics_Driver::default_driver().set_color(i, c);
 }
 
 
+void Fl::set_colors(const unsigned *colors, int first, int count)
+{
+  if (first < 0 || first > 255 || count <= 0) return;
+  if (count > 256 - first) count = 256 - first;
+  fl_color_generation++;
+  Fl_Graphics_Driver::default_driver().set_colors(colors, first, count);
+}
+
+
 void Fl::free_color(Fl_Color i, int overlay)
 {
+  fl_color_generation++;
   Fl_Graphics_Driver::default_driver().free_color(i, overlay);
 }
 
@@ -24,16 +24,20 @@
 #include <FL/fl_utf8.h>
 #include <FL/Fl.H>
 #include <FL/fl_draw.H>
+#include <FL/Fl_Widget.H>
 #include <FL/Fl_Image.H>
 #include <FL/platform.H>        // fl_open_display()
 
 #include "flstring.h"
 #include <ctype.h>
 #include <math.h>
+#include <stdlib.h>
 
 
 char fl_draw_shortcut;  // set by fl_labeltypes.cxx
 
+Fl_Label_Layout* fl_draw_layout;  // set by fl_labeltypes.cxx, consumed below
+
 static char* underline_at;
 
 /* If called with maxbuf==0, use an internally allocated buffer and enlarge it as needed.
@@ -125,6 +129,93 @@ fl_expand_text(const char* from, char* buf, int maxbuf, double maxw, int& n,
   return expand_text_(from,  buf, maxbuf, maxw,  n, width,  wrap,  draw_symbols);
 }
 
+// cheap content hash so a cached layout notices in-place label edits
+static unsigned layout_hash_(const char *s) {
+  unsigned h = 5381;
+  while (*s) h = 33*h + (uchar)*s++;
+  return h;
+}
+
+Fl_Label_Layout::Fl_Label_Layout() {
+  buf_ = NULL;
+  buf_size_ = 0;
+  lines_ = NULL;
+  nlines_ = 0;
+  lines_size_ = 0;
+  max_width_ = 0;
+  valid_ = 0;
+}
+
+Fl_Label_Layout::~Fl_Label_Layout() {
+  if (buf_) free(buf_);
+  if (lines_) free(lines_);
+}
+
+/** Returns non-zero if the cached layout was computed for the given
+  parameters and the current font, size and shortcut handling. */
+int Fl_Label_Layout::match(const char *str, double maxw, int wrap, int draw_symbols) const {
+  if (!valid_ || value_ != str) return 0;
+  if (font_ != fl_font() || size_ != fl_size() || height_ != fl_height()) return 0;
+  if (wrap_ != (char)(wrap != 0) || symbols_ != (char)(draw_symbols != 0)) return 0;
+  if (shortcut_ != fl_draw_shortcut) return 0;
+  if (wrap && maxw_ != maxw) return 0; // without wrapping the width is irrelevant
+  return hash_ == layout_hash_(str);
+}
+
+/** Expands \p str into its laid out lines and remembers the parameters
+  the layout was computed for. */
+void Fl_Label_Layout::build(const char *str, double maxw, int wrap, int draw_symbols) {
+  nlines_ = 0;
+  max_width_ = 0;
+  int used = 0;
+  char *linebuf = NULL;
+  for (const char *p = str; p;) {
+    int n;
+    double width;
+    const char *e = expand_text_(p, linebuf, 0, maxw, n, width, wrap, draw_symbols);
+    if (used + n + 1 > buf_size_) {
+      buf_size_ = used + n + 129;
+      buf_ = (char*)realloc(buf_, buf_size_);
+    }
+    if (nlines_ >= lines_size_) {
+      lines_size_ = lines_size_ ? 2*lines_size_ : 8;
+      lines_ = (Line*)realloc(lines_, lines_size_*sizeof(Line));
+    }
+    memcpy(buf_+used, linebuf, n);
+    buf_[used+n] = 0;
+    lines_[nlines_].off = used;
+    lines_[nlines_].n = n;
+    lines_[nlines_].width = width;
+    lines_[nlines_].underline =
+      (underline_at && underline_at >= linebuf && underline_at < linebuf+n) ?
+        (int)(underline_at - linebuf) : -1;
+    used += n + 1;
+    if (width > max_width_) max_width_ = width;
+    nlines_++;
+    if (!*e || (*e == '@' && e[1] != '@' && draw_symbols)) break;
+    p = e;
+  }
+  value_ = str;
+  hash_ = layout_hash_(str);
+  font_ = fl_font();
+  size_ = fl_size();
+  height_ = fl_height();
+  maxw_ = maxw;
+  wrap_ = (char)(wrap != 0);
+  symbols_ = (char)(draw_symbols != 0);
+  shortcut_ = fl_draw_shortcut;
+  valid_ = 1;
+}
+
+/** Returns the expanded text of line \p i and its length, width and
+  underline position (offset of the underlined character, or -1). */
+const char *Fl_Label_Layout::line(int i, int &n, double &width, int &underline) const {
+  n = lines_[i].n;
+  width = lines_[i].width;
+  underline = lines_[i].underline;
+  return buf_ + lines_[i].off;
+}
+
 /**
   The same as fl_draw(const char*,int,int,int,int,Fl_Align,Fl_Image*,int) with
   the addition of the \p callthis parameter, which is a pointer to a text drawing
@@ -144,6 +235,10 @@ void fl_draw(
   char symbol[2][255], *symptr;
   int symwidth[2], symoffset, symtotal, imgtotal;
 
+  // labels that cache their layout route it here through fl_normal_label()
+  Fl_Label_Layout* layout = fl_draw_layout;
+  fl_draw_layout = NULL;
+
   // count how many lines and put the last one into the buffer:
   int lines;
   double width;
@@ -180,7 +275,12 @@ void fl_draw(
   int strw = 0;
   int strh;
 
-  if (str) {
+  if (str && layout) {
+    if (!layout->match(str, w - symtotal - imgtotal, align&FL_ALIGN_WRAP, draw_symbols))
+      layout->build(str, w - symtotal - imgtotal, align&FL_ALIGN_WRAP, draw_symbols);
+    lines = layout->lines();
+    strw = (int)layout->max_width();
+  } else if (str) {
     for (p = str, lines=0; p;) {
       e = expand_text_(p, linebuf, 0, w - symtotal - imgtotal, buflen, width,
                          align&FL_ALIGN_WRAP, draw_symbols);
@@ -248,8 +348,14 @@ void fl_draw(
   // now draw all the lines:
   if (str) {
     int desc = fl_descent();
+    int line_i = 0;
     for (p=str; ; ypos += height) {
-      if (lines>1) e = expand_text_(p, linebuf, 0, w - symtotal - imgtotal, buflen,
+      if (layout) {
+        int u;
+        linebuf = (char*)layout->line(line_i, buflen, width, u);
+        underline_at = (u >= 0) ? linebuf + u : NULL;
+      }
+      else if (lines>1) e = expand_text_(p, linebuf, 0, w - symtotal - imgtotal, buflen,
                                 width, align&FL_ALIGN_WRAP, draw_symbols);
       else e = "";
 
@@ -264,8 +370,11 @@ void fl_draw(
       if (underline_at && underline_at >= linebuf && underline_at < (linebuf + buflen))
         callthis("_",1,xpos+int(fl_width(linebuf,(int) (underline_at-linebuf))),ypos-desc);
 
-      if (!*e || (*e == '@' && e[1] != '@')) break;
-      p = e;
+      if (layout) {
+        if (++line_i >= lines) break;
+      }
+      else if (!*e || (*e == '@' && e[1] != '@')) break;
+      else p = e;
     }
   }
 
@@ -328,8 +437,8 @@ void fl_draw(
   Fl_Image* img,
   int draw_symbols)
 {
-  if ((!str || !*str) && !img) return;
-  if (w && h && !fl_not_clipped(x, y, w, h) && (align & FL_ALIGN_INSIDE)) return;
+  if ((!str || !*str) && !img) {fl_draw_layout = NULL; return;}
+  if (w && h && !fl_not_clipped(x, y, w, h) && (align & FL_ALIGN_INSIDE)) {fl_draw_layout = NULL; return;}
   if (align & FL_ALIGN_CLIP)
     fl_push_clip(x, y, w, h);
   fl_draw(str, x, y, w, h, align, fl_draw, img, draw_symbols);
@@ -418,6 +527,64 @@ void fl_measure(const char* str, int& w, int& h, int draw_symbols) {
   h = lines*h;
 }
 
+/**
+  The same as fl_measure(), but the line breaks and expanded lines computed
+  while measuring are kept in \p layout, where a subsequent fl_draw() of the
+  same label consumes them directly instead of expanding the string again.
+  Labels that enabled Fl_Label::cache_layout(int) are measured through this
+  function automatically, so measuring and drawing a multi-line label
+  together cost a single pass over the text.
+
+  If \p layout is NULL this is plain fl_measure().
+
+  \param[in] layout the cache to fill, usually Fl_Label::layout
+  \param[in] str nul-terminated string
+  \param[out] w,h width and height of string in current font
+  \param[in] draw_symbols non-zero to enable @@symbol handling [default=1]
+*/
+void fl_measure_layout(Fl_Label_Layout *layout, const char* str, int& w, int& h, int draw_symbols) {
+  if (!layout) {fl_measure(str, w, h, draw_symbols); return;}
+  if (!str || !*str) {w = 0; h = 0; return;}
+  h = fl_height();
+  const char* p;
+  int symwidth[2], symtotal;
+
+  symwidth[0] = 0;      // size of symbol at beginning of string (if any)
+  symwidth[1] = 0;      // size of symbol at end of string (if any)
+
+  if (draw_symbols) {
+    // Symbol at beginning of string?
+    const char *sym2 = (str[0]=='@' && str[1]=='@') ? str+2 : str;      // sym2 check will skip leading @@
+    if (str[0] == '@' && str[1] != '@') {
+      while (*str && !isspace(*str)) { ++str; }         // skip over symbol
+      if (isspace(*str)) ++str;                         // skip over trailing space
+      sym2 = str;                                       // sym2 check will skip leading symbol
+      symwidth[0] = h;
+    }
+    // Symbol at end of string?
+    if ((p=strchr(sym2,'@')) != NULL && p[1] != '@') {
+      symwidth[1] = h;
+    }
+  }
+
+  symtotal = symwidth[0] + symwidth[1];
+
+  if (!layout->match(str, w - symtotal, w != 0, draw_symbols))
+    layout->build(str, w - symtotal, w != 0, draw_symbols);
+  int lines = layout->lines();
+  int W = (int)ceil(layout->max_width());
+
+  if ((symwidth[0] || symwidth[1]) && lines) {
+    if (symwidth[0]) symwidth[0] = lines * fl_height();
+    if (symwidth[1]) symwidth[1] = lines * fl_height();
+  }
+
+  symtotal = symwidth[0] + symwidth[1];
+
+  w = W + symtotal;
+  h = lines*h;
+}
+
 /**
   Sets the current font, which is then used in various drawing routines.
   You may call this outside a draw context if necessary to measure text,
@@ -180,17 +180,97 @@ int fl_convert_pixmap(const char*const* cdata, uchar* out, Fl_Color bg) {
   return 1;
 }
 
+//
+// Rasterized pixmap cache: interfaces typically draw the same few XPM
+// icons thousands of times (tree and browser views), so the RGBA
+// conversion of the most recently drawn pixmaps is kept and reused,
+// making each repeated fl_draw_pixmap() call a plain image blit.
+// Entries are keyed by the XPM data pointer and the background color;
+// code that modifies or frees XPM data after drawing it must call
+// fl_forget_pixmap() (Fl_Pixmap does).
+//
+
+#define PIXMAP_CACHE_SIZE 16
+
+typedef struct {
+  const char *const *data;  // XPM data that was converted, or NULL
+  Fl_Color bg;              // background color used for transparency
+  int w, h;                 // converted size
+  uchar *rgba;              // w*h*4 converted pixels
+  unsigned last_use;        // for LRU replacement
+} PixmapCacheEntry;
+
+static PixmapCacheEntry pixmap_cache[PIXMAP_CACHE_SIZE];
+static unsigned pixmap_cache_clock = 0;
+
+/**
+  Drop the cached rasterization of an XPM image, if there is one.
+  fl_draw_pixmap() keeps the RGBA conversion of recently drawn pixmaps
+  and reuses it when the same data is drawn again. Call this before
+  modifying or freeing XPM data that may have been drawn, so a stale
+  conversion cannot be reused. Fl_Pixmap calls it automatically.
+  \param[in] data pointer to XPM image data
+  \version 1.4.0
+  */
+void fl_forget_pixmap(const char* const* data) {
+  for (int i = 0; i < PIXMAP_CACHE_SIZE; i++) {
+    PixmapCacheEntry *e = &pixmap_cache[i];
+    if (e->data == data) {
+      delete[] e->rgba;
+      e->rgba = 0;
+      e->data = 0;
+      e->last_use = 0;
+    }
+  }
+}
+
 int fl_draw_pixmap(const char*const* cdata, int x, int y, Fl_Color bg) {
   int w, h;
 
   if (!fl_measure_pixmap(cdata, w, h))
     return 0;
 
-  uchar *buffer = new uchar[w*h*4];
+  // Drivers that need a background color adjust per-draw state inside
+  // fl_convert_pixmap(), so the conversion is not reusable for them.
+  int cacheable = !Fl_Graphics_Driver::need_pixmap_bg_color;
+  uchar *buffer;
 
-  if (!fl_convert_pixmap(cdata, buffer, bg)) {
-    delete[] buffer;
-    return 0;
+  if (cacheable) {
+    PixmapCacheEntry *entry = 0;
+    PixmapCacheEntry *lru = &pixmap_cache[0];
+    for (int i = 0; i < PIXMAP_CACHE_SIZE; i++) {
+      PixmapCacheEntry *e = &pixmap_cache[i];
+      if (e->data == cdata && e->bg == bg && e->w == w && e->h == h) {
+        entry = e;
+        break;
+      }
+      if (e->last_use < lru->last_use) lru = e;
+    }
+    if (!entry) {
+      // Convert into the least recently used cache slot
+      entry = lru;
+      delete[] entry->rgba;
+      entry->rgba = new uchar[w*h*4];
+      if (!fl_convert_pixmap(cdata, entry->rgba, bg)) {
+        delete[] entry->rgba;
+        entry->rgba = 0;
+        entry->data = 0;
+        entry->last_use = 0;
+        return 0;
+      }
+      entry->data = cdata;
+      entry->bg   = bg;
+      entry->w    = w;
+      entry->h    = h;
+    }
+    entry->last_use = ++pixmap_cache_clock;
+    buffer = entry->rgba;
+  } else {
+    buffer = new uchar[w*h*4];
+    if (!fl_convert_pixmap(cdata, buffer, bg)) {
+      delete[] buffer;
+      return 0;
+    }
   }
 
   // build the mask bitmap used by Fl_Pixmap:
@@ -218,6 +298,6 @@ int fl_draw_pixmap(const char*const* cdata, int x, int y, Fl_Color bg) {
 
   fl_draw_image(buffer, x, y, w, h, 4);
 
-  delete[] buffer;
+  if (!cacheable) delete[] buffer;
   return 1;
 }
@@ -65,29 +65,28 @@ static void gleam_color(Fl_Color c) {
 static void shade_rect_top_bottom(int x, int y, int w, int h, Fl_Color fg1, Fl_Color fg2, float th) {
   // calculate background size w/o borders
   x += 2; y += 2; w -= 4; h -= 4;
+  if (w <= 0 || h <= 0) return;
   // draw the shiny background using maximum limits
   int h_top    = ((h/2) < (20) ? (h/2) : (20)); // min(h/2, 20);
   int h_bottom = ((h/6) < (15) ? (h/6) : (15)); // min(h/6, 15);
-  int h_flat = h - h_top - h_bottom;
-  float step_size_top = h_top > 1 ? (0.999f/float(h_top)) : 1;
-  float step_size_bottom = h_bottom > 1 ? (0.999f/float(h_bottom)) : 1;
-  // draw the gradient at the top of the widget
-  float k = 1;
-  for (int i = 0; i < h_top; i++, k -= step_size_top) {
-    gleam_color(fl_color_average(fl_color_average(fg1, fg2, th), fg1, k));
-    fl_xyline(x, y+i, x+w-1);
+  // The shade runs from the mixed color at the top edge to the flat
+  // background color, stays flat in the middle area of the box and
+  // fades back to the mixed color at the bottom edge. This is a single
+  // linear gradient so the whole background is one backend call.
+  Fl_Color mixed = Fl::box_color(fl_color_average(fg1, fg2, th));
+  Fl_Color flat = Fl::box_color(fg1);
+  double pos[4];
+  Fl_Color colors[4];
+  int n = 0;
+  pos[n] = 0.; colors[n++] = h_top > 0 ? mixed : flat;
+  if (h_top > 0 && h_top < h - 1) {
+    pos[n] = h_top / double(h - 1); colors[n++] = flat;
   }
-
-  // draw a "flat" rectangle in the middle area of the box
-  gleam_color(fg1);
-  fl_rectf(x, y + h_top, w, h_flat);
-
-  // draw the gradient at the bottom of the widget
-  k = 1;
-  for (int i = 0; i < h_bottom; i++, k -= step_size_bottom) {
-    gleam_color(fl_color_average(fg1, fl_color_average(fg1, fg2, th), k));
-    fl_xyline(x, y+h_top+h_flat+i, x+w-1);
+  if (h_bottom > 0 && h_bottom < h - 1) {
+    pos[n] = (h - h_bottom) / double(h - 1); colors[n++] = flat;
   }
+  pos[n] = 1.; colors[n++] = h_bottom > 0 ? mixed : flat;
+  fl_gradient_rectf(x, y, w, h, n, pos, colors);
 }
 
 // See shade_rect_top_bottom()
@@ -31,12 +31,51 @@ static void gtk_color(Fl_Color c) {
   Fl::set_box_color(c);
 }
 
+// The shades of the base color used by these boxes. One box draw needs
+// up to ten of them and a GUI repaints the same few box colors over and
+// over, so the shades are computed once per color and kept in a small
+// cache instead of calling fl_color_average() on every draw.
+struct gtk_shade_set {
+  char valid;
+  Fl_Color base;  // the box color these shades belong to
+  unsigned argb;  // Fl::get_color(base) when the shades were computed
+  Fl_Color w60, w50, w40, w20, w10;  // averages towards FL_WHITE
+  Fl_Color b50, b40, b10, b05, b025; // averages towards FL_BLACK
+};
+
+static const gtk_shade_set *gtk_shades(Fl_Color c) {
+  static gtk_shade_set cache[8];
+  static int next = 0;
+  unsigned argb = Fl::get_color(c); // so redefined colormap entries recompute
+  for (int i = 0; i < 8; i++) {
+    if (cache[i].valid && cache[i].base == c && cache[i].argb == argb)
+      return &cache[i];
+  }
+  gtk_shade_set *s = &cache[next];
+  next = (next + 1) % 8;
+  s->valid = 1;
+  s->base = c;
+  s->argb = argb;
+  s->w60 = fl_color_average(FL_WHITE, c, 0.6f);
+  s->w50 = fl_color_average(FL_WHITE, c, 0.5f);
+  s->w40 = fl_color_average(FL_WHITE, c, 0.4f);
+  s->w20 = fl_color_average(FL_WHITE, c, 0.2f);
+  s->w10 = fl_color_average(FL_WHITE, c, 0.1f);
+  s->b50 = fl_color_average(FL_BLACK, c, 0.5f);
+  s->b40 = fl_color_average(FL_BLACK, c, 0.4f);
+  s->b10 = fl_color_average(FL_BLACK, c, 0.1f);
+  s->b05 = fl_color_average(FL_BLACK, c, 0.05f);
+  s->b025 = fl_color_average(FL_BLACK, c, 0.025f);
+  return s;
+}
+
 static void gtk_up_frame(int x, int y, int w, int h, Fl_Color c) {
-  gtk_color(fl_color_average(FL_WHITE, c, 0.5));
+  const gtk_shade_set *s = gtk_shades(c);
+  gtk_color(s->w50);
   fl_xyline(x + 2, y + 1, x + w - 3);
   fl_yxline(x + 1, y + 2, y + h - 3);
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.5));
+  gtk_color(s->b50);
   fl_begin_loop();
     fl_vertex(x, y + 2);
     fl_vertex(x + 2, y);
@@ -53,26 +92,46 @@ static void gtk_up_frame(int x, int y, int w, int h, Fl_Color c) {
 static void gtk_up_box(int x, int y, int w, int h, Fl_Color c) {
   gtk_up_frame(x, y, w, h, c);
 
-  gtk_color(fl_color_average(FL_WHITE, c, 0.4f));
-  fl_xyline(x + 2, y + 2, x + w - 3);
-  gtk_color(fl_color_average(FL_WHITE, c, 0.2f));
-  fl_xyline(x + 2, y + 3, x + w - 3);
-  gtk_color(fl_color_average(FL_WHITE, c, 0.1f));
-  fl_xyline(x + 2, y + 4, x + w - 3);
-  gtk_color(c);
-  fl_rectf(x + 2, y + 5, w - 4, h - 7);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.025f));
-  fl_xyline(x + 2, y + h - 4, x + w - 3);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.05f));
-  fl_xyline(x + 2, y + h - 3, x + w - 3);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.1f));
-  fl_xyline(x + 2, y + h - 2, x + w - 3);
+  const gtk_shade_set *s = gtk_shades(c);
+  int hh = h - 3; // interior rows y + 2 .. y + h - 2
+  if (hh >= 7) {
+    // lighter top rows, flat middle and darker bottom rows as one gradient
+    double den = hh - 1;
+    double pos[8];
+    Fl_Color colors[8];
+    pos[0] = 0.;             colors[0] = Fl::box_color(s->w40);
+    pos[1] = 1 / den;        colors[1] = Fl::box_color(s->w20);
+    pos[2] = 2 / den;        colors[2] = Fl::box_color(s->w10);
+    pos[3] = 3 / den;        colors[3] = Fl::box_color(c);
+    pos[4] = (hh - 4) / den; colors[4] = colors[3];
+    pos[5] = (hh - 3) / den; colors[5] = Fl::box_color(s->b025);
+    pos[6] = (hh - 2) / den; colors[6] = Fl::box_color(s->b05);
+    pos[7] = 1.;             colors[7] = Fl::box_color(s->b10);
+    fl_gradient_rectf(x + 2, y + 2, w - 4, hh, 8, pos, colors);
+  } else {
+    gtk_color(s->w40);
+    fl_xyline(x + 2, y + 2, x + w - 3);
+    gtk_color(s->w20);
+    fl_xyline(x + 2, y + 3, x + w - 3);
+    gtk_color(s->w10);
+    fl_xyline(x + 2, y + 4, x + w - 3);
+    gtk_color(c);
+    fl_rectf(x + 2, y + 5, w - 4, h - 7);
+    gtk_color(s->b025);
+    fl_xyline(x + 2, y + h - 4, x + w - 3);
+    gtk_color(s->b05);
+    fl_xyline(x + 2, y + h - 3, x + w - 3);
+    gtk_color(s->b10);
+    fl_xyline(x + 2, y + h - 2, x + w - 3);
+  }
+  gtk_color(s->b10);
   fl_yxline(x + w - 2, y + 2, y + h - 3);
 }
 
 
 static void gtk_down_frame(int x, int y, int w, int h, Fl_Color c) {
-  gtk_color(fl_color_average(FL_BLACK, c, 0.5));
+  const gtk_shade_set *s = gtk_shades(c);
+  gtk_color(s->b50);
   fl_begin_loop();
     fl_vertex(x, y + 2);
     fl_vertex(x + 2, y);
@@ -84,11 +143,11 @@ static void gtk_down_frame(int x, int y, int w, int h, Fl_Color c) {
     fl_vertex(x, y + h - 3);
   fl_end_loop();
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.1f));
+  gtk_color(s->b10);
   fl_xyline(x + 2, y + 1, x + w - 3);
   fl_yxline(x + 1, y + 2, y + h - 3);
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.05f));
+  gtk_color(s->b05);
   fl_yxline(x + 2, y + h - 2, y + 2, x + w - 2);
 }
 
@@ -103,11 +162,12 @@ static void gtk_down_box(int x, int y, int w, int h, Fl_Color c) {
 
 
 static void gtk_thin_up_frame(int x, int y, int w, int h, Fl_Color c) {
-  gtk_color(fl_color_average(FL_WHITE, c, 0.6f));
+  const gtk_shade_set *s = gtk_shades(c);
+  gtk_color(s->w60);
   fl_xyline(x + 1, y, x + w - 2);
   fl_yxline(x, y + 1, y + h - 2);
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.4f));
+  gtk_color(s->b40);
   fl_xyline(x + 1, y + h - 1, x + w - 2);
   fl_yxline(x + w - 1, y + 1, y + h - 2);
 }
@@ -116,29 +176,48 @@ static void gtk_thin_up_frame(int x, int y, int w, int h, Fl_Color c) {
 static void gtk_thin_up_box(int x, int y, int w, int h, Fl_Color c) {
   gtk_thin_up_frame(x, y, w, h, c);
 
-  gtk_color(fl_color_average(FL_WHITE, c, 0.4f));
-  fl_xyline(x + 1, y + 1, x + w - 2);
-  gtk_color(fl_color_average(FL_WHITE, c, 0.2f));
-  fl_xyline(x + 1, y + 2, x + w - 2);
-  gtk_color(fl_color_average(FL_WHITE, c, 0.1f));
-  fl_xyline(x + 1, y + 3, x + w - 2);
-  gtk_color(c);
-  fl_rectf(x + 1, y + 4, w - 2, h - 8);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.025f));
-  fl_xyline(x + 1, y + h - 4, x + w - 2);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.05f));
-  fl_xyline(x + 1, y + h - 3, x + w - 2);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.1f));
-  fl_xyline(x + 1, y + h - 2, x + w - 2);
+  const gtk_shade_set *s = gtk_shades(c);
+  int hh = h - 2; // interior rows y + 1 .. y + h - 2
+  if (hh >= 7) {
+    // lighter top rows, flat middle and darker bottom rows as one gradient
+    double den = hh - 1;
+    double pos[8];
+    Fl_Color colors[8];
+    pos[0] = 0.;             colors[0] = Fl::box_color(s->w40);
+    pos[1] = 1 / den;        colors[1] = Fl::box_color(s->w20);
+    pos[2] = 2 / den;        colors[2] = Fl::box_color(s->w10);
+    pos[3] = 3 / den;        colors[3] = Fl::box_color(c);
+    pos[4] = (hh - 4) / den; colors[4] = colors[3];
+    pos[5] = (hh - 3) / den; colors[5] = Fl::box_color(s->b025);
+    pos[6] = (hh - 2) / den; colors[6] = Fl::box_color(s->b05);
+    pos[7] = 1.;             colors[7] = Fl::box_color(s->b10);
+    fl_gradient_rectf(x + 1, y + 1, w - 2, hh, 8, pos, colors);
+  } else {
+    gtk_color(s->w40);
+    fl_xyline(x + 1, y + 1, x + w - 2);
+    gtk_color(s->w20);
+    fl_xyline(x + 1, y + 2, x + w - 2);
+    gtk_color(s->w10);
+    fl_xyline(x + 1, y + 3, x + w - 2);
+    gtk_color(c);
+    fl_rectf(x + 1, y + 4, w - 2, h - 8);
+    gtk_color(s->b025);
+    fl_xyline(x + 1, y + h - 4, x + w - 2);
+    gtk_color(s->b05);
+    fl_xyline(x + 1, y + h - 3, x + w - 2);
+    gtk_color(s->b10);
+    fl_xyline(x + 1, y + h - 2, x + w - 2);
+  }
 }
 
 
 static void gtk_thin_down_frame(int x, int y, int w, int h, Fl_Color c) {
-  gtk_color(fl_color_average(FL_BLACK, c, 0.4f));
+  const gtk_shade_set *s = gtk_shades(c);
+  gtk_color(s->b40);
   fl_xyline(x + 1, y, x + w - 2);
   fl_yxline(x, y + 1, y + h - 2);
 
-  gtk_color(fl_color_average(FL_WHITE, c, 0.6f));
+  gtk_color(s->w60);
   fl_xyline(x + 1, y + h - 1, x + w - 2);
   fl_yxline(x + w - 1, y + 1, y + h - 2);
 }
@@ -200,48 +279,50 @@ static void draw(int which, int x,int y,int w,int h, int inset)
 }
 
 static void gtk_round_up_box(int x, int y, int w, int h, Fl_Color c) {
+  const gtk_shade_set *s = gtk_shades(c);
   gtk_color(c);
   draw(FILL,        x,   y, w,   h, 2);
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.025f));
+  gtk_color(s->b025);
   draw(LOWER_RIGHT, x+1, y, w-2, h, 2);
   draw(LOWER_RIGHT, x,   y, w,   h, 3);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.05f));
+  gtk_color(s->b05);
   draw(LOWER_RIGHT, x+1, y, w-2, h, 1);
   draw(LOWER_RIGHT, x,   y, w,   h, 2);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.1f));
+  gtk_color(s->b10);
   draw(LOWER_RIGHT, x+1, y, w-2, h, 0);
   draw(LOWER_RIGHT, x,   y, w,   h, 1);
 
-  gtk_color(fl_color_average(FL_WHITE, c, 0.1f));
+  gtk_color(s->w10);
   draw(UPPER_LEFT,  x,   y, w,   h, 4);
   draw(UPPER_LEFT,  x+1, y, w-2, h, 3);
-  gtk_color(fl_color_average(FL_WHITE, c, 0.2f));
+  gtk_color(s->w20);
   draw(UPPER_LEFT,  x,   y, w,   h, 3);
   draw(UPPER_LEFT,  x+1, y, w-2, h, 2);
-  gtk_color(fl_color_average(FL_WHITE, c, 0.4f));
+  gtk_color(s->w40);
   draw(UPPER_LEFT,  x,   y, w,   h, 2);
   draw(UPPER_LEFT,  x+1, y, w-2, h, 1);
-  gtk_color(fl_color_average(FL_WHITE, c, 0.5f));
+  gtk_color(s->w50);
   draw(UPPER_LEFT,  x,   y, w,   h, 1);
   draw(UPPER_LEFT,  x+1, y, w-2, h, 0);
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.5f));
+  gtk_color(s->b50);
   draw(CLOSED,      x,   y, w,   h, 0);
 }
 
 static void gtk_round_down_box(int x, int y, int w, int h, Fl_Color c) {
+  const gtk_shade_set *s = gtk_shades(c);
   gtk_color(c);
   draw(FILL,        x,   y, w,   h, 2);
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.05f));
+  gtk_color(s->b05);
   draw(UPPER_LEFT,  x,   y, w,   h, 2);
   draw(UPPER_LEFT,  x+1, y, w-2, h, 1);
-  gtk_color(fl_color_average(FL_BLACK, c, 0.1f));
+  gtk_color(s->b10);
   draw(UPPER_LEFT,  x,   y, w,   h, 1);
   draw(UPPER_LEFT,  x+1, y, w-2, h, 0);
 
-  gtk_color(fl_color_average(FL_BLACK, c, 0.5f));
+  gtk_color(s->b50);
   draw(CLOSED,      x,   y, w,   h, 0);
 }
 
@@ -270,6 +351,19 @@ static void gtk_round_down_box(int x, int y, int w, int h, Fl_Color c) {
 
 #endif
 
+// The round boxes need many arc and pie calls per draw: draw them
+// through the raster cache so repaints are a single image blit.
+
+extern void fl_draw_box_cached(Fl_Box_Draw_F*, int, int, int, int, Fl_Color); // in fl_cached_box.cxx
+
+static void gtk_round_up_box_cached(int x, int y, int w, int h, Fl_Color c) {
+  fl_draw_box_cached(gtk_round_up_box, x, y, w, h, c);
+}
+
+static void gtk_round_down_box_cached(int x, int y, int w, int h, Fl_Color c) {
+  fl_draw_box_cached(gtk_round_down_box, x, y, w, h, c);
+}
+
 Fl_Boxtype fl_define_FL_GTK_UP_BOX() {
   fl_internal_boxtype(_FL_GTK_UP_BOX, gtk_up_box);
   fl_internal_boxtype(_FL_GTK_DOWN_BOX, gtk_down_box);
@@ -279,8 +373,8 @@ Fl_Boxtype fl_define_FL_GTK_UP_BOX() {
   fl_internal_boxtype(_FL_GTK_THIN_DOWN_BOX, gtk_thin_down_box);
   fl_internal_boxtype(_FL_GTK_THIN_UP_FRAME, gtk_thin_up_frame);
   fl_internal_boxtype(_FL_GTK_THIN_DOWN_FRAME, gtk_thin_down_frame);
-  fl_internal_boxtype(_FL_GTK_ROUND_UP_BOX, gtk_round_up_box);
-  fl_internal_boxtype(_FL_GTK_ROUND_DOWN_BOX, gtk_round_down_box);
+  fl_internal_boxtype(_FL_GTK_ROUND_UP_BOX, gtk_round_up_box_cached);
+  fl_internal_boxtype(_FL_GTK_ROUND_DOWN_BOX, gtk_round_down_box_cached);
 
   return _FL_GTK_UP_BOX;
 }
@@ -44,6 +44,7 @@
 //
 
 static Fl_Image *fl_check_images(const char *name, uchar *header, int headerlen);
+static Fl_RGB_Image *fl_decode_image_mem(const unsigned char *data, int length);
 
 
 /**
@@ -55,10 +56,40 @@ static Fl_Image *fl_check_images(const char *name, uchar *header, int headerlen)
 */
 void fl_register_images() {
   Fl_Shared_Image::add_handler(fl_check_images);
+  Fl_Image::decode_image_mem = fl_decode_image_mem;
   Fl_Image::register_images_done = true;
 }
 
 
+//
+// 'fl_decode_image_mem()' - Decode an in-memory image stream.
+//
+// Decodes the formats that can arrive through the system clipboard
+// directly from the transferred bytes, without the temporary file
+// Fl_Shared_Image::get() would need.
+//
+
+static Fl_RGB_Image *                           // O - Image, if format known
+fl_decode_image_mem(const unsigned char *data,  // I - Image stream bytes
+                    int length) {               // I - Number of bytes
+  if (length >= 2 && memcmp(data, "BM", 2) == 0)        // BMP stream
+    return new Fl_BMP_Image(NULL, data);
+
+#ifdef HAVE_LIBPNG
+  if (length >= 4 && memcmp(data, "\211PNG", 4) == 0)   // PNG stream
+    return new Fl_PNG_Image(NULL, data, length);
+#endif // HAVE_LIBPNG
+
+#ifdef HAVE_LIBJPEG
+  if (length >= 4 && memcmp(data, "\377\330\377", 3) == 0 &&
+      data[3] >= 0xc0 && data[3] <= 0xfe)               // JPEG stream
+    return new Fl_JPEG_Image(NULL, data);
+#endif // HAVE_LIBJPEG
+
+  return NULL;
+}
+
+
 //
 // 'fl_check_images()' - Check for a supported image format.
 //
@@ -24,6 +24,8 @@
 #include <FL/fl_draw.H>
 #include <FL/Fl_Image.H>
 
+extern Fl_Label_Layout* fl_draw_layout; // in fl_draw.cxx
+
 void
 fl_no_label(const Fl_Label*,int,int,int,int,Fl_Align) {}
 
@@ -32,13 +34,16 @@ fl_normal_label(const Fl_Label* o, int X, int Y, int W, int H, Fl_Align align)
 {
   fl_font(o->font, o->size);
   fl_color((Fl_Color)o->color);
+  fl_draw_layout = o->layout;
   fl_draw(o->value, X, Y, W, H, align, o->image);
 }
 
 void
 fl_normal_measure(const Fl_Label* o, int& W, int& H) {
   fl_font(o->font, o->size);
-  fl_measure(o->value, W, H);
+  // a label that caches its layout keeps the line breaks found while
+  // measuring, so the following draw doesn't expand the text again
+  fl_measure_layout(o->layout, o->value, W, H);
   if (o->image) {
     int iw = o->image->w(), ih = o->image->h();
     if (o->align_ & FL_ALIGN_IMAGE_BACKDROP) {          // backdrop: ignore
@@ -84,6 +89,18 @@ void Fl_Label::draw(int X, int Y, int W, int H, Fl_Align align) const {
   if (!value && !image) return;
   table[type](this, X, Y, W, H, align);
 }
+
+/** Turns caching of the label's multi-line layout on or off.
+    \param[in] on non-zero to cache the layout computed by fl_draw()
+    \see Fl_Widget::cache_label_layout(int), Fl_Label_Layout
+*/
+void Fl_Label::cache_layout(int on) {
+  if (on && !layout) layout = new Fl_Label_Layout();
+  else if (!on && layout) {
+    delete layout;
+    layout = 0;
+  }
+}
 /**
     Measures the size of the label.
     \param[in,out] W, H : this is the requested size for the label text plus image;
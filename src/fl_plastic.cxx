@@ -148,35 +148,41 @@ static void shade_rect(int x, int y, int w, int h, const char *c, Fl_Color bc) {
   int   clen = (int) strlen(c) - 1;
   int   chalf = clen / 2;
   int   cstep = 1;
+  // stop arrays for the shade gradient: at most one stop per ramp
+  // character at each end plus the two ends of the flat interior
+  double    pos[2 * ('X' - 'A') + 2];
+  Fl_Color  colors[2 * ('X' - 'A') + 2];
+  int       n = 0;
 
   if (h < (w * 2)) {
     // Horizontal shading...
     if (clen >= h) cstep = 2;
 
     for (i = 0, j = 0; j < chalf; i ++, j += cstep) {
-      // Draw the top line and points...
-      fl_color(shade_color(g[(int)c[i]], bc));
-      fl_xyline(x + 1, y + i, x + w - 2);
-
+      // Draw the top and bottom points...
       fl_color(shade_color(g[c[i] - 2], bc));
       fl_point(x, y + i + 1);
       fl_point(x + w - 1, y + i + 1);
 
-      // Draw the bottom line and points...
-      fl_color(shade_color(g[(int)c[clen - i]], bc));
-      fl_xyline(x + 1, y + h - i, x + w - 2);
-
       fl_color(shade_color(g[c[clen - i] - 2], bc));
       fl_point(x, y + h - i);
       fl_point(x + w - 1, y + h - i);
     }
 
-    // Draw the interior and sides...
+    // Draw the top shade, the flat interior and the bottom shade with
+    // a single gradient...
     i = chalf / cstep;
+    for (j = 0; j < i; j ++) {
+      pos[n] = j / double(h); colors[n ++] = shade_color(g[(int)c[j]], bc);
+    }
+    pos[n] = i / double(h);       colors[n ++] = shade_color(g[(int)c[chalf]], bc);
+    pos[n] = (h - i) / double(h); colors[n ++] = shade_color(g[(int)c[chalf]], bc);
+    for (j = i - 1; j >= 0; j --) {
+      pos[n] = (h - j) / double(h); colors[n ++] = shade_color(g[(int)c[clen - j]], bc);
+    }
+    fl_gradient_rectf(x + 1, y, w - 2, h + 1, n, pos, colors);
 
-    fl_color(shade_color(g[(int)c[chalf]], bc));
-    fl_rectf(x + 1, y + i, w - 2, h - 2 * i + 1);
-
+    // Draw the sides...
     fl_color(shade_color(g[c[chalf] - 2], bc));
     fl_yxline(x, y + i, y + h - i);
     fl_yxline(x + w - 1, y + i, y + h - i);
@@ -185,29 +191,30 @@ static void shade_rect(int x, int y, int w, int h, const char *c, Fl_Color bc) {
     if (clen >= w) cstep = 2;
 
     for (i = 0, j = 0; j < chalf; i ++, j += cstep) {
-      // Draw the left line and points...
-      fl_color(shade_color(g[(int)c[i]], bc));
-      fl_yxline(x + i, y + 1, y + h - 1);
-
+      // Draw the left and right points...
       fl_color(shade_color(g[c[i] - 2], bc));
       fl_point(x + i + 1, y);
       fl_point(x + i + 1, y + h);
 
-      // Draw the right line and points...
-      fl_color(shade_color(g[(int)c[clen - i]], bc));
-      fl_yxline(x + w - 1 - i, y + 1, y + h - 1);
-
       fl_color(shade_color(g[c[clen - i] - 2], bc));
       fl_point(x + w - 2 - i, y);
       fl_point(x + w - 2 - i, y + h);
     }
 
-    // Draw the interior, top, and bottom...
+    // Draw the left shade, the flat interior and the right shade with
+    // a single gradient...
     i = chalf / cstep;
+    for (j = 0; j < i; j ++) {
+      pos[n] = j / double(w - 1); colors[n ++] = shade_color(g[(int)c[j]], bc);
+    }
+    pos[n] = i / double(w - 1);           colors[n ++] = shade_color(g[(int)c[chalf]], bc);
+    pos[n] = (w - 1 - i) / double(w - 1); colors[n ++] = shade_color(g[(int)c[chalf]], bc);
+    for (j = i - 1; j >= 0; j --) {
+      pos[n] = (w - 1 - j) / double(w - 1); colors[n ++] = shade_color(g[(int)c[clen - j]], bc);
+    }
+    fl_gradient_rectf(x, y + 1, w, h - 1, n, pos, colors, 1);
 
-    fl_color(shade_color(g[(int)c[chalf]], bc));
-    fl_rectf(x + i, y + 1, w - 2 * i, h - 1);
-
+    // Draw the top and bottom...
     fl_color(shade_color(g[c[chalf] - 2], bc));
     fl_xyline(x + i, y, x + w - i);
     fl_xyline(x + i, y + h, x + w - i);
@@ -348,6 +355,20 @@ static void down_round(int x, int y, int w, int h, Fl_Color c) {
 }
 
 
+// The round boxes need many arc and pie calls per draw: draw them
+// through the raster cache so repaints are a single image blit.
+
+extern void fl_draw_box_cached(Fl_Box_Draw_F*, int, int, int, int, Fl_Color); // in fl_cached_box.cxx
+
+static void up_round_cached(int x, int y, int w, int h, Fl_Color c) {
+  fl_draw_box_cached(up_round, x, y, w, h, c);
+}
+
+static void down_round_cached(int x, int y, int w, int h, Fl_Color c) {
+  fl_draw_box_cached(down_round, x, y, w, h, c);
+}
+
+
 extern void fl_internal_boxtype(Fl_Boxtype, Fl_Box_Draw_F*);
 
 
@@ -358,8 +379,8 @@ Fl_Boxtype fl_define_FL_PLASTIC_UP_BOX() {
   fl_internal_boxtype(_FL_PLASTIC_DOWN_FRAME, down_frame);
   fl_internal_boxtype(_FL_PLASTIC_THIN_UP_BOX, thin_up_box);
   fl_internal_boxtype(_FL_PLASTIC_THIN_DOWN_BOX, down_box);
-  fl_internal_boxtype(_FL_PLASTIC_ROUND_UP_BOX, up_round);
-  fl_internal_boxtype(_FL_PLASTIC_ROUND_DOWN_BOX, down_round);
+  fl_internal_boxtype(_FL_PLASTIC_ROUND_UP_BOX, up_round_cached);
+  fl_internal_boxtype(_FL_PLASTIC_ROUND_DOWN_BOX, down_round_cached);
 
   return _FL_PLASTIC_UP_BOX;
 }
@@ -50,6 +50,29 @@ uchar *fl_read_image(uchar *p, int X, int Y, int w, int h, int alpha) {
     img = Fl_Screen_Driver::traverse_to_gl_subwindows(Fl_Window::current(), X, Y, w, h, NULL);
   }
   int depth = alpha ? 4 : 3;
+  if (img && p && img->w() == w && img->h() == h) {
+    // The caller supplied a buffer of the right size: convert straight into
+    // it, without an intermediate image or an allocation per call.
+    if (img->d() == depth) {
+      memcpy(p, img->array, w * h * depth);
+    } else {
+      if (depth == 4) memset(p, alpha, w * h * depth);
+      uchar *d = p;
+      const uchar *q;
+      int ld = img->ld() ? img->ld() : img->w() * img->d();
+      for (int r = 0; r < img->h(); r++) {
+        q = img->array + r * ld;
+        for (int c = 0; c < img->w(); c++) {
+          d[0] = q[0];
+          d[1] = q[1];
+          d[2] = q[2];
+          d += depth; q += img->d();
+        }
+      }
+    }
+    delete img;
+    return p;
+  }
   if (img && img->d() != depth) {
     uchar *data = new uchar[img->w() * img->h() * depth];
     if (depth == 4) memset(data, alpha, img->w() * img->h() * depth);
@@ -300,14 +300,12 @@ unsigned int fl_old_shortcut(const char* s) {
 unsigned int Fl_Widget::label_shortcut(const char *t) {
   if (!t) return 0;
   for (;;) {
-    if (*t==0) return 0;
-    if (*t=='&') {
-      unsigned int s = fl_utf8decode(t+1, 0, 0);
-      if (s==0) return 0;
-      else if (s==(unsigned int)'&') t++;
-      else return s;
-    }
-    t++;
+    t = strchr(t, '&'); // skip over text without markers in one step
+    if (!t) return 0;
+    unsigned int s = fl_utf8decode(t+1, 0, 0);
+    if (s==0) return 0;
+    else if (s==(unsigned int)'&') t += 2; // '&&' is a literal ampersand
+    else return s;
   }
 }
 
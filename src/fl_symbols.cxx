@@ -89,6 +89,32 @@ int fl_add_symbol(const char *name, void (*drawit)(Fl_Color), int scalable)
 
 int fl_return_arrow(int x,int y,int w,int h);
 
+extern void fl_draw_symbol_cached(Fl_Box_Draw_F *, const void *, unsigned,
+                                  int, int, int, int, Fl_Color); // in fl_cached_box.cxx
+
+// The symbol fl_draw_symbol() decoded last, for draw_symbol_raster():
+static void (*sym_drawit)(Fl_Color);
+static int sym_w, sym_h, sym_rotangle;
+static char sym_flip_x, sym_flip_y, sym_equalscale;
+
+// Draws the decoded symbol. x,y,w,h is a padded rectangle with the
+// nominal sym_w x sym_h symbol rectangle centered inside it: symbols
+// stroke their outlines on (and "@FLTK" even draws beyond) the edges of
+// the nominal rectangle, and the padding keeps those pixels inside the
+// offscreen when the draw is rasterized for the cache.
+static void draw_symbol_raster(int x, int y, int w, int h, Fl_Color col) {
+  fl_push_matrix();
+  fl_translate(x+w/2,y+h/2);
+  w = sym_w; h = sym_h;
+  if (sym_equalscale) {if (w<h) h = w; else w = h;}
+  fl_scale(0.5*w, 0.5*h);
+  fl_rotate(sym_rotangle/10.0);
+  if (sym_flip_x) fl_scale(-1.0, 1.0);
+  if (sym_flip_y) fl_scale(1.0, -1.0);
+  (sym_drawit)(col);
+  fl_pop_matrix();
+}
+
 /**
   Draw the named symbol in the given rectangle using the given color
   \param[in] label name of symbol
@@ -148,6 +174,19 @@ int fl_draw_symbol(const char *label,int x,int y,int w,int h,Fl_Color col) {
     fl_return_arrow(x,y,w,h);
     return 1;
   }
+  if (symbols[pos].scalable == 1) {
+    // replay repeated draws of the same symbol at the same size from a
+    // raster cache instead of re-tessellating the vector description
+    sym_drawit = symbols[pos].drawit;
+    sym_w = w; sym_h = h;
+    sym_rotangle = rotangle;
+    sym_flip_x = flip_x; sym_flip_y = flip_y; sym_equalscale = equalscale;
+    int mx = w/2 + 2, my = h/2 + 2;     // see draw_symbol_raster()
+    fl_draw_symbol_cached(draw_symbol_raster, (const void *)symbols[pos].drawit,
+                          (unsigned)rotangle*8 + flip_x*4 + flip_y*2 + equalscale,
+                          x - mx, y - my, w + 2*mx, h + 2*my, col);
+    return 1;
+  }
   fl_push_matrix();
   fl_translate(x+w/2,y+h/2);
   if (symbols[pos].scalable) {
@@ -58,6 +58,22 @@ static int Toupper(int ucs) {
   return table[ucs];
 }
 
+/* Sequence length, indexed by the value of the first byte: 1 for ASCII,
+   2..6 for lead bytes of multi-byte sequences, 0 for continuation bytes
+   (which cannot start a sequence). These functions are called for every
+   character of every text draw, measurement and Fl_Text_Buffer
+   traversal, so a table lookup is preferable to nested branches. */
+static const unsigned char utf8len_table[256] = {
+  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, /* 0x00 */
+  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, /* 0x20 */
+  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, /* 0x40 */
+  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, /* 0x60 */
+  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, /* 0x80 */
+  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, /* 0xa0 */
+  2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, /* 0xc0 */
+  3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3, 4,4,4,4,4,4,4,4,5,5,5,5,6,6,6,6  /* 0xe0 */
+};
+
 /**
   Returns the byte length of the UTF-8 sequence with first byte \p c,
   or -1 if \p c is not valid.
@@ -67,23 +83,8 @@ static int Toupper(int ucs) {
 */
 int fl_utf8len(char c)
 {
-  if (!(c & 0x80)) return 1;
-  if (c & 0x40) {
-    if (c & 0x20) {
-      if (c & 0x10) {
-        if (c & 0x08) {
-          if (c & 0x04) {
-            return 6;
-          }
-          return 5;
-        }
-        return 4;
-      }
-      return 3;
-    }
-    return 2;
-  }
-  return -1;
+  int l = utf8len_table[(unsigned char)c];
+  return l ? l : -1;
 } // fl_utf8len
 
 
@@ -97,23 +98,8 @@ int fl_utf8len(char c)
 */
 int fl_utf8len1(char c)
 {
-  if (!(c & 0x80)) return 1;
-  if (c & 0x40) {
-    if (c & 0x20) {
-      if (c & 0x10) {
-        if (c & 0x08) {
-          if (c & 0x04) {
-            return 6;
-          }
-          return 5;
-        }
-        return 4;
-      }
-      return 3;
-    }
-    return 2;
-  }
-  return 1;
+  int l = utf8len_table[(unsigned char)c];
+  return l ? l : 1;
 } // fl_utf8len1
 
 
@@ -125,10 +111,28 @@ fl_utf_nb_char(
         const unsigned char     *buf,
         int                     len)
 {
+  /* set in every byte of a word that holds a non-ASCII value */
+  const unsigned long himagic = (unsigned long)-1 / 0xff * 0x80;
   int i = 0;
   int nbc = 0;
   while (i < len) {
-    int cl = fl_utf8len((buf+i)[0]);
+    unsigned char c = buf[i];
+    if (!(c & 0x80)) { /* ASCII: count the whole 7-bit run, word-at-a-time */
+      i++;
+      nbc++;
+      while (i < len && ((size_t)(buf + i) & (sizeof(unsigned long) - 1)) &&
+             !(buf[i] & 0x80)) { /* up to the next word boundary */
+        i++;
+        nbc++;
+      }
+      while (i + (int)sizeof(unsigned long) <= len &&
+             !(*(const unsigned long *)(buf + i) & himagic)) {
+        i += (int)sizeof(unsigned long);
+        nbc += (int)sizeof(unsigned long);
+      }
+      continue;
+    }
+    int cl = utf8len_table[c];
     if (cl < 1) cl = 1;
     nbc++;
     i += cl;
@@ -979,6 +983,11 @@ unsigned fl_ucs_to_Utf16(const unsigned ucs, unsigned short *dst, const unsigned
   Unicode characters in the range 0x10000 to 0x10ffff are converted to
   "surrogate pairs" which take two words each (this is called UTF-16
   encoding).
+
+  Since every UTF-8 byte produces at most one output word (a 4-byte
+  sequence makes a surrogate pair of two words), a \p dst array of
+  \p srclen+1 words is always large enough to convert in a single pass
+  without querying the length first.
 */
 unsigned fl_utf8toUtf16(const char* src, unsigned srclen,
                         unsigned short* dst, unsigned dstlen)
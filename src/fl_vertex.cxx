@@ -131,6 +131,20 @@ double Fl_Graphics_Driver::transform_dy(double x, double y) {
   return x*m.b + y*m.d;
 }
 
+/** see fl_polyline(const double*, int) */
+void Fl_Graphics_Driver::polyline(const double *xy, int npts) {
+  begin_line();
+  for (int i = 0; i < npts; i++) vertex(xy[2*i], xy[2*i+1]);
+  end_line();
+}
+
+/** see fl_polygon(const double*, int) */
+void Fl_Graphics_Driver::polygon(const double *xy, int npts) {
+  begin_polygon();
+  for (int i = 0; i < npts; i++) vertex(xy[2*i], xy[2*i+1]);
+  end_polygon();
+}
+
 /**
  \}
  \endcond
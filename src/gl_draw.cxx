@@ -249,6 +249,14 @@ void gl_color(Fl_Color i) {
  Strings are drawn in 2 steps:
     1) compute the texture for that string if it was not computed before;
     2) draw the texture using the current GL color.
+ When the pile is full, the least recently displayed texture is reused
+ for the new string, so strings drawn at every frame stay in the pile
+ even while transient strings flow through it.
+ Because FLTK creates all GL contexts sharing with the first one (see
+ Fl_XXX_Gl_Window_Driver::create_gl_context), a single pile serves all
+ Fl_Gl_Window's: textures computed in one window's context are directly
+ usable in every other, and opening a new GL window does not require
+ re-computing them.
 */
 
 // manages a fifo pile of pre-computed string textures
@@ -261,11 +269,13 @@ private:
     Fl_Font_Descriptor *fdesc; // its font
     float scale; // scaling factor of the GUI
     int str_len; // the length of the utf8 text
+    int last_used; // value of the pile's clock when the texture was last displayed
   } data;
   data *fifo; // array of pile elements
   int size_; // pile height
-  int current; // the oldest texture to have entered the pile
+  int current; // where the most recent texture was computed
   int last; // pile top
+  int clock_; // incremented at each texture display
   int textures_generated; // true after glGenTextures has been called
   void display_texture(int rank);
   int compute_texture(const char* str, int n);
@@ -280,6 +290,7 @@ gl_texture_fifo::gl_texture_fifo(int max)
 {
   size_ = max;
   last = current = -1;
+  clock_ = 0;
   textures_generated = 0;
   fifo = (data*)calloc(size_, sizeof(data));
 }
@@ -322,6 +333,7 @@ void gl_texture_reset()
 // displays a pre-computed texture on the GL scene
 void gl_texture_fifo::display_texture(int rank)
 {
+  fifo[rank].last_used = ++clock_; // mark as most recently used
   //setup matrices
   GLint matrixMode;
   glGetIntegerv (GL_MATRIX_MODE, &matrixMode);
@@ -397,8 +409,14 @@ void gl_texture_fifo::display_texture(int rank)
 // pre-computes a string texture
 int gl_texture_fifo::compute_texture(const char* str, int n)
 {
-  current = (current + 1) % size_;
-  if (current > last) last = current;
+  if (last < size_ - 1) { // the pile is not full: use a fresh slot
+    current = ++last;
+  } else { // the pile is full: reuse the least recently displayed slot
+    current = 0;
+    for (int i = 1; i < size_; i++) {
+      if (fifo[i].last_used < fifo[current].last_used) current = i;
+    }
+  }
   if ( fifo[current].utf8 ) free(fifo[current].utf8);
   fifo[current].utf8 = (char *)malloc(n + 1);
   memcpy(fifo[current].utf8, str, n);
@@ -458,7 +476,8 @@ int gl_texture_pile_height(void)
  Changes the maximum height of the pile of pre-computed string textures
 
  Strings that are often re-displayed can be processed much faster if
- this pile is set high enough to hold all of them.
+ this pile is set high enough to hold all of them. When the pile is full,
+ the least recently displayed texture is reused for the next new string.
  \param max Maximum height of the texture pile
  \see Fl::draw_GL_text_with_textures(int)
 */
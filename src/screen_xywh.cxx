@@ -20,13 +20,37 @@
 #include <config.h>
 
 
+// incremented whenever the screen or work-area configuration changes;
+// also bumped by the platform event handlers (e.g. _NET_WORKAREA updates
+// in Fl_x.cxx) that refresh the cached work area without a full re-init
+int fl_screen_configuration_serial = 0;
+
 #ifndef FL_DOXYGEN
 void Fl::call_screen_init()
 {
   screen_driver()->init();
+  fl_screen_configuration_serial++;
 }
 #endif
 
+/**
+  Returns a serial number identifying the current screen configuration.
+
+  The number changes whenever the screen configuration changes — a monitor
+  is added or removed, its resolution changes, or the work area moves
+  because a taskbar appeared. Screen numbers and the geometry returned by
+  Fl::screen_xywh() and Fl::screen_work_area() are stable while the serial
+  is unchanged, so code that calls these functions on hot paths (tooltip
+  and menu positioning, for example) can cache per-screen results keyed by
+  this value instead of handling FL_SCREEN_CONFIGURATION_CHANGED itself.
+
+  \see Fl::screen_count(), Fl::screen_xywh(int&, int&, int&, int&, int)
+*/
+int Fl::screen_configuration_serial()
+{
+  return fl_screen_configuration_serial;
+}
+
 /** Returns the leftmost x coordinate of the main screen work area. */
 int Fl::x()
 {
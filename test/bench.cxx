@@ -0,0 +1,240 @@
+//
+// Microbenchmark program for the Fast Light Tool Kit (FLTK).
+//
+// Times core drawing and widget paths so that library changes can be
+// compared before deploying them. All rendering goes into an
+// Fl_Image_Surface, so no window is mapped and the numbers do not
+// depend on a compositor; a display connection is still required for
+// fonts and offscreen surfaces.
+//
+// Output is one line per benchmark:
+//
+//   bench <name> <ops> <seconds> <ops-per-second>
+//
+// which is easy to collect per commit and compare with a script.
+//
+// Copyright 1998-2021 by Bill Spitzak and others.
+//
+// This library is free software. Distribution and use rights are outlined in
+// the file "COPYING" which should have been included with this file.  If this
+// file is missing or damaged, see the license at:
+//
+//     https://www.fltk.org/COPYING.php
+//
+// Please see the following page on how to report bugs and issues:
+//
+//     https://www.fltk.org/bugs.php
+//
+
+#include <FL/Fl.H>
+#include <FL/platform.H>
+#include <FL/Fl_Double_Window.H>
+#include <FL/Fl_Browser.H>
+#include <FL/Fl_Text_Buffer.H>
+#include <FL/Fl_Text_Display.H>
+#include <FL/Fl_Table.H>
+#include <FL/Fl_RGB_Image.H>
+#include <FL/Fl_Image_Surface.H>
+#include <FL/fl_draw.H>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#  include <sys/time.h> // gettimeofday()
+#else
+#  include <windows.h>
+#endif // !_WIN32
+
+
+// Return the wall clock in seconds; only differences are meaningful.
+static double now(void) {
+#if !defined(_WIN32)
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + 0.000001 * t.tv_usec;
+#else
+  return 0.001 * GetTickCount();
+#endif // !_WIN32
+}
+
+
+static void report(const char *name, long ops, double secs) {
+  printf("bench %-16s %9ld %9.4f %12.0f\n", name, ops, secs, ops / secs);
+  fflush(stdout);
+}
+
+
+// fl_rectf() fill throughput...
+static void bench_rect(void) {
+  const long N = 100000;
+  Fl_Image_Surface surf(512, 512);
+
+  Fl_Surface_Device::push_current(&surf);
+  double t0 = now();
+  for (long i = 0; i < N; i++) {
+    fl_color((Fl_Color)(i & 255));
+    fl_rectf((int)(i % 400), (int)(i % 300), 100, 100);
+  }
+  double t1 = now();
+  Fl_Surface_Device::pop_current();
+
+  report("rectf", N, t1 - t0);
+}
+
+
+// fl_draw() text throughput...
+static void bench_text(void) {
+  const long N = 20000;
+  static const char line[] = "The quick brown fox jumps over the lazy dog, 0123456789.";
+  Fl_Image_Surface surf(512, 512);
+
+  Fl_Surface_Device::push_current(&surf);
+  fl_font(FL_HELVETICA, 14);
+  fl_color(FL_BLACK);
+  double t0 = now();
+  for (long i = 0; i < N; i++)
+    fl_draw(line, 10, (int)(20 + (i % 24) * 20));
+  double t1 = now();
+  Fl_Surface_Device::pop_current();
+
+  report("text", N, t1 - t0);
+}
+
+
+// Filling an Fl_Browser with lines, then sweeping the top line...
+static void bench_browser(void) {
+  const long N = 50000;
+  char buf[64];
+
+  Fl_Double_Window win(400, 300);
+  Fl_Browser browser(0, 0, 400, 300);
+  win.end();
+
+  double t0 = now();
+  for (long i = 0; i < N; i++) {
+    sprintf(buf, "line %ld\tsecond column %ld", i, i * i);
+    browser.add(buf);
+  }
+  double t1 = now();
+  report("browser-add", N, t1 - t0);
+
+  t0 = now();
+  for (long i = 1; i <= N; i += 100)
+    browser.topline((int)i);
+  t1 = now();
+  report("browser-scroll", N / 100, t1 - t0);
+}
+
+
+// Loading a large buffer into a wrapping Fl_Text_Display...
+static void bench_text_display(void) {
+  const long N = 20000;
+  char *text = (char *)malloc(N * 64 + 1);
+  char *p = text;
+
+  for (long i = 0; i < N; i++)
+    p += sprintf(p, "Line %ld of a reasonably long paragraph used to exercise word wrap.\n", i);
+
+  Fl_Double_Window win(800, 600);
+  Fl_Text_Display display(0, 0, 800, 600);
+  win.end();
+  Fl_Text_Buffer buffer;
+  display.buffer(&buffer);
+  display.wrap_mode(Fl_Text_Display::WRAP_AT_BOUNDS, 0);
+
+  double t0 = now();
+  buffer.text(text);
+  double t1 = now();
+  report("textdisplay-load", N, t1 - t0);
+
+  display.buffer((Fl_Text_Buffer *)0); // detach before the buffer goes away
+  free(text);
+}
+
+
+// Scaling copies of an Fl_RGB_Image...
+static void bench_image_copy(void) {
+  const long N = 50;
+  const int W = 1024, H = 1024;
+  uchar *data = (uchar *)malloc((size_t)W * H * 3);
+
+  for (long i = 0; i < (long)W * H * 3; i++)
+    data[i] = (uchar)i;
+  Fl_RGB_Image image(data, W, H, 3);
+
+  double t0 = now();
+  for (long i = 0; i < N; i++) {
+    Fl_Image *copy = image.copy(333, 333);
+    delete copy;
+  }
+  double t1 = now();
+  report("image-copy", N, t1 - t0);
+
+  free(data);
+}
+
+
+// An Fl_Table painting all of its cells...
+class BenchTable : public Fl_Table {
+public:
+  BenchTable(int X, int Y, int W, int H) : Fl_Table(X, Y, W, H) {
+    rows(40);
+    cols(12);
+    row_height_all(20);
+    col_width_all(60);
+    end();
+  }
+  void draw_cell(TableContext context, int R = 0, int C = 0,
+                 int X = 0, int Y = 0, int W = 0, int H = 0) {
+    char s[40];
+    switch (context) {
+      case CONTEXT_CELL:
+        fl_push_clip(X, Y, W, H);
+        fl_color(((R + C) & 1) ? FL_WHITE : FL_LIGHT2);
+        fl_rectf(X, Y, W, H);
+        fl_color(FL_BLACK);
+        sprintf(s, "%d/%d", R, C);
+        fl_draw(s, X, Y, W, H, FL_ALIGN_CENTER);
+        fl_pop_clip();
+        break;
+      default:
+        break;
+    }
+  }
+};
+
+static void bench_table(void) {
+  const long N = 200;
+
+  Fl_Double_Window win(760, 560);
+  BenchTable table(0, 0, 760, 560);
+  win.end();
+
+  Fl_Image_Surface surf(760, 560);
+  double t0 = now();
+  for (long i = 0; i < N; i++)
+    surf.draw(&table, 0, 0);
+  double t1 = now();
+
+  report("table-draw", N, t1 - t0);
+}
+
+
+int main(int argc, char **argv) {
+  fl_open_display();
+
+  // run everything once outside the timed loops to pull in fonts etc.
+  bench_rect();
+  printf("# warmup done, timed runs follow\n");
+
+  bench_rect();
+  bench_text();
+  bench_browser();
+  bench_text_display();
+  bench_image_copy();
+  bench_table();
+
+  return 0;
+}